@@ -0,0 +1,72 @@
+'use strict';
+
+// Built-in HTTP/2 load generator, forked by the H2NativeBenchmarker class
+// in _http-benchmarkers.js with --expose-internals. Unlike wrk/autocannon
+// it drives multiplexed load shapes: `sessions` client sessions with
+// `streams` concurrent requests each, with an optional per-stream think
+// time between a response finishing and the next request starting.
+// Per-request latencies are recorded into a native hdr histogram and the
+// summary is printed as JSON on stdout when the run is over.
+
+const http2 = require('http2');
+const { URL } = require('url');
+const { createHistogram } = require('internal/histogram');
+
+const url = new URL(process.env.test_url);
+const duration = +process.env.duration || 5;
+const sessions = +process.env.sessions || 1;
+const streams = +process.env.streams || 10;
+const thinktime = +process.env.thinktime || 0;
+
+const histogram = createHistogram();
+const clients = [];
+let throughput = 0;
+let stopped = false;
+
+function startStream(client) {
+  if (stopped)
+    return;
+  const started = process.hrtime.bigint();
+  const req = client.request({ ':path': url.pathname + url.search });
+  req.resume();
+  req.on('error', () => {});
+  req.on('close', () => {
+    if (stopped)
+      return;
+    throughput++;
+    // Latencies are recorded in nanoseconds.
+    histogram.record(Number(process.hrtime.bigint() - started));
+    if (thinktime > 0)
+      setTimeout(() => startStream(client), thinktime);
+    else
+      startStream(client);
+  });
+}
+
+for (let i = 0; i < sessions; i++) {
+  const client = http2.connect(url.origin);
+  client.on('error', (e) => { throw e; });
+  client.on('connect', () => {
+    for (let j = 0; j < streams; j++)
+      startStream(client);
+  });
+  clients.push(client);
+}
+
+setTimeout(() => {
+  stopped = true;
+  for (const client of clients)
+    client.destroy();
+  console.log(JSON.stringify({
+    throughput,
+    latency: {
+      min: histogram.min,
+      max: histogram.max,
+      mean: histogram.mean,
+      stddev: histogram.stddev,
+      p50: histogram.percentile(50),
+      p90: histogram.percentile(90),
+      p99: histogram.percentile(99),
+    },
+  }));
+}, duration * 1000);
@@ -168,12 +168,53 @@ class H2LoadBenchmarker {
   }
 }
 
+/**
+ * Built-in HTTP/2 benchmarker. Runs over the http2 client in a forked
+ * process, so it can drive multiplexed load shapes (N sessions x M
+ * concurrent streams with think time) that the external tools cannot,
+ * and reports a latency histogram alongside the throughput.
+ */
+class H2NativeBenchmarker {
+  constructor() {
+    this.name = 'h2-native';
+    this.executable = path.resolve(__dirname, '_h2-native-benchmarker.js');
+    this.present = fs.existsSync(this.executable);
+  }
+
+  create(options) {
+    const env = Object.assign({
+      duration: options.duration,
+      sessions: options.connections,
+      streams: options.streams || options.maxConcurrentStreams || 10,
+      thinktime: options.thinktime || 0,
+      test_url: `http://127.0.0.1:${options.port}${options.path}`,
+    }, process.env);
+
+    const child = child_process.fork(
+      this.executable,
+      [],
+      { silent: true, env, execArgv: ['--expose-internals'] });
+    return child;
+  }
+
+  processResults(output) {
+    let result;
+    try {
+      result = JSON.parse(output);
+    } catch {
+      return undefined;
+    }
+    return result.throughput;
+  }
+}
+
 const http_benchmarkers = [
   new WrkBenchmarker(),
   new AutocannonBenchmarker(),
   new TestDoubleBenchmarker('http'),
   new TestDoubleBenchmarker('http2'),
   new H2LoadBenchmarker(),
+  new H2NativeBenchmarker(),
 ];
 
 const benchmarkers = {};
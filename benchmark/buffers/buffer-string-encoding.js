@@ -0,0 +1,33 @@
+'use strict';
+
+// Covers both conversion directions for every string encoding, so
+// changes to the StringBytes fast paths (base64/hex SIMD, force_ascii,
+// UCS-2 handling) are caught by a single benchmark.
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  encoding: ['ascii', 'latin1', 'utf8', 'utf16le', 'hex', 'base64'],
+  op: ['toString', 'from'],
+  len: [64, 1024, 32768],
+  n: [1e5]
+});
+
+function main({ encoding, op, len, n }) {
+  const buf = Buffer.alloc(len);
+  for (let i = 0; i < len; i++)
+    buf[i] = (i * 7 + 33) & 0x7f;  // printable-ish, valid in every encoding
+  const str = buf.toString(encoding);
+
+  if (op === 'toString') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      buf.toString(encoding);
+    bench.end(n);
+  } else {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      Buffer.from(str, encoding);
+    bench.end(n);
+  }
+}
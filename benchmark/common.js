@@ -2,6 +2,16 @@
 
 const child_process = require('child_process');
 const http_benchmarkers = require('./_http-benchmarkers.js');
+const { performance } = require('perf_hooks');
+
+// Native hdr_histogram-backed sample storage for runSampled(); only
+// available when the benchmark is run with --expose-internals.
+let createHistogram = null;
+try {
+  createHistogram = require('internal/histogram').createHistogram;
+} catch {
+  // Percentiles are simply omitted from the stats in that case.
+}
 
 exports.buildType = process.features.debug ? 'Debug' : 'Release';
 
@@ -33,6 +43,10 @@ function Benchmark(fn, configs, options) {
   this._time = [0, 0];
   // Used to make sure a benchmark only start a timer once
   this._started = false;
+  // Whether hardware performance counters are running for this benchmark.
+  // Opt-in via NODE_BENCHMARK_COUNTERS=1; requires Linux perf_event support
+  // and a node with performance.startHardwareCounters().
+  this._counters = false;
 
   // this._run will use fork() to create a new process for each configuration
   // combination.
@@ -187,12 +201,21 @@ Benchmark.prototype.start = function() {
     throw new Error('Called start more than once in a single benchmark');
   }
   this._started = true;
+  if (process.env.NODE_BENCHMARK_COUNTERS &&
+      typeof performance.startHardwareCounters === 'function') {
+    this._counters = performance.startHardwareCounters();
+  }
   this._time = process.hrtime();
 };
 
 Benchmark.prototype.end = function(operations) {
   // Get elapsed time now and do error checking later for accuracy.
   const elapsed = process.hrtime(this._time);
+  let counters = null;
+  if (this._counters) {
+    counters = performance.readHardwareCounters();
+    performance.stopHardwareCounters();
+  }
 
   if (!this._started) {
     throw new Error('called end without start');
@@ -212,7 +235,131 @@ Benchmark.prototype.end = function(operations) {
 
   const time = elapsed[0] + elapsed[1] / 1e9;
   const rate = operations / time;
-  this.report(rate, elapsed);
+  this.report(rate, elapsed, counters);
+};
+
+// Two-sided 95% Student's t quantiles, [degrees of freedom, t]. Falls back
+// to the normal quantile for large sample counts.
+const t95Table = [
+  [1, 12.706], [2, 4.303], [3, 3.182], [4, 2.776], [5, 2.571],
+  [6, 2.447], [7, 2.365], [8, 2.306], [9, 2.262], [10, 2.228],
+  [12, 2.179], [14, 2.145], [16, 2.120], [18, 2.101], [20, 2.086],
+  [25, 2.060], [30, 2.042], [40, 2.021], [60, 2.000],
+];
+
+function tQuantile95(df) {
+  for (const [tableDf, t] of t95Table) {
+    if (df <= tableDf)
+      return t;
+  }
+  return 1.96;
+}
+
+function median(sorted) {
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+// Rejects outliers by median absolute deviation (robust against the very
+// skew that makes them outliers), then computes mean, stddev and a 95%
+// confidence interval over the surviving samples.
+function computeStats(samples) {
+  const sorted = samples.slice().sort((a, b) => a - b);
+  const med = median(sorted);
+  const deviations = sorted.map((x) => Math.abs(x - med)).sort((a, b) => a - b);
+  const mad = median(deviations);
+  // 1.4826 makes the MAD a consistent estimator of the standard deviation
+  // for normally distributed data; 3 sigma is the usual rejection cutoff.
+  const cutoff = 3 * 1.4826 * mad;
+  const kept = mad === 0 ?
+    sorted : sorted.filter((x) => Math.abs(x - med) <= cutoff);
+
+  const n = kept.length;
+  const mean = kept.reduce((a, b) => a + b, 0) / n;
+  const variance = n > 1 ?
+    kept.reduce((a, b) => a + (b - mean) ** 2, 0) / (n - 1) : 0;
+  const stddev = Math.sqrt(variance);
+  const moe = n > 1 ? tQuantile95(n - 1) * stddev / Math.sqrt(n) : 0;
+
+  return {
+    n,
+    rejected: samples.length - n,
+    mean,
+    stddev,
+    moe,
+  };
+}
+
+// Statistically rigorous alternative to start()/end(). `fn(iterations)` must
+// synchronously run the measured operation `iterations` times; it is invoked
+// repeatedly: first until batch times reach a steady state (warmup — JIT
+// tiering, IC warmup, page faults), then `samples` more times for the actual
+// measurement. Batch times are outlier-rejected and reported with a 95%
+// confidence interval, so a small regression is distinguishable from noise
+// in a single run. With --expose-internals the batch times additionally go
+// into a native hdr_histogram and p50/p90/p99 are included in the report.
+Benchmark.prototype.runSampled = function(options, fn) {
+  if (typeof options === 'function') {
+    fn = options;
+    options = {};
+  }
+  if (this._started) {
+    throw new Error('runSampled() cannot be combined with start()');
+  }
+  this._started = true;
+
+  const iterations = options.iterations || 1e4;
+  const samples = options.samples || 30;
+  const warmupWindow = options.warmupWindow || 10;
+  const maxWarmupBatches = options.maxWarmupBatches || 100;
+  // Steady state: the two halves of the sliding window agree within 2%.
+  const tolerance = options.steadyStateTolerance || 0.02;
+
+  const measure = () => {
+    const start = process.hrtime.bigint();
+    fn(iterations);
+    return Number(process.hrtime.bigint() - start);
+  };
+
+  const window = [];
+  for (let i = 0; i < maxWarmupBatches; i++) {
+    window.push(measure());
+    if (window.length > warmupWindow)
+      window.shift();
+    if (window.length === warmupWindow) {
+      const half = warmupWindow >> 1;
+      const first = window.slice(0, half).reduce((a, b) => a + b, 0) / half;
+      const rest = window.slice(half);
+      const second = rest.reduce((a, b) => a + b, 0) / rest.length;
+      if (Math.abs(first - second) / second < tolerance)
+        break;
+    }
+  }
+
+  const histogram = createHistogram === null ? null : createHistogram();
+  const times = [];
+  let totalNs = 0;
+  for (let i = 0; i < samples; i++) {
+    const ns = measure();
+    times.push(ns);
+    totalNs += ns;
+    if (histogram !== null && ns >= 1)
+      histogram.record(Math.round(ns));
+  }
+
+  const stats = computeStats(times);
+  stats.iterations = iterations;
+  if (histogram !== null) {
+    stats.percentiles = {
+      p50: histogram.percentile(50),
+      p90: histogram.percentile(90),
+      p99: histogram.percentile(99),
+    };
+  }
+
+  const rate = iterations / (stats.mean / 1e9);
+  const elapsed = [Math.floor(totalNs / 1e9), totalNs % 1e9];
+  this.report(rate, elapsed, null, stats);
 };
 
 function formatResult(data) {
@@ -225,7 +372,22 @@ function formatResult(data) {
   var rate = data.rate.toString().split('.');
   rate[0] = rate[0].replace(/(\d)(?=(?:\d\d\d)+(?!\d))/g, '$1,');
   rate = (rate[1] ? rate.join('.') : rate[0]);
-  return `${data.name}${conf}: ${rate}`;
+
+  let stats = '';
+  if (data.stats) {
+    const moePct = (100 * data.stats.moe / data.stats.mean).toFixed(2);
+    stats = ` (±${moePct}%, n=${data.stats.n}`;
+    if (data.stats.rejected > 0)
+      stats += `, ${data.stats.rejected} outliers rejected`;
+    stats += ')';
+  }
+
+  let gc = '';
+  if (data.gc) {
+    gc = ` [GC: ${data.gc.count} pauses, ` +
+         `${data.gc.pauseMs.toFixed(1)} ms total]`;
+  }
+  return `${data.name}${conf}: ${rate}${stats}${gc}`;
 }
 
 function sendResult(data) {
@@ -239,14 +401,68 @@ function sendResult(data) {
 }
 exports.sendResult = sendResult;
 
-Benchmark.prototype.report = function(rate, elapsed) {
-  sendResult({
+Benchmark.prototype.report = function(rate, elapsed, counters, stats, gc) {
+  const data = {
     name: this.name,
     conf: this.config,
     rate: rate,
     time: elapsed[0] + elapsed[1] / 1e9,
     type: 'report',
+  };
+  if (stats) {
+    data.stats = stats;
+  }
+  if (gc) {
+    data.gc = gc;
+  }
+  if (counters) {
+    // Counter values are BigInts; convert so the report survives the JSON
+    // serialization done by process.send().
+    data.counters = {};
+    for (const key of Object.keys(counters))
+      data.counters[key] = Number(counters[key]);
+  }
+  sendResult(data);
+};
+
+// Tracks GC activity (counts, pause totals, heap delta) over a measured
+// region, for allocation-heavy benchmarks. GC performance entries are
+// delivered on later event loop turns, so stop() flushes the observer
+// queue before invoking its callback with the summary.
+exports.createGCTracker = function() {
+  const { PerformanceObserver, constants } = require('perf_hooks');
+  const v8 = require('v8');
+
+  const summary = {
+    count: 0,
+    pauseMs: 0,
+    major: 0,
+    majorPauseMs: 0,
+    heapUsedDelta: 0,
+  };
+  const heapBefore = v8.getHeapStatistics().used_heap_size;
+  const observer = new PerformanceObserver((list) => {
+    for (const entry of list.getEntries()) {
+      summary.count++;
+      summary.pauseMs += entry.duration;
+      if (entry.kind === constants.NODE_PERFORMANCE_GC_MAJOR) {
+        summary.major++;
+        summary.majorPauseMs += entry.duration;
+      }
+    }
   });
+  observer.observe({ entryTypes: ['gc'] });
+
+  return {
+    stop(cb) {
+      setImmediate(() => setImmediate(() => {
+        observer.disconnect();
+        summary.heapUsedDelta =
+          v8.getHeapStatistics().used_heap_size - heapBefore;
+        cb(summary);
+      }));
+    },
+  };
 };
 
 exports.binding = function(bindingName) {
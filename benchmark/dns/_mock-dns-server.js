@@ -0,0 +1,119 @@
+'use strict';
+
+// Minimal in-process DNS server for benchmarking the resolver path without
+// touching real networks. It understands just enough of the wire format to
+// answer A queries, with scriptable failure injection: a fixed response
+// delay, dropping the first attempt of each query (forcing client-side
+// timeout and retry), and UDP truncation (forcing TCP fallback, which is
+// served by a companion TCP listener on the same port number).
+
+const dgram = require('dgram');
+const net = require('net');
+
+function parseQuery(buf) {
+  const id = buf.readUInt16BE(0);
+  let offset = 12;
+  while (buf[offset] !== 0)
+    offset += buf[offset] + 1;
+  // The raw question section (name + QTYPE + QCLASS) is echoed back.
+  const question = buf.slice(12, offset + 5);
+  return { id, question };
+}
+
+function buildResponse(id, question, truncated) {
+  const header = Buffer.alloc(12);
+  header.writeUInt16BE(id, 0);
+  // QR + RD + RA, plus TC when injecting truncation.
+  header.writeUInt16BE(truncated ? 0x8380 : 0x8180, 2);
+  header.writeUInt16BE(1, 4);                  // QDCOUNT
+  header.writeUInt16BE(truncated ? 0 : 1, 6);  // ANCOUNT
+  if (truncated)
+    return Buffer.concat([header, question]);
+
+  const answer = Buffer.from([
+    0xc0, 0x0c,              // Compression pointer to the question name.
+    0x00, 0x01, 0x00, 0x01,  // TYPE A, CLASS IN.
+    0x00, 0x00, 0x00, 0x3c,  // TTL 60.
+    0x00, 0x04,              // RDLENGTH.
+    127, 0, 0, 1,
+  ]);
+  return Buffer.concat([header, question, answer]);
+}
+
+// options:
+//   delay        milliseconds to wait before answering (default 0)
+//   dropFirstTry swallow the first attempt of every query id (default false)
+//   truncate     answer UDP queries with TC set, full answer over TCP only
+function createMockDNSServer(options, onListen) {
+  const delay = options.delay | 0;
+  const dropFirstTry = !!options.dropFirstTry;
+  const truncate = !!options.truncate;
+
+  const dropped = new Set();
+  const udp = dgram.createSocket('udp4');
+
+  udp.on('message', (msg, rinfo) => {
+    const query = parseQuery(msg);
+    if (dropFirstTry && !dropped.has(query.id)) {
+      dropped.add(query.id);
+      return;
+    }
+    dropped.delete(query.id);
+    const response = buildResponse(query.id, query.question, truncate);
+    const send = () => udp.send(response, rinfo.port, rinfo.address);
+    if (delay > 0)
+      setTimeout(send, delay);
+    else
+      send();
+  });
+
+  // DNS over TCP is length-prefixed; only used after a truncated UDP answer.
+  const tcp = net.createServer((socket) => {
+    let buffered = Buffer.alloc(0);
+    socket.on('data', (chunk) => {
+      buffered = Buffer.concat([buffered, chunk]);
+      while (buffered.length >= 2) {
+        const len = buffered.readUInt16BE(0);
+        if (buffered.length < len + 2)
+          break;
+        const query = parseQuery(buffered.slice(2, len + 2));
+        buffered = buffered.slice(len + 2);
+        const response = buildResponse(query.id, query.question, false);
+        const framed = Buffer.alloc(2);
+        framed.writeUInt16BE(response.length, 0);
+        const send = () => socket.write(Buffer.concat([framed, response]));
+        if (delay > 0)
+          setTimeout(send, delay);
+        else
+          send();
+      }
+    });
+  });
+
+  udp.bind(0, '127.0.0.1', () => {
+    tcp.listen(udp.address().port, '127.0.0.1', () => {
+      onListen(udp.address().port);
+    });
+  });
+
+  return {
+    close() {
+      udp.close();
+      tcp.close();
+    },
+  };
+}
+
+// The benchmark metric is throughput; tail latency is reported separately
+// on stderr so it does not interfere with compare.js parsing of stdout.
+function reportLatency(latenciesMs) {
+  const sorted = Array.from(latenciesMs).sort((a, b) => a - b);
+  const pct = (p) => {
+    const index = Math.min(sorted.length - 1, Math.floor(sorted.length * p));
+    return sorted[index].toFixed(3);
+  };
+  console.error(`latency ms: p50=${pct(0.5)} p90=${pct(0.9)} ` +
+                `p99=${pct(0.99)} max=${sorted[sorted.length - 1].toFixed(3)}`);
+}
+
+module.exports = { createMockDNSServer, reportLatency };
@@ -0,0 +1,58 @@
+'use strict';
+
+// Resolution tail latency under injected failures: `droptry` swallows the
+// first attempt of every query so the client has to time out and retry
+// (dominated by the c-ares retry timeout — keep `n` small), `truncate`
+// forces TCP fallback via the TC bit. Percentiles go to stderr.
+
+const common = require('../common.js');
+const dns = require('dns');
+const {
+  createMockDNSServer,
+  reportLatency,
+} = require('./_mock-dns-server.js');
+
+const bench = common.createBenchmark(main, {
+  n: [50],
+  concurrency: [10],
+  failure: ['droptry', 'truncate'],
+});
+
+function main({ n, concurrency, failure }) {
+  const options = {
+    dropFirstTry: failure === 'droptry',
+    truncate: failure === 'truncate',
+  };
+
+  const server = createMockDNSServer(options, (port) => {
+    const resolver = new dns.Resolver();
+    resolver.setServers([`127.0.0.1:${port}`]);
+
+    const latencies = new Float64Array(n);
+    let started = 0;
+    let finished = 0;
+
+    function startOne() {
+      if (started === n)
+        return;
+      const index = started++;
+      const begin = process.hrtime.bigint();
+      resolver.resolve4(`q${index}.example.org`, (err) => {
+        if (err)
+          throw err;
+        latencies[index] = Number(process.hrtime.bigint() - begin) / 1e6;
+        if (++finished === n) {
+          bench.end(n);
+          reportLatency(latencies);
+          server.close();
+          return;
+        }
+        startOne();
+      });
+    }
+
+    bench.start();
+    for (let i = 0; i < Math.min(concurrency, n); i++)
+      startOne();
+  });
+}
@@ -0,0 +1,57 @@
+'use strict';
+
+// Resolver throughput and tail latency against an in-process mock DNS
+// server, so cache and coalescing changes can be measured repeatably.
+// `names=unique` makes every query hit the wire; `names=same` resolves one
+// name over and over, exercising the response cache and in-flight
+// coalescing. `delay` adds a fixed server-side response delay.
+
+const common = require('../common.js');
+const dns = require('dns');
+const {
+  createMockDNSServer,
+  reportLatency,
+} = require('./_mock-dns-server.js');
+
+const bench = common.createBenchmark(main, {
+  n: [2e3],
+  concurrency: [10, 100],
+  names: ['unique', 'same'],
+  delay: [0, 1],
+});
+
+function main({ n, concurrency, names, delay }) {
+  const server = createMockDNSServer({ delay }, (port) => {
+    const resolver = new dns.Resolver();
+    resolver.setServers([`127.0.0.1:${port}`]);
+
+    const latencies = new Float64Array(n);
+    let started = 0;
+    let finished = 0;
+
+    function startOne() {
+      if (started === n)
+        return;
+      const index = started++;
+      const name = names === 'unique' ?
+        `q${index}.example.org` : 'q.example.org';
+      const begin = process.hrtime.bigint();
+      resolver.resolve4(name, (err) => {
+        if (err)
+          throw err;
+        latencies[index] = Number(process.hrtime.bigint() - begin) / 1e6;
+        if (++finished === n) {
+          bench.end(n);
+          reportLatency(latencies);
+          server.close();
+          return;
+        }
+        startOne();
+      });
+    }
+
+    bench.start();
+    for (let i = 0; i < Math.min(concurrency, n); i++)
+      startOne();
+  });
+}
@@ -0,0 +1,112 @@
+// Latency-under-concurrency harness for the fs threadpool paths.
+//
+// The other fs benchmarks measure single-stream throughput, which hides
+// the tail latency that appears once the threadpool is saturated. This
+// driver keeps `concurrent` fs operations of a configurable `mix` in
+// flight for `dur` seconds, optionally alongside `cryptoload` pbkdf2
+// loops that compete for the same threadpool, and records every
+// operation's latency into a native hdr histogram. The op rate goes
+// through the usual bench.end() reporting; per-op-type p50/p99/p999
+// (in microseconds) are printed to stderr so threadpool and I/O engine
+// changes can be judged on tail latency rather than MB/s.
+
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+const crypto = require('crypto');
+
+const filename = path.resolve(__dirname,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  concurrent: [4, 16],
+  mix: ['read', 'stat', 'write', 'all'],
+  cryptoload: [0, 2]
+}, { flags: ['--expose-internals'] });
+
+const kFileSize = 16 * 1024 * 1024;
+const kIoSize = 4096;
+
+function main({ dur, concurrent, mix, cryptoload }) {
+  const { createHistogram } = require('internal/histogram');
+
+  try { fs.unlinkSync(filename); } catch {}
+  fs.writeFileSync(filename, Buffer.alloc(kFileSize, 'x'));
+
+  const fd = fs.openSync(filename, 'r+');
+  const opTypes = mix === 'all' ? ['read', 'stat', 'write'] : [mix];
+  const histograms = {};
+  for (const type of opTypes)
+    histograms[type] = createHistogram();
+
+  let ops = 0;
+  let benchEnded = false;
+
+  function randomOffset() {
+    return Math.floor(Math.random() * (kFileSize - kIoSize));
+  }
+
+  const operations = {
+    read(buf, cb) {
+      fs.read(fd, buf, 0, kIoSize, randomOffset(), cb);
+    },
+    stat(buf, cb) {
+      fs.stat(filename, cb);
+    },
+    write(buf, cb) {
+      fs.write(fd, buf, 0, kIoSize, randomOffset(), cb);
+    }
+  };
+
+  function worker(type) {
+    const buf = Buffer.alloc(kIoSize, 'y');
+    const histogram = histograms[type];
+    const op = operations[type];
+    (function next() {
+      if (benchEnded)
+        return;
+      const started = process.hrtime.bigint();
+      op(buf, (err) => {
+        if (err && !benchEnded)
+          throw err;
+        if (benchEnded)
+          return;
+        // Latencies are recorded in nanoseconds.
+        histogram.record(Number(process.hrtime.bigint() - started));
+        ops++;
+        next();
+      });
+    })();
+  }
+
+  // Competing threadpool work; not counted as fs ops.
+  function cryptoWorker() {
+    if (benchEnded)
+      return;
+    crypto.pbkdf2('password', 'salt', 5000, 32, 'sha256', cryptoWorker);
+  }
+
+  bench.start();
+  for (let i = 0; i < concurrent; i++)
+    worker(opTypes[i % opTypes.length]);
+  for (let i = 0; i < cryptoload; i++)
+    cryptoWorker();
+
+  setTimeout(() => {
+    benchEnded = true;
+    bench.end(ops);
+    for (const type of opTypes) {
+      const histogram = histograms[type];
+      if (histogram.max === 0)
+        continue;
+      console.error(`${type}: p50=${histogram.percentile(50) / 1e3}us ` +
+                    `p99=${histogram.percentile(99) / 1e3}us ` +
+                    `p999=${histogram.percentile(99.9) / 1e3}us`);
+    }
+    fs.closeSync(fd);
+    try { fs.unlinkSync(filename); } catch {}
+  }, dur * 1000);
+}
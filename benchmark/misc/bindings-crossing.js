@@ -0,0 +1,90 @@
+// Microbenchmarks for the raw JS<->C++ crossing primitives, so that changes
+// to the dispatch machinery (src/api/callback.cc, async_wrap.cc, the fast
+// binding paths) show their overhead deltas immediately:
+//
+//   call-empty          zero-argument binding call (timers.getLibuvNow)
+//   call-one-arg        one-argument no-side-effect call (types.isDate)
+//   callback-into-js    full loop-turn dispatch into JS through the
+//                       InternalCallbackScope/MakeCallback machinery,
+//                       measured as a serial setImmediate chain
+//   aliased-buffer-read reading a C++-maintained AliasedBuffer field from JS
+//                       (timers.coarseClockFields), i.e. the zero-crossing
+//                       alternative the binding calls compete against
+//
+// The synchronous methods use runSampled() for confidence intervals at
+// nanosecond resolution; the callback chain is inherently async and uses
+// the classic start()/end() protocol.
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  method: [
+    'call-empty',
+    'call-one-arg',
+    'callback-into-js',
+    'aliased-buffer-read',
+  ],
+  n: [1e6],
+}, {
+  flags: ['--expose-internals', '--no-warnings'],
+});
+
+function main({ method, n }) {
+  switch (method) {
+    case 'call-empty': {
+      const { getLibuvNow } = common.binding('timers');
+      bench.runSampled({ iterations: n }, (iterations) => {
+        let last = 0;
+        for (let i = 0; i < iterations; i++)
+          last = getLibuvNow();
+        if (last < 0)
+          throw new Error('unreachable');
+      });
+      break;
+    }
+
+    case 'call-one-arg': {
+      const { isDate } = common.binding('types');
+      const date = new Date();
+      bench.runSampled({ iterations: n }, (iterations) => {
+        let hits = 0;
+        for (let i = 0; i < iterations; i++) {
+          if (isDate(date))
+            hits++;
+        }
+        if (hits !== iterations)
+          throw new Error('unreachable');
+      });
+      break;
+    }
+
+    case 'callback-into-js': {
+      let count = 0;
+      bench.start();
+      (function next() {
+        if (++count === n) {
+          bench.end(n);
+          return;
+        }
+        setImmediate(next);
+      })();
+      break;
+    }
+
+    case 'aliased-buffer-read': {
+      const { coarseClockFields } = common.binding('timers');
+      bench.runSampled({ iterations: n }, (iterations) => {
+        let acc = 0;
+        for (let i = 0; i < iterations; i++)
+          acc += coarseClockFields[0];
+        if (acc < 0)
+          throw new Error('unreachable');
+      });
+      break;
+    }
+
+    default:
+      throw new Error(`invalid method: ${method}`);
+  }
+}
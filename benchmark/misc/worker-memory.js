@@ -0,0 +1,33 @@
+'use strict';
+// Measures the fixed per-Environment native memory overhead by spawning idle
+// workers and dividing the RSS growth among them. The interesting figure is
+// the reported value itself (bytes of RSS per idle worker), not the rate the
+// harness derives from it.
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  workers: [16],
+});
+
+function main({ workers }) {
+  const spawned = [];
+  let online = 0;
+
+  global.gc?.();
+  const rssBefore = process.memoryUsage().rss;
+
+  bench.start();
+  for (let i = 0; i < workers; i++) {
+    const worker = new Worker('setInterval(() => {}, 1000);', { eval: true });
+    spawned.push(worker);
+    worker.once('online', () => {
+      if (++online < workers) return;
+      // All workers are idle now; attribute the RSS growth to them.
+      global.gc?.();
+      const perWorker = (process.memoryUsage().rss - rssBefore) / workers;
+      bench.end(perWorker);
+      for (const w of spawned) w.terminate();
+    });
+  }
+}
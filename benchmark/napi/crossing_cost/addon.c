@@ -0,0 +1,402 @@
+#include <stddef.h>
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+
+#define NAPI_CALL(env, call)                          \
+  do {                                                \
+    napi_status status = (call);                      \
+    if (status != napi_ok) {                          \
+      napi_throw_error((env), NULL, #call " failed"); \
+      return NULL;                                    \
+    }                                                 \
+  } while (0)
+
+// Locals created inside the measurement loops are released in chunks so a
+// multi-million iteration run does not grow one giant handle scope.
+#define SCOPE_CHUNK 1000
+
+static napi_value
+GetIterations(napi_env env, napi_callback_info info, size_t* n) {
+  size_t argc = 1;
+  napi_value arg;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+  uint32_t n32;
+  NAPI_CALL(env, napi_get_value_uint32(env, arg, &n32));
+  *n = n32;
+  return arg;
+}
+
+static napi_value
+CreateObject(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value obj;
+      NAPI_CALL(env, napi_create_object(env, &obj));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+static napi_value
+CreateStringUtf8(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value str;
+      NAPI_CALL(env, napi_create_string_utf8(
+          env, "crossing-cost", NAPI_AUTO_LENGTH, &str));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+static napi_value
+CreateStringLatin1(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value str;
+      NAPI_CALL(env, napi_create_string_latin1(
+          env, "crossing-cost", NAPI_AUTO_LENGTH, &str));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+static napi_value
+GetNamedProperty(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value obj;
+  napi_value value;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+  NAPI_CALL(env, napi_create_int32(env, 42, &value));
+  NAPI_CALL(env, napi_set_named_property(env, obj, "prop", value));
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value out;
+      NAPI_CALL(env, napi_get_named_property(env, obj, "prop", &out));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+static napi_value
+SetNamedProperty(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value obj;
+  napi_value value;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+  NAPI_CALL(env, napi_create_int32(env, 42, &value));
+
+  for (size_t i = 0; i < n; i++) {
+    NAPI_CALL(env, napi_set_named_property(env, obj, "prop", value));
+  }
+  return NULL;
+}
+
+static napi_value
+GetElement(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value arr;
+  napi_value value;
+  NAPI_CALL(env, napi_create_array_with_length(env, 8, &arr));
+  NAPI_CALL(env, napi_create_int32(env, 42, &value));
+  NAPI_CALL(env, napi_set_element(env, arr, 0, value));
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value out;
+      NAPI_CALL(env, napi_get_element(env, arr, 0, &out));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+static napi_value
+SetElement(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value arr;
+  napi_value value;
+  NAPI_CALL(env, napi_create_array_with_length(env, 8, &arr));
+  NAPI_CALL(env, napi_create_int32(env, 42, &value));
+
+  for (size_t i = 0; i < n; i++) {
+    NAPI_CALL(env, napi_set_element(env, arr, 0, value));
+  }
+  return NULL;
+}
+
+static napi_value
+Reference(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value obj;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+
+  for (size_t i = 0; i < n; i++) {
+    napi_ref ref;
+    NAPI_CALL(env, napi_create_reference(env, obj, 1, &ref));
+    NAPI_CALL(env, napi_delete_reference(env, ref));
+  }
+  return NULL;
+}
+
+static napi_value
+GetReferenceValue(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value obj;
+  napi_ref ref;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+  NAPI_CALL(env, napi_create_reference(env, obj, 1, &ref));
+
+  for (size_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    size_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (size_t j = i; j < end; j++) {
+      napi_value out;
+      NAPI_CALL(env, napi_get_reference_value(env, ref, &out));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+
+  NAPI_CALL(env, napi_delete_reference(env, ref));
+  return NULL;
+}
+
+static napi_value
+Constructor(napi_env env, napi_callback_info info) {
+  napi_value this_arg;
+  NAPI_CALL(env, napi_get_cb_info(env, info, NULL, NULL, &this_arg, NULL));
+  return this_arg;
+}
+
+// Unwrap of a plain object (private-property path).
+static napi_value
+Unwrap(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  static int native = 42;
+  napi_value obj;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+  NAPI_CALL(env, napi_wrap(env, obj, &native, NULL, NULL, NULL));
+
+  for (size_t i = 0; i < n; i++) {
+    void* out;
+    NAPI_CALL(env, napi_unwrap(env, obj, &out));
+  }
+  return NULL;
+}
+
+// Unwrap of a napi_define_class instance (internal-field fast path).
+static napi_value
+UnwrapClass(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  static int native = 42;
+  napi_value ctor;
+  napi_value instance;
+  NAPI_CALL(env, napi_define_class(
+      env, "CrossingCost", NAPI_AUTO_LENGTH, Constructor, NULL, 0, NULL,
+      &ctor));
+  NAPI_CALL(env, napi_new_instance(env, ctor, 0, NULL, &instance));
+  NAPI_CALL(env, napi_wrap(env, instance, &native, NULL, NULL, NULL));
+
+  for (size_t i = 0; i < n; i++) {
+    void* out;
+    NAPI_CALL(env, napi_unwrap(env, instance, &out));
+  }
+  return NULL;
+}
+
+static napi_value
+TypeofNumber(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value num;
+  NAPI_CALL(env, napi_create_int32(env, 42, &num));
+
+  for (size_t i = 0; i < n; i++) {
+    napi_valuetype t;
+    NAPI_CALL(env, napi_typeof(env, num, &t));
+  }
+  return NULL;
+}
+
+static napi_value
+GetValueInt32(napi_env env, napi_callback_info info) {
+  size_t n;
+  if (GetIterations(env, info, &n) == NULL) return NULL;
+
+  napi_value num;
+  NAPI_CALL(env, napi_create_int32(env, 42, &num));
+
+  for (size_t i = 0; i < n; i++) {
+    int32_t out;
+    NAPI_CALL(env, napi_get_value_int32(env, num, &out));
+  }
+  return NULL;
+}
+
+// callFunction(n, fn): calls `fn` n times with no arguments.
+static napi_value
+CallFunction(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  uint32_t n;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &n));
+
+  napi_value recv;
+  NAPI_CALL(env, napi_get_undefined(env, &recv));
+
+  for (uint32_t i = 0; i < n; i += SCOPE_CHUNK) {
+    napi_handle_scope scope;
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    uint32_t end = i + SCOPE_CHUNK < n ? i + SCOPE_CHUNK : n;
+    for (uint32_t j = i; j < end; j++) {
+      napi_value out;
+      NAPI_CALL(env, napi_call_function(env, recv, args[1], 0, NULL, &out));
+    }
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+// Threadsafe-function push cost, measured end to end: n pushes from the main
+// thread through queue and delivery, finishing via the JS `done` callback.
+typedef struct {
+  size_t remaining;
+  napi_ref done;
+  napi_threadsafe_function tsfn;
+} tsfn_state;
+
+static tsfn_state the_tsfn_state;
+
+static void
+TsfnCallJs(napi_env env, napi_value js_cb, void* context, void* data) {
+  tsfn_state* state = (tsfn_state*)context;
+  if (--state->remaining != 0) return;
+  if (env == NULL) return;
+
+  napi_value done;
+  napi_value recv;
+  napi_value unused;
+  if (napi_get_reference_value(env, state->done, &done) != napi_ok) return;
+  if (napi_get_undefined(env, &recv) != napi_ok) return;
+  if (napi_call_function(env, recv, done, 0, NULL, &unused) != napi_ok)
+    return;
+  napi_delete_reference(env, state->done);
+}
+
+static napi_value
+TsfnPush(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  uint32_t n;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &n));
+
+  tsfn_state* state = &the_tsfn_state;
+  state->remaining = n;
+  NAPI_CALL(env, napi_create_reference(env, args[1], 1, &state->done));
+
+  napi_value name;
+  NAPI_CALL(env, napi_create_string_utf8(
+      env, "crossing-cost-tsfn", NAPI_AUTO_LENGTH, &name));
+  NAPI_CALL(env, napi_create_threadsafe_function(
+      env, NULL, NULL, name, 0, 1, NULL, NULL, state, TsfnCallJs,
+      &state->tsfn));
+
+  for (uint32_t i = 0; i < n; i++) {
+    NAPI_CALL(env, napi_call_threadsafe_function(
+        state->tsfn, NULL, napi_tsfn_nonblocking));
+  }
+  NAPI_CALL(env, napi_release_threadsafe_function(
+      state->tsfn, napi_tsfn_release));
+  return NULL;
+}
+
+NAPI_MODULE_INIT(/* napi_env env, napi_value exports */) {
+  napi_property_descriptor props[] = {
+    { "createObject", NULL, CreateObject,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "createStringUtf8", NULL, CreateStringUtf8,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "createStringLatin1", NULL, CreateStringLatin1,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getNamedProperty", NULL, GetNamedProperty,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "setNamedProperty", NULL, SetNamedProperty,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getElement", NULL, GetElement,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "setElement", NULL, SetElement,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "reference", NULL, Reference,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getReferenceValue", NULL, GetReferenceValue,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "unwrap", NULL, Unwrap,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "unwrapClass", NULL, UnwrapClass,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "typeofNumber", NULL, TypeofNumber,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getValueInt32", NULL, GetValueInt32,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "callFunction", NULL, CallFunction,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+    { "tsfnPush", NULL, TsfnPush,
+      NULL, NULL, NULL, napi_enumerable, NULL },
+  };
+
+  NAPI_CALL(env, napi_define_properties(env,
+                                        exports,
+                                        sizeof(props) / sizeof(*props),
+                                        props));
+
+  return exports;
+}
@@ -0,0 +1,57 @@
+'use strict';
+// Measures the per-operation cost of the hot napi_* entry points. Each op
+// loops n times inside the addon, so the reported rate is dominated by the
+// N-API crossing itself rather than the JS driver.
+const common = require('../../common');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/addon`);
+} catch {
+  console.error('napi/crossing_cost/index.js Binding failed to load');
+  process.exit(0);
+}
+
+const ops = [
+  'createObject',
+  'createStringUtf8',
+  'createStringLatin1',
+  'getNamedProperty',
+  'setNamedProperty',
+  'getElement',
+  'setElement',
+  'reference',
+  'getReferenceValue',
+  'unwrap',
+  'unwrapClass',
+  'typeofNumber',
+  'getValueInt32',
+  'callFunction',
+  'tsfnPush',
+];
+
+const bench = common.createBenchmark(main, {
+  n: [1e6],
+  op: ops,
+});
+
+function noop() {}
+
+function main({ n, op }) {
+  switch (op) {
+    case 'tsfnPush':
+      bench.start();
+      binding.tsfnPush(n, () => bench.end(n));
+      break;
+    case 'callFunction':
+      bench.start();
+      binding.callFunction(n, noop);
+      bench.end(n);
+      break;
+    default:
+      bench.start();
+      binding[op](n);
+      bench.end(n);
+      break;
+  }
+}
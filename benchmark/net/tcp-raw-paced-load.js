@@ -0,0 +1,245 @@
+// Load-generation rig over the raw TCP/Pipe wraps: many connections sending
+// paced small messages against an echo server, instead of the full-speed
+// single-connection pump the other tcp-raw benchmarks drive. Writes are
+// released by a per-connection token bucket targeting `rate` messages per
+// second, message sizes follow a configurable distribution, and per-message
+// round-trip latency is recorded into a native hdr_histogram, so stream-layer
+// changes (corking, batching, allocation) are measurable under a realistic
+// load shape. Reports messages per second plus p50/p90/p99 latency.
+'use strict';
+
+const common = require('../common.js');
+const util = require('util');
+
+const bench = common.createBenchmark(main, {
+  conn: [10, 100],
+  rate: [1000],  // Messages per second per connection.
+  size: ['small', 'mixed', 'large'],
+  transport: ['tcp', 'pipe'],
+  dur: [5],
+}, {
+  flags: ['--expose-internals', '--no-warnings'],
+});
+
+// The pacing tick; also bounds how bursty a refill can get.
+const kTickMs = 5;
+// Per-connection cap on echoes still in flight, so a slow server results in
+// a lowered rate instead of an unbounded queue.
+const kMaxPending = 1024;
+
+const kSmallLen = 64;
+const kLargeLen = 16384;
+
+function main({ conn, rate, size, transport, dur }) {
+  const { createHistogram } = require('internal/histogram');
+  const { WriteWrap } = common.binding('stream_wrap');
+
+  function fail(err, syscall) {
+    throw util._errnoException(err, syscall);
+  }
+
+  let serverHandle;
+  let makeClientHandle;
+  let connectClient;
+  if (transport === 'tcp') {
+    const {
+      TCP,
+      TCPConnectWrap,
+      constants: TCPConstants
+    } = common.binding('tcp_wrap');
+
+    serverHandle = new TCP(TCPConstants.SERVER);
+    let err = serverHandle.bind('127.0.0.1', common.PORT);
+    if (err)
+      fail(err, 'bind');
+
+    makeClientHandle = () => new TCP(TCPConstants.SOCKET);
+    connectClient = (handle, oncomplete) => {
+      const req = new TCPConnectWrap();
+      req.oncomplete = oncomplete;
+      err = handle.connect(req, '127.0.0.1', common.PORT);
+      if (err)
+        fail(err, 'connect');
+    };
+  } else {
+    const {
+      Pipe,
+      PipeConnectWrap,
+      constants: PipeConstants
+    } = common.binding('pipe_wrap');
+    const pipeName = process.platform === 'win32' ?
+      `\\\\.\\pipe\\nodebench.${process.pid}.sock` :
+      require('path').join(require('os').tmpdir(),
+                           `nodebench-${process.pid}.sock`);
+    if (process.platform !== 'win32') {
+      try {
+        require('fs').unlinkSync(pipeName);
+      } catch {}
+    }
+
+    serverHandle = new Pipe(PipeConstants.SERVER);
+    let err = serverHandle.bind(pipeName);
+    if (err)
+      fail(err, 'bind');
+
+    makeClientHandle = () => new Pipe(PipeConstants.SOCKET);
+    connectClient = (handle, oncomplete) => {
+      const req = new PipeConnectWrap();
+      req.oncomplete = oncomplete;
+      err = handle.connect(req, pipeName, oncomplete);
+      if (err)
+        fail(err, 'connect');
+    };
+  }
+
+  let err = serverHandle.listen(511);
+  if (err)
+    fail(err, 'listen');
+
+  serverHandle.onconnection = function(err, clientHandle) {
+    if (err)
+      fail(err, 'connect');
+
+    // Pure echo; the client does its accounting by byte count, so the
+    // server does not need to parse message boundaries.
+    clientHandle.onread = function(buffer) {
+      if (!buffer)
+        return;
+
+      const writeReq = new WriteWrap();
+      writeReq.oncomplete = afterEchoWrite;
+      const writeErr = clientHandle.writeBuffer(writeReq, Buffer.from(buffer));
+      if (writeErr)
+        fail(writeErr, 'write');
+    };
+
+    clientHandle.readStart();
+  };
+
+  function afterEchoWrite(err) {
+    if (err)
+      fail(err, 'write');
+  }
+
+  const smallChunk = Buffer.alloc(kSmallLen, 'x');
+  const largeChunk = Buffer.alloc(kLargeLen, 'x');
+  function nextChunk() {
+    switch (size) {
+      case 'small':
+        return smallChunk;
+      case 'large':
+        return largeChunk;
+      case 'mixed':
+        // Bimodal: mostly small control-plane messages with the occasional
+        // large payload, as seen on typical RPC connections.
+        return Math.random() < 0.9 ? smallChunk : largeChunk;
+      default:
+        throw new Error(`invalid size: ${size}`);
+    }
+  }
+
+  const histogram = createHistogram();
+  const burst = Math.max(rate / 20, 1);
+  const clients = [];
+  let connected = 0;
+  let messages = 0;
+  let started = null;
+
+  function makeClient() {
+    const client = {
+      handle: makeClientHandle(),
+      // Queue of { time, len } for messages whose echo is still pending;
+      // the transport preserves ordering, so echoes complete head-first.
+      pending: [],
+      // Echoed bytes not yet attributed to the head pending message.
+      receivedBytes: 0,
+      tokens: 0,
+    };
+
+    client.handle.onread = function(buffer) {
+      if (!buffer)
+        return;
+      const now = process.hrtime.bigint();
+      client.receivedBytes += buffer.byteLength;
+      while (client.pending.length > 0 &&
+             client.receivedBytes >= client.pending[0].len) {
+        const message = client.pending.shift();
+        client.receivedBytes -= message.len;
+        if (started !== null) {
+          messages++;
+          const latency = Number(now - message.time);
+          if (latency >= 1)
+            histogram.record(latency);
+        }
+      }
+    };
+
+    connectClient(client.handle, (err) => {
+      if (err)
+        fail(err, 'connect');
+      client.handle.readStart();
+      if (++connected === conn)
+        startLoad();
+    });
+
+    return client;
+  }
+
+  function sendMessage(client) {
+    const chunk = nextChunk();
+    client.pending.push({ time: process.hrtime.bigint(), len: chunk.length });
+    const writeReq = new WriteWrap();
+    writeReq.oncomplete = afterLoadWrite;
+    const writeErr = client.handle.writeBuffer(writeReq, chunk);
+    if (writeErr)
+      fail(writeErr, 'write');
+  }
+
+  function afterLoadWrite(err) {
+    if (err)
+      fail(err, 'write');
+  }
+
+  function startLoad() {
+    started = process.hrtime();
+    let lastTick = process.hrtime.bigint();
+
+    const pacer = setInterval(() => {
+      const now = process.hrtime.bigint();
+      const dt = Number(now - lastTick) / 1e9;
+      lastTick = now;
+      for (const client of clients) {
+        client.tokens = Math.min(client.tokens + rate * dt, burst);
+        while (client.tokens >= 1 && client.pending.length < kMaxPending) {
+          client.tokens -= 1;
+          sendMessage(client);
+        }
+      }
+    }, kTickMs);
+
+    setTimeout(() => {
+      clearInterval(pacer);
+      const elapsed = process.hrtime(started);
+
+      const stats = {
+        n: messages,
+        rejected: 0,
+        mean: histogram.mean,
+        stddev: histogram.stddev,
+        moe: messages > 1 ?
+          1.96 * histogram.stddev / Math.sqrt(messages) : 0,
+        percentiles: {
+          p50: histogram.percentile(50),
+          p90: histogram.percentile(90),
+          p99: histogram.percentile(99),
+        },
+      };
+      const time = elapsed[0] + elapsed[1] / 1e9;
+      bench.report(messages / time, elapsed, null, stats);
+      process.exit(0);
+    }, dur * 1000);
+  }
+
+  for (let i = 0; i < conn; i++)
+    clients.push(makeClient());
+}
@@ -0,0 +1,20 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  algorithm: ['crc32', 'crc32c', 'adler32'],
+  len: [1024, 64 * 1024, 1024 * 1024],
+  n: [1e5]
+});
+
+function main({ n, algorithm, len }) {
+  const chunk = Buffer.alloc(len, 'a');
+  const fn = zlib[algorithm];
+
+  let value = 0;
+  bench.start();
+  for (let i = 0; i < n; i++)
+    value = fn(chunk, value);
+  bench.end(n);
+}
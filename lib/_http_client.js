@@ -46,7 +46,11 @@ const {
 const { OutgoingMessage } = require('_http_outgoing');
 const Agent = require('_http_agent');
 const { Buffer } = require('buffer');
-const { defaultTriggerAsyncIdScope } = require('internal/async_hooks');
+const {
+  defaultTriggerAsyncIdScope,
+  initHooksExist,
+  destroyHooksExist
+} = require('internal/async_hooks');
 const { URL, urlToOptions, searchParamsSymbol } = require('internal/url');
 const { kOutHeaders, kNeedDrain } = require('internal/http');
 const { connResetException, codes } = require('internal/errors');
@@ -680,8 +684,13 @@ function emitFreeNT(req) {
 function tickOnSocket(req, socket) {
   const parser = parsers.alloc();
   req.socket = socket;
+  // Only pay for a fresh async identity on the recycled parser when
+  // async_hooks can actually observe it; see connectionListenerInternal()
+  // in _http_server.js.
   parser.initialize(HTTPParser.RESPONSE,
-                    new HTTPClientAsyncResource('HTTPINCOMINGMESSAGE', req),
+                    initHooksExist() || destroyHooksExist() ?
+                      new HTTPClientAsyncResource('HTTPINCOMINGMESSAGE', req) :
+                      null,
                     req.maxHeaderSize || 0,
                     isLenient());
   parser.socket = socket;
@@ -54,7 +54,9 @@ const {
 } = require('internal/http');
 const {
   defaultTriggerAsyncIdScope,
-  getOrSetAsyncId
+  getOrSetAsyncId,
+  initHooksExist,
+  destroyHooksExist
 } = require('internal/async_hooks');
 const { IncomingMessage } = require('_http_incoming');
 const {
@@ -412,9 +414,13 @@ function connectionListenerInternal(server, socket) {
   // TODO(addaleax): This doesn't play well with the
   // `async_hooks.currentResource()` proposal, see
   // https://github.com/nodejs/node/pull/21313
+  // Creating a fresh async resource (and with it a fresh async identity for
+  // the recycled parser) is only observable through async_hooks; skip both
+  // when no hooks are installed so parser reuse stays allocation-free.
   parser.initialize(
     HTTPParser.REQUEST,
-    new HTTPServerAsyncResource('HTTPINCOMINGMESSAGE', socket),
+    initHooksExist() || destroyHooksExist() ?
+      new HTTPServerAsyncResource('HTTPINCOMINGMESSAGE', socket) : null,
     server.maxHeaderSize || 0,
     isLenient(),
   );
@@ -136,6 +136,30 @@ function onhandshakedone() {
   owner._finishInit();
 }
 
+// TLS1.3 0-RTT early data arrived with a resumed handshake. Early data is
+// replayable by a network attacker, so it stays parked in the handle until
+// a listener explicitly opens the gate by calling accept(); with nobody
+// listening, opting in through the server's `maxEarlyData` option is taken
+// as consent and the data flows immediately.
+function onearlydata() {
+  debug('server onearlydata');
+
+  const owner = this[owner_symbol];
+  assert(owner._tlsOptions.isServer);
+
+  let once = false;
+  const accept = () => {
+    if (once)
+      return;
+    once = true;
+    if (owner._handle !== null)
+      owner._handle.acceptEarlyData();
+  };
+
+  if (!owner.server || !owner.server.emit('earlyData', owner, accept))
+    accept();
+}
+
 
 function loadSession(hello) {
   debug('server onclienthello',
@@ -679,6 +703,10 @@ TLSSocket.prototype._init = function(socket, wrap) {
         ssl.enableKeylogCallback();
       if (this.server.listenerCount('OCSPRequest') > 0)
         ssl.enableCertCb();
+      if (this.server.maxEarlyData) {
+        ssl.onearlydata = onearlydata;
+        ssl.enableEarlyData();
+      }
     }
   } else {
     ssl.onhandshakestart = noop;
@@ -935,6 +963,12 @@ TLSSocket.prototype._start = function() {
 
   if (this._tlsOptions.requestOCSP)
     this._handle.requestOCSP();
+
+  // TLS1.3 0-RTT: hand the early data to OpenSSL before kicking off the
+  // handshake so it rides out in the same flight as the ClientHello.
+  if (this._tlsOptions.earlyData && this._tlsOptions.session)
+    this.writeEarlyData(this._tlsOptions.earlyData);
+
   this._handle.start();
 };
 
@@ -954,6 +988,40 @@ TLSSocket.prototype.setSession = function(session) {
   this._handle.setSession(session);
 };
 
+// Send application data in the first flight of a resumed TLS1.3 handshake
+// (0-RTT), before the handshake completes. Returns the number of bytes the
+// session accepted as early data; 0 when the server did not announce early
+// data support in the ticket. Rejected early data is never retransmitted
+// automatically - check getEarlyDataStatus() after 'secureConnect' and
+// rewrite through the regular stream if it comes back 'rejected'.
+TLSSocket.prototype.writeEarlyData = function(data, encoding) {
+  if (typeof data === 'string')
+    data = Buffer.from(data, encoding);
+  if (!isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+
+  if (!this._handle || this._tlsOptions.isServer)
+    return 0;
+
+  return this._handle.writeEarlyData(data);
+};
+
+TLSSocket.prototype.getEarlyDataStatus = function() {
+  if (!this._handle)
+    return null;
+
+  switch (this._handle.getEarlyDataStatus()) {
+    case tls_wrap.SSL_EARLY_DATA_ACCEPTED:
+      return 'accepted';
+    case tls_wrap.SSL_EARLY_DATA_REJECTED:
+      return 'rejected';
+    default:
+      return 'not-sent';
+  }
+};
+
 TLSSocket.prototype.getPeerCertificate = function(detailed) {
   if (this._handle) {
     return common.translatePeerCertificate(
@@ -1149,6 +1217,21 @@ function Server(options, listener) {
   if (options.sessionTimeout)
     this.sessionTimeout = options.sessionTimeout;
 
+  // TLS1.3 0-RTT: allow resuming clients to send up to this many bytes of
+  // early data; delivery is gated on the 'earlyData' event (replay safety).
+  if (options.maxEarlyData)
+    this.maxEarlyData = options.maxEarlyData;
+
+  // Store and resume sessions through a cache shared by every server in
+  // the process, including servers on other worker threads.
+  if (options.sharedSessionCache)
+    this.sharedSessionCache = true;
+
+  // Run the RSA private key operation of full handshakes on the libuv
+  // threadpool instead of the event loop.
+  if (options.asyncPrivateKey)
+    this.asyncPrivateKey = true;
+
   if (options.ticketKeys)
     this.ticketKeys = options.ticketKeys;
 
@@ -1314,6 +1397,15 @@ Server.prototype.setSecureContext = function(options) {
   if (this.sessionTimeout)
     this._sharedCreds.context.setSessionTimeout(this.sessionTimeout);
 
+  if (this.maxEarlyData)
+    this._sharedCreds.context.setMaxEarlyData(this.maxEarlyData);
+
+  if (this.sharedSessionCache)
+    this._sharedCreds.context.enableSharedSessionCache();
+
+  if (this.asyncPrivateKey)
+    this._sharedCreds.context.enableAsyncPrivateKey();
+
   if (options.ticketKeys) {
     this.ticketKeys = options.ticketKeys;
     this.setTicketKeys(this.ticketKeys);
@@ -1571,6 +1663,7 @@ exports.connect = function connect(...args) {
     requestOCSP: options.requestOCSP,
     enableTrace: options.enableTrace,
     pskCallback: options.pskCallback,
+    earlyData: options.earlyData,
   });
 
   tlssock[kConnectOptions] = options;
@@ -8,9 +8,10 @@ const {
 
 const {
   ERR_ASYNC_CALLBACK,
+  ERR_INVALID_ARG_VALUE,
   ERR_INVALID_ASYNC_ID
 } = require('internal/errors').codes;
-const { validateString } = require('internal/validators');
+const { validateString, validateUint32 } = require('internal/validators');
 const internal_async_hooks = require('internal/async_hooks');
 
 // Get functions
@@ -32,6 +33,8 @@ const {
   emitAfter,
   emitDestroy,
   initHooksExist,
+  getAsyncContextFrame,
+  setAsyncContextFrame,
 } = internal_async_hooks;
 
 // Get symbols
@@ -130,9 +133,29 @@ function createHook(fns) {
 }
 
 
+// Sampling API //
+
+function setSampleInterval(interval) {
+  validateUint32(interval, 'interval');
+  internal_async_hooks.setSampleInterval(interval);
+}
+
+
+// Promise Tracking API //
+
+function setPromiseTrackingMode(mode) {
+  if (mode !== 'full' && mode !== 'lightweight') {
+    throw new ERR_INVALID_ARG_VALUE('mode', mode,
+                                    "must be 'full' or 'lightweight'");
+  }
+  internal_async_hooks.setPromiseTrackingMode(mode);
+}
+
+
 // Embedder API //
 
 const destroyedSymbol = Symbol('destroyed');
+const contextFrameSymbol = Symbol('contextFrame');
 
 class AsyncResource {
   constructor(type, opts = {}) {
@@ -155,6 +178,7 @@ class AsyncResource {
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    this[contextFrameSymbol] = getAsyncContextFrame();
 
     if (initHooksExist()) {
       emitInit(asyncId, type, triggerAsyncId, this);
@@ -172,9 +196,16 @@ class AsyncResource {
     const asyncId = this[async_id_symbol];
     emitBefore(asyncId, this[trigger_async_id_symbol]);
 
-    const ret = thisArg === undefined ?
-      fn(...args) :
-      ReflectApply(fn, thisArg, args);
+    const prevFrame = getAsyncContextFrame();
+    setAsyncContextFrame(this[contextFrameSymbol]);
+    let ret;
+    try {
+      ret = thisArg === undefined ?
+        fn(...args) :
+        ReflectApply(fn, thisArg, args);
+    } finally {
+      setAsyncContextFrame(prevFrame);
+    }
 
     emitAfter(asyncId);
     return ret;
@@ -205,6 +236,10 @@ module.exports = {
   createHook,
   executionAsyncId,
   triggerAsyncId,
+  setSampleInterval,
+  setPromiseTrackingMode,
+  getAsyncContextFrame,
+  setAsyncContextFrame,
   // Embedder API
   AsyncResource,
 };
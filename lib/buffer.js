@@ -45,9 +45,11 @@ const {
   compareOffset,
   createFromString,
   fill: bindingFill,
+  indexOfAnyBuffer,
   indexOfBuffer,
   indexOfNumber,
   indexOfString,
+  sliceRetained: bindingSliceRetained,
   swap16: _swap16,
   swap32: _swap32,
   swap64: _swap64,
@@ -101,6 +103,8 @@ const {
   addBufferPrototypeMethods
 } = require('internal/buffer');
 
+const { DTRACE_BUFFER_POOL_REFILL } = require('internal/dtrace');
+
 FastBuffer.prototype.constructor = Buffer;
 Buffer.prototype = FastBuffer.prototype;
 addBufferPrototypeMethods(Buffer.prototype);
@@ -141,6 +145,10 @@ function createUnsafeBuffer(size) {
 }
 
 function createPool() {
+  // Report the occupancy of the pool being retired, so probe consumers can
+  // watch fill levels without instrumenting every allocation.
+  if (allocPool !== undefined)
+    DTRACE_BUFFER_POOL_REFILL(poolOffset, poolSize);
   poolSize = Buffer.poolSize;
   allocPool = createUnsafeBuffer(poolSize).buffer;
   poolOffset = 0;
@@ -943,6 +951,47 @@ Buffer.prototype.includes = function includes(val, byteOffset, encoding) {
   return this.indexOf(val, byteOffset, encoding) !== -1;
 };
 
+const indexOfAnyResult = new Uint32Array(2);
+
+// Finds the earliest occurrence of any of the given needles in a single
+// forward pass. Needles are matched byte-wise; strings are converted with
+// the given encoding (utf8 by default). Returns { offset, needle } for
+// the leftmost match — ties resolve to the needle listed first — or null
+// when none of the needles occur.
+Buffer.prototype.indexOfAny = function indexOfAny(needles, byteOffset,
+                                                  encoding) {
+  if (!ArrayIsArray(needles))
+    throw new ERR_INVALID_ARG_TYPE('needles', 'Array', needles);
+  if (needles.length === 0 || needles.length > 32) {
+    throw new ERR_OUT_OF_RANGE('needles.length', '>= 1 and <= 32',
+                               needles.length);
+  }
+  const converted = new Array(needles.length);
+  for (let i = 0; i < needles.length; i++) {
+    const needle = needles[i];
+    if (typeof needle === 'string')
+      converted[i] = fromString(needle, encoding || 'utf8');
+    else if (isUint8Array(needle))
+      converted[i] = needle;
+    else
+      throw new ERR_INVALID_ARG_TYPE(`needles[${i}]`,
+                                     ['string', 'Buffer', 'Uint8Array'],
+                                     needle);
+    if (converted[i].length === 0) {
+      throw new ERR_INVALID_ARG_VALUE(`needles[${i}]`, needle,
+                                      'must not be empty');
+    }
+  }
+  byteOffset = byteOffset === undefined ? 0 : +byteOffset;
+  if (NumberIsNaN(byteOffset) || byteOffset < 0)
+    byteOffset = 0;
+  if (byteOffset >= this.length)
+    return null;
+  if (!indexOfAnyBuffer(this, converted, byteOffset, indexOfAnyResult))
+    return null;
+  return { offset: indexOfAnyResult[0], needle: indexOfAnyResult[1] };
+};
+
 // Usage:
 //    buffer.fill(number[, offset[, end]])
 //    buffer.fill(buffer[, offset[, end]])
@@ -1084,6 +1133,19 @@ Buffer.prototype.slice = function slice(start, end) {
   return new FastBuffer(this.buffer, this.byteOffset + start, newLength);
 };
 
+// Like slice(), but the returned Buffer pins the underlying memory on its
+// own: it remains valid after this Buffer and its ArrayBuffer have been
+// garbage collected, and the backing allocation is only released once the
+// last retained slice is gone. The memory itself is shared, so writes are
+// visible both ways just as with slice(), but the returned Buffer has its
+// own ArrayBuffer and does not keep the source's alive.
+Buffer.prototype.sliceRetained = function sliceRetained(start, end) {
+  const srcLength = this.length;
+  start = adjustOffset(start, srcLength);
+  end = end !== undefined ? adjustOffset(end, srcLength) : srcLength;
+  return bindingSliceRetained(this, start, end > start ? end : start);
+};
+
 function swap(b, n, m) {
   const i = b[n];
   b[n] = b[m];
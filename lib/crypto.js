@@ -99,7 +99,8 @@ const {
   getHashes,
   setDefaultEncoding,
   setEngine,
-  timingSafeEqual
+  timingSafeEqual,
+  timingSafeEqualMany
 } = require('internal/crypto/util');
 const Certificate = require('internal/crypto/certificate');
 
@@ -183,6 +184,7 @@ module.exports = {
   sign: signOneShot,
   setEngine,
   timingSafeEqual,
+  timingSafeEqualMany,
   getFips: !fipsMode ? getFipsDisabled :
     fipsForced ? getFipsForced : getFipsCrypto,
   setFips: !fipsMode ? setFipsDisabled :
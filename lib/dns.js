@@ -38,6 +38,8 @@ const {
   setDefaultResolver,
   Resolver,
   validateHints,
+  validateLookupMode,
+  lookupViaResolver,
   emitInvalidHostnameWarning,
 } = require('internal/dns/utils');
 const {
@@ -96,6 +98,7 @@ function lookup(hostname, options, callback) {
   let family = -1;
   let all = false;
   let verbatim = false;
+  let mode;
 
   // Parse arguments
   if (hostname && typeof hostname !== 'string') {
@@ -110,8 +113,10 @@ function lookup(hostname, options, callback) {
     family = options.family >>> 0;
     all = options.all === true;
     verbatim = options.verbatim === true;
+    mode = options.mode;
 
     validateHints(hints);
+    validateLookupMode(mode);
   } else {
     family = options >>> 0;
   }
@@ -140,6 +145,11 @@ function lookup(hostname, options, callback) {
     return {};
   }
 
+  if (mode === 'resolver') {
+    lookupViaResolver(hostname, family, all, verbatim, callback);
+    return {};
+  }
+
   const req = new GetAddrInfoReqWrap();
   req.callback = callback;
   req.family = family;
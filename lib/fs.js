@@ -25,6 +25,7 @@
 'use strict';
 
 const {
+  ArrayIsArray,
   Map,
   MathMax,
   NumberIsSafeInteger,
@@ -46,7 +47,9 @@ const {
   W_OK,
   X_OK,
   O_WRONLY,
-  O_SYMLINK
+  O_SYMLINK,
+  COPYFILE_FICLONE,
+  COPYFILE_PARALLEL
 } = constants;
 
 const pathModule = require('path');
@@ -63,7 +66,7 @@ const {
   uvException
 } = require('internal/errors');
 
-const { FSReqCallback, statValues } = binding;
+const { FSReqCallback, statValues, kFsStatsFieldsNumber } = binding;
 const { toPathIfFileURL } = require('internal/url');
 const internalUtil = require('internal/util');
 const {
@@ -91,7 +94,8 @@ const {
 const {
   Dir,
   opendir,
-  opendirSync
+  opendirSync,
+  walkdir
 } = require('internal/fs/dir');
 const {
   CHAR_FORWARD_SLASH,
@@ -290,9 +294,42 @@ function readFileAfterStat(err, stats) {
   context.read();
 }
 
+// Maps the file instead of read(2)ing it; the returned Buffer is backed by
+// the (copy-on-write) mapping, so loading costs page faults rather than
+// copies and concurrent processes reading the same file share page cache.
+// Only used when the caller opts in, with plain paths (not fds) and the
+// default 'r' flag, since the mapping path always opens read-only.
+function useMmapRead(options, path) {
+  return options.mmap && binding.mmapRead !== undefined && !isFd(path) &&
+         options.flag === 'r';
+}
+
+function tryMmapReadSync(path) {
+  path = getValidatedPath(path);
+  const ctx = {};
+  const result = binding.mmapRead(pathModule.toNamespacedPath(path), ctx);
+  handleErrorFromBinding(ctx);
+  return result;
+}
+
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
+
+  if (useMmapRead(options, path)) {
+    let result;
+    try {
+      result = tryMmapReadSync(path);
+    } catch (err) {
+      process.nextTick(callback, err);
+      return;
+    }
+    process.nextTick(callback, null,
+                     options.encoding ?
+                       result.toString(options.encoding) : result);
+    return;
+  }
+
   if (!ReadFileContext)
     ReadFileContext = require('internal/fs/read_file_context');
   const context = new ReadFileContext(callback, options.encoding);
@@ -355,6 +392,13 @@ function tryReadSync(fd, isUserFd, buffer, pos, len) {
 
 function readFileSync(path, options) {
   options = getOptions(options, { flag: 'r' });
+
+  if (useMmapRead(options, path)) {
+    const result = tryMmapReadSync(path);
+    return options.encoding ?
+      result.toString(options.encoding) : result;
+  }
+
   const isUserFd = isFd(path); // File descriptor ownership
   const fd = isUserFd ? path : fs.openSync(path, options.flag, 0o666);
 
@@ -923,6 +967,82 @@ function stat(path, options = { bigint: false }, callback) {
   binding.stat(pathModule.toNamespacedPath(path), options.bigint, req);
 }
 
+// Stats every path in `paths` as a single threadpool task with a single
+// completion callback, instead of one req and one loop wakeup per path.
+// The callback receives (err, stats, errors) where `stats[i]` is an fs.Stats
+// for paths[i] or null if it could not be statted, and `errors` is an
+// Int32Array of the per-path libuv error codes (0 on success).
+function statBatch(paths, options = { lstat: false }, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = {};
+  }
+  callback = makeCallback(callback);
+  if (!ArrayIsArray(paths))
+    throw new ERR_INVALID_ARG_TYPE('paths', 'Array', paths);
+  const namespaced = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    namespaced[i] =
+      pathModule.toNamespacedPath(getValidatedPath(paths[i], `paths[${i}]`));
+  }
+  const req = new FSReqCallback();
+  req.oncomplete = (err, result) => {
+    if (err) return callback(err);
+    const [errors, fields] = result;
+    const stats = new Array(errors.length);
+    for (let i = 0; i < errors.length; i++) {
+      stats[i] = errors[i] === 0 ?
+        getStatsFromBinding(fields, i * kFsStatsFieldsNumber) :
+        null;
+    }
+    callback(null, stats, errors);
+  };
+  binding.statBatch(namespaced, !!options.lstat, req);
+}
+
+// Scopes the native stat cache to the given path prefixes. stat() and
+// lstat() calls for paths under a prefix are answered from an in-memory
+// cache that filesystem watchers on the covered directories keep coherent,
+// skipping the threadpool entirely on repeat lookups. Pass an empty array
+// to disable and drop the cache.
+function setStatCachePrefixes(prefixes) {
+  if (!ArrayIsArray(prefixes))
+    throw new ERR_INVALID_ARG_TYPE('prefixes', 'Array', prefixes);
+  const namespaced = new Array(prefixes.length);
+  for (let i = 0; i < prefixes.length; i++) {
+    namespaced[i] = pathModule.toNamespacedPath(
+      getValidatedPath(prefixes[i], `prefixes[${i}]`));
+  }
+  binding.setStatCachePrefixes(namespaced);
+}
+
+// Reads a file through the native asset cache: the first read of a path
+// opens and maps it once, and every later read hands back a Buffer over
+// the same mapping with no syscalls and no copies. Cached entries are
+// dropped by a filesystem watcher as soon as the file changes and by LRU
+// eviction when the cache outgrows its size cap. Buffers returned for one
+// file alias shared memory, so treat them as read-only.
+function readAssetSync(path, options) {
+  options = getOptions(options, {});
+  if (binding.assetCacheRead === undefined)  // Windows: no mmap support.
+    return readFileSync(path, options);
+  path = getValidatedPath(path);
+  const ctx = {};
+  const result = binding.assetCacheRead(pathModule.toNamespacedPath(path),
+                                        ctx);
+  handleErrorFromBinding(ctx);
+  return options.encoding ? result.toString(options.encoding) : result;
+}
+
+// Caps the total bytes the asset cache may keep mapped; least recently
+// used entries are evicted to fit. Zero drops every entry and disables
+// admission (reads still work, they just stop being cached).
+function setAssetCacheSize(bytes) {
+  validateInteger(bytes, 'bytes', 0);
+  if (binding.setAssetCacheSize !== undefined)
+    binding.setAssetCacheSize(bytes);
+}
+
 function fstatSync(fd, options = { bigint: false }) {
   validateInt32(fd, 'fd', 0);
   const ctx = { fd };
@@ -1807,6 +1927,12 @@ function copyFile(src, dest, flags, callback) {
   flags = flags | 0;
   const req = new FSReqCallback();
   req.oncomplete = makeCallback(callback);
+  if (flags & COPYFILE_PARALLEL) {
+    // Clones the file when the filesystem can, and otherwise copies it in
+    // concurrent threadpool range tasks instead of one sequential pass.
+    binding.copyFileParallel(src, dest, flags & ~COPYFILE_PARALLEL, req);
+    return;
+  }
   binding.copyFile(src, dest, flags, req);
 }
 
@@ -1820,6 +1946,11 @@ function copyFileSync(src, dest, flags) {
   src = pathModule._makeLong(src);
   dest = pathModule._makeLong(dest);
   flags = flags | 0;
+  if (flags & COPYFILE_PARALLEL) {
+    // The sync path cannot fan out; keep the reflink-first behavior by
+    // asking libuv for an opportunistic clone instead.
+    flags = (flags & ~COPYFILE_PARALLEL) | COPYFILE_FICLONE;
+  }
   binding.copyFile(src, dest, flags, undefined, ctx);
   handleErrorFromBinding(ctx);
 }
@@ -1892,6 +2023,7 @@ module.exports = fs = {
   readdirSync,
   read,
   readSync,
+  readAssetSync,
   readFile,
   readFileSync,
   readlink,
@@ -1902,7 +2034,10 @@ module.exports = fs = {
   renameSync,
   rmdir,
   rmdirSync,
+  setAssetCacheSize,
+  setStatCachePrefixes,
   stat,
+  statBatch,
   statSync,
   symlink,
   symlinkSync,
@@ -1913,6 +2048,7 @@ module.exports = fs = {
   unlinkSync,
   utimes,
   utimesSync,
+  walkdir,
   watch,
   watchFile,
   writeFile,
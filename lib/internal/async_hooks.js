@@ -75,6 +75,11 @@ const active_hooks = {
 };
 
 const { registerDestroyHook } = async_wrap;
+// The async context frame is a single arbitrary JS value kept natively per
+// Environment. Every AsyncWrap captures it on construction and makes it
+// current again around its callbacks, so reading it from anywhere yields the
+// value that was current when the enclosing async resource was created.
+const { getAsyncContextFrame, setAsyncContextFrame } = async_wrap;
 const { enqueueMicrotask } = internalBinding('task_queue');
 
 // Each constant tracks how many callbacks there are for any given step of
@@ -82,7 +87,8 @@ const { enqueueMicrotask } = internalBinding('task_queue');
 // for a given step, that step can bail out early.
 const { kInit, kBefore, kAfter, kDestroy, kTotals, kPromiseResolve,
         kCheck, kExecutionAsyncId, kAsyncIdCounter, kTriggerAsyncId,
-        kDefaultTriggerAsyncId, kStackLength } = async_wrap.constants;
+        kDefaultTriggerAsyncId, kStackLength, kSampleInterval,
+        kUnsampledEvents } = async_wrap.constants;
 
 // Used in AsyncHook and AsyncResource.
 const async_id_symbol = Symbol('asyncId');
@@ -94,7 +100,6 @@ const destroy_symbol = Symbol('destroy');
 const promise_resolve_symbol = Symbol('promiseResolve');
 const emitBeforeNative = emitHookFactory(before_symbol, 'emitBeforeNative');
 const emitAfterNative = emitHookFactory(after_symbol, 'emitAfterNative');
-const emitDestroyNative = emitHookFactory(destroy_symbol, 'emitDestroyNative');
 const emitPromiseResolveNative =
     emitHookFactory(promise_resolve_symbol, 'emitPromiseResolveNative');
 
@@ -189,6 +194,56 @@ function emitHook(symbol, asyncId) {
   }
 }
 
+// Called from native with the whole drained batch of destroyed async ids at
+// once (see AsyncWrap::DestroyAsyncIdsCallback), so a churn-heavy tick costs
+// one C++->JS transition rather than one per destroyed resource.
+function emitDestroyNative(asyncIds) {
+  active_hooks.call_depth += 1;
+  // Use a single try/catch for all hooks to avoid setting up one per
+  // iteration.
+  try {
+    // Using var here instead of let because "for (var ...)" is faster than
+    // let. Refs: https://github.com/nodejs/node/pull/30380#issuecomment-552948364
+    for (var i = 0; i < asyncIds.length; i++) {
+      for (var j = 0; j < active_hooks.array.length; j++) {
+        if (typeof active_hooks.array[j][destroy_symbol] === 'function') {
+          active_hooks.array[j][destroy_symbol](asyncIds[i]);
+        }
+      }
+    }
+  } catch (e) {
+    fatalError(e);
+  } finally {
+    active_hooks.call_depth -= 1;
+  }
+
+  // Hooks can only be restored if there have been no recursive hook calls.
+  // Also the active hooks do not need to be restored if enable()/disable()
+  // weren't called during hook execution, in which case
+  // active_hooks.tmp_array will be null.
+  if (active_hooks.call_depth === 0 && active_hooks.tmp_array !== null) {
+    restoreActiveHooks();
+  }
+}
+
+// Shared resource object handed to init() for promises tracked in
+// 'lightweight' mode, where no per-promise resource object is allocated.
+const lightweightPromiseResource = { __proto__: null };
+
+// Called from native with a drained batch of staged promise events, flat
+// [type, asyncId, triggerAsyncId] triplets where type 0 is init and 1 is
+// promiseResolve (see FlushPromiseEvents in src/async_wrap.cc).
+function emitPromiseEventsNative(events) {
+  for (var i = 0; i < events.length; i += 3) {
+    if (events[i] === 0) {
+      emitInitNative(events[i + 1], 'PROMISE', events[i + 2],
+                     lightweightPromiseResource);
+    } else {
+      emitPromiseResolveNative(events[i + 1]);
+    }
+  }
+}
+
 function emitHookFactory(symbol, name) {
   const fn = FunctionPrototypeBind(emitHook, undefined, symbol);
 
@@ -243,11 +298,23 @@ function restoreActiveHooks() {
 
 
 let wantPromiseHook = false;
+// When true, promises are tracked by the allocation-free native hook and
+// batched event delivery instead of one PromiseWrap per promise. See
+// LightweightPromiseHook in src/async_wrap.cc for the trade-offs.
+let lightweightPromiseTracking = false;
+
 function enableHooks() {
   async_hook_fields[kCheck] += 1;
 
   wantPromiseHook = true;
-  enablePromiseHook();
+  enablePromiseHook(lightweightPromiseTracking);
+}
+
+function setPromiseTrackingMode(mode) {
+  lightweightPromiseTracking = (mode === 'lightweight');
+  // If the promise hook is currently installed, swap it in place.
+  if (wantPromiseHook)
+    enablePromiseHook(lightweightPromiseTracking);
 }
 
 function disableHooks() {
@@ -315,6 +382,22 @@ function defaultTriggerAsyncIdScope(triggerAsyncId, block, ...args) {
 }
 
 
+// Keep in sync with AsyncHooks::sampled() in src/env-inl.h. A resource is
+// either fully sampled (all of its hook events fire) or fully unsampled
+// (none do, only the kUnsampledEvents counter moves), decided by its async
+// id so both the JS and C++ emitters reach the same verdict without extra
+// per-resource state.
+function isSampledAsyncId(asyncId) {
+  const interval = async_hook_fields[kSampleInterval];
+  if (interval <= 1) return true;
+  return asyncId % interval === 0;
+}
+
+function setSampleInterval(interval) {
+  async_hook_fields[kSampleInterval] = interval;
+}
+
+
 function initHooksExist() {
   return async_hook_fields[kInit] > 0;
 }
@@ -342,6 +425,11 @@ function emitInitScript(asyncId, type, triggerAsyncId, resource) {
   if (async_hook_fields[kInit] === 0)
     return;
 
+  if (!isSampledAsyncId(asyncId)) {
+    async_hook_fields[kUnsampledEvents]++;
+    return;
+  }
+
   // This can run after the early return check b/c running this function
   // manually means that the embedder must have used getDefaultTriggerAsyncId().
   if (triggerAsyncId === null) {
@@ -359,18 +447,28 @@ function emitBeforeScript(asyncId, triggerAsyncId) {
   validateAsyncId(asyncId, 'asyncId');
   validateAsyncId(triggerAsyncId, 'triggerAsyncId');
 
+  // The async id stack must stay accurate for unsampled resources too; only
+  // the user-facing hook call is subject to sampling.
   pushAsyncIds(asyncId, triggerAsyncId);
 
-  if (async_hook_fields[kBefore] > 0)
-    emitBeforeNative(asyncId);
+  if (async_hook_fields[kBefore] > 0) {
+    if (isSampledAsyncId(asyncId))
+      emitBeforeNative(asyncId);
+    else
+      async_hook_fields[kUnsampledEvents]++;
+  }
 }
 
 
 function emitAfterScript(asyncId) {
   validateAsyncId(asyncId, 'asyncId');
 
-  if (async_hook_fields[kAfter] > 0)
-    emitAfterNative(asyncId);
+  if (async_hook_fields[kAfter] > 0) {
+    if (isSampledAsyncId(asyncId))
+      emitAfterNative(asyncId);
+    else
+      async_hook_fields[kUnsampledEvents]++;
+  }
 
   popAsyncIds(asyncId);
 }
@@ -382,6 +480,10 @@ function emitDestroyScript(asyncId) {
   // Return early if there are no destroy callbacks, or invalid asyncId.
   if (async_hook_fields[kDestroy] === 0 || asyncId <= 0)
     return;
+  if (!isSampledAsyncId(asyncId)) {
+    async_hook_fields[kUnsampledEvents]++;
+    return;
+  }
   async_wrap.queueDestroyAsyncId(asyncId);
 }
 
@@ -467,6 +569,11 @@ module.exports = {
   initHooksExist,
   afterHooksExist,
   destroyHooksExist,
+  isSampledAsyncId,
+  setSampleInterval,
+  setPromiseTrackingMode,
+  getAsyncContextFrame,
+  setAsyncContextFrame,
   emitInit: emitInitScript,
   emitBefore: emitBeforeScript,
   emitAfter: emitAfterScript,
@@ -477,6 +584,7 @@ module.exports = {
     before: emitBeforeNative,
     after: emitAfterNative,
     destroy: emitDestroyNative,
-    promise_resolve: emitPromiseResolveNative
+    promise_resolve: emitPromiseResolveNative,
+    promise_events: emitPromiseEventsNative
   }
 };
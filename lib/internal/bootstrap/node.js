@@ -84,6 +84,7 @@ const rawMethods = internalBinding('process_methods');
   process.cpuUsage = wrapped.cpuUsage;
   process.resourceUsage = wrapped.resourceUsage;
   process.memoryUsage = wrapped.memoryUsage;
+  process.loopStallSamples = rawMethods.loopStallSamples;
   process.kill = wrapped.kill;
   process.exit = wrapped.exit;
 
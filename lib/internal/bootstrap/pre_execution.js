@@ -43,6 +43,8 @@ function prepareMainThreadExecution(expandArgv1 = false) {
 
   initializeHeapSnapshotSignalHandlers();
 
+  initializeCpuFlightRecorderSignalHandlers();
+
   // If the process is spawned with env NODE_CHANNEL_FD, it's probably
   // spawned by our child_process module, then initialize IPC.
   // This attaches some internal event listeners and creates:
@@ -197,6 +199,20 @@ function initializeHeapSnapshotSignalHandlers() {
   });
 }
 
+function initializeCpuFlightRecorderSignalHandlers() {
+  const signal = getOptionValue('--cpu-prof-flight-signal');
+
+  if (!signal || !process.features.inspector)
+    return;
+
+  require('internal/validators').validateSignalName(signal);
+  const { dumpCpuFlightRecorder } = internalBinding('profiler');
+
+  process.on(signal, () => {
+    dumpCpuFlightRecorder();
+  });
+}
+
 function setupTraceCategoryState() {
   const { isTraceCategoryEnabled } = internalBinding('trace_events');
   const { toggleTraceCategoryState } = require('internal/process/per_thread');
@@ -0,0 +1,116 @@
+'use strict';
+
+// Pre-forked worker pool: keeps a number of idle Node.js child processes
+// forked ahead of need, so that callers acquire an already-running worker
+// instead of paying the full process-creation cost on the critical path.
+// Work items (and socket/server handles) are dispatched over the regular
+// IPC channel, which supports descriptor passing natively via send().
+
+const {
+  ArrayIsArray,
+  NumberIsInteger,
+} = primordials;
+
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE,
+  }
+} = require('internal/errors');
+const { validateString } = require('internal/validators');
+
+let fork;  // Lazy loaded so unused pools do not cost anything at startup.
+
+class PreforkPool {
+  constructor(modulePath, options = {}) {
+    validateString(modulePath, 'modulePath');
+    if (options === null || typeof options !== 'object')
+      throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+    const size = options.size === undefined ? 2 : options.size;
+    if (!NumberIsInteger(size) || size < 1)
+      throw new ERR_OUT_OF_RANGE('options.size', '>= 1', size);
+
+    if (options.args !== undefined && !ArrayIsArray(options.args))
+      throw new ERR_INVALID_ARG_TYPE('options.args', 'Array', options.args);
+
+    this.modulePath = modulePath;
+    this.size = size;
+    this.args = options.args || [];
+    this.forkOptions = {
+      execArgv: options.execArgv,
+      env: options.env,
+      silent: options.silent,
+    };
+    this.idle = [];
+    this.closed = false;
+
+    this._refill();
+  }
+
+  get idleCount() {
+    return this.idle.length;
+  }
+
+  // Returns a ChildProcess that is already running whenever one is warm;
+  // falls back to forking inline when the pool has been drained faster than
+  // it could refill. Refilling happens in the background either way.
+  acquire() {
+    if (this.closed)
+      return null;
+    const child = this.idle.length > 0 ? this.idle.pop() : this._fork();
+    // Workers in service participate in keeping the parent alive again.
+    child.ref();
+    child.channel.ref();
+    this._refill();
+    return child;
+  }
+
+  // Hands a worker back to the pool; workers that died or disconnected
+  // while in service are discarded and replaced by the next refill.
+  release(child) {
+    if (this.closed || child.killed || child.exitCode !== null ||
+        !child.connected) {
+      if (child.exitCode === null && !child.killed)
+        child.kill();
+      return;
+    }
+    if (this.idle.length < this.size) {
+      child.unref();
+      child.channel.unref();
+      this.idle.push(child);
+    } else {
+      child.kill();
+    }
+  }
+
+  close() {
+    this.closed = true;
+    for (const child of this.idle)
+      child.kill();
+    this.idle = [];
+  }
+
+  _fork() {
+    if (fork === undefined)
+      fork = require('child_process').fork;
+    const child = fork(this.modulePath, this.args, this.forkOptions);
+    // A worker that dies while idle must not be handed out later.
+    child.once('exit', () => {
+      const index = this.idle.indexOf(child);
+      if (index !== -1)
+        this.idle.splice(index, 1);
+    });
+    // Idle workers must not keep the parent alive.
+    child.unref();
+    child.channel.unref();
+    return child;
+  }
+
+  _refill() {
+    while (!this.closed && this.idle.length < this.size)
+      this.idle.push(this._fork());
+  }
+}
+
+module.exports = { PreforkPool };
@@ -56,6 +56,10 @@ cluster.setupMaster = function(options) {
     args: process.argv.slice(2),
     exec: process.argv[1],
     execArgv: process.execArgv,
+    // Cluster IPC is chatty (every handle distribution round-trips over the
+    // channel), so default to the structured serializer, which is
+    // significantly cheaper than JSON for the internal control messages.
+    serialization: 'advanced',
     silent: false,
     ...cluster.settings,
     ...options
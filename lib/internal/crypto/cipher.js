@@ -12,9 +12,11 @@ const {
 const {
   ERR_CRYPTO_INVALID_STATE,
   ERR_INVALID_ARG_TYPE,
-  ERR_INVALID_OPT_VALUE
+  ERR_INVALID_OPT_VALUE,
+  ERR_OUT_OF_RANGE
 } = require('internal/errors').codes;
-const { validateEncoding, validateString } = require('internal/validators');
+const { validateEncoding, validateString, validateUint32 } =
+  require('internal/validators');
 
 const {
   preparePrivateKey,
@@ -169,6 +171,31 @@ Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
 };
 
 
+// Ciphers the given range of `buffer` in place and returns the number of
+// bytes written, avoiding the output allocation that update() pays for
+// every chunk. Only supported for cipher modes with a block size of one
+// (stream ciphers, CTR, GCM, ...), where output and input sizes always
+// match.
+Cipher.prototype.updateInPlace = function updateInPlace(buffer,
+                                                        offset = 0,
+                                                        length) {
+  if (!isArrayBufferView(buffer)) {
+    throw new ERR_INVALID_ARG_TYPE('buffer',
+                                   ['Buffer', 'TypedArray', 'DataView'],
+                                   buffer);
+  }
+  if (length === undefined)
+    length = buffer.byteLength - offset;
+  validateUint32(offset, 'offset');
+  validateUint32(length, 'length');
+  if (offset + length > buffer.byteLength)
+    throw new ERR_OUT_OF_RANGE('length', `<= ${buffer.byteLength - offset}`,
+                               length);
+
+  return this[kHandle].updateInPlace(buffer, offset, length);
+};
+
+
 Cipher.prototype.final = function final(outputEncoding) {
   outputEncoding = outputEncoding || getDefaultEncoding();
   const ret = this[kHandle].final();
@@ -231,6 +258,7 @@ function addCipherPrototypeFunctions(constructor) {
   constructor.prototype._transform = Cipher.prototype._transform;
   constructor.prototype._flush = Cipher.prototype._flush;
   constructor.prototype.update = Cipher.prototype.update;
+  constructor.prototype.updateInPlace = Cipher.prototype.updateInPlace;
   constructor.prototype.final = Cipher.prototype.final;
   constructor.prototype.setAutoPadding = Cipher.prototype.setAutoPadding;
   if (constructor === Cipheriv) {
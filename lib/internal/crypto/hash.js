@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayIsArray,
   ObjectSetPrototypeOf,
   Symbol,
 } = primordials;
@@ -78,6 +79,20 @@ Hash.prototype.update = function update(data, encoding) {
   if (state[kFinalized])
     throw new ERR_CRYPTO_HASH_FINALIZED();
 
+  // An array of views is digested in a single binding call.
+  if (ArrayIsArray(data)) {
+    for (let i = 0; i < data.length; i++) {
+      if (!isArrayBufferView(data[i])) {
+        throw new ERR_INVALID_ARG_TYPE(`data[${i}]`,
+                                       ['Buffer', 'TypedArray', 'DataView'],
+                                       data[i]);
+      }
+    }
+    if (!this[kHandle].updateMany(data))
+      throw new ERR_CRYPTO_HASH_UPDATE_FAILED();
+    return this;
+  }
+
   if (typeof data !== 'string' && !isArrayBufferView(data)) {
     throw new ERR_INVALID_ARG_TYPE('data',
                                    ['string',
@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayIsArray,
   Symbol,
 } = primordials;
 
@@ -9,7 +10,8 @@ const {
   getCurves: _getCurves,
   getHashes: _getHashes,
   setEngine: _setEngine,
-  timingSafeEqual: _timingSafeEqual
+  timingSafeEqual: _timingSafeEqual,
+  timingSafeEqualMany: _timingSafeEqualMany
 } = internalBinding('crypto');
 
 const {
@@ -91,6 +93,31 @@ function timingSafeEqual(buf1, buf2) {
   return _timingSafeEqual(buf1, buf2);
 }
 
+// Compares `probe` against every buffer in `candidates` in constant time
+// inside one native call and returns the index of the first match, or -1.
+// Useful when a MAC has to be checked against several rotated keys.
+function timingSafeEqualMany(probe, candidates) {
+  if (!isArrayBufferView(probe)) {
+    throw new ERR_INVALID_ARG_TYPE('probe',
+                                   ['Buffer', 'TypedArray', 'DataView'],
+                                   probe);
+  }
+  if (!ArrayIsArray(candidates)) {
+    throw new ERR_INVALID_ARG_TYPE('candidates', 'Array', candidates);
+  }
+  for (let i = 0; i < candidates.length; i++) {
+    if (!isArrayBufferView(candidates[i])) {
+      throw new ERR_INVALID_ARG_TYPE(`candidates[${i}]`,
+                                     ['Buffer', 'TypedArray', 'DataView'],
+                                     candidates[i]);
+    }
+    if (candidates[i].byteLength !== probe.byteLength) {
+      throw new ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH();
+    }
+  }
+  return _timingSafeEqualMany(probe, candidates);
+}
+
 const getArrayBufferView = hideStackFrames((buffer, name, encoding) => {
   if (typeof buffer === 'string') {
     if (encoding === 'buffer')
@@ -117,5 +144,6 @@ module.exports = {
   setDefaultEncoding,
   setEngine,
   timingSafeEqual,
+  timingSafeEqualMany,
   toBuf
 };
@@ -10,6 +10,8 @@ const {
   bindDefaultResolver,
   Resolver: CallbackResolver,
   validateHints,
+  validateLookupMode,
+  lookupViaResolver,
   emitInvalidHostnameWarning,
 } = require('internal/dns/utils');
 const { codes, dnsException } = require('internal/errors');
@@ -62,7 +64,7 @@ function onlookupall(err, addresses) {
   this.resolve(addresses);
 }
 
-function createLookupPromise(family, hostname, all, hints, verbatim) {
+function createLookupPromise(family, hostname, all, hints, verbatim, mode) {
   return new Promise((resolve, reject) => {
     if (!hostname) {
       emitInvalidHostnameWarning(hostname);
@@ -86,6 +88,19 @@ function createLookupPromise(family, hostname, all, hints, verbatim) {
       return;
     }
 
+    if (mode === 'resolver') {
+      lookupViaResolver(hostname, family, all, verbatim,
+                        (err, address, family) => {
+                          if (err)
+                            reject(err);
+                          else if (all)
+                            resolve(address);
+                          else
+                            resolve({ address, family });
+                        });
+      return;
+    }
+
     const req = new GetAddrInfoReqWrap();
 
     req.family = family;
@@ -107,6 +122,7 @@ function lookup(hostname, options) {
   var family = -1;
   var all = false;
   var verbatim = false;
+  var mode;
 
   // Parse arguments
   if (hostname && typeof hostname !== 'string') {
@@ -116,8 +132,10 @@ function lookup(hostname, options) {
     family = options.family >>> 0;
     all = options.all === true;
     verbatim = options.verbatim === true;
+    mode = options.mode;
 
     validateHints(hints);
+    validateLookupMode(mode);
   } else {
     family = options >>> 0;
   }
@@ -125,7 +143,7 @@ function lookup(hostname, options) {
   if (family !== 0 && family !== 4 && family !== 6)
     throw new ERR_INVALID_OPT_VALUE('family', family);
 
-  return createLookupPromise(family, hostname, all, hints, verbatim);
+  return createLookupPromise(family, hostname, all, hints, verbatim, mode);
 }
 
 
@@ -5,9 +5,12 @@ const {
 } = primordials;
 
 const errors = require('internal/errors');
+const { dnsException } = errors;
+const { toASCII } = require('internal/idna');
 const { isIP } = require('internal/net');
 const {
   ChannelWrap,
+  QueryReqWrap,
   strerror,
   AI_ADDRCONFIG,
   AI_V4MAPPED
@@ -135,6 +138,96 @@ function bindDefaultResolver(target, source) {
   });
 }
 
+function validateLookupMode(mode) {
+  if (mode !== undefined && mode !== 'getaddrinfo' && mode !== 'resolver') {
+    throw new ERR_INVALID_OPT_VALUE('mode', mode);
+  }
+}
+
+// dns.lookup() normally goes through the blocking getaddrinfo(3) on the
+// threadpool. With `mode: 'resolver'`, A and AAAA queries are issued in
+// parallel on the default resolver's c-ares channel instead, keeping the
+// lookup event-driven and off the threadpool entirely. The answers are
+// merged into a getaddrinfo-shaped result: IPv4 before IPv6 by default,
+// or interleaved starting with IPv6 when `verbatim` is set, so that a
+// connection attempt walking the list alternates between address families.
+function lookupViaResolver(hostname, family, all, verbatim, callback) {
+  const handle = getDefaultResolver()._handle;
+  const name = toASCII(hostname);
+  const state = {
+    // Start at one so that the queries issued below can never complete
+    // (or fail synchronously) before all of them have been sent; the
+    // extra reference is dropped on the next tick.
+    pending: 1,
+    error: null,
+    addresses4: [],
+    addresses6: [],
+  };
+
+  function done() {
+    const { addresses4, addresses6 } = state;
+    if (addresses4.length === 0 && addresses6.length === 0) {
+      callback(state.error || dnsException('ENOTFOUND', 'queryA', hostname));
+      return;
+    }
+
+    let addresses;
+    if (!verbatim) {
+      addresses = addresses4.concat(addresses6);
+    } else {
+      addresses = [];
+      const count = addresses4.length > addresses6.length ?
+        addresses4.length : addresses6.length;
+      for (let i = 0; i < count; i++) {
+        if (i < addresses6.length) addresses.push(addresses6[i]);
+        if (i < addresses4.length) addresses.push(addresses4[i]);
+      }
+    }
+
+    if (all) {
+      callback(null, addresses.map(
+        (address) => ({ address, family: isIP(address) })));
+    } else {
+      callback(null, addresses[0], isIP(addresses[0]));
+    }
+  }
+
+  function query(bindingName, target) {
+    state.pending++;
+    const req = new QueryReqWrap();
+    req.bindingName = bindingName;
+    req.hostname = hostname;
+    req.oncomplete = (err, result) => {
+      if (err) {
+        // A missing record for one family is fine as long as the other
+        // family answers; only the first error is reported if neither does.
+        if (state.error === null)
+          state.error = dnsException(err, bindingName, hostname);
+      } else {
+        state[target] = result;
+      }
+      if (--state.pending === 0)
+        done();
+    };
+    const err = handle[bindingName](req, name);
+    if (err) {
+      if (state.error === null)
+        state.error = dnsException(err, bindingName, hostname);
+      state.pending--;
+    }
+  }
+
+  if (family === 0 || family === 4)
+    query('queryA', 'addresses4');
+  if (family === 0 || family === 6)
+    query('queryAaaa', 'addresses6');
+
+  process.nextTick(() => {
+    if (--state.pending === 0)
+      done();
+  });
+}
+
 function validateHints(hints) {
   if (hints !== 0 &&
       hints !== AI_ADDRCONFIG &&
@@ -164,6 +257,8 @@ module.exports = {
   getDefaultResolver,
   setDefaultResolver,
   validateHints,
+  validateLookupMode,
+  lookupViaResolver,
   Resolver,
   emitInvalidHostnameWarning,
 };
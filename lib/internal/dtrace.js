@@ -3,6 +3,7 @@
 const config = internalBinding('config');
 
 const {
+  DTRACE_BUFFER_POOL_REFILL = () => {},
   DTRACE_HTTP_CLIENT_REQUEST = () => {},
   DTRACE_HTTP_CLIENT_RESPONSE = () => {},
   DTRACE_HTTP_SERVER_REQUEST = () => {},
@@ -12,6 +13,7 @@ const {
 } = (config.hasDtrace ? internalBinding('dtrace') : {});
 
 module.exports = {
+  DTRACE_BUFFER_POOL_REFILL,
   DTRACE_HTTP_CLIENT_REQUEST,
   DTRACE_HTTP_CLIENT_RESPONSE,
   DTRACE_HTTP_SERVER_REQUEST,
@@ -47,6 +47,7 @@ const MainContextError = Error;
 const ErrorToString = Error.prototype.toString;
 const overrideStackTrace = new WeakMap();
 const kNoOverride = Symbol('kNoOverride');
+const kIsNodeError = Symbol('kIsNodeError');
 const prepareStackTrace = (globalThis, error, trace) => {
   // API for node internals to override error stack formatting
   // without interfering with userland code.
@@ -65,7 +66,14 @@ const prepareStackTrace = (globalThis, error, trace) => {
   // Error: Message
   //     at function (file)
   //     at file
-  const errorString = ErrorToString.call(error);
+  //
+  // For errors created through the E() factories the error code is baked
+  // into the first line here, at first access, instead of eagerly
+  // materializing the whole stack at construction time just to snapshot a
+  // decorated name (see addCodeToName()).
+  const errorString = kIsNodeError in error ?
+    `${error.name} [${error.code}]: ${error.message}` :
+    ErrorToString.call(error);
   if (trace.length === 0) {
     return errorString;
   }
@@ -272,6 +280,20 @@ function makeNodeErrorWithCode(Base, key) {
   };
 }
 
+// Fast-path opt-out for hot paths that throw errors which are always caught
+// and discarded: while `fn` runs, newly created errors capture no stack
+// frames at all, making their construction little more than an object
+// allocation.
+function withoutStackTrace(fn) {
+  const limit = Error.stackTraceLimit;
+  Error.stackTraceLimit = 0;
+  try {
+    return fn();
+  } finally {
+    Error.stackTraceLimit = limit;
+  }
+}
+
 // This function removes unnecessary frames from Node.js core errors.
 function hideStackFrames(fn) {
   return function hidden(...args) {
@@ -297,12 +319,17 @@ function addCodeToName(err, name, code) {
     // eslint-disable-next-line no-restricted-syntax
     Error.captureStackTrace(err, excludedStackFn);
   }
-  // Add the error code to the name to include it in the stack trace.
-  err.name = `${name} [${code}]`;
-  // Access the stack to generate the error message including the error code
-  // from the name.
-  err.stack;
-  // Reset the name to the actual name.
+  // Mark the error so prepareStackTrace() includes the error code in the
+  // first stack line when (and only when) the stack is first formatted.
+  // Accessing err.stack here instead forced full frame symbolization for
+  // every error created through the factories, including errors that are
+  // caught and discarded without ever being inspected.
+  ObjectDefineProperty(err, kIsNodeError, {
+    value: true,
+    enumerable: false,
+    writable: false,
+    configurable: true
+  });
   if (name === 'SystemError') {
     ObjectDefineProperty(err, 'name', {
       value: name,
@@ -310,8 +337,6 @@ function addCodeToName(err, name, code) {
       writable: true,
       configurable: true
     });
-  } else {
-    delete err.name;
   }
 }
 
@@ -694,6 +719,7 @@ module.exports = {
   exceptionWithHostPort,
   getMessage,
   hideStackFrames,
+  withoutStackTrace,
   isStackOverflowError,
   connResetException,
   uvErrmapGet,
@@ -781,6 +807,8 @@ E('ERR_CRYPTO_SIGN_KEY_REQUIRED', 'No key provided to sign', Error);
 E('ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH',
   'Input buffers must have the same byte length', RangeError);
 E('ERR_DIR_CLOSED', 'Directory handle was closed', Error);
+E('ERR_DIR_CONCURRENT_OPERATION',
+  'Cannot start a directory operation while another is in progress', Error);
 E('ERR_DNS_SET_SERVERS_FAILED', 'c-ares failed to set servers: "%s" [%s]',
   Error);
 E('ERR_DOMAIN_CALLBACK_NOT_AVAILABLE',
@@ -802,6 +830,10 @@ E('ERR_FALSY_VALUE_REJECTION', function(reason) {
   this.reason = reason;
   return 'Promise was rejected with falsy value';
 }, Error);
+E('ERR_FEATURE_UNAVAILABLE_ON_PLATFORM',
+  'The feature %s is unavailable on the current platform' +
+  ', which is being used to run Node.js',
+  TypeError);
 E('ERR_FS_FILE_TOO_LARGE', 'File size (%s) is greater than possible Buffer: ' +
     `${kMaxLength} bytes`,
   RangeError);
@@ -1368,6 +1400,11 @@ E('ERR_WORKER_PATH',
   'The worker script filename must be an absolute path or a relative ' +
   'path starting with \'./\' or \'../\'. Received "%s"',
   TypeError);
+E('ERR_WORKER_SCHEDULING_FAILED',
+  'Applying CPU affinity or priority to the worker thread failed', Error);
+E('ERR_WORKER_SPAWN_BUDGET_EXCEEDED',
+  'Worker terminated because its environment setup exceeded the spawn budget',
+  Error);
 E('ERR_WORKER_UNSERIALIZABLE_ERROR',
   'Serializing an uncaught exception failed', Error);
 E('ERR_WORKER_UNSUPPORTED_EXTENSION',
@@ -12,6 +12,7 @@ const dirBinding = internalBinding('fs_dir');
 const {
   codes: {
     ERR_DIR_CLOSED,
+    ERR_DIR_CONCURRENT_OPERATION,
     ERR_INVALID_CALLBACK,
     ERR_MISSING_ARGS
   }
@@ -38,6 +39,13 @@ const kDirReadImpl = Symbol('kDirReadImpl');
 const kDirReadPromisified = Symbol('kDirReadPromisified');
 const kDirClosePromisified = Symbol('kDirClosePromisified');
 
+const kWalkerHandle = Symbol('kWalkerHandle');
+const kWalkerPath = Symbol('kWalkerPath');
+const kWalkerBatchSize = Symbol('kWalkerBatchSize');
+const kWalkerReading = Symbol('kWalkerReading');
+const kWalkerDone = Symbol('kWalkerDone');
+const kWalkerReadPromisified = Symbol('kWalkerReadPromisified');
+
 class Dir {
   constructor(handle, path, options) {
     if (handle == null) throw new ERR_MISSING_ARGS('handle');
@@ -183,6 +191,105 @@ ObjectDefineProperty(Dir.prototype, SymbolAsyncIterator, {
   configurable: true,
 });
 
+// Streams a recursive directory walk. Unlike Dir, the whole traversal is
+// driven by the binding on the threadpool, so each read() costs one JS
+// round trip for a full page of entries.
+class DirWalker {
+  constructor(handle, path, options) {
+    this[kWalkerHandle] = handle;
+    this[kWalkerPath] = path;
+    this[kWalkerBatchSize] = options.batchSize;
+    this[kWalkerReading] = false;
+    this[kWalkerDone] = false;
+    this[kWalkerReadPromisified] = internalUtil.promisify(this.read).bind(this);
+  }
+
+  get path() {
+    return this[kWalkerPath];
+  }
+
+  // Delivers the next page as an array of { path, type, size } records,
+  // where `path` is relative to the walk root and `size` is -1 when stats
+  // were not requested. Yields null once the traversal has finished.
+  read(callback) {
+    if (callback === undefined) {
+      return this[kWalkerReadPromisified]();
+    } else if (typeof callback !== 'function') {
+      throw new ERR_INVALID_CALLBACK(callback);
+    }
+
+    if (this[kWalkerReading]) {
+      throw new ERR_DIR_CONCURRENT_OPERATION();
+    }
+
+    if (this[kWalkerDone]) {
+      process.nextTick(callback, null, null);
+      return;
+    }
+
+    const req = new FSReqCallback();
+    req.oncomplete = (err, names) => {
+      this[kWalkerReading] = false;
+      if (err) {
+        return callback(err);
+      }
+      if (names.length === 0) {
+        this[kWalkerDone] = true;
+        return callback(null, null);
+      }
+
+      const data = this[kWalkerHandle].entryData;
+      const entries = new Array(names.length);
+      for (let i = 0; i < names.length; i++) {
+        entries[i] = {
+          path: names[i],
+          type: data[2 * i],
+          size: data[2 * i + 1]
+        };
+      }
+      callback(null, entries);
+    };
+
+    this[kWalkerReading] = true;
+    this[kWalkerHandle].read(this[kWalkerBatchSize], req);
+  }
+
+  async* entries() {
+    while (true) {
+      const result = await this[kWalkerReadPromisified]();
+      if (result === null) {
+        break;
+      }
+      yield* result;
+    }
+  }
+}
+
+ObjectDefineProperty(DirWalker.prototype, SymbolAsyncIterator, {
+  value: DirWalker.prototype.entries,
+  enumerable: false,
+  writable: true,
+  configurable: true,
+});
+
+function walkdir(path, options) {
+  path = getValidatedPath(path);
+  options = {
+    batchSize: 1024,
+    stats: false,
+    ...getOptions(options, {})
+  };
+
+  validateUint32(options.batchSize, 'options.batchSize', true);
+
+  const handle = dirBinding.walkdir(
+    pathModule.toNamespacedPath(path),
+    !!options.stats
+  );
+
+  return new DirWalker(handle, path, options);
+}
+
 function opendir(path, options, callback) {
   callback = typeof options === 'function' ? options : callback;
   if (typeof callback !== 'function') {
@@ -231,6 +338,8 @@ function opendirSync(path, options) {
 
 module.exports = {
   Dir,
+  DirWalker,
   opendir,
-  opendirSync
+  opendirSync,
+  walkdir
 };
@@ -8,6 +8,7 @@ const {
 } = primordials;
 
 const {
+  COPYFILE_PARALLEL,
   F_OK,
   O_SYMLINK,
   O_WRONLY,
@@ -22,6 +23,7 @@ const {
   ERR_INVALID_ARG_VALUE,
   ERR_METHOD_NOT_IMPLEMENTED
 } = require('internal/errors').codes;
+const { uvException } = require('internal/errors');
 const { isUint8Array } = require('internal/util/types');
 const { rimrafPromises } = require('internal/fs/rimraf');
 const {
@@ -52,6 +54,7 @@ const pathModule = require('path');
 const { promisify } = require('internal/util');
 
 const kHandle = Symbol('kHandle');
+const kWriteCombining = Symbol('kWriteCombining');
 const { kUsePromises } = binding;
 
 const getDirectoryEntriesPromise = promisify(getDirents);
@@ -93,6 +96,15 @@ class FileHandle {
     return read(this, buffer, offset, length, position);
   }
 
+  // Sets how many reads are kept in flight when this handle is consumed as
+  // a stream (e.g. by http2's respondWithFile()). Deeper pipelines help
+  // large sequential scans on high-latency storage; the default is 1.
+  setReadPipelineDepth(depth) {
+    validateUint32(depth, 'depth', true);
+    this[kHandle].setReadPipelineDepth(depth);
+    return this;
+  }
+
   readFile(options) {
     return readFile(this, options);
   }
@@ -109,6 +121,17 @@ class FileHandle {
     return futimes(this, atime, mtime);
   }
 
+  // Turns on write combining for this handle: position-less buffer writes
+  // are copied into a native arena and flushed as one large write per loop
+  // turn, so append-heavy logging costs one syscall per turn instead of
+  // one threadpool dispatch per write(). Writes resolve once queued;
+  // sync(), datasync() and close() flush the arena first so durability
+  // barriers still hold.
+  setWriteCombining(enable = true) {
+    this[kWriteCombining] = !!enable;
+    return this;
+  }
+
   write(buffer, offset, length, position) {
     return write(this, buffer, offset, length, position);
   }
@@ -122,6 +145,10 @@ class FileHandle {
   }
 
   close = () => {
+    if (this[kWriteCombining]) {
+      return this[kHandle].flushCombinedWrites(kUsePromises)
+        .then(() => this[kHandle].close());
+    }
     return this[kHandle].close();
   }
 }
@@ -198,6 +225,13 @@ async function copyFile(src, dest, flags) {
   src = getValidatedPath(src, 'src');
   dest = getValidatedPath(dest, 'dest');
   flags = flags | 0;
+  if (flags & COPYFILE_PARALLEL) {
+    // Same routing as the callback form: clone when the filesystem can,
+    // otherwise copy in concurrent threadpool range tasks.
+    return binding.copyFileParallel(pathModule.toNamespacedPath(src),
+                                    pathModule.toNamespacedPath(dest),
+                                    flags & ~COPYFILE_PARALLEL, kUsePromises);
+  }
   return binding.copyFile(pathModule.toNamespacedPath(src),
                           pathModule.toNamespacedPath(dest),
                           flags, kUsePromises);
@@ -263,6 +297,15 @@ async function write(handle, buffer, offset, length, position) {
     if (typeof position !== 'number')
       position = null;
     validateOffsetLengthWrite(offset, length, buffer.byteLength);
+    if (position === null && handle[kWriteCombining]) {
+      const data = offset === 0 && length === buffer.byteLength ?
+        buffer :
+        new Uint8Array(buffer.buffer, buffer.byteOffset + offset, length);
+      const queued = handle[kHandle].writeCombined(data);
+      if (queued < 0)
+        throw uvException({ errno: queued, syscall: 'write' });
+      return { bytesWritten: length, buffer };
+    }
     const bytesWritten =
       (await binding.writeBuffer(handle.fd, buffer, offset,
                                  length, position, kUsePromises)) || 0;
@@ -321,11 +364,15 @@ async function rmdir(path, options) {
 
 async function fdatasync(handle) {
   validateFileHandle(handle);
+  if (handle[kWriteCombining])
+    await handle[kHandle].flushCombinedWrites(kUsePromises);
   return binding.fdatasync(handle.fd, kUsePromises);
 }
 
 async function fsync(handle) {
   validateFileHandle(handle);
+  if (handle[kWriteCombining])
+    await handle[kHandle].flushCombinedWrites(kUsePromises);
   return binding.fsync(handle.fd, kUsePromises);
 }
 
@@ -0,0 +1,107 @@
+'use strict';
+
+const {
+  Map,
+  NumberIsSafeInteger,
+  NumberMAX_SAFE_INTEGER,
+  Symbol,
+} = primordials;
+
+const { Histogram: _Histogram } = internalBinding('performance');
+
+const {
+  ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_OPT_VALUE,
+} = require('internal/errors').codes;
+
+const kInspect = require('internal/util').customInspectSymbol;
+
+const kHandle = Symbol('handle');
+const kMap = Symbol('map');
+
+// A histogram that is filled one sample at a time via record(), backed by
+// the same native hdr_histogram as perf_hooks.monitorEventLoopDelay().
+class RecordableHistogram {
+  constructor(handle) {
+    this[kHandle] = handle;
+    this[kMap] = new Map();
+  }
+
+  record(value) {
+    if (typeof value !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('value', 'number', value);
+    }
+    if (value < 1 || !NumberIsSafeInteger(value)) {
+      throw new ERR_INVALID_OPT_VALUE.RangeError('value', value);
+    }
+    return this[kHandle].record(value);
+  }
+
+  reset() { this[kHandle].reset(); }
+
+  get min() { return this[kHandle].min(); }
+  get max() { return this[kHandle].max(); }
+  get mean() { return this[kHandle].mean(); }
+  get stddev() { return this[kHandle].stddev(); }
+
+  percentile(percentile) {
+    if (typeof percentile !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('percentile', 'number', percentile);
+    }
+    if (percentile <= 0 || percentile > 100) {
+      throw new ERR_INVALID_OPT_VALUE.RangeError('percentile', percentile);
+    }
+    return this[kHandle].percentile(percentile);
+  }
+
+  get percentiles() {
+    this[kMap].clear();
+    this[kHandle].percentiles(this[kMap]);
+    return this[kMap];
+  }
+
+  [kInspect]() {
+    return {
+      min: this.min,
+      max: this.max,
+      mean: this.mean,
+      stddev: this.stddev,
+      percentiles: this.percentiles,
+    };
+  }
+}
+
+function createHistogram(options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const {
+    lowest = 1,
+    highest = NumberMAX_SAFE_INTEGER,
+    figures = 3,
+  } = options;
+  if (typeof lowest !== 'number') {
+    throw new ERR_INVALID_ARG_TYPE('options.lowest', 'number', lowest);
+  }
+  if (lowest < 1 || !NumberIsSafeInteger(lowest)) {
+    throw new ERR_INVALID_OPT_VALUE.RangeError('lowest', lowest);
+  }
+  if (typeof highest !== 'number') {
+    throw new ERR_INVALID_ARG_TYPE('options.highest', 'number', highest);
+  }
+  if (highest <= lowest || !NumberIsSafeInteger(highest)) {
+    throw new ERR_INVALID_OPT_VALUE.RangeError('highest', highest);
+  }
+  if (typeof figures !== 'number') {
+    throw new ERR_INVALID_ARG_TYPE('options.figures', 'number', figures);
+  }
+  if (figures < 1 || figures > 5 || !NumberIsSafeInteger(figures)) {
+    throw new ERR_INVALID_OPT_VALUE.RangeError('figures', figures);
+  }
+  return new RecordableHistogram(new _Histogram(lowest, highest, figures));
+}
+
+module.exports = {
+  RecordableHistogram,
+  createHistogram,
+};
@@ -193,6 +193,8 @@ const IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT = 2;
 const IDX_STREAM_STATE_LOCAL_CLOSE = 3;
 const IDX_STREAM_STATE_REMOTE_CLOSE = 4;
 const IDX_STREAM_STATE_LOCAL_WINDOW_SIZE = 5;
+const IDX_STREAM_STATE_DRR_SENT_BYTES = 6;
+const IDX_STREAM_STATE_DRR_DEFERRALS = 7;
 
 const IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE = 0;
 const IDX_OPTIONS_MAX_RESERVED_REMOTE_STREAMS = 1;
@@ -399,7 +401,11 @@ function getStreamState(stream) {
     sumDependencyWeight: streamState[IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT],
     localClose: streamState[IDX_STREAM_STATE_LOCAL_CLOSE],
     remoteClose: streamState[IDX_STREAM_STATE_REMOTE_CLOSE],
-    localWindowSize: streamState[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE]
+    localWindowSize: streamState[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE],
+    // Outbound scheduling fairness counters, see DRRAdmit() in
+    // src/node_http2.cc.
+    drrSentBytes: streamState[IDX_STREAM_STATE_DRR_SENT_BYTES],
+    drrDeferrals: streamState[IDX_STREAM_STATE_DRR_DEFERRALS]
   };
 }
 
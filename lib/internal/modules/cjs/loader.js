@@ -26,6 +26,7 @@ const {
   Error,
   JSONParse,
   Map,
+  MathImul,
   Number,
   ObjectCreate,
   ObjectDefineProperty,
@@ -69,6 +70,7 @@ const {
   loadNativeModule
 } = require('internal/modules/cjs/helpers');
 const { getOptionValue } = require('internal/options');
+const compileCacheDir = getOptionValue('--compile-cache-dir');
 const enableSourceMaps = getOptionValue('--enable-source-maps');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
@@ -1113,6 +1115,43 @@ Module.prototype.require = function(id) {
 let resolvedArgv;
 let hasPausedEntry = false;
 
+// Returns the on-disk location of the compiled-code cache for a module.
+// The key is a cheap FNV-1a hash of the filename plus the source length;
+// V8 itself validates the cached data against the source, so a collision
+// or a stale entry only costs a recompile, never a wrong result.
+function compileCachePath(filename, content) {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < filename.length; i++) {
+    hash ^= filename.charCodeAt(i);
+    hash = MathImul(hash, 0x01000193) >>> 0;
+  }
+  return path.join(compileCacheDir,
+                   `${hash.toString(16)}-${content.length}.cache`);
+}
+
+function readCompileCache(cachePath) {
+  try {
+    return fs.readFileSync(cachePath);
+  } catch {
+    return undefined;
+  }
+}
+
+function writeCompileCache(cachePath, data) {
+  try {
+    fs.writeFileSync(cachePath, data);
+  } catch {
+    // The cache directory may not exist yet; create it and retry once.
+    try {
+      fs.mkdirSync(compileCacheDir, { recursive: true });
+      fs.writeFileSync(cachePath, data);
+    } catch {
+      // Caching is best-effort; a read-only or full disk just means cold
+      // compiles.
+    }
+  }
+}
+
 function wrapSafe(filename, content, cjsModuleInstance) {
   if (patched) {
     const wrapper = Module.wrap(content);
@@ -1126,6 +1165,12 @@ function wrapSafe(filename, content, cjsModuleInstance) {
       },
     });
   }
+  let cachePath;
+  let cachedData;
+  if (compileCacheDir !== '') {
+    cachePath = compileCachePath(filename, content);
+    cachedData = readCompileCache(cachePath);
+  }
   let compiled;
   try {
     compiled = compileFunction(
@@ -1133,8 +1178,8 @@ function wrapSafe(filename, content, cjsModuleInstance) {
       filename,
       0,
       0,
-      undefined,
-      false,
+      cachedData,
+      cachePath !== undefined && cachedData === undefined,
       undefined,
       [],
       [
@@ -1151,6 +1196,18 @@ function wrapSafe(filename, content, cjsModuleInstance) {
     throw err;
   }
 
+  if (cachePath !== undefined) {
+    if (cachedData === undefined && compiled.cachedDataProduced) {
+      writeCompileCache(cachePath, compiled.cachedData);
+    } else if (cachedData !== undefined && compiled.cachedDataRejected) {
+      // Stale entry (different V8 version or changed source with the same
+      // key); drop it so the next run regenerates it.
+      try {
+        fs.unlinkSync(cachePath);
+      } catch {}
+    }
+  }
+
   const { callbackMap } = internalBinding('module_wrap');
   callbackMap.set(compiled.cacheKey, {
     importModuleDynamically: async (specifier) => {
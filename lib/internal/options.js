@@ -1,14 +1,21 @@
 'use strict';
 
+const {
+  SafeMap,
+} = primordials;
+
 const { getOptions } = internalBinding('options');
 const { options, aliases } = getOptions();
 
+// Flat option → value lookup table so that hot paths do not have to
+// dereference the per-option metadata object on every query.
+const optionValues = new SafeMap();
+for (const [option, info] of options) {
+  optionValues.set(option, info.value);
+}
+
 function getOptionValue(option) {
-  const result = options.get(option);
-  if (!result) {
-    return undefined;
-  }
-  return result.value;
+  return optionValues.get(option);
 }
 
 module.exports = {
@@ -43,6 +43,7 @@ function wrapProcessMethods(binding) {
     hrtimeBigInt: _hrtimeBigInt,
     cpuUsage: _cpuUsage,
     memoryUsage: _memoryUsage,
+    memoryUsageDetailed: _memoryUsageDetailed,
     resourceUsage: _resourceUsage
   } = binding;
 
@@ -156,6 +157,12 @@ function wrapProcessMethods(binding) {
     };
   }
 
+  // Per-subsystem breakdown of native memory, aggregated from the same
+  // retainer information that feeds heap snapshots but much cheaper.
+  memoryUsage.detailed = function detailed() {
+    return _memoryUsageDetailed();
+  };
+
   function exit(code) {
     if (code || code === 0)
       process.exitCode = code;
@@ -102,7 +102,10 @@ function removeSignalHandler() {
 }
 
 function signalHandler(sig) {
-  nr.writeReport(sig, 'Signal', null, '');
+  // Serialize and write the report off-thread; a signal-triggered report is
+  // usually taken to inspect a live (possibly busy) process, so the event
+  // loop should only pay for the capture phase.
+  nr.writeReportAsync(sig, 'Signal', null, '');
 }
 
 module.exports = {
@@ -9,6 +9,9 @@ const {
   // For easy access to the nextTick state in the C++ land,
   // and to avoid unnecessary calls into JS land.
   tickInfo,
+  // Monitoring counters shared with the C++ land; updated here so that
+  // reading them never requires a callback into JS.
+  taskQueueStats,
   // Used to run V8's micro task queue.
   runMicrotasks,
   setTickCallback,
@@ -46,6 +49,11 @@ const FixedQueue = require('internal/fixed_queue');
 // *Must* match Environment::TickInfo::Fields in src/env.h.
 const kHasTickScheduled = 0;
 
+// *Must* match Environment::TaskQueueStats::Fields in src/env.h.
+const kTicksEnqueued = 0;
+const kTicksDrained = 1;
+const kMaxTickDepth = 2;
+
 function hasTickScheduled() {
   return tickInfo[kHasTickScheduled] === 1;
 }
@@ -68,8 +76,10 @@ function runNextTicks() {
 
 function processTicksAndRejections() {
   let tock;
+  let depth = 0;
   do {
     while (tock = queue.shift()) {
+      depth++;
       const asyncId = tock[async_id_symbol];
       emitBefore(asyncId, tock[trigger_async_id_symbol]);
 
@@ -96,6 +106,9 @@ function processTicksAndRejections() {
     }
     runMicrotasks();
   } while (!queue.isEmpty() || processPromiseRejections());
+  taskQueueStats[kTicksDrained] += depth;
+  if (depth > taskQueueStats[kMaxTickDepth])
+    taskQueueStats[kMaxTickDepth] = depth;
   setHasTickScheduled(false);
   setHasRejectionToWarn(false);
 }
@@ -133,6 +146,7 @@ function nextTick(callback) {
   };
   if (initHooksExist())
     emitInit(asyncId, 'TickObject', triggerAsyncId, tickObject);
+  taskQueueStats[kTicksEnqueued]++;
   queue.push(tickObject);
 }
 
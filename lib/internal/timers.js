@@ -73,6 +73,7 @@
 // have shown to be trivial in comparison to other timers architectures.
 
 const {
+  Map,
   MathMax,
   MathTrunc,
   NumberMIN_SAFE_INTEGER,
@@ -84,7 +85,10 @@ const {
   scheduleTimer,
   toggleTimerRef,
   getLibuvNow,
-  immediateInfo
+  immediateInfo,
+  coarseClockFields,
+  kCoarseClockDateNow,
+  TimerWheel
 } = internalBinding('timers');
 
 const {
@@ -588,6 +592,52 @@ function getTimerCallbacks(runNextTicks) {
   };
 }
 
+// Coarse timeouts backed by the native hierarchical timer wheel. Arming and
+// cancelling are O(1) and do not touch the Timeout priority queue, which
+// makes them suitable for high-churn, cancel-heavy timers such as
+// per-connection idle timeouts. Callbacks may fire a few milliseconds late;
+// anything that needs exact timing should use setTimeout() instead.
+let timerWheel = null;
+const coarseTimeoutCallbacks = new Map();
+
+function getTimerWheel() {
+  if (timerWheel === null) {
+    timerWheel = new TimerWheel();
+    timerWheel.onexpired = function(ids) {
+      for (let i = 0; i < ids.length; i++) {
+        const callback = coarseTimeoutCallbacks.get(ids[i]);
+        if (callback !== undefined) {
+          coarseTimeoutCallbacks.delete(ids[i]);
+          callback();
+        }
+      }
+    };
+  }
+  return timerWheel;
+}
+
+function setCoarseTimeout(callback, after) {
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+  const id = getTimerWheel().arm(after);
+  coarseTimeoutCallbacks.set(id, callback);
+  return id;
+}
+
+function clearCoarseTimeout(id) {
+  if (coarseTimeoutCallbacks.delete(id))
+    getTimerWheel().cancel(id);
+}
+
+// Wall clock in Date.now() units, read from the native per-turn cache: one
+// clock call per loop turn instead of one per stamp, at the cost of up to a
+// loop turn of slack. Meant for log timestamps and similar coarse
+// bookkeeping; timer scheduling keeps using getLibuvNow(), since a stale
+// start time could make a timer fire early.
+function coarseNow() {
+  return coarseClockFields[kCoarseClockDateNow];
+}
+
 module.exports = {
   TIMEOUT_MAX,
   kTimeout: Symbol('timeout'), // For hiding Timeouts on other internals.
@@ -611,5 +661,8 @@ module.exports = {
   timerListMap,
   timerListQueue,
   decRefCount,
-  incRefCount
+  incRefCount,
+  setCoarseTimeout,
+  clearCoarseTimeout,
+  coarseNow
 };
@@ -60,6 +60,7 @@ const {
   encodeAuth,
   toUSVString: _toUSVString,
   parse,
+  scanComponents,
   setURLConstructor,
   URL_FLAGS_CANNOT_BE_BASE,
   URL_FLAGS_HAS_FRAGMENT,
@@ -129,6 +130,9 @@ class URLContext {
     this.path = [];
     this.query = null;
     this.fragment = null;
+    // Serialization with default options, memoized by kFormat. Every
+    // mutation of the fields above must reset this to null.
+    this.href = null;
   }
 }
 
@@ -234,9 +238,46 @@ class URLSearchParams {
   }
 }
 
+// Scratch space for the scanComponents() fast path below; holds
+// [ schemeEnd, hostStart, hostEnd, port, pathStart, pathEnd,
+//   queryStart, fragmentStart ], with kNoComponent marking absent ones.
+const scanResult = new Uint32Array(8);
+const kNoComponent = 0xFFFFFFFF;
+
+// Fill the context from the component offsets reported by
+// scanComponents() for inputs that are already in canonical form. The
+// resulting context is identical to what a full parse would produce.
+function onScanComplete(input) {
+  const ctx = this[context];
+  const port = scanResult[3];
+  const queryStart = scanResult[6];
+  const fragmentStart = scanResult[7];
+  let flags = URL_FLAGS_SPECIAL | URL_FLAGS_HAS_HOST | URL_FLAGS_HAS_PATH;
+  if (queryStart !== kNoComponent)
+    flags |= URL_FLAGS_HAS_QUERY;
+  if (fragmentStart !== kNoComponent)
+    flags |= URL_FLAGS_HAS_FRAGMENT;
+  ctx.flags = flags;
+  ctx.scheme = input.slice(0, scanResult[0]);
+  ctx.host = input.slice(scanResult[1], scanResult[2]);
+  ctx.port = port === kNoComponent ? null : port;
+  ctx.path = input.slice(scanResult[4] + 1, scanResult[5]).split('/');
+  ctx.query = queryStart === kNoComponent ?
+    null :
+    input.slice(queryStart,
+                fragmentStart === kNoComponent ?
+                  input.length : fragmentStart - 1);
+  ctx.fragment = fragmentStart === kNoComponent ?
+    null : input.slice(fragmentStart);
+  this[searchParams] = new URLSearchParams();
+  this[searchParams][context] = this;
+  initSearchParams(this[searchParams], ctx.query);
+}
+
 function onParseComplete(flags, protocol, username, password,
                          host, port, path, query, fragment) {
   const ctx = this[context];
+  ctx.href = null;
   ctx.flags = flags;
   ctx.scheme = protocol;
   ctx.username = (flags & URL_FLAGS_HAS_USERNAME) !== 0 ? username : '';
@@ -260,6 +301,7 @@ function onParseError(flags, input) {
 function onParseProtocolComplete(flags, protocol, username, password,
                                  host, port, path, query, fragment) {
   const ctx = this[context];
+  ctx.href = null;
   if ((flags & URL_FLAGS_SPECIAL) !== 0) {
     ctx.flags |= URL_FLAGS_SPECIAL;
   } else {
@@ -272,6 +314,7 @@ function onParseProtocolComplete(flags, protocol, username, password,
 function onParseHostnameComplete(flags, protocol, username, password,
                                  host, port, path, query, fragment) {
   const ctx = this[context];
+  ctx.href = null;
   if ((flags & URL_FLAGS_HAS_HOST) !== 0) {
     ctx.host = host;
     ctx.flags |= URL_FLAGS_HAS_HOST;
@@ -283,7 +326,9 @@ function onParseHostnameComplete(flags, protocol, username, password,
 
 function onParsePortComplete(flags, protocol, username, password,
                              host, port, path, query, fragment) {
-  this[context].port = port;
+  const ctx = this[context];
+  ctx.href = null;
+  ctx.port = port;
 }
 
 function onParseHostComplete(flags, protocol, username, password,
@@ -296,6 +341,7 @@ function onParseHostComplete(flags, protocol, username, password,
 function onParsePathComplete(flags, protocol, username, password,
                              host, port, path, query, fragment) {
   const ctx = this[context];
+  ctx.href = null;
   if ((flags & URL_FLAGS_HAS_PATH) !== 0) {
     ctx.path = path;
     ctx.flags |= URL_FLAGS_HAS_PATH;
@@ -313,12 +359,16 @@ function onParsePathComplete(flags, protocol, username, password,
 
 function onParseSearchComplete(flags, protocol, username, password,
                                host, port, path, query, fragment) {
-  this[context].query = query;
+  const ctx = this[context];
+  ctx.href = null;
+  ctx.query = query;
 }
 
 function onParseHashComplete(flags, protocol, username, password,
                              host, port, path, query, fragment) {
-  this[context].fragment = fragment;
+  const ctx = this[context];
+  ctx.href = null;
+  ctx.fragment = fragment;
 }
 
 class URL {
@@ -330,6 +380,10 @@ class URL {
       base_context = new URL(base)[context];
     }
     this[context] = new URLContext();
+    if (base_context === undefined && scanComponents(input, scanResult)) {
+      onScanComplete.call(this, input);
+      return;
+    }
     parse(input, -1, base_context, undefined, onParseComplete.bind(this),
           onParseError);
   }
@@ -404,6 +458,12 @@ ObjectDefineProperties(URL.prototype, {
         ...options
       };
       const ctx = this[context];
+      // Reserialization is memoized for the default options; any context
+      // mutation resets ctx.href.
+      const isDefault = options.fragment && options.search &&
+                        options.auth && !options.unicode;
+      if (isDefault && ctx.href !== null)
+        return ctx.href;
       let ret = ctx.scheme;
       if (ctx.host !== null) {
         ret += '//';
@@ -429,6 +489,8 @@ ObjectDefineProperties(URL.prototype, {
         ret += `?${ctx.query}`;
       if (options.fragment && ctx.fragment !== null)
         ret += `#${ctx.fragment}`;
+      if (isDefault)
+        ctx.href = ret;
       return ret;
     }
   },
@@ -518,6 +580,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      ctx.href = null;
       if (username === '') {
         ctx.username = '';
         ctx.flags &= ~URL_FLAGS_HAS_USERNAME;
@@ -539,6 +602,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      ctx.href = null;
       if (password === '') {
         ctx.password = '';
         ctx.flags &= ~URL_FLAGS_HAS_PASSWORD;
@@ -599,6 +663,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      ctx.href = null;
       if (port === '') {
         ctx.port = null;
         return;
@@ -637,6 +702,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(search) {
       const ctx = this[context];
+      ctx.href = null;
       search = toUSVString(search);
       if (search === '') {
         ctx.query = null;
@@ -670,6 +736,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(hash) {
       const ctx = this[context];
+      ctx.href = null;
       // toUSVString is not needed.
       hash = `${hash}`;
       if (!hash) {
@@ -699,6 +766,7 @@ function update(url, params) {
     return;
 
   const ctx = url[context];
+  ctx.href = null;
   const serializedParams = params.toString();
   if (serializedParams) {
     ctx.query = serializedParams;
@@ -63,8 +63,15 @@ function isBigUint64Array(value) {
   return TypedArrayProto_toStringTag(value) === 'BigUint64Array';
 }
 
+// classify()/classifyBits batch all native predicates into one binding
+// crossing; they are for internal callers (which use internalBinding
+// directly) and must not leak onto the public util.types surface.
+const bindingTypes = { ...internalBinding('types') };
+delete bindingTypes.classify;
+delete bindingTypes.classifyBits;
+
 module.exports = {
-  ...internalBinding('types'),
+  ...bindingTypes,
   isArrayBufferView: ArrayBufferIsView,
   isTypedArray,
   isUint8Array,
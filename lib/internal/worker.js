@@ -23,9 +23,14 @@ const {
   ERR_WORKER_UNSERIALIZABLE_ERROR,
   ERR_WORKER_UNSUPPORTED_EXTENSION,
   ERR_WORKER_INVALID_EXEC_ARGV,
+  ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
   ERR_INVALID_ARG_TYPE,
+  ERR_OUT_OF_RANGE,
 } = errorCodes;
-const { validateString } = require('internal/validators');
+const {
+  validateInt32,
+  validateString,
+} = require('internal/validators');
 const { getOptionValue } = require('internal/options');
 
 const workerIo = require('internal/worker/io');
@@ -53,9 +58,16 @@ const {
   kMaxYoungGenerationSizeMb,
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
-  kTotalResourceLimitCount
+  kTotalResourceLimitCount,
+  kSpawnStarted,
+  kSpawnIsolateReady,
+  kSpawnContextReady,
+  kSpawnEnvironmentReady,
+  kSpawnBootstrapComplete
 } = internalBinding('worker');
 
+const { PerformanceEntry, notify } = internalBinding('performance');
+
 const kHandle = Symbol('kHandle');
 const kPublicPort = Symbol('kPublicPort');
 const kDispose = Symbol('kDispose');
@@ -79,6 +91,21 @@ if (isMainThread) {
   };
 }
 
+class WorkerSpawnTiming extends PerformanceEntry {
+  constructor(worker, timing) {
+    super();
+    this.name = 'Worker';
+    this.entryType = 'worker';
+    this.startTime = timing[kSpawnStarted];
+    this.duration = timing[kSpawnBootstrapComplete];
+    this.threadId = worker.threadId;
+    this.isolateInit = timing[kSpawnIsolateReady];
+    this.contextInit = timing[kSpawnContextReady];
+    this.environmentInit = timing[kSpawnEnvironmentReady];
+    this.bootstrapComplete = timing[kSpawnBootstrapComplete];
+  }
+}
+
 class Worker extends EventEmitter {
   constructor(filename, options = {}) {
     super();
@@ -129,6 +156,31 @@ class Worker extends EventEmitter {
     if (this[kHandle].invalidExecArgv) {
       throw new ERR_WORKER_INVALID_EXEC_ARGV(this[kHandle].invalidExecArgv);
     }
+    if (options.cpuSet !== undefined || options.priority !== undefined) {
+      let cpuSet = null;
+      if (options.cpuSet !== undefined) {
+        if (!ArrayIsArray(options.cpuSet) || options.cpuSet.length === 0) {
+          throw new ERR_INVALID_ARG_TYPE('options.cpuSet',
+                                         'Array',
+                                         options.cpuSet);
+        }
+        for (const cpu of options.cpuSet)
+          validateInt32(cpu, 'options.cpuSet', 0);
+        cpuSet = options.cpuSet;
+      }
+      let priority = null;
+      if (options.priority !== undefined) {
+        validateInt32(priority = options.priority, 'options.priority');
+        if (priority < -20 || priority > 19)
+          throw new ERR_OUT_OF_RANGE('options.priority',
+                                     '>= -20 && <= 19',
+                                     priority);
+      }
+      if (!this[kHandle].setScheduling(cpuSet, priority)) {
+        throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM(
+          'worker thread scheduling');
+      }
+    }
     if (env === process.env) {
       // This may be faster than manually cloning the object in C++, especially
       // when recursively spawning Workers.
@@ -207,6 +259,8 @@ class Worker extends EventEmitter {
   [kOnMessage](message) {
     switch (message.type) {
       case messageTypes.UP_AND_RUNNING:
+        notify('worker',
+               new WorkerSpawnTiming(this, this[kHandle].getSpawnTiming()));
         return this.emit('online');
       case messageTypes.COULD_NOT_SERIALIZE_ERROR:
         return this[kOnCouldNotSerializeErr]();
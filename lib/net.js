@@ -508,6 +508,41 @@ Socket.prototype.setKeepAlive = function(setting, msecs) {
 };
 
 
+// Mark this socket as latency-critical: incoming data extends the event
+// loop's busy-poll spin window (see --busy-poll-window) and, on Linux,
+// `usec` is also passed to the kernel via SO_BUSY_POLL. Pass 0 to revert
+// to normal blocking poll behavior.
+Socket.prototype.setBusyPoll = function(usec) {
+  if (!this._handle) {
+    this.once('connect', () => this.setBusyPoll(usec));
+    return this;
+  }
+
+  if (this._handle.setBusyPoll)
+    this._handle.setBusyPoll(usec >>> 0);
+
+  return this;
+};
+
+
+// Opt into batched read delivery: data chunks arriving within one event
+// loop iteration are delivered as a single 'data' event. This trades chunk
+// granularity for fewer C++ to JS transitions on very busy sockets. It must
+// not be enabled on sockets that are wrapped by another native stream
+// consumer (e.g. TLS).
+Socket.prototype.setReadBatching = function(enable) {
+  if (!this._handle) {
+    this.once('connect', () => this.setReadBatching(enable));
+    return this;
+  }
+
+  if (this._handle.setReadBatching)
+    this._handle.setReadBatching(!!enable);
+
+  return this;
+};
+
+
 Socket.prototype.address = function() {
   return this._getsockname();
 };
@@ -888,6 +923,12 @@ function internalConnect(
   }
 
   if (addressType === 6 || addressType === 4) {
+    // Defer the SYN until the first write so its payload can ride in the
+    // SYN itself (TCP Fast Open). Best-effort: unsupported platforms and
+    // kernels simply perform a regular connect.
+    if (self._fastOpen && self._handle.setFastOpenConnect)
+      self._handle.setFastOpenConnect(addressType);
+
     const req = new TCPConnectWrap();
     req.oncomplete = afterConnect;
     req.address = address;
@@ -970,6 +1011,7 @@ Socket.prototype.connect = function(...args) {
       this[async_id_symbol], internalConnect, this, path
     );
   } else {
+    this._fastOpen = !!options.fastOpen;
     lookupAndConnect(this, options);
   }
   return this;
@@ -1194,6 +1236,10 @@ function Server(options, connectionListener) {
 
   this.allowHalfOpen = options.allowHalfOpen || false;
   this.pauseOnConnect = !!options.pauseOnConnect;
+  // TCP Fast Open accept queue length; `true` selects a default of 256
+  // pending TFO requests.
+  const { fastOpen } = options;
+  this._fastOpen = fastOpen === true ? 256 : (fastOpen >>> 0);
 }
 ObjectSetPrototypeOf(Server.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(Server, EventEmitter);
@@ -1301,6 +1347,12 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
   this._handle.onconnection = onconnection;
   this._handle[owner_symbol] = this;
 
+  // TCP Fast Open has to be enabled before listen(); data carried in a
+  // SYN is then delivered with the first read on the accepted connection.
+  // Best-effort: kernels without TFO support just do regular handshakes.
+  if (this._fastOpen && this._handle.setFastOpen)
+    this._handle.setFastOpen(this._fastOpen);
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
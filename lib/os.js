@@ -40,7 +40,9 @@ const {
 const { validateInt32 } = require('internal/validators');
 
 const {
-  getCPUs,
+  availableParallelism,
+  effectiveMemory,
+  getCPUTopology,
   getFreeMem,
   getHomeDirectory: _getHomeDirectory,
   getHostname: _getHostname,
@@ -53,6 +55,7 @@ const {
   getUserInfo,
   getUptime,
   isBigEndian,
+  refreshCPUTimes,
   setPriority: _setPriority
 } = internalBinding('os');
 
@@ -73,6 +76,8 @@ const getInterfaceAddresses = getCheckedFunction(_getInterfaceAddresses);
 const getOSRelease = getCheckedFunction(_getOSRelease);
 const getOSType = getCheckedFunction(_getOSType);
 
+availableParallelism[SymbolToPrimitive] = () => availableParallelism();
+effectiveMemory[SymbolToPrimitive] = () => effectiveMemory();
 getFreeMem[SymbolToPrimitive] = () => getFreeMem();
 getHostname[SymbolToPrimitive] = () => getHostname();
 getHomeDirectory[SymbolToPrimitive] = () => getHomeDirectory();
@@ -93,21 +98,35 @@ function loadavg() {
   return [avgValues[0], avgValues[1], avgValues[2]];
 }
 
+// The model strings and speeds never change at runtime, so they are fetched
+// once and the changing tick counters are refreshed in place through a
+// reusable typed array, keeping repeated polling allocation-free on the
+// native side.
+let cpuTopology;
+let cpuTimes;
+
 function cpus() {
-  // [] is a bugfix for a regression introduced in 51cea61
-  const data = getCPUs() || [];
+  if (cpuTimes === undefined ||
+      refreshCPUTimes(cpuTimes) * 5 !== cpuTimes.length) {
+    // First call, or the core count changed: re-read the static topology
+    // and size the reusable tick buffer to match.
+    // [] is a bugfix for a regression introduced in 51cea61
+    cpuTopology = getCPUTopology() || [];
+    cpuTimes = new Float64Array(cpuTopology.length / 2 * 5);
+    if (refreshCPUTimes(cpuTimes) * 5 !== cpuTimes.length)
+      return [];
+  }
   const result = [];
-  let i = 0;
-  while (i < data.length) {
+  for (let i = 0, t = 0; i < cpuTopology.length;) {
     result.push({
-      model: data[i++],
-      speed: data[i++],
+      model: cpuTopology[i++],
+      speed: cpuTopology[i++],
       times: {
-        user: data[i++],
-        nice: data[i++],
-        sys: data[i++],
-        idle: data[i++],
-        irq: data[i++]
+        user: cpuTimes[t++],
+        nice: cpuTimes[t++],
+        sys: cpuTimes[t++],
+        idle: cpuTimes[t++],
+        irq: cpuTimes[t++]
       }
     });
   }
@@ -269,7 +288,9 @@ function userInfo(options) {
 
 module.exports = {
   arch,
+  availableParallelism,
   cpus,
+  effectiveMemory,
   endianness,
   freemem: getFreeMem,
   getPriority,
@@ -18,12 +18,17 @@ const {
   mark: _mark,
   clearMark: _clearMark,
   measure: _measure,
+  loopPhases,
   milestones,
   observerCounts,
   setupObservers,
   timeOrigin,
   timeOriginTimestamp,
   timerify,
+  loopLatency: _loopLatency,
+  countersStart,
+  countersStop,
+  countersRead,
   constants,
   installGarbageCollectionTracking,
   removeGarbageCollectionTracking
@@ -37,13 +42,19 @@ const {
   NODE_PERFORMANCE_ENTRY_TYPE_FUNCTION,
   NODE_PERFORMANCE_ENTRY_TYPE_HTTP2,
   NODE_PERFORMANCE_ENTRY_TYPE_HTTP,
+  NODE_PERFORMANCE_ENTRY_TYPE_WORKER,
 
   NODE_PERFORMANCE_MILESTONE_NODE_START,
   NODE_PERFORMANCE_MILESTONE_V8_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
   NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+
+  NODE_PERFORMANCE_LOOP_PHASE_TIMERS,
+  NODE_PERFORMANCE_LOOP_PHASE_POLL,
+  NODE_PERFORMANCE_LOOP_PHASE_CHECK,
+  NODE_PERFORMANCE_LOOP_PHASE_ITERATIONS
 } = constants;
 
 const { AsyncResource } = require('async_hooks');
@@ -83,7 +94,8 @@ const observerableTypes = [
   'gc',
   'function',
   'http2',
-  'http'
+  'http',
+  'worker'
 ];
 
 const IDX_STREAM_STATS_ID = 0;
@@ -204,6 +216,19 @@ class PerformanceNodeTiming extends PerformanceEntry {
     return getMilestoneTimestamp(NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE);
   }
 
+  // Cumulative time in milliseconds the event loop has spent in each phase,
+  // plus the number of loop iterations so far. The counters are updated
+  // natively on every loop turn, so reading this repeatedly (e.g. once per
+  // second for monitoring) has no additional cost.
+  get loopPhases() {
+    return {
+      timers: loopPhases[NODE_PERFORMANCE_LOOP_PHASE_TIMERS],
+      poll: loopPhases[NODE_PERFORMANCE_LOOP_PHASE_POLL],
+      check: loopPhases[NODE_PERFORMANCE_LOOP_PHASE_CHECK],
+      iterations: loopPhases[NODE_PERFORMANCE_LOOP_PHASE_ITERATIONS]
+    };
+  }
+
   [kInspect]() {
     return {
       name: 'node',
@@ -215,7 +240,8 @@ class PerformanceNodeTiming extends PerformanceEntry {
       bootstrapComplete: this.bootstrapComplete,
       environment: this.environment,
       loopStart: this.loopStart,
-      loopExit: this.loopExit
+      loopExit: this.loopExit,
+      loopPhases: this.loopPhases
     };
   }
 }
@@ -414,6 +440,22 @@ class Performance {
     }
   }
 
+  // Hardware performance counters (Linux perf_event). Returns false where
+  // counters are unavailable (non-Linux, or perf_event access denied).
+  startHardwareCounters() {
+    return countersStart();
+  }
+
+  stopHardwareCounters() {
+    countersStop();
+  }
+
+  // Returns an object of BigInt counter values, or undefined while the
+  // counters are not running.
+  readHardwareCounters() {
+    return countersRead();
+  }
+
   timerify(fn) {
     if (typeof fn !== 'function') {
       throw new ERR_INVALID_ARG_TYPE('fn', 'Function', fn);
@@ -520,6 +562,7 @@ function mapTypes(i) {
     case 'function': return NODE_PERFORMANCE_ENTRY_TYPE_FUNCTION;
     case 'http2': return NODE_PERFORMANCE_ENTRY_TYPE_HTTP2;
     case 'http': return NODE_PERFORMANCE_ENTRY_TYPE_HTTP;
+    case 'worker': return NODE_PERFORMANCE_ENTRY_TYPE_WORKER;
   }
 }
 
@@ -615,10 +658,17 @@ function monitorEventLoopDelay(options = {}) {
   return new ELDHistogram(new _ELDHistogram(resolution));
 }
 
+// Unlike monitorEventLoopDelay(), this reads the native always-on recorder:
+// no timer, no enable step, and taking a snapshot does not pause recording.
+function loopLatency() {
+  return _loopLatency();
+}
+
 module.exports = {
   performance,
   PerformanceObserver,
-  monitorEventLoopDelay
+  monitorEventLoopDelay,
+  loopLatency
 };
 
 ObjectDefineProperty(module.exports, 'constants', {
@@ -26,11 +26,13 @@
 const {
   Array,
   ArrayIsArray,
+  NumberIsInteger,
   ObjectCreate,
   ObjectKeys,
 } = primordials;
 
 const { Buffer } = require('buffer');
+const { parse: parseNative } = internalBinding('querystring');
 const {
   encodeStr,
   hexTable,
@@ -244,6 +246,27 @@ function parse(qs, sep, eq, options) {
     return obj;
   }
 
+  // Fast path: with the default separators and decoder the whole string can
+  // be split and percent-decoded in a single native pass. The binding punts
+  // (returns undefined) on input containing literal non-ASCII characters.
+  if (!sep && !eq &&
+      (options === undefined || options === null ||
+       (typeof options.decodeURIComponent !== 'function' &&
+        (typeof options.maxKeys !== 'number' ||
+         NumberIsInteger(options.maxKeys))))) {
+    let maxPairs = 1000;
+    if (options && typeof options.maxKeys === 'number')
+      maxPairs = (options.maxKeys > 0 ? options.maxKeys : -1);
+    if (maxPairs > 2 ** 31 - 1)
+      maxPairs = -1;  // More pairs than could possibly fit in the input.
+    const parts = parseNative(qs, maxPairs);
+    if (parts !== undefined) {
+      for (let i = 0; i < parts.length; i += 2)
+        addKeyVal(obj, parts[i], parts[i + 1], false, false, undefined);
+      return obj;
+    }
+  }
+
   const sepCodes = (!sep ? defSepCodes : charCodes(sep + ''));
   const eqCodes = (!eq ? defEqCodes : charCodes(eq + ''));
   const sepLen = sepCodes.length;
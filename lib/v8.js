@@ -33,10 +33,17 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
-const { validateString } = require('internal/validators');
+const {
+  ERR_INVALID_ARG_TYPE
+} = require('internal/errors').codes;
+const {
+  validateString,
+  validateUint32
+} = require('internal/validators');
 const {
   Serializer: _Serializer,
-  Deserializer: _Deserializer
+  Deserializer: _Deserializer,
+  clone
 } = internalBinding('serdes');
 const assert = require('internal/assert');
 const { copy } = internalBinding('buffer');
@@ -90,8 +97,20 @@ class HeapSnapshotStream extends Readable {
   }
 }
 
-function getHeapSnapshot() {
-  const handle = createHeapSnapshotStream();
+function getHeapSnapshot(options) {
+  let incremental = false;
+  if (options !== undefined) {
+    if (typeof options !== 'object' || options === null)
+      throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+    incremental = options.incremental;
+    if (incremental === undefined) {
+      incremental = false;
+    } else if (typeof incremental !== 'boolean') {
+      throw new ERR_INVALID_ARG_TYPE('options.incremental', 'boolean',
+                                     incremental);
+    }
+  }
+  const handle = createHeapSnapshotStream(incremental);
   assert(handle);
   return new HeapSnapshotStream(handle);
 }
@@ -112,6 +131,11 @@ const {
   updateHeapStatisticsArrayBuffer,
   updateHeapSpaceStatisticsArrayBuffer,
   updateHeapCodeStatisticsArrayBuffer,
+  setHeapSpaceStatisticsGCTracking: _setHeapSpaceStatisticsGCTracking,
+  setMemoryPressureCallback: _setMemoryPressureCallback,
+  startAllocationSampling: _startAllocationSampling,
+  stopAllocationSampling: _stopAllocationSampling,
+  readAllocationSamples,
 
   // Properties for heap statistics buffer extraction.
   kTotalHeapSizeIndex,
@@ -176,10 +200,60 @@ function getHeapStatistics() {
   };
 }
 
+let allocationSampleInterval = 0;
+
+function startAllocationSampling(interval) {
+  validateUint32(interval, 'interval', true);
+  allocationSampleInterval = interval;
+  _startAllocationSampling(interval);
+}
+
+function stopAllocationSampling() {
+  allocationSampleInterval = 0;
+  _stopAllocationSampling();
+}
+
+function getAllocationSamples() {
+  const flat = readAllocationSamples();
+  const interval = allocationSampleInterval;
+  const samples = [];
+  for (let i = 0; i < flat.length; i += 3) {
+    samples.push({
+      asyncId: flat[i],
+      count: flat[i + 1],
+      bytes: flat[i + 2],
+      // The sampled values scaled back up by the sampling interval.
+      estimatedCount: flat[i + 1] * interval,
+      estimatedBytes: flat[i + 2] * interval
+    });
+  }
+  return samples;
+}
+
+let heapSpaceGCTracking = false;
+
+function setHeapSpaceStatisticsGCTracking(enable) {
+  if (typeof enable !== 'boolean')
+    throw new ERR_INVALID_ARG_TYPE('enable', 'boolean', enable);
+  if (enable === heapSpaceGCTracking)
+    return;
+  heapSpaceGCTracking = enable;
+  _setHeapSpaceStatisticsGCTracking(enable);
+}
+
+function setMemoryPressureCallback(callback) {
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_ARG_TYPE('callback', 'function', callback);
+  _setMemoryPressureCallback(callback);
+}
+
 function getHeapSpaceStatistics() {
   const heapSpaceStatistics = new Array(kNumberOfHeapSpaces);
   const buffer = heapSpaceStatisticsBuffer;
-  updateHeapSpaceStatisticsArrayBuffer();
+  // While GC tracking keeps the buffer fresh there is no need for a
+  // native call; the numbers are at most one GC cycle old.
+  if (!heapSpaceGCTracking)
+    updateHeapSpaceStatisticsArrayBuffer();
 
   for (let i = 0; i < kNumberOfHeapSpaces; i++) {
     const propertyOffset = i * kHeapSpaceStatisticsPropertiesCount;
@@ -310,11 +384,17 @@ function deserialize(buffer) {
 
 module.exports = {
   cachedDataVersionTag,
+  clone,
+  getAllocationSamples,
   getHeapSnapshot,
   getHeapStatistics,
   getHeapSpaceStatistics,
   getHeapCodeStatistics,
   setFlagsFromString,
+  setHeapSpaceStatisticsGCTracking,
+  setMemoryPressureCallback,
+  startAllocationSampling,
+  stopAllocationSampling,
   Serializer,
   Deserializer,
   DefaultSerializer,
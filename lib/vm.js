@@ -24,6 +24,8 @@
 const {
   ArrayIsArray,
   ArrayPrototypeForEach,
+  ObjectFreeze,
+  ObjectSetPrototypeOf,
   Symbol,
 } = primordials;
 
@@ -31,7 +33,8 @@ const {
   ContextifyScript,
   makeContext,
   isContext: _isContext,
-  compileFunction: _compileFunction
+  compileFunction: _compileFunction,
+  compileScriptStreaming: _compileScriptStreaming,
 } = internalBinding('contextify');
 const {
   ERR_INVALID_ARG_TYPE,
@@ -402,6 +405,41 @@ function compileFunction(code, params, options = {}) {
 }
 
 
+// Compiles a script from a file path or open file descriptor using V8's
+// background streaming parser: chunks are read and parsed on a worker
+// thread, so the source is never held as one string before parsing begins.
+// Falls back to a regular compilation when V8 declines to stream.
+async function compileScriptStreaming(source, options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const {
+    filename = 'evalmachine.<anonymous>',
+    lineOffset = 0,
+    columnOffset = 0,
+  } = options;
+  validateString(filename, 'options.filename');
+  validateInt32(lineOffset, 'options.lineOffset');
+  validateInt32(columnOffset, 'options.columnOffset');
+  if (typeof source === 'number') {
+    validateInt32(source, 'source');
+  } else {
+    validateString(source, 'source');
+  }
+
+  const script = await _compileScriptStreaming(
+    source, filename, lineOffset, columnOffset);
+  if (script === undefined) {
+    // V8 cannot stream under the current flags; compile normally.
+    const { readFileSync } = require('fs');
+    return new Script(readFileSync(source, 'utf8'),
+                      { filename, lineOffset, columnOffset });
+  }
+  ObjectSetPrototypeOf(script, Script.prototype);
+  ObjectFreeze(script);
+  return script;
+}
+
 module.exports = {
   Script,
   createContext,
@@ -411,6 +449,7 @@ module.exports = {
   runInThisContext,
   isContext,
   compileFunction,
+  compileScriptStreaming,
 };
 
 if (require('internal/options').getOptionValue('--experimental-vm-modules')) {
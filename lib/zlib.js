@@ -40,11 +40,13 @@ const {
     ERR_BROTLI_INVALID_PARAM,
     ERR_BUFFER_TOO_LARGE,
     ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
     ERR_OUT_OF_RANGE,
     ERR_ZLIB_INITIALIZATION_FAILED,
   },
   hideStackFrames
 } = require('internal/errors');
+const { validateUint32 } = require('internal/validators');
 const Transform = require('_stream_transform');
 const {
   deprecate
@@ -276,6 +278,20 @@ function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
   this._defaultFullFlushFlag = fullFlush;
   this.once('end', _close.bind(null, this));
   this._info = opts && opts.info;
+
+  // Decompression-bomb guards, enforced in C++ so that untrusted input does
+  // not need a JS byte-counting wrapper on the hot path. Only meaningful for
+  // the decompression modes; the compression classes ignore the options.
+  if (opts && (opts.maxOutputLength !== undefined ||
+               opts.maxRatio !== undefined) &&
+      (mode === INFLATE || mode === GUNZIP || mode === UNZIP ||
+       mode === INFLATERAW || mode === BROTLI_DECODE)) {
+    const maxOutputLength = checkRangesOrGetDefault(
+      opts.maxOutputLength, 'options.maxOutputLength', 1, kMaxLength, 0);
+    const maxRatio = checkRangesOrGetDefault(
+      opts.maxRatio, 'options.maxRatio', 1, Infinity, 0);
+    handle.setOutputLimits(maxOutputLength, maxRatio);
+  }
 }
 ObjectSetPrototypeOf(ZlibBase.prototype, Transform.prototype);
 ObjectSetPrototypeOf(ZlibBase, Transform);
@@ -305,6 +321,17 @@ ObjectDefineProperty(ZlibBase.prototype, 'bytesRead', {
      'This feature will be removed in the future.', 'DEP0108')
 });
 
+// Total number of bytes produced by the engine over the handle's lifetime
+// (modulo 2**32), maintained natively in the shared write-result array.
+// Complements `bytesWritten`, e.g. for auditing adaptive compression.
+ObjectDefineProperty(ZlibBase.prototype, 'bytesProduced', {
+  configurable: true,
+  enumerable: true,
+  get() {
+    return this._writeState[3];
+  }
+});
+
 ZlibBase.prototype.reset = function() {
   if (!this._handle)
     assert(false, 'zlib binding closed');
@@ -649,7 +676,11 @@ function Zlib(opts, mode) {
   // Ideally, we could let ZlibBase() set up _writeState. I haven't been able
   // to come up with a good solution that doesn't break our internal API,
   // and with it all supported npm versions at the time of writing.
-  this._writeState = new Uint32Array(2);
+  // Slots [0]/[1] receive the post-write avail_out/avail_in values; slots
+  // [2]/[3] mirror the handle's lifetime input/output byte totals (low 32
+  // bits). The native side checks the array length, so callers passing the
+  // historical two-element array keep working.
+  this._writeState = new Uint32Array(4);
   if (!handle.init(windowBits,
                    level,
                    memLevel,
@@ -663,6 +694,14 @@ function Zlib(opts, mode) {
     throw new ERR_ZLIB_INITIALIZATION_FAILED();
   }
 
+  // Content-aware compression: sample the first input bytes natively and
+  // drop to Z_BEST_SPEED or Z_NO_COMPRESSION for high-entropy (e.g.
+  // already-compressed) payloads.
+  if (opts && opts.adaptive &&
+      (mode === DEFLATE || mode === GZIP || mode === DEFLATERAW)) {
+    handle.setAdaptive();
+  }
+
   ZlibBase.call(this, opts, mode, handle, zlibDefaultOpts);
 
   this._level = level;
@@ -756,9 +795,94 @@ function Unzip(opts) {
 ObjectSetPrototypeOf(Unzip.prototype, Zlib.prototype);
 ObjectSetPrototypeOf(Unzip, Zlib);
 
-function createConvenienceMethod(ctor, sync) {
+// One-shot whole-buffer compression fast path. For the deflate-based
+// compressors, payloads whose options only consist of the four numeric zlib
+// parameters can skip the Transform stream machinery entirely and be
+// compressed with a single native call (see OneShotCompress in
+// src/node_zlib.cc). Anything else — dictionaries, info mode, custom flush
+// behavior, stream options, exotic prototypes — takes the regular path.
+// The async methods additionally accept `parallel: true`, which compresses
+// large payloads as concurrent independent blocks (pigz-style; see
+// ParallelCompressJob). The synchronous methods accept and ignore it, as a
+// blocking call cannot overlap with itself.
+const kObjectPrototype = ObjectGetPrototypeOf({});
+function isOneShotEligible(opts) {
+  if (opts == null) return true;
+  if (typeof opts !== 'object') return false;
+  const proto = ObjectGetPrototypeOf(opts);
+  if (proto !== null && proto !== kObjectPrototype) return false;
+  for (const key of ObjectKeys(opts)) {
+    if (key !== 'level' && key !== 'windowBits' &&
+        key !== 'memLevel' && key !== 'strategy' && key !== 'parallel') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mirrors the input coercion done by zlibBuffer()/zlibBufferSync() plus the
+// stream encoding of string inputs. Returns undefined for anything else, in
+// which case the caller falls back to the streaming path (which produces
+// the canonical errors).
+function coerceOneShotInput(buffer) {
+  if (typeof buffer === 'string')
+    return Buffer.from(buffer);
+  if (isArrayBufferView(buffer)) {
+    if (ObjectGetPrototypeOf(buffer) === Buffer.prototype)
+      return buffer;
+    return Buffer.from(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+  }
+  if (isAnyArrayBuffer(buffer))
+    return Buffer.from(buffer);
+  return undefined;
+}
+
+// Same validation as the Zlib constructor, for the four parameters the
+// one-shot path supports.
+function oneShotOptions(mode, opts) {
+  let windowBits = Z_DEFAULT_WINDOWBITS;
+  let level = Z_DEFAULT_COMPRESSION;
+  let memLevel = Z_DEFAULT_MEMLEVEL;
+  let strategy = Z_DEFAULT_STRATEGY;
+
+  if (opts) {
+    if (mode === DEFLATERAW && opts.windowBits === 8) {
+      // Matches the DeflateRaw constructor quirk.
+      windowBits = 9;
+    } else {
+      windowBits = checkRangesOrGetDefault(
+        opts.windowBits, 'options.windowBits',
+        Z_MIN_WINDOWBITS, Z_MAX_WINDOWBITS, Z_DEFAULT_WINDOWBITS);
+    }
+
+    level = checkRangesOrGetDefault(
+      opts.level, 'options.level',
+      Z_MIN_LEVEL, Z_MAX_LEVEL, Z_DEFAULT_COMPRESSION);
+
+    memLevel = checkRangesOrGetDefault(
+      opts.memLevel, 'options.memLevel',
+      Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_MEMLEVEL);
+
+    strategy = checkRangesOrGetDefault(
+      opts.strategy, 'options.strategy',
+      Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
+  }
+
+  return { level, windowBits, memLevel, strategy };
+}
+
+function createConvenienceMethod(ctor, sync, oneShotMode) {
   if (sync) {
     return function syncBufferWrapper(buffer, opts) {
+      if (oneShotMode !== undefined && isOneShotEligible(opts)) {
+        const input = coerceOneShotInput(buffer);
+        if (input !== undefined) {
+          const { level, windowBits, memLevel, strategy } =
+            oneShotOptions(oneShotMode, opts);
+          return binding.oneShotCompressSync(
+            oneShotMode, input, level, windowBits, memLevel, strategy);
+        }
+      }
       return zlibBufferSync(new ctor(opts), buffer);
     };
   } else {
@@ -767,6 +891,29 @@ function createConvenienceMethod(ctor, sync) {
         callback = opts;
         opts = {};
       }
+      if (oneShotMode !== undefined && isOneShotEligible(opts)) {
+        if (typeof callback !== 'function')
+          throw new ERR_INVALID_ARG_TYPE('callback', 'function', callback);
+        const input = coerceOneShotInput(buffer);
+        if (input !== undefined) {
+          const { level, windowBits, memLevel, strategy } =
+            oneShotOptions(oneShotMode, opts);
+          if (opts !== null && opts !== undefined && opts.parallel) {
+            // Split the input into independent blocks compressed concurrently
+            // across the thread pool (inputs smaller than one block
+            // degenerate to a single job). The output differs byte-wise from
+            // the serial path but is a valid stream in the same format.
+            binding.oneShotCompressParallel(
+              oneShotMode, input, level, windowBits, memLevel, strategy,
+              callback);
+            return;
+          }
+          binding.oneShotCompress(
+            oneShotMode, input, level, windowBits, memLevel, strategy,
+            callback);
+          return;
+        }
+      }
       return zlibBuffer(new ctor(opts), buffer, callback);
     };
   }
@@ -807,7 +954,7 @@ function Brotli(opts, mode) {
   const handle = mode === BROTLI_DECODE ?
     new binding.BrotliDecoder(mode) : new binding.BrotliEncoder(mode);
 
-  this._writeState = new Uint32Array(2);
+  this._writeState = new Uint32Array(4);
   if (!handle.init(brotliInitParamsArray,
                    this._writeState,
                    processCallback)) {
@@ -853,6 +1000,100 @@ ObjectDefineProperty(binding.Zlib.prototype, 'jsref', {
   set(v) { return this[owner_symbol] = v; }
 });
 
+// Checksums //
+
+const kChecksumType = Symbol('kChecksumType');
+const kChecksumValue = Symbol('kChecksumValue');
+
+const checksumTypes = {
+  crc32: binding.CHECKSUM_CRC32,
+  crc32c: binding.CHECKSUM_CRC32C,
+  adler32: binding.CHECKSUM_ADLER32,
+};
+
+// adler32 is defined to start from 1; the CRCs start from 0.
+function checksumDefaultValue(type) {
+  return type === binding.CHECKSUM_ADLER32 ? 1 : 0;
+}
+
+function coerceChecksumData(data) {
+  if (typeof data === 'string')
+    return Buffer.from(data);
+  if (isArrayBufferView(data)) {
+    if (ObjectGetPrototypeOf(data) !== Buffer.prototype)
+      return Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+    return data;
+  }
+  if (isAnyArrayBuffer(data))
+    return Buffer.from(data);
+  throw new ERR_INVALID_ARG_TYPE(
+    'data',
+    ['string', 'Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+    data);
+}
+
+function createChecksumMethod(type) {
+  return function checksum(data, value, callback) {
+    if (typeof value === 'function') {
+      callback = value;
+      value = undefined;
+    }
+    if (value === undefined)
+      value = checksumDefaultValue(type);
+    else
+      validateUint32(value, 'value');
+    data = coerceChecksumData(data);
+
+    if (callback === undefined)
+      return binding.checksum(type, data, value);
+
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_ARG_TYPE('callback', 'function', callback);
+    if (data.byteLength < binding.CHECKSUM_ASYNC_THRESHOLD) {
+      // Checksumming runs at several bytes per cycle; below the threshold a
+      // threadpool round trip costs more than the work itself. Still defer
+      // the callback so both paths are consistently asynchronous.
+      const result = binding.checksum(type, data, value);
+      process.nextTick(callback, null, result);
+      return;
+    }
+    binding.checksumAsync(type, data, value, callback);
+  };
+}
+
+// Streaming form. crc32, crc32c and adler32 are all resumable from their
+// running value, so the context is just (algorithm, value) and needs no
+// native state.
+class Checksum {
+  constructor(algorithm, value) {
+    const type = checksumTypes[algorithm];
+    if (type === undefined) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'algorithm', algorithm, "must be 'crc32', 'crc32c' or 'adler32'");
+    }
+    if (value === undefined)
+      value = checksumDefaultValue(type);
+    else
+      validateUint32(value, 'value');
+    this[kChecksumType] = type;
+    this[kChecksumValue] = value;
+  }
+
+  update(data) {
+    this[kChecksumValue] = binding.checksum(
+      this[kChecksumType], coerceChecksumData(data), this[kChecksumValue]);
+    return this;
+  }
+
+  get value() {
+    return this[kChecksumValue];
+  }
+
+  digest() {
+    return this[kChecksumValue];
+  }
+}
+
 module.exports = {
   Deflate,
   Inflate,
@@ -866,12 +1107,12 @@ module.exports = {
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
-  deflate: createConvenienceMethod(Deflate, false),
-  deflateSync: createConvenienceMethod(Deflate, true),
-  gzip: createConvenienceMethod(Gzip, false),
-  gzipSync: createConvenienceMethod(Gzip, true),
-  deflateRaw: createConvenienceMethod(DeflateRaw, false),
-  deflateRawSync: createConvenienceMethod(DeflateRaw, true),
+  deflate: createConvenienceMethod(Deflate, false, DEFLATE),
+  deflateSync: createConvenienceMethod(Deflate, true, DEFLATE),
+  gzip: createConvenienceMethod(Gzip, false, GZIP),
+  gzipSync: createConvenienceMethod(Gzip, true, GZIP),
+  deflateRaw: createConvenienceMethod(DeflateRaw, false, DEFLATERAW),
+  deflateRawSync: createConvenienceMethod(DeflateRaw, true, DEFLATERAW),
   unzip: createConvenienceMethod(Unzip, false),
   unzipSync: createConvenienceMethod(Unzip, true),
   inflate: createConvenienceMethod(Inflate, false),
@@ -884,6 +1125,12 @@ module.exports = {
   brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
   brotliDecompressSync: createConvenienceMethod(BrotliDecompress, true),
+
+  // Checksums.
+  crc32: createChecksumMethod(binding.CHECKSUM_CRC32),
+  crc32c: createChecksumMethod(binding.CHECKSUM_CRC32C),
+  adler32: createChecksumMethod(binding.CHECKSUM_ADLER32),
+  Checksum,
 };
 
 ObjectDefineProperties(module.exports, {
@@ -97,6 +97,7 @@
       'lib/internal/buffer.js',
       'lib/internal/cli_table.js',
       'lib/internal/child_process.js',
+      'lib/internal/child_process/prefork_pool.js',
       'lib/internal/child_process/serialization.js',
       'lib/internal/cluster/child.js',
       'lib/internal/cluster/master.js',
@@ -136,6 +137,7 @@
       'lib/internal/fs/sync_write_stream.js',
       'lib/internal/fs/utils.js',
       'lib/internal/fs/watchers.js',
+      'lib/internal/histogram.js',
       'lib/internal/http.js',
       'lib/internal/idna.js',
       'lib/internal/inspector_async_hook.js',
@@ -521,6 +523,8 @@
         'src/api/utils.cc',
 
         'src/async_wrap.cc',
+        'src/base_object.cc',
+        'src/base64.cc',
         'src/cares_wrap.cc',
         'src/connect_wrap.cc',
         'src/connection_wrap.cc',
@@ -552,6 +556,8 @@
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
+        'src/node_interned_strings.cc',
+        'src/node_io_uring.cc',
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
@@ -565,6 +571,7 @@
         'src/node_process_events.cc',
         'src/node_process_methods.cc',
         'src/node_process_object.cc',
+        'src/node_querystring.cc',
         'src/node_serdes.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
@@ -590,8 +597,10 @@
         'src/tcp_wrap.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
+        'src/tracing/node_binary_trace_writer.cc',
         'src/tracing/node_trace_buffer.cc',
         'src/tracing/node_trace_writer.cc',
+        'src/tracing/trace_category_state.cc',
         'src/tracing/trace_event.cc',
         'src/tracing/traced_value.cc',
         'src/tty_wrap.cc',
@@ -632,7 +641,9 @@
         'src/node_http2.h',
         'src/node_http2_state.h',
         'src/node_i18n.h',
+        'src/node_interned_strings.h',
         'src/node_internals.h',
+        'src/node_io_uring.h',
         'src/node_main_instance.h',
         'src/node_mem.h',
         'src/node_mem-inl.h',
@@ -650,6 +661,7 @@
         'src/node_process.h',
         'src/node_revert.h',
         'src/node_root_certs.h',
+        'src/node_simd.h',
         'src/node_stat_watcher.h',
         'src/node_union_bytes.h',
         'src/node_url.h',
@@ -672,8 +684,10 @@
         'src/string_search.h',
         'src/tcp_wrap.h',
         'src/tracing/agent.h',
+        'src/tracing/node_binary_trace_writer.h',
         'src/tracing/node_trace_buffer.h',
         'src/tracing/node_trace_writer.h',
+        'src/tracing/trace_category_state.h',
         'src/tracing/trace_event.h',
         'src/tracing/trace_event_common.h',
         'src/tracing/traced_value.h',
@@ -1111,6 +1125,7 @@
         'test/cctest/test_base_object_ptr.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
+        'test/cctest/test_interned_strings.cc',
         'test/cctest/test_linked_binding.cc',
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include <cinttypes>
+#include <limits>
 #include "util.h"
 #include "v8.h"
 
@@ -33,8 +34,11 @@ template <class NativeT,
 class AliasedBufferBase {
  public:
   AliasedBufferBase(v8::Isolate* isolate, const size_t count)
-      : isolate_(isolate), count_(count), byte_offset_(0) {
+      : isolate_(isolate),
+        count_(static_cast<uint32_t>(count)),
+        byte_offset_(0) {
     CHECK_GT(count, 0);
+    CHECK_LE(count, std::numeric_limits<uint32_t>::max());
     const v8::HandleScope handle_scope(isolate_);
     const size_t size_in_bytes =
         MultiplyWithOverflowCheck(sizeof(NativeT), count);
@@ -63,7 +67,11 @@ class AliasedBufferBase {
       const size_t byte_offset,
       const size_t count,
       const AliasedBufferBase<uint8_t, v8::Uint8Array>& backing_buffer)
-      : isolate_(isolate), count_(count), byte_offset_(byte_offset) {
+      : isolate_(isolate),
+        count_(static_cast<uint32_t>(count)),
+        byte_offset_(static_cast<uint32_t>(byte_offset)) {
+    CHECK_LE(count, std::numeric_limits<uint32_t>::max());
+    CHECK_LE(byte_offset, std::numeric_limits<uint32_t>::max());
     const v8::HandleScope handle_scope(isolate_);
 
     v8::Local<v8::ArrayBuffer> ab = backing_buffer.GetArrayBuffer();
@@ -217,7 +225,8 @@ class AliasedBufferBase {
   // an owning `AliasedBufferBase`.
   void reserve(size_t new_capacity) {
     DCHECK_GE(new_capacity, count_);
-    DCHECK_EQ(byte_offset_, 0);
+    DCHECK_EQ(byte_offset_, 0u);
+    CHECK_LE(new_capacity, std::numeric_limits<uint32_t>::max());
     const v8::HandleScope handle_scope(isolate_);
 
     const size_t old_size_in_bytes = sizeof(NativeT) * count_;
@@ -239,14 +248,18 @@ class AliasedBufferBase {
     js_array_ = std::move(v8::Global<V8T>(isolate_, js_array));
 
     buffer_ = new_buffer;
-    count_ = new_capacity;
+    count_ = static_cast<uint32_t>(new_capacity);
   }
 
  private:
+  // Keep this struct lean: Environment owns dozens of these per thread, so
+  // count/offset are stored as uint32_t (an AliasedBuffer larger than 4 GB
+  // is a bug anyway) to pack the metadata into four machine words plus the
+  // handle instead of five.
   v8::Isolate* isolate_;
-  size_t count_;
-  size_t byte_offset_;
   NativeT* buffer_;
+  uint32_t count_;
+  uint32_t byte_offset_;
   v8::Global<V8T> js_array_;
 };
 
@@ -39,7 +39,13 @@ InternalCallbackScope::InternalCallbackScope(AsyncWrap* async_wrap, int flags)
                             async_wrap->object(),
                             { async_wrap->get_async_id(),
                               async_wrap->get_trigger_async_id() },
-                            flags) {}
+                            flags) {
+  // Make the async context frame captured at the resource's creation current
+  // for the duration of the scope. The previous frame is restored in Close().
+  prev_context_frame_.Reset(env_->isolate(), env_->async_context_frame());
+  env_->set_async_context_frame(async_wrap->context_frame());
+  swapped_context_frame_ = true;
+}
 
 InternalCallbackScope::InternalCallbackScope(Environment* env,
                                              Local<Object> object,
@@ -54,6 +60,11 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
   CHECK_NOT_NULL(env);
   env->PushAsyncCallbackScope();
 
+  // Only the outermost scope charges CPU time; nested MakeCallback()s are
+  // already covered by the enclosing scope's measurement.
+  if (env->cpu_budget_enabled() && env->async_callback_scope_depth() == 1)
+    cpu_charge_start_ns_ = uv_hrtime();
+
   if (!env->can_call_into_js()) {
     failed_ = true;
     return;
@@ -83,6 +94,20 @@ void InternalCallbackScope::Close() {
   if (closed_) return;
   closed_ = true;
 
+  auto cpu_charge = OnScopeLeave([&]() {
+    if (cpu_charge_start_ns_ != 0) {
+      env_->ChargeCpuTime(uv_hrtime() - cpu_charge_start_ns_);
+      cpu_charge_start_ns_ = 0;
+    }
+  });
+
+  if (swapped_context_frame_) {
+    env_->set_async_context_frame(
+        PersistentToLocal::Strong(prev_context_frame_));
+    prev_context_frame_.Reset();
+    swapped_context_frame_ = false;
+  }
+
   if (!env_->can_call_into_js()) return;
   if (failed_ && !env_->is_main_thread() && env_->is_stopping()) {
     env_->async_hooks()->clear_async_id_stack();
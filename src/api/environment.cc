@@ -7,6 +7,12 @@
 #include "node_v8_platform-inl.h"
 #include "uv.h"
 
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace node {
 using errors::TryCatchScope;
 using v8::Array;
@@ -86,13 +92,93 @@ static void HostCleanupFinalizationGroupCallback(
   env->RegisterFinalizationGroupForCleanup(group);
 }
 
+NodeArrayBufferAllocator::~NodeArrayBufferAllocator() {
+  for (auto& chunks : pool_) {
+    for (void* data : chunks) free(data);
+  }
+}
+
+void* NodeArrayBufferAllocator::PoolAllocate(size_t size) {
+  const size_t max_size = kPoolMinSize << (kPoolClassCount - 1);
+  if (size < kPoolMinSize || size > max_size) return nullptr;
+  // The smallest class whose chunks can hold |size| bytes.
+  size_t size_class = 0;
+  while ((kPoolMinSize << size_class) < size) size_class++;
+  Mutex::ScopedLock lock(pool_mutex_);
+  std::vector<void*>& chunks = pool_[size_class];
+  if (chunks.empty()) {
+    pool_stats_.misses++;
+    return nullptr;
+  }
+  void* data = chunks.back();
+  chunks.pop_back();
+  pool_stats_.hits++;
+  pool_stats_.retained_bytes -= kPoolMinSize << size_class;
+  return data;
+}
+
+bool NodeArrayBufferAllocator::PoolFree(void* data, size_t size) {
+  const size_t max_size = kPoolMinSize << (kPoolClassCount - 1);
+  if (size < kPoolMinSize || size > max_size) return false;
+  // Round down: the chunk holds at least |size| bytes, so it may only be
+  // reused for allocations no larger than that. Retained bytes are
+  // accounted at class granularity for the same reason.
+  size_t size_class = 0;
+  while (size_class + 1 < kPoolClassCount &&
+         (kPoolMinSize << (size_class + 1)) <= size) {
+    size_class++;
+  }
+  const uint64_t class_size = kPoolMinSize << size_class;
+  Mutex::ScopedLock lock(pool_mutex_);
+  std::vector<void*>& chunks = pool_[size_class];
+  if (chunks.size() >= kMaxChunksPerClass ||
+      pool_stats_.retained_bytes + class_size > kMaxRetainedBytes) {
+    pool_stats_.evicted++;
+    return false;
+  }
+  chunks.push_back(data);
+  pool_stats_.recycled++;
+  pool_stats_.retained_bytes += class_size;
+  return true;
+}
+
+NodeArrayBufferAllocator::PoolStats NodeArrayBufferAllocator::pool_stats()
+    const {
+  Mutex::ScopedLock lock(pool_mutex_);
+  return pool_stats_;
+}
+
+void NodeArrayBufferAllocator::ReleasePooledMemory() {
+  Mutex::ScopedLock lock(pool_mutex_);
+  for (size_t i = 0; i < kPoolClassCount; i++) {
+    for (void* chunk : pool_[i]) free(chunk);
+    pool_[i].clear();
+  }
+  pool_stats_.retained_bytes = 0;
+}
+
 void* NodeArrayBufferAllocator::Allocate(size_t size) {
-  if (zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers)
+  const bool zero_fill =
+      zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers;
+  if (void* data = PoolAllocate(size)) {
+    if (zero_fill) memset(data, 0, size);
+    return data;
+  }
+  if (zero_fill)
     return UncheckedCalloc(size);
   else
     return UncheckedMalloc(size);
 }
 
+void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
+  if (void* data = PoolAllocate(size)) return data;
+  return UncheckedMalloc(size);
+}
+
+void NodeArrayBufferAllocator::Free(void* data, size_t size) {
+  if (data == nullptr || !PoolFree(data, size)) free(data);
+}
+
 DebuggingArrayBufferAllocator::~DebuggingArrayBufferAllocator() {
   CHECK(allocations_.empty());
 }
@@ -196,6 +282,29 @@ void SetIsolateCreateParamsForNode(Isolate::CreateParams* params) {
   }
 }
 
+// Ask the kernel to back the isolate's code range with transparent huge
+// pages. The code range is reserved in one block at isolate creation and
+// is where all JIT code lands, so a single early madvise() covers every
+// code page the isolate will ever commit; the kernel then uses 2MB
+// mappings as pages become resident, reducing iTLB pressure the same way
+// the --use-largepages .text remapping does for static code. Best-effort:
+// the advice is a no-op on kernels without THP.
+static void AdviseCodeRangeLargePages(v8::Isolate* isolate) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (per_process::cli_options->use_largepages != "on" &&
+      per_process::cli_options->use_largepages != "silent") {
+    return;
+  }
+  void* start = nullptr;
+  size_t length = 0;
+  isolate->GetCodeRange(&start, &length);
+  if (start == nullptr || length == 0) return;
+  madvise(start, length, MADV_HUGEPAGE);
+#else
+  (void)isolate;
+#endif
+}
+
 void SetIsolateErrorHandlers(v8::Isolate* isolate, const IsolateSettings& s) {
   if (s.flags & MESSAGE_LISTENER_WITH_ERROR_LEVEL)
     isolate->AddMessageListenerWithErrorLevel(
@@ -235,6 +344,8 @@ void SetIsolateMiscHandlers(v8::Isolate* isolate, const IsolateSettings& s) {
 
   if (s.flags & DETAILED_SOURCE_POSITIONS_FOR_PROFILING)
     v8::CpuProfiler::UseDetailedSourcePositionsForProfiling(isolate);
+
+  AdviseCodeRangeLargePages(isolate);
 }
 
 void SetIsolateUpForNode(v8::Isolate* isolate,
@@ -350,6 +461,27 @@ Environment* GetCurrentEnvironment(Local<Context> context) {
   return Environment::GetCurrent(context);
 }
 
+void SetEnvironmentCpuBudget(Environment* env,
+                             uint64_t budget_ns,
+                             uint64_t interval_ns) {
+  env->SetCpuBudget(budget_ns, interval_ns);
+}
+
+bool EnvironmentCpuBudgetExceeded(Environment* env) {
+  return env->CpuBudgetExceeded();
+}
+
+uint64_t GetEnvironmentCpuTime(Environment* env) {
+  return env->cpu_time_ns();
+}
+
+uint64_t GetEnvironmentActiveHandleCount(Environment* env) {
+  uint64_t total = 0;
+  for (int64_t count : env->active_handle_counts())
+    total += count;
+  return total;
+}
+
 MultiIsolatePlatform* GetMainThreadMultiIsolatePlatform() {
   return per_process::v8_platform.Platform();
 }
@@ -28,6 +28,7 @@
 
 #include "v8.h"
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
@@ -95,17 +96,24 @@ void AsyncWrap::DestroyAsyncIdsCallback(Environment* env) {
     std::vector<double> destroy_async_id_list;
     destroy_async_id_list.swap(*env->destroy_async_id_list());
     if (!env->can_call_into_js()) return;
-    for (auto async_id : destroy_async_id_list) {
-      // Want each callback to be cleaned up after itself, instead of cleaning
-      // them all up after the while() loop completes.
-      HandleScope scope(env->isolate());
-      Local<Value> async_id_value = Number::New(env->isolate(), async_id);
-      MaybeLocal<Value> ret = fn->Call(
-          env->context(), Undefined(env->isolate()), 1, &async_id_value);
-
-      if (ret.IsEmpty())
-        return;
-    }
+
+    // Hand the whole batch to JS in one call instead of one call per id;
+    // emitDestroyNative in lib/internal/async_hooks.js iterates the array.
+    HandleScope scope(env->isolate());
+    MaybeStackBuffer<Local<Value>, 64> js_ids(destroy_async_id_list.size());
+    for (size_t i = 0; i < destroy_async_id_list.size(); i++)
+      js_ids[i] = Number::New(env->isolate(), destroy_async_id_list[i]);
+    Local<Value> ids_array =
+        Array::New(env->isolate(), js_ids.out(), js_ids.length());
+    MaybeLocal<Value> ret = fn->Call(
+        env->context(), Undefined(env->isolate()), 1, &ids_array);
+
+    if (ret.IsEmpty())
+      return;
+
+    // Only ids whose destroy() has actually been observed may be reused.
+    for (double async_id : destroy_async_id_list)
+      env->RecycleAsyncId(async_id);
   } while (!env->destroy_async_id_list()->empty());
 }
 
@@ -116,6 +124,11 @@ void Emit(Environment* env, double async_id, AsyncHooks::Fields type,
   if (async_hooks->fields()[type] == 0 || !env->can_call_into_js())
     return;
 
+  if (!async_hooks->sampled(async_id)) {
+    async_hooks->fields()[AsyncHooks::kUnsampledEvents] += 1;
+    return;
+  }
+
   HandleScope handle_scope(env->isolate());
   Local<Value> async_id_value = Number::New(env->isolate(), async_id);
   TryCatchScope try_catch(env, TryCatchScope::CatchMode::kFatal);
@@ -206,7 +219,9 @@ PromiseWrap* PromiseWrap::New(Environment* env,
   obj->SetInternalField(PromiseWrap::kIsChainedPromiseField,
                         parent_wrap != nullptr ? v8::True(env->isolate())
                                                : v8::False(env->isolate()));
-  CHECK_NULL(promise->GetAlignedPointerFromInternalField(0));
+  // The field may hold a leftover id from lightweight tracking (see
+  // LightweightPromiseHook below); only a wrap must never be overwritten.
+  CHECK(!promise->GetInternalField(0)->IsObject());
   promise->SetInternalField(0, obj);
   return new PromiseWrap(env, obj, silent);
 }
@@ -280,6 +295,162 @@ static void PromiseHook(PromiseHookType type, Local<Promise> promise,
   }
 }
 
+// Lightweight promise tracking. The full-fidelity hook above allocates a
+// PromiseWrap per promise: a JS wrapper object plus a C++ BaseObject with a
+// weak persistent handle. Promise-heavy code doubles its allocation rate
+// just by enabling async_hooks. In lightweight mode the async id and
+// trigger id are stored directly in the two internal fields our V8 build
+// reserves on promises (Smis for as long as ids fit), and init/promiseResolve
+// notifications are staged in a per-environment buffer that is handed to JS
+// in batches, one C++->JS transition per batch instead of one per promise.
+// Trade-offs, documented in doc/api/async_hooks.md: init() receives a shared
+// placeholder resource, init/promiseResolve events arrive slightly after the
+// fact (though always before that promise's before()), and promises emit no
+// destroy events since nothing holds a weak reference to them.
+
+constexpr int kPromiseAsyncIdField = 0;
+constexpr int kPromiseTriggerIdField = 1;
+
+constexpr double kPromiseEventInit = 0;
+constexpr double kPromiseEventResolve = 1;
+// Flat [type, async_id, trigger_async_id] triplets. Flush as soon as the
+// buffer fills up so hook consumers never fall arbitrarily far behind.
+constexpr size_t kMaxStagedPromiseEvents = 3 * 1024;
+
+static void FlushPromiseEvents(Environment* env) {
+  Local<Function> fn = env->async_hooks_promise_events_function();
+
+  TryCatchScope try_catch(env, TryCatchScope::CatchMode::kFatal);
+
+  while (!env->promise_event_list()->empty()) {
+    std::vector<double> events;
+    events.swap(*env->promise_event_list());
+    if (!env->can_call_into_js()) return;
+
+    HandleScope scope(env->isolate());
+    MaybeStackBuffer<Local<Value>, 192> js_events(events.size());
+    for (size_t i = 0; i < events.size(); i++)
+      js_events[i] = Number::New(env->isolate(), events[i]);
+    Local<Value> events_array =
+        Array::New(env->isolate(), js_events.out(), js_events.length());
+    if (fn->Call(env->context(), Undefined(env->isolate()), 1, &events_array)
+            .IsEmpty()) {
+      return;
+    }
+  }
+}
+
+static void StagePromiseEvent(Environment* env,
+                              double type,
+                              double async_id,
+                              double trigger_async_id) {
+  std::vector<double>* list = env->promise_event_list();
+  if (list->empty())
+    env->SetUnrefImmediate(&FlushPromiseEvents);
+  list->push_back(type);
+  list->push_back(async_id);
+  list->push_back(trigger_async_id);
+  if (list->size() >= kMaxStagedPromiseEvents)
+    FlushPromiseEvents(env);
+}
+
+static inline double GetPromiseId(Local<Promise> promise, int field) {
+  Local<Value> value = promise->GetInternalField(field);
+  return value->IsNumber() ? value.As<Number>()->Value()
+                           : AsyncWrap::kInvalidAsyncId;
+}
+
+// Assigns ids to a promise that has none yet. `silent` suppresses the init
+// notification; it is used for parent promises first observed after their
+// creation, mirroring the silent PromiseWrap in the full-fidelity hook.
+static double InitLightweightPromise(Environment* env,
+                                     Local<Promise> promise,
+                                     Local<Value> parent,
+                                     bool silent) {
+  Isolate* isolate = env->isolate();
+
+  double trigger_async_id;
+  if (!parent.IsEmpty() && parent->IsPromise()) {
+    Local<Promise> parent_promise = parent.As<Promise>();
+    double parent_id = GetPromiseId(parent_promise, kPromiseAsyncIdField);
+    if (parent_id == AsyncWrap::kInvalidAsyncId) {
+      parent_id =
+          InitLightweightPromise(env, parent_promise, Local<Value>(), true);
+    }
+    trigger_async_id = parent_id;
+  } else {
+    trigger_async_id = env->get_default_trigger_async_id();
+  }
+
+  double async_id = env->new_async_id();
+  promise->SetInternalField(kPromiseAsyncIdField,
+                            Number::New(isolate, async_id));
+  promise->SetInternalField(kPromiseTriggerIdField,
+                            Number::New(isolate, trigger_async_id));
+
+  AsyncHooks* async_hooks = env->async_hooks();
+  if (!silent && async_hooks->fields()[AsyncHooks::kInit] != 0) {
+    if (async_hooks->sampled(async_id))
+      StagePromiseEvent(env, kPromiseEventInit, async_id, trigger_async_id);
+    else
+      async_hooks->fields()[AsyncHooks::kUnsampledEvents] += 1;
+  }
+  return async_id;
+}
+
+static void LightweightPromiseHook(PromiseHookType type,
+                                   Local<Promise> promise,
+                                   Local<Value> parent) {
+  Local<Context> context = promise->CreationContext();
+
+  Environment* env = Environment::GetCurrent(context);
+  if (env == nullptr) return;
+  TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
+                              "EnvPromiseHook", env);
+
+  if (promise->GetInternalField(kPromiseAsyncIdField)->IsObject()) {
+    // Tracked by the full-fidelity hook before a mode switch; keep
+    // dispatching through it so before/after pairing stays intact.
+    return PromiseHook(type, promise, parent);
+  }
+
+  double async_id = GetPromiseId(promise, kPromiseAsyncIdField);
+  if (type == PromiseHookType::kInit ||
+      async_id == AsyncWrap::kInvalidAsyncId) {
+    async_id = InitLightweightPromise(
+        env, promise, parent, type != PromiseHookType::kInit);
+  }
+
+  if (type == PromiseHookType::kBefore) {
+    env->async_hooks()->push_async_ids(
+        async_id, GetPromiseId(promise, kPromiseTriggerIdField));
+    // Deliver staged init events before this promise's before().
+    if (!env->promise_event_list()->empty())
+      FlushPromiseEvents(env);
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(TRACING_CATEGORY_NODE1(async_hooks),
+                                      "PROMISE_CALLBACK",
+                                      static_cast<int64_t>(async_id));
+    AsyncWrap::EmitBefore(env, async_id);
+  } else if (type == PromiseHookType::kAfter) {
+    TRACE_EVENT_NESTABLE_ASYNC_END0(TRACING_CATEGORY_NODE1(async_hooks),
+                                    "PROMISE_CALLBACK",
+                                    static_cast<int64_t>(async_id));
+    AsyncWrap::EmitAfter(env, async_id);
+    if (env->execution_async_id() == async_id) {
+      // See the comment on the matching condition in PromiseHook above.
+      env->async_hooks()->pop_async_id(async_id);
+    }
+  } else if (type == PromiseHookType::kResolve) {
+    AsyncHooks* async_hooks = env->async_hooks();
+    if (async_hooks->fields()[AsyncHooks::kPromiseResolve] != 0) {
+      if (async_hooks->sampled(async_id))
+        StagePromiseEvent(env, kPromiseEventResolve, async_id, 0);
+      else
+        async_hooks->fields()[AsyncHooks::kUnsampledEvents] += 1;
+    }
+  }
+}
+
 
 static void SetupHooks(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -308,6 +479,7 @@ static void SetupHooks(const FunctionCallbackInfo<Value>& args) {
   SET_HOOK_FN(after);
   SET_HOOK_FN(destroy);
   SET_HOOK_FN(promise_resolve);
+  SET_HOOK_FN(promise_events);
 #undef SET_HOOK_FN
 
   {
@@ -326,7 +498,8 @@ static void SetupHooks(const FunctionCallbackInfo<Value>& args) {
 
 
 static void EnablePromiseHook(const FunctionCallbackInfo<Value>& args) {
-  args.GetIsolate()->SetPromiseHook(PromiseHook);
+  args.GetIsolate()->SetPromiseHook(
+      args[0]->IsTrue() ? LightweightPromiseHook : PromiseHook);
 }
 
 
@@ -340,6 +513,21 @@ static void DisablePromiseHook(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+static void GetAsyncContextFrame(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Value> frame = env->async_context_frame();
+  if (frame.IsEmpty())
+    frame = Undefined(env->isolate());
+  args.GetReturnValue().Set(frame);
+}
+
+
+static void SetAsyncContextFrame(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->set_async_context_frame(args[0]);
+}
+
+
 class DestroyParam {
  public:
   double asyncId;
@@ -470,6 +658,8 @@ void AsyncWrap::Initialize(Local<Object> target,
   env->SetMethod(target, "enablePromiseHook", EnablePromiseHook);
   env->SetMethod(target, "disablePromiseHook", DisablePromiseHook);
   env->SetMethod(target, "registerDestroyHook", RegisterDestroyHook);
+  env->SetMethod(target, "getAsyncContextFrame", GetAsyncContextFrame);
+  env->SetMethod(target, "setAsyncContextFrame", SetAsyncContextFrame);
 
   PropertyAttribute ReadOnlyDontDelete =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
@@ -527,6 +717,8 @@ void AsyncWrap::Initialize(Local<Object> target,
   SET_HOOKS_CONSTANT(kAsyncIdCounter);
   SET_HOOKS_CONSTANT(kDefaultTriggerAsyncId);
   SET_HOOKS_CONSTANT(kStackLength);
+  SET_HOOKS_CONSTANT(kSampleInterval);
+  SET_HOOKS_CONSTANT(kUnsampledEvents);
 #undef SET_HOOKS_CONSTANT
   FORCE_SET_TARGET_FIELD(target, "constants", constants);
 
@@ -545,6 +737,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   env->set_async_hooks_after_function(Local<Function>());
   env->set_async_hooks_destroy_function(Local<Function>());
   env->set_async_hooks_promise_resolve_function(Local<Function>());
+  env->set_async_hooks_promise_events_function(Local<Function>());
   env->set_async_hooks_binding(target);
 
   // TODO(addaleax): This block might better work as a
@@ -637,6 +830,15 @@ void AsyncWrap::EmitTraceEventDestroy() {
 void AsyncWrap::EmitDestroy(Environment* env, double async_id) {
   if (env->async_hooks()->fields()[AsyncHooks::kDestroy] == 0 ||
       !env->can_call_into_js()) {
+    // No destroy() call will ever be observed for this id, so it can be
+    // handed back for reuse right away.
+    env->RecycleAsyncId(async_id);
+    return;
+  }
+
+  if (!env->async_hooks()->sampled(async_id)) {
+    env->async_hooks()->fields()[AsyncHooks::kUnsampledEvents] += 1;
+    env->RecycleAsyncId(async_id);
     return;
   }
 
@@ -670,6 +872,10 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
                                                      : execution_async_id;
   trigger_async_id_ = env()->get_default_trigger_async_id();
 
+  // Capture the current async context frame, to be restored around
+  // MakeCallback() later on.
+  context_frame_.Reset(env()->isolate(), env()->async_context_frame());
+
   switch (provider_type()) {
 #define V(PROVIDER)                                                           \
     case PROVIDER_ ## PROVIDER:                                               \
@@ -714,6 +920,11 @@ void AsyncWrap::EmitAsyncInit(Environment* env,
     return;
   }
 
+  if (!async_hooks->sampled(async_id)) {
+    async_hooks->fields()[AsyncHooks::kUnsampledEvents] += 1;
+    return;
+  }
+
   HandleScope scope(env->isolate());
   Local<Function> init_fn = env->async_hooks_init_function();
 
@@ -736,8 +947,20 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
 
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
+
+  // Restore the async context frame that was current when this resource was
+  // created for the duration of the callback, so that JS can always read its
+  // propagated context from one slot instead of maintaining a map in a hook.
+  // `this` may be deleted by the callback, so keep the Environment* around.
+  Environment* environment = env();
+  Local<Value> previous_frame = environment->async_context_frame();
+  environment->set_async_context_frame(context_frame());
+  auto restore_frame = OnScopeLeave([&]() {
+    environment->set_async_context_frame(previous_frame);
+  });
+
   MaybeLocal<Value> ret = InternalMakeCallback(
-      env(), object(), cb, argc, argv, context);
+      environment, object(), cb, argc, argv, context);
 
   // This is a static call with cached values because the `this` object may
   // no longer be alive at this point.
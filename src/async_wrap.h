@@ -58,13 +58,17 @@ namespace node {
   V(PROCESSWRAP)                                                              \
   V(PROMISE)                                                                  \
   V(QUERYWRAP)                                                                \
+  V(RINGCHANNEL)                                                              \
   V(SHUTDOWNWRAP)                                                             \
   V(SIGNALWRAP)                                                               \
   V(STATWATCHER)                                                              \
   V(STREAMPIPE)                                                               \
+  V(TASKQUEUE)                                                                \
   V(TCPCONNECTWRAP)                                                           \
   V(TCPSERVERWRAP)                                                            \
   V(TCPWRAP)                                                                  \
+  V(TIMERWHEEL)                                                               \
+  V(TRANSCODESTREAM)                                                          \
   V(TTYWRAP)                                                                  \
   V(UDPSENDWRAP)                                                              \
   V(UDPWRAP)                                                                  \
@@ -164,6 +168,14 @@ class AsyncWrap : public BaseObject {
   inline double get_async_id() const;
   inline double get_trigger_async_id() const;
 
+  // The async context frame (an arbitrary JS value, see
+  // getAsyncContextFrame() in lib/internal/async_hooks.js) that was current
+  // when this resource was created. It is restored as the Environment's
+  // current frame for the duration of MakeCallback(), so context follows
+  // the resource with one handle copy instead of a JS hook plus map
+  // mutation per async operation.
+  inline v8::Local<v8::Value> context_frame() const;
+
   void AsyncReset(v8::Local<v8::Object> resource,
                   double execution_async_id = kInvalidAsyncId,
                   bool silent = false);
@@ -214,6 +226,7 @@ class AsyncWrap : public BaseObject {
   // Because the values may be Reset(), cannot be made const.
   double async_id_ = kInvalidAsyncId;
   double trigger_async_id_;
+  v8::Global<v8::Value> context_frame_;
 };
 
 }  // namespace node
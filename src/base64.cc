@@ -0,0 +1,364 @@
+// Vectorized base64 kernels with runtime dispatch, used by the scalar
+// loops in base64.h for the bulk of the input. The algorithms are the
+// well-known pshufb-based ones (Muła/Lemire, also used by aklomp/base64):
+// the encoder splats each 3-byte group across a 32-bit lane, extracts the
+// four 6-bit indices arithmetically and translates them to ASCII with a
+// saturated range lookup; the decoder classifies characters through two
+// nibble lookup tables and bails out to the scalar loop on the first
+// block containing whitespace, padding or invalid input.
+
+#include "base64.h"
+#include "node_simd.h"
+
+#include <cstring>
+
+namespace node {
+namespace {
+
+using EncodeFn = size_t (*)(char* dst, const char* src, size_t slen);
+using DecodeFn = void (*)(char* dst, size_t dstlen,
+                          const char* src, size_t srclen,
+                          size_t* i, size_t* k);
+
+#ifndef NODE_SIMD_NEON
+// Fallback for CPUs (or architectures) without a suitable kernel.
+size_t base64_encode_none(char*, const char*, size_t) {
+  return 0;
+}
+
+void base64_decode_none(char*, size_t, const char*, size_t,
+                        size_t*, size_t*) {}
+#endif  // !NODE_SIMD_NEON
+
+#ifdef NODE_SIMD_X86
+
+// Translates 6-bit indices to base64 characters by adding a per-range
+// offset: the index is first reduced to a range selector with a
+// saturated subtraction ('0'..'9', '+' and '/' all land on distinct
+// selectors), which then picks the offset out of a 16-byte table.
+NODE_TARGET_SSSE3
+inline __m128i base64_indices_to_ascii(const __m128i indices) {
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, result), indices);
+}
+
+NODE_TARGET_SSSE3
+size_t base64_encode_ssse3(char* dst, const char* src, size_t slen) {
+  // Splat each 3-byte group into a 32-bit lane as [b1 b0 b2 b1] so that
+  // the four 6-bit indices can be extracted with two multiplications.
+  const __m128i shuf = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                    4, 5, 3, 4, 1, 2, 0, 1);
+  size_t i = 0;
+  size_t k = 0;
+  // Each iteration loads 16 bytes but consumes only 12, so stay one
+  // full vector short of the end of the input.
+  while (i + 16 <= slen) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    in = _mm_shuffle_epi8(in, shuf);
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     base64_indices_to_ascii(indices));
+    i += 12;
+    k += 16;
+  }
+  return i;
+}
+
+NODE_TARGET_AVX2
+size_t base64_encode_avx2(char* dst, const char* src, size_t slen) {
+  const __m256i shuf = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                       4, 5, 3, 4, 1, 2, 0, 1,
+                                       10, 11, 9, 10, 7, 8, 6, 7,
+                                       4, 5, 3, 4, 1, 2, 0, 1);
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  size_t k = 0;
+  // 32 bytes loaded, 24 consumed per iteration; see the SSSE3 variant.
+  while (i + 32 <= slen) {
+    __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    // Move bytes 0-11 into the low lane and 12-23 into the high lane so
+    // the in-lane byte shuffle below works on both halves.
+    in = _mm256_permutevar8x32_epi32(
+        in, _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5));
+    in = _mm256_shuffle_epi8(in, shuf);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+    __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    result = _mm256_or_si256(result,
+                             _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    result = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, result), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), result);
+    i += 24;
+    k += 32;
+  }
+  return i;
+}
+
+NODE_TARGET_SSSE3
+void base64_decode_ssse3(char* dst, size_t dstlen,
+                         const char* src, size_t srclen,
+                         size_t* const pi, size_t* const pk) {
+  // Character class bitmasks indexed by low and high nibble: a byte is a
+  // valid base64 character iff lut_lo[lo] & lut_hi[hi] == 0.
+  const __m128i lut_lo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  // Offset from ASCII to 6-bit value, indexed by high nibble ('/' gets
+  // its own slot via the eq_2F adjustment below).
+  const __m128i lut_roll = _mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  size_t i = *pi;
+  size_t k = *pk;
+  while (i + 16 <= srclen && k + 12 <= dstlen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi_nibbles =
+        _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0F));
+    const __m128i lo_nibbles = _mm_and_si128(in, _mm_set1_epi8(0x0F));
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    // Whitespace, '=', the URL-safe alphabet ('-', '_') and anything
+    // else the lenient table-driven scalar loop has to inspect shows up
+    // as a non-zero byte here.
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi),
+                                         _mm_setzero_si128())) != 0xFFFF) {
+      break;
+    }
+    const __m128i eq_2F = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2F));
+    const __m128i roll =
+        _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2F, hi_nibbles));
+    // Merge four 6-bit values per lane into three bytes.
+    __m128i merged = _mm_add_epi8(in, roll);
+    merged = _mm_maddubs_epi16(merged, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    merged = _mm_shuffle_epi8(
+        merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                              -1, -1, -1, -1));
+    // Store exactly the 12 payload bytes; the destination may not have
+    // room for a full 16-byte store.
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + k), merged);
+    const uint32_t tail =
+        static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(merged, 8)));
+    memcpy(dst + k + 8, &tail, sizeof(tail));
+    i += 16;
+    k += 12;
+  }
+  *pi = i;
+  *pk = k;
+}
+
+NODE_TARGET_AVX2
+void base64_decode_avx2(char* dst, size_t dstlen,
+                        const char* src, size_t srclen,
+                        size_t* const pi, size_t* const pk) {
+  const __m256i lut_lo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  size_t i = *pi;
+  size_t k = *pk;
+  while (i + 32 <= srclen && k + 24 <= dstlen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(in, 4), _mm256_set1_epi8(0x0F));
+    const __m256i lo_nibbles = _mm256_and_si256(in, _mm256_set1_epi8(0x0F));
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    if (_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi),
+                              _mm256_setzero_si256())) != -1) {
+      break;
+    }
+    const __m256i eq_2F = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(0x2F));
+    const __m256i roll =
+        _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2F, hi_nibbles));
+    __m256i merged = _mm256_add_epi8(in, roll);
+    merged = _mm256_maddubs_epi16(merged, _mm256_set1_epi32(0x01400140));
+    merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(
+        merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                 -1, -1, -1, -1,
+                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                 -1, -1, -1, -1));
+    // Compact the 12 payload bytes of each lane into 24 contiguous bytes.
+    merged = _mm256_permutevar8x32_epi32(
+        merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     _mm256_castsi256_si128(merged));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + k + 16),
+                     _mm256_extracti128_si256(merged, 1));
+    i += 32;
+    k += 24;
+  }
+  *pi = i;
+  *pk = k;
+}
+
+#endif  // NODE_SIMD_X86
+
+#ifdef NODE_SIMD_NEON
+
+size_t base64_encode_neon(char* dst, const char* src, size_t slen) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                              "abcdefghijklmnopqrstuvwxyz"
+                              "0123456789+/";
+  uint8x16x4_t tbl;
+  tbl.val[0] = vld1q_u8(reinterpret_cast<const uint8_t*>(table));
+  tbl.val[1] = vld1q_u8(reinterpret_cast<const uint8_t*>(table) + 16);
+  tbl.val[2] = vld1q_u8(reinterpret_cast<const uint8_t*>(table) + 32);
+  tbl.val[3] = vld1q_u8(reinterpret_cast<const uint8_t*>(table) + 48);
+  size_t i = 0;
+  size_t k = 0;
+  // The deinterleaving load gives the first, second and third byte of 16
+  // consecutive 3-byte groups in separate registers, so the 6-bit values
+  // fall out of plain shifts and the 64-entry table fits a single vqtbl4q.
+  while (i + 48 <= slen) {
+    const uint8x16x3_t in =
+        vld3q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4),
+                          vshrq_n_u8(in.val[1], 4));
+    out.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0F)), 2),
+                          vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3F));
+    out.val[0] = vqtbl4q_u8(tbl, out.val[0]);
+    out.val[1] = vqtbl4q_u8(tbl, out.val[1]);
+    out.val[2] = vqtbl4q_u8(tbl, out.val[2]);
+    out.val[3] = vqtbl4q_u8(tbl, out.val[3]);
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+    i += 48;
+    k += 64;
+  }
+  return i;
+}
+
+void base64_decode_neon(char* dst, size_t dstlen,
+                        const char* src, size_t srclen,
+                        size_t* const pi, size_t* const pk) {
+  // Same nibble classification tables as the SSSE3 decoder.
+  static const uint8_t kLutLo[16] = {
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A};
+  static const uint8_t kLutHi[16] = {
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+  static const int8_t kLutRoll[16] = {
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0};
+  const uint8x16_t lut_lo = vld1q_u8(kLutLo);
+  const uint8x16_t lut_hi = vld1q_u8(kLutHi);
+  const int8x16_t lut_roll = vld1q_s8(kLutRoll);
+  size_t i = *pi;
+  size_t k = *pk;
+  while (i + 64 <= srclen && k + 48 <= dstlen) {
+    const uint8x16x4_t in =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t vals;
+    uint8x16_t bad = vdupq_n_u8(0);
+    for (int j = 0; j < 4; j++) {
+      const uint8x16_t c = in.val[j];
+      const uint8x16_t lo_nib = vandq_u8(c, vdupq_n_u8(0x0F));
+      const uint8x16_t hi_nib = vshrq_n_u8(c, 4);
+      bad = vorrq_u8(bad, vandq_u8(vqtbl1q_u8(lut_lo, lo_nib),
+                                   vqtbl1q_u8(lut_hi, hi_nib)));
+      // vceqq yields 0xFF (= -1) for '/', stepping the roll index back to
+      // its dedicated slot.
+      const uint8x16_t eq_2F = vceqq_u8(c, vdupq_n_u8(0x2F));
+      const int8x16_t roll = vqtbl1q_s8(lut_roll, vaddq_u8(hi_nib, eq_2F));
+      vals.val[j] = vaddq_u8(c, vreinterpretq_u8_s8(roll));
+    }
+    if (vmaxvq_u8(bad) != 0)
+      break;
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(vals.val[0], 2),
+                          vshrq_n_u8(vals.val[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(vals.val[1], 4),
+                          vshrq_n_u8(vals.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(vals.val[2], 6), vals.val[3]);
+    vst3q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+    i += 64;
+    k += 48;
+  }
+  *pi = i;
+  *pk = k;
+}
+
+#endif  // NODE_SIMD_NEON
+
+EncodeFn ResolveEncode() {
+#if defined(NODE_SIMD_X86)
+  if (simd::cpu_has_avx2())
+    return base64_encode_avx2;
+  if (simd::cpu_has_ssse3())
+    return base64_encode_ssse3;
+  return base64_encode_none;
+#elif defined(NODE_SIMD_NEON)
+  return base64_encode_neon;
+#else
+  return base64_encode_none;
+#endif
+}
+
+DecodeFn ResolveDecode() {
+#if defined(NODE_SIMD_X86)
+  if (simd::cpu_has_avx2())
+    return base64_decode_avx2;
+  if (simd::cpu_has_ssse3())
+    return base64_decode_ssse3;
+  return base64_decode_none;
+#elif defined(NODE_SIMD_NEON)
+  return base64_decode_neon;
+#else
+  return base64_decode_none;
+#endif
+}
+
+}  // anonymous namespace
+
+size_t base64_encode_simd(char* dst, const char* src, size_t slen) {
+  static const EncodeFn encode = ResolveEncode();
+  return encode(dst, src, slen);
+}
+
+void base64_decode_simd(char* dst, size_t dstlen,
+                        const char* src, size_t srclen,
+                        size_t* i, size_t* k) {
+  static const DecodeFn decode = ResolveDecode();
+  decode(dst, dstlen, src, srclen, i, k);
+}
+
+}  // namespace node
@@ -54,6 +54,31 @@ inline static int8_t unbase64(uint8_t x) {
 }
 
 
+// Vectorized bulk kernels with runtime dispatch, defined in base64.cc.
+// Both consume as many whole input blocks as the selected instruction
+// set supports and leave the remainder — and, for the decoder, anything
+// from the first block containing whitespace, padding or invalid
+// characters onwards — to the scalar loops below. No-ops on platforms
+// without a suitable kernel.
+size_t base64_encode_simd(char* dst, const char* src, size_t slen);
+void base64_decode_simd(char* dst, size_t dstlen,
+                        const char* src, size_t srclen,
+                        size_t* i, size_t* k);
+
+// Only one-byte input has a vectorized decoder; the two-byte (UCS-2)
+// instantiation of base64_decode_fast() goes straight to the scalar loop.
+inline void base64_decode_simd_start(char* dst, size_t dstlen,
+                                     const char* src, size_t srclen,
+                                     size_t* i, size_t* k) {
+  base64_decode_simd(dst, dstlen, src, srclen, i, k);
+}
+
+template <typename TypeName>
+inline void base64_decode_simd_start(char*, size_t,
+                                     const TypeName*, size_t,
+                                     size_t*, size_t*) {}
+
+
 template <typename TypeName>
 bool base64_decode_group_slow(char* const dst, const size_t dstlen,
                               const TypeName* const src, const size_t srclen,
@@ -94,6 +119,7 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   size_t max_i = srclen / 4 * 4;
   size_t i = 0;
   size_t k = 0;
+  base64_decode_simd_start(dst, available, src, srclen, &i, &k);
   while (i < max_i && k < max_k) {
     const uint32_t v =
         unbase64(src[i + 0]) << 24 |
@@ -140,17 +166,17 @@ static size_t base64_encode(const char* src,
   unsigned a;
   unsigned b;
   unsigned c;
-  unsigned i;
-  unsigned k;
-  unsigned n;
+  size_t i;
+  size_t k;
+  size_t n;
 
   static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                               "abcdefghijklmnopqrstuvwxyz"
                               "0123456789+/";
 
-  i = 0;
-  k = 0;
   n = slen / 3 * 3;
+  i = base64_encode_simd(dst, src, slen);
+  k = i / 3 * 4;
 
   while (i < n) {
     a = src[i + 0] & 0xff;
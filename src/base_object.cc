@@ -0,0 +1,102 @@
+#include "base_object.h"
+#include "util-inl.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace node {
+
+namespace {
+
+// Per-thread pool of recycled BaseObject allocations, bucketed into
+// kGranularity-sized classes. All blocks are plain Malloc() allocations of
+// their full bucket size, so any block can always be handed back to free()
+// directly — e.g. when it is deleted on a different thread than it was
+// allocated on, or after the pool has been torn down at thread exit.
+constexpr size_t kGranularity = 64;
+constexpr size_t kSizeClasses = 16;  // Covers allocations up to 1024 bytes.
+constexpr size_t kMaxFreePerClass = 64;
+
+class BaseObjectPool {
+ public:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  BaseObjectPool();
+  ~BaseObjectPool();
+
+  FreeBlock* free_lists[kSizeClasses] = {nullptr};
+  size_t free_counts[kSizeClasses] = {0};
+};
+
+// Cleared by the pool's destructor so that late allocations and frees during
+// thread teardown fall back to the global allocator instead of touching a
+// destroyed pool.
+thread_local BaseObjectPool* current_pool = nullptr;
+
+BaseObjectPool::BaseObjectPool() {
+  current_pool = this;
+}
+
+BaseObjectPool::~BaseObjectPool() {
+  current_pool = nullptr;
+  for (size_t i = 0; i < kSizeClasses; i++) {
+    while (free_lists[i] != nullptr) {
+      FreeBlock* block = free_lists[i];
+      free_lists[i] = block->next;
+      free(block);
+    }
+  }
+}
+
+BaseObjectPool* GetBaseObjectPool() {
+  thread_local BaseObjectPool pool;
+  return current_pool;
+}
+
+inline size_t SizeClassOf(size_t size) {
+  return (size - 1) / kGranularity;
+}
+
+}  // anonymous namespace
+
+void* BaseObject::operator new(size_t size) {
+  const size_t size_class = SizeClassOf(size);
+  if (size_class >= kSizeClasses)
+    return Malloc<char>(size);
+  BaseObjectPool* pool = GetBaseObjectPool();
+  if (pool != nullptr) {
+    BaseObjectPool::FreeBlock* block = pool->free_lists[size_class];
+    if (block != nullptr) {
+      pool->free_lists[size_class] = block->next;
+      pool->free_counts[size_class]--;
+      return block;
+    }
+  }
+  // Always allocate the full bucket so that the block can later be reused
+  // by any type in the same size class.
+  return Malloc<char>((size_class + 1) * kGranularity);
+}
+
+void BaseObject::operator delete(void* ptr, size_t size) {
+  if (ptr == nullptr) return;
+  const size_t size_class = SizeClassOf(size);
+  BaseObjectPool* pool = GetBaseObjectPool();
+  if (pool == nullptr || size_class >= kSizeClasses ||
+      pool->free_counts[size_class] >= kMaxFreePerClass) {
+    free(ptr);
+    return;
+  }
+#ifdef DEBUG
+  // Poison recycled blocks so that use-after-free reads trip over obviously
+  // invalid data instead of stale-but-plausible object contents.
+  memset(ptr, 0xda, (size_class + 1) * kGranularity);
+#endif
+  auto* block = static_cast<BaseObjectPool::FreeBlock*>(ptr);
+  block->next = pool->free_lists[size_class];
+  pool->free_lists[size_class] = block;
+  pool->free_counts[size_class]++;
+}
+
+}  // namespace node
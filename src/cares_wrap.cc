@@ -29,10 +29,15 @@
 #include "util-inl.h"
 #include "uv.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <limits>
 #include <memory>
+#include <string>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #ifdef __POSIX__
@@ -87,6 +92,75 @@ inline uint32_t cares_get_32bit(const unsigned char* p) {
 
 const int ns_t_cname_or_a = -1;
 
+// Per-channel response cache. Successful responses are kept for the minimum
+// TTL of their answer records (clamped below), and for a further
+// stale-while-revalidate window during which they are still served while a
+// background query refreshes the entry.
+constexpr size_t kDnsCacheMaxEntries = 256;
+constexpr uint64_t kDnsCacheMinTtlMs = 1000;
+constexpr uint64_t kDnsCacheMaxTtlMs = 60 * 60 * 1000;
+constexpr uint64_t kDnsCacheStaleWindowMs = 30 * 1000;
+
+// Advances `offset` past a (possibly compressed) domain name in a raw DNS
+// packet. Returns false if the packet is truncated or malformed.
+bool SkipDnsName(const unsigned char* buf, int len, int* offset) {
+  int pos = *offset;
+  while (pos < len) {
+    const unsigned char label = buf[pos];
+    if (label == 0) {
+      *offset = pos + 1;
+      return true;
+    }
+    if ((label & 0xc0) == 0xc0) {  // Compression pointer; always 2 bytes.
+      if (pos + 2 > len) return false;
+      *offset = pos + 2;
+      return true;
+    }
+    if ((label & 0xc0) != 0) return false;
+    pos += 1 + label;
+  }
+  return false;
+}
+
+// Returns the minimum TTL (in seconds) over the answer records of a raw DNS
+// response, or a negative value if the response has no answers or cannot be
+// parsed and therefore must not be cached.
+int64_t MinAnswerTTL(const unsigned char* buf, int len) {
+  if (len < NS_HFIXEDSZ) return -1;
+  const int qdcount = cares_get_16bit(buf + 4);
+  const int ancount = cares_get_16bit(buf + 6);
+  if (ancount == 0) return -1;
+
+  int pos = NS_HFIXEDSZ;
+  for (int i = 0; i < qdcount; i++) {
+    if (!SkipDnsName(buf, len, &pos)) return -1;
+    pos += 4;  // QTYPE + QCLASS
+    if (pos > len) return -1;
+  }
+
+  int64_t min_ttl = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < ancount; i++) {
+    if (!SkipDnsName(buf, len, &pos)) return -1;
+    if (pos + 10 > len) return -1;
+    const int64_t ttl = cares_get_32bit(buf + pos + 4);
+    const int rdlength = cares_get_16bit(buf + pos + 8);
+    if (ttl < min_ttl) min_ttl = ttl;
+    pos += 10 + rdlength;
+    if (pos > len) return -1;
+  }
+  return min_ttl;
+}
+
+// Cache keys combine the query type with the case-normalized name (DNS names
+// are case-insensitive).
+std::string ResponseCacheKey(int type, const char* name) {
+  std::string key = std::to_string(type);
+  key += ':';
+  for (const char* p = name; *p != '\0'; p++)
+    key += ToLower(*p);
+  return key;
+}
+
 #define DNS_ESETSRVPENDING -1000
 inline const char* ToErrorCodeString(int status) {
   switch (status) {
@@ -148,6 +222,91 @@ struct TaskEqual {
 using node_ares_task_list =
     std::unordered_set<node_ares_task*, TaskHash, TaskEqual>;
 
+void ares_poll_cb(uv_poll_t* watcher, int status, int events);
+void ares_poll_close_cb(uv_poll_t* watcher);
+
+// Indirection between an ares channel's socket-state callback and the
+// ChannelWrap that currently owns the channel. It outlives the wrap so that
+// a quiescent channel can be parked in the channel pool (wrap == nullptr)
+// and later re-owned by a new wrap without re-initializing c-ares.
+struct AresChannelState {
+  ChannelWrap* wrap;
+};
+
+// Quiescent ares channels parked for reuse, keyed by their server
+// configuration. Together with ARES_FLAG_STAYOPEN this keeps a channel's
+// UDP sockets open across queries and across wrap lifetimes, so the
+// create-resolver-per-request pattern stops churning file descriptors and
+// re-reading the resolver configuration on every construction.
+struct PooledAresChannel {
+  ares_channel channel;
+  AresChannelState* state;
+  std::vector<node_ares_task*> tasks;
+  bool library_inited;
+};
+
+struct AresChannelPool {
+  std::unordered_map<std::string, std::vector<PooledAresChannel>> channels;
+  size_t size = 0;
+  bool hook_registered = false;
+};
+
+constexpr size_t kMaxPooledChannels = 8;
+
+// One pool per event loop; entries are drained by an environment cleanup
+// hook so their poll watchers close while the loop is still alive.
+thread_local std::unordered_map<Environment*, AresChannelPool> channel_pools;
+
+// Key of a channel freshly initialized from the system configuration,
+// learned from the first full ares_init_options() on this thread.
+thread_local std::string default_server_config_key;
+
+std::string ServerListKey(const ares_addr_port_node* servers) {
+  std::string key;
+  char buf[INET6_ADDRSTRLEN + 32];
+  for (const ares_addr_port_node* n = servers; n != nullptr; n = n->next) {
+    char ip[INET6_ADDRSTRLEN];
+    if (uv_inet_ntop(n->family, &n->addr, ip, sizeof(ip)) != 0)
+      return std::string();
+    snprintf(buf, sizeof(buf), "%d/%s:%d:%d;",
+             n->family, ip, n->udp_port, n->tcp_port);
+    key += buf;
+  }
+  return key;
+}
+
+std::string ServerConfigKey(ares_channel channel) {
+  ares_addr_port_node* servers = nullptr;
+  if (ares_get_servers_ports(channel, &servers) != ARES_SUCCESS)
+    return std::string();
+  std::string key = ServerListKey(servers);
+  ares_free_data(servers);
+  return key;
+}
+
+void DrainChannelPool(void* arg) {
+  Environment* env = static_cast<Environment*>(arg);
+  auto it = channel_pools.find(env);
+  if (it == channel_pools.end())
+    return;
+
+  for (auto& entry : it->second.channels) {
+    for (PooledAresChannel& pooled : entry.second) {
+      for (node_ares_task* task : pooled.tasks)
+        env->CloseHandle(&task->poll_watcher, ares_poll_close_cb);
+      ares_destroy(pooled.channel);
+      delete pooled.state;
+      if (pooled.library_inited) {
+        Mutex::ScopedLock lock(ares_library_mutex);
+        ares_library_cleanup();
+      }
+    }
+  }
+  channel_pools.erase(it);
+}
+
+class QueryWrap;
+
 class ChannelWrap : public AsyncWrap {
  public:
   ChannelWrap(Environment* env, Local<Object> object);
@@ -171,6 +330,55 @@ class ChannelWrap : public AsyncWrap {
   inline int active_query_count() { return active_query_count_; }
   inline node_ares_task_list* task_list() { return &task_list_; }
 
+  // TTL-honoring cache of raw DNS responses for this channel, keyed by
+  // ResponseCacheKey(). Entries past their TTL but within the
+  // stale-while-revalidate window are still served while RefreshResponse()
+  // re-queries them in the background.
+  struct CachedResponse {
+    std::vector<unsigned char> data;
+    uint64_t fresh_until;
+    uint64_t stale_until;
+    bool refresh_in_flight = false;
+  };
+
+  CachedResponse* CacheLookup(const std::string& key);
+  void CacheResponse(const std::string& key,
+                     const unsigned char* buf,
+                     int len);
+  void RefreshResponse(const std::string& key,
+                       const char* name,
+                       int dnsclass,
+                       int type);
+  inline void FlushCache() { response_cache_.clear(); }
+
+  // Coalescing of identical in-flight queries, keyed like the cache. The
+  // first query for a key becomes the leader and goes out on the wire;
+  // duplicates issued before its response arrives are parked as waiters and
+  // answered from the leader's response.
+  struct InflightQuery {
+    QueryWrap* leader;
+    std::vector<QueryWrap*> waiters;
+  };
+
+  // Returns true if `wrap` was attached to an existing in-flight query and
+  // must not be sent; otherwise registers `wrap` as the leader.
+  bool CoalesceQuery(const std::string& key, QueryWrap* wrap);
+  void FinishInflight(const std::string& key,
+                      int status,
+                      const unsigned char* answer_buf,
+                      int answer_len);
+  // Detaches a destroyed QueryWrap from the in-flight table. A destroyed
+  // leader cancels its waiters, since its wire response can no longer be
+  // delivered.
+  void ForgetQuery(const std::string& key, QueryWrap* wrap);
+
+  // Channel pooling. A quiescent channel is parked with its open sockets
+  // instead of being destroyed, and a wrap that wants a given server
+  // configuration adopts a parked channel instead of initializing a new one.
+  bool AdoptFromPool(const std::string& key);
+  bool ReleaseToPool();
+  bool TrySwapFromPool(const std::string& key);
+
   void MemoryInfo(MemoryTracker* tracker) const override {
     if (timer_handle_ != nullptr)
       tracker->TrackField("timer_handle", *timer_handle_);
@@ -183,13 +391,18 @@ class ChannelWrap : public AsyncWrap {
   static void AresTimeout(uv_timer_t* handle);
 
  private:
+  void Adopt(PooledAresChannel* pooled);
+
   uv_timer_t* timer_handle_;
   ares_channel channel_;
+  AresChannelState* state_ = nullptr;
   bool query_last_ok_;
   bool is_servers_default_;
   bool library_inited_;
   int active_query_count_;
   node_ares_task_list task_list_;
+  std::unordered_map<std::string, CachedResponse> response_cache_;
+  std::unordered_map<std::string, InflightQuery> inflight_queries_;
 };
 
 ChannelWrap::ChannelWrap(Environment* env,
@@ -226,10 +439,46 @@ class GetAddrInfoReqWrap : public ReqWrap<uv_getaddrinfo_t> {
 
   bool verbatim() const { return verbatim_; }
 
+  // Duplicate lookups issued while this one is on the libuv threadpool;
+  // they never dispatch themselves and are completed from this wrap's
+  // result in AfterGetAddrInfo().
+  void AddWaiter(std::unique_ptr<GetAddrInfoReqWrap> waiter) {
+    waiters_.push_back(std::move(waiter));
+  }
+  std::vector<std::unique_ptr<GetAddrInfoReqWrap>> TakeWaiters() {
+    return std::move(waiters_);
+  }
+  void set_coalesce_key(const std::string& key) { coalesce_key_ = key; }
+  const std::string& coalesce_key() const { return coalesce_key_; }
+
  private:
   const bool verbatim_;
+  std::string coalesce_key_;
+  std::vector<std::unique_ptr<GetAddrInfoReqWrap>> waiters_;
 };
 
+// In-flight getaddrinfo lookups for the current thread, so that a burst of
+// identical lookups results in a single getaddrinfo(3) call. Keyed by
+// environment, hostname, family, flags and result order; the value is the
+// dispatched leader that duplicates attach to. thread_local works here
+// because a lookup completes on the same loop (thread) that dispatched it.
+thread_local std::unordered_map<std::string, GetAddrInfoReqWrap*>
+    in_flight_lookups;
+
+std::string LookupKey(Environment* env,
+                      const char* hostname,
+                      int family,
+                      int32_t flags,
+                      bool verbatim) {
+  char prefix[64];
+  snprintf(prefix, sizeof(prefix), "%p:%d:%d:%d:",
+           static_cast<void*>(env), family, flags, verbatim ? 1 : 0);
+  std::string key = prefix;
+  for (const char* p = hostname; *p != '\0'; p++)
+    key += ToLower(*p);
+  return key;
+}
+
 GetAddrInfoReqWrap::GetAddrInfoReqWrap(Environment* env,
                                        Local<Object> req_wrap_obj,
                                        bool verbatim)
@@ -259,6 +508,11 @@ void ChannelWrap::AresTimeout(uv_timer_t* handle) {
   ChannelWrap* channel = static_cast<ChannelWrap*>(handle->data);
   CHECK_EQ(channel->timer_handle(), handle);
   CHECK_EQ(false, channel->task_list()->empty());
+  if (channel->active_query_count() == 0) {
+    // Nothing that could time out; re-armed when the next query starts.
+    uv_timer_stop(handle);
+    return;
+  }
   ares_process_fd(channel->cares_channel(), ARES_SOCKET_BAD, ARES_SOCKET_BAD);
 }
 
@@ -267,8 +521,10 @@ void ares_poll_cb(uv_poll_t* watcher, int status, int events) {
   node_ares_task* task = ContainerOf(&node_ares_task::poll_watcher, watcher);
   ChannelWrap* channel = task->channel;
 
-  /* Reset the idle timer */
-  uv_timer_again(channel->timer_handle());
+  /* Reset the idle timer; an idle channel's sockets stay open and polled */
+  /* for reads, but its timer may be stopped or not created yet. */
+  if (channel->timer_handle() != nullptr)
+    uv_timer_again(channel->timer_handle());
 
   if (status < 0) {
     /* An error happened. Just pretend that the socket is both readable and */
@@ -316,9 +572,14 @@ void ares_sockstate_cb(void* data,
                        ares_socket_t sock,
                        int read,
                        int write) {
-  ChannelWrap* channel = static_cast<ChannelWrap*>(data);
+  ChannelWrap* channel = static_cast<AresChannelState*>(data)->wrap;
   node_ares_task* task;
 
+  // A parked channel only sees callbacks while it is being destroyed from
+  // the pool, after its watchers have already been closed.
+  if (channel == nullptr)
+    return;
+
   node_ares_task lookup_task;
   lookup_task.sock = sock;
   auto it = channel->task_list()->find(&lookup_task);
@@ -455,11 +716,23 @@ void cares_wrap_hostent_cpy(struct hostent* dest, const struct hostent* src) {
 class QueryWrap;
 
 void ChannelWrap::Setup() {
+  // A parked channel with the system's default server configuration can be
+  // adopted directly, skipping c-ares initialization (and its re-read of
+  // the resolver configuration) entirely.
+  if (!default_server_config_key.empty() &&
+      AdoptFromPool(default_server_config_key)) {
+    return;
+  }
+
   struct ares_options options;
   memset(&options, 0, sizeof(options));
-  options.flags = ARES_FLAG_NOCHECKRESP;
+  // STAYOPEN keeps a channel's UDP sockets open between queries, so
+  // back-to-back queries are pipelined over the same socket (c-ares
+  // demultiplexes responses by query id) instead of churning descriptors.
+  options.flags = ARES_FLAG_NOCHECKRESP | ARES_FLAG_STAYOPEN;
+  state_ = new AresChannelState{this};
   options.sock_state_cb = ares_sockstate_cb;
-  options.sock_state_cb_data = this;
+  options.sock_state_cb_data = state_;
 
   int r;
   if (!library_inited_) {
@@ -483,6 +756,9 @@ void ChannelWrap::Setup() {
   }
 
   library_inited_ = true;
+
+  if (default_server_config_key.empty())
+    default_server_config_key = ServerConfigKey(channel_);
 }
 
 void ChannelWrap::StartTimer() {
@@ -505,7 +781,13 @@ void ChannelWrap::CloseTimer() {
 }
 
 ChannelWrap::~ChannelWrap() {
+  if (ReleaseToPool()) {
+    CloseTimer();
+    return;
+  }
+
   ares_destroy(channel_);
+  delete state_;
 
   if (library_inited_) {
     Mutex::ScopedLock lock(ares_library_mutex);
@@ -517,9 +799,229 @@ ChannelWrap::~ChannelWrap() {
 }
 
 
+bool ChannelWrap::AdoptFromPool(const std::string& key) {
+  auto pool_it = channel_pools.find(env());
+  if (pool_it == channel_pools.end())
+    return false;
+  AresChannelPool& pool = pool_it->second;
+  auto it = pool.channels.find(key);
+  if (it == pool.channels.end() || it->second.empty())
+    return false;
+
+  PooledAresChannel pooled = std::move(it->second.back());
+  it->second.pop_back();
+  if (it->second.empty())
+    pool.channels.erase(it);
+  pool.size--;
+
+  Adopt(&pooled);
+  return true;
+}
+
+
+void ChannelWrap::Adopt(PooledAresChannel* pooled) {
+  channel_ = pooled->channel;
+  state_ = pooled->state;
+  state_->wrap = this;
+  library_inited_ = pooled->library_inited;
+
+  // Re-own the channel's open sockets. The channel is quiescent, so the
+  // watchers only listen for reads and stay unreferenced until a query
+  // makes the channel active again.
+  for (node_ares_task* task : pooled->tasks) {
+    task->channel = this;
+    uv_poll_start(&task->poll_watcher, UV_READABLE, ares_poll_cb);
+    uv_unref(reinterpret_cast<uv_handle_t*>(&task->poll_watcher));
+    task_list_.insert(task);
+  }
+  pooled->tasks.clear();
+}
+
+
+bool ChannelWrap::ReleaseToPool() {
+  if (active_query_count_ != 0 || state_ == nullptr || channel_ == nullptr)
+    return false;
+
+  AresChannelPool& pool = channel_pools[env()];
+  if (pool.size >= kMaxPooledChannels)
+    return false;
+  std::string key = ServerConfigKey(channel_);
+  if (key.empty())
+    return false;
+
+  if (!pool.hook_registered) {
+    env()->AddCleanupHook(DrainChannelPool, env());
+    pool.hook_registered = true;
+  }
+
+  PooledAresChannel pooled;
+  pooled.channel = channel_;
+  pooled.state = state_;
+  pooled.library_inited = library_inited_;
+  state_->wrap = nullptr;
+
+  for (node_ares_task* task : task_list_) {
+    uv_poll_stop(&task->poll_watcher);
+    task->channel = nullptr;
+    pooled.tasks.push_back(task);
+  }
+  task_list_.clear();
+
+  pool.channels[key].push_back(std::move(pooled));
+  pool.size++;
+
+  channel_ = nullptr;
+  state_ = nullptr;
+  library_inited_ = false;
+  return true;
+}
+
+
+bool ChannelWrap::TrySwapFromPool(const std::string& key) {
+  if (active_query_count_ != 0)
+    return false;
+
+  auto pool_it = channel_pools.find(env());
+  if (pool_it == channel_pools.end())
+    return false;
+  AresChannelPool& pool = pool_it->second;
+  auto it = pool.channels.find(key);
+  if (it == pool.channels.end() || it->second.empty())
+    return false;
+
+  PooledAresChannel pooled = std::move(it->second.back());
+  it->second.pop_back();
+  if (it->second.empty())
+    pool.channels.erase(it);
+  pool.size--;
+
+  // Park (or, failing that, destroy) the current channel, then take over
+  // the pooled one, which already has the requested server configuration.
+  if (!ReleaseToPool()) {
+    ares_destroy(channel_);
+    delete state_;
+    if (library_inited_) {
+      Mutex::ScopedLock lock(ares_library_mutex);
+      ares_library_cleanup();
+    }
+  }
+  CloseTimer();
+
+  Adopt(&pooled);
+  return true;
+}
+
+
 void ChannelWrap::ModifyActivityQueryCount(int count) {
+  const bool was_active = active_query_count_ > 0;
   active_query_count_ += count;
   CHECK_GE(active_query_count_, 0);
+  const bool is_active = active_query_count_ > 0;
+  if (is_active == was_active)
+    return;
+
+  // With ARES_FLAG_STAYOPEN, sockets and their poll watchers outlive the
+  // queries they were created for. Only hold the event loop open while
+  // queries are actually pending.
+  for (node_ares_task* task : task_list_) {
+    uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(&task->poll_watcher);
+    if (is_active)
+      uv_ref(handle);
+    else
+      uv_unref(handle);
+  }
+
+  if (is_active) {
+    if (!task_list_.empty())
+      StartTimer();
+  } else if (timer_handle_ != nullptr) {
+    uv_timer_stop(timer_handle_);
+  }
+}
+
+
+ChannelWrap::CachedResponse* ChannelWrap::CacheLookup(const std::string& key) {
+  auto it = response_cache_.find(key);
+  if (it == response_cache_.end())
+    return nullptr;
+  const uint64_t now = uv_now(env()->event_loop());
+  if (now >= it->second.stale_until) {
+    // Too old to serve even as stale data; fall through to a regular query
+    // (which will re-populate the entry on success).
+    response_cache_.erase(it);
+    return nullptr;
+  }
+  return &it->second;
+}
+
+
+void ChannelWrap::CacheResponse(const std::string& key,
+                                const unsigned char* buf,
+                                int len) {
+  const int64_t ttl = MinAnswerTTL(buf, len);
+  if (ttl < 0)
+    return;
+
+  const uint64_t now = uv_now(env()->event_loop());
+  if (response_cache_.size() >= kDnsCacheMaxEntries &&
+      response_cache_.count(key) == 0) {
+    // Prefer dropping entries that can no longer be served; failing that,
+    // drop an arbitrary one. Typical workloads query far fewer distinct
+    // names than the cache holds.
+    for (auto it = response_cache_.begin(); it != response_cache_.end();) {
+      if (now >= it->second.stale_until)
+        it = response_cache_.erase(it);
+      else
+        ++it;
+    }
+    if (response_cache_.size() >= kDnsCacheMaxEntries)
+      response_cache_.erase(response_cache_.begin());
+  }
+
+  const uint64_t ttl_ms = std::max(
+      kDnsCacheMinTtlMs,
+      std::min(kDnsCacheMaxTtlMs, static_cast<uint64_t>(ttl) * 1000));
+  CachedResponse& entry = response_cache_[key];
+  entry.data.assign(buf, buf + len);
+  entry.fresh_until = now + ttl_ms;
+  entry.stale_until = entry.fresh_until + kDnsCacheStaleWindowMs;
+  entry.refresh_in_flight = false;
+}
+
+
+// Re-queries a cached name in the background after its TTL expired while it
+// is still being served stale. The callback only feeds the cache; no
+// QueryWrap is involved. c-ares guarantees that pending callbacks run during
+// ares_destroy() (with ARES_EDESTRUCTION), so `this` outlives the query.
+void ChannelWrap::RefreshResponse(const std::string& key,
+                                  const char* name,
+                                  int dnsclass,
+                                  int type) {
+  struct RefreshCtx {
+    ChannelWrap* channel;
+    std::string key;
+  };
+
+  auto callback = [](void* arg, int status, int timeouts,
+                     unsigned char* answer_buf, int answer_len) {
+    std::unique_ptr<RefreshCtx> ctx { static_cast<RefreshCtx*>(arg) };
+    ChannelWrap* channel = ctx->channel;
+    channel->set_query_last_ok(status != ARES_ECONNREFUSED);
+    channel->ModifyActivityQueryCount(-1);
+
+    auto it = channel->response_cache_.find(ctx->key);
+    if (status == ARES_SUCCESS) {
+      channel->CacheResponse(ctx->key, answer_buf, answer_len);
+    } else if (it != channel->response_cache_.end()) {
+      // Keep serving the stale entry until its window runs out, but allow
+      // another refresh attempt.
+      it->second.refresh_in_flight = false;
+    }
+  };
+
+  ModifyActivityQueryCount(1);
+  ares_query(channel_, name, dnsclass, type, callback,
+             new RefreshCtx { this, key });
 }
 
 
@@ -583,6 +1085,9 @@ class QueryWrap : public AsyncWrap {
     // Let Callback() know that this object no longer exists.
     if (callback_ptr_ != nullptr)
       *callback_ptr_ = nullptr;
+
+    if (!cache_key_.empty())
+      channel_->ForgetQuery(cache_key_, this);
   }
 
   // Subclasses should implement the appropriate Send method.
@@ -596,6 +1101,26 @@ class QueryWrap : public AsyncWrap {
     return 0;
   }
 
+  // Takes a copy of a raw response buffer and schedules the JS callback.
+  // Called both for this wrap's own wire response and, via the channel's
+  // in-flight table, for coalesced duplicates of another wrap's query.
+  void DeliverResponse(int status,
+                       const unsigned char* answer_buf,
+                       int answer_len) {
+    unsigned char* buf_copy = nullptr;
+    if (status == ARES_SUCCESS) {
+      buf_copy = node::Malloc<unsigned char>(answer_len);
+      memcpy(buf_copy, answer_buf, answer_len);
+    }
+
+    response_data_ = std::make_unique<ResponseData>();
+    response_data_->status = status;
+    response_data_->is_host = false;
+    response_data_->buf = MallocedBuffer<unsigned char>(buf_copy, answer_len);
+
+    QueueResponseCallback(status);
+  }
+
  protected:
   void AresQuery(const char* name,
                  int dnsclass,
@@ -604,6 +1129,35 @@ class QueryWrap : public AsyncWrap {
     TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
       TRACING_CATEGORY_NODE2(dns, native), trace_name_, this,
       "name", TRACE_STR_COPY(name));
+
+    if (dnsclass == ns_c_in) {
+      std::string key = ResponseCacheKey(type, name);
+      ChannelWrap::CachedResponse* cached = channel_->CacheLookup(key);
+      if (cached != nullptr) {
+        if (uv_now(env()->event_loop()) >= cached->fresh_until &&
+            !cached->refresh_in_flight) {
+          cached->refresh_in_flight = true;
+          channel_->RefreshResponse(key, name, dnsclass, type);
+        }
+        unsigned char* buf_copy =
+            node::Malloc<unsigned char>(cached->data.size());
+        memcpy(buf_copy, cached->data.data(), cached->data.size());
+        response_data_ = std::make_unique<ResponseData>();
+        response_data_->status = ARES_SUCCESS;
+        response_data_->is_host = false;
+        response_data_->buf =
+            MallocedBuffer<unsigned char>(buf_copy, cached->data.size());
+        QueueResponseCallback(ARES_SUCCESS);
+        return;
+      }
+      cache_key_ = std::move(key);
+
+      // If an identical query is already on the wire, wait for its response
+      // instead of sending another one.
+      if (channel_->CoalesceQuery(cache_key_, this))
+        return;
+    }
+
     ares_query(channel_->cares_channel(), name, dnsclass, type, Callback,
                MakeCallbackPointer());
   }
@@ -648,19 +1202,14 @@ class QueryWrap : public AsyncWrap {
     QueryWrap* wrap = FromCallbackPointer(arg);
     if (wrap == nullptr) return;
 
-    unsigned char* buf_copy = nullptr;
-    if (status == ARES_SUCCESS) {
-      buf_copy = node::Malloc<unsigned char>(answer_len);
-      memcpy(buf_copy, answer_buf, answer_len);
+    if (!wrap->cache_key_.empty()) {
+      if (status == ARES_SUCCESS)
+        wrap->channel_->CacheResponse(wrap->cache_key_, answer_buf, answer_len);
+      wrap->channel_->FinishInflight(wrap->cache_key_, status,
+                                     answer_buf, answer_len);
     }
 
-    wrap->response_data_ = std::make_unique<ResponseData>();
-    ResponseData* data = wrap->response_data_.get();
-    data->status = status;
-    data->is_host = false;
-    data->buf = MallocedBuffer<unsigned char>(buf_copy, answer_len);
-
-    wrap->QueueResponseCallback(status);
+    wrap->DeliverResponse(status, answer_buf, answer_len);
   }
 
   static void Callback(void* arg, int status, int timeouts,
@@ -738,12 +1287,68 @@ class QueryWrap : public AsyncWrap {
  private:
   std::unique_ptr<ResponseData> response_data_;
   const char* trace_name_;
+  // Key under which a successful response should be cached; empty for
+  // queries that bypass the cache (non-IN class, hostent-based lookups).
+  std::string cache_key_;
   // Pointer to pointer to 'this' that can be reset from the destructor,
   // in order to let Callback() know that 'this' no longer exists.
   QueryWrap** callback_ptr_ = nullptr;
 };
 
 
+// These live below QueryWrap because they call into it.
+
+bool ChannelWrap::CoalesceQuery(const std::string& key, QueryWrap* wrap) {
+  auto it = inflight_queries_.find(key);
+  if (it != inflight_queries_.end()) {
+    it->second.waiters.push_back(wrap);
+    return true;
+  }
+  inflight_queries_[key].leader = wrap;
+  return false;
+}
+
+
+void ChannelWrap::FinishInflight(const std::string& key,
+                                 int status,
+                                 const unsigned char* answer_buf,
+                                 int answer_len) {
+  auto it = inflight_queries_.find(key);
+  if (it == inflight_queries_.end())
+    return;
+
+  // Erase before delivering: a callback may issue a fresh query for the
+  // same name, which must not attach to this finished entry.
+  std::vector<QueryWrap*> waiters = std::move(it->second.waiters);
+  inflight_queries_.erase(it);
+
+  for (QueryWrap* waiter : waiters)
+    waiter->DeliverResponse(status, answer_buf, answer_len);
+}
+
+
+void ChannelWrap::ForgetQuery(const std::string& key, QueryWrap* wrap) {
+  auto it = inflight_queries_.find(key);
+  if (it == inflight_queries_.end())
+    return;
+
+  InflightQuery& entry = it->second;
+  if (entry.leader == wrap) {
+    // The wire response can no longer be delivered; fail the waiters the
+    // same way a cancelled query of their own would.
+    std::vector<QueryWrap*> waiters = std::move(entry.waiters);
+    inflight_queries_.erase(it);
+    for (QueryWrap* waiter : waiters)
+      waiter->DeliverResponse(ARES_ECANCELLED, nullptr, 0);
+    return;
+  }
+
+  auto waiter = std::find(entry.waiters.begin(), entry.waiters.end(), wrap);
+  if (waiter != entry.waiters.end())
+    entry.waiters.erase(waiter);
+}
+
+
 template <typename T>
 Local<Array> AddrTTLToArray(Environment* env,
                             const T* addrttls,
@@ -1870,8 +2475,36 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
       TRACING_CATEGORY_NODE2(dns, native), "lookup", req_wrap.get(),
       "count", n, "verbatim", verbatim);
 
+  // Detach coalesced duplicates before making callbacks, so that a callback
+  // re-issuing the same lookup dispatches a fresh request. Each waiter gets
+  // its own copy of the result array up front, since callbacks may mutate
+  // what they receive.
+  in_flight_lookups.erase(req_wrap->coalesce_key());
+  auto waiters = req_wrap->TakeWaiters();
+  std::vector<Local<Value>> waiter_results(waiters.size(), argv[1]);
+  if (status == 0) {
+    for (auto& result : waiter_results) {
+      Local<Array> copy = Array::New(env->isolate());
+      Local<Array> source = argv[1].As<Array>();
+      for (uint64_t i = 0; i < n; i++) {
+        copy->Set(env->context(), i,
+                  source->Get(env->context(), i).ToLocalChecked()).Check();
+      }
+      result = copy;
+    }
+  }
+
   // Make the callback into JavaScript
   req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+
+  for (size_t i = 0; i < waiters.size(); i++) {
+    Local<Value> waiter_argv[] = { argv[0], waiter_results[i] };
+    TRACE_EVENT_NESTABLE_ASYNC_END2(
+        TRACING_CATEGORY_NODE2(dns, native), "lookup", waiters[i].get(),
+        "count", n, "verbatim", verbatim);
+    waiters[i]->MakeCallback(env->oncomplete_string(), arraysize(waiter_argv),
+                             waiter_argv);
+  }
 }
 
 
@@ -1983,14 +2616,27 @@ void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
       "family",
       family == AF_INET ? "ipv4" : family == AF_INET6 ? "ipv6" : "unspec");
 
+  // An identical lookup may already be running on the threadpool; if so,
+  // park this request on it rather than dispatching another one.
+  std::string key =
+      LookupKey(env, *hostname, family, flags, args[4]->IsTrue());
+  auto in_flight = in_flight_lookups.find(key);
+  if (in_flight != in_flight_lookups.end()) {
+    in_flight->second->AddWaiter(std::move(req_wrap));
+    return args.GetReturnValue().Set(0);
+  }
+
   int err = req_wrap->Dispatch(uv_getaddrinfo,
                                AfterGetAddrInfo,
                                *hostname,
                                nullptr,
                                &hints);
-  if (err == 0)
+  if (err == 0) {
+    req_wrap->set_coalesce_key(key);
+    in_flight_lookups[key] = req_wrap.get();
     // Release ownership of the pointer allowing the ownership to be transferred
     USE(req_wrap.release());
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -2079,6 +2725,10 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
 
   uint32_t len = arr->Length();
 
+  // Cached responses may no longer reflect what the new servers would
+  // answer, so drop them whenever the server list changes.
+  channel->FlushCache();
+
   if (len == 0) {
     int rv = ares_set_servers(channel->cares_channel(), nullptr);
     return args.GetReturnValue().Set(rv);
@@ -2135,10 +2785,17 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
     last = cur;
   }
 
-  if (err == 0)
+  if (err == 0) {
+    // A parked channel that already has this exact server configuration can
+    // be adopted wholesale, keeping its warmed-up sockets.
+    if (channel->TrySwapFromPool(ServerListKey(&servers[0]))) {
+      channel->set_is_servers_default(false);
+      return args.GetReturnValue().Set(ARES_SUCCESS);
+    }
     err = ares_set_servers_ports(channel->cares_channel(), &servers[0]);
-  else
+  } else {
     err = ARES_EBADSTR;
+  }
 
   if (err == ARES_SUCCESS)
     channel->set_is_servers_default(false);
@@ -1,10 +1,24 @@
 #include "connect_wrap.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
 #include "req_wrap-inl.h"
 
+#include <memory>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 namespace node {
 
+using v8::Boolean;
+using v8::Context;
+using v8::HandleScope;
+using v8::Integer;
 using v8::Local;
 using v8::Object;
+using v8::Value;
 
 class Environment;
 
@@ -13,4 +27,125 @@ ConnectWrap::ConnectWrap(Environment* env,
     AsyncWrap::ProviderType provider) : ReqWrap(env, req_wrap_obj, provider) {
 }
 
+
+MultiConnectWrap::MultiConnectWrap(Environment* env,
+    Local<Object> req_wrap_obj,
+    AsyncWrap* handle_wrap,
+    uv_tcp_t* target)
+    : ConnectWrap(env, req_wrap_obj, AsyncWrap::PROVIDER_TCPCONNECTWRAP),
+      handle_wrap_(handle_wrap),
+      target_(target) {
+}
+
+
+MultiConnectWrap::~MultiConnectWrap() {
+  CloseAttempt();
+}
+
+
+int MultiConnectWrap::Start(std::vector<sockaddr_storage>&& addrs) {
+  CHECK(!addrs.empty());
+  CHECK(addrs_.empty());
+  addrs_ = std::move(addrs);
+  return StartAttempt();
+}
+
+
+int MultiConnectWrap::StartAttempt() {
+  CHECK_NULL(attempt_);
+  CHECK_LT(next_, addrs_.size());
+
+  attempt_ = new uv_tcp_t;
+  int err = uv_tcp_init(env()->event_loop(), attempt_);
+  if (err != 0) {
+    delete attempt_;
+    attempt_ = nullptr;
+    return err;
+  }
+
+  const sockaddr* addr = reinterpret_cast<const sockaddr*>(&addrs_[next_]);
+  next_++;
+  err = Dispatch(uv_tcp_connect, attempt_, addr, AfterAttempt);
+  if (err != 0)
+    CloseAttempt();
+  return err;
+}
+
+
+void MultiConnectWrap::CloseAttempt() {
+  if (attempt_ == nullptr)
+    return;
+  uv_close(reinterpret_cast<uv_handle_t*>(attempt_), [](uv_handle_t* handle) {
+    delete reinterpret_cast<uv_tcp_t*>(handle);
+  });
+  attempt_ = nullptr;
+}
+
+
+void MultiConnectWrap::AfterAttempt(uv_connect_t* req, int status) {
+  MultiConnectWrap* wrap = static_cast<MultiConnectWrap*>(req->data);
+  CHECK_NOT_NULL(wrap);
+
+  if (status == 0 || wrap->next_ >= wrap->addrs_.size())
+    return wrap->Finish(status);
+
+  // The failed socket cannot be reused; fall back to the next candidate on
+  // a fresh handle. Reset() allows dispatching this request object again.
+  wrap->CloseAttempt();
+  wrap->Reset();
+  int err = wrap->StartAttempt();
+  if (err != 0)
+    wrap->Finish(err);
+}
+
+
+void MultiConnectWrap::Finish(int status) {
+  std::unique_ptr<MultiConnectWrap> self(this);
+  Environment* env = this->env();
+
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  bool readable = false;
+  bool writable = false;
+
+  if (status == 0) {
+#ifdef _WIN32
+    // The binding layer rejects this path on Windows; duplicating the
+    // winning socket into the target handle relies on dup(2).
+    status = UV_ENOSYS;
+#else
+    if (uv_is_closing(reinterpret_cast<uv_handle_t*>(target_))) {
+      status = UV_ECANCELED;
+    } else {
+      uv_os_fd_t fd;
+      CHECK_EQ(uv_fileno(reinterpret_cast<uv_handle_t*>(attempt_), &fd), 0);
+      int duped = dup(fd);
+      if (duped == -1)
+        status = uv_translate_sys_error(errno);
+      else
+        status = uv_tcp_open(target_, duped);
+    }
+    if (status == 0) {
+      readable = uv_is_readable(reinterpret_cast<uv_stream_t*>(target_)) != 0;
+      writable = uv_is_writable(reinterpret_cast<uv_stream_t*>(target_)) != 0;
+    }
+#endif
+  }
+  CloseAttempt();
+
+  CHECK_EQ(persistent().IsEmpty(), false);
+  CHECK_EQ(handle_wrap_->persistent().IsEmpty(), false);
+
+  Local<Value> argv[5] = {
+    Integer::New(env->isolate(), status),
+    handle_wrap_->object(),
+    object(),
+    Boolean::New(env->isolate(), readable),
+    Boolean::New(env->isolate(), writable)
+  };
+
+  MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+}
+
 }  // namespace node
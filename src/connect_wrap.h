@@ -6,6 +6,8 @@
 #include "req_wrap-inl.h"
 #include "async_wrap.h"
 
+#include <vector>
+
 namespace node {
 
 class ConnectWrap : public ReqWrap<uv_connect_t> {
@@ -19,6 +21,43 @@ class ConnectWrap : public ReqWrap<uv_connect_t> {
   SET_SELF_SIZE(ConnectWrap)
 };
 
+// A connect request that takes a list of pre-resolved addresses and tries
+// them in order without surfacing the intermediate failures to JS. Each
+// attempt runs on a temporary handle; the socket of the first attempt that
+// connects is moved into the target handle and a single oncomplete callback
+// is emitted, matching the shape of ConnectionWrap::AfterConnect(). This
+// keeps address fallback out of the JS/C++ boundary for callers that
+// already hold binary sockaddrs from the resolver.
+class MultiConnectWrap : public ConnectWrap {
+ public:
+  MultiConnectWrap(Environment* env,
+                   v8::Local<v8::Object> req_wrap_obj,
+                   AsyncWrap* handle_wrap,
+                   uv_tcp_t* target);
+  ~MultiConnectWrap() override;
+
+  // Kicks off the first attempt. Returns a libuv error code on synchronous
+  // failure, in which case the caller still owns (and should delete) this
+  // object; once 0 is returned the wrap deletes itself after the callback.
+  int Start(std::vector<sockaddr_storage>&& addrs);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(MultiConnectWrap)
+  SET_SELF_SIZE(MultiConnectWrap)
+
+ private:
+  static void AfterAttempt(uv_connect_t* req, int status);
+  int StartAttempt();
+  void CloseAttempt();
+  void Finish(int status);
+
+  BaseObjectPtr<AsyncWrap> handle_wrap_;
+  uv_tcp_t* target_;
+  uv_tcp_t* attempt_ = nullptr;
+  std::vector<sockaddr_storage> addrs_;
+  size_t next_ = 0;
+};
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
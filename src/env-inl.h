@@ -33,6 +33,7 @@
 #include "node_perf_common.h"
 #include "node_context_data.h"
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 
@@ -185,6 +186,15 @@ inline void AsyncHooks::clear_async_id_stack() {
   fields_[kStackLength] = 0;
 }
 
+// Keep in sync with isSampledAsyncId in lib/internal/async_hooks.js.
+inline bool AsyncHooks::sampled(double async_id) {
+  const uint32_t interval = fields_[kSampleInterval];
+  if (interval <= 1) return true;
+  // Async ids are consecutive integers, so selecting by remainder yields an
+  // even 1-in-interval spread without per-resource bookkeeping.
+  return std::fmod(async_id, static_cast<double>(interval)) == 0;
+}
+
 // The DefaultTriggerAsyncIdScope(AsyncWrap*) constructor is defined in
 // async_wrap-inl.h to avoid a circular dependency.
 
@@ -273,6 +283,13 @@ inline bool TickInfo::has_rejection_to_warn() const {
   return fields_[kHasRejectionToWarn] == 1;
 }
 
+inline TaskQueueStats::TaskQueueStats(v8::Isolate* isolate)
+    : fields_(isolate, kFieldsCount) {}
+
+inline AliasedFloat64Array& TaskQueueStats::fields() {
+  return fields_;
+}
+
 inline void Environment::AssignToContext(v8::Local<v8::Context> context,
                                          const ContextInfo& info) {
   context->SetAlignedPointerInEmbedderData(
@@ -436,10 +453,18 @@ inline TickInfo* Environment::tick_info() {
   return &tick_info_;
 }
 
+inline TaskQueueStats* Environment::task_queue_stats() {
+  return &task_queue_stats_;
+}
+
 inline uint64_t Environment::timer_base() const {
   return timer_base_;
 }
 
+inline AliasedFloat64Array& Environment::coarse_clock_fields() {
+  return coarse_clock_fields_;
+}
+
 inline std::shared_ptr<KVStore> Environment::env_vars() {
   return env_vars_;
 }
@@ -519,11 +544,27 @@ inline std::vector<double>* Environment::destroy_async_id_list() {
   return &destroy_async_id_list_;
 }
 
+inline std::vector<double>* Environment::promise_event_list() {
+  return &promise_event_list_;
+}
+
 inline double Environment::new_async_id() {
+  if (!recycled_async_ids_.empty()) {
+    const double async_id = recycled_async_ids_.back();
+    recycled_async_ids_.pop_back();
+    return async_id;
+  }
   async_hooks()->async_id_fields()[AsyncHooks::kAsyncIdCounter] += 1;
   return async_hooks()->async_id_fields()[AsyncHooks::kAsyncIdCounter];
 }
 
+inline void Environment::RecycleAsyncId(double async_id) {
+  if (!options_->recycle_async_ids) return;
+  if (async_id <= 0) return;
+  if (recycled_async_ids_.size() >= kMaxRecycledAsyncIds) return;
+  recycled_async_ids_.push_back(async_id);
+}
+
 inline double Environment::execution_async_id() {
   return async_hooks()->async_id_fields()[AsyncHooks::kExecutionAsyncId];
 }
@@ -628,6 +669,47 @@ Environment::file_handle_read_wrap_freelist() {
   return file_handle_read_wrap_freelist_;
 }
 
+inline std::vector<void*>& Environment::stream_req_storage_freelist() {
+  return stream_req_storage_freelist_;
+}
+
+inline std::vector<AllocatedBuffer>&
+Environment::stream_read_buffer_freelist() {
+  return stream_read_buffer_freelist_;
+}
+
+inline std::vector<PooledZlibState>& Environment::pooled_zlib_states() {
+  return pooled_zlib_states_;
+}
+
+inline uint32_t Environment::gc_pressure_level() const {
+  return gc_pressure_level_;
+}
+
+inline v8::Local<v8::String> Environment::interned_string(size_t index) {
+  v8::Eternal<v8::String>& slot = interned_strings_[index];
+  if (slot.IsEmpty()) {
+    size_t size;
+    const char* data = InternedStringSource(index, &size);
+    slot.Set(isolate(), OneByteString(isolate(), data, size));
+  }
+  return slot.Get(isolate());
+}
+
+inline void Environment::AdjustExternalMemory(int64_t delta) {
+  external_memory_delta_ += delta;
+  if (external_memory_delta_ >= kExternalMemoryFlushThreshold ||
+      external_memory_delta_ <= -kExternalMemoryFlushThreshold) {
+    FlushExternalMemory();
+  }
+}
+
+inline void Environment::FlushExternalMemory() {
+  if (external_memory_delta_ == 0) return;
+  isolate()->AdjustAmountOfExternalAllocatedMemory(external_memory_delta_);
+  external_memory_delta_ = 0;
+}
+
 inline std::shared_ptr<EnvironmentOptions> Environment::options() {
   return options_;
 }
@@ -733,6 +815,16 @@ inline uint64_t Environment::heap_prof_interval() const {
   return heap_prof_interval_;
 }
 
+inline void Environment::set_cpu_flight_recorder(
+    std::unique_ptr<profiler::CpuFlightRecorder> recorder) {
+  CHECK_NULL(cpu_flight_recorder_);
+  std::swap(cpu_flight_recorder_, recorder);
+}
+
+inline profiler::CpuFlightRecorder* Environment::cpu_flight_recorder() {
+  return cpu_flight_recorder_.get();
+}
+
 #endif  // HAVE_INSPECTOR
 
 inline std::shared_ptr<HostPort> Environment::inspector_host_port() {
@@ -749,23 +841,38 @@ inline void IsolateData::set_options(
 }
 
 template <typename Fn>
-void Environment::CreateImmediate(Fn&& cb, bool ref) {
+void Environment::CreateImmediate(Fn&& cb, bool ref, bool high_priority) {
   auto callback = std::make_unique<NativeImmediateCallbackImpl<Fn>>(
       std::move(cb), ref);
-  NativeImmediateCallback* prev_tail = native_immediate_callbacks_tail_;
-
-  native_immediate_callbacks_tail_ = callback.get();
+  std::unique_ptr<NativeImmediateCallback>& head =
+      high_priority ? native_immediates_high_head_
+                    : native_immediate_callbacks_head_;
+  NativeImmediateCallback*& tail =
+      high_priority ? native_immediates_high_tail_
+                    : native_immediate_callbacks_tail_;
+  NativeImmediateCallback* prev_tail = tail;
+
+  tail = callback.get();
   if (prev_tail != nullptr)
     prev_tail->set_next(std::move(callback));
   else
-    native_immediate_callbacks_head_ = std::move(callback);
+    head = std::move(callback);
 
   immediate_info()->count_inc(1);
 }
 
 template <typename Fn>
 void Environment::SetImmediate(Fn&& cb) {
-  CreateImmediate(std::move(cb), true);
+  CreateImmediate(std::move(cb), true, false);
+
+  if (immediate_info()->ref_count() == 0)
+    ToggleImmediateRef(true);
+  immediate_info()->ref_count_inc(1);
+}
+
+template <typename Fn>
+void Environment::SetHighPriorityImmediate(Fn&& cb) {
+  CreateImmediate(std::move(cb), true, true);
 
   if (immediate_info()->ref_count() == 0)
     ToggleImmediateRef(true);
@@ -774,7 +881,7 @@ void Environment::SetImmediate(Fn&& cb) {
 
 template <typename Fn>
 void Environment::SetUnrefImmediate(Fn&& cb) {
-  CreateImmediate(std::move(cb), false);
+  CreateImmediate(std::move(cb), false, false);
 }
 
 Environment::NativeImmediateCallback::NativeImmediateCallback(bool refed)
@@ -909,11 +1016,59 @@ inline void Environment::Free(char* data, size_t size) {
 }
 
 inline AllocatedBuffer Environment::AllocateManaged(size_t size, bool checked) {
+  if (UNLIKELY(allocation_sampling_enabled()))
+    RecordAllocationSample(size);
   char* data = checked ? Allocate(size) : AllocateUnchecked(size);
   if (data == nullptr) size = 0;
   return AllocatedBuffer(this, uv_buf_init(data, size));
 }
 
+inline Mutex& Environment::report_snapshot_mutex() {
+  return report_snapshot_mutex_;
+}
+
+inline std::string& Environment::report_uv_snapshot() {
+  return report_uv_snapshot_;
+}
+
+inline std::string& Environment::report_env_vars_snapshot() {
+  return report_env_vars_snapshot_;
+}
+
+inline uint64_t& Environment::report_snapshot_timestamp() {
+  return report_snapshot_timestamp_;
+}
+
+inline void Environment::StartAllocationSampling(uint32_t interval) {
+  CHECK_GT(interval, 0);
+  allocation_sample_interval_ = interval;
+  allocation_sample_counter_ = 0;
+  allocation_samples_.clear();
+}
+
+inline void Environment::StopAllocationSampling() {
+  allocation_sample_interval_ = 0;
+  allocation_samples_.clear();
+}
+
+inline bool Environment::allocation_sampling_enabled() const {
+  return allocation_sample_interval_ > 0;
+}
+
+inline void Environment::RecordAllocationSample(size_t size) {
+  allocation_sample_counter_ += 1;
+  if (allocation_sample_counter_ % allocation_sample_interval_ != 0)
+    return;
+  AllocationSample& sample = allocation_samples_[execution_async_id()];
+  sample.count += 1;
+  sample.bytes += size;
+}
+
+inline const std::unordered_map<double, Environment::AllocationSample>&
+Environment::allocation_samples() const {
+  return allocation_samples_;
+}
+
 inline AllocatedBuffer::AllocatedBuffer(Environment* env, uv_buf_t buf)
     : env_(env), buffer_(buf) {}
 
@@ -1,6 +1,8 @@
 #include "env.h"
 
 #include "async_wrap.h"
+#include "debug_utils.h"
+#include "histogram-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_context_data.h"
@@ -9,17 +11,26 @@
 #include "node_internals.h"
 #include "node_options-inl.h"
 #include "node_process.h"
+#ifdef NODE_REPORT
+#include "node_report.h"
+#endif
 #include "node_v8_platform-inl.h"
+#include "node_watchdog.h"
 #include "node_worker.h"
 #include "req_wrap-inl.h"
+#include "threadpoolwork-inl.h"
 #include "tracing/agent.h"
 #include "tracing/traced_value.h"
 #include "util-inl.h"
 #include "v8-profiler.h"
+#include "zlib.h"
 
 #include <algorithm>
 #include <atomic>
+#include <cinttypes>
 #include <cstdio>
+#include <limits>
+#include <map>
 #include <memory>
 
 namespace node {
@@ -32,7 +43,10 @@ using v8::EmbedderGraph;
 using v8::FinalizationGroup;
 using v8::Function;
 using v8::FunctionTemplate;
+using v8::GCCallbackFlags;
+using v8::GCType;
 using v8::HandleScope;
+using v8::HeapStatistics;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -299,12 +313,14 @@ Environment::Environment(IsolateData* isolate_data,
       isolate_data_(isolate_data),
       immediate_info_(context->GetIsolate()),
       tick_info_(context->GetIsolate()),
+      task_queue_stats_(context->GetIsolate()),
       timer_base_(uv_now(isolate_data->event_loop())),
       exec_argv_(exec_args),
       argv_(args),
       exec_path_(GetExecPath(args)),
       should_abort_on_uncaught_toggle_(isolate_, 1),
       stream_base_state_(isolate_, StreamBase::kNumStreamBaseStateFields),
+      coarse_clock_fields_(isolate_, kCoarseClockFieldsCount),
       flags_(flags),
       thread_id_(thread_id == kNoThreadId ? AllocateThreadId() : thread_id),
       fs_stats_field_array_(isolate_, kFsStatsBufferLength),
@@ -382,6 +398,11 @@ Environment::Environment(IsolateData* isolate_data,
     async_hooks_.no_force_checks();
   }
 
+  isolate()->AddGCPrologueCallback(GCPressurePrologueCallback, this);
+  isolate()->AddGCEpilogueCallback(GCPressureEpilogueCallback, this);
+  isolate()->AddNearHeapLimitCallback(NearHeapLimitEvictionCallback, this);
+  AddCacheEvictionCallback(EvictCoreCaches, this);
+
   // TODO(joyeecheung): deserialize when the snapshot covers the environment
   // properties.
   CreateProperties();
@@ -390,11 +411,28 @@ Environment::Environment(IsolateData* isolate_data,
 Environment::~Environment() {
   isolate()->GetHeapProfiler()->RemoveBuildEmbedderGraphCallback(
       BuildEmbedderGraph, this);
+  isolate()->RemoveGCPrologueCallback(GCPressurePrologueCallback, this);
+  isolate()->RemoveGCEpilogueCallback(GCPressureEpilogueCallback, this);
+  isolate()->RemoveNearHeapLimitCallback(NearHeapLimitEvictionCallback, 0);
+  FlushExternalMemory();
 
   // Make sure there are no re-used libuv wrapper objects.
   // CleanupHandles() should have removed all of them.
   CHECK(file_handle_read_wrap_freelist_.empty());
 
+  // Release recycled stream request storage. All StreamReq instances have
+  // been destroyed by now; only raw storage blocks remain in the freelist.
+  for (void* storage : stream_req_storage_freelist_)
+    free(storage);
+
+  // Release recycled stream read buffers while the isolate is still fully
+  // alive.
+  stream_read_buffer_freelist_.clear();
+
+  // Dispose of zlib streams parked for reuse; their allocation functions no
+  // longer refer to the streams that released them.
+  DiscardPooledZlibStates();
+
   HandleScope handle_scope(isolate());
 
 #if HAVE_INSPECTOR
@@ -433,6 +471,152 @@ Environment::~Environment() {
   CHECK_EQ(base_object_count(), 0);
 }
 
+namespace {
+
+// Derive a pressure level from how close the heap is to its limit. Called
+// from GC callbacks, where querying heap statistics is explicitly allowed.
+uint32_t ComputeGCPressure(Isolate* isolate) {
+  HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+  const double fraction = static_cast<double>(stats.used_heap_size()) /
+                          static_cast<double>(stats.heap_size_limit());
+  if (fraction >= 0.9) return Environment::kGCPressureCritical;
+  if (fraction >= 0.75) return Environment::kGCPressureModerate;
+  return Environment::kGCPressureNone;
+}
+
+}  // anonymous namespace
+
+void Environment::GCPressurePrologueCallback(Isolate* isolate,
+                                             GCType type,
+                                             GCCallbackFlags flags,
+                                             void* data) {
+  if (type != v8::kGCTypeIncrementalMarking) return;
+  Environment* env = static_cast<Environment*>(data);
+  // Incremental marking starting means the collector already considers the
+  // heap full enough to be worth a major GC; report at least moderate
+  // pressure for the duration of the cycle.
+  env->gc_pressure_level_ =
+      std::max(ComputeGCPressure(isolate),
+               static_cast<uint32_t>(kGCPressureModerate));
+}
+
+void Environment::GCPressureEpilogueCallback(Isolate* isolate,
+                                             GCType type,
+                                             GCCallbackFlags flags,
+                                             void* data) {
+  if (type != v8::kGCTypeMarkSweepCompact) return;
+  Environment* env = static_cast<Environment*>(data);
+  const uint32_t previous_level = env->gc_pressure_level_;
+  env->gc_pressure_level_ = ComputeGCPressure(isolate);
+  if (env->gc_pressure_level_ > previous_level)
+    env->ScheduleCacheEviction(env->gc_pressure_level_);
+  if (env->gc_pressure_level_ < kGCPressureCritical)
+    env->RunGCPressureRelievedCallbacks();
+}
+
+void Environment::OnGCPressureRelieved(std::function<void()> cb) {
+  gc_pressure_relieved_callbacks_.emplace_back(std::move(cb));
+}
+
+void Environment::RunGCPressureRelievedCallbacks() {
+  if (gc_pressure_relieved_callbacks_.empty()) return;
+  std::vector<std::function<void()>> callbacks;
+  callbacks.swap(gc_pressure_relieved_callbacks_);
+  // Defer to the event loop; GC callbacks must not re-enter V8.
+  SetImmediate([callbacks = std::move(callbacks)](Environment* env) {
+    for (const auto& cb : callbacks) cb();
+  });
+}
+
+void Environment::AddCacheEvictionCallback(CacheEvictionCallback cb,
+                                           void* data) {
+  cache_eviction_callbacks_.push_back({cb, data});
+}
+
+void Environment::RemoveCacheEvictionCallback(CacheEvictionCallback cb,
+                                              void* data) {
+  for (auto it = cache_eviction_callbacks_.begin();
+       it != cache_eviction_callbacks_.end();
+       ++it) {
+    if (it->cb == cb && it->data == data) {
+      cache_eviction_callbacks_.erase(it);
+      return;
+    }
+  }
+}
+
+// Last-resort tier: V8 is about to fail an allocation because the heap
+// limit is reached. Evicting native caches cannot move the limit, but it
+// releases memory the next GC can no longer need to compete with; the
+// limit itself is left untouched.
+size_t Environment::NearHeapLimitEvictionCallback(void* data,
+                                                  size_t current_heap_limit,
+                                                  size_t initial_heap_limit) {
+  Environment* env = static_cast<Environment*>(data);
+  env->gc_pressure_level_ = kGCPressureCritical;
+  env->ScheduleCacheEviction(kGCPressureCritical);
+  return current_heap_limit;
+}
+
+void Environment::ScheduleCacheEviction(uint32_t level) {
+  // Defer to the event loop; this may be called from inside the GC, where
+  // re-entering V8 (or running arbitrary native code) is not allowed.
+  if (cache_eviction_scheduled_) return;
+  cache_eviction_scheduled_ = true;
+  SetImmediate([level](Environment* env) {
+    env->cache_eviction_scheduled_ = false;
+    env->RunCacheEvictionCallbacks(level);
+  });
+}
+
+void Environment::RunCacheEvictionCallbacks(uint32_t level) {
+  for (const CacheEvictionEntry& entry : cache_eviction_callbacks_)
+    entry.cb(entry.data, level);
+
+  HandleScope handle_scope(isolate());
+  Context::Scope context_scope(context());
+  Local<Function> cb = memory_pressure_callback();
+  if (cb.IsEmpty() || !can_call_into_js()) return;
+  Local<Value> arg = Integer::NewFromUnsigned(isolate(), level);
+  v8::TryCatch try_catch(isolate());
+  USE(cb->Call(context(), Undefined(isolate()), 1, &arg));
+  if (try_catch.HasCaught() && !try_catch.HasTerminated())
+    errors::TriggerUncaughtException(isolate(), try_catch);
+}
+
+// Eviction handler for the caches the Environment itself owns. Recycled
+// buffer pools and parked zlib states are cheap to refill and are dropped at
+// any level; interned strings are only worth dropping when the heap is
+// critically full.
+void Environment::EvictCoreCaches(void* data, uint32_t level) {
+  Environment* env = static_cast<Environment*>(data);
+  for (void* storage : env->stream_req_storage_freelist_)
+    free(storage);
+  env->stream_req_storage_freelist_.clear();
+  env->stream_read_buffer_freelist_.clear();
+  if (NodeArrayBufferAllocator* allocator =
+          env->isolate_data()->node_allocator()) {
+    allocator->ReleasePooledMemory();
+  }
+  env->DiscardPooledZlibStates();
+  if (level >= kGCPressureCritical) {
+    env->http_header_intern_lru_.clear();
+    env->http_header_intern_map_.clear();
+  }
+}
+
+void Environment::DiscardPooledZlibStates() {
+  for (PooledZlibState& state : pooled_zlib_states_) {
+    if (state.is_deflate)
+      deflateEnd(state.stream);
+    else
+      inflateEnd(state.stream);
+    delete state.stream;
+  }
+  pooled_zlib_states_.clear();
+}
+
 void Environment::InitializeLibuv(bool start_profiler_idle_notifier) {
   HandleScope handle_scope(isolate());
   Context::Scope context_scope(context());
@@ -458,6 +642,72 @@ void Environment::InitializeLibuv(bool start_profiler_idle_notifier) {
   // will be recorded with state=IDLE.
   uv_prepare_init(event_loop(), &idle_prepare_handle_);
   uv_check_init(event_loop(), &idle_check_handle_);
+
+  // Always-on per-phase loop timing: the prepare handle runs right before
+  // the loop blocks in the poll phase and the check handle right after, so
+  // the delta covers poll wait plus I/O callbacks. The counters end up in
+  // performance_state and are exposed via perf_hooks; a pair of uv_hrtime()
+  // calls per loop turn is cheap enough to leave enabled in production.
+  uv_prepare_init(event_loop(), &loop_phase_prepare_handle_);
+  uv_check_init(event_loop(), &loop_phase_check_handle_);
+  loop_latency_histogram_ = std::make_unique<Histogram>(1, 3.6e12);
+  uv_prepare_start(&loop_phase_prepare_handle_, [](uv_prepare_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::loop_phase_prepare_handle_, handle);
+    env->loop_poll_start_time_ = uv_hrtime();
+    // The span from leaving the poll phase to re-entering it is the time
+    // this turn's callbacks kept the loop busy; feed it to the always-on
+    // latency histogram.
+    if (env->loop_turn_start_time_ != 0) {
+      env->loop_latency_histogram_->Record(
+          env->loop_poll_start_time_ - env->loop_turn_start_time_);
+    }
+    if (env->loop_stall_watchdog_)
+      env->loop_stall_watchdog_->Heartbeat(true /* entering poll */);
+    // Forward any batched external memory delta before the loop blocks, so
+    // V8 sees an up-to-date figure at least once per turn.
+    env->FlushExternalMemory();
+#ifdef NODE_REPORT
+    // Refresh the cached diagnostic report sections at most once per
+    // second, right before the loop goes to sleep. This keeps the capture
+    // phase of an on-demand report short; see report::UpdateReportSnapshots.
+    if (env->loop_poll_start_time_ - env->report_snapshot_timestamp() >
+        1000000000) {
+      report::UpdateReportSnapshots(env);
+    }
+#endif  // NODE_REPORT
+  });
+  uv_check_start(&loop_phase_check_handle_, [](uv_check_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::loop_phase_check_handle_, handle);
+    if (env->loop_poll_start_time_ != 0) {
+      env->performance_state()->AddLoopPhaseTime(
+          performance::NODE_PERFORMANCE_LOOP_PHASE_POLL,
+          uv_hrtime() - env->loop_poll_start_time_);
+    }
+    env->loop_turn_start_time_ = uv_hrtime();
+    env->performance_state()->IncrementLoopIterations();
+    if (env->loop_stall_watchdog_)
+      env->loop_stall_watchdog_->Heartbeat(false /* left poll */);
+    // One real clock read per turn, taken right after poll so it is fresh
+    // for the I/O callbacks that do the bulk of the stamping.
+    env->UpdateCoarseClock();
+  });
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_phase_prepare_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_phase_check_handle_));
+
+  // Seed the cached coarse clock so readers see sane values before the
+  // first loop turn refreshes it.
+  UpdateCoarseClock();
+
+  if (options_->loop_stall_threshold > 0) {
+    loop_stall_watchdog_ = std::make_unique<LoopStallWatchdog>(
+        this, options_->loop_stall_threshold);
+  }
+
+  uv_idle_init(event_loop(), &busy_poll_idle_handle_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&busy_poll_idle_handle_));
+
   uv_async_init(
       event_loop(),
       &cleanup_finalization_groups_async_,
@@ -531,6 +781,18 @@ void Environment::RegisterHandleCleanups() {
       reinterpret_cast<uv_handle_t*>(&idle_check_handle_),
       close_and_finish,
       nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_phase_prepare_handle_),
+      close_and_finish,
+      nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_phase_check_handle_),
+      close_and_finish,
+      nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&busy_poll_idle_handle_),
+      close_and_finish,
+      nullptr);
   RegisterHandleCleanup(
       reinterpret_cast<uv_handle_t*>(&cleanup_finalization_groups_async_),
       close_and_finish,
@@ -601,8 +863,26 @@ void Environment::RunCleanup() {
   started_cleanup_ = true;
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunCleanup", this);
+  // Stop the stall watchdog first so it no longer requests interrupts while
+  // the loop winds down; a request already in flight sees a null watchdog.
+  loop_stall_watchdog_.reset();
   thread_stopper()->Uninstall();
+
+  // With NODE_DEBUG_NATIVE=CLEANUP, aggregate per-subsystem teardown timing
+  // so that slow exits can be attributed. Hooks belonging to a BaseObject are
+  // keyed by the object's type; plain native hooks are lumped together since
+  // only their function pointer would distinguish them.
+  struct HookTiming {
+    uint64_t time = 0;
+    uint64_t count = 0;
+  };
+  std::map<std::string, HookTiming> timings;
+  uint64_t handles_time = 0;
+  const bool profile_cleanup = debug_enabled(DebugCategory::CLEANUP);
+
+  uint64_t start = profile_cleanup ? uv_hrtime() : 0;
   CleanupHandles();
+  if (profile_cleanup) handles_time += uv_hrtime() - start;
 
   while (!cleanup_hooks_.empty()) {
     // Copy into a vector, since we can't sort an unordered_set in-place.
@@ -625,10 +905,43 @@ void Environment::RunCleanup() {
         continue;
       }
 
-      cb.fn_(cb.arg_);
+      if (profile_cleanup) {
+        // Read the name before running the hook; it usually deletes the
+        // object.
+        BaseObject* obj = cb.GetBaseObject();
+        std::string name =
+            obj != nullptr ? obj->MemoryInfoName() : "(native hooks)";
+        start = uv_hrtime();
+        cb.fn_(cb.arg_);
+        HookTiming& timing = timings[name];
+        timing.time += uv_hrtime() - start;
+        timing.count++;
+      } else {
+        cb.fn_(cb.arg_);
+      }
       cleanup_hooks_.erase(cb);
     }
+    start = profile_cleanup ? uv_hrtime() : 0;
     CleanupHandles();
+    if (profile_cleanup) handles_time += uv_hrtime() - start;
+  }
+
+  if (profile_cleanup) {
+    std::vector<std::pair<std::string, HookTiming>> sorted(timings.begin(),
+                                                           timings.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+      return a.second.time > b.second.time;
+    });
+    uint64_t total = handles_time;
+    for (const auto& entry : sorted) total += entry.second.time;
+    Debug(this, DebugCategory::CLEANUP,
+          "cleanup: total %.3f ms (%.3f ms waiting on handle closes)\n",
+          total / 1e6, handles_time / 1e6);
+    for (const auto& entry : sorted) {
+      Debug(this, DebugCategory::CLEANUP,
+            "cleanup: %-32s %6" PRIu64 " hooks %10.3f ms\n",
+            entry.first.c_str(), entry.second.count, entry.second.time / 1e6);
+    }
   }
 }
 
@@ -658,18 +971,108 @@ void Environment::AtExit(void (*cb)(void* arg), void* arg) {
   at_exit_functions_.push_front(ExitCallback{cb, arg});
 }
 
+bool Environment::TryAcquireCpuWorkSlot(ThreadPoolWork* work) {
+  const uint64_t limit = options_->threadpool_cpu_limit;
+  if (limit == 0 || active_cpu_work_count_ < limit) {
+    active_cpu_work_count_++;
+    return true;
+  }
+  queued_cpu_work_.push_back(work);
+  return false;
+}
+
+void Environment::ReleaseCpuWorkSlot() {
+  CHECK_GT(active_cpu_work_count_, 0u);
+  active_cpu_work_count_--;
+  if (queued_cpu_work_.empty()) return;
+  ThreadPoolWork* next = queued_cpu_work_.front();
+  queued_cpu_work_.pop_front();
+  active_cpu_work_count_++;
+  next->lane_queued_ = false;
+  next->SubmitToPool();
+}
+
+void Environment::CancelQueuedCpuWork(ThreadPoolWork* work) {
+  auto it = std::find(queued_cpu_work_.begin(), queued_cpu_work_.end(), work);
+  CHECK(it != queued_cpu_work_.end());
+  queued_cpu_work_.erase(it);
+}
+
+void Environment::RegisterBusyPollStream() {
+  busy_poll_stream_count_++;
+  NoteBusyPollActivity();
+}
+
+void Environment::UnregisterBusyPollStream() {
+  CHECK_GT(busy_poll_stream_count_, 0);
+  if (--busy_poll_stream_count_ == 0 && busy_poll_spinning_) {
+    uv_idle_stop(&busy_poll_idle_handle_);
+    busy_poll_spinning_ = false;
+  }
+}
+
+void Environment::NoteBusyPollActivity() {
+  const uint64_t window = options_->busy_poll_window;
+  if (window == 0 || busy_poll_stream_count_ == 0 || started_cleanup_)
+    return;
+
+  busy_poll_spin_deadline_ = uv_hrtime() + window * 1000;
+  if (busy_poll_spinning_)
+    return;
+  busy_poll_spinning_ = true;
+
+  // While this idle handle is active, libuv polls with a zero timeout every
+  // iteration, so ready sockets are serviced without the epoll_wait()
+  // sleep/wakeup cost. The spin stops once the window elapses with no fresh
+  // activity and resumes on the next read from a registered stream.
+  uv_idle_start(&busy_poll_idle_handle_, [](uv_idle_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::busy_poll_idle_handle_, handle);
+    if (uv_hrtime() >= env->busy_poll_spin_deadline_) {
+      uv_idle_stop(handle);
+      env->busy_poll_spinning_ = false;
+    }
+  });
+}
+
+void Environment::SetCpuBudget(uint64_t budget_ns, uint64_t interval_ns) {
+  cpu_budget_ns_ = budget_ns;
+  cpu_budget_interval_ns_ = interval_ns;
+  cpu_interval_start_ns_ = uv_hrtime();
+  cpu_used_in_interval_ns_ = 0;
+}
+
+void Environment::ChargeCpuTime(uint64_t delta_ns) {
+  cpu_time_ns_ += delta_ns;
+  cpu_used_in_interval_ns_ += delta_ns;
+}
+
+bool Environment::CpuBudgetExceeded() {
+  if (!cpu_budget_enabled())
+    return false;
+  const uint64_t now = uv_hrtime();
+  if (now - cpu_interval_start_ns_ >= cpu_budget_interval_ns_) {
+    // Refill. Intervals are aligned to the first query after expiry rather
+    // than to a timer, so an idle Environment costs nothing.
+    cpu_interval_start_ns_ = now;
+    cpu_used_in_interval_ns_ = 0;
+    return false;
+  }
+  return cpu_used_in_interval_ns_ >= cpu_budget_ns_;
+}
+
 void Environment::RunAndClearNativeImmediates(bool only_refed) {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunAndClearNativeImmediates", this);
   size_t ref_count = 0;
   size_t count = 0;
+  size_t budget = 0;
   std::unique_ptr<NativeImmediateCallback> head;
-  head.swap(native_immediate_callbacks_head_);
-  native_immediate_callbacks_tail_ = nullptr;
 
   auto drain_list = [&]() {
     TryCatchScope try_catch(this);
-    for (; head; head = head->get_next()) {
+    for (; head && budget > 0; head = head->get_next()) {
+      budget--;
       DebugSealHandleScope seal_handle_scope(isolate());
       count++;
       if (head->is_refed())
@@ -690,8 +1093,38 @@ void Environment::RunAndClearNativeImmediates(bool only_refed) {
     }
     return false;
   };
+
+  // The high-priority lane always drains completely, so that close callbacks
+  // and error propagation never wait behind bulk work in the normal lane.
+  head.swap(native_immediates_high_head_);
+  native_immediates_high_tail_ = nullptr;
+  budget = std::numeric_limits<size_t>::max();
   while (head && drain_list()) {}
 
+  // The normal lane runs at most kNativeImmediateMaxBatch callbacks per loop
+  // turn, except during cleanup (only_refed) where everything must drain.
+  head.swap(native_immediate_callbacks_head_);
+  NativeImmediateCallback* snapshot_tail = native_immediate_callbacks_tail_;
+  native_immediate_callbacks_tail_ = nullptr;
+  // An Environment that has used up its CPU allowance still makes progress,
+  // but in much smaller slices, so that co-tenant Environments on the same
+  // loop get their handles serviced in between.
+  budget = only_refed ? std::numeric_limits<size_t>::max()
+                      : (CpuBudgetExceeded() ? kNativeImmediateThrottledBatch
+                                             : kNativeImmediateMaxBatch);
+  while (head && budget > 0 && drain_list()) {}
+
+  if (head) {
+    // The batch limit was hit; put the remainder back at the front of the
+    // queue, ahead of anything that was enqueued while it was being drained.
+    // immediate_info()->count() stays positive, so the check handle will run
+    // this method again on the next loop turn.
+    snapshot_tail->set_next(std::move(native_immediate_callbacks_head_));
+    if (native_immediate_callbacks_tail_ == nullptr)
+      native_immediate_callbacks_tail_ = snapshot_tail;
+    native_immediate_callbacks_head_ = std::move(head);
+  }
+
   DCHECK_GE(immediate_info()->count(), count);
   immediate_info()->count_dec(count);
   immediate_info()->ref_count_dec(ref_count);
@@ -718,6 +1151,13 @@ void Environment::RunTimers(uv_timer_t* handle) {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunTimers", env);
 
+  const uint64_t start_time = uv_hrtime();
+  auto timing_scope = OnScopeLeave([&]() {
+    env->performance_state()->AddLoopPhaseTime(
+        performance::NODE_PERFORMANCE_LOOP_PHASE_TIMERS,
+        uv_hrtime() - start_time);
+  });
+
   if (!env->can_call_into_js())
     return;
 
@@ -780,6 +1220,13 @@ void Environment::CheckImmediate(uv_check_t* handle) {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
+  const uint64_t start_time = uv_hrtime();
+  auto timing_scope = OnScopeLeave([&]() {
+    env->performance_state()->AddLoopPhaseTime(
+        performance::NODE_PERFORMANCE_LOOP_PHASE_CHECK,
+        uv_hrtime() - start_time);
+  });
+
   if (env->immediate_info()->count() == 0)
     return;
 
@@ -816,6 +1263,20 @@ void Environment::ToggleImmediateRef(bool ref) {
 }
 
 
+// Refreshes the per-turn cached clock: one uv_gettimeofday() per loop turn
+// instead of one clock call per Date.now()-style stamp. The loop-time field
+// deliberately reads the already-cached uv_now() rather than updating it;
+// consumers of the coarse clock accept a loop turn of slack by definition.
+void Environment::UpdateCoarseClock() {
+  uv_timeval64_t tv;
+  if (uv_gettimeofday(&tv) == 0) {
+    coarse_clock_fields_[kCoarseClockDateNow] =
+        static_cast<double>(tv.tv_sec) * 1000.0 + tv.tv_usec / 1000.0;
+  }
+  coarse_clock_fields_[kCoarseClockLibuvNow] =
+      static_cast<double>(uv_now(event_loop()) - timer_base_);
+}
+
 Local<Value> Environment::GetNow() {
   uv_update_time(event_loop());
   uint64_t now = uv_now(event_loop());
@@ -827,6 +1288,40 @@ Local<Value> Environment::GetNow() {
     return Number::New(isolate(), static_cast<double>(now));
 }
 
+Local<String> Environment::InternHTTPHeaderString(const char* data,
+                                                  size_t size) {
+  if (size == 0 || size > kHTTPHeaderInternMaxLength)
+    return OneByteString(isolate(), data, size);
+
+  // Known-hot vocabulary (common header names and values) resolves through
+  // the static perfect-hash corpus in one probe, bypassing the LRU.
+  const size_t interned = FindInternedStringIndex(data, size);
+  if (interned != kInternedStringNotFound)
+    return interned_string(interned);
+
+  std::string key(data, size);
+  auto it = http_header_intern_map_.find(key);
+  if (it != http_header_intern_map_.end()) {
+    auto entry = it->second;
+    http_header_intern_lru_.splice(
+        http_header_intern_lru_.begin(), http_header_intern_lru_, entry);
+    return entry->second.Get(isolate());
+  }
+
+  Local<String> str = OneByteString(isolate(), data, size);
+  http_header_intern_lru_.emplace_front(
+      std::move(key), v8::Global<v8::String>(isolate(), str));
+  http_header_intern_map_.emplace(http_header_intern_lru_.front().first,
+                                  http_header_intern_lru_.begin());
+
+  if (http_header_intern_lru_.size() > kHTTPHeaderInternCapacity) {
+    http_header_intern_map_.erase(http_header_intern_lru_.back().first);
+    http_header_intern_lru_.pop_back();
+  }
+
+  return str;
+}
+
 void Environment::set_debug_categories(const std::string& cats, bool enabled) {
   std::string debug_categories = cats;
   while (!debug_categories.empty()) {
@@ -918,6 +1413,10 @@ void TickInfo::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("fields", fields_);
 }
 
+void TaskQueueStats::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("fields", fields_);
+}
+
 void AsyncHooks::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("providers", providers_);
   tracker->TrackField("async_ids_stack", async_ids_stack_);
@@ -1014,6 +1513,7 @@ inline size_t Environment::SelfSize() const {
   size -= sizeof(thread_stopper_);
   size -= sizeof(async_hooks_);
   size -= sizeof(tick_info_);
+  size -= sizeof(task_queue_stats_);
   size -= sizeof(immediate_info_);
   return size;
 }
@@ -1038,6 +1538,7 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("async_hooks", async_hooks_);
   tracker->TrackField("immediate_info", immediate_info_);
   tracker->TrackField("tick_info", tick_info_);
+  tracker->TrackField("task_queue_stats", task_queue_stats_);
 
 #define V(PropertyName, TypeName)                                              \
   tracker->TrackField(#PropertyName, PropertyName());
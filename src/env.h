@@ -33,6 +33,7 @@
 #include "node.h"
 #include "node_binding.h"
 #include "node_http2_state.h"
+#include "node_interned_strings.h"
 #include "node_main_instance.h"
 #include "node_options.h"
 #include "req_wrap.h"
@@ -50,6 +51,7 @@
 #include <vector>
 
 struct nghttp2_rcbuf;
+struct z_stream_s;
 
 namespace node {
 
@@ -72,6 +74,7 @@ class AgentWriterHandle;
 
 #if HAVE_INSPECTOR
 namespace profiler {
+class CpuFlightRecorder;
 class V8CoverageConnection;
 class V8CpuProfilerConnection;
 class V8HeapProfilerConnection;
@@ -291,8 +294,10 @@ constexpr size_t kFsStatsBufferLength =
   V(oncomplete_string, "oncomplete")                                           \
   V(onconnection_string, "onconnection")                                       \
   V(ondone_string, "ondone")                                                   \
+  V(onearlydata_string, "onearlydata")                                         \
   V(onerror_string, "onerror")                                                 \
   V(onexit_string, "onexit")                                                   \
+  V(onexpired_string, "onexpired")                                             \
   V(onhandshakedone_string, "onhandshakedone")                                 \
   V(onhandshakestart_string, "onhandshakestart")                               \
   V(onkeylog_string, "onkeylog")                                               \
@@ -304,6 +309,7 @@ constexpr size_t kFsStatsBufferLength =
   V(onshutdown_string, "onshutdown")                                           \
   V(onsignal_string, "onsignal")                                               \
   V(onunpipe_string, "onunpipe")                                               \
+  V(onwakeup_string, "onwakeup")                                               \
   V(onwrite_string, "onwrite")                                                 \
   V(openssl_error_stack, "opensslErrorStack")                                  \
   V(options_string, "options")                                                 \
@@ -352,6 +358,7 @@ constexpr size_t kFsStatsBufferLength =
   V(sni_context_err_string, "Invalid SNI context")                             \
   V(sni_context_string, "sni_context")                                         \
   V(source_string, "source")                                                   \
+  V(spawn_template_string, "spawnTemplate")                                    \
   V(stack_string, "stack")                                                     \
   V(standard_name_string, "standardName")                                      \
   V(start_time_string, "startTime")                                            \
@@ -392,7 +399,9 @@ constexpr size_t kFsStatsBufferLength =
   V(async_wrap_ctor_template, v8::FunctionTemplate)                            \
   V(async_wrap_object_ctor_template, v8::FunctionTemplate)                     \
   V(compiled_fn_entry_template, v8::ObjectTemplate)                            \
+  V(contextify_global_template, v8::ObjectTemplate)                            \
   V(dir_instance_template, v8::ObjectTemplate)                                 \
+  V(dir_walker_instance_template, v8::ObjectTemplate)                          \
   V(fd_constructor_template, v8::ObjectTemplate)                               \
   V(fdclose_constructor_template, v8::ObjectTemplate)                          \
   V(filehandlereadwrap_template, v8::ObjectTemplate)                           \
@@ -401,6 +410,7 @@ constexpr size_t kFsStatsBufferLength =
   V(http2settings_constructor_template, v8::ObjectTemplate)                    \
   V(http2stream_constructor_template, v8::ObjectTemplate)                      \
   V(http2ping_constructor_template, v8::ObjectTemplate)                        \
+  V(lazy_clone_handle_template, v8::ObjectTemplate)                            \
   V(libuv_stream_wrap_ctor_template, v8::FunctionTemplate)                     \
   V(message_event_object_template, v8::ObjectTemplate)                         \
   V(message_port_constructor_template, v8::FunctionTemplate)                   \
@@ -413,16 +423,19 @@ constexpr size_t kFsStatsBufferLength =
   V(streambaseoutputstream_constructor_template, v8::ObjectTemplate)           \
   V(tcp_constructor_template, v8::FunctionTemplate)                            \
   V(tty_constructor_template, v8::FunctionTemplate)                            \
-  V(write_wrap_template, v8::ObjectTemplate)
+  V(write_wrap_template, v8::ObjectTemplate)                                   \
+  V(zlib_oneshot_job_template, v8::ObjectTemplate)
 
 #define ENVIRONMENT_STRONG_PERSISTENT_VALUES(V)                                \
   V(as_callback_data, v8::Object)                                              \
+  V(async_context_frame, v8::Value)                                            \
   V(async_hooks_after_function, v8::Function)                                  \
   V(async_hooks_before_function, v8::Function)                                 \
   V(async_hooks_binding, v8::Object)                                           \
   V(async_hooks_destroy_function, v8::Function)                                \
   V(async_hooks_init_function, v8::Function)                                   \
   V(async_hooks_promise_resolve_function, v8::Function)                        \
+  V(async_hooks_promise_events_function, v8::Function)                         \
   V(buffer_prototype_object, v8::Object)                                       \
   V(crypto_key_object_constructor, v8::Function)                               \
   V(domain_callback, v8::Function)                                             \
@@ -446,6 +459,7 @@ constexpr size_t kFsStatsBufferLength =
   V(internal_binding_loader, v8::Function)                                     \
   V(immediate_callback_function, v8::Function)                                 \
   V(inspector_console_extension_installer, v8::Function)                       \
+  V(memory_pressure_callback, v8::Function)                                    \
   V(message_port, v8::Object)                                                  \
   V(native_module_require, v8::Function)                                       \
   V(performance_entry_callback, v8::Function)                                  \
@@ -454,7 +468,7 @@ constexpr size_t kFsStatsBufferLength =
   V(process_object, v8::Object)                                                \
   V(primordials, v8::Object)                                                   \
   V(promise_reject_callback, v8::Function)                                     \
-  V(script_data_constructor_function, v8::Function)                            \
+  V(serialized_options, v8::Object)                                            \
   V(source_map_cache_getter, v8::Function)                                     \
   V(tick_callback_function, v8::Function)                                      \
   V(timers_callback_function, v8::Function)                                    \
@@ -464,6 +478,9 @@ constexpr size_t kFsStatsBufferLength =
   V(url_constructor_function, v8::Function)
 
 class Environment;
+class Histogram;
+class LoopStallWatchdog;
+class ThreadPoolWork;
 
 class IsolateData : public MemoryRetainer {
  public:
@@ -543,6 +560,7 @@ struct ContextInfo {
 // from a provider type to a debug category.
 #define DEBUG_CATEGORY_NAMES(V)                                                \
   NODE_ASYNC_PROVIDER_TYPES(V)                                                 \
+  V(CLEANUP)                                                                   \
   V(INSPECTOR_SERVER)                                                          \
   V(INSPECTOR_PROFILER)                                                        \
   V(WASI)
@@ -554,6 +572,21 @@ enum class DebugCategory {
   CATEGORY_COUNT
 };
 
+// An initialized zlib stream parked for reuse by a later compression stream
+// with the same parameters; see ZlibContext in node_zlib.cc. The z_stream is
+// heap-allocated because zlib keeps an internal back-pointer to its address,
+// and its allocation functions have been detached from the releasing stream
+// so that the state can be disposed of independently.
+struct PooledZlibState {
+  z_stream_s* stream = nullptr;  // Owned.
+  bool is_deflate = false;       // Selects deflateEnd() vs. inflateEnd().
+  int level = 0;
+  int window_bits = 0;           // Effective value passed to *Init2().
+  int mem_level = 0;
+  int strategy = 0;
+  size_t memory = 0;             // zlib allocation bytes held by the state.
+};
+
 // A unique-pointer-ish object that is compatible with the JS engine's
 // ArrayBuffer::Allocator.
 struct AllocatedBuffer {
@@ -636,6 +669,10 @@ class KVStore {
   virtual std::shared_ptr<KVStore> Clone(v8::Isolate* isolate) const;
   virtual v8::Maybe<bool> AssignFromObject(v8::Local<v8::Context> context,
                                            v8::Local<v8::Object> entries);
+  // Discard any cached view of the underlying store. Only meaningful for
+  // stores that cache, e.g. when an embedder or native addon mutates the
+  // real environment behind the process's back.
+  virtual void Resync() {}
 
   static std::shared_ptr<KVStore> CreateMapKVStore();
 };
@@ -661,6 +698,8 @@ class AsyncHooks : public MemoryRetainer {
     kTotals,
     kCheck,
     kStackLength,
+    kSampleInterval,
+    kUnsampledEvents,
     kFieldsCount,
   };
 
@@ -685,6 +724,15 @@ class AsyncHooks : public MemoryRetainer {
   inline bool pop_async_id(double async_id);
   inline void clear_async_id_stack();  // Used in fatal exceptions.
 
+  // Whether the resource with the given async id receives full JS hook
+  // treatment. With kSampleInterval <= 1 every resource does; otherwise
+  // only one resource in kSampleInterval, selected deterministically by
+  // async id so that C++ and JS emitters always agree and a resource
+  // either gets its complete init/before/after/destroy sequence or none
+  // of it. Unsampled events are counted in kUnsampledEvents instead.
+  // Keep in sync with isSampledAsyncId() in lib/internal/async_hooks.js.
+  inline bool sampled(double async_id);
+
   AsyncHooks(const AsyncHooks&) = delete;
   AsyncHooks& operator=(const AsyncHooks&) = delete;
   AsyncHooks(AsyncHooks&&) = delete;
@@ -784,6 +832,41 @@ class TickInfo : public MemoryRetainer {
   AliasedUint8Array fields_;
 };
 
+// Counters describing the process.nextTick() queue and microtask draining,
+// kept in an aliased buffer so that both the JS tick machinery and
+// node_task_queue.cc can update them and monitoring code can read them
+// without any callback overhead.
+class TaskQueueStats : public MemoryRetainer {
+ public:
+  inline AliasedFloat64Array& fields();
+
+  SET_MEMORY_INFO_NAME(TaskQueueStats)
+  SET_SELF_SIZE(TaskQueueStats)
+  void MemoryInfo(MemoryTracker* tracker) const override;
+
+  TaskQueueStats(const TaskQueueStats&) = delete;
+  TaskQueueStats& operator=(const TaskQueueStats&) = delete;
+  TaskQueueStats(TaskQueueStats&&) = delete;
+  TaskQueueStats& operator=(TaskQueueStats&&) = delete;
+  ~TaskQueueStats() = default;
+
+  enum Fields {
+    kTicksEnqueued = 0,
+    kTicksDrained,
+    // Largest number of queued ticks observed within a single drain run.
+    kMaxTickDepth,
+    // Cumulative time spent draining the microtask queue, in milliseconds.
+    kMicrotaskDrainTime,
+    kFieldsCount
+  };
+
+ private:
+  friend class Environment;  // So we can call the constructor.
+  inline explicit TaskQueueStats(v8::Isolate* isolate);
+
+  AliasedFloat64Array fields_;
+};
+
 class TrackingTraceStateObserver :
     public v8::TracingController::TraceStateObserver {
  public:
@@ -960,10 +1043,29 @@ class Environment : public MemoryRetainer {
   inline void IncreaseWaitingRequestCounter();
   inline void DecreaseWaitingRequestCounter();
 
+  // Scheduling support for CPU-class ThreadPoolWork under
+  // --threadpool-cpu-limit; see threadpoolwork-inl.h. Only to be called from
+  // the event loop thread.
+  bool TryAcquireCpuWorkSlot(ThreadPoolWork* work);
+  void ReleaseCpuWorkSlot();
+  void CancelQueuedCpuWork(ThreadPoolWork* work);
+
   inline AsyncHooks* async_hooks();
   inline ImmediateInfo* immediate_info();
   inline TickInfo* tick_info();
+  inline TaskQueueStats* task_queue_stats();
   inline uint64_t timer_base() const;
+
+  // Cached coarse clock, refreshed once per loop turn right after the poll
+  // phase (see UpdateCoarseClock()). Readers trade up to a loop turn of
+  // slack for not paying a clock call per stamp.
+  enum CoarseClockFields {
+    kCoarseClockDateNow,   // Wall clock in Date.now() units (ms since epoch).
+    kCoarseClockLibuvNow,  // Loop clock in getLibuvNow() units.
+    kCoarseClockFieldsCount
+  };
+  inline AliasedFloat64Array& coarse_clock_fields();
+  void UpdateCoarseClock();
   inline std::shared_ptr<KVStore> env_vars();
   inline void set_env_vars(std::shared_ptr<KVStore> env_vars);
 
@@ -1004,9 +1106,23 @@ class Environment : public MemoryRetainer {
   // List of id's that have been destroyed and need the destroy() cb called.
   inline std::vector<double>* destroy_async_id_list();
 
+  // Staged init/promiseResolve events from the lightweight promise hook,
+  // flat [type, async_id, trigger_async_id] triplets. See
+  // FlushPromiseEvents() in async_wrap.cc.
+  inline std::vector<double>* promise_event_list();
+
+  // With --recycle-async-ids, returns the id of a fully destroyed resource
+  // to the pool that new_async_id() draws from, keeping ids in SMI range in
+  // long-lived processes instead of growing without bound. No-op otherwise.
+  inline void RecycleAsyncId(double async_id);
+
   std::set<std::string> native_modules_with_cache;
   std::set<std::string> native_modules_without_cache;
 
+  // Initialization time in nanoseconds of each internal binding, in the
+  // order the bindings were first requested. See --trace-bindings.
+  std::vector<std::pair<std::string, uint64_t>> binding_init_times;
+
   std::unordered_multimap<int, loader::ModuleWrap*> hash_to_module_map;
   std::unordered_map<uint32_t, loader::ModuleWrap*> id_to_module_map;
   std::unordered_map<uint32_t, contextify::ContextifyScript*>
@@ -1032,6 +1148,30 @@ class Environment : public MemoryRetainer {
   inline void set_heap_code_statistics_buffer(
       std::shared_ptr<v8::BackingStore> backing_store);
 
+  // Pre-serialized node-report sections; written by
+  // report::UpdateReportSnapshots() on the event loop thread, read under
+  // the mutex when a report is generated (possibly from a worker thread).
+  inline Mutex& report_snapshot_mutex();
+  inline std::string& report_uv_snapshot();
+  inline std::string& report_env_vars_snapshot();
+  inline uint64_t& report_snapshot_timestamp();
+
+  // Sampling allocation profiler for native buffer memory. While enabled,
+  // every `interval`-th AllocateManaged() call records its size against the
+  // current execution async id, so allocations can be attributed to the
+  // async resource (and hence the request) that made them. Multiply the
+  // sampled numbers by the interval for an estimate of the real volume.
+  struct AllocationSample {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+  };
+  inline void StartAllocationSampling(uint32_t interval);
+  inline void StopAllocationSampling();
+  inline bool allocation_sampling_enabled() const;
+  inline void RecordAllocationSample(size_t size);
+  inline const std::unordered_map<double, AllocationSample>&
+      allocation_samples() const;
+
   inline char* http_parser_buffer() const;
   inline void set_http_parser_buffer(char* buffer);
   inline bool http_parser_buffer_in_use() const;
@@ -1050,6 +1190,64 @@ class Environment : public MemoryRetainer {
   inline std::vector<std::unique_ptr<fs::FileHandleReadWrap>>&
       file_handle_read_wrap_freelist();
 
+  // Recycled storage blocks for stream requests (WriteWrap/ShutdownWrap),
+  // see StreamReq::operator new.
+  inline std::vector<void*>& stream_req_storage_freelist();
+
+  // Recycled read buffers for the default JS stream listener, see
+  // EmitToJSStreamListener::OnStreamAlloc().
+  inline std::vector<AllocatedBuffer>& stream_read_buffer_freelist();
+
+  // Initialized zlib streams kept for reuse, see ZlibContext in node_zlib.cc.
+  static constexpr size_t kMaxPooledZlibStates = 8;
+  inline std::vector<PooledZlibState>& pooled_zlib_states();
+
+  // Returns a cached JS string for a header name/value byte slice, creating
+  // and caching it on a miss. Header names and most values repeat across
+  // requests, so this avoids re-materializing the same strings per message.
+  // The cache is a small LRU; slices that are empty or too long to be worth
+  // interning are converted directly.
+  v8::Local<v8::String> InternHTTPHeaderString(const char* data, size_t size);
+
+  // Returns the eternal JS string for an interned-string corpus index (see
+  // node_interned_strings.h), creating it on first use. Unlike the LRU
+  // above, these strings live for the Environment's lifetime and resolve
+  // from bytes in a single probe via FindInternedStringIndex().
+  inline v8::Local<v8::String> interned_string(size_t index);
+
+  // Pressure signal from the garbage collector, updated from GC prologue/
+  // epilogue callbacks (see the GCPressure*Callback methods in env.cc).
+  // Streams consult this when allocating read buffers so that ingest backs
+  // off while the collector is struggling.
+  enum GCPressureLevel : uint32_t {
+    kGCPressureNone = 0,
+    kGCPressureModerate = 1,
+    kGCPressureCritical = 2,
+  };
+  inline uint32_t gc_pressure_level() const;
+  // Schedules `cb` to run once from the event loop after the pressure level
+  // has dropped below kGCPressureCritical; used to resume paused reads.
+  void OnGCPressureRelieved(std::function<void()> cb);
+
+  // Batched interface to Isolate::AdjustAmountOfExternalAllocatedMemory().
+  // Every direct call to the V8 API runs its external-memory GC trigger
+  // check; deltas reported here accumulate locally instead and are only
+  // forwarded once they exceed 1MB in either direction, plus once per loop
+  // turn right before the poll phase. Large native retainers that V8 cannot
+  // see (NodeBIO chains, http2 session read buffers) report through this so
+  // that the collector schedules with the real external footprint in view.
+  inline void AdjustExternalMemory(int64_t delta);
+  inline void FlushExternalMemory();
+
+  // Near-limit cache eviction tier: when the pressure level rises (or V8's
+  // near-heap-limit callback fires), registered callbacks run from the
+  // event loop with the new level so native caches can be dropped before
+  // the process hits the heap limit. The environment registers its own
+  // recycled-buffer pools and intern caches; bindings may add more.
+  typedef void (*CacheEvictionCallback)(void* data, uint32_t level);
+  void AddCacheEvictionCallback(CacheEvictionCallback cb, void* data);
+  void RemoveCacheEvictionCallback(CacheEvictionCallback cb, void* data);
+
   inline performance::performance_state* performance_state();
   inline std::unordered_map<std::string, uint64_t>* performance_marks();
 
@@ -1182,6 +1380,32 @@ class Environment : public MemoryRetainer {
   inline HandleWrapQueue* handle_wrap_queue() { return &handle_wrap_queue_; }
   inline ReqWrapQueue* req_wrap_queue() { return &req_wrap_queue_; }
 
+  // Per-provider tally of handles currently in handle_wrap_queue_, maintained
+  // by HandleWrap so that monitoring code can report handle populations
+  // without materializing a wrap object per handle.
+  inline const std::array<int64_t, AsyncWrap::PROVIDERS_LENGTH>&
+      active_handle_counts() const {
+    return active_handle_counts_;
+  }
+  inline void AdjustActiveHandleCount(AsyncWrap::ProviderType provider,
+                                      int64_t delta) {
+    active_handle_counts_[provider] += delta;
+    DCHECK_GE(active_handle_counts_[provider], 0);
+  }
+
+  // Cooperative per-Environment CPU accounting, for embedders that multiplex
+  // several Environments (sharing an Isolate and event loop) and want to
+  // budget CPU per tenant. When a budget is set, the wall time spent inside
+  // outermost callback scopes is charged against it and the allowance refills
+  // every interval. Enforcement is cooperative: JS is never preempted; the
+  // budget state only tells dispatchers (the embedder's, and the native
+  // immediate queue) when to prefer other Environments' work.
+  inline bool cpu_budget_enabled() const { return cpu_budget_interval_ns_ > 0; }
+  inline uint64_t cpu_time_ns() const { return cpu_time_ns_; }
+  void SetCpuBudget(uint64_t budget_ns, uint64_t interval_ns);
+  void ChargeCpuTime(uint64_t delta_ns);
+  bool CpuBudgetExceeded();
+
   inline bool EmitProcessEnvWarning() {
     bool current_value = emit_env_nonstring_warning_;
     emit_env_nonstring_warning_ = false;
@@ -1198,6 +1422,12 @@ class Environment : public MemoryRetainer {
   // keep_alive will be kept alive between now and after the callback has run.
   template <typename Fn>
   inline void SetImmediate(Fn&& cb);
+  // Like SetImmediate(), but the callback runs in a separate high-priority
+  // lane that is always drained completely before the normal lane, ahead of
+  // any bulk work queued there. Reserved for latency-critical cleanups such
+  // as close callbacks and stream error propagation.
+  template <typename Fn>
+  inline void SetHighPriorityImmediate(Fn&& cb);
   template <typename Fn>
   inline void SetUnrefImmediate(Fn&& cb);
   // This needs to be available for the JS-land setImmediate().
@@ -1226,6 +1456,26 @@ class Environment : public MemoryRetainer {
 
   inline AsyncRequest* thread_stopper() { return &thread_stopper_; }
 
+  inline LoopStallWatchdog* loop_stall_watchdog() {
+    return loop_stall_watchdog_.get();
+  }
+
+  // Always-on histogram of the non-poll portion of each event loop turn
+  // (nanoseconds spent in timers, callbacks and ticks between leaving the
+  // poll phase and re-entering it). Fed from the loop phase handles in
+  // InitializeLibuv(); snapshotted via perf_hooks.loopLatency().
+  inline Histogram* loop_latency_histogram() {
+    return loop_latency_histogram_.get();
+  }
+
+  // Busy-poll support for latency-critical sockets (--busy-poll-window):
+  // while at least one registered stream has seen activity within the
+  // window, an idle handle keeps the loop's poll timeout at zero so that
+  // ready events are picked up without an epoll_wait() sleep/wakeup cycle.
+  void RegisterBusyPollStream();
+  void UnregisterBusyPollStream();
+  void NoteBusyPollActivity();
+
   // The BaseObject count is a debugging helper that makes sure that there are
   // no memory leaks caused by BaseObjects staying alive longer than expected
   // (in particular, no circular BaseObjectPtr references).
@@ -1268,11 +1518,15 @@ class Environment : public MemoryRetainer {
   inline void set_heap_prof_interval(uint64_t interval);
   inline uint64_t heap_prof_interval() const;
 
+  void set_cpu_flight_recorder(
+      std::unique_ptr<profiler::CpuFlightRecorder> recorder);
+  profiler::CpuFlightRecorder* cpu_flight_recorder();
+
 #endif  // HAVE_INSPECTOR
 
  private:
   template <typename Fn>
-  inline void CreateImmediate(Fn&& cb, bool ref);
+  inline void CreateImmediate(Fn&& cb, bool ref, bool high_priority);
 
   inline void ThrowError(v8::Local<v8::Value> (*fun)(v8::Local<v8::String>),
                          const char* errmsg);
@@ -1285,12 +1539,22 @@ class Environment : public MemoryRetainer {
   uv_idle_t immediate_idle_handle_;
   uv_prepare_t idle_prepare_handle_;
   uv_check_t idle_check_handle_;
+  // Always-on loop phase timing; see performance_state::AddLoopPhaseTime().
+  uv_prepare_t loop_phase_prepare_handle_;
+  uv_check_t loop_phase_check_handle_;
+  uint64_t loop_poll_start_time_ = 0;
+  // Timestamp taken when the loop left the poll phase; the time until the
+  // next poll entry is recorded into loop_latency_histogram_.
+  uint64_t loop_turn_start_time_ = 0;
+  std::unique_ptr<Histogram> loop_latency_histogram_;
+  AliasedFloat64Array coarse_clock_fields_;
   uv_async_t cleanup_finalization_groups_async_;
   bool profiler_idle_notifier_started_ = false;
 
   AsyncHooks async_hooks_;
   ImmediateInfo immediate_info_;
   TickInfo tick_info_;
+  TaskQueueStats task_queue_stats_;
   const uint64_t timer_base_;
   std::shared_ptr<KVStore> env_vars_;
   bool printed_error_ = false;
@@ -1299,6 +1563,12 @@ class Environment : public MemoryRetainer {
   bool emit_err_name_warning_ = true;
   size_t async_callback_scope_depth_ = 0;
   std::vector<double> destroy_async_id_list_;
+  std::vector<double> promise_event_list_;
+
+  // Pool of reusable async ids, see RecycleAsyncId(). Bounded so that a
+  // burst of destroyed resources cannot hold on to a large allocation.
+  static constexpr size_t kMaxRecycledAsyncIds = 65536;
+  std::vector<double> recycled_async_ids_;
 
 #if HAVE_INSPECTOR
   std::unique_ptr<profiler::V8CoverageConnection> coverage_connection_;
@@ -1311,6 +1581,7 @@ class Environment : public MemoryRetainer {
   std::string heap_prof_dir_;
   std::string heap_prof_name_;
   uint64_t heap_prof_interval_;
+  std::unique_ptr<profiler::CpuFlightRecorder> cpu_flight_recorder_;
 #endif  // HAVE_INSPECTOR
 
   std::shared_ptr<EnvironmentOptions> options_;
@@ -1367,14 +1638,41 @@ class Environment : public MemoryRetainer {
   friend int GenDebugSymbols();
   HandleWrapQueue handle_wrap_queue_;
   ReqWrapQueue req_wrap_queue_;
+  std::array<int64_t, AsyncWrap::PROVIDERS_LENGTH> active_handle_counts_ {};
+
+  // CPU budgeting state; see SetCpuBudget(). All times in nanoseconds.
+  uint64_t cpu_budget_ns_ = 0;
+  uint64_t cpu_budget_interval_ns_ = 0;
+  uint64_t cpu_interval_start_ns_ = 0;
+  uint64_t cpu_used_in_interval_ns_ = 0;
+  uint64_t cpu_time_ns_ = 0;
+
   std::list<HandleCleanup> handle_cleanup_queue_;
   int handle_cleanup_waiting_ = 0;
   int request_waiting_ = 0;
 
+  // CPU-class ThreadPoolWork items waiting for a slot when
+  // --threadpool-cpu-limit is in effect. Only accessed from the event loop
+  // thread.
+  std::list<ThreadPoolWork*> queued_cpu_work_;
+  uint32_t active_cpu_work_count_ = 0;
+
+  // Pre-serialized node-report sections, maintained on the event loop
+  // thread by report::UpdateReportSnapshots() and read (under the mutex,
+  // possibly from a worker thread) when a report is generated.
+  Mutex report_snapshot_mutex_;
+  std::string report_uv_snapshot_;
+  std::string report_env_vars_snapshot_;
+  uint64_t report_snapshot_timestamp_ = 0;
+
   std::shared_ptr<v8::BackingStore> heap_statistics_buffer_;
   std::shared_ptr<v8::BackingStore> heap_space_statistics_buffer_;
   std::shared_ptr<v8::BackingStore> heap_code_statistics_buffer_;
 
+  uint32_t allocation_sample_interval_ = 0;  // 0 means disabled.
+  uint64_t allocation_sample_counter_ = 0;
+  std::unordered_map<double, AllocationSample> allocation_samples_;
+
   char* http_parser_buffer_ = nullptr;
   bool http_parser_buffer_in_use_ = false;
   std::unique_ptr<http2::Http2State> http2_state_;
@@ -1387,6 +1685,54 @@ class Environment : public MemoryRetainer {
   std::vector<std::unique_ptr<fs::FileHandleReadWrap>>
       file_handle_read_wrap_freelist_;
 
+  std::vector<void*> stream_req_storage_freelist_;
+  std::vector<AllocatedBuffer> stream_read_buffer_freelist_;
+  std::vector<PooledZlibState> pooled_zlib_states_;
+
+  void DiscardPooledZlibStates();
+
+  static void GCPressurePrologueCallback(v8::Isolate* isolate,
+                                         v8::GCType type,
+                                         v8::GCCallbackFlags flags,
+                                         void* data);
+  static void GCPressureEpilogueCallback(v8::Isolate* isolate,
+                                         v8::GCType type,
+                                         v8::GCCallbackFlags flags,
+                                         void* data);
+  void RunGCPressureRelievedCallbacks();
+  uint32_t gc_pressure_level_ = kGCPressureNone;
+  std::vector<std::function<void()>> gc_pressure_relieved_callbacks_;
+
+  static constexpr int64_t kExternalMemoryFlushThreshold = 1 << 20;
+  int64_t external_memory_delta_ = 0;
+
+  static size_t NearHeapLimitEvictionCallback(void* data,
+                                              size_t current_heap_limit,
+                                              size_t initial_heap_limit);
+  static void EvictCoreCaches(void* data, uint32_t level);
+  void ScheduleCacheEviction(uint32_t level);
+  void RunCacheEvictionCallbacks(uint32_t level);
+  struct CacheEvictionEntry {
+    CacheEvictionCallback cb;
+    void* data;
+  };
+  std::vector<CacheEvictionEntry> cache_eviction_callbacks_;
+  bool cache_eviction_scheduled_ = false;
+
+  // Lazily created eternal strings for the static interned-string corpus.
+  std::array<v8::Eternal<v8::String>, kInternedStringCount> interned_strings_;
+
+  // LRU intern table for HTTP header strings, most recently used first.
+  // The map's keys point at the byte strings owned by the list entries.
+  static constexpr size_t kHTTPHeaderInternMaxLength = 256;
+  static constexpr size_t kHTTPHeaderInternCapacity = 512;
+  std::list<std::pair<std::string, v8::Global<v8::String>>>
+      http_header_intern_lru_;
+  std::unordered_map<
+      std::string,
+      std::list<std::pair<std::string, v8::Global<v8::String>>>::iterator>
+      http_header_intern_map_;
+
   worker::Worker* worker_context_ = nullptr;
 
   std::list<node_module> extra_linked_bindings_;
@@ -1430,6 +1776,14 @@ class Environment : public MemoryRetainer {
 
   std::unique_ptr<NativeImmediateCallback> native_immediate_callbacks_head_;
   NativeImmediateCallback* native_immediate_callbacks_tail_ = nullptr;
+  std::unique_ptr<NativeImmediateCallback> native_immediates_high_head_;
+  NativeImmediateCallback* native_immediates_high_tail_ = nullptr;
+
+  // At most this many normal-lane native immediates run per loop turn; any
+  // remainder is carried over to the front of the queue for the next turn.
+  static constexpr size_t kNativeImmediateMaxBatch = 1024;
+  // Normal-lane batch size while this Environment is over its CPU budget.
+  static constexpr size_t kNativeImmediateThrottledBatch = 8;
 
   void RunAndClearNativeImmediates(bool only_refed = false);
   static void CheckImmediate(uv_check_t* handle);
@@ -1447,6 +1801,13 @@ class Environment : public MemoryRetainer {
   // Used by embedders to shutdown running Node instance.
   AsyncRequest thread_stopper_;
 
+  std::unique_ptr<LoopStallWatchdog> loop_stall_watchdog_;
+
+  uv_idle_t busy_poll_idle_handle_;
+  uint32_t busy_poll_stream_count_ = 0;
+  uint64_t busy_poll_spin_deadline_ = 0;
+  bool busy_poll_spinning_ = false;
+
   template <typename T>
   void ForEachBaseObject(T&& iterator);
 
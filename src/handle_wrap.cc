@@ -90,12 +90,14 @@ void HandleWrap::OnGCCollect() {
 
 void HandleWrap::MarkAsInitialized() {
   env()->handle_wrap_queue()->PushBack(this);
+  env()->AdjustActiveHandleCount(provider_type(), 1);
   state_ = kInitialized;
 }
 
 
 void HandleWrap::MarkAsUninitialized() {
   handle_wrap_queue_.Remove();
+  env()->AdjustActiveHandleCount(provider_type(), -1);
   state_ = kClosed;
 }
 
@@ -111,6 +113,7 @@ HandleWrap::HandleWrap(Environment* env,
   HandleScope scope(env->isolate());
   CHECK(env->has_run_bootstrapping_code());
   env->handle_wrap_queue()->PushBack(this);
+  env->AdjustActiveHandleCount(provider, 1);
 }
 
 
@@ -128,6 +131,7 @@ void HandleWrap::OnClose(uv_handle_t* handle) {
 
   wrap->OnClose();
   wrap->handle_wrap_queue_.Remove();
+  env->AdjustActiveHandleCount(wrap->provider_type(), -1);
 
   if (!wrap->persistent().IsEmpty() &&
       wrap->object()->Has(env->context(), env->handle_onclose_symbol())
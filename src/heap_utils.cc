@@ -4,6 +4,11 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <string>
+
 using v8::Array;
 using v8::Boolean;
 using v8::Context;
@@ -230,6 +235,28 @@ class FileOutputStream : public v8::OutputStream {
   FILE* stream_;
 };
 
+// Collects serialized snapshot chunks in memory so that they can later be
+// emitted to JS in bounded slices instead of one synchronous burst.
+class BufferOutputStream : public v8::OutputStream {
+ public:
+  explicit BufferOutputStream(std::deque<std::string>* chunks)
+      : chunks_(chunks) {}
+
+  int GetChunkSize() override {
+    return 65536;  // big chunks == faster
+  }
+
+  void EndOfStream() override {}
+
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    chunks_->emplace_back(data, static_cast<size_t>(size));
+    return kContinue;
+  }
+
+ private:
+  std::deque<std::string>* chunks_;
+};
+
 class HeapSnapshotStream : public AsyncWrap,
                            public StreamBase,
                            public v8::OutputStream {
@@ -237,10 +264,12 @@ class HeapSnapshotStream : public AsyncWrap,
   HeapSnapshotStream(
       Environment* env,
       const HeapSnapshot* snapshot,
-      v8::Local<v8::Object> obj) :
+      v8::Local<v8::Object> obj,
+      bool incremental) :
       AsyncWrap(env, obj, AsyncWrap::PROVIDER_HEAPSNAPSHOT),
       StreamBase(env),
-      snapshot_(snapshot) {
+      snapshot_(snapshot),
+      incremental_(incremental) {
     MakeWeak();
     StreamBase::AttachToObject(GetObject());
   }
@@ -274,12 +303,33 @@ class HeapSnapshotStream : public AsyncWrap,
   }
 
   int ReadStart() override {
-    CHECK_NE(snapshot_, nullptr);
-    snapshot_->Serialize(this, HeapSnapshot::kJSON);
+    if (!incremental_) {
+      CHECK_NE(snapshot_, nullptr);
+      snapshot_->Serialize(this, HeapSnapshot::kJSON);
+      return 0;
+    }
+
+    reading_ = true;
+    if (!serialized_) {
+      CHECK_NE(snapshot_, nullptr);
+      // Serialize into memory without re-entering JS; the chunks are then
+      // drained one bounded slice per loop turn. The snapshot itself can be
+      // released right away, which matters on large heaps.
+      BufferOutputStream out(&chunks_);
+      snapshot_->Serialize(&out, HeapSnapshot::kJSON);
+      serialized_ = true;
+      const_cast<HeapSnapshot*>(snapshot_)->Delete();
+      snapshot_ = nullptr;
+      // Keep this wrap alive while chunks are pending; the drain callbacks
+      // capture `this` across loop turns.
+      self_ref_.Reset(env()->isolate(), GetObject());
+    }
+    ScheduleDrain();
     return 0;
   }
 
   int ReadStop() override {
+    reading_ = false;
     return 0;
   }
 
@@ -294,8 +344,8 @@ class HeapSnapshotStream : public AsyncWrap,
     UNREACHABLE();
   }
 
-  bool IsAlive() override { return snapshot_ != nullptr; }
-  bool IsClosing() override { return snapshot_ == nullptr; }
+  bool IsAlive() override { return snapshot_ != nullptr || !chunks_.empty(); }
+  bool IsClosing() override { return !IsAlive(); }
   AsyncWrap* GetAsyncWrap() override { return this; }
 
   void MemoryInfo(MemoryTracker* tracker) const override {
@@ -309,15 +359,65 @@ class HeapSnapshotStream : public AsyncWrap,
   SET_SELF_SIZE(HeapSnapshotStream)
 
  private:
+  // Cap on how many serialized bytes are pushed to JS per loop turn in
+  // incremental mode.
+  static constexpr size_t kIncrementalSliceBytes = 1024 * 1024;
+
+  void ScheduleDrain() {
+    if (draining_ || !reading_) return;
+    draining_ = true;
+    env()->SetImmediate([this](Environment* env) { DrainSlice(); });
+  }
+
+  void DrainSlice() {
+    draining_ = false;
+    if (!reading_) return;
+    v8::HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    size_t emitted = 0;
+    while (emitted < kIncrementalSliceBytes && !chunks_.empty()) {
+      const std::string& chunk = chunks_.front();
+      size_t len = chunk.size() - chunk_offset_;
+      uv_buf_t buf = EmitAlloc(len);
+      size_t avail = std::min<size_t>(len, buf.len);
+      memcpy(buf.base, chunk.data() + chunk_offset_, avail);
+      chunk_offset_ += avail;
+      emitted += avail;
+      if (chunk_offset_ == chunk.size()) {
+        chunks_.pop_front();
+        chunk_offset_ = 0;
+      }
+      EmitRead(avail, buf);
+      // The consumer may have paused the stream from within EmitRead().
+      if (!reading_) break;
+    }
+    if (chunks_.empty()) {
+      EmitRead(UV_EOF);
+      Cleanup();
+      return;
+    }
+    ScheduleDrain();
+  }
+
   void Cleanup() {
     if (snapshot_ != nullptr) {
       const_cast<HeapSnapshot*>(snapshot_)->Delete();
       snapshot_ = nullptr;
     }
+    chunks_.clear();
+    chunk_offset_ = 0;
+    self_ref_.Reset();
   }
 
 
   const HeapSnapshot* snapshot_;
+  const bool incremental_;
+  bool serialized_ = false;
+  bool reading_ = false;
+  bool draining_ = false;
+  std::deque<std::string> chunks_;
+  size_t chunk_offset_ = 0;
+  Global<Object> self_ref_;
 };
 
 inline void TakeSnapshot(Isolate* isolate, v8::OutputStream* out) {
@@ -342,6 +442,7 @@ inline bool WriteSnapshot(Isolate* isolate, const char* filename) {
 void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   HandleScope scope(env->isolate());
+  const bool incremental = args[0]->IsTrue();
   const HeapSnapshot* const snapshot =
       env->isolate()->GetHeapProfiler()->TakeHeapSnapshot();
   CHECK_NOT_NULL(snapshot);
@@ -351,7 +452,8 @@ void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
            .ToLocal(&obj)) {
     return;
   }
-  HeapSnapshotStream* out = new HeapSnapshotStream(env, snapshot, obj);
+  HeapSnapshotStream* out =
+      new HeapSnapshotStream(env, snapshot, obj, incremental);
   args.GetReturnValue().Set(out->object());
 }
 
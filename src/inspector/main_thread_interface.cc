@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 
 namespace node {
 namespace inspector {
@@ -16,6 +17,53 @@ namespace {
 using v8_inspector::StringView;
 using v8_inspector::StringBuffer;
 
+// Returns whether dispatching the protocol message has to break into
+// JavaScript that is currently executing, rather than wait for the next
+// event loop turn. This runs on whatever thread the message arrives on
+// (e.g. the inspector IO thread), so with a frontend attached the main
+// thread is only interrupted for methods that need it - a breakpoint has
+// to land while a script spins in a loop, but most traffic can ride the
+// regular task queue. A false positive merely costs an extra interrupt,
+// so unparseable messages are treated as urgent.
+bool MessageNeedsInterrupt(const StringView& message) {
+  const size_t length = message.length();
+  auto char_at = [&message](size_t pos) -> char {
+    uint16_t ch = message.is8Bit() ? message.characters8()[pos]
+                                   : message.characters16()[pos];
+    return ch < 0x80 ? static_cast<char>(ch) : '\0';
+  };
+  // Frontends serialize the "method" property before "params", so the
+  // first occurrence is the method name and not e.g. part of a
+  // Runtime.evaluate expression.
+  static const char kMethodKey[] = "\"method\"";
+  constexpr size_t kMethodKeyLength = sizeof(kMethodKey) - 1;
+  size_t pos = 0;
+  size_t matched = 0;
+  while (pos < length && matched < kMethodKeyLength) {
+    if (char_at(pos) == kMethodKey[matched])
+      matched++;
+    else
+      matched = char_at(pos) == kMethodKey[0] ? 1 : 0;
+    pos++;
+  }
+  if (matched < kMethodKeyLength)
+    return true;
+  while (pos < length && (char_at(pos) == ':' || char_at(pos) == ' '))
+    pos++;
+  if (pos >= length || char_at(pos) != '"')
+    return true;
+  pos++;
+  std::string method;
+  while (pos < length && char_at(pos) != '"')
+    method += char_at(pos++);
+  // Pausing, breakpoints and profiler control affect code that may be
+  // running right now; everything else can wait for the loop to turn.
+  return method.compare(0, 9, "Debugger.") == 0 ||
+         method.compare(0, 9, "Profiler.") == 0 ||
+         method.compare(0, 13, "HeapProfiler.") == 0 ||
+         method == "Runtime.terminateExecution";
+}
+
 template <typename T>
 class DeletableWrapper : public Deletable {
  public:
@@ -67,6 +115,8 @@ class DeleteRequest : public Request {
     thread->RemoveObject(object_id_);
   }
 
+  bool needs_interrupt() const override { return false; }
+
  private:
   int object_id_;
 };
@@ -74,15 +124,20 @@ class DeleteRequest : public Request {
 template <typename Target, typename Fn>
 class CallRequest : public Request {
  public:
-  CallRequest(int id, Fn fn) : id_(id), fn_(std::move(fn)) {}
+  CallRequest(int id, Fn fn, bool needs_interrupt)
+              : id_(id), fn_(std::move(fn)),
+                needs_interrupt_(needs_interrupt) {}
 
   void Call(MainThreadInterface* thread) override {
     fn_(DeletableWrapper<Target>::get(thread, id_));
   }
 
+  bool needs_interrupt() const override { return needs_interrupt_; }
+
  private:
   int id_;
   Fn fn_;
+  bool needs_interrupt_;
 };
 
 class DispatchMessagesTask : public v8::Task {
@@ -119,15 +174,17 @@ class AnotherThreadObjectReference {
   }
 
   template <typename Fn>
-  void Call(Fn fn) const {
+  void Call(Fn fn, bool needs_interrupt = true) const {
     using Request = CallRequest<T, Fn>;
     thread_->Post(std::unique_ptr<Request>(
-        new Request(object_id_, std::move(fn))));
+        new Request(object_id_, std::move(fn), needs_interrupt)));
   }
 
   template <typename Arg>
-  void Call(void (T::*fn)(Arg), Arg argument) const {
-    Call(std::bind(Apply<Arg>, std::placeholders::_1, fn, std::move(argument)));
+  void Call(void (T::*fn)(Arg), Arg argument,
+            bool needs_interrupt = true) const {
+    Call(std::bind(Apply<Arg>, std::placeholders::_1, fn, std::move(argument)),
+         needs_interrupt);
   }
 
  private:
@@ -185,7 +242,8 @@ class CrossThreadInspectorSession : public InspectorSession {
 
   void Dispatch(const StringView& message) override {
     state_.Call(&MainThreadSessionState::Dispatch,
-                StringBuffer::create(message));
+                StringBuffer::create(message),
+                MessageNeedsInterrupt(message));
   }
 
  private:
@@ -198,11 +256,12 @@ class ThreadSafeDelegate : public InspectorSessionDelegate {
                      : thread_(thread), delegate_(thread, object_id) {}
 
   void SendMessageToFrontend(const v8_inspector::StringView& message) override {
+    // Delivering output to the frontend never has to preempt running code.
     delegate_.Call(
         [m = StringBuffer::create(message)]
         (InspectorSessionDelegate* delegate) {
       delegate->SendMessageToFrontend(m->string());
-    });
+    }, false);
   }
 
  private:
@@ -227,15 +286,26 @@ MainThreadInterface::~MainThreadInterface() {
 void MainThreadInterface::Post(std::unique_ptr<Request> request) {
   Mutex::ScopedLock scoped_lock(requests_lock_);
   bool needs_notify = requests_.empty();
+  bool needs_interrupt = request->needs_interrupt();
   requests_.push_back(std::move(request));
-  if (needs_notify) {
-    if (isolate_ != nullptr && platform_ != nullptr) {
+  if (isolate_ != nullptr && platform_ != nullptr) {
+    if (needs_notify) {
       std::shared_ptr<v8::TaskRunner> taskrunner =
           platform_->GetForegroundTaskRunner(isolate_);
+      taskrunner->PostTask(std::make_unique<DispatchMessagesTask>(
+          std::weak_ptr<MainThreadInterface>(shared_from_this())));
+      interrupt_requested_ = false;
+    }
+    // An isolate interrupt breaks into JavaScript that is currently
+    // executing. Only request one for messages that cannot wait for the
+    // task posted above to run when the loop turns, so that an attached
+    // frontend does not keep preempting running code. One pending
+    // interrupt per batch is enough - DispatchMessages drains the whole
+    // queue.
+    if (needs_interrupt && !interrupt_requested_) {
+      interrupt_requested_ = true;
       std::weak_ptr<MainThreadInterface>* interface_ptr =
           new std::weak_ptr<MainThreadInterface>(shared_from_this());
-      taskrunner->PostTask(
-          std::make_unique<DispatchMessagesTask>(*interface_ptr));
       isolate_->RequestInterrupt([](v8::Isolate* isolate, void* opaque) {
         std::unique_ptr<std::weak_ptr<MainThreadInterface>> interface_ptr {
           static_cast<std::weak_ptr<MainThreadInterface>*>(opaque) };
@@ -267,6 +337,9 @@ void MainThreadInterface::DispatchMessages() {
     if (dispatching_message_queue_.empty()) {
       Mutex::ScopedLock scoped_lock(requests_lock_);
       requests_.swap(dispatching_message_queue_);
+      // The batch is being dispatched; an interrupt requested for it is
+      // no longer needed and must not swallow one for the next batch.
+      interrupt_requested_ = false;
     }
     had_messages = !dispatching_message_queue_.empty();
     while (!dispatching_message_queue_.empty()) {
@@ -25,6 +25,9 @@ class MainThreadInterface;
 class Request {
  public:
   virtual void Call(MainThreadInterface*) = 0;
+  // Whether delivering this request has to break into JavaScript that is
+  // currently executing, rather than wait for the next event loop turn.
+  virtual bool needs_interrupt() const { return true; }
   virtual ~Request() = default;
 };
 
@@ -95,6 +98,7 @@ class MainThreadInterface :
   // when we reenter the DispatchMessages function.
   MessageQueue dispatching_message_queue_;
   bool dispatching_messages_ = false;
+  bool interrupt_requested_ = false;  // Guarded by requests_lock_
   ConditionVariable incoming_message_cond_;
   // Used from any thread
   Agent* const agent_;
@@ -8,6 +8,7 @@
 #include "node_internals.h"
 #include "util-inl.h"
 #include "v8-inspector.h"
+#include "v8-profiler.h"
 
 #include <sstream>
 
@@ -89,6 +90,7 @@ void V8ProfilerConnection::V8ProfilerSessionDelegate::SendMessageToFrontend(
         type,
         connection_->ending() ? "true" : "false");
   if (!connection_->ending()) {
+    connection_->OnMessage(message);
     return;
   }
 
@@ -106,6 +108,30 @@ void V8ProfilerConnection::V8ProfilerSessionDelegate::SendMessageToFrontend(
   connection_->WriteProfile(message_str);
 }
 
+// Extract the numeric "id" field from a protocol response. The id is
+// always serialized first by the inspector, so only the message prefix
+// needs to be scanned.
+static bool GetMessageId(const StringView& message, size_t* id) {
+  auto char_at = [&](size_t i) {
+    return message.is8Bit() ? static_cast<char>(message.characters8()[i])
+                            : static_cast<char>(message.characters16()[i]);
+  };
+  const char prefix[] = "{\"id\":";
+  size_t length = message.length();
+  size_t pos = 0;
+  for (; prefix[pos] != '\0'; pos++) {
+    if (pos >= length || char_at(pos) != prefix[pos]) return false;
+  }
+  if (pos >= length || char_at(pos) < '0' || char_at(pos) > '9') return false;
+  size_t result = 0;
+  while (pos < length && char_at(pos) >= '0' && char_at(pos) <= '9') {
+    result = result * 10 + (char_at(pos) - '0');
+    pos++;
+  }
+  *id = result;
+  return true;
+}
+
 static bool EnsureDirectory(const std::string& directory, const char* type) {
   uv_fs_t req;
   int ret = fs::MKDirpSync(nullptr, &req, directory, 0777, nullptr);
@@ -209,6 +235,16 @@ void V8CoverageConnection::WriteProfile(Local<String> message) {
   HandleScope handle_scope(isolate);
   Context::Scope context_scope(context);
 
+  if (streaming_) {
+    // The final coverage taken at exit is just another delta; it is
+    // appended to the stream and merged offline with the rest. The source
+    // map cache has no profile to piggyback on, so it gets its own file.
+    AppendCoverageDelta(message);
+    WriteSourceMapCache();
+    StopStreaming();
+    return;
+  }
+
   // Get message.result from the response.
   Local<Object> result;
   if (!ParseProfile(env_, message, type()).ToLocal(&result)) {
@@ -275,6 +311,9 @@ void V8CoverageConnection::Start() {
   DispatchMessage("Profiler.enable");
   DispatchMessage("Profiler.startPreciseCoverage",
                   R"({ "callCount": true, "detailed": true })");
+  if (env()->options()->coverage_stream_interval > 0) {
+    StartStreaming();
+  }
 }
 
 void V8CoverageConnection::End() {
@@ -283,6 +322,209 @@ void V8CoverageConnection::End() {
   DispatchMessage("Profiler.takePreciseCoverage");
 }
 
+void V8CoverageConnection::StartStreaming() {
+  streaming_ = true;
+  uint64_t interval = env()->options()->coverage_stream_interval;
+  CHECK_EQ(uv_timer_init(env()->event_loop(), &stream_timer_), 0);
+  stream_timer_.data = this;
+  uv_timer_start(&stream_timer_, StreamTimerCb, interval, interval);
+  // Taking deltas must not keep the event loop alive on its own.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&stream_timer_));
+}
+
+void V8CoverageConnection::StopStreaming() {
+  if (!streaming_) return;
+  streaming_ = false;
+  uv_timer_stop(&stream_timer_);
+  env()->CloseHandle(&stream_timer_, [](uv_timer_t*) {});
+  if (stream_fd_ != -1) {
+    uv_fs_t req;
+    uv_fs_close(nullptr, &req, stream_fd_, nullptr);
+    uv_fs_req_cleanup(&req);
+    stream_fd_ = -1;
+  }
+}
+
+void V8CoverageConnection::StreamTimerCb(uv_timer_t* handle) {
+  V8CoverageConnection* connection =
+      static_cast<V8CoverageConnection*>(handle->data);
+  HandleScope handle_scope(connection->env()->isolate());
+  Context::Scope context_scope(connection->env()->context());
+  connection->TakeCoverageDelta();
+}
+
+void V8CoverageConnection::TakeCoverageDelta() {
+  // The response may be delivered synchronously during dispatch, so the id
+  // has to be registered before the message goes out.
+  pending_delta_ids_.insert(next_message_id());
+  DispatchMessage("Profiler.takePreciseCoverage");
+}
+
+void V8CoverageConnection::OnMessage(const StringView& message) {
+  if (!streaming_) return;
+  size_t id;
+  if (!GetMessageId(message, &id)) return;
+  auto it = pending_delta_ids_.find(id);
+  if (it == pending_delta_ids_.end()) return;
+  pending_delta_ids_.erase(it);
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+  Local<String> message_str;
+  if (!String::NewFromTwoByte(isolate,
+                              message.characters16(),
+                              NewStringType::kNormal,
+                              message.length())
+           .ToLocal(&message_str)) {
+    fprintf(stderr, "Failed to convert %s delta message\n", type());
+    return;
+  }
+  AppendCoverageDelta(message_str);
+}
+
+// A pending append of one coverage delta record, freed when the threadpool
+// write completes.
+struct CoverageDeltaWrite {
+  uv_fs_t req;
+  MallocedBuffer<char> buffer;
+};
+
+void V8CoverageConnection::AppendCoverageDelta(Local<String> message) {
+  if (stream_fd_ == -1) {
+    std::string directory = GetDirectory();
+    DCHECK(!directory.empty());
+    if (!EnsureDirectory(directory, type())) {
+      return;
+    }
+    std::string thread_id = std::to_string(env()->thread_id());
+    std::string pid = std::to_string(uv_os_getpid());
+    std::string timestamp = std::to_string(
+        static_cast<uint64_t>(GetCurrentTimeInMicroseconds() / 1000));
+    char filename[1024];
+    snprintf(filename,
+             sizeof(filename),
+             "coverage-stream-%s-%s-%s.bin",
+             pid.c_str(),
+             timestamp.c_str(),
+             thread_id.c_str());
+    std::string path = directory + kPathSeparator + filename;
+    uv_fs_t req;
+    int fd = uv_fs_open(nullptr,
+                        &req,
+                        path.c_str(),
+                        UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_APPEND,
+                        0600,
+                        nullptr);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0) {
+      char err_buf[128];
+      uv_err_name_r(fd, err_buf, sizeof(err_buf));
+      fprintf(stderr,
+              "%s: Failed to open coverage stream file %s\n",
+              err_buf,
+              path.c_str());
+      return;
+    }
+    stream_fd_ = fd;
+  }
+
+  // Each record is a 4-byte little-endian length followed by the UTF-8
+  // delta message. Records are self-contained and the call counts they
+  // carry are additive, so the offline merge does not depend on order.
+  node::Utf8Value utf8(env()->isolate(), message);
+  uint32_t length = static_cast<uint32_t>(utf8.length());
+  MallocedBuffer<char> record(sizeof(length) + length);
+  record.data[0] = length & 0xff;
+  record.data[1] = (length >> 8) & 0xff;
+  record.data[2] = (length >> 16) & 0xff;
+  record.data[3] = (length >> 24) & 0xff;
+  memcpy(record.data + sizeof(length), *utf8, length);
+
+  if (ending_) {
+    // The event loop is gone by the time the final delta is taken;
+    // write it out synchronously.
+    uv_buf_t buf = uv_buf_init(record.data,
+                               static_cast<unsigned int>(record.size));
+    uv_fs_t req;
+    uv_fs_write(nullptr, &req, stream_fd_, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    return;
+  }
+
+  CoverageDeltaWrite* write = new CoverageDeltaWrite{{}, std::move(record)};
+  write->req.data = write;
+  uv_buf_t buf = uv_buf_init(write->buffer.data,
+                             static_cast<unsigned int>(write->buffer.size));
+  int err = uv_fs_write(env()->event_loop(),
+                        &write->req,
+                        stream_fd_,
+                        &buf,
+                        1,
+                        -1,
+                        [](uv_fs_t* req) {
+                          std::unique_ptr<CoverageDeltaWrite> write(
+                              static_cast<CoverageDeltaWrite*>(req->data));
+                          uv_fs_req_cleanup(req);
+                        });
+  if (err < 0) {
+    delete write;
+  }
+}
+
+// Write the source map cache to its own file. Only used in streaming mode,
+// where there is no end-of-process JSON profile to attach it to.
+void V8CoverageConnection::WriteSourceMapCache() {
+  Isolate* isolate = env_->isolate();
+  Local<Context> context = env_->context();
+
+  Local<Value> source_map_cache_v;
+  {
+    TryCatchScope try_catch(env());
+    {
+      Isolate::AllowJavascriptExecutionScope allow_js_here(isolate);
+      Local<Function> source_map_cache_getter = env_->source_map_cache_getter();
+      if (!source_map_cache_getter->Call(
+              context, Undefined(isolate), 0, nullptr)
+              .ToLocal(&source_map_cache_v)) {
+        return;
+      }
+    }
+    if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
+      PrintCaughtException(isolate, context, try_catch);
+    }
+  }
+  // Avoid writing to disk if no source-map data:
+  if (source_map_cache_v->IsUndefined()) {
+    return;
+  }
+
+  Local<String> result_s;
+  if (!v8::JSON::Stringify(context, source_map_cache_v).ToLocal(&result_s)) {
+    fprintf(stderr, "Failed to stringify %s source map cache\n", type());
+    return;
+  }
+
+  std::string directory = GetDirectory();
+  DCHECK(!directory.empty());
+  if (!EnsureDirectory(directory, type())) {
+    return;
+  }
+  std::string thread_id = std::to_string(env()->thread_id());
+  std::string pid = std::to_string(uv_os_getpid());
+  std::string timestamp = std::to_string(
+      static_cast<uint64_t>(GetCurrentTimeInMicroseconds() / 1000));
+  char filename[1024];
+  snprintf(filename,
+           sizeof(filename),
+           "source-map-cache-%s-%s-%s.json",
+           pid.c_str(),
+           timestamp.c_str(),
+           thread_id.c_str());
+  std::string path = directory + kPathSeparator + filename;
+  WriteResult(env_, path.c_str(), result_s);
+}
+
 std::string V8CpuProfilerConnection::GetDirectory() const {
   return env()->cpu_prof_dir();
 }
@@ -360,6 +602,233 @@ void V8HeapProfilerConnection::End() {
   DispatchMessage("HeapProfiler.stopSampling");
 }
 
+// Names of the two overlapping flight-recorder sampling windows. Only used
+// to address the profiles inside our private CpuProfiler instance.
+static const char* const kFlightWindowNames[2] = {
+    "__node_cpu_flight_0", "__node_cpu_flight_1"};
+
+static Local<String> FlightWindowName(Isolate* isolate, int slot) {
+  return OneByteString(isolate, kFlightWindowNames[slot]);
+}
+
+static void EscapeJson(const char* str, std::ostringstream* out) {
+  for (const char* p = str; *p != '\0'; p++) {
+    const char c = *p;
+    switch (c) {
+      case '"': *out << "\\\""; break;
+      case '\\': *out << "\\\\"; break;
+      case '\b': *out << "\\b"; break;
+      case '\f': *out << "\\f"; break;
+      case '\n': *out << "\\n"; break;
+      case '\r': *out << "\\r"; break;
+      case '\t': *out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          *out << buf;
+        } else {
+          *out << c;
+        }
+        break;
+    }
+  }
+}
+
+static void SerializeCpuProfileNode(const v8::CpuProfileNode* node,
+                                    std::ostringstream* out,
+                                    bool* first) {
+  if (!*first) *out << ',';
+  *first = false;
+
+  *out << R"({"id":)" << node->GetNodeId();
+  *out << R"(,"callFrame":{"functionName":")";
+  EscapeJson(node->GetFunctionNameStr(), out);
+  *out << R"(","scriptId":")" << node->GetScriptId();
+  *out << R"(","url":")";
+  EscapeJson(node->GetScriptResourceNameStr(), out);
+  // The .cpuprofile format uses 0-based positions.
+  *out << R"(","lineNumber":)" << (node->GetLineNumber() - 1);
+  *out << R"(,"columnNumber":)" << (node->GetColumnNumber() - 1);
+  *out << R"(},"hitCount":)" << node->GetHitCount();
+  *out << R"(,"children":[)";
+  int count = node->GetChildrenCount();
+  for (int i = 0; i < count; i++) {
+    if (i > 0) *out << ',';
+    *out << node->GetChild(i)->GetNodeId();
+  }
+  *out << "]}";
+
+  for (int i = 0; i < count; i++) {
+    SerializeCpuProfileNode(node->GetChild(i), out, first);
+  }
+}
+
+// Writes `profile` in the .cpuprofile JSON format understood by the usual
+// tooling. Serialization only happens on dump; discarded windows never get
+// here.
+static void SerializeCpuProfile(const v8::CpuProfile* profile,
+                                std::ostringstream* out) {
+  *out << R"({"nodes":[)";
+  bool first = true;
+  SerializeCpuProfileNode(profile->GetTopDownRoot(), out, &first);
+  *out << R"(],"startTime":)" << profile->GetStartTime();
+  *out << R"(,"endTime":)" << profile->GetEndTime();
+
+  int samples = profile->GetSamplesCount();
+  *out << R"(,"samples":[)";
+  for (int i = 0; i < samples; i++) {
+    if (i > 0) *out << ',';
+    *out << profile->GetSample(i)->GetNodeId();
+  }
+  *out << R"(],"timeDeltas":[)";
+  int64_t last = profile->GetStartTime();
+  for (int i = 0; i < samples; i++) {
+    if (i > 0) *out << ',';
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    *out << (timestamp - last);
+    last = timestamp;
+  }
+  *out << "]}";
+}
+
+CpuFlightRecorder::CpuFlightRecorder(Environment* env) : env_(env) {}
+
+CpuFlightRecorder::~CpuFlightRecorder() {
+  // StopRecording() has run as a cleanup hook by the time the Environment
+  // destroys us; nothing is left to tear down here.
+  CHECK(!started_);
+}
+
+void CpuFlightRecorder::Start() {
+  CHECK(!started_);
+  started_ = true;
+
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+
+  profiler_ = v8::CpuProfiler::New(isolate);
+  profiler_->SetSamplingInterval(
+      static_cast<int>(env_->cpu_prof_interval()));
+  StartWindow(0);
+  current_ = 0;
+
+  // Rotate twice per retention window so the older of the two running
+  // profiles always covers at least half of it.
+  uint64_t half_window_ms =
+      env_->options()->cpu_prof_flight_window * 1000 / 2;
+  CHECK_EQ(uv_timer_init(env_->event_loop(), &rotate_timer_), 0);
+  rotate_timer_.data = this;
+  uv_timer_start(&rotate_timer_, RotateTimerCb,
+                 half_window_ms, half_window_ms);
+  // Sampling must not keep the event loop alive on its own.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&rotate_timer_));
+
+  env_->AddCleanupHook(
+      [](void* data) {
+        static_cast<CpuFlightRecorder*>(data)->StopRecording();
+      },
+      this);
+}
+
+void CpuFlightRecorder::StopRecording() {
+  if (!started_) return;
+  started_ = false;
+
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+
+  uv_timer_stop(&rotate_timer_);
+  env_->CloseHandle(&rotate_timer_, [](uv_timer_t*) {});
+
+  // Drop retained windows; by design nothing is serialized here.
+  for (int i = 0; i < 2; i++) {
+    if (!running_[i]) continue;
+    v8::CpuProfile* profile =
+        profiler_->StopProfiling(FlightWindowName(isolate, i));
+    if (profile != nullptr) profile->Delete();
+    running_[i] = false;
+  }
+  profiler_->Dispose();
+  profiler_ = nullptr;
+}
+
+void CpuFlightRecorder::RotateTimerCb(uv_timer_t* handle) {
+  static_cast<CpuFlightRecorder*>(handle->data)->Rotate();
+}
+
+void CpuFlightRecorder::StartWindow(int slot) {
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+  profiler_->StartProfiling(FlightWindowName(isolate, slot), true);
+  running_[slot] = true;
+}
+
+void CpuFlightRecorder::Rotate() {
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+
+  int next = 1 - current_;
+  if (running_[next]) {
+    // This window is now older than the retention limit; discard its
+    // samples without serialization.
+    v8::CpuProfile* profile =
+        profiler_->StopProfiling(FlightWindowName(isolate, next));
+    if (profile != nullptr) profile->Delete();
+    running_[next] = false;
+  }
+  StartWindow(next);
+  current_ = next;
+}
+
+std::string CpuFlightRecorder::Dump(const std::string& requested_path) {
+  if (!started_) return std::string();
+
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env_->context());
+
+  // The older of the two running windows holds the longest history,
+  // including everything sampled since it was started.
+  int oldest = running_[1 - current_] ? 1 - current_ : current_;
+  v8::CpuProfile* profile =
+      profiler_->StopProfiling(FlightWindowName(isolate, oldest));
+  running_[oldest] = false;
+  if (profile == nullptr) return std::string();
+
+  std::ostringstream out;
+  SerializeCpuProfile(profile, &out);
+  profile->Delete();
+
+  // Keep recording; the dumped window restarts empty.
+  StartWindow(oldest);
+  current_ = oldest;
+
+  std::string path = requested_path;
+  if (path.empty()) {
+    std::string directory = env_->cpu_prof_dir();
+    DCHECK(!directory.empty());
+    if (!EnsureDirectory(directory, "CPU flight")) {
+      return std::string();
+    }
+    DiagnosticFilename filename(env_, "CPU-flight", "cpuprofile");
+    path = directory + kPathSeparator + *filename;
+  }
+
+  std::string json = out.str();
+  Local<String> result;
+  if (!String::NewFromUtf8(isolate,
+                           json.c_str(),
+                           NewStringType::kNormal,
+                           static_cast<int>(json.length()))
+           .ToLocal(&result)) {
+    fprintf(stderr, "Failed to convert CPU flight profile\n");
+    return std::string();
+  }
+  WriteResult(env_, path.c_str(), result);
+  return path;
+}
+
 // For now, we only support coverage profiling, but we may add more
 // in the future.
 static void EndStartedProfilers(Environment* env) {
@@ -429,6 +898,14 @@ void StartProfilers(Environment* env) {
         std::make_unique<V8CpuProfilerConnection>(env));
     env->cpu_profiler_connection()->Start();
   }
+  if (env->options()->cpu_prof_flight_recorder) {
+    const std::string& dir = env->options()->cpu_prof_dir;
+    env->set_cpu_prof_interval(env->options()->cpu_prof_interval);
+    env->set_cpu_prof_dir(dir.empty() ? GetCwd(env) : dir);
+    CHECK_NULL(env->cpu_flight_recorder());
+    env->set_cpu_flight_recorder(std::make_unique<CpuFlightRecorder>(env));
+    env->cpu_flight_recorder()->Start();
+  }
   if (env->options()->heap_prof) {
     const std::string& dir = env->options()->heap_prof_dir;
     env->set_heap_prof_interval(env->options()->heap_prof_interval);
@@ -459,6 +936,29 @@ static void SetSourceMapCacheGetter(const FunctionCallbackInfo<Value>& args) {
   env->set_source_map_cache_getter(args[0].As<Function>());
 }
 
+static void DumpCpuFlightRecorder(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CpuFlightRecorder* recorder = env->cpu_flight_recorder();
+  if (recorder == nullptr) return;
+
+  std::string requested_path;
+  if (args[0]->IsString()) {
+    node::Utf8Value path(env->isolate(), args[0].As<String>());
+    requested_path = *path;
+  }
+  std::string written = recorder->Dump(requested_path);
+  if (written.empty()) return;
+
+  Local<String> result;
+  if (String::NewFromUtf8(env->isolate(),
+                          written.c_str(),
+                          NewStringType::kNormal,
+                          static_cast<int>(written.length()))
+          .ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
 static void Initialize(Local<Object> target,
                        Local<Value> unused,
                        Local<Context> context,
@@ -466,6 +966,7 @@ static void Initialize(Local<Object> target,
   Environment* env = Environment::GetCurrent(context);
   env->SetMethod(target, "setCoverageDirectory", SetCoverageDirectory);
   env->SetMethod(target, "setSourceMapCacheGetter", SetSourceMapCacheGetter);
+  env->SetMethod(target, "dumpCpuFlightRecorder", DumpCpuFlightRecorder);
 }
 
 }  // namespace profiler
@@ -8,6 +8,15 @@
 #endif
 
 #include "inspector_agent.h"
+#include "uv.h"
+
+#include <set>
+#include <string>
+
+namespace v8 {
+class CpuProfile;
+class CpuProfiler;
+}  // namespace v8
 
 namespace node {
 // Forward declaration to break recursive dependency chain with src/env.h.
@@ -41,11 +50,21 @@ class V8ProfilerConnection {
   // the commands we use here.
   size_t DispatchMessage(const char* method, const char* params = nullptr);
 
+  // Return the id the next DispatchMessage() call will use. Responses can
+  // be delivered synchronously during dispatch, so callers that need to
+  // recognize a response by id must register it before dispatching.
+  size_t next_message_id() const { return id_; }
+
   // Use DispatchMessage() to dispatch necessary inspector messages
   // to start and end the profiling.
   virtual void Start() = 0;
   virtual void End() = 0;
 
+  // Called for responses that arrive while the profile is not ending,
+  // e.g. intermediate data taken while the process is still running.
+  // The default is to discard them.
+  virtual void OnMessage(const v8_inspector::StringView& message) {}
+
   // Return a descriptive name of the profile for debugging.
   virtual const char* type() const = 0;
   // Return if the profile is ending and the response can be parsed.
@@ -75,6 +94,7 @@ class V8CoverageConnection : public V8ProfilerConnection {
 
   void Start() override;
   void End() override;
+  void OnMessage(const v8_inspector::StringView& message) override;
 
   const char* type() const override { return "coverage"; }
   bool ending() const override { return ending_; }
@@ -86,8 +106,22 @@ class V8CoverageConnection : public V8ProfilerConnection {
   void WriteSourceMapCache();
 
  private:
+  // With --coverage-stream-interval, incremental Profiler.takePreciseCoverage
+  // deltas are appended to a stream file as length-prefixed records on the
+  // threadpool instead of one JSON dump of the accumulated result at exit.
+  static void StreamTimerCb(uv_timer_t* handle);
+  void StartStreaming();
+  void StopStreaming();
+  void TakeCoverageDelta();
+  void AppendCoverageDelta(v8::Local<v8::String> message);
+
   std::unique_ptr<inspector::InspectorSession> session_;
   bool ending_ = false;
+  bool streaming_ = false;
+  uv_timer_t stream_timer_;
+  int stream_fd_ = -1;
+  // Ids of takePreciseCoverage messages whose responses carry a delta.
+  std::set<size_t> pending_delta_ids_;
 };
 
 class V8CpuProfilerConnection : public V8ProfilerConnection {
@@ -130,6 +164,44 @@ class V8HeapProfilerConnection : public V8ProfilerConnection {
   bool ending_ = false;
 };
 
+// Always-on sampling profiler with bounded retention, for incident
+// forensics. Unlike V8CpuProfilerConnection it does not go through the
+// inspector protocol: samples accumulate in two overlapping in-memory
+// profiles that are rotated and discarded without JSON serialization, so at
+// any time roughly the last --cpu-prof-flight-window seconds are available.
+// Dump() serializes the retained window to a .cpuprofile file on demand.
+class CpuFlightRecorder {
+ public:
+  explicit CpuFlightRecorder(Environment* env);
+  ~CpuFlightRecorder();
+
+  void Start();
+  // Stop sampling and discard whatever is retained. Runs as an Environment
+  // cleanup hook; safe to call more than once.
+  void StopRecording();
+  // Write the retained samples to `path`, or to an auto-generated file in
+  // env->cpu_prof_dir() when `path` is empty. Returns the path written to,
+  // or an empty string on failure.
+  std::string Dump(const std::string& path);
+
+  Environment* env() const { return env_; }
+
+ private:
+  static void RotateTimerCb(uv_timer_t* handle);
+  void Rotate();
+  void StartWindow(int slot);
+
+  Environment* env_;
+  v8::CpuProfiler* profiler_ = nullptr;
+  uv_timer_t rotate_timer_;
+  // Two overlapping sampling windows; the older one always holds at least
+  // half the configured retention. `running_[i]` tells whether window i is
+  // collecting, `current_` which one was started most recently.
+  bool running_[2] = { false, false };
+  int current_ = 0;
+  bool started_ = false;
+};
+
 }  // namespace profiler
 }  // namespace node
 
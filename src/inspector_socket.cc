@@ -1,5 +1,6 @@
 #include "inspector_socket.h"
 #include "llhttp.h"
+#include "zlib.h"
 
 #include "base64.h"
 #include "util-inl.h"
@@ -198,10 +199,14 @@ const size_t kTwoBytePayloadLengthField = 126;
 const size_t kEightBytePayloadLengthField = 127;
 const size_t kMaskingKeyWidthInBytes = 4;
 
-static std::vector<char> encode_frame_hybi17(const std::vector<char>& message) {
+static std::vector<char> encode_frame_hybi17(const std::vector<char>& message,
+                                             bool compressed) {
   std::vector<char> frame;
   OpCode op_code = kOpCodeText;
-  frame.push_back(kFinalBit | op_code);
+  unsigned char first_byte = kFinalBit | op_code;
+  if (compressed)
+    first_byte |= kReserved1Bit;
+  frame.push_back(first_byte);
   const size_t data_length = message.size();
   if (data_length <= kMaxSingleBytePayloadLength) {
     frame.push_back(static_cast<char>(data_length));
@@ -315,16 +320,30 @@ static ws_decode_result decode_frame_hybi17(const std::vector<char>& buffer,
 // WS protocol
 class WsHandler : public ProtocolHandler {
  public:
-  WsHandler(InspectorSocket* inspector, TcpHolder::Pointer tcp)
+  WsHandler(InspectorSocket* inspector, TcpHolder::Pointer tcp,
+            bool compression_enabled)
             : ProtocolHandler(inspector, std::move(tcp)),
               OnCloseSent(&WsHandler::WaitForCloseReply),
               OnCloseRecieved(&WsHandler::CloseFrameReceived),
-              dispose_(false) { }
+              compression_(compression_enabled),
+              dispose_(false) {
+    if (compression_) {
+      // Raw deflate with the default 15-bit window and context takeover,
+      // matching the parameterless permessage-deflate the handshake accepts.
+      memset(&deflate_stream_, 0, sizeof(deflate_stream_));
+      CHECK_EQ(Z_OK, deflateInit2(&deflate_stream_, Z_DEFAULT_COMPRESSION,
+                                  Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY));
+      memset(&inflate_stream_, 0, sizeof(inflate_stream_));
+      CHECK_EQ(Z_OK, inflateInit2(&inflate_stream_, -15));
+    }
+  }
 
   void AcceptUpgrade(const std::string& accept_key) override { }
   void CancelHandshake() override {}
 
   void OnEof() override {
+    pending_.clear();
+    CloseFlushCheck();
     tcp_.reset();
     if (dispose_)
       delete this;
@@ -343,20 +362,35 @@ class WsHandler : public ProtocolHandler {
   }
 
   void Write(const std::vector<char> data) override {
-    std::vector<char> output = encode_frame_hybi17(data);
-    WriteRaw(output, WriteRequest::Cleanup);
+    std::vector<char> frame = compression_
+        ? encode_frame_hybi17(CompressMessage(data), true)
+        : encode_frame_hybi17(data, false);
+    // Frames written during one loop turn are coalesced into a single TCP
+    // write - protocols like heap snapshot streaming emit large numbers of
+    // small messages back to back.
+    pending_.insert(pending_.end(), frame.begin(), frame.end());
+    ScheduleFlush();
   }
 
  protected:
   void Shutdown() override {
     if (tcp_) {
       dispose_ = true;
+      Flush();
       SendClose();
     } else {
       delete this;
     }
   }
 
+  ~WsHandler() override {
+    CloseFlushCheck();
+    if (compression_) {
+      deflateEnd(&deflate_stream_);
+      inflateEnd(&inflate_stream_);
+    }
+  }
+
  private:
   using Callback = void (WsHandler::*)();
 
@@ -379,9 +413,88 @@ class WsHandler : public ProtocolHandler {
 
   void CloseFrameReceived() {
     OnCloseSent = &WsHandler::OnEof;
+    Flush();
     SendClose();
   }
 
+  void ScheduleFlush() {
+    if (flush_check_ == nullptr) {
+      flush_check_ = new uv_check_t();
+      CHECK_EQ(0, uv_check_init(tcp_->tcp()->loop, flush_check_));
+      flush_check_->data = this;
+    }
+    if (!uv_is_active(reinterpret_cast<uv_handle_t*>(flush_check_)))
+      uv_check_start(flush_check_, FlushCb);
+  }
+
+  static void FlushCb(uv_check_t* check) {
+    WsHandler* handler = static_cast<WsHandler*>(check->data);
+    uv_check_stop(check);
+    handler->Flush();
+  }
+
+  void Flush() {
+    if (pending_.empty())
+      return;
+    std::vector<char> output;
+    std::swap(output, pending_);
+    if (tcp_)
+      WriteRaw(output, WriteRequest::Cleanup);
+  }
+
+  void CloseFlushCheck() {
+    if (flush_check_ == nullptr)
+      return;
+    uv_check_stop(flush_check_);
+    uv_close(reinterpret_cast<uv_handle_t*>(flush_check_),
+             [](uv_handle_t* handle) {
+               delete reinterpret_cast<uv_check_t*>(handle);
+             });
+    flush_check_ = nullptr;
+  }
+
+  std::vector<char> CompressMessage(const std::vector<char>& message) {
+    std::vector<char> output(
+        deflateBound(&deflate_stream_, message.size()) + 16);
+    deflate_stream_.next_in = reinterpret_cast<Bytef*>(
+        const_cast<char*>(message.data()));
+    deflate_stream_.avail_in = static_cast<uInt>(message.size());
+    deflate_stream_.next_out = reinterpret_cast<Bytef*>(output.data());
+    deflate_stream_.avail_out = static_cast<uInt>(output.size());
+    CHECK_EQ(Z_OK, deflate(&deflate_stream_, Z_SYNC_FLUSH));
+    CHECK_GT(deflate_stream_.avail_out, 0u);
+    output.resize(output.size() - deflate_stream_.avail_out);
+    // Z_SYNC_FLUSH always ends the output with an empty stored block;
+    // permessage-deflate transmits the message without it.
+    CHECK_GE(output.size(), 4u);
+    output.resize(output.size() - 4);
+    return output;
+  }
+
+  bool DecompressMessage(const std::vector<char>& message,
+                         std::vector<char>* output) {
+    // Restore the empty stored block the sender stripped off.
+    static const char kMessageTail[] = {'\x00', '\x00', '\xFF', '\xFF'};
+    std::vector<char> input(message);
+    input.insert(input.end(), kMessageTail,
+                 kMessageTail + sizeof(kMessageTail));
+    inflate_stream_.next_in = reinterpret_cast<Bytef*>(input.data());
+    inflate_stream_.avail_in = static_cast<uInt>(input.size());
+    do {
+      char chunk[65536];
+      inflate_stream_.next_out = reinterpret_cast<Bytef*>(chunk);
+      inflate_stream_.avail_out = sizeof(chunk);
+      int ret = inflate(&inflate_stream_, Z_NO_FLUSH);
+      if (ret == Z_BUF_ERROR)
+        break;  // No more progress is possible.
+      if (ret != Z_OK)
+        return false;
+      output->insert(output->end(), chunk,
+                     chunk + sizeof(chunk) - inflate_stream_.avail_out);
+    } while (inflate_stream_.avail_in > 0 || inflate_stream_.avail_out == 0);
+    return true;
+  }
+
   int ParseWsFrames(const std::vector<char>& buffer) {
     int bytes_consumed = 0;
     std::vector<char> output;
@@ -391,15 +504,25 @@ class WsHandler : public ProtocolHandler {
                                               true /* client_frame */,
                                               &bytes_consumed, &output,
                                               &compressed);
-    // Compressed frame means client is ignoring the headers and misbehaves
-    if (compressed || r == FRAME_ERROR) {
+    // Compressed frame without negotiated compression means the client is
+    // ignoring the headers and misbehaves
+    if ((compressed && !compression_) || r == FRAME_ERROR) {
       OnEof();
       bytes_consumed = 0;
     } else if (r == FRAME_CLOSE) {
       (this->*OnCloseRecieved)();
       bytes_consumed = 0;
     } else if (r == FRAME_OK) {
-      delegate()->OnWsFrame(output);
+      if (compressed) {
+        std::vector<char> decompressed;
+        if (!DecompressMessage(output, &decompressed)) {
+          OnEof();
+          return 0;
+        }
+        delegate()->OnWsFrame(decompressed);
+      } else {
+        delegate()->OnWsFrame(output);
+      }
     }
     return bytes_consumed;
   }
@@ -407,29 +530,76 @@ class WsHandler : public ProtocolHandler {
 
   Callback OnCloseSent;
   Callback OnCloseRecieved;
+  std::vector<char> pending_;
+  uv_check_t* flush_check_ = nullptr;
+  z_stream deflate_stream_;
+  z_stream inflate_stream_;
+  const bool compression_;
   bool dispose_;
 };
 
+// Returns true if one of the offers in a Sec-WebSocket-Extensions header
+// is permessage-deflate in a configuration the frame layer supports: the
+// parameterless response implies 15-bit windows with context takeover, so
+// offers constraining the server side are declined. Parameters that only
+// concern the client side are hints and can be ignored.
+static bool OffersPermessageDeflate(const std::string& extensions) {
+  size_t start = 0;
+  while (start < extensions.size()) {
+    size_t end = extensions.find(',', start);
+    if (end == std::string::npos)
+      end = extensions.size();
+    std::string offer = extensions.substr(start, end - start);
+    start = end + 1;
+    bool token_matched = false;
+    bool acceptable = true;
+    size_t param_start = 0;
+    while (param_start < offer.size()) {
+      size_t param_end = offer.find(';', param_start);
+      if (param_end == std::string::npos)
+        param_end = offer.size();
+      std::string param = offer.substr(param_start, param_end - param_start);
+      bool first_param = param_start == 0;
+      param_start = param_end + 1;
+      size_t first = param.find_first_not_of(" \t");
+      if (first == std::string::npos)
+        continue;
+      param = param.substr(first, param.find_last_not_of(" \t") - first + 1);
+      if (first_param) {
+        token_matched = param == "permessage-deflate";
+      } else if (param.compare(0, sizeof("server_") - 1, "server_") == 0) {
+        acceptable = false;
+      }
+    }
+    if (token_matched && acceptable)
+      return true;
+  }
+  return false;
+}
+
 // HTTP protocol
 class HttpEvent {
  public:
   HttpEvent(const std::string& path, bool upgrade, bool isGET,
-            const std::string& ws_key, const std::string& host)
+            const std::string& ws_key, const std::string& host,
+            bool deflate)
             : path(path), upgrade(upgrade), isGET(isGET), ws_key(ws_key),
-              host(host) { }
+              host(host), deflate(deflate) { }
 
   std::string path;
   bool upgrade;
   bool isGET;
   std::string ws_key;
   std::string host;
+  bool deflate;
 };
 
 class HttpHandler : public ProtocolHandler {
  public:
   explicit HttpHandler(InspectorSocket* inspector, TcpHolder::Pointer tcp)
                        : ProtocolHandler(inspector, std::move(tcp)),
-                         parsing_value_(false) {
+                         parsing_value_(false),
+                         deflate_accepted_(false) {
     llhttp_init(&parser_, HTTP_REQUEST, &parser_settings);
     llhttp_settings_init(&parser_settings);
     parser_settings.on_header_field = OnHeaderField;
@@ -445,15 +615,22 @@ class HttpHandler : public ProtocolHandler {
                                     "Upgrade: websocket\r\n"
                                     "Connection: Upgrade\r\n"
                                     "Sec-WebSocket-Accept: ";
+    const char accept_ws_deflate[] =
+        "\r\nSec-WebSocket-Extensions: permessage-deflate";
     const char accept_ws_suffix[] = "\r\n\r\n";
     std::vector<char> reply(accept_ws_prefix,
                             accept_ws_prefix + sizeof(accept_ws_prefix) - 1);
     reply.insert(reply.end(), accept_string,
                  accept_string + sizeof(accept_string));
+    if (deflate_accepted_) {
+      reply.insert(reply.end(), accept_ws_deflate,
+                   accept_ws_deflate + sizeof(accept_ws_deflate) - 1);
+    }
     reply.insert(reply.end(), accept_ws_suffix,
                  accept_ws_suffix + sizeof(accept_ws_suffix) - 1);
     if (WriteRaw(reply, WriteRequest::Cleanup) >= 0) {
-      inspector_->SwitchProtocol(new WsHandler(inspector_, std::move(tcp_)));
+      inspector_->SwitchProtocol(
+          new WsHandler(inspector_, std::move(tcp_), deflate_accepted_));
     } else {
       tcp_.reset();
     }
@@ -499,6 +676,7 @@ class HttpHandler : public ProtocolHandler {
         CancelHandshake();
         return;
       } else {
+        deflate_accepted_ = event.deflate;
         delegate()->OnSocketUpgrade(event.host, event.path, event.ws_key);
       }
     }
@@ -550,11 +728,14 @@ class HttpHandler : public ProtocolHandler {
   static int OnMessageComplete(llhttp_t* parser) {
     // Event needs to be fired after the parser is done.
     HttpHandler* handler = From(parser);
-    handler->events_.emplace_back(handler->path_,
-                                  parser->upgrade,
-                                  parser->method == HTTP_GET,
-                                  handler->HeaderValue("Sec-WebSocket-Key"),
-                                  handler->HeaderValue("Host"));
+    handler->events_.emplace_back(
+        handler->path_,
+        parser->upgrade,
+        parser->method == HTTP_GET,
+        handler->HeaderValue("Sec-WebSocket-Key"),
+        handler->HeaderValue("Host"),
+        OffersPermessageDeflate(
+            handler->HeaderValue("Sec-WebSocket-Extensions")));
     handler->path_ = "";
     handler->parsing_value_ = false;
     handler->headers_.clear();
@@ -585,6 +766,7 @@ class HttpHandler : public ProtocolHandler {
   }
 
   bool parsing_value_;
+  bool deflate_accepted_;
   llhttp_t parser_;
   llhttp_settings_t parser_settings;
   std::vector<HttpEvent> events_;
@@ -522,6 +522,41 @@ NAPI_EXTERN napi_status napi_detach_arraybuffer(napi_env env,
 NAPI_EXTERN napi_status napi_is_detached_arraybuffer(napi_env env,
                                                      napi_value value,
                                                      bool* result);
+
+// Vectored calls
+NAPI_EXTERN napi_status napi_execute_ops(napi_env env,
+                                         const napi_op* ops,
+                                         size_t op_count,
+                                         napi_value* slots,
+                                         size_t slot_count);
+
+// External strings
+NAPI_EXTERN napi_status
+napi_create_external_string_latin1(napi_env env,
+                                   char* str,
+                                   size_t length,
+                                   napi_finalize finalize_callback,
+                                   void* finalize_hint,
+                                   napi_value* result,
+                                   bool* copied);
+NAPI_EXTERN napi_status
+napi_create_external_string_utf16(napi_env env,
+                                  char16_t* str,
+                                  size_t length,
+                                  napi_finalize finalize_callback,
+                                  void* finalize_hint,
+                                  napi_value* result,
+                                  bool* copied);
+
+// Callback info access without argument copying
+NAPI_EXTERN napi_status
+napi_get_cb_info_view(napi_env env,
+                      napi_callback_info cbinfo,
+                      napi_callback_info_view* result);
+NAPI_EXTERN napi_status napi_get_cb_arg(napi_env env,
+                                        napi_callback_info cbinfo,
+                                        size_t index,
+                                        napi_value* result);
 #endif  // NAPI_EXPERIMENTAL
 
 EXTERN_C_END
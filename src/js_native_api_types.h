@@ -115,4 +115,37 @@ typedef struct {
   napi_status error_code;
 } napi_extended_error_info;
 
+#ifdef NAPI_EXPERIMENTAL
+typedef enum {
+  napi_op_create_object,
+  napi_op_get_property,
+  napi_op_set_property,
+  napi_op_get_element,
+  napi_op_set_element,
+  napi_op_call_function
+} napi_op_code;
+
+// One operation of a vectored call executed by napi_execute_ops(). Operands
+// are indexes into the slot array passed alongside the op array, except that
+// for the element ops `key` is the literal element index, and for
+// napi_op_call_function `key` is the argument count.
+typedef struct {
+  napi_op_code code;
+  uint32_t target;
+  uint32_t key;
+  uint32_t value;
+  uint32_t result;
+} napi_op;
+
+// Snapshot of a callback invocation filled in by napi_get_cb_info_view();
+// one call replaces separate napi_get_cb_info() and
+// napi_get_instance_data() calls in hot callbacks.
+typedef struct {
+  size_t argc;
+  napi_value this_arg;
+  void* data;
+  void* instance_data;
+} napi_callback_info_view;
+#endif  // NAPI_EXPERIMENTAL
+
 #endif  // SRC_JS_NATIVE_API_TYPES_H_
@@ -57,12 +57,39 @@ namespace v8impl {
 
 namespace {
 
+// Upper bound on the number of property names cached per environment; names
+// beyond this (an addon generating property names dynamically) fall back to
+// uncached creation.
+constexpr size_t kPropertyNameCacheMaxSize = 4096;
+
+// Returns an internalized name for `str`, cached per environment so that
+// repeated class and property definitions - context-aware addons run their
+// whole init once per worker - and named-property access skip the UTF-8
+// decode and internalization on every call.
+inline static napi_status V8NameFromCachedUtf8(napi_env env,
+                                               const char* str,
+                                               v8::Local<v8::Name>* result) {
+  auto it = env->property_name_cache.find(str);
+  if (it != env->property_name_cache.end()) {
+    *result = v8::Local<v8::Name>::New(env->isolate, it->second);
+    return napi_ok;
+  }
+
+  v8::Local<v8::Name> name;
+  CHECK_NEW_FROM_UTF8(env, name, str);
+  if (env->property_name_cache.size() < kPropertyNameCacheMaxSize) {
+    env->property_name_cache[str].Reset(env->isolate, name);
+  }
+  *result = name;
+  return napi_ok;
+}
+
 inline static napi_status
 V8NameFromPropertyDescriptor(napi_env env,
                              const napi_property_descriptor* p,
                              v8::Local<v8::Name>* result) {
   if (p->utf8name != nullptr) {
-    CHECK_NEW_FROM_UTF8(env, *result, p->utf8name);
+    return V8NameFromCachedUtf8(env, p->utf8name, result);
   } else {
     v8::Local<v8::Value> property_value =
       v8impl::V8LocalValueFromJsValue(p->name);
@@ -185,6 +212,10 @@ inline static napi_status ConcludeDeferred(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+// Upper bound on the number of recycled Reference memory blocks kept per
+// environment before falling back to the allocator.
+constexpr size_t kReferencePoolMaxSize = 1024;
+
 // Wrapper around v8impl::Persistent that implements reference counting.
 class Reference : protected Finalizer, RefTracker {
  protected:
@@ -209,6 +240,17 @@ class Reference : protected Finalizer, RefTracker {
   }
 
  public:
+  ~Reference() {
+    // If the weak callback already queued this reference for batched
+    // finalization, drop it from the queue: either the environment is being
+    // torn down or an explicit delete got here first.
+    std::vector<RefTracker*>& queue = _env->finalization_queue;
+    queue.erase(std::remove(queue.begin(),
+                            queue.end(),
+                            static_cast<RefTracker*>(this)),
+                queue.end());
+  }
+
   void* Data() {
     return _finalize_data;
   }
@@ -220,7 +262,7 @@ class Reference : protected Finalizer, RefTracker {
                         napi_finalize finalize_callback = nullptr,
                         void* finalize_data = nullptr,
                         void* finalize_hint = nullptr) {
-    return new Reference(env,
+    return new(AllocateBlock(env)) Reference(env,
       value,
       initial_refcount,
       delete_self,
@@ -249,7 +291,9 @@ class Reference : protected Finalizer, RefTracker {
     if ((reference->RefCount() != 0) ||
         (reference->_delete_self) ||
         (reference->_finalize_ran)) {
-      delete reference;
+      napi_env env = reference->_env;
+      reference->~Reference();
+      FreeBlock(env, reference);
     } else {
       // defer until finalizer runs as
       // it may alread be queued
@@ -310,6 +354,26 @@ class Reference : protected Finalizer, RefTracker {
     }
   }
 
+  // Reference objects are carved out of a per-env free list of uniformly
+  // sized memory blocks. All subclasses must therefore have the same size as
+  // Reference itself; this is asserted below the subclass definitions.
+  static void* AllocateBlock(napi_env env) {
+    if (!env->reference_pool.empty()) {
+      void* block = env->reference_pool.back();
+      env->reference_pool.pop_back();
+      return block;
+    }
+    return ::operator new(sizeof(Reference));
+  }
+
+  static void FreeBlock(napi_env env, void* block) {
+    if (env->reference_pool.size() < kReferencePoolMaxSize) {
+      env->reference_pool.push_back(block);
+    } else {
+      ::operator delete(block);
+    }
+  }
+
  private:
   // The N-API finalizer callback may make calls into the engine. V8's heap is
   // not in a consistent state during the weak callback, and therefore it does
@@ -318,17 +382,36 @@ class Reference : protected Finalizer, RefTracker {
   // attach such a second-pass finalizer from the first pass finalizer. Thus,
   // we do that here to ensure that the N-API finalizer callback is free to call
   // into the engine.
+  //
+  // Rather than attaching one second-pass callback per reference, every
+  // reference collected during a GC cycle is pushed onto a per-env queue and
+  // only the first one schedules a second-pass callback, which then drains
+  // the whole queue. This keeps the number of GC interruptions independent of
+  // the number of collected references.
   static void FinalizeCallback(const v8::WeakCallbackInfo<Reference>& data) {
     Reference* reference = data.GetParameter();
 
     // The reference must be reset during the first pass.
     reference->_persistent.Reset();
 
-    data.SetSecondPassCallback(SecondPassCallback);
+    napi_env env = reference->_env;
+    env->finalization_queue.push_back(static_cast<RefTracker*>(reference));
+    if (!env->finalization_scheduled) {
+      env->finalization_scheduled = true;
+      data.SetSecondPassCallback(SecondPassCallback);
+    }
   }
 
   static void SecondPassCallback(const v8::WeakCallbackInfo<Reference>& data) {
-    data.GetParameter()->Finalize();
+    napi_env env = data.GetParameter()->_env;
+    env->finalization_scheduled = false;
+    // Pop each entry before finalizing it: a finalizer may delete other
+    // queued references, which removes them from the queue via ~Reference().
+    while (!env->finalization_queue.empty()) {
+      RefTracker* reference = env->finalization_queue.back();
+      env->finalization_queue.pop_back();
+      reference->Finalize(false);
+    }
   }
 
   v8impl::Persistent<v8::Value> _persistent;
@@ -350,7 +433,8 @@ class ArrayBufferReference final : public Reference {
   static ArrayBufferReference* New(napi_env env,
                                    v8::Local<v8::ArrayBuffer> value,
                                    Args&&... args) {
-    return new ArrayBufferReference(env, value, std::forward<Args>(args)...);
+    return new(AllocateBlock(env))
+        ArrayBufferReference(env, value, std::forward<Args>(args)...);
   }
 
  private:
@@ -367,11 +451,39 @@ class ArrayBufferReference final : public Reference {
   }
 };
 
+// Reference subclasses share the uniformly sized blocks handed out by
+// Reference::AllocateBlock(), so they must not add data members.
+static_assert(sizeof(ArrayBufferReference) == sizeof(Reference),
+              "ArrayBufferReference must have the same size as Reference");
+
 enum UnwrapAction {
   KeepWrap,
   RemoveWrap
 };
 
+// Instances created from napi_define_class() templates carry two internal
+// fields: slot 0 holds the wrap Reference and slot 1 a type tag telling
+// Unwrap() that the external in slot 0 is ours. This avoids the private
+// property dictionary lookup on every unwrap; objects not created from a
+// napi class keep using the private-property path.
+constexpr int kWrapInternalFieldCount = 2;
+constexpr int kWrapReferenceField = 0;
+constexpr int kWrapTypeTagField = 1;
+// Only the address of this variable is used, as the identity behind the
+// type tag external stored in slot 1.
+static const char kWrapTypeTag = 0;
+
+inline static bool HasWrapInternalFields(v8::Local<v8::Object> obj) {
+  return obj->InternalFieldCount() == kWrapInternalFieldCount;
+}
+
+inline static bool IsWrapTagged(v8::Local<v8::Object> obj) {
+  v8::Local<v8::Value> tag = obj->GetInternalField(kWrapTypeTagField);
+  return tag->IsExternal() &&
+      tag.As<v8::External>()->Value() ==
+          const_cast<char*>(&kWrapTypeTag);
+}
+
 inline static napi_status Unwrap(napi_env env,
                                  napi_value js_object,
                                  void** result,
@@ -389,10 +501,29 @@ inline static napi_status Unwrap(napi_env env,
   RETURN_STATUS_IF_FALSE(env, value->IsObject(), napi_invalid_arg);
   v8::Local<v8::Object> obj = value.As<v8::Object>();
 
+  Reference* reference = nullptr;
+  if (HasWrapInternalFields(obj) && IsWrapTagged(obj)) {
+    reference = static_cast<v8impl::Reference*>(
+        obj->GetInternalField(kWrapReferenceField)
+            .As<v8::External>()->Value());
+
+    if (result) {
+      *result = reference->Data();
+    }
+
+    if (action == RemoveWrap) {
+      obj->SetInternalField(kWrapReferenceField, v8::Undefined(isolate));
+      obj->SetInternalField(kWrapTypeTagField, v8::Undefined(isolate));
+      Reference::Delete(reference);
+    }
+
+    return GET_RETURN_STATUS(env);
+  }
+
   auto val = obj->GetPrivate(context, NAPI_PRIVATE_KEY(context, wrapper))
       .ToLocalChecked();
   RETURN_STATUS_IF_FALSE(env, val->IsExternal(), napi_invalid_arg);
-  Reference* reference =
+  reference =
       static_cast<v8impl::Reference*>(val.As<v8::External>()->Value());
 
   if (result) {
@@ -432,6 +563,7 @@ class CallbackWrapper {
 
   virtual napi_value GetNewTarget() = 0;
   virtual void Args(napi_value* buffer, size_t bufferlength) = 0;
+  virtual napi_value Arg(size_t index) = 0;
   virtual void SetReturnValue(napi_value value) = 0;
 
   napi_value This() { return _this; }
@@ -523,6 +655,15 @@ class FunctionCallbackWrapper
     }
   }
 
+  /*virtual*/
+  napi_value Arg(size_t index) override {
+    if (index >= _args_length) {
+      return v8impl::JsValueFromV8LocalValue(
+          v8::Undefined(_cbinfo.GetIsolate()));
+    }
+    return v8impl::JsValueFromV8LocalValue(_cbinfo[index]);
+  }
+
   /*virtual*/
   void SetReturnValue(napi_value value) override {
     v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
@@ -555,6 +696,12 @@ class GetterCallbackWrapper
     }
   }
 
+  /*virtual*/
+  napi_value Arg(size_t index) override {
+    return v8impl::JsValueFromV8LocalValue(
+        v8::Undefined(_cbinfo.GetIsolate()));
+  }
+
   /*virtual*/
   void SetReturnValue(napi_value value) override {
     v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
@@ -592,6 +739,15 @@ class SetterCallbackWrapper
     }
   }
 
+  /*virtual*/
+  napi_value Arg(size_t index) override {
+    if (index == 0) {
+      return v8impl::JsValueFromV8LocalValue(_value);
+    }
+    return v8impl::JsValueFromV8LocalValue(
+        v8::Undefined(_cbinfo.GetIsolate()));
+  }
+
   /*virtual*/
   void SetReturnValue(napi_value value) override {
     // Ignore any value returned from a setter callback.
@@ -643,12 +799,18 @@ inline napi_status Wrap(napi_env env,
   RETURN_STATUS_IF_FALSE(env, value->IsObject(), napi_invalid_arg);
   v8::Local<v8::Object> obj = value.As<v8::Object>();
 
+  const bool use_internal_fields = HasWrapInternalFields(obj);
+
   if (wrap_type == retrievable) {
     // If we've already wrapped this object, we error out.
-    RETURN_STATUS_IF_FALSE(env,
-        !obj->HasPrivate(context, NAPI_PRIVATE_KEY(context, wrapper))
-            .FromJust(),
-        napi_invalid_arg);
+    if (use_internal_fields) {
+      RETURN_STATUS_IF_FALSE(env, !IsWrapTagged(obj), napi_invalid_arg);
+    } else {
+      RETURN_STATUS_IF_FALSE(env,
+          !obj->HasPrivate(context, NAPI_PRIVATE_KEY(context, wrapper))
+              .FromJust(),
+          napi_invalid_arg);
+    }
   } else if (wrap_type == anonymous) {
     // If no finalize callback is provided, we error out.
     CHECK_ARG(env, finalize_cb);
@@ -671,13 +833,72 @@ inline napi_status Wrap(napi_env env,
   }
 
   if (wrap_type == retrievable) {
-    CHECK(obj->SetPrivate(context, NAPI_PRIVATE_KEY(context, wrapper),
-          v8::External::New(env->isolate, reference)).FromJust());
+    if (use_internal_fields) {
+      obj->SetInternalField(kWrapReferenceField,
+                            v8::External::New(env->isolate, reference));
+      obj->SetInternalField(kWrapTypeTagField,
+                            v8::External::New(env->isolate,
+                                const_cast<char*>(&kWrapTypeTag)));
+    } else {
+      CHECK(obj->SetPrivate(context, NAPI_PRIVATE_KEY(context, wrapper),
+            v8::External::New(env->isolate, reference)).FromJust());
+    }
   }
 
   return GET_RETURN_STATUS(env);
 }
 
+// Below this length adopting addon-owned memory as an external string is not
+// worth the external-resource bookkeeping; napi_create_external_string_*
+// copies into the V8 heap instead and finalizes the memory right away.
+constexpr size_t kExternalStringMinLength = 64;
+
+// Shared finalize bookkeeping for the one-byte and two-byte external string
+// resources. V8 calls Dispose() once the adopting string is collected.
+template <typename BaseResource, typename CharT>
+class ExternalStringResource : public BaseResource {
+ public:
+  ExternalStringResource(napi_env env,
+                         const CharT* data,
+                         size_t length,
+                         napi_finalize finalize_cb,
+                         void* finalize_hint)
+      : env_(env),
+        data_(data),
+        length_(length),
+        finalize_cb_(finalize_cb),
+        finalize_hint_(finalize_hint) {
+    env_->Ref();
+  }
+
+  ~ExternalStringResource() override { env_->Unref(); }
+
+  const CharT* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+  void Dispose() override {
+    if (finalize_cb_ != nullptr) {
+      v8::HandleScope handle_scope(env_->isolate);
+      env_->CallIntoModuleThrow([&](napi_env env) {
+        finalize_cb_(env, const_cast<CharT*>(data_), finalize_hint_);
+      });
+    }
+    delete this;
+  }
+
+ private:
+  napi_env env_;
+  const CharT* data_;
+  size_t length_;
+  napi_finalize finalize_cb_;
+  void* finalize_hint_;
+};
+
+using ExternalOneByteStringResource =
+    ExternalStringResource<v8::String::ExternalOneByteStringResource, char>;
+using ExternalTwoByteStringResource =
+    ExternalStringResource<v8::String::ExternalStringResource, uint16_t>;
+
 }  // end of anonymous namespace
 
 }  // end of namespace v8impl
@@ -801,6 +1022,11 @@ napi_status napi_define_class(napi_env env,
   CHECK_NEW_FROM_UTF8_LEN(env, name_string, utf8name, length);
   tpl->SetClassName(name_string);
 
+  // Reserve internal fields on instances so napi_wrap()/napi_unwrap() can
+  // bypass the private-property lookup. See `v8impl::Unwrap()`.
+  tpl->InstanceTemplate()->SetInternalFieldCount(
+      v8impl::kWrapInternalFieldCount);
+
   size_t static_property_count = 0;
   for (size_t i = 0; i < property_count; i++) {
     const napi_property_descriptor* p = properties + i;
@@ -1043,7 +1269,8 @@ napi_status napi_set_named_property(napi_env env,
   CHECK_TO_OBJECT(env, context, obj, object);
 
   v8::Local<v8::Name> key;
-  CHECK_NEW_FROM_UTF8(env, key, utf8name);
+  napi_status status = v8impl::V8NameFromCachedUtf8(env, utf8name, &key);
+  if (status != napi_ok) return napi_set_last_error(env, status);
 
   v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
 
@@ -1066,7 +1293,8 @@ napi_status napi_has_named_property(napi_env env,
   CHECK_TO_OBJECT(env, context, obj, object);
 
   v8::Local<v8::Name> key;
-  CHECK_NEW_FROM_UTF8(env, key, utf8name);
+  napi_status status = v8impl::V8NameFromCachedUtf8(env, utf8name, &key);
+  if (status != napi_ok) return napi_set_last_error(env, status);
 
   v8::Maybe<bool> has_maybe = obj->Has(context, key);
 
@@ -1086,7 +1314,8 @@ napi_status napi_get_named_property(napi_env env,
   v8::Local<v8::Context> context = env->context();
 
   v8::Local<v8::Name> key;
-  CHECK_NEW_FROM_UTF8(env, key, utf8name);
+  napi_status status = v8impl::V8NameFromCachedUtf8(env, utf8name, &key);
+  if (status != napi_ok) return napi_set_last_error(env, status);
 
   v8::Local<v8::Object> obj;
 
@@ -1447,6 +1676,119 @@ napi_status napi_create_string_utf16(napi_env env,
   return napi_clear_last_error(env);
 }
 
+napi_status napi_create_external_string_latin1(napi_env env,
+                                               char* str,
+                                               size_t length,
+                                               napi_finalize finalize_callback,
+                                               void* finalize_hint,
+                                               napi_value* result,
+                                               bool* copied) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, str);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH) {
+    length = std::char_traits<char>::length(str);
+  }
+
+  auto isolate = env->isolate;
+
+  if (length < v8impl::kExternalStringMinLength) {
+    auto str_maybe =
+        v8::String::NewFromOneByte(isolate,
+                                   reinterpret_cast<const uint8_t*>(str),
+                                   v8::NewStringType::kNormal,
+                                   length);
+    CHECK_MAYBE_EMPTY(env, str_maybe, napi_generic_failure);
+    *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+
+    // The characters were copied, so the addon-owned memory can be released
+    // right away.
+    if (finalize_callback != nullptr) {
+      v8::HandleScope handle_scope(isolate);
+      env->CallIntoModuleThrow([&](napi_env env) {
+        finalize_callback(env, str, finalize_hint);
+      });
+    }
+    if (copied != nullptr) *copied = true;
+    return napi_clear_last_error(env);
+  }
+
+  auto* resource = new v8impl::ExternalOneByteStringResource(
+      env, str, length, finalize_callback, finalize_hint);
+  auto str_maybe = v8::String::NewExternalOneByte(isolate, resource);
+  if (str_maybe.IsEmpty()) {
+    // Ownership was not taken; free the bookkeeping without finalizing the
+    // addon-owned memory.
+    delete resource;
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+  if (copied != nullptr) *copied = false;
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_create_external_string_utf16(napi_env env,
+                                              char16_t* str,
+                                              size_t length,
+                                              napi_finalize finalize_callback,
+                                              void* finalize_hint,
+                                              napi_value* result,
+                                              bool* copied) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, str);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH) {
+    length = std::char_traits<char16_t>::length(str);
+  }
+
+  auto isolate = env->isolate;
+
+  if (length < v8impl::kExternalStringMinLength) {
+    auto str_maybe =
+        v8::String::NewFromTwoByte(isolate,
+                                   reinterpret_cast<const uint16_t*>(str),
+                                   v8::NewStringType::kNormal,
+                                   length);
+    CHECK_MAYBE_EMPTY(env, str_maybe, napi_generic_failure);
+    *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+
+    // The characters were copied, so the addon-owned memory can be released
+    // right away.
+    if (finalize_callback != nullptr) {
+      v8::HandleScope handle_scope(isolate);
+      env->CallIntoModuleThrow([&](napi_env env) {
+        finalize_callback(env, str, finalize_hint);
+      });
+    }
+    if (copied != nullptr) *copied = true;
+    return napi_clear_last_error(env);
+  }
+
+  auto* resource = new v8impl::ExternalTwoByteStringResource(
+      env, reinterpret_cast<const uint16_t*>(str), length,
+      finalize_callback, finalize_hint);
+  auto str_maybe = v8::String::NewExternalTwoByte(isolate, resource);
+  if (str_maybe.IsEmpty()) {
+    // Ownership was not taken; free the bookkeeping without finalizing the
+    // addon-owned memory.
+    delete resource;
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+  if (copied != nullptr) *copied = false;
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_create_double(napi_env env,
                                double value,
                                napi_value* result) {
@@ -1768,6 +2110,40 @@ napi_status napi_get_cb_info(
   return napi_clear_last_error(env);
 }
 
+napi_status napi_get_cb_info_view(napi_env env,
+                                  napi_callback_info cbinfo,
+                                  napi_callback_info_view* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, cbinfo);
+  CHECK_ARG(env, result);
+
+  v8impl::CallbackWrapper* info =
+      reinterpret_cast<v8impl::CallbackWrapper*>(cbinfo);
+
+  result->argc = info->ArgsLength();
+  result->this_arg = info->This();
+  result->data = info->Data();
+  result->instance_data = env->instance_data.data;
+
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_get_cb_arg(napi_env env,
+                            napi_callback_info cbinfo,
+                            size_t index,
+                            napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, cbinfo);
+  CHECK_ARG(env, result);
+
+  v8impl::CallbackWrapper* info =
+      reinterpret_cast<v8impl::CallbackWrapper*>(cbinfo);
+
+  *result = info->Arg(index);
+
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_get_new_target(napi_env env,
                                 napi_callback_info cbinfo,
                                 napi_value* result) {
@@ -3098,3 +3474,126 @@ napi_status napi_is_detached_arraybuffer(napi_env env,
 
   return napi_clear_last_error(env);
 }
+
+napi_status napi_execute_ops(napi_env env,
+                             const napi_op* ops,
+                             size_t op_count,
+                             napi_value* slots,
+                             size_t slot_count) {
+  // Executes the whole op buffer under a single preamble and exception
+  // check, amortizing the per-call overhead of the equivalent sequence of
+  // individual N-API calls. Execution stops at the first failing op; the
+  // effects of ops already executed are kept.
+  NAPI_PREAMBLE(env);
+  if (op_count > 0) {
+    CHECK_ARG(env, ops);
+  }
+  CHECK_ARG(env, slots);
+
+  v8::Isolate* isolate = env->isolate;
+  v8::Local<v8::Context> context = env->context();
+
+  for (size_t i = 0; i < op_count; i++) {
+    const napi_op* op = &ops[i];
+    switch (op->code) {
+      case napi_op_create_object: {
+        RETURN_STATUS_IF_FALSE(env, op->result < slot_count,
+                               napi_invalid_arg);
+        slots[op->result] =
+            v8impl::JsValueFromV8LocalValue(v8::Object::New(isolate));
+        break;
+      }
+      case napi_op_get_property: {
+        RETURN_STATUS_IF_FALSE(env,
+            op->target < slot_count && op->key < slot_count &&
+                op->result < slot_count,
+            napi_invalid_arg);
+        v8::Local<v8::Value> v8value =
+            v8impl::V8LocalValueFromJsValue(slots[op->target]);
+        RETURN_STATUS_IF_FALSE(env, v8value->IsObject(),
+                               napi_object_expected);
+        auto get_maybe = v8value.As<v8::Object>()->Get(
+            context, v8impl::V8LocalValueFromJsValue(slots[op->key]));
+        CHECK_MAYBE_EMPTY(env, get_maybe, napi_generic_failure);
+        slots[op->result] =
+            v8impl::JsValueFromV8LocalValue(get_maybe.ToLocalChecked());
+        break;
+      }
+      case napi_op_set_property: {
+        RETURN_STATUS_IF_FALSE(env,
+            op->target < slot_count && op->key < slot_count &&
+                op->value < slot_count,
+            napi_invalid_arg);
+        v8::Local<v8::Value> v8value =
+            v8impl::V8LocalValueFromJsValue(slots[op->target]);
+        RETURN_STATUS_IF_FALSE(env, v8value->IsObject(),
+                               napi_object_expected);
+        v8::Maybe<bool> set_maybe = v8value.As<v8::Object>()->Set(
+            context,
+            v8impl::V8LocalValueFromJsValue(slots[op->key]),
+            v8impl::V8LocalValueFromJsValue(slots[op->value]));
+        RETURN_STATUS_IF_FALSE(env, set_maybe.FromMaybe(false),
+                               napi_generic_failure);
+        break;
+      }
+      case napi_op_get_element: {
+        RETURN_STATUS_IF_FALSE(env,
+            op->target < slot_count && op->result < slot_count,
+            napi_invalid_arg);
+        v8::Local<v8::Value> v8value =
+            v8impl::V8LocalValueFromJsValue(slots[op->target]);
+        RETURN_STATUS_IF_FALSE(env, v8value->IsObject(),
+                               napi_object_expected);
+        auto get_maybe = v8value.As<v8::Object>()->Get(context, op->key);
+        CHECK_MAYBE_EMPTY(env, get_maybe, napi_generic_failure);
+        slots[op->result] =
+            v8impl::JsValueFromV8LocalValue(get_maybe.ToLocalChecked());
+        break;
+      }
+      case napi_op_set_element: {
+        RETURN_STATUS_IF_FALSE(env,
+            op->target < slot_count && op->value < slot_count,
+            napi_invalid_arg);
+        v8::Local<v8::Value> v8value =
+            v8impl::V8LocalValueFromJsValue(slots[op->target]);
+        RETURN_STATUS_IF_FALSE(env, v8value->IsObject(),
+                               napi_object_expected);
+        v8::Maybe<bool> set_maybe = v8value.As<v8::Object>()->Set(
+            context, op->key,
+            v8impl::V8LocalValueFromJsValue(slots[op->value]));
+        RETURN_STATUS_IF_FALSE(env, set_maybe.FromMaybe(false),
+                               napi_generic_failure);
+        break;
+      }
+      case napi_op_call_function: {
+        // The receiver lives at `value`, the `key` arguments follow it in
+        // consecutive slots.
+        RETURN_STATUS_IF_FALSE(env,
+            op->target < slot_count && op->result < slot_count &&
+                op->value < slot_count &&
+                op->key <= slot_count - op->value - 1,
+            napi_invalid_arg);
+        v8::Local<v8::Value> fn_value =
+            v8impl::V8LocalValueFromJsValue(slots[op->target]);
+        RETURN_STATUS_IF_FALSE(env, fn_value->IsFunction(),
+                               napi_function_expected);
+        auto call_maybe = fn_value.As<v8::Function>()->Call(
+            context,
+            v8impl::V8LocalValueFromJsValue(slots[op->value]),
+            op->key,
+            reinterpret_cast<v8::Local<v8::Value>*>(&slots[op->value + 1]));
+        if (try_catch.HasCaught()) {
+          return napi_set_last_error(env, napi_pending_exception);
+        }
+        CHECK_MAYBE_EMPTY(env, call_maybe, napi_generic_failure);
+        slots[op->result] =
+            v8impl::JsValueFromV8LocalValue(call_maybe.ToLocalChecked());
+        break;
+      }
+      default:
+        return napi_set_last_error(env, napi_invalid_arg);
+    }
+  }
+
+  return GET_RETURN_STATUS(env);
+}
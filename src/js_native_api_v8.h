@@ -3,6 +3,9 @@
 
 // This file needs to be compatible with C compilers.
 #include <string.h>  // NOLINT(modernize-deprecated-headers)
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "js_native_api_types.h"
 #include "js_native_api_v8_internals.h"
 
@@ -27,6 +30,12 @@ struct napi_env__ {
         instance_data.finalize_cb(env, instance_data.data, instance_data.hint);
       });
     }
+    // Any block still pooled at this point belongs to a reference that has
+    // already been destroyed; the finalizers above may have returned more
+    // blocks to the pool, so this must run last.
+    for (void* block : reference_pool) {
+      ::operator delete(block);
+    }
   }
   v8::Isolate* const isolate;  // Shortcut for context()->GetIsolate()
   v8impl::Persistent<v8::Context> context_persistent;
@@ -72,6 +81,21 @@ struct napi_env__ {
   // have such a callback. See `~napi_env__()` above for details.
   v8impl::RefTracker::RefList reflist;
   v8impl::RefTracker::RefList finalizing_reflist;
+  // References queued by the GC's first-pass weak callback and finalized in
+  // one batch by a single second-pass callback, instead of one second-pass
+  // callback per reference. See `v8impl::Reference`.
+  std::vector<v8impl::RefTracker*> finalization_queue;
+  bool finalization_scheduled = false;
+  // Recycled memory blocks for `v8impl::Reference` objects, so that addons
+  // creating many short-lived references do not pay an allocator round-trip
+  // per reference. Managed by `v8impl::Reference`.
+  std::vector<void*> reference_pool;
+  // Internalized property names cached per environment, so that repeated
+  // class and property definitions as well as named-property access skip
+  // the per-call UTF-8 decode and internalization. See
+  // `v8impl::V8NameFromCachedUtf8()`.
+  std::unordered_map<std::string, v8impl::Persistent<v8::Name>>
+      property_name_cache;
   napi_extended_error_info last_error;
   int open_handle_scopes = 0;
   int open_callback_scopes = 0;
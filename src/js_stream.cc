@@ -56,6 +56,9 @@ bool JSStream::IsClosing() {
 
 
 int JSStream::ReadStart() {
+  if (passthrough_target_ != nullptr)
+    return passthrough_target_->ReadStart();
+
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
   TryCatchScope try_catch(env());
@@ -71,6 +74,9 @@ int JSStream::ReadStart() {
 
 
 int JSStream::ReadStop() {
+  if (passthrough_target_ != nullptr)
+    return passthrough_target_->ReadStop();
+
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
   TryCatchScope try_catch(env());
@@ -113,6 +119,23 @@ int JSStream::DoWrite(WriteWrap* w,
                       uv_stream_t* send_handle) {
   CHECK_NULL(send_handle);
 
+  if (passthrough_target_ != nullptr) {
+    StreamWriteResult res = passthrough_target_->Write(bufs, count);
+    if (!res.async) {
+      if (res.err != 0)
+        return res.err;
+      // Synchronous completion on the target; report ours on the next tick
+      // since `w` is still being set up by our caller.
+      BaseObjectPtr<AsyncWrap> strong_ref{this};
+      env()->SetImmediate([w, strong_ref](Environment* env) {
+        w->Done(0);
+      });
+      return 0;
+    }
+    passthrough_writes_.emplace_back(res.wrap, w);
+    return 0;
+  }
+
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
 
@@ -186,6 +209,95 @@ void JSStream::ReadBuffer(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+uv_buf_t JSStream::PassthroughListener::OnStreamAlloc(size_t suggested_size) {
+  JSStream* stream = ContainerOf(&JSStream::passthrough_listener_, this);
+  return stream->EmitAlloc(suggested_size);
+}
+
+
+void JSStream::PassthroughListener::OnStreamRead(ssize_t nread,
+                                                 const uv_buf_t& buf) {
+  JSStream* stream = ContainerOf(&JSStream::passthrough_listener_, this);
+  stream->EmitRead(nread, buf);
+}
+
+
+void JSStream::PassthroughListener::OnStreamAfterWrite(WriteWrap* w,
+                                                       int status) {
+  JSStream* stream = ContainerOf(&JSStream::passthrough_listener_, this);
+  auto& writes = stream->passthrough_writes_;
+  for (auto it = writes.begin(); it != writes.end(); ++it) {
+    if (it->first != w)
+      continue;
+    WriteWrap* own = it->second;
+    writes.erase(it);
+    own->Done(status);
+    return;
+  }
+  CHECK_NOT_NULL(previous_listener_);
+  previous_listener_->OnStreamAfterWrite(w, status);
+}
+
+
+void JSStream::PassthroughListener::OnStreamDestroy() {
+  JSStream* stream = ContainerOf(&JSStream::passthrough_listener_, this);
+  stream->passthrough_target_ = nullptr;
+  // Fail writes that will never complete and signal EOF to our readers.
+  std::vector<std::pair<WriteWrap*, WriteWrap*>> writes =
+      std::move(stream->passthrough_writes_);
+  stream->passthrough_writes_.clear();
+  for (const auto& entry : writes)
+    entry.second->Done(UV_ECANCELED);
+  stream->EmitRead(UV_EPIPE);
+}
+
+
+void JSStream::DetachPassthrough(int pending_status) {
+  if (passthrough_target_ == nullptr)
+    return;
+  passthrough_target_->RemoveStreamListener(&passthrough_listener_);
+  passthrough_target_ = nullptr;
+  std::vector<std::pair<WriteWrap*, WriteWrap*>> writes =
+      std::move(passthrough_writes_);
+  passthrough_writes_.clear();
+  for (const auto& entry : writes)
+    entry.second->Done(pending_status);
+}
+
+
+void JSStream::SetPassthrough(const FunctionCallbackInfo<Value>& args) {
+  JSStream* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  Environment* env = wrap->env();
+
+  Local<String> target_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "passthroughTarget");
+
+  if (args[0]->IsNull() || args[0]->IsUndefined()) {
+    wrap->DetachPassthrough(UV_ECANCELED);
+    wrap->object()
+        ->Set(env->context(), target_string, Null(env->isolate()))
+        .Check();
+    return;
+  }
+
+  CHECK(args[0]->IsObject());
+  StreamBase* target = StreamBase::FromObject(args[0].As<Object>());
+  CHECK_NOT_NULL(target);
+  CHECK_NE(static_cast<StreamBase*>(wrap), target);
+
+  wrap->DetachPassthrough(UV_ECANCELED);
+  wrap->passthrough_target_ = target;
+  target->PushStreamListener(&wrap->passthrough_listener_);
+
+  // Keep the target's JS object alive (and discoverable) as long as the
+  // splice exists.
+  wrap->object()
+      ->Set(env->context(), target_string, args[0])
+      .Check();
+}
+
+
 void JSStream::EmitEOF(const FunctionCallbackInfo<Value>& args) {
   JSStream* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -212,6 +324,7 @@ void JSStream::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "finishShutdown", Finish<ShutdownWrap>);
   env->SetProtoMethod(t, "readBuffer", ReadBuffer);
   env->SetProtoMethod(t, "emitEOF", EmitEOF);
+  env->SetProtoMethod(t, "setPassthrough", SetPassthrough);
 
   StreamBase::AddMethods(env, t);
   target->Set(env->context(),
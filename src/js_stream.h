@@ -40,9 +40,32 @@ class JSStream : public AsyncWrap, public StreamBase {
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ReadBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EmitEOF(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // setPassthrough(target): splice this JSStream to another StreamBase in
+  // C++. While spliced, writes are forwarded to the target and the target's
+  // reads are emitted as this stream's reads, without materializing JS
+  // values per chunk; JS observes progress through the bytesRead/
+  // bytesWritten accessors. Passing null detaches again.
+  static void SetPassthrough(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   template <class Wrap>
   static void Finish(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ private:
+  class PassthroughListener : public StreamListener {
+   public:
+    uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+    void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+    void OnStreamAfterWrite(WriteWrap* w, int status) override;
+    void OnStreamDestroy() override;
+  };
+
+  void DetachPassthrough(int pending_status);
+
+  StreamBase* passthrough_target_ = nullptr;
+  PassthroughListener passthrough_listener_;
+  // Maps in-flight writes on the target to the corresponding writes on this
+  // stream.
+  std::vector<std::pair<WriteWrap*, WriteWrap*>> passthrough_writes_;
 };
 
 }  // namespace node
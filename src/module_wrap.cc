@@ -178,8 +178,34 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
                           False(isolate),                   // is WASM
                           True(isolate),                    // is ES Module
                           host_defined_options);
-      ScriptCompiler::Source source(source_text, origin);
-      if (!ScriptCompiler::CompileModule(isolate, &source).ToLocal(&module)) {
+
+      // When --compile-cache-dir is set, consult the on-disk compile cache
+      // so that repeatedly loaded module graphs deserialize instead of
+      // parsing from scratch. disk_cache_data backs the CachedData handed
+      // to the Source below and must outlive it.
+      std::string disk_cache_path;
+      std::vector<char> disk_cache_data;
+      ScriptCompiler::CachedData* cached_data = nullptr;
+      if (!env->options()->compile_cache_dir.empty()) {
+        Utf8Value source_utf8(isolate, source_text);
+        disk_cache_path =
+            contextify::CompileCachePath(env->options()->compile_cache_dir,
+                                         *source_utf8,
+                                         source_utf8.length());
+        if (contextify::ReadCompileCacheFile(disk_cache_path,
+                                             &disk_cache_data)) {
+          cached_data = new ScriptCompiler::CachedData(
+              reinterpret_cast<const uint8_t*>(disk_cache_data.data()),
+              disk_cache_data.size());
+        }
+      }
+
+      ScriptCompiler::Source source(source_text, origin, cached_data);
+      ScriptCompiler::CompileOptions compile_options =
+          cached_data != nullptr ? ScriptCompiler::kConsumeCodeCache
+                                 : ScriptCompiler::kNoCompileOptions;
+      if (!ScriptCompiler::CompileModule(isolate, &source, compile_options)
+               .ToLocal(&module)) {
         if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
           CHECK(!try_catch.Message().IsEmpty());
           CHECK(!try_catch.Exception().IsEmpty());
@@ -189,6 +215,18 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
+
+      // On a miss, or when V8 rejected a stale entry, refresh the cache
+      // entry off-thread.
+      if (!disk_cache_path.empty() &&
+          (cached_data == nullptr || source.GetCachedData()->rejected)) {
+        std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+            ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+        if (new_cached_data) {
+          contextify::ScheduleCompileCacheWrite(
+              env, disk_cache_path, new_cached_data.get());
+        }
+      }
     }
   }
 
@@ -661,6 +661,10 @@ inline void PlatformInit() {
 
 // Safe to call more than once and from signal handlers.
 void ResetStdio() {
+  // Drain bytes still parked in line-buffered TTY batches before the
+  // descriptors are reset; a crashing process must not lose its last
+  // log lines.
+  FlushPendingTTYBatches();
   uv_tty_reset_mode();
 #ifdef __POSIX__
   for (auto& s : stdio) {
@@ -997,6 +1001,74 @@ void Init(int* argc,
     argv[i] = strdup(argv_[i].c_str());
 }
 
+// Returns true if the V8 flag named `flag` (in its canonical dashed form,
+// without the "--"/"--no-" prefix or a value) was passed explicitly on the
+// command line or through NODE_OPTIONS. Explicit flags always win over a
+// tuning profile.
+static bool IsV8FlagOverridden(const std::vector<std::string>& exec_args,
+                               const std::string& flag) {
+  for (const std::string& arg : exec_args) {
+    if (arg.size() < 3 || arg[0] != '-' || arg[1] != '-') continue;
+    std::string name = arg.substr(2, arg.find('=') - 2);
+    for (char& c : name) {
+      if (c == '_') c = '-';
+    }
+    if (name.compare(0, 3, "no-") == 0) name.erase(0, 3);
+    if (name == flag) return true;
+  }
+  return false;
+}
+
+// Resolve a --v8-tuning-profile name into concrete V8 flags, scaled to the
+// memory actually available to this process. GetEffectiveMemory() reads the
+// cgroup limit on Linux, so the same profile adapts to container limits
+// instead of the host's physical memory.
+static void ApplyV8TuningProfile(const std::string& profile,
+                                 const std::vector<std::string>& exec_args) {
+  const uint64_t mem_mb = GetEffectiveMemory() / (1024 * 1024);
+
+  // { canonical flag name, full flag string } pairs; the name is used to
+  // detect explicit overrides.
+  std::vector<std::pair<std::string, std::string>> flags;
+  const auto scaled = [&](uint64_t divisor, uint64_t min, uint64_t max) {
+    return std::max(min, std::min(max, mem_mb / divisor));
+  };
+
+  if (profile == "server-throughput") {
+    // Large young generation to cut scavenge frequency for allocation-heavy
+    // request handling, old space sized to half the machine, and no bytecode
+    // flushing so hot paths are never re-compiled mid-load.
+    flags.emplace_back(
+        "max-semi-space-size",
+        "--max-semi-space-size=" + std::to_string(scaled(64, 16, 64)));
+    flags.emplace_back(
+        "max-old-space-size",
+        "--max-old-space-size=" + std::to_string(scaled(2, 256, 1 << 16)));
+    flags.emplace_back("flush-bytecode", "--no-flush-bytecode");
+  } else if (profile == "low-memory") {
+    // Trade peak throughput for footprint: --optimize-for-size also shrinks
+    // the semi-spaces to 1 MB, and the old space is capped at half of the
+    // (container) limit so the GC pushes back well before the OOM killer.
+    flags.emplace_back("optimize-for-size", "--optimize-for-size");
+    flags.emplace_back(
+        "max-old-space-size",
+        "--max-old-space-size=" + std::to_string(scaled(2, 64, 2048)));
+  } else if (profile == "fast-startup") {
+    // Short-lived processes: compact code, and no background recompilation
+    // since peak optimized throughput is never reached anyway.
+    flags.emplace_back("optimize-for-size", "--optimize-for-size");
+    flags.emplace_back("concurrent-recompilation",
+                       "--no-concurrent-recompilation");
+  } else {
+    UNREACHABLE();
+  }
+
+  for (const auto& flag : flags) {
+    if (IsV8FlagOverridden(exec_args, flag.first)) continue;
+    V8::SetFlagsFromString(flag.second.c_str(), flag.second.size());
+  }
+}
+
 InitializationResult InitializeOncePerProcess(int argc, char** argv) {
   atexit(ResetStdio);
   PlatformInit();
@@ -1061,6 +1133,29 @@ InitializationResult InitializeOncePerProcess(int argc, char** argv) {
     UNREACHABLE();
   }
 
+  // Needs to run before V8::Initialize() so the flags still take effect.
+  if (!per_process::cli_options->v8_tuning_profile.empty()) {
+    ApplyV8TuningProfile(per_process::cli_options->v8_tuning_profile,
+                         result.exec_args);
+  }
+
+  // Size the libuv threadpool to what the process can actually use: keep
+  // the historical default of 4 threads, but do not oversubscribe when a
+  // cgroup CPU quota or affinity mask grants fewer CPUs than that. This
+  // must happen before the first uv_queue_work() call spins the pool up;
+  // an explicit UV_THREADPOOL_SIZE always wins.
+  {
+    char buf[1];
+    size_t len = sizeof(buf);
+    if (uv_os_getenv("UV_THREADPOOL_SIZE", buf, &len) == UV_ENOENT) {
+      const int parallelism = GetAvailableParallelism();
+      if (parallelism < 4) {
+        std::string size = std::to_string(parallelism);
+        uv_os_setenv("UV_THREADPOOL_SIZE", size.c_str());
+      }
+    }
+  }
+
 #if HAVE_OPENSSL
   {
     std::string extra_ca_certs;
@@ -393,6 +393,26 @@ NODE_EXTERN void FreeEnvironment(Environment* env);
 // This may return nullptr if context is not associated with a Node instance.
 NODE_EXTERN Environment* GetCurrentEnvironment(v8::Local<v8::Context> context);
 
+// Cooperative CPU budgeting for embedders that run multiple Environments
+// (each with its own context, sharing an Isolate and event loop). While a
+// budget is set, the time spent running an Environment's callbacks is
+// charged against it; the allowance refills every `interval_ns`. JS is never
+// preempted — an Environment that exhausts its budget keeps running already
+// scheduled work, but EnvironmentCpuBudgetExceeded() reports the exhaustion
+// so the embedder's dispatcher can defer feeding it more, and Node itself
+// drains its internal queues in smaller slices. Pass a zero interval to
+// disable budgeting again.
+NODE_EXTERN void SetEnvironmentCpuBudget(Environment* env,
+                                         uint64_t budget_ns,
+                                         uint64_t interval_ns);
+NODE_EXTERN bool EnvironmentCpuBudgetExceeded(Environment* env);
+// Cumulative nanoseconds of callback time charged to this Environment since
+// it was created (tracked only while a budget is set).
+NODE_EXTERN uint64_t GetEnvironmentCpuTime(Environment* env);
+// Number of libuv handles currently owned by this Environment. O(1) per
+// provider type; usable for per-tenant accounting on a shared loop.
+NODE_EXTERN uint64_t GetEnvironmentActiveHandleCount(Environment* env);
+
 // This returns the MultiIsolatePlatform used in the main thread of Node.js.
 // If NODE_USE_V8_PLATFORM haven't been defined when Node.js was built,
 // it returns nullptr.
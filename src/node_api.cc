@@ -9,7 +9,9 @@
 #include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 struct node_napi_env__ : public napi_env__ {
   explicit node_napi_env__(v8::Local<v8::Context> context):
@@ -17,6 +19,12 @@ struct node_napi_env__ : public napi_env__ {
     CHECK_NOT_NULL(node_env());
   }
 
+  ~node_napi_env__() override {
+    for (void* block : async_work_pool) {
+      ::operator delete(block);
+    }
+  }
+
   inline node::Environment* node_env() const {
     return node::Environment::GetCurrent(context());
   }
@@ -32,6 +40,11 @@ struct node_napi_env__ : public napi_env__ {
         node_env()->arraybuffer_untransferable_private_symbol(),
         v8::True(isolate));
   }
+
+  // Recycled memory blocks for `uvimpl::Work` objects, so that addons
+  // queueing many short-lived async work items do not pay an allocator
+  // round-trip per item. Managed by `uvimpl::Work`.
+  std::vector<void*> async_work_pool;
 };
 
 typedef node_napi_env__* node_napi_env;
@@ -73,6 +86,97 @@ class BufferFinalizer : private Finalizer {
   };
 };
 
+// Shared finalization bookkeeping for buffers created through
+// napi_create_external_buffer_with_table(). The table preallocates one entry
+// per slot, and each buffer's free-callback hint is a pointer into `entries_`,
+// so creating an individual external buffer performs no allocation here.
+class ExternalBufferTable {
+ public:
+  struct Entry {
+    ExternalBufferTable* table;
+    uint32_t generation;
+  };
+
+  ExternalBufferTable(node_napi_env env,
+                      size_t capacity,
+                      napi_external_buffer_finalize finalize_cb,
+                      void* finalize_hint)
+      : env_(env),
+        finalize_cb_(finalize_cb),
+        finalize_hint_(finalize_hint),
+        entries_(capacity),
+        live_(0),
+        deleted_(false) {
+    for (Entry& entry : entries_) {
+      entry.table = this;
+    }
+    env_->Ref();
+  }
+
+  ~ExternalBufferTable() {
+    env_->Unref();
+  }
+
+  size_t capacity() const { return entries_.size(); }
+  bool deleted() const { return deleted_; }
+
+  Entry* Occupy(size_t index, uint32_t generation) {
+    Entry* entry = &entries_[index];
+    entry->generation = generation;
+    live_++;
+    return entry;
+  }
+
+  // Undoes Occupy() when buffer creation fails afterwards.
+  void Abandon() {
+    live_--;
+  }
+
+  // Marks the table for deletion. Actual deletion is deferred until the
+  // finalizer of the last outstanding buffer has run.
+  void Release() {
+    deleted_ = true;
+    if (live_ == 0) {
+      delete this;
+    }
+  }
+
+  // node::Buffer::FreeCallback. May run during garbage collection, so the
+  // call into the addon is deferred to a point where re-entering the engine
+  // is safe, mirroring BufferFinalizer above.
+  static void FinalizeBufferCallback(char* data, void* hint) {
+    Entry* entry = static_cast<Entry*>(hint);
+    ExternalBufferTable* table = entry->table;
+    size_t index = entry - &table->entries_[0];
+    uint32_t generation = entry->generation;
+
+    table->env_->node_env()->SetImmediate(
+        [table, data, index, generation](node::Environment*) {
+      v8::HandleScope handle_scope(table->env_->isolate);
+      v8::Context::Scope context_scope(table->env_->context());
+
+      if (table->finalize_cb_ != nullptr) {
+        table->env_->CallIntoModuleThrow([&](napi_env env) {
+          table->finalize_cb_(
+              env, data, table->finalize_hint_, index, generation);
+        });
+      }
+
+      if (--table->live_ == 0 && table->deleted_) {
+        delete table;
+      }
+    });
+  }
+
+ private:
+  node_napi_env env_;
+  napi_external_buffer_finalize finalize_cb_;
+  void* finalize_hint_;
+  std::vector<Entry> entries_;
+  size_t live_;
+  bool deleted_;
+};
+
 static inline napi_env NewEnv(v8::Local<v8::Context> context) {
   node_napi_env result;
 
@@ -110,6 +214,11 @@ static inline void trigger_fatal_exception(
   node::errors::TriggerUncaughtException(env->isolate, local_err, local_msg);
 }
 
+// Upper bound on the number of queue items delivered per loop iteration by
+// a thread-safe function without a maximum queue size, so that a fast
+// producer cannot starve the rest of the event loop.
+const size_t kTsfnMaxBatchSize = 1000;
+
 class ThreadSafeFunction : public node::AsyncResource {
  public:
   ThreadSafeFunction(v8::Local<v8::Function> func,
@@ -133,7 +242,13 @@ class ThreadSafeFunction : public node::AsyncResource {
       finalize_data(finalize_data_),
       finalize_cb(finalize_cb_),
       call_js_cb(call_js_cb_ == nullptr ? CallJs : call_js_cb_),
-      handles_closing(false) {
+      batch_call_js_cb(nullptr),
+      handles_closing(false),
+      stub{nullptr, {nullptr}},
+      lock_free_tail(&stub),
+      lock_free_head(&stub),
+      wakeup_pending(false),
+      closing_hint(false) {
     ref.Reset(env->isolate, func);
     node::AddEnvironmentCleanupHook(env->isolate, Cleanup, this);
     env->Ref();
@@ -147,6 +262,10 @@ class ThreadSafeFunction : public node::AsyncResource {
   // These methods can be called from any thread.
 
   napi_status Push(void* data, napi_threadsafe_function_call_mode mode) {
+    if (max_queue_size == 0) {
+      return PushLockFree(data);
+    }
+
     node::Mutex::ScopedLock lock(this->mutex);
 
     while (queue.size() >= max_queue_size &&
@@ -166,7 +285,7 @@ class ThreadSafeFunction : public node::AsyncResource {
         return napi_closing;
       }
     } else {
-      if (uv_async_send(&async) != 0) {
+      if (!SendWakeup()) {
         return napi_generic_failure;
       }
       queue.push(data);
@@ -174,6 +293,45 @@ class ThreadSafeFunction : public node::AsyncResource {
     }
   }
 
+  // Fast path for thread-safe functions without a maximum queue size: append
+  // to an intrusive MPSC list with a single atomic exchange instead of taking
+  // the mutex. The mutex is only touched when the function is closing, which
+  // keeps the thread_count bookkeeping identical to the locked path.
+  napi_status PushLockFree(void* data) {
+    if (closing_hint.load(std::memory_order_acquire)) {
+      node::Mutex::ScopedLock lock(this->mutex);
+      if (is_closing) {
+        if (thread_count == 0) {
+          return napi_invalid_arg;
+        } else {
+          thread_count--;
+          return napi_closing;
+        }
+      }
+    }
+
+    QueueNode* node = new QueueNode{data, {nullptr}};
+    QueueNode* prev = lock_free_tail.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    return SendWakeup() ? napi_ok : napi_generic_failure;
+  }
+
+  // Collapses bursts of producer wakeups into a single uv_async_send(): only
+  // the thread that flips wakeup_pending pokes the loop. The dispatcher
+  // clears the flag before draining, so anything enqueued afterwards
+  // schedules a fresh wakeup.
+  bool SendWakeup() {
+    if (wakeup_pending.exchange(true, std::memory_order_acq_rel)) {
+      return true;
+    }
+    if (uv_async_send(&async) != 0) {
+      wakeup_pending.store(false, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
   napi_status Acquire() {
     node::Mutex::ScopedLock lock(this->mutex);
 
@@ -198,10 +356,13 @@ class ThreadSafeFunction : public node::AsyncResource {
     if (thread_count == 0 || mode == napi_tsfn_abort) {
       if (!is_closing) {
         is_closing = (mode == napi_tsfn_abort);
-        if (is_closing && max_queue_size > 0) {
-          cond->Signal(lock);
+        if (is_closing) {
+          closing_hint.store(true, std::memory_order_release);
+          if (max_queue_size > 0) {
+            cond->Signal(lock);
+          }
         }
-        if (uv_async_send(&async) != 0) {
+        if (!SendWakeup()) {
           return napi_generic_failure;
         }
       }
@@ -212,11 +373,23 @@ class ThreadSafeFunction : public node::AsyncResource {
 
   void EmptyQueueAndDelete() {
     for (; !queue.empty() ; queue.pop()) {
-      call_js_cb(nullptr, nullptr, context, queue.front());
+      ReleaseItem(queue.front());
+    }
+    void* data;
+    while (PopLockFree(&data)) {
+      ReleaseItem(data);
     }
     delete this;
   }
 
+  void ReleaseItem(void* data) {
+    if (batch_call_js_cb != nullptr) {
+      batch_call_js_cb(nullptr, nullptr, context, &data, 1);
+    } else {
+      call_js_cb(nullptr, nullptr, context, data);
+    }
+  }
+
   // These methods must only be called from the loop thread.
 
   napi_status Init() {
@@ -270,6 +443,8 @@ class ThreadSafeFunction : public node::AsyncResource {
     bool popped_value = false;
     bool idle_stop_failed = false;
 
+    wakeup_pending.store(false, std::memory_order_seq_cst);
+
     {
       node::Mutex::ScopedLock lock(this->mutex);
       if (is_closing) {
@@ -289,6 +464,7 @@ class ThreadSafeFunction : public node::AsyncResource {
         if (size == 0) {
           if (thread_count == 0) {
             is_closing = true;
+            closing_hint.store(true, std::memory_order_release);
             if (max_queue_size > 0) {
               cond->Signal(lock);
             }
@@ -318,12 +494,88 @@ class ThreadSafeFunction : public node::AsyncResource {
           js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
         }
         env->CallIntoModuleThrow([&](napi_env env) {
-          call_js_cb(env, js_callback, context, data);
+          if (batch_call_js_cb != nullptr) {
+            batch_call_js_cb(env, js_callback, context, &data, 1);
+          } else {
+            call_js_cb(env, js_callback, context, data);
+          }
+        });
+      }
+    }
+  }
+
+  // Counterpart of DispatchOne() for the lock-free queue: drains up to
+  // kTsfnMaxBatchSize items per loop iteration instead of one, and hands the
+  // whole batch to the JS side in a single invocation when a batch callback
+  // is installed.
+  void DispatchBatch() {
+    void* items[kTsfnMaxBatchSize];
+    size_t count = 0;
+    bool idle_stop_failed = false;
+
+    {
+      node::Mutex::ScopedLock lock(this->mutex);
+      if (is_closing) {
+        CloseHandlesAndMaybeDelete();
+        return;
+      }
+    }
+
+    // Clear the wakeup flag before draining: producers that enqueue from
+    // here on schedule their own wakeup, so nothing can be stranded.
+    wakeup_pending.store(false, std::memory_order_seq_cst);
+
+    while (count < kTsfnMaxBatchSize && PopLockFree(&items[count])) {
+      count++;
+    }
+
+    {
+      node::Mutex::ScopedLock lock(this->mutex);
+      if (LockFreeQueueEmpty()) {
+        if (thread_count == 0) {
+          is_closing = true;
+          closing_hint.store(true, std::memory_order_release);
+          CloseHandlesAndMaybeDelete();
+        } else {
+          if (uv_idle_stop(&idle) != 0) {
+            idle_stop_failed = true;
+          }
+        }
+      }
+    }
+
+    if (count > 0 || idle_stop_failed) {
+      v8::HandleScope scope(env->isolate);
+      CallbackScope cb_scope(this);
+
+      if (idle_stop_failed) {
+        CHECK(napi_throw_error(env,
+                               "ERR_NAPI_TSFN_STOP_IDLE_LOOP",
+                               "Failed to stop the idle loop") == napi_ok);
+      } else {
+        napi_value js_callback = nullptr;
+        if (!ref.IsEmpty()) {
+          v8::Local<v8::Function> js_cb =
+            v8::Local<v8::Function>::New(env->isolate, ref);
+          js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
+        }
+        env->CallIntoModuleThrow([&](napi_env env) {
+          if (batch_call_js_cb != nullptr) {
+            batch_call_js_cb(env, js_callback, context, items, count);
+          } else {
+            for (size_t i = 0; i < count; i++) {
+              call_js_cb(env, js_callback, context, items[i]);
+            }
+          }
         });
       }
     }
   }
 
+  void SetBatchCallback(napi_threadsafe_function_call_js_batch cb) {
+    batch_call_js_cb = cb;
+  }
+
   void MaybeStartIdle() {
     if (uv_idle_start(&idle, IdleCb) != 0) {
       v8::HandleScope scope(env->isolate);
@@ -354,6 +606,7 @@ class ThreadSafeFunction : public node::AsyncResource {
     if (set_closing) {
       node::Mutex::ScopedLock lock(this->mutex);
       is_closing = true;
+      closing_hint.store(true, std::memory_order_release);
       if (max_queue_size > 0) {
         cond->Signal(lock);
       }
@@ -406,7 +659,11 @@ class ThreadSafeFunction : public node::AsyncResource {
   static void IdleCb(uv_idle_t* idle) {
     ThreadSafeFunction* ts_fn =
         node::ContainerOf(&ThreadSafeFunction::idle, idle);
-    ts_fn->DispatchOne();
+    if (ts_fn->max_queue_size == 0) {
+      ts_fn->DispatchBatch();
+    } else {
+      ts_fn->DispatchOne();
+    }
   }
 
   static void AsyncCb(uv_async_t* async) {
@@ -421,6 +678,67 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
  private:
+  // Node of the intrusive MPSC list backing the lock-free queue. Producers
+  // link new nodes in with an atomic exchange on lock_free_tail; only the
+  // loop thread follows next pointers and frees nodes.
+  struct QueueNode {
+    void* data;
+    std::atomic<QueueNode*> next;
+  };
+
+  // Dequeues one item. Must only be called from the loop thread. Returns
+  // false when the queue is empty or when the node at the head has been
+  // linked into the tail but its next pointer is not yet visible (a producer
+  // is mid-push); in the latter case LockFreeQueueEmpty() reports non-empty,
+  // so the idle loop keeps running and retries on the next iteration.
+  bool PopLockFree(void** out) {
+    QueueNode* head = lock_free_head;
+    QueueNode* next = head->next.load(std::memory_order_acquire);
+
+    if (head == &stub) {
+      if (next == nullptr) {
+        return false;
+      }
+      lock_free_head = next;
+      head = next;
+      next = head->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+      lock_free_head = next;
+      *out = head->data;
+      delete head;
+      return true;
+    }
+
+    if (head != lock_free_tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    // `head` is the last node. Push the stub back behind it so it becomes
+    // poppable without racing concurrent producers.
+    stub.next.store(nullptr, std::memory_order_relaxed);
+    QueueNode* prev = lock_free_tail.exchange(&stub,
+                                              std::memory_order_acq_rel);
+    prev->next.store(&stub, std::memory_order_release);
+
+    next = head->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      lock_free_head = next;
+      *out = head->data;
+      delete head;
+      return true;
+    }
+
+    return false;
+  }
+
+  bool LockFreeQueueEmpty() {
+    return lock_free_head == &stub &&
+        stub.next.load(std::memory_order_acquire) == nullptr &&
+        lock_free_tail.load(std::memory_order_acquire) == &stub;
+  }
+
   // These are variables protected by the mutex.
   node::Mutex mutex;
   std::unique_ptr<node::ConditionVariable> cond;
@@ -441,7 +759,17 @@ class ThreadSafeFunction : public node::AsyncResource {
   void* finalize_data;
   napi_finalize finalize_cb;
   napi_threadsafe_function_call_js call_js_cb;
+  napi_threadsafe_function_call_js_batch batch_call_js_cb;
   bool handles_closing;
+
+  // State of the lock-free queue, used instead of `queue` when
+  // max_queue_size == 0. `stub` and `lock_free_tail` are shared with
+  // producer threads; `lock_free_head` belongs to the loop thread.
+  QueueNode stub;
+  std::atomic<QueueNode*> lock_free_tail;
+  QueueNode* lock_free_head;
+  std::atomic<bool> wakeup_pending;
+  std::atomic<bool> closing_hint;
 };
 
 }  // end of anonymous namespace
@@ -751,6 +1079,67 @@ napi_status napi_create_external_buffer(napi_env env,
   // coverity[leaked_storage]
 }
 
+napi_status napi_create_external_buffer_table(
+    napi_env env,
+    size_t capacity,
+    napi_external_buffer_finalize finalize_cb,
+    void* finalize_hint,
+    napi_external_buffer_table* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env, capacity > 0, napi_invalid_arg);
+
+  v8impl::ExternalBufferTable* table = new v8impl::ExternalBufferTable(
+      reinterpret_cast<node_napi_env>(env), capacity, finalize_cb,
+      finalize_hint);
+
+  *result = reinterpret_cast<napi_external_buffer_table>(table);
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_delete_external_buffer_table(
+    napi_env env,
+    napi_external_buffer_table table) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, table);
+
+  reinterpret_cast<v8impl::ExternalBufferTable*>(table)->Release();
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_create_external_buffer_with_table(
+    napi_env env,
+    size_t length,
+    void* data,
+    napi_external_buffer_table table,
+    size_t index,
+    uint32_t generation,
+    napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, table);
+  CHECK_ARG(env, result);
+
+  v8impl::ExternalBufferTable* the_table =
+      reinterpret_cast<v8impl::ExternalBufferTable*>(table);
+  RETURN_STATUS_IF_FALSE(env, index < the_table->capacity(), napi_invalid_arg);
+  RETURN_STATUS_IF_FALSE(env, !the_table->deleted(), napi_invalid_arg);
+
+  auto maybe = node::Buffer::New(
+      env->isolate,
+      static_cast<char*>(data),
+      length,
+      v8impl::ExternalBufferTable::FinalizeBufferCallback,
+      the_table->Occupy(index, generation));
+
+  if (maybe.IsEmpty()) {
+    the_table->Abandon();
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+  return GET_RETURN_STATUS(env);
+}
+
 napi_status napi_create_buffer_copy(napi_env env,
                                     size_t length,
                                     const void* data,
@@ -832,6 +1221,10 @@ static napi_status ConvertUVErrorCode(int code) {
   }
 }
 
+// Above this size the per-env freelist of recycled Work blocks stops growing
+// and excess blocks go back to the allocator.
+const size_t kAsyncWorkPoolMaxSize = 64;
+
 // Wrapper around uv_work_t which calls user-provided callbacks.
 class Work : public node::AsyncResource, public node::ThreadPoolWork {
  private:
@@ -840,11 +1233,13 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
                 v8::Local<v8::String> async_resource_name,
                 napi_async_execute_callback execute,
                 napi_async_complete_callback complete = nullptr,
-                void* data = nullptr)
+                void* data = nullptr,
+                node::ThreadPoolWork::WorkClass work_class =
+                    node::ThreadPoolWork::WorkClass::kBlockingIo)
     : AsyncResource(env->isolate,
                     async_resource,
                     *v8::String::Utf8Value(env->isolate, async_resource_name)),
-      ThreadPoolWork(env->node_env()),
+      ThreadPoolWork(env->node_env(), work_class),
       _env(env),
       _data(data),
       _execute(execute),
@@ -853,19 +1248,41 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
 
   ~Work() override = default;
 
+  static void* AllocateBlock(node_napi_env env) {
+    if (!env->async_work_pool.empty()) {
+      void* block = env->async_work_pool.back();
+      env->async_work_pool.pop_back();
+      return block;
+    }
+    return ::operator new(sizeof(Work));
+  }
+
+  static void FreeBlock(node_napi_env env, void* block) {
+    if (env->async_work_pool.size() < kAsyncWorkPoolMaxSize) {
+      env->async_work_pool.push_back(block);
+    } else {
+      ::operator delete(block);
+    }
+  }
+
  public:
   static Work* New(node_napi_env env,
                    v8::Local<v8::Object> async_resource,
                    v8::Local<v8::String> async_resource_name,
                    napi_async_execute_callback execute,
                    napi_async_complete_callback complete,
-                   void* data) {
-    return new Work(env, async_resource, async_resource_name,
-                    execute, complete, data);
+                   void* data,
+                   node::ThreadPoolWork::WorkClass work_class =
+                       node::ThreadPoolWork::WorkClass::kBlockingIo) {
+    return new(AllocateBlock(env)) Work(env, async_resource,
+                                        async_resource_name,
+                                        execute, complete, data, work_class);
   }
 
   static void Delete(Work* work) {
-    delete work;
+    node_napi_env env = work->_env;
+    work->~Work();
+    FreeBlock(env, work);
   }
 
   void DoThreadPoolWork() override {
@@ -914,12 +1331,13 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     }                                                                   \
   } while (0)
 
-napi_status napi_create_async_work(napi_env env,
+static napi_status CreateAsyncWork(napi_env env,
                                    napi_value async_resource,
                                    napi_value async_resource_name,
                                    napi_async_execute_callback execute,
                                    napi_async_complete_callback complete,
                                    void* data,
+                                   node::ThreadPoolWork::WorkClass work_class,
                                    napi_async_work* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, execute);
@@ -942,13 +1360,54 @@ napi_status napi_create_async_work(napi_env env,
                                          resource_name,
                                          execute,
                                          complete,
-                                         data);
+                                         data,
+                                         work_class);
 
   *result = reinterpret_cast<napi_async_work>(work);
 
   return napi_clear_last_error(env);
 }
 
+napi_status napi_create_async_work(napi_env env,
+                                   napi_value async_resource,
+                                   napi_value async_resource_name,
+                                   napi_async_execute_callback execute,
+                                   napi_async_complete_callback complete,
+                                   void* data,
+                                   napi_async_work* result) {
+  return CreateAsyncWork(env, async_resource, async_resource_name,
+                         execute, complete, data,
+                         node::ThreadPoolWork::WorkClass::kBlockingIo,
+                         result);
+}
+
+napi_status
+napi_create_async_work_with_class(napi_env env,
+                                  napi_value async_resource,
+                                  napi_value async_resource_name,
+                                  napi_async_work_class work_class,
+                                  napi_async_execute_callback execute,
+                                  napi_async_complete_callback complete,
+                                  void* data,
+                                  napi_async_work* result) {
+  CHECK_ENV(env);
+
+  node::ThreadPoolWork::WorkClass native_class;
+  switch (work_class) {
+    case napi_async_work_blocking_io:
+      native_class = node::ThreadPoolWork::WorkClass::kBlockingIo;
+      break;
+    case napi_async_work_cpu_bound:
+      native_class = node::ThreadPoolWork::WorkClass::kCpuBound;
+      break;
+    default:
+      return napi_set_last_error(env, napi_invalid_arg);
+  }
+
+  return CreateAsyncWork(env, async_resource, async_resource_name,
+                         execute, complete, data, native_class, result);
+}
+
 napi_status napi_delete_async_work(napi_env env, napi_async_work work) {
   CHECK_ENV(env);
   CHECK_ARG(env, work);
@@ -1075,6 +1534,16 @@ napi_call_threadsafe_function(napi_threadsafe_function func,
                                                                    is_blocking);
 }
 
+napi_status
+napi_set_threadsafe_function_batch_callback(
+    napi_threadsafe_function func,
+    napi_threadsafe_function_call_js_batch call_js_cb_batch) {
+  CHECK_NOT_NULL(func);
+  reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->SetBatchCallback(
+      call_js_cb_batch);
+  return napi_ok;
+}
+
 napi_status
 napi_acquire_threadsafe_function(napi_threadsafe_function func) {
   CHECK_NOT_NULL(func);
@@ -232,6 +232,47 @@ napi_ref_threadsafe_function(napi_env env, napi_threadsafe_function func);
 
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+
+NAPI_EXTERN napi_status
+napi_set_threadsafe_function_batch_callback(
+    napi_threadsafe_function func,
+    napi_threadsafe_function_call_js_batch call_js_cb_batch);
+
+// Registration-based external buffer creation
+NAPI_EXTERN napi_status
+napi_create_external_buffer_table(napi_env env,
+                                  size_t capacity,
+                                  napi_external_buffer_finalize finalize_cb,
+                                  void* finalize_hint,
+                                  napi_external_buffer_table* result);
+
+NAPI_EXTERN napi_status
+napi_delete_external_buffer_table(napi_env env,
+                                  napi_external_buffer_table table);
+
+NAPI_EXTERN napi_status
+napi_create_external_buffer_with_table(napi_env env,
+                                       size_t length,
+                                       void* data,
+                                       napi_external_buffer_table table,
+                                       size_t index,
+                                       uint32_t generation,
+                                       napi_value* result);
+
+// Async work with a scheduling class
+NAPI_EXTERN napi_status
+napi_create_async_work_with_class(napi_env env,
+                                  napi_value async_resource,
+                                  napi_value async_resource_name,
+                                  napi_async_work_class work_class,
+                                  napi_async_execute_callback execute,
+                                  napi_async_complete_callback complete,
+                                  void* data,
+                                  napi_async_work* result);
+
+#endif  // NAPI_EXPERIMENTAL
+
 EXTERN_C_END
 
 #endif  // SRC_NODE_API_H_
@@ -34,6 +34,27 @@ typedef void (*napi_threadsafe_function_call_js)(napi_env env,
                                                  void* data);
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+typedef void (*napi_threadsafe_function_call_js_batch)(napi_env env,
+                                                       napi_value js_callback,
+                                                       void* context,
+                                                       void** data,
+                                                       size_t count);
+
+typedef struct napi_external_buffer_table__* napi_external_buffer_table;
+
+typedef void (*napi_external_buffer_finalize)(napi_env env,
+                                              void* data,
+                                              void* finalize_hint,
+                                              size_t index,
+                                              uint32_t generation);
+
+typedef enum {
+  napi_async_work_blocking_io,
+  napi_async_work_cpu_bound
+} napi_async_work_class;
+#endif  // NAPI_EXPERIMENTAL
+
 typedef struct {
   uint32_t major;
   uint32_t minor;
@@ -46,11 +46,13 @@
 namespace node {
 namespace Buffer {
 
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::Global;
 using v8::HandleScope;
@@ -134,7 +136,7 @@ CallbackInfo::CallbackInfo(Environment* env,
 
   persistent_.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
   env->AddCleanupHook(CleanupHook, this);
-  env->isolate()->AdjustAmountOfExternalAllocatedMemory(sizeof(*this));
+  env->AdjustExternalMemory(sizeof(*this));
 }
 
 
@@ -168,8 +170,7 @@ void CallbackInfo::WeakCallback(
 
 void CallbackInfo::WeakCallback(Isolate* isolate) {
   callback_(data_, hint_);
-  int64_t change_in_bytes = -static_cast<int64_t>(sizeof(*this));
-  isolate->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+  env_->AdjustExternalMemory(-static_cast<int64_t>(sizeof(*this)));
 }
 
 
@@ -582,6 +583,39 @@ void Copy(const FunctionCallbackInfo<Value> &args) {
 }
 
 
+// Create a [start, end) view over args[0] that pins the underlying backing
+// store on its own, i.e. without keeping the source Buffer or its
+// ArrayBuffer from being garbage collected. The backing allocation is
+// released (and, for pool-sized chunks, recycled by the allocator) once the
+// source ArrayBuffer and the last retained view are gone. This lets framed
+// protocol parsers keep small payload views out of large receive slabs
+// without copying. Range validation happens in lib/buffer.js.
+void SliceRetained(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
+
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  const size_t start = args[1].As<Uint32>()->Value();
+  const size_t end = args[2].As<Uint32>()->Value();
+  CHECK_LE(start, end);
+  CHECK_LE(end, view->ByteLength());
+
+  std::shared_ptr<BackingStore> backing = view->Buffer()->GetBackingStore();
+  char* data =
+      static_cast<char*>(backing->Data()) + view->ByteOffset() + start;
+
+  auto* retained = new std::shared_ptr<BackingStore>(std::move(backing));
+  auto free_callback = [](char* data, void* hint) {
+    delete static_cast<std::shared_ptr<BackingStore>*>(hint);
+  };
+  Local<Object> buf;
+  if (New(env, data, end - start, free_callback, retained).ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+
 void Fill(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Local<Context> ctx = env->context();
@@ -1028,6 +1062,69 @@ void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
       result == haystack_length ? -1 : static_cast<int>(result));
 }
 
+// Finds the earliest occurrence of any of the needle buffers in a single
+// pass over the haystack. Byte-level (encoding-agnostic) and forward-only.
+//   args[0]: haystack buffer
+//   args[1]: array of up to kMaxMultiNeedles non-empty needle buffers
+//   args[2]: byte offset to start the search at
+//   args[3]: Uint32Array(2) receiving [offset, needle index] on a match
+// Returns true iff a match was found. Argument validation beyond type
+// checks happens in lib/buffer.js.
+void IndexOfAnyBuffer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsNumber());
+  CHECK(args[3]->IsUint32Array());
+
+  THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
+  ArrayBufferViewContents<uint8_t> haystack(args[0]);
+
+  Local<Context> context = env->context();
+  Local<Array> needle_array = args[1].As<Array>();
+  const uint32_t n_needles = needle_array->Length();
+  CHECK_GT(n_needles, 0);
+  CHECK_LE(n_needles, stringsearch::kMaxMultiNeedles);
+
+  stringsearch::MultiPattern needles[stringsearch::kMaxMultiNeedles];
+  for (uint32_t j = 0; j < n_needles; j++) {
+    Local<Value> elem;
+    if (!needle_array->Get(context, j).ToLocal(&elem))
+      return;
+    THROW_AND_RETURN_UNLESS_BUFFER(env, elem);
+    needles[j].data = reinterpret_cast<const uint8_t*>(Buffer::Data(elem));
+    needles[j].length = Buffer::Length(elem);
+    CHECK_GT(needles[j].length, 0);
+  }
+
+  const int64_t offset_i64 = args[2].As<Integer>()->Value();
+  CHECK_GE(offset_i64, 0);
+  const size_t haystack_length = haystack.length();
+  if (static_cast<uint64_t>(offset_i64) >= haystack_length) {
+    return args.GetReturnValue().Set(false);
+  }
+
+  size_t needle_index;
+  const size_t result =
+      stringsearch::SearchStringMulti(haystack.data(),
+                                      haystack_length,
+                                      needles,
+                                      n_needles,
+                                      static_cast<size_t>(offset_i64),
+                                      &needle_index);
+  if (result == haystack_length) {
+    return args.GetReturnValue().Set(false);
+  }
+
+  Local<Uint32Array> result_array = args[3].As<Uint32Array>();
+  CHECK_GE(result_array->Length(), 2);
+  uint32_t* fields = static_cast<uint32_t*>(
+      result_array->Buffer()->GetBackingStore()->Data());
+  fields += result_array->ByteOffset() / sizeof(uint32_t);
+  fields[0] = static_cast<uint32_t>(result);
+  fields[1] = static_cast<uint32_t>(needle_index);
+  args.GetReturnValue().Set(true);
+}
+
 void IndexOfNumber(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[1]->IsUint32());
   CHECK(args[2]->IsNumber());
@@ -1087,6 +1184,32 @@ void Swap64(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Fill the Float64Array argument with the allocator pool counters:
+// [ hits, misses, recycled, evicted, retainedBytes ]. The counters stay
+// zero when this isolate does not own its ArrayBuffer allocator.
+static void GetAllocatorStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 5);
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  NodeArrayBufferAllocator::PoolStats stats;
+  if (NodeArrayBufferAllocator* allocator =
+          env->isolate_data()->node_allocator()) {
+    stats = allocator->pool_stats();
+  }
+  fields[0] = static_cast<double>(stats.hits);
+  fields[1] = static_cast<double>(stats.misses);
+  fields[2] = static_cast<double>(stats.recycled);
+  fields[3] = static_cast<double>(stats.evicted);
+  fields[4] = static_cast<double>(stats.retained_bytes);
+}
+
+
 // Encode a single string to a UTF-8 Uint8Array (not Buffer).
 // Used in TextEncoder.prototype.encode.
 static void EncodeUtf8String(const FunctionCallbackInfo<Value>& args) {
@@ -1165,9 +1288,11 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target, "compare", Compare);
   env->SetMethodNoSideEffect(target, "compareOffset", CompareOffset);
   env->SetMethod(target, "fill", Fill);
+  env->SetMethod(target, "indexOfAnyBuffer", IndexOfAnyBuffer);
   env->SetMethodNoSideEffect(target, "indexOfBuffer", IndexOfBuffer);
   env->SetMethodNoSideEffect(target, "indexOfNumber", IndexOfNumber);
   env->SetMethodNoSideEffect(target, "indexOfString", IndexOfString);
+  env->SetMethod(target, "sliceRetained", SliceRetained);
 
   env->SetMethod(target, "swap16", Swap16);
   env->SetMethod(target, "swap32", Swap32);
@@ -1176,6 +1301,8 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "encodeInto", EncodeInto);
   env->SetMethodNoSideEffect(target, "encodeUtf8String", EncodeUtf8String);
 
+  env->SetMethod(target, "getAllocatorStats", GetAllocatorStats);
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "kMaxLength"),
               Integer::NewFromUnsigned(env->isolate(), kMaxLength)).Check();
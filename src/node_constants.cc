@@ -53,8 +53,13 @@
 
 namespace node {
 
+using v8::Context;
+using v8::Isolate;
 using v8::Local;
+using v8::Name;
 using v8::Object;
+using v8::PropertyCallbackInfo;
+using v8::Value;
 
 namespace {
 
@@ -1262,6 +1267,13 @@ NODE_DEFINE_CONSTANT(target, UV_FS_O_FILEMAP);
   NODE_DEFINE_CONSTANT(target, COPYFILE_FICLONE_FORCE);
 # undef COPYFILE_FICLONE_FORCE
 #endif
+
+  // Node-specific copy mode, not part of libuv: attempt a reflink clone
+  // first and fall back to copying the file in parallel threadpool range
+  // tasks. Must stay clear of the UV_FS_COPYFILE_* bits above.
+#define COPYFILE_PARALLEL 8
+  NODE_DEFINE_CONSTANT(target, COPYFILE_PARALLEL);
+#undef COPYFILE_PARALLEL
 }
 
 void DefineDLOpenConstants(Local<Object> target) {
@@ -1315,56 +1327,32 @@ void DefineTraceConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, TRACE_EVENT_PHASE_LINK_IDS);
 }
 
-}  // anonymous namespace
-
-void DefineConstants(v8::Isolate* isolate, Local<Object> target) {
-  Environment* env = Environment::GetCurrent(isolate);
-
-  Local<Object> os_constants = Object::New(isolate);
-  CHECK(os_constants->SetPrototype(env->context(),
-                                   Null(env->isolate())).FromJust());
-
-  Local<Object> err_constants = Object::New(isolate);
-  CHECK(err_constants->SetPrototype(env->context(),
-                                    Null(env->isolate())).FromJust());
-
-  Local<Object> sig_constants = Object::New(isolate);
-  CHECK(sig_constants->SetPrototype(env->context(),
-                                    Null(env->isolate())).FromJust());
-
-  Local<Object> priority_constants = Object::New(isolate);
-  CHECK(priority_constants->SetPrototype(env->context(),
-                                         Null(env->isolate())).FromJust());
-
-  Local<Object> fs_constants = Object::New(isolate);
-  CHECK(fs_constants->SetPrototype(env->context(),
-                                   Null(env->isolate())).FromJust());
-
-  Local<Object> crypto_constants = Object::New(isolate);
-  CHECK(crypto_constants->SetPrototype(env->context(),
-                                       Null(env->isolate())).FromJust());
+Local<Object> NewConstantsObject(Environment* env) {
+  Local<Object> obj = Object::New(env->isolate());
+  CHECK(obj->SetPrototype(env->context(), Null(env->isolate())).FromJust());
+  return obj;
+}
 
-  Local<Object> zlib_constants = Object::New(isolate);
-  CHECK(zlib_constants->SetPrototype(env->context(),
-                                     Null(env->isolate())).FromJust());
+// The lazy getters below materialize one section of the constants binding
+// on first access. SetLazyDataProperty() then replaces the accessor with an
+// ordinary data property, so each section is built at most once per context.
 
-  Local<Object> dlopen_constants = Object::New(isolate);
-  CHECK(dlopen_constants->SetPrototype(env->context(),
-                                       Null(env->isolate())).FromJust());
+void OsConstantsGetter(Local<Name> property,
+                       const PropertyCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Isolate* isolate = env->isolate();
 
-  Local<Object> trace_constants = Object::New(isolate);
-  CHECK(trace_constants->SetPrototype(env->context(),
-                                      Null(env->isolate())).FromJust());
+  Local<Object> os_constants = NewConstantsObject(env);
+  Local<Object> err_constants = NewConstantsObject(env);
+  Local<Object> sig_constants = NewConstantsObject(env);
+  Local<Object> priority_constants = NewConstantsObject(env);
+  Local<Object> dlopen_constants = NewConstantsObject(env);
 
   DefineErrnoConstants(err_constants);
   DefineWindowsErrorConstants(err_constants);
   DefineSignalConstants(sig_constants);
   DefinePriorityConstants(priority_constants);
-  DefineSystemConstants(fs_constants);
-  DefineCryptoConstants(crypto_constants);
-  DefineZlibConstants(zlib_constants);
   DefineDLOpenConstants(dlopen_constants);
-  DefineTraceConstants(trace_constants);
 
   // Define libuv constants.
   NODE_DEFINE_CONSTANT(os_constants, UV_UDP_REUSEADDR);
@@ -1381,21 +1369,87 @@ void DefineConstants(v8::Isolate* isolate, Local<Object> target) {
   os_constants->Set(env->context(),
                     OneByteString(isolate, "priority"),
                     priority_constants).Check();
-  target->Set(env->context(),
-              OneByteString(isolate, "os"),
-              os_constants).Check();
-  target->Set(env->context(),
-              OneByteString(isolate, "fs"),
-              fs_constants).Check();
-  target->Set(env->context(),
-              OneByteString(isolate, "crypto"),
-              crypto_constants).Check();
-  target->Set(env->context(),
-              OneByteString(isolate, "zlib"),
-              zlib_constants).Check();
-  target->Set(env->context(),
-              OneByteString(isolate, "trace"),
-              trace_constants).Check();
+  info.GetReturnValue().Set(os_constants);
+}
+
+void FsConstantsGetter(Local<Name> property,
+                       const PropertyCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Local<Object> fs_constants = NewConstantsObject(env);
+  DefineSystemConstants(fs_constants);
+  info.GetReturnValue().Set(fs_constants);
+}
+
+void CryptoConstantsGetter(Local<Name> property,
+                           const PropertyCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Local<Object> crypto_constants = NewConstantsObject(env);
+  DefineCryptoConstants(crypto_constants);
+  info.GetReturnValue().Set(crypto_constants);
+}
+
+void ZlibConstantsGetter(Local<Name> property,
+                         const PropertyCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Local<Object> zlib_constants = NewConstantsObject(env);
+  DefineZlibConstants(zlib_constants);
+  info.GetReturnValue().Set(zlib_constants);
+}
+
+void TraceConstantsGetter(Local<Name> property,
+                          const PropertyCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Local<Object> trace_constants = NewConstantsObject(env);
+  DefineTraceConstants(trace_constants);
+  info.GetReturnValue().Set(trace_constants);
+}
+
+}  // anonymous namespace
+
+void DefineConstants(v8::Isolate* isolate, Local<Object> target) {
+  Environment* env = Environment::GetCurrent(isolate);
+  Local<Context> context = env->context();
+
+  // The constant tables are large — several hundred properties across the
+  // os/fs/crypto/zlib/trace sections — and every Environment, including each
+  // Worker, materializes its own copy. Install the sections as lazy data
+  // properties so that an Environment only pays the heap cost for the
+  // sections it actually reads.
+  CHECK(target->SetLazyDataProperty(context,
+                                    OneByteString(isolate, "os"),
+                                    OsConstantsGetter,
+                                    Local<Value>(),
+                                    v8::None,
+                                    v8::SideEffectType::kHasNoSideEffect)
+            .FromJust());
+  CHECK(target->SetLazyDataProperty(context,
+                                    OneByteString(isolate, "fs"),
+                                    FsConstantsGetter,
+                                    Local<Value>(),
+                                    v8::None,
+                                    v8::SideEffectType::kHasNoSideEffect)
+            .FromJust());
+  CHECK(target->SetLazyDataProperty(context,
+                                    OneByteString(isolate, "crypto"),
+                                    CryptoConstantsGetter,
+                                    Local<Value>(),
+                                    v8::None,
+                                    v8::SideEffectType::kHasNoSideEffect)
+            .FromJust());
+  CHECK(target->SetLazyDataProperty(context,
+                                    OneByteString(isolate, "zlib"),
+                                    ZlibConstantsGetter,
+                                    Local<Value>(),
+                                    v8::None,
+                                    v8::SideEffectType::kHasNoSideEffect)
+            .FromJust());
+  CHECK(target->SetLazyDataProperty(context,
+                                    OneByteString(isolate, "trace"),
+                                    TraceConstantsGetter,
+                                    Local<Value>(),
+                                    v8::None,
+                                    v8::SideEffectType::kHasNoSideEffect)
+            .FromJust());
 }
 
 }  // namespace node
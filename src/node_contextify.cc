@@ -28,8 +28,14 @@
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "module_wrap.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
 namespace node {
 namespace contextify {
 
@@ -47,6 +53,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::IndexedPropertyHandlerConfiguration;
+using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -60,6 +67,7 @@ using v8::ObjectTemplate;
 using v8::PrimitiveArray;
 using v8::PropertyAttribute;
 using v8::PropertyCallbackInfo;
+using v8::Promise;
 using v8::PropertyDescriptor;
 using v8::PropertyHandlerFlags;
 using v8::Script;
@@ -129,66 +137,66 @@ void ContextifyContext::CleanupHook(void* arg) {
 }
 
 
-// This is an object that just keeps an internal pointer to this
-// ContextifyContext.  It's passed to the NamedPropertyHandler.  If we
-// pass the main JavaScript context object we're embedded in, then the
-// NamedPropertyHandler will store a reference to it forever and keep it
-// from getting gc'd.
-MaybeLocal<Object> ContextifyContext::CreateDataWrapper(Environment* env) {
-  Local<Object> wrapper;
-  if (!env->script_data_constructor_function()
-           ->NewInstance(env->context())
-           .ToLocal(&wrapper)) {
-    return MaybeLocal<Object>();
-  }
-
-  wrapper->SetAlignedPointerInInternalField(0, this);
-  return wrapper;
-}
-
 MaybeLocal<Context> ContextifyContext::CreateV8Context(
     Environment* env,
     Local<Object> sandbox_obj,
     const ContextOptions& options) {
   EscapableHandleScope scope(env->isolate());
-  Local<FunctionTemplate> function_template =
-      FunctionTemplate::New(env->isolate());
 
-  function_template->SetClassName(sandbox_obj->GetConstructorName());
+  // The global object template is shared between all contextified contexts of
+  // this Environment: the interceptors resolve the ContextifyContext they
+  // operate on from the context's embedder data rather than from data bound
+  // to the template. Sharing the template lets V8 share the global object
+  // setup (maps, interceptor info, code compiled against it) between
+  // sandboxes, so additional sandboxes only pay for their own mutable state
+  // instead of a full template + interceptor chain each.
+  if (env->contextify_global_template().IsEmpty()) {
+    Local<FunctionTemplate> function_template =
+        FunctionTemplate::New(env->isolate());
+
+    Local<ObjectTemplate> object_template =
+        function_template->InstanceTemplate();
+
+    NamedPropertyHandlerConfiguration config(
+        PropertyGetterCallback,
+        PropertySetterCallback,
+        PropertyDescriptorCallback,
+        PropertyDeleterCallback,
+        PropertyEnumeratorCallback,
+        PropertyDefinerCallback,
+        Local<Value>(),
+        PropertyHandlerFlags::kHasNoSideEffect);
+
+    IndexedPropertyHandlerConfiguration indexed_config(
+        IndexedPropertyGetterCallback,
+        IndexedPropertySetterCallback,
+        IndexedPropertyDescriptorCallback,
+        IndexedPropertyDeleterCallback,
+        PropertyEnumeratorCallback,
+        IndexedPropertyDefinerCallback,
+        Local<Value>(),
+        PropertyHandlerFlags::kHasNoSideEffect);
+
+    object_template->SetHandler(config);
+    object_template->SetHandler(indexed_config);
+
+    env->set_contextify_global_template(object_template);
+  }
 
-  Local<ObjectTemplate> object_template =
-      function_template->InstanceTemplate();
+  Local<Context> ctx = Context::New(
+      env->isolate(), nullptr, env->contextify_global_template());
 
-  Local<Object> data_wrapper;
-  if (!CreateDataWrapper(env).ToLocal(&data_wrapper))
+  if (ctx.IsEmpty()) {
     return MaybeLocal<Context>();
+  }
 
-  NamedPropertyHandlerConfiguration config(
-      PropertyGetterCallback,
-      PropertySetterCallback,
-      PropertyDescriptorCallback,
-      PropertyDeleterCallback,
-      PropertyEnumeratorCallback,
-      PropertyDefinerCallback,
-      data_wrapper,
-      PropertyHandlerFlags::kHasNoSideEffect);
-
-  IndexedPropertyHandlerConfiguration indexed_config(
-      IndexedPropertyGetterCallback,
-      IndexedPropertySetterCallback,
-      IndexedPropertyDescriptorCallback,
-      IndexedPropertyDeleterCallback,
-      PropertyEnumeratorCallback,
-      IndexedPropertyDefinerCallback,
-      data_wrapper,
-      PropertyHandlerFlags::kHasNoSideEffect);
-
-  object_template->SetHandler(config);
-  object_template->SetHandler(indexed_config);
-
-  Local<Context> ctx = NewContext(env->isolate(), object_template);
+  // Tie the new context to this ContextifyContext before running the
+  // per-context scripts: they touch the global object, which invokes the
+  // interceptors.
+  ctx->SetAlignedPointerInEmbedderData(
+      ContextEmbedderIndex::kContextifyContext, this);
 
-  if (ctx.IsEmpty()) {
+  if (!InitializeContext(ctx)) {
     return MaybeLocal<Context>();
   }
 
@@ -224,12 +232,6 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
 
 
 void ContextifyContext::Init(Environment* env, Local<Object> target) {
-  Local<FunctionTemplate> function_template =
-      FunctionTemplate::New(env->isolate());
-  function_template->InstanceTemplate()->SetInternalFieldCount(1);
-  env->set_script_data_constructor_function(
-      function_template->GetFunction(env->context()).ToLocalChecked());
-
   env->SetMethod(target, "makeContext", MakeContext);
   env->SetMethod(target, "isContext", IsContext);
   env->SetMethod(target, "compileFunction", CompileFunction);
@@ -323,9 +325,19 @@ ContextifyContext* ContextifyContext::ContextFromContextifiedSandbox(
 // static
 template <typename T>
 ContextifyContext* ContextifyContext::Get(const PropertyCallbackInfo<T>& args) {
-  Local<Value> data = args.Data();
+  // The interceptors are only ever installed on globals of contextified
+  // contexts, so the creation context of the receiver is the context that
+  // owns the ContextifyContext. The field count check keeps this safe if a
+  // global proxy somehow crosses over from a foreign context.
+  Local<Context> context = args.This()->CreationContext();
+  if (context.IsEmpty() ||
+      context->GetNumberOfEmbedderDataFields() <=
+          ContextEmbedderIndex::kContextifyContext) {
+    return nullptr;
+  }
   return static_cast<ContextifyContext*>(
-      data.As<Object>()->GetAlignedPointerFromInternalField(0));
+      context->GetAlignedPointerFromEmbedderData(
+          ContextEmbedderIndex::kContextifyContext));
 }
 
 // static
@@ -335,7 +347,7 @@ void ContextifyContext::PropertyGetterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Local<Context> context = ctx->context();
@@ -364,7 +376,7 @@ void ContextifyContext::PropertySetterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   auto attributes = PropertyAttribute::None;
@@ -424,7 +436,7 @@ void ContextifyContext::PropertyDescriptorCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Local<Context> context = ctx->context();
@@ -446,7 +458,7 @@ void ContextifyContext::PropertyDefinerCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Local<Context> context = ctx->context();
@@ -508,7 +520,7 @@ void ContextifyContext::PropertyDeleterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Maybe<bool> success = ctx->sandbox()->Delete(ctx->context(), property);
@@ -527,7 +539,7 @@ void ContextifyContext::PropertyEnumeratorCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Local<Array> properties;
@@ -545,7 +557,7 @@ void ContextifyContext::IndexedPropertyGetterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   ContextifyContext::PropertyGetterCallback(
@@ -560,7 +572,7 @@ void ContextifyContext::IndexedPropertySetterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   ContextifyContext::PropertySetterCallback(
@@ -574,7 +586,7 @@ void ContextifyContext::IndexedPropertyDescriptorCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   ContextifyContext::PropertyDescriptorCallback(
@@ -589,7 +601,7 @@ void ContextifyContext::IndexedPropertyDefinerCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   ContextifyContext::PropertyDefinerCallback(
@@ -603,7 +615,7 @@ void ContextifyContext::IndexedPropertyDeleterCallback(
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
   // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (ctx == nullptr || ctx->context_.IsEmpty())
     return;
 
   Maybe<bool> success = ctx->sandbox()->Delete(ctx->context(), index);
@@ -616,6 +628,127 @@ void ContextifyContext::IndexedPropertyDeleterCallback(
   args.GetReturnValue().Set(false);
 }
 
+// On-disk compile cache, enabled by --compile-cache-dir. Entries are keyed
+// by a hash of the source text and validated by V8 on consumption, so a
+// hash collision or stale entry can only be rejected, never wrongly
+// accepted.
+
+static uint64_t Fnv1aHash(const char* data, size_t length) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::string CompileCachePath(const std::string& dir,
+                             const char* source,
+                             size_t length) {
+  char name[64];
+  snprintf(name,
+           sizeof(name),
+           "%016" PRIx64 "-%zu.cache",
+           Fnv1aHash(source, length),
+           length);
+  return dir + kPathSeparator + name;
+}
+
+bool ReadCompileCacheFile(const std::string& path, std::vector<char>* out) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in.is_open()) return false;
+  std::streamsize size = in.tellg();
+  if (size <= 0) return false;
+  out->resize(size);
+  in.seekg(0);
+  in.read(out->data(), size);
+  return !in.fail();
+}
+
+static uint64_t CompileCacheDirSize(const std::string& dir) {
+  uv_fs_t req;
+  uint64_t total = 0;
+  if (uv_fs_scandir(nullptr, &req, dir.c_str(), 0, nullptr) < 0) {
+    uv_fs_req_cleanup(&req);
+    return 0;
+  }
+  uv_dirent_t ent;
+  while (uv_fs_scandir_next(&req, &ent) != UV_EOF) {
+    std::string path = dir + kPathSeparator + ent.name;
+    uv_fs_t stat_req;
+    if (uv_fs_stat(nullptr, &stat_req, path.c_str(), nullptr) == 0)
+      total += stat_req.statbuf.st_size;
+    uv_fs_req_cleanup(&stat_req);
+  }
+  uv_fs_req_cleanup(&req);
+  return total;
+}
+
+// Writes a freshly produced code cache entry to disk on the threadpool so
+// that compilation latency on the main thread is unaffected. Writes go to a
+// temporary file first and are renamed into place, so concurrent readers
+// never observe a partially written entry. Owns itself; deleted after the
+// work completes.
+class CompileCacheWriter final : public ThreadPoolWork {
+ public:
+  CompileCacheWriter(Environment* env,
+                     const std::string& dir,
+                     const std::string& path,
+                     std::vector<char>&& data,
+                     uint64_t max_size)
+      : ThreadPoolWork(env),
+        dir_(dir),
+        path_(path),
+        data_(std::move(data)),
+        max_size_(max_size) {}
+
+  void DoThreadPoolWork() override {
+    if (max_size_ != 0 &&
+        CompileCacheDirSize(dir_) + data_.size() > max_size_) {
+      return;
+    }
+    std::string tmp_path = path_ + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      // The cache directory may not exist yet; create it and retry once.
+      uv_fs_t req;
+      uv_fs_mkdir(nullptr, &req, dir_.c_str(), 0777, nullptr);
+      uv_fs_req_cleanup(&req);
+      out.open(tmp_path, std::ios::binary | std::ios::trunc);
+      if (!out.is_open()) return;
+    }
+    out.write(data_.data(), data_.size());
+    out.close();
+    if (out.fail()) {
+      std::remove(tmp_path.c_str());
+      return;
+    }
+    if (std::rename(tmp_path.c_str(), path_.c_str()) != 0)
+      std::remove(tmp_path.c_str());
+  }
+
+  void AfterThreadPoolWork(int status) override { delete this; }
+
+ private:
+  std::string dir_;
+  std::string path_;
+  std::vector<char> data_;
+  uint64_t max_size_;
+};
+
+void ScheduleCompileCacheWrite(Environment* env,
+                               const std::string& path,
+                               const ScriptCompiler::CachedData* data) {
+  const char* bytes = reinterpret_cast<const char*>(data->data);
+  CompileCacheWriter* writer =
+      new CompileCacheWriter(env,
+                             env->options()->compile_cache_dir,
+                             path,
+                             std::vector<char>(bytes, bytes + data->length),
+                             env->options()->compile_cache_max_size);
+  writer->ScheduleWork();
+}
+
 void ContextifyScript::Init(Environment* env, Local<Object> target) {
   HandleScope scope(env->isolate());
   Local<String> class_name =
@@ -631,6 +764,8 @@ void ContextifyScript::Init(Environment* env, Local<Object> target) {
   target->Set(env->context(), class_name,
       script_tmpl->GetFunction(env->context()).ToLocalChecked()).Check();
   env->set_script_context_constructor_template(script_tmpl);
+
+  env->SetMethod(target, "compileScriptStreaming", CompileStreaming);
 }
 
 void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
@@ -703,6 +838,23 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
         data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
   }
 
+  // When --compile-cache-dir is set and the caller did not supply its own
+  // cached data, consult the on-disk compile cache. disk_cache_data backs
+  // the CachedData handed to the Source below and must outlive it.
+  std::string disk_cache_path;
+  std::vector<char> disk_cache_data;
+  if (cached_data == nullptr && !env->options()->compile_cache_dir.empty()) {
+    Utf8Value code_utf8(isolate, code);
+    disk_cache_path = CompileCachePath(
+        env->options()->compile_cache_dir, *code_utf8, code_utf8.length());
+    if (ReadCompileCacheFile(disk_cache_path, &disk_cache_data)) {
+      cached_data = new ScriptCompiler::CachedData(
+          reinterpret_cast<const uint8_t*>(disk_cache_data.data()),
+          disk_cache_data.size());
+    }
+  }
+  const bool disk_cache_consumed = !disk_cache_data.empty();
+
   Local<PrimitiveArray> host_defined_options =
       PrimitiveArray::New(isolate, loader::HostDefinedOptions::kLength);
   host_defined_options->Set(isolate, loader::HostDefinedOptions::kType,
@@ -749,7 +901,8 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
   }
   contextify_script->script_.Reset(isolate, v8_script.ToLocalChecked());
 
-  if (compile_options == ScriptCompiler::kConsumeCodeCache) {
+  if (compile_options == ScriptCompiler::kConsumeCodeCache &&
+      !disk_cache_consumed) {
     args.This()->Set(
         env->context(),
         env->cached_data_rejected_string(),
@@ -772,12 +925,247 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
         env->cached_data_produced_string(),
         Boolean::New(isolate, cached_data_produced)).Check();
   }
+
+  // On a disk cache miss, or when V8 rejected a stale entry, refresh the
+  // entry off-thread. A rejected entry is simply overwritten in place.
+  if (!disk_cache_path.empty() &&
+      (!disk_cache_consumed || source.GetCachedData()->rejected)) {
+    std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+        ScriptCompiler::CreateCodeCache(v8_script.ToLocalChecked()));
+    if (new_cached_data)
+      ScheduleCompileCacheWrite(env, disk_cache_path, new_cached_data.get());
+  }
+
   TRACE_EVENT_NESTABLE_ASYNC_END0(
       TRACING_CATEGORY_NODE2(vm, script),
       "ContextifyScript::New",
       contextify_script);
 }
 
+// Feeds file contents to V8's background streaming parser in chunks read
+// on the parser's own thread, so the source is never materialized as a
+// whole before parsing starts. The raw bytes are accumulated as they
+// stream by, since V8 does not build the source string itself and needs
+// it passed to Compile() at the end.
+class FdSourceStream : public ScriptCompiler::ExternalSourceStream {
+ public:
+  static constexpr size_t kChunkSize = 256 * 1024;
+
+  FdSourceStream(int fd, bool owns_fd) : fd_(fd), owns_fd_(owns_fd) {}
+
+  ~FdSourceStream() override {
+    if (owns_fd_) {
+      uv_fs_t req;
+      uv_fs_close(nullptr, &req, fd_, nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  // Called by V8 on the streaming thread; blocking reads are expected
+  // here. The caller takes ownership of the returned chunk.
+  size_t GetMoreData(const uint8_t** src) override {
+    uint8_t* chunk = new uint8_t[kChunkSize];
+    uv_buf_t buf =
+        uv_buf_init(reinterpret_cast<char*>(chunk), kChunkSize);
+    uv_fs_t req;
+    const ssize_t n = uv_fs_read(nullptr, &req, fd_, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (n <= 0) {
+      delete[] chunk;
+      return 0;
+    }
+    data_.insert(data_.end(),
+                 reinterpret_cast<char*>(chunk),
+                 reinterpret_cast<char*>(chunk) + n);
+    *src = chunk;
+    return n;
+  }
+
+  const std::vector<char>& data() const { return data_; }
+
+ private:
+  int fd_;
+  bool owns_fd_;
+  std::vector<char> data_;
+};
+
+// Runs a V8 ScriptStreamingTask on the threadpool and finalizes the
+// compilation back on the loop thread, resolving a promise with the
+// ContextifyScript. Owns itself; deleted after the work completes.
+class StreamingCompileWork : public ThreadPoolWork {
+ public:
+  StreamingCompileWork(Environment* env,
+                       int fd,
+                       bool owns_fd,
+                       Local<String> filename,
+                       int line_offset,
+                       int column_offset,
+                       Local<Promise::Resolver> resolver)
+      : ThreadPoolWork(env, WorkClass::kCpuBound),
+        env_(env),
+        stream_(new FdSourceStream(fd, owns_fd)),
+        streamed_source_(
+            std::unique_ptr<ScriptCompiler::ExternalSourceStream>(stream_),
+            ScriptCompiler::StreamedSource::UTF8),
+        line_offset_(line_offset),
+        column_offset_(column_offset) {
+    filename_.Reset(env->isolate(), filename);
+    resolver_.Reset(env->isolate(), resolver);
+  }
+
+  // Returns false when V8 declines to stream; the caller falls back to a
+  // regular compilation.
+  bool Start() {
+    task_.reset(ScriptCompiler::StartStreamingScript(env_->isolate(),
+                                                     &streamed_source_));
+    if (!task_) return false;
+    ScheduleWork();
+    return true;
+  }
+
+  void DoThreadPoolWork() override { task_->Run(); }
+
+  void AfterThreadPoolWork(int status) override {
+    Environment* env = env_;
+    std::unique_ptr<StreamingCompileWork> self(this);
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Local<Context> context = env->context();
+    Context::Scope context_scope(context);
+    InternalCallbackScope callback_scope(
+        env,
+        Local<Object>(),
+        { 0, 0 },
+        InternalCallbackScope::kAllowEmptyResource);
+
+    Local<Promise::Resolver> resolver = resolver_.Get(isolate);
+
+    if (status == UV_ECANCELED || !env->can_call_into_js()) {
+      USE(resolver->Reject(
+          context, ERR_SCRIPT_EXECUTION_INTERRUPTED(isolate)));
+      return;
+    }
+
+    const std::vector<char>& data = stream_->data();
+    Local<String> source_text;
+    if (!String::NewFromUtf8(isolate,
+                             data.data(),
+                             v8::NewStringType::kNormal,
+                             static_cast<int>(data.size()))
+             .ToLocal(&source_text)) {
+      USE(resolver->Reject(
+          context,
+          node::ERR_STRING_TOO_LONG(isolate)));
+      return;
+    }
+
+    Local<Object> object;
+    if (!env->script_context_constructor_template()
+             ->InstanceTemplate()
+             ->NewInstance(context)
+             .ToLocal(&object)) {
+      return;
+    }
+    ContextifyScript* contextify_script = new ContextifyScript(env, object);
+
+    Local<PrimitiveArray> host_defined_options =
+        PrimitiveArray::New(isolate, loader::HostDefinedOptions::kLength);
+    host_defined_options->Set(
+        isolate,
+        loader::HostDefinedOptions::kType,
+        Number::New(isolate, loader::ScriptType::kScript));
+    host_defined_options->Set(isolate,
+                              loader::HostDefinedOptions::kID,
+                              Number::New(isolate, contextify_script->id()));
+
+    ScriptOrigin origin(filename_.Get(isolate),
+                        Integer::New(isolate, line_offset_),
+                        Integer::New(isolate, column_offset_),
+                        True(isolate),                    // is cross origin
+                        Local<Integer>(),                 // script id
+                        Local<Value>(),                   // source map URL
+                        False(isolate),                   // is opaque (?)
+                        False(isolate),                   // is WASM
+                        False(isolate),                   // is ES Module
+                        host_defined_options);
+
+    TryCatchScope try_catch(env);
+    Local<Script> script;
+    if (!ScriptCompiler::Compile(context,
+                                 &streamed_source_,
+                                 source_text,
+                                 origin).ToLocal(&script)) {
+      CHECK(try_catch.HasCaught());
+      errors::DecorateErrorStack(env, try_catch);
+      USE(resolver->Reject(context, try_catch.Exception()));
+      return;
+    }
+
+    contextify_script->script_.Reset(isolate, script->GetUnboundScript());
+    // Not frozen here: lib/vm.js still needs to swap in Script.prototype
+    // before freezing, matching what `new vm.Script()` produces.
+    USE(resolver->Resolve(context, object));
+  }
+
+ private:
+  Environment* env_;
+  FdSourceStream* stream_;  // Owned by streamed_source_.
+  ScriptCompiler::StreamedSource streamed_source_;
+  std::unique_ptr<ScriptCompiler::ScriptStreamingTask> task_;
+  v8::Global<String> filename_;
+  int line_offset_;
+  int column_offset_;
+  v8::Global<Promise::Resolver> resolver_;
+};
+
+// compileScriptStreaming(fdOrPath, filename, lineOffset, columnOffset)
+void ContextifyScript::CompileStreaming(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsInt32() || args[0]->IsString());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsInt32());
+  CHECK(args[3]->IsInt32());
+
+  int fd;
+  bool owns_fd;
+  if (args[0]->IsInt32()) {
+    fd = args[0].As<Int32>()->Value();
+    owns_fd = false;
+  } else {
+    node::Utf8Value path(isolate, args[0]);
+    uv_fs_t req;
+    fd = uv_fs_open(nullptr, &req, *path, UV_FS_O_RDONLY, 0, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0) {
+      return env->ThrowUVException(fd, "open", nullptr, *path);
+    }
+    owns_fd = true;
+  }
+
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(context).ToLocal(&resolver)) return;
+  args.GetReturnValue().Set(resolver->GetPromise());
+
+  StreamingCompileWork* work =
+      new StreamingCompileWork(env,
+                               fd,
+                               owns_fd,
+                               args[1].As<String>(),
+                               args[2].As<Int32>()->Value(),
+                               args[3].As<Int32>()->Value(),
+                               resolver);
+  if (!work->Start()) {
+    // V8 declined to stream (e.g. lazy parsing disabled); resolve with
+    // undefined so the caller falls back to a regular compile.
+    delete work;
+    USE(resolver->Resolve(context, Undefined(isolate)));
+  }
+}
+
 bool ContextifyScript::InstanceOf(Environment* env,
                                   const Local<Value>& value) {
   return !value.IsEmpty() &&
@@ -1137,6 +1525,14 @@ void ContextifyContext::CompileFunction(
           .IsNothing())
     return;
 
+  if (options == ScriptCompiler::kConsumeCodeCache) {
+    if (result
+            ->Set(parsing_context,
+                  env->cached_data_rejected_string(),
+                  Boolean::New(isolate, source.GetCachedData()->rejected))
+            .IsNothing())
+      return;
+  }
   if (produce_cached_data) {
     const std::unique_ptr<ScriptCompiler::CachedData> cached_data(
         ScriptCompiler::CreateCodeCacheForFunction(fn));
@@ -25,7 +25,6 @@ class ContextifyContext {
   ~ContextifyContext();
   static void CleanupHook(void* arg);
 
-  v8::MaybeLocal<v8::Object> CreateDataWrapper(Environment* env);
   v8::MaybeLocal<v8::Context> CreateV8Context(Environment* env,
                                               v8::Local<v8::Object> sandbox_obj,
                                               const ContextOptions& options);
@@ -103,6 +102,8 @@ class ContextifyContext {
   v8::Global<v8::Context> context_;
 };
 
+class StreamingCompileWork;
+
 class ContextifyScript : public BaseObject {
  public:
   SET_NO_MEMORY_INFO()
@@ -114,6 +115,8 @@ class ContextifyScript : public BaseObject {
 
   static void Init(Environment* env, v8::Local<v8::Object> target);
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CompileStreaming(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static bool InstanceOf(Environment* env, const v8::Local<v8::Value>& args);
   static void CreateCachedData(
       const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -129,10 +132,26 @@ class ContextifyScript : public BaseObject {
   inline uint32_t id() { return id_; }
 
  private:
+  // Fills in script_ once background parsing has finished.
+  friend class StreamingCompileWork;
+
   v8::Global<v8::UnboundScript> script_;
   uint32_t id_;
 };
 
+// Helpers for the on-disk compile cache (--compile-cache-dir), shared
+// between ContextifyScript and ModuleWrap compilations. Entries are keyed
+// by a hash of the source text and validated by V8 on consumption, so a
+// stale or colliding entry can only be rejected, never wrongly accepted.
+std::string CompileCachePath(const std::string& dir,
+                             const char* source,
+                             size_t length);
+bool ReadCompileCacheFile(const std::string& path, std::vector<char>* out);
+// Copies `data` and writes it to `path` on the threadpool.
+void ScheduleCompileCacheWrite(Environment* env,
+                               const std::string& path,
+                               const v8::ScriptCompiler::CachedData* data);
+
 class CompiledFnEntry final : public BaseObject {
  public:
   SET_NO_MEMORY_INFO()
@@ -56,6 +56,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -490,6 +491,7 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "setOptions", SetOptions);
   env->SetProtoMethod(t, "setSessionIdContext", SetSessionIdContext);
   env->SetProtoMethod(t, "setSessionTimeout", SetSessionTimeout);
+  env->SetProtoMethod(t, "setMaxEarlyData", SetMaxEarlyData);
   env->SetProtoMethod(t, "close", Close);
   env->SetProtoMethod(t, "loadPKCS12", LoadPKCS12);
 #ifndef OPENSSL_NO_ENGINE
@@ -499,6 +501,8 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "setTicketKeys", SetTicketKeys);
   env->SetProtoMethod(t, "setFreeListLength", SetFreeListLength);
   env->SetProtoMethod(t, "enableTicketKeyCallback", EnableTicketKeyCallback);
+  env->SetProtoMethod(t, "enableSharedSessionCache", EnableSharedSessionCache);
+  env->SetProtoMethod(t, "enableAsyncPrivateKey", EnableAsyncPrivateKey);
   env->SetProtoMethodNoSideEffect(t, "getCertificate", GetCertificate<true>);
   env->SetProtoMethodNoSideEffect(t, "getIssuer", GetCertificate<false>);
 
@@ -947,6 +951,153 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
 }
 
 
+namespace {
+
+// Process-wide cache of parsed certificate chains, keyed by the PEM bytes
+// they were built from. SNI-heavy servers set the same chains on many
+// SecureContexts, and again on every worker thread; parsing each chain
+// once and attaching it to further contexts by reference removes the
+// repeated PEM parse on reload and deduplicates the X509 objects, which
+// OpenSSL reference-counts atomically and never mutates after parse.
+class SharedCertChainCache {
+ public:
+  static SharedCertChainCache* GetInstance() {
+    static SharedCertChainCache instance;
+    return &instance;
+  }
+
+  int UseCertificateChain(SSL_CTX* ctx,
+                          const std::string& pem,
+                          X509Pointer* cert,
+                          X509Pointer* issuer) {
+    std::shared_ptr<Chain> chain;
+    {
+      Mutex::ScopedLock lock(mutex_);
+      auto it = chains_.find(pem);
+      if (it != chains_.end())
+        chain = it->second;
+    }
+
+    if (!chain) {
+      chain = Parse(pem);
+      if (!chain)
+        return 0;
+      Mutex::ScopedLock lock(mutex_);
+      // The map is only a parse cache: attached contexts hold their own
+      // references, so dropping entries cannot invalidate anything.
+      if (chains_.size() >= kMaxEntries)
+        chains_.clear();
+      chains_.emplace(pem, chain);
+    }
+
+    return Attach(ctx, *chain, cert, issuer);
+  }
+
+ private:
+  struct Chain {
+    X509Pointer leaf;
+    StackOfX509 extra_certs;
+  };
+
+  static constexpr size_t kMaxEntries = 65536;
+
+  // Mirrors the parsing half of SSL_CTX_use_certificate_chain() above, but
+  // into free-standing X509 objects instead of a context.
+  static std::shared_ptr<Chain> Parse(const std::string& pem) {
+    ERR_clear_error();
+
+    BIOPointer in(BIO_new_mem_buf(pem.data(), pem.size()));
+    if (!in)
+      return nullptr;
+
+    auto chain = std::make_shared<Chain>();
+    chain->leaf.reset(
+        PEM_read_bio_X509_AUX(in.get(), nullptr, NoPasswordCallback, nullptr));
+    if (!chain->leaf)
+      return nullptr;
+
+    chain->extra_certs.reset(sk_X509_new_null());
+    if (!chain->extra_certs)
+      return nullptr;
+
+    while (X509Pointer extra {PEM_read_bio_X509(in.get(),
+                                                nullptr,
+                                                NoPasswordCallback,
+                                                nullptr)}) {
+      if (sk_X509_push(chain->extra_certs.get(), extra.get())) {
+        extra.release();
+        continue;
+      }
+
+      return nullptr;
+    }
+
+    // When the while loop ends, it's usually just EOF.
+    unsigned long err = ERR_peek_last_error();  // NOLINT(runtime/int)
+    if (ERR_GET_LIB(err) == ERR_LIB_PEM &&
+        ERR_GET_REASON(err) == PEM_R_NO_START_LINE) {
+      ERR_clear_error();
+    } else {
+      // some real error
+      return nullptr;
+    }
+
+    return chain;
+  }
+
+  // Mirrors the attaching half of SSL_CTX_use_certificate_chain(), except
+  // that cert/issuer share the cached X509 objects by reference instead of
+  // duplicating them.
+  static int Attach(SSL_CTX* ctx,
+                    const Chain& chain,
+                    X509Pointer* cert,
+                    X509Pointer* issuer_) {
+    CHECK(!*cert);
+    CHECK(!*issuer_);
+
+    X509* leaf = chain.leaf.get();
+    if (!SSL_CTX_use_certificate(ctx, leaf))  // Increments reference count.
+      return 0;
+
+    SSL_CTX_clear_extra_chain_certs(ctx);
+
+    X509* issuer = nullptr;
+    for (int i = 0; i < sk_X509_num(chain.extra_certs.get()); i++) {
+      X509* ca = sk_X509_value(chain.extra_certs.get(), i);
+
+      // NOTE: Increments reference count on `ca`
+      if (!SSL_CTX_add1_chain_cert(ctx, ca))
+        return 0;
+
+      // Find issuer
+      if (issuer == nullptr && X509_check_issued(ca, leaf) == X509_V_OK)
+        issuer = ca;
+    }
+
+    int ret = 1;
+    if (issuer == nullptr) {
+      // Try getting issuer from the cert store; returns a new reference.
+      ret = SSL_CTX_get_issuer(ctx, leaf, &issuer);
+      ret = ret < 0 ? 0 : 1;
+    } else {
+      X509_up_ref(issuer);
+    }
+    issuer_->reset(issuer);
+
+    if (ret) {
+      X509_up_ref(leaf);
+      cert->reset(leaf);
+    }
+    return ret;
+  }
+
+  Mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Chain>> chains_;
+};
+
+}  // anonymous namespace
+
+
 void SecureContext::SetCert(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -957,17 +1108,22 @@ void SecureContext::SetCert(const FunctionCallbackInfo<Value>& args) {
     return THROW_ERR_MISSING_ARGS(env, "Certificate argument is mandatory");
   }
 
-  BIOPointer bio(LoadBIO(env, args[0]));
-  if (!bio)
+  std::string pem;
+  if (args[0]->IsString()) {
+    const node::Utf8Value s(env->isolate(), args[0]);
+    pem.assign(*s, s.length());
+  } else if (args[0]->IsArrayBufferView()) {
+    ArrayBufferViewContents<char> buf(args[0].As<ArrayBufferView>());
+    pem.assign(buf.data(), buf.length());
+  } else {
     return;
+  }
 
   sc->cert_.reset();
   sc->issuer_.reset();
 
-  int rv = SSL_CTX_use_certificate_chain(sc->ctx_.get(),
-                                         std::move(bio),
-                                         &sc->cert_,
-                                         &sc->issuer_);
+  int rv = SharedCertChainCache::GetInstance()->UseCertificateChain(
+      sc->ctx_.get(), pem, &sc->cert_, &sc->issuer_);
 
   if (!rv) {
     unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
@@ -1404,6 +1560,20 @@ void SecureContext::SetSessionTimeout(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Announce TLS1.3 0-RTT support: session tickets issued from this context
+// allow clients to send up to `max` bytes of early data with a resumed
+// handshake. Individual connections must still opt into reading it; see
+// TLSWrap::EnableEarlyData().
+void SecureContext::SetMaxEarlyData(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  CHECK_EQ(args.Length(), 1);
+  CHECK(args[0]->IsUint32());
+  SSL_CTX_set_max_early_data(sc->ctx_.get(), args[0].As<Uint32>()->Value());
+}
+
+
 void SecureContext::Close(const FunctionCallbackInfo<Value>& args) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
@@ -1588,6 +1758,156 @@ void SecureContext::EnableTicketKeyCallback(
 }
 
 
+namespace {
+
+// Process-wide external session cache, shared by every SecureContext that
+// opted in via enableSharedSessionCache(). Because it is process-global, a
+// session established by a TLS server running on one worker thread can be
+// resumed by a server on any other thread. Sessions are stored in
+// serialized (DER) form, so no SSL_SESSION is ever shared between threads;
+// the store is sharded by session id and each shard has its own lock to
+// keep handshakes on different threads from contending.
+class SharedSessionCache {
+ public:
+  static constexpr size_t kShardCount = 16;  // Must be a power of two.
+  static constexpr size_t kMaxEntriesPerShard = 1024;
+
+  static SharedSessionCache* GetInstance() {
+    static SharedSessionCache instance;
+    return &instance;
+  }
+
+  void Attach(SSL_CTX* ctx) {
+    SSL_CTX_set_session_cache_mode(
+        ctx, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+    SSL_CTX_sess_set_new_cb(ctx, NewSessionCallback);
+    SSL_CTX_sess_set_get_cb(ctx, GetSessionCallback);
+  }
+
+ private:
+  struct Entry {
+    std::vector<unsigned char> der;
+    uint64_t expires;
+  };
+
+  struct Shard {
+    Mutex mutex;
+    std::unordered_map<std::string, Entry> sessions;
+  };
+
+  Shard* ShardFor(const std::string& key) {
+    return &shards_[std::hash<std::string>()(key) & (kShardCount - 1)];
+  }
+
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* sess) {
+    SharedSessionCache* cache = GetInstance();
+
+    unsigned int id_size;
+    const unsigned char* id = SSL_SESSION_get_id(sess, &id_size);
+    int der_size = i2d_SSL_SESSION(sess, nullptr);
+    if (id_size == 0 || der_size <= 0 ||
+        der_size > SecureContext::kMaxSessionSize) {
+      return 0;
+    }
+
+    Entry entry;
+    entry.der.resize(der_size);
+    unsigned char* der_ptr = entry.der.data();
+    i2d_SSL_SESSION(sess, &der_ptr);
+    entry.expires = static_cast<uint64_t>(SSL_SESSION_get_time(sess)) +
+                    SSL_SESSION_get_timeout(sess);
+
+    std::string key(reinterpret_cast<const char*>(id), id_size);
+    Shard* shard = cache->ShardFor(key);
+    Mutex::ScopedLock lock(shard->mutex);
+
+    if (shard->sessions.size() >= kMaxEntriesPerShard &&
+        shard->sessions.count(key) == 0) {
+      cache->Evict(shard);
+    }
+    shard->sessions[key] = std::move(entry);
+
+    // Returning 0 tells OpenSSL that we did not keep a reference to sess.
+    return 0;
+  }
+
+  static SSL_SESSION* GetSessionCallback(SSL* ssl,
+                                         const unsigned char* id,
+                                         int id_size,
+                                         int* copy) {
+    SharedSessionCache* cache = GetInstance();
+
+    // We return a session the caller may take ownership of.
+    *copy = 0;
+
+    if (id_size <= 0)
+      return nullptr;
+    std::string key(reinterpret_cast<const char*>(id), id_size);
+    Shard* shard = cache->ShardFor(key);
+
+    std::vector<unsigned char> der;
+    {
+      Mutex::ScopedLock lock(shard->mutex);
+      auto it = shard->sessions.find(key);
+      if (it == shard->sessions.end())
+        return nullptr;
+      if (it->second.expires <= static_cast<uint64_t>(time(nullptr))) {
+        shard->sessions.erase(it);
+        return nullptr;
+      }
+      der = it->second.der;
+    }
+
+    // Deserialize outside the lock; d2i is the expensive part.
+    const unsigned char* der_ptr = der.data();
+    return d2i_SSL_SESSION(nullptr, &der_ptr, der.size());
+  }
+
+  // Drop an expired entry if there is one, an arbitrary one otherwise.
+  // Called with the shard lock held.
+  void Evict(Shard* shard) {
+    uint64_t now = static_cast<uint64_t>(time(nullptr));
+    for (auto it = shard->sessions.begin(); it != shard->sessions.end();
+         ++it) {
+      if (it->second.expires <= now) {
+        shard->sessions.erase(it);
+        return;
+      }
+    }
+    if (!shard->sessions.empty())
+      shard->sessions.erase(shard->sessions.begin());
+  }
+
+  Shard shards_[kShardCount];
+};
+
+}  // anonymous namespace
+
+
+void SecureContext::EnableSharedSessionCache(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  wrap->use_shared_session_cache_ = true;
+  SharedSessionCache::GetInstance()->Attach(wrap->ctx_.get());
+}
+
+
+// Full handshakes run the private key operation synchronously on the event
+// loop by default; a single 2048-bit RSA sign costs several hundred
+// microseconds. This moves it to the libuv threadpool. Must be called after
+// the key has been assigned. Returns false when the offload is not
+// available, in which case the key operations simply stay on the loop.
+void SecureContext::EnableAsyncPrivateKey(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  args.GetReturnValue().Set(TLSWrap::InstallAsyncPrivateKey(wrap->ctx_.get()));
+}
+
+
 int SecureContext::TicketKeyCallback(SSL* ssl,
                                      unsigned char* name,
                                      unsigned char* iv,
@@ -3980,6 +4300,7 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "init", Init);
   env->SetProtoMethod(t, "initiv", InitIv);
   env->SetProtoMethod(t, "update", Update);
+  env->SetProtoMethod(t, "updateInPlace", UpdateInPlace);
   env->SetProtoMethod(t, "final", Final);
   env->SetProtoMethod(t, "setAutoPadding", SetAutoPadding);
   env->SetProtoMethodNoSideEffect(t, "getAuthTag", GetAuthTag);
@@ -4467,6 +4788,50 @@ CipherBase::UpdateResult CipherBase::Update(const char* data,
 }
 
 
+// Cipher into the input buffer itself instead of allocating an output
+// buffer. Only valid for cipher modes with a block size of one (stream
+// ciphers, CTR, GCM, ...), where the amount of output produced by an
+// update always equals the amount of input consumed, so the result can
+// never outgrow the buffer it replaces.
+CipherBase::UpdateResult CipherBase::UpdateInPlace(char* data, int len) {
+  if (!ctx_)
+    return kErrorState;
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  const int mode = EVP_CIPHER_CTX_mode(ctx_.get());
+
+  if (EVP_CIPHER_CTX_block_size(ctx_.get()) != 1)
+    return kErrorState;
+
+  if (mode == EVP_CIPH_CCM_MODE) {
+    if (!CheckCCMMessageLength(len))
+      return kErrorMessageSize;
+  }
+
+  // Pass the authentication tag to OpenSSL if possible. This will only happen
+  // once, usually on the first update.
+  if (kind_ == kDecipher && IsAuthenticatedMode()) {
+    CHECK(MaybePassAuthTagToOpenSSL());
+  }
+
+  int buf_len = 0;
+  int r = EVP_CipherUpdate(ctx_.get(),
+                           reinterpret_cast<unsigned char*>(data),
+                           &buf_len,
+                           reinterpret_cast<const unsigned char*>(data),
+                           len);
+  CHECK_IMPLIES(r == 1, buf_len == len);
+
+  // When in CCM mode, EVP_CipherUpdate will fail if the authentication tag is
+  // invalid. In that case, remember the error and throw in final().
+  if (!r && kind_ == kDecipher && mode == EVP_CIPH_CCM_MODE) {
+    pending_auth_failed_ = true;
+    return kSuccess;
+  }
+  return r == 1 ? kSuccess : kErrorState;
+}
+
+
 void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -4503,6 +4868,36 @@ void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void CipherBase::UpdateInPlace(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+
+  CHECK(args[0]->IsArrayBufferView());  // buffer
+  CHECK(args[1]->IsUint32());  // offset
+  CHECK(args[2]->IsUint32());  // length
+  const uint32_t offset = args[1].As<Uint32>()->Value();
+  const uint32_t length = args[2].As<Uint32>()->Value();
+  CHECK_GE(offset + length, offset);  // Overflow check.
+  CHECK_LE(offset + length, Buffer::Length(args[0]));  // Bounds check.
+
+  UpdateResult r =
+      cipher->UpdateInPlace(Buffer::Data(args[0]) + offset, length);
+
+  if (r != kSuccess) {
+    if (r == kErrorState) {
+      ThrowCryptoError(env, ERR_get_error(),
+                       "Trying to add data in unsupported state");
+    }
+    return;
+  }
+
+  // Block-size-one modes produce exactly as many bytes as they consume.
+  args.GetReturnValue().Set(length);
+}
+
+
 bool CipherBase::SetAutoPadding(bool auto_padding) {
   if (!ctx_)
     return false;
@@ -4601,6 +4996,7 @@ void Hmac::Initialize(Environment* env, Local<Object> target) {
 
   env->SetProtoMethod(t, "init", HmacInit);
   env->SetProtoMethod(t, "update", HmacUpdate);
+  env->SetProtoMethod(t, "updateMany", HmacUpdateMany);
   env->SetProtoMethod(t, "digest", HmacDigest);
 
   target->Set(env->context(),
@@ -4678,6 +5074,38 @@ void Hmac::HmacUpdate(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Digest an array of ArrayBufferViews in one binding call, so input that
+// arrives as many chunks pays a single JS->C++ transition instead of one
+// per chunk.
+void Hmac::HmacUpdateMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Hmac* hmac;
+  ASSIGN_OR_RETURN_UNWRAP(&hmac, args.Holder());
+
+  CHECK(args[0]->IsArray());
+  Local<Array> chunks = args[0].As<Array>();
+  const uint32_t length = chunks->Length();
+
+  bool r = true;
+  for (uint32_t i = 0; r && i < length; i++) {
+    Local<Value> chunk;
+    if (!chunks->Get(env->context(), i).ToLocal(&chunk))
+      return;
+    // lib-side validation cannot be trusted here: a Proxy-backed array can
+    // hand the binding a different value than the one that was validated.
+    if (!chunk->IsArrayBufferView()) {
+      return THROW_ERR_INVALID_ARG_TYPE(
+          env, "Every chunk must be an ArrayBufferView");
+    }
+    ArrayBufferViewContents<char> buf(chunk.As<ArrayBufferView>());
+    r = hmac->HmacUpdate(buf.data(), buf.length());
+  }
+
+  args.GetReturnValue().Set(r);
+}
+
+
 void Hmac::HmacDigest(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -4719,6 +5147,7 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   t->InstanceTemplate()->SetInternalFieldCount(1);
 
   env->SetProtoMethod(t, "update", HashUpdate);
+  env->SetProtoMethod(t, "updateMany", HashUpdateMany);
   env->SetProtoMethod(t, "digest", HashDigest);
 
   target->Set(env->context(),
@@ -4816,6 +5245,36 @@ void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// See Hmac::HmacUpdateMany().
+void Hash::HashUpdateMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Hash* hash;
+  ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
+
+  CHECK(args[0]->IsArray());
+  Local<Array> chunks = args[0].As<Array>();
+  const uint32_t length = chunks->Length();
+
+  bool r = true;
+  for (uint32_t i = 0; r && i < length; i++) {
+    Local<Value> chunk;
+    if (!chunks->Get(env->context(), i).ToLocal(&chunk))
+      return;
+    // lib-side validation cannot be trusted here: a Proxy-backed array can
+    // hand the binding a different value than the one that was validated.
+    if (!chunk->IsArrayBufferView()) {
+      return THROW_ERR_INVALID_ARG_TYPE(
+          env, "Every chunk must be an ArrayBufferView");
+    }
+    ArrayBufferViewContents<char> buf(chunk.As<ArrayBufferView>());
+    r = hash->HashUpdate(buf.data(), buf.length());
+  }
+
+  args.GetReturnValue().Set(r);
+}
+
+
 void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -6210,7 +6669,8 @@ bool ECDH::IsKeyPairValid() {
 struct CryptoJob : public ThreadPoolWork {
   Environment* const env;
   std::unique_ptr<AsyncWrap> async_wrap;
-  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env), env(env) {}
+  inline explicit CryptoJob(Environment* env)
+      : ThreadPoolWork(env, WorkClass::kCpuBound), env(env) {}
   inline void AfterThreadPoolWork(int status) final;
   virtual void AfterThreadPoolWork() = 0;
   static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
@@ -6246,6 +6706,121 @@ inline void CopyBuffer(Local<Value> buf, std::vector<char>* vec) {
 }
 
 
+namespace {
+
+// Buffered entropy for small synchronous randomBytes()/randomFillSync()
+// requests, so that they can be served with a memcpy instead of entering
+// OpenSSL's RAND machinery on every call. Each Environment runs its event
+// loop on its own thread, so a thread-local pool is per-Environment
+// without having to thread state through it. The pool is consumed from
+// the top and refilled in one large block on the threadpool once it runs
+// low; while no refilled block is ready, requests fall back to the
+// regular RAND_bytes() path.
+class RandomBytesPool {
+ public:
+  static constexpr size_t kPoolSize = 65536;
+  static constexpr size_t kMaxRequestSize = 1024;
+  static constexpr size_t kRefillWatermark = kPoolSize / 4;
+
+  // Copies `size` random bytes into `out`. Returns false when the request
+  // is too large or the pool is empty, in which case the caller generates
+  // the bytes itself.
+  bool Fill(Environment* env, unsigned char* out, size_t size) {
+    if (size > kMaxRequestSize)
+      return false;
+
+    // A forked child would otherwise hand out the same bytes as its
+    // parent; drop everything that was buffered before the fork.
+    const uv_pid_t pid = uv_os_getpid();
+    if (pid != pid_) {
+      pid_ = pid;
+      available_ = 0;
+      standby_.reset();
+      standby_ready_ = false;
+      refill_pending_ = false;
+    }
+
+    if (size > available_ && !TakeStandby()) {
+      MaybeScheduleRefill(env);
+      return false;
+    }
+
+    available_ -= size;
+    memcpy(out, data_ + available_, size);
+    // Do not keep copies of handed-out entropy around.
+    OPENSSL_cleanse(data_ + available_, size);
+
+    MaybeScheduleRefill(env);
+    return true;
+  }
+
+ private:
+  struct RefillJob {
+    uv_work_t work_req;
+    RandomBytesPool* pool;
+    std::unique_ptr<unsigned char[]> data;
+    bool ok = false;
+  };
+
+  bool TakeStandby() {
+    if (!standby_ready_)
+      return false;
+    memcpy(data_, standby_.get(), kPoolSize);
+    OPENSSL_cleanse(standby_.get(), kPoolSize);
+    standby_.reset();
+    standby_ready_ = false;
+    available_ = kPoolSize;
+    return true;
+  }
+
+  void MaybeScheduleRefill(Environment* env) {
+    if (refill_pending_ || standby_ready_ || available_ >= kRefillWatermark)
+      return;
+
+    RefillJob* job = new RefillJob();
+    job->pool = this;
+    job->data.reset(new unsigned char[kPoolSize]);
+
+    // The after-work callback runs on the loop thread that owns this pool,
+    // so no synchronization with Fill() is needed.
+    int err = uv_queue_work(
+        env->event_loop(),
+        &job->work_req,
+        [](uv_work_t* req) {
+          RefillJob* job = ContainerOf(&RefillJob::work_req, req);
+          CheckEntropy();  // Ensure that OpenSSL's PRNG is properly seeded.
+          job->ok = RAND_bytes(job->data.get(), kPoolSize) == 1;
+        },
+        [](uv_work_t* req, int status) {
+          std::unique_ptr<RefillJob> job(
+              ContainerOf(&RefillJob::work_req, req));
+          RandomBytesPool* pool = job->pool;
+          pool->refill_pending_ = false;
+          if (status == UV_ECANCELED || !job->ok)
+            return;
+          pool->standby_ = std::move(job->data);
+          pool->standby_ready_ = true;
+        });
+    if (err != 0) {
+      delete job;
+      return;
+    }
+    refill_pending_ = true;
+  }
+
+  unsigned char data_[kPoolSize];
+  size_t available_ = 0;
+  std::unique_ptr<unsigned char[]> standby_;
+  bool standby_ready_ = false;
+  bool refill_pending_ = false;
+  uv_pid_t pid_ = 0;
+};
+
+thread_local RandomBytesPool random_bytes_pool;
+
+}  // anonymous namespace
+
+
 struct RandomBytesJob : public CryptoJob {
   unsigned char* data;
   size_t size;
@@ -6283,8 +6858,18 @@ void RandomBytes(const FunctionCallbackInfo<Value>& args) {
   CHECK_GE(offset + size, offset);  // Overflow check.
   CHECK_LE(offset + size, Buffer::Length(args[0]));  // Bounds check.
   Environment* env = Environment::GetCurrent(args);
+  unsigned char* data =
+      reinterpret_cast<unsigned char*>(Buffer::Data(args[0])) + offset;
+
+  // Small synchronous requests are sliced off the buffered entropy pool
+  // when it has enough bytes; asynchronous requests go through the
+  // threadpool anyway, where the RAND call is not what they pay for.
+  if (!args[3]->IsObject() && random_bytes_pool.Fill(env, data, size)) {
+    return args.GetReturnValue().Set(Undefined(env->isolate()));
+  }
+
   std::unique_ptr<RandomBytesJob> job(new RandomBytesJob(env));
-  job->data = reinterpret_cast<unsigned char*>(Buffer::Data(args[0])) + offset;
+  job->data = data;
   job->size = size;
   if (args[3]->IsObject()) return RandomBytesJob::Run(std::move(job), args[3]);
   env->PrintSyncTrace();
@@ -7108,6 +7693,73 @@ void TimingSafeEqual(const FunctionCallbackInfo<Value>& args) {
       CRYPTO_memcmp(buf1.data(), buf2.data(), buf1.length()) == 0);
 }
 
+// Constant-time comparison accumulating the XOR of the inputs a word at a
+// time instead of CRYPTO_memcmp's byte loop; branch-free on the data.
+static uint64_t ConstantTimeDiff(const char* a, const char* b, size_t len) {
+  uint64_t diff = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t wa;
+    uint64_t wb;
+    memcpy(&wa, a + i, sizeof(uint64_t));
+    memcpy(&wb, b + i, sizeof(uint64_t));
+    diff |= wa ^ wb;
+  }
+  for (; i < len; i++) {
+    diff |= static_cast<uint64_t>(
+        static_cast<unsigned char>(a[i]) ^ static_cast<unsigned char>(b[i]));
+  }
+  return diff;
+}
+
+// Compares one probe against an array of equally sized candidates in a
+// single binding call and returns the index of the first match, or -1.
+// Every candidate is compared and the result index is folded in without
+// branching on the outcome, so neither the amount of work nor the memory
+// access pattern depends on where (or whether) a match occurs.
+void TimingSafeEqualMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsArray());
+  Local<Array> candidates = args[1].As<Array>();
+  const uint32_t length = candidates->Length();
+
+  // Array::Get can run arbitrary JS (Proxy traps, index getters) that may
+  // hand the binding different values than lib-side validation saw, or
+  // detach a buffer whose contents were captured earlier. Collect and
+  // type-check every element first; only once no more JS can run are any
+  // data pointers taken, and mismatches throw rather than abort.
+  MaybeStackBuffer<Local<ArrayBufferView>, 16> views(length);
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> candidate;
+    if (!candidates->Get(env->context(), i).ToLocal(&candidate))
+      return;
+    if (!candidate->IsArrayBufferView()) {
+      return THROW_ERR_INVALID_ARG_TYPE(
+          env, "Every candidate must be an ArrayBufferView");
+    }
+    views[i] = candidate.As<ArrayBufferView>();
+  }
+
+  ArrayBufferViewContents<char> probe(args[0]);
+
+  int32_t match = -1;
+  for (uint32_t i = 0; i < length; i++) {
+    ArrayBufferViewContents<char> buf(views[i]);
+    if (buf.length() != probe.length())
+      return THROW_ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH(env);
+
+    const int32_t is_eq =
+        ConstantTimeDiff(probe.data(), buf.data(), probe.length()) == 0;
+    // Take this index if it matched and no earlier candidate did.
+    const int32_t take = -(is_eq & (match < 0));
+    match = (match & ~take) | (static_cast<int32_t>(i) & take);
+  }
+
+  args.GetReturnValue().Set(match);
+}
+
 void InitCryptoOnce() {
 #ifndef OPENSSL_IS_BORINGSSL
   OPENSSL_INIT_SETTINGS* settings = OPENSSL_INIT_new();
@@ -7269,6 +7921,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "signOneShot", SignOneShot);
   env->SetMethod(target, "verifyOneShot", VerifyOneShot);
   env->SetMethodNoSideEffect(target, "timingSafeEqual", TimingSafeEqual);
+  env->SetMethodNoSideEffect(target, "timingSafeEqualMany", TimingSafeEqualMany);
   env->SetMethodNoSideEffect(target, "getSSLCiphers", GetSSLCiphers);
   env->SetMethodNoSideEffect(target, "getCiphers", GetCiphers);
   env->SetMethodNoSideEffect(target, "getHashes", GetHashes);
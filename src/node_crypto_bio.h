@@ -142,15 +142,13 @@ class NodeBIO : public MemoryRetainer {
                                            next_(nullptr) {
       data_ = new char[len];
       if (env_ != nullptr)
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
+        env_->AdjustExternalMemory(len);
     }
 
     ~Buffer() {
       delete[] data_;
-      if (env_ != nullptr) {
-        const int64_t len = static_cast<int64_t>(len_);
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
-      }
+      if (env_ != nullptr)
+        env_->AdjustExternalMemory(-static_cast<int64_t>(len_));
     }
 
     Environment* env_;
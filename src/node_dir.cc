@@ -2,7 +2,7 @@
 #include "node_file-inl.h"
 #include "node_process.h"
 #include "memory_tracker-inl.h"
-#include "util.h"
+#include "util-inl.h"
 
 #include "tracing/trace_event.h"
 
@@ -41,6 +41,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 #define TRACE_NAME(name) "fs_dir.sync." #name
@@ -343,6 +344,221 @@ static void OpenDir(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+DirWalker::DirWalker(Environment* env,
+                     Local<Object> obj,
+                     std::string root,
+                     bool with_stats)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_DIRHANDLE),
+      entry_data_(env->isolate(), 2 * kBatchLimit),
+      root_(std::move(root)),
+      with_stats_(with_stats) {
+  MakeWeak();
+  // The empty suffix stands for the walk root itself.
+  pending_dirs_.emplace_back("");
+  USE(obj->Set(env->context(),
+               FIXED_ONE_BYTE_STRING(env->isolate(), "entryData"),
+               entry_data_.GetJSArray()));
+}
+
+DirWalker* DirWalker::New(Environment* env, std::string root, bool with_stats) {
+  Local<Object> obj;
+  if (!env->dir_walker_instance_template()
+          ->NewInstance(env->context())
+          .ToLocal(&obj)) {
+    return nullptr;
+  }
+
+  return new DirWalker(env, obj, std::move(root), with_stats);
+}
+
+void DirWalker::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+}
+
+void DirWalker::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("entry_data", entry_data_);
+}
+
+struct DirWalker::ReadJob {
+  uv_work_t work_req;
+  BaseObjectPtr<DirWalker> walker;
+  BaseObjectPtr<FSReqBase> wrap;
+  uint32_t batch;
+  std::vector<Entry> entries;
+  int error = 0;
+};
+
+void DirWalker::DoRead(uv_work_t* req) {
+  ReadJob* job = ContainerOf(&ReadJob::work_req, req);
+  DirWalker* walker = job->walker.get();
+
+  while (job->entries.size() < job->batch) {
+    // Serve leftovers of a partially consumed directory first.
+    if (!walker->pending_entries_.empty()) {
+      job->entries.emplace_back(std::move(walker->pending_entries_.front()));
+      walker->pending_entries_.pop_front();
+      continue;
+    }
+
+    if (walker->pending_dirs_.empty())
+      break;  // Traversal complete.
+
+    const std::string rel = std::move(walker->pending_dirs_.front());
+    walker->pending_dirs_.pop_front();
+    std::string full = walker->root_;
+    if (!rel.empty()) {
+      full += kPathSeparator;
+      full += rel;
+    }
+
+    uv_fs_t scan_req;
+    const int n = uv_fs_scandir(nullptr, &scan_req, full.c_str(), 0, nullptr);
+    if (n < 0) {
+      uv_fs_req_cleanup(&scan_req);
+      if (rel.empty()) {
+        // The walk root itself is unreadable; report that. Subdirectories
+        // that disappeared or are unreadable mid-walk are skipped, as any
+        // racing traversal would.
+        job->error = n;
+        return;
+      }
+      continue;
+    }
+
+    uv_dirent_t ent;
+    while (uv_fs_scandir_next(&scan_req, &ent) != UV_EOF) {
+      Entry entry;
+      entry.path = rel.empty() ? std::string(ent.name)
+                               : rel + kPathSeparator + ent.name;
+      entry.type = ent.type;
+      entry.size = -1;
+
+      // Stat when asked to, and also whenever the filesystem did not
+      // report an entry type: the recursion has to know about
+      // directories either way.
+      if (walker->with_stats_ || ent.type == UV_DIRENT_UNKNOWN) {
+        std::string entry_full = full;
+        entry_full += kPathSeparator;
+        entry_full += ent.name;
+        uv_fs_t stat_req;
+        if (uv_fs_lstat(nullptr, &stat_req, entry_full.c_str(), nullptr) ==
+            0) {
+          const uv_stat_t* s = static_cast<const uv_stat_t*>(stat_req.ptr);
+          entry.size = static_cast<double>(s->st_size);
+          if (entry.type == UV_DIRENT_UNKNOWN && (s->st_mode & S_IFDIR))
+            entry.type = UV_DIRENT_DIR;
+        }
+        uv_fs_req_cleanup(&stat_req);
+      }
+
+      if (entry.type == UV_DIRENT_DIR)
+        walker->pending_dirs_.emplace_back(entry.path);
+
+      if (job->entries.size() < job->batch)
+        job->entries.emplace_back(std::move(entry));
+      else
+        walker->pending_entries_.emplace_back(std::move(entry));
+    }
+    uv_fs_req_cleanup(&scan_req);
+  }
+}
+
+void DirWalker::AfterRead(uv_work_t* req, int status) {
+  std::unique_ptr<ReadJob> job(ContainerOf(&ReadJob::work_req, req));
+  BaseObjectPtr<DirWalker> walker = std::move(job->walker);
+  BaseObjectPtr<FSReqBase> wrap = std::move(job->wrap);
+  walker->reading_ = false;
+  if (status == UV_ECANCELED)
+    return;
+
+  Environment* env = walker->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  if (job->error < 0) {
+    return wrap->Reject(UVException(isolate,
+                                    job->error,
+                                    "scandir",
+                                    nullptr,
+                                    walker->root_.c_str(),
+                                    nullptr));
+  }
+
+  const size_t count = job->entries.size();
+  MaybeStackBuffer<Local<Value>, 64> names(count);
+  for (size_t i = 0; i < count; i++) {
+    const Entry& entry = job->entries[i];
+    walker->entry_data_.SetValue(2 * i, entry.type);
+    walker->entry_data_.SetValue(2 * i + 1, entry.size);
+
+    Local<Value> name;
+    Local<Value> error;
+    if (!StringBytes::Encode(isolate,
+                             entry.path.c_str(),
+                             entry.path.size(),
+                             UTF8,
+                             &error).ToLocal(&name)) {
+      return wrap->Reject(error);
+    }
+    names[i] = name;
+  }
+
+  wrap->Resolve(Array::New(isolate, names.out(), count));
+}
+
+void DirWalker::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  DirWalker* walker;
+  ASSIGN_OR_RETURN_UNWRAP(&walker, args.Holder());
+
+  CHECK(args[0]->IsUint32());
+  uint32_t batch = args[0].As<Uint32>()->Value();
+  if (batch == 0 || batch > kBatchLimit)
+    batch = kBatchLimit;
+
+  FSReqBase* req_wrap = GetReqWrap(env, args[1]);
+  CHECK_NOT_NULL(req_wrap);
+
+  // One page at a time; the threadpool job owns the walker state while a
+  // read is in flight.
+  CHECK(!walker->reading_);
+  walker->reading_ = true;
+  req_wrap->Init("scandir", nullptr, 0, UTF8);
+
+  ReadJob* job = new ReadJob();
+  job->walker = BaseObjectPtr<DirWalker>(walker);
+  job->wrap = BaseObjectPtr<FSReqBase>(req_wrap);
+  // No FSReqAfterScope runs for this job; the job's reference owns the
+  // wrap and deletes it once the page has been resolved.
+  req_wrap->Detach();
+  job->batch = batch;
+  CHECK_EQ(0, uv_queue_work(env->event_loop(), &job->work_req,
+                            DoRead, AfterRead));
+
+  args.GetReturnValue().Set(req_wrap->object());
+}
+
+static void WalkDir(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  DirWalker* walker = DirWalker::New(
+      env, std::string(*path, path.length()), args[1]->IsTrue());
+  if (walker != nullptr)
+    args.GetReturnValue().Set(walker->object());
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -351,6 +567,7 @@ void Initialize(Local<Object> target,
   Isolate* isolate = env->isolate();
 
   env->SetMethod(target, "opendir", OpenDir);
+  env->SetMethod(target, "walkdir", WalkDir);
 
   // Create FunctionTemplate for DirHandle
   Local<FunctionTemplate> dir = env->NewFunctionTemplate(DirHandle::New);
@@ -367,6 +584,20 @@ void Initialize(Local<Object> target,
             dir->GetFunction(env->context()).ToLocalChecked())
       .FromJust();
   env->set_dir_instance_template(dirt);
+
+  // Create FunctionTemplate for DirWalker
+  Local<FunctionTemplate> walker = env->NewFunctionTemplate(DirWalker::New);
+  walker->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(walker, "read", DirWalker::Read);
+  Local<ObjectTemplate> walkert = walker->InstanceTemplate();
+  walkert->SetInternalFieldCount(DirHandle::kDirHandleFieldCount);
+  Local<String> walkerString = FIXED_ONE_BYTE_STRING(isolate, "DirWalker");
+  walker->SetClassName(walkerString);
+  target
+      ->Set(context, walkerString,
+            walker->GetFunction(env->context()).ToLocalChecked())
+      .FromJust();
+  env->set_dir_walker_instance_template(walkert);
 }
 
 }  // namespace fs_dir
@@ -45,6 +45,63 @@ class DirHandle : public AsyncWrap {
   bool closed_ = false;
 };
 
+// Streams a recursive directory walk in batches. A single walker performs
+// the whole traversal on the threadpool with an internal directory queue,
+// so large trees cost one JS round trip per page of entries instead of an
+// opendir()/readdir() cycle per subdirectory.
+class DirWalker final : public AsyncWrap {
+ public:
+  // Upper bound for entries delivered per read(); sizes the reusable
+  // entry data buffer.
+  static constexpr uint32_t kBatchLimit = 1024;
+
+  static DirWalker* New(Environment* env, std::string root, bool with_stats);
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // read(batchSize, req): resolves `req` with an array of path suffixes
+  // (relative to the walk root); dirent types and sizes for the page are
+  // left in the `entryData` Float64Array. An empty array means the walk
+  // has finished.
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(DirWalker)
+  SET_SELF_SIZE(DirWalker)
+
+  DirWalker(const DirWalker&) = delete;
+  DirWalker& operator=(const DirWalker&) = delete;
+
+ private:
+  DirWalker(Environment* env,
+            v8::Local<v8::Object> obj,
+            std::string root,
+            bool with_stats);
+
+  struct Entry {
+    std::string path;
+    int type;
+    double size;
+  };
+  struct ReadJob;
+
+  static void DoRead(uv_work_t* req);
+  static void AfterRead(uv_work_t* req, int status);
+
+  // [2 * i] holds the dirent type and [2 * i + 1] the size (-1 when not
+  // statted) for the i-th name of the most recent page; reused across
+  // pages and exposed to JS as `entryData`.
+  AliasedFloat64Array entry_data_;
+  std::string root_;
+  const bool with_stats_;
+  // Guards the walker state below; only the threadpool job touches it
+  // while a read is in flight.
+  bool reading_ = false;
+  std::deque<std::string> pending_dirs_;
+  // Entries of a partially consumed directory that did not fit into the
+  // previous page.
+  std::deque<Entry> pending_entries_;
+};
+
 }  // namespace fs_dir
 
 }  // namespace node
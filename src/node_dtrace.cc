@@ -42,9 +42,19 @@
 #define NODE_GC_DONE(arg0, arg1, arg2)
 #endif
 
+#ifndef HAVE_DTRACE
+/*
+ * The expanded probe set (stream, http2, threadpool, buffer pool) is
+ * USDT-only; the ETW manifest does not define matching events.
+ */
+#define NODE_BUFFER_POOL_REFILL(arg0, arg1)
+#define NODE_BUFFER_POOL_REFILL_ENABLED() (0)
+#endif
+
 #include "env-inl.h"
 #include "node_errors.h"
 
+#include <atomic>
 #include <cstring>
 
 namespace node {
@@ -249,6 +259,54 @@ void DTRACE_HTTP_CLIENT_RESPONSE(const FunctionCallbackInfo<Value>& args) {
   NODE_HTTP_CLIENT_RESPONSE(&conn, conn.remote, conn.port, conn.fd);
 }
 
+void DTRACE_BUFFER_POOL_REFILL(const FunctionCallbackInfo<Value>& args) {
+  if (!NODE_BUFFER_POOL_REFILL_ENABLED())
+    return;
+  Environment* env = Environment::GetCurrent(args);
+  int32_t used = args[0]->Int32Value(env->context()).FromJust();
+  int32_t capacity = args[1]->Int32Value(env->context()).FromJust();
+  NODE_BUFFER_POOL_REFILL(used, capacity);
+}
+
+#ifdef HAVE_DTRACE
+void dtrace_stream_read(void* stream, int32_t nread) {
+  if (NODE_STREAM_READ_ENABLED())
+    NODE_STREAM_READ(stream, nread);
+}
+
+void dtrace_stream_write(void* stream, int32_t length) {
+  if (NODE_STREAM_WRITE_ENABLED())
+    NODE_STREAM_WRITE(stream, length);
+}
+
+void dtrace_http2_stream_open(void* session, int32_t id) {
+  if (NODE_HTTP2_STREAM_OPEN_ENABLED())
+    NODE_HTTP2_STREAM_OPEN(session, id);
+}
+
+void dtrace_http2_stream_close(void* session, int32_t id, int32_t code) {
+  if (NODE_HTTP2_STREAM_CLOSE_ENABLED())
+    NODE_HTTP2_STREAM_CLOSE(session, id, code);
+}
+
+// The depth spans all Environments sharing the process-wide libuv pool and
+// is tracked even while no consumer is attached, so that probes report a
+// correct value for consumers attaching mid-run.
+static std::atomic<int32_t> threadpool_depth{0};
+
+void dtrace_threadpool_enqueue() {
+  int32_t depth = threadpool_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (NODE_THREADPOOL_ENQUEUE_ENABLED())
+    NODE_THREADPOOL_ENQUEUE(depth);
+}
+
+void dtrace_threadpool_dequeue() {
+  int32_t depth = threadpool_depth.fetch_sub(1, std::memory_order_relaxed) - 1;
+  if (NODE_THREADPOOL_DEQUEUE_ENABLED())
+    NODE_THREADPOOL_DEQUEUE(depth);
+}
+#endif  // HAVE_DTRACE
+
 void dtrace_gc_start(Isolate* isolate,
                      GCType type,
                      GCCallbackFlags flags,
@@ -303,6 +361,7 @@ void InitializeDTrace(Local<Object> target,
   NODE_PROBE(DTRACE_HTTP_SERVER_RESPONSE)
   NODE_PROBE(DTRACE_HTTP_CLIENT_REQUEST)
   NODE_PROBE(DTRACE_HTTP_CLIENT_RESPONSE)
+  NODE_PROBE(DTRACE_BUFFER_POOL_REFILL)
 # undef NODE_PROBE
 #endif
 }
@@ -79,6 +79,30 @@ class Environment;
 
 void InitDTrace(Environment* env);
 
+/*
+ * Probe points fired from hot paths in other translation units. With DTrace
+ * support compiled in each call reduces to an is-enabled check; in other
+ * builds (including ETW, whose manifest does not define matching events)
+ * they compile away entirely.
+ */
+#ifdef HAVE_DTRACE
+void dtrace_stream_read(void* stream, int32_t nread);
+void dtrace_stream_write(void* stream, int32_t length);
+void dtrace_http2_stream_open(void* session, int32_t id);
+void dtrace_http2_stream_close(void* session, int32_t id, int32_t code);
+void dtrace_threadpool_enqueue();
+void dtrace_threadpool_dequeue();
+#else
+inline void dtrace_stream_read(void* stream, int32_t nread) {}
+inline void dtrace_stream_write(void* stream, int32_t length) {}
+inline void dtrace_http2_stream_open(void* session, int32_t id) {}
+inline void dtrace_http2_stream_close(void* session,
+                                      int32_t id,
+                                      int32_t code) {}
+inline void dtrace_threadpool_enqueue() {}
+inline void dtrace_threadpool_dequeue() {}
+#endif
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -27,6 +27,13 @@ using v8::PropertyHandlerFlags;
 using v8::String;
 using v8::Value;
 
+// Reads are served from a snapshot of the environment that is built on
+// first use: one atomic shared_ptr load plus a hash probe instead of a
+// mutex-protected getenv(3) walk per property access. Set()/Delete() write
+// through to the real environment and publish an updated snapshot
+// copy-on-write, so concurrent readers on worker threads never block.
+// Mutations made behind the process's back (setenv(3) from an addon or the
+// embedder) are not observed until Resync() drops the snapshot.
 class RealEnvStore final : public KVStore {
  public:
   MaybeLocal<String> Get(Isolate* isolate, Local<String> key) const override;
@@ -34,6 +41,33 @@ class RealEnvStore final : public KVStore {
   int32_t Query(Isolate* isolate, Local<String> key) const override;
   void Delete(Isolate* isolate, Local<String> key) override;
   Local<Array> Enumerate(Isolate* isolate) const override;
+  void Resync() override;
+
+ private:
+  struct Snapshot {
+    // Keyed on the normalized variable name (see NormalizedKey()).
+    std::unordered_map<std::string, std::string> map;
+    // Keys in the order and spelling the real environment reports them,
+    // so that enumeration stays what it always was.
+    std::vector<std::string> keys;
+  };
+
+  // Environment variable names are case-insensitive on Windows, so the
+  // snapshot map is keyed on the upcased name there to preserve getenv(3)
+  // semantics; other platforms use the name as given.
+  static std::string NormalizedKey(const char* name, size_t size) {
+#ifdef _WIN32
+    return ToUpper(std::string(name, size));
+#else
+    return std::string(name, size);
+#endif
+  }
+
+  // Returns the current snapshot, building it from the real environment
+  // under the env_var_mutex if none exists yet.
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  mutable std::shared_ptr<const Snapshot> snapshot_;
 };
 
 class MapKVStore final : public KVStore {
@@ -72,29 +106,56 @@ void DateTimeConfigurationChangeNotification(Isolate* isolate, const T& key) {
   }
 }
 
-MaybeLocal<String> RealEnvStore::Get(Isolate* isolate,
-                                     Local<String> property) const {
+std::shared_ptr<const RealEnvStore::Snapshot> RealEnvStore::snapshot() const {
+  std::shared_ptr<const Snapshot> snap = std::atomic_load(&snapshot_);
+  if (snap)
+    return snap;
+
   Mutex::ScopedLock lock(per_process::env_var_mutex);
+  // Another thread may have built the snapshot while this one waited for
+  // the lock.
+  snap = std::atomic_load(&snapshot_);
+  if (snap)
+    return snap;
 
-  node::Utf8Value key(isolate, property);
-  size_t init_sz = 256;
-  MaybeStackBuffer<char, 256> val;
-  int ret = uv_os_getenv(*key, *val, &init_sz);
-
-  if (ret == UV_ENOBUFS) {
-    // Buffer is not large enough, reallocate to the updated init_sz
-    // and fetch env value again.
-    val.AllocateSufficientStorage(init_sz);
-    ret = uv_os_getenv(*key, *val, &init_sz);
-  }
+  uv_env_item_t* items;
+  int count;
+  auto cleanup = OnScopeLeave([&]() { uv_os_free_environ(items, count); });
+  CHECK_EQ(uv_os_environ(&items, &count), 0);
 
-  if (ret >= 0) {  // Env key value fetch success.
-    MaybeLocal<String> value_string =
-        String::NewFromUtf8(isolate, *val, NewStringType::kNormal, init_sz);
-    return value_string;
+  auto fresh = std::make_shared<Snapshot>();
+  fresh->map.reserve(count);
+  fresh->keys.reserve(count);
+  for (int i = 0; i < count; i++) {
+    std::string name(items[i].name);
+    if (fresh->map.emplace(NormalizedKey(name.data(), name.size()),
+                           items[i].value).second) {
+      fresh->keys.emplace_back(std::move(name));
+    }
   }
 
-  return MaybeLocal<String>();
+  snap = std::move(fresh);
+  std::atomic_store(&snapshot_, snap);
+  return snap;
+}
+
+void RealEnvStore::Resync() {
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>());
+}
+
+MaybeLocal<String> RealEnvStore::Get(Isolate* isolate,
+                                     Local<String> property) const {
+  std::shared_ptr<const Snapshot> snap = snapshot();
+
+  node::Utf8Value key(isolate, property);
+  auto it = snap->map.find(NormalizedKey(*key, key.length()));
+  if (it == snap->map.end())
+    return MaybeLocal<String>();
+
+  return String::NewFromUtf8(isolate,
+                             it->second.data(),
+                             NewStringType::kNormal,
+                             it->second.size());
 }
 
 void RealEnvStore::Set(Isolate* isolate,
@@ -109,21 +170,30 @@ void RealEnvStore::Set(Isolate* isolate,
   if (key[0] == L'=') return;
 #endif
   uv_os_setenv(*key, *val);
+
+  // Publish an updated snapshot copy-on-write; readers holding the old one
+  // are unaffected.
+  std::shared_ptr<const Snapshot> snap = std::atomic_load(&snapshot_);
+  if (snap) {
+    auto fresh = std::make_shared<Snapshot>(*snap);
+    std::string normalized = NormalizedKey(*key, key.length());
+    if (fresh->map.emplace(normalized, std::string(*val, val.length())).second)
+      fresh->keys.emplace_back(*key, key.length());
+    else
+      fresh->map[normalized] = std::string(*val, val.length());
+    std::atomic_store(&snapshot_,
+                      std::shared_ptr<const Snapshot>(std::move(fresh)));
+  }
+
   DateTimeConfigurationChangeNotification(isolate, key);
 }
 
 int32_t RealEnvStore::Query(Isolate* isolate, Local<String> property) const {
-  Mutex::ScopedLock lock(per_process::env_var_mutex);
+  std::shared_ptr<const Snapshot> snap = snapshot();
 
   node::Utf8Value key(isolate, property);
-
-  char val[2];
-  size_t init_sz = sizeof(val);
-  int ret = uv_os_getenv(*key, val, &init_sz);
-
-  if (ret == UV_ENOENT) {
+  if (snap->map.count(NormalizedKey(*key, key.length())) == 0)
     return -1;
-  }
 
 #ifdef _WIN32
   if (key[0] == L'=') {
@@ -141,28 +211,41 @@ void RealEnvStore::Delete(Isolate* isolate, Local<String> property) {
 
   node::Utf8Value key(isolate, property);
   uv_os_unsetenv(*key);
+
+  std::shared_ptr<const Snapshot> snap = std::atomic_load(&snapshot_);
+  if (snap) {
+    auto fresh = std::make_shared<Snapshot>(*snap);
+    std::string normalized = NormalizedKey(*key, key.length());
+    if (fresh->map.erase(normalized) > 0) {
+      // The keys vector stores the environment's spelling, which may
+      // differ in case from the deleted property name on Windows.
+      fresh->keys.erase(std::find_if(
+          fresh->keys.begin(), fresh->keys.end(),
+          [&](const std::string& name) {
+            return NormalizedKey(name.data(), name.size()) == normalized;
+          }));
+    }
+    std::atomic_store(&snapshot_,
+                      std::shared_ptr<const Snapshot>(std::move(fresh)));
+  }
+
   DateTimeConfigurationChangeNotification(isolate, key);
 }
 
 Local<Array> RealEnvStore::Enumerate(Isolate* isolate) const {
-  Mutex::ScopedLock lock(per_process::env_var_mutex);
-  uv_env_item_t* items;
-  int count;
+  std::shared_ptr<const Snapshot> snap = snapshot();
 
-  auto cleanup = OnScopeLeave([&]() { uv_os_free_environ(items, count); });
-  CHECK_EQ(uv_os_environ(&items, &count), 0);
-
-  MaybeStackBuffer<Local<Value>, 256> env_v(count);
+  MaybeStackBuffer<Local<Value>, 256> env_v(snap->keys.size());
   int env_v_index = 0;
-  for (int i = 0; i < count; i++) {
+  for (const std::string& name : snap->keys) {
 #ifdef _WIN32
     // If the key starts with '=' it is a hidden environment variable.
     // The '\0' check is a workaround for the bug behind
     // https://github.com/libuv/libuv/pull/2473 and can be removed later.
-    if (items[i].name[0] == '=' || items[i].name[0] == '\0') continue;
+    if (name[0] == '=' || name[0] == '\0') continue;
 #endif
     MaybeLocal<String> str = String::NewFromUtf8(
-        isolate, items[i].name, NewStringType::kNormal);
+        isolate, name.data(), NewStringType::kNormal, name.size());
     if (str.IsEmpty()) {
       isolate->ThrowException(ERR_STRING_TOO_LONG(isolate));
       return Local<Array>();
@@ -23,6 +23,7 @@
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_io_uring.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -45,21 +46,42 @@
 # include <io.h>
 #endif
 
+#ifndef _WIN32
+# include <sys/mman.h>
+#endif
+
+#ifdef __linux__
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# ifndef FICLONE
+#  define FICLONE _IOW(0x94, 9, int)
+# endif
+#endif
+
+#include <atomic>
+#include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace node {
 
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -178,7 +200,11 @@ int FileHandle::DoWrite(WriteWrap* w,
 }
 
 void FileHandle::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackField("current_read", current_read_);
+  tracker->TrackField("pending_reads", pending_reads_);
+  tracker->TrackField("abandoned_reads", abandoned_reads_);
+  tracker->TrackFieldWithSize(
+      "combine_arenas", combine_active_.size() + combine_flushing_.size());
+  tracker->TrackField("combine_barriers", combine_barriers_);
 }
 
 // Close the file descriptor if it hasn't already been closed. A process
@@ -187,6 +213,17 @@ void FileHandle::MemoryInfo(MemoryTracker* tracker) const {
 // will crash the process immediately.
 inline void FileHandle::Close() {
   if (closed_) return;
+  if (!combine_active_.empty()) {
+    // Last-ditch synchronous flush of combined appends that were never
+    // barriered; losing them on gc would be silent data loss.
+    uv_buf_t buf = uv_buf_init(
+        combine_active_.data(),
+        static_cast<unsigned int>(combine_active_.size()));
+    uv_fs_t write_req;
+    uv_fs_write(env()->event_loop(), &write_req, fd_, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&write_req);
+    combine_active_.clear();
+  }
   uv_fs_t req;
   int ret = uv_fs_close(env()->event_loop(), &req, fd_, nullptr);
   uv_fs_req_cleanup(&req);
@@ -286,6 +323,17 @@ MaybeLocal<Promise> FileHandle::ClosePromise() {
   Local<Promise> promise = resolver.As<Promise>();
   CHECK(!reading_);
   if (!closed_ && !closing_) {
+    if (!combine_inflight_ && !combine_active_.empty()) {
+      // The JS layer barriers before closing; this catches direct closes
+      // of a handle with combined appends still queued.
+      uv_buf_t buf = uv_buf_init(
+          combine_active_.data(),
+          static_cast<unsigned int>(combine_active_.size()));
+      uv_fs_t write_req;
+      uv_fs_write(env()->event_loop(), &write_req, fd_, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&write_req);
+      combine_active_.clear();
+    }
     closing_ = true;
     Local<Object> close_req_obj;
     if (!env()
@@ -352,115 +400,361 @@ FileHandleReadWrap::FileHandleReadWrap(FileHandle* handle, Local<Object> obj)
   : ReqWrap(handle->env(), obj, AsyncWrap::PROVIDER_FSREQCALLBACK),
     file_handle_(handle) {}
 
+// Push the read wrap back to the freelist, or let it be destroyed
+// once we’re exiting the current scope.
+static void RecycleReadWrap(Environment* env,
+                            std::unique_ptr<FileHandleReadWrap> read_wrap) {
+  constexpr size_t wanted_freelist_fill = 100;
+  auto& freelist = env->file_handle_read_wrap_freelist();
+  if (freelist.size() < wanted_freelist_fill) {
+    read_wrap->Reset();
+    freelist.emplace_back(std::move(read_wrap));
+  }
+}
+
 int FileHandle::ReadStart() {
   if (!IsAlive() || IsClosing())
     return UV_EOF;
 
   reading_ = true;
 
-  if (current_read_)
-    return 0;
-
-  std::unique_ptr<FileHandleReadWrap> read_wrap;
-
-  if (read_length_ == 0) {
+  if (read_length_ == 0 && pending_reads_.empty()) {
     EmitRead(UV_EOF);
     return 0;
   }
 
-  {
-    // Create a new FileHandleReadWrap or re-use one.
-    // Either way, we need these two scopes for AsyncReset() or otherwise
-    // for creating the new instance.
-    HandleScope handle_scope(env()->isolate());
-    AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(this);
+  FillReadPipeline();
+  return 0;
+}
 
-    auto& freelist = env()->file_handle_read_wrap_freelist();
-    if (freelist.size() > 0) {
-      read_wrap = std::move(freelist.back());
-      freelist.pop_back();
-      read_wrap->AsyncReset();
-      read_wrap->file_handle_ = this;
-    } else {
-      Local<Object> wrap_obj;
-      if (!env()
-               ->filehandlereadwrap_template()
-               ->NewInstance(env()->context())
-               .ToLocal(&wrap_obj)) {
-        return UV_EBUSY;
-      }
-      read_wrap = std::make_unique<FileHandleReadWrap>(this, wrap_obj);
+void FileHandle::FillReadPipeline() {
+  // Position-relative reads depend on the kernel-side file position, so
+  // only a single one of them may be outstanding at any time. With an
+  // explicit offset, subsequent reads target known positions and up to
+  // read_pipeline_depth_ of them can run concurrently.
+  const size_t depth = read_offset_ < 0 ? 1 : read_pipeline_depth_;
+
+  while (reading_ && pending_reads_.size() < depth) {
+    int64_t recommended_read = 65536;
+    if (read_length_ >= 0) {
+      const int64_t remaining = read_length_ - issued_ahead_;
+      if (remaining <= 0)
+        break;  // The requested range is covered by already-issued reads.
+      if (remaining < recommended_read)
+        recommended_read = remaining;
     }
-  }
-  int64_t recommended_read = 65536;
-  if (read_length_ >= 0 && read_length_ <= recommended_read)
-    recommended_read = read_length_;
-
-  read_wrap->buffer_ = EmitAlloc(recommended_read);
 
-  current_read_ = std::move(read_wrap);
+    std::unique_ptr<FileHandleReadWrap> read_wrap;
 
-  current_read_->Dispatch(uv_fs_read,
-                          fd_,
-                          &current_read_->buffer_,
-                          1,
-                          read_offset_,
-                          uv_fs_callback_t{[](uv_fs_t* req) {
-    FileHandle* handle;
     {
+      // Create a new FileHandleReadWrap or re-use one.
+      // Either way, we need these two scopes for AsyncReset() or otherwise
+      // for creating the new instance.
+      HandleScope handle_scope(env()->isolate());
+      AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(this);
+
+      auto& freelist = env()->file_handle_read_wrap_freelist();
+      if (freelist.size() > 0) {
+        read_wrap = std::move(freelist.back());
+        freelist.pop_back();
+        read_wrap->AsyncReset();
+        read_wrap->file_handle_ = this;
+      } else {
+        Local<Object> wrap_obj;
+        if (!env()
+                 ->filehandlereadwrap_template()
+                 ->NewInstance(env()->context())
+                 .ToLocal(&wrap_obj)) {
+          return;
+        }
+        read_wrap = std::make_unique<FileHandleReadWrap>(this, wrap_obj);
+      }
+    }
+
+    read_wrap->buffer_ = EmitAlloc(recommended_read);
+    read_wrap->done_ = false;
+    read_wrap->discarded_ = false;
+    read_wrap->result_ = 0;
+
+    const int64_t offset =
+        read_offset_ < 0 ? -1 : read_offset_ + issued_ahead_;
+    issued_ahead_ += recommended_read;
+
+    pending_reads_.emplace_back(std::move(read_wrap));
+    FileHandleReadWrap* wrap = pending_reads_.back().get();
+
+    // On Linux 5.x kernels, submit the read through io_uring instead of
+    // paying for a threadpool round trip. Completions arrive on the event
+    // loop and funnel into the same OnReadComplete() path.
+    if (IoUring* ring = IoUring::Get(env())) {
+      if (ring->SubmitRead(fd_, wrap->buffer_.base, wrap->buffer_.len, offset,
+                           [this, wrap](int result) {
+                             HandleScope handle_scope(env()->isolate());
+                             Context::Scope context_scope(env()->context());
+                             OnReadComplete(wrap, result);
+                           })) {
+        continue;
+      }
+    }
+
+    wrap->Dispatch(uv_fs_read,
+                   fd_,
+                   &wrap->buffer_,
+                   1,
+                   offset,
+                   uv_fs_callback_t{[](uv_fs_t* req) {
       FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
-      handle = req_wrap->file_handle_;
-      CHECK_EQ(handle->current_read_.get(), req_wrap);
+      FileHandle* handle = req_wrap->file_handle_;
+      int result = req->result;
+      uv_fs_req_cleanup(req);
+      handle->OnReadComplete(req_wrap, result);
+    }});
+  }
+}
+
+void FileHandle::OnReadComplete(FileHandleReadWrap* wrap, int result) {
+  wrap->done_ = true;
+  wrap->result_ = result;
+
+  if (wrap->discarded_) {
+    // A stale read the pipeline already gave up on. Now that the kernel is
+    // done writing into the buffer it can be released, and the wrap
+    // recycled.
+    for (auto it = abandoned_reads_.begin();
+         it != abandoned_reads_.end();
+         ++it) {
+      if (it->get() != wrap) continue;
+      std::unique_ptr<FileHandleReadWrap> read_wrap = std::move(*it);
+      abandoned_reads_.erase(it);
+      AllocatedBuffer discarded(env(), read_wrap->buffer_);
+      RecycleReadWrap(env(), std::move(read_wrap));
+      break;
     }
+    return;
+  }
+
+  DrainCompletedReads();
+}
 
-    // ReadStart() checks whether current_read_ is set to determine whether
-    // a read is in progress. Moving it into a local variable makes sure that
-    // the ReadStart() call below doesn't think we're still actively reading.
+void FileHandle::DrainCompletedReads() {
+  while (!pending_reads_.empty() && pending_reads_.front()->done_) {
     std::unique_ptr<FileHandleReadWrap> read_wrap =
-        std::move(handle->current_read_);
+        std::move(pending_reads_.front());
+    pending_reads_.pop_front();
 
-    int result = req->result;
+    int result = read_wrap->result_;
     uv_buf_t buffer = read_wrap->buffer_;
+    const int64_t planned_read = buffer.len;
+    issued_ahead_ -= planned_read;
 
-    uv_fs_req_cleanup(req);
-
-    // Push the read wrap back to the freelist, or let it be destroyed
-    // once we’re exiting the current scope.
-    constexpr size_t wanted_freelist_fill = 100;
-    auto& freelist = handle->env()->file_handle_read_wrap_freelist();
-    if (freelist.size() < wanted_freelist_fill) {
-      read_wrap->Reset();
-      freelist.emplace_back(std::move(read_wrap));
-    }
+    RecycleReadWrap(env(), std::move(read_wrap));
 
     if (result >= 0) {
       // Read at most as many bytes as we originally planned to.
-      if (handle->read_length_ >= 0 && handle->read_length_ < result)
-        result = handle->read_length_;
+      if (read_length_ >= 0 && read_length_ < result)
+        result = read_length_;
 
       // If we read data and we have an expected length, decrease it by
       // how much we have read.
-      if (handle->read_length_ >= 0)
-        handle->read_length_ -= result;
+      if (read_length_ >= 0)
+        read_length_ -= result;
 
       // If we have an offset, increase it by how much we have read.
-      if (handle->read_offset_ >= 0)
-        handle->read_offset_ += result;
+      if (read_offset_ >= 0)
+        read_offset_ += result;
+
+      // A short read leaves any following pipelined reads at stale file
+      // offsets; drop those and reissue from the new position.
+      if (result > 0 && result < planned_read)
+        DiscardPipelinedReads();
+    } else {
+      DiscardPipelinedReads();
     }
 
     // Reading 0 bytes from a file always means EOF, or that we reached
     // the end of the requested range.
-    if (result == 0)
+    if (result == 0) {
       result = UV_EOF;
+      DiscardPipelinedReads();
+    }
 
-    handle->EmitRead(result, buffer);
+    EmitRead(result, buffer);
 
-    // Start over, if EmitRead() didn’t tell us to stop.
-    if (handle->reading_)
-      handle->ReadStart();
-  }});
+    if (!reading_)
+      return;
+  }
 
-  return 0;
+  // Keep the pipeline full, if EmitRead() didn’t tell us to stop.
+  if (reading_)
+    FillReadPipeline();
+}
+
+void FileHandle::DiscardPipelinedReads() {
+  while (!pending_reads_.empty()) {
+    std::unique_ptr<FileHandleReadWrap> read_wrap =
+        std::move(pending_reads_.front());
+    pending_reads_.pop_front();
+    if (read_wrap->done_) {
+      AllocatedBuffer discarded(env(), read_wrap->buffer_);
+      RecycleReadWrap(env(), std::move(read_wrap));
+    } else {
+      // The kernel may still be writing into the buffer; park the wrap
+      // until its completion arrives.
+      read_wrap->discarded_ = true;
+      abandoned_reads_.emplace_back(std::move(read_wrap));
+    }
+  }
+  issued_ahead_ = 0;
+}
+
+void FileHandle::SetReadPipelineDepth(const FunctionCallbackInfo<Value>& args) {
+  FileHandle* fd;
+  ASSIGN_OR_RETURN_UNWRAP(&fd, args.Holder());
+  CHECK(args[0]->IsUint32());
+  constexpr uint32_t kMaxReadPipelineDepth = 32;
+  uint32_t depth = args[0].As<Uint32>()->Value();
+  if (depth < 1) depth = 1;
+  if (depth > kMaxReadPipelineDepth) depth = kMaxReadPipelineDepth;
+  fd->read_pipeline_depth_ = depth;
+}
+
+void FileHandle::WriteCombined(const FunctionCallbackInfo<Value>& args) {
+  FileHandle* fd;
+  ASSIGN_OR_RETURN_UNWRAP(&fd, args.Holder());
+  CHECK(Buffer::HasInstance(args[0]));
+
+  if (fd->combine_error_ != 0) {
+    int err = fd->combine_error_;
+    fd->combine_error_ = 0;
+    args.GetReturnValue().Set(static_cast<double>(err));
+    return;
+  }
+  if (fd->closing_ || fd->closed_) {
+    args.GetReturnValue().Set(static_cast<double>(UV_EBADF));
+    return;
+  }
+
+  const char* data = Buffer::Data(args[0]);
+  const size_t length = Buffer::Length(args[0]);
+  fd->combine_active_.insert(fd->combine_active_.end(), data, data + length);
+
+  if (fd->combine_active_.size() >= kCombineFlushThreshold &&
+      !fd->combine_inflight_) {
+    fd->StartCombineFlush();
+  } else {
+    fd->ScheduleCombineFlush();
+  }
+
+  args.GetReturnValue().Set(static_cast<double>(length));
+}
+
+void FileHandle::FlushCombinedWrites(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  FileHandle* fd;
+  ASSIGN_OR_RETURN_UNWRAP(&fd, args.Holder());
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[0]);
+  CHECK_NOT_NULL(req_wrap_async);  // flushCombinedWrites(req)
+  req_wrap_async->Init("write", nullptr, 0, UTF8);
+  req_wrap_async->SetReturnValue(args);
+
+  fd->combine_barriers_.emplace_back(req_wrap_async);
+  // No FSReqAfterScope runs for barriers; the barrier list's reference
+  // owns the wrap and deletes it once it has been settled.
+  req_wrap_async->Detach();
+
+  if (!fd->combine_inflight_) {
+    if (!fd->combine_active_.empty() && fd->combine_error_ == 0)
+      fd->StartCombineFlush();
+    else
+      fd->SettleCombineBarriers();
+  }
+}
+
+void FileHandle::ScheduleCombineFlush() {
+  if (combine_flush_scheduled_ || combine_inflight_) return;
+  combine_flush_scheduled_ = true;
+  // The immediate is ref'ed, so queued appends keep the loop alive until
+  // they have been handed to the kernel.
+  env()->SetImmediate([this, self = BaseObjectPtr<FileHandle>{this}](
+                          Environment* env) {
+    combine_flush_scheduled_ = false;
+    if (!combine_inflight_ && !combine_active_.empty() &&
+        !closing_ && !closed_) {
+      StartCombineFlush();
+    }
+  });
+}
+
+void FileHandle::StartCombineFlush() {
+  CHECK(!combine_inflight_);
+  CHECK(!combine_active_.empty());
+  CHECK(combine_flushing_.empty());
+  combine_flushing_.swap(combine_active_);
+  combine_inflight_ = true;
+  combine_self_ref_ = BaseObjectPtr<FileHandle>{this};
+  combine_req_.data = this;
+
+  uv_buf_t buf = uv_buf_init(
+      combine_flushing_.data(),
+      static_cast<unsigned int>(combine_flushing_.size()));
+  // Offset -1 writes at the current file position; with O_APPEND the
+  // kernel makes the whole combined buffer a single atomic append.
+  int err = uv_fs_write(env()->event_loop(), &combine_req_, fd_,
+                        &buf, 1, -1, AfterCombineFlush);
+  if (err < 0) {
+    combine_inflight_ = false;
+    combine_self_ref_.reset();
+    combine_flushing_.clear();
+    combine_error_ = err;
+    SettleCombineBarriers();
+  }
+}
+
+void FileHandle::AfterCombineFlush(uv_fs_t* req) {
+  FileHandle* handle = static_cast<FileHandle*>(req->data);
+  const ssize_t result = req->result;
+  uv_fs_req_cleanup(req);
+
+  BaseObjectPtr<FileHandle> self = std::move(handle->combine_self_ref_);
+  handle->combine_inflight_ = false;
+
+  if (result < 0) {
+    if (handle->combine_error_ == 0)
+      handle->combine_error_ = static_cast<int>(result);
+  } else if (static_cast<size_t>(result) < handle->combine_flushing_.size()) {
+    // Short write: carry the tail over so it leads the next flush.
+    handle->combine_active_.insert(
+        handle->combine_active_.begin(),
+        handle->combine_flushing_.begin() + result,
+        handle->combine_flushing_.end());
+  }
+  handle->combine_flushing_.clear();
+
+  if (handle->combine_error_ == 0 && !handle->combine_active_.empty() &&
+      !handle->closing_ && !handle->closed_) {
+    handle->StartCombineFlush();
+    return;
+  }
+  handle->SettleCombineBarriers();
+}
+
+void FileHandle::SettleCombineBarriers() {
+  if (combine_barriers_.empty()) return;
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+
+  std::vector<BaseObjectPtr<FSReqBase>> barriers;
+  barriers.swap(combine_barriers_);
+  int err = combine_error_;
+  combine_error_ = 0;
+  for (auto& barrier : barriers) {
+    if (err != 0)
+      barrier->Reject(UVException(isolate, err, "write"));
+    else
+      barrier->Resolve(Undefined(isolate));
+  }
 }
 
 int FileHandle::ReadStop() {
@@ -844,6 +1138,124 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Process-wide cache for InternalModuleStat() results, shared by every
+// thread and Worker in the process so that resolver state survives Worker
+// teardown. Entries are grouped by containing directory and validated by
+// the directory's mtime: creating, removing or renaming a directory entry
+// updates the mtime, and those are the only operations that can change the
+// file-vs-directory-vs-missing answer this cache stores, so one stat() of
+// the directory validates every probe into it - including the negative
+// probes that dominate node_modules resolution. Sharded by directory hash
+// so concurrently resolving threads do not contend on a single lock.
+// Caveat: for a symlink the cached answer describes its target, and a
+// target change does not touch the link's directory; the entry stays
+// stale until the directory itself changes, like any other stat cache
+// that follows links.
+class ModuleStatCache {
+ public:
+  // Same contract as InternalModuleStat(): 0 for a file, 1 for a
+  // directory, < 0 on error.
+  static int Stat(uv_loop_t* loop, const std::string& path) {
+    size_t sep = path.find_last_of("/\\");
+    if (sep == std::string::npos || sep == 0 || sep == path.size() - 1)
+      return PlainStat(loop, path.c_str());
+    const std::string dir = path.substr(0, sep);
+    const std::string base = path.substr(sep + 1);
+
+    uv_fs_t dir_req;
+    const int dir_rc = uv_fs_stat(nullptr, &dir_req, dir.c_str(), nullptr);
+    if (dir_rc < 0) {
+      // The containing directory cannot be resolved, so neither can the
+      // path; the error (ENOENT, ENOTDIR, EACCES, ...) applies to both.
+      uv_fs_req_cleanup(&dir_req);
+      return dir_rc;
+    }
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(dir_req.ptr);
+    if (!(s->st_mode & S_IFDIR)) {
+      uv_fs_req_cleanup(&dir_req);
+      return UV_ENOTDIR;
+    }
+    const uv_timespec_t mtime = s->st_mtim;
+    uv_fs_req_cleanup(&dir_req);
+
+    // On filesystems with coarse mtime granularity a directory modified
+    // "just now" could change again within the same timestamp, making the
+    // mtime check unreliable; bypass the cache until the dust settles.
+    uv_timeval64_t now;
+    if (uv_gettimeofday(&now) != 0 ||
+        now.tv_sec < mtime.tv_sec + kMtimeSafetyWindowSec) {
+      return PlainStat(loop, path.c_str());
+    }
+
+    Shard* shard = ShardFor(dir);
+    {
+      Mutex::ScopedLock lock(shard->mutex);
+      auto dir_it = shard->dirs.find(dir);
+      if (dir_it != shard->dirs.end() &&
+          dir_it->second.mtime.tv_sec == mtime.tv_sec &&
+          dir_it->second.mtime.tv_nsec == mtime.tv_nsec) {
+        auto entry_it = dir_it->second.entries.find(base);
+        if (entry_it != dir_it->second.entries.end())
+          return entry_it->second;
+      }
+    }
+
+    // Miss: stat the path itself without holding the shard lock, then
+    // insert the result under the directory mtime observed above. If the
+    // directory changed in between, the entry is simply dropped on the
+    // next validation.
+    const int rc = PlainStat(loop, path.c_str());
+    Mutex::ScopedLock lock(shard->mutex);
+    auto dir_it = shard->dirs.find(dir);
+    if (dir_it == shard->dirs.end()) {
+      if (shard->dirs.size() >= kMaxDirsPerShard)
+        return rc;
+      dir_it = shard->dirs.emplace(dir, DirEntry()).first;
+      dir_it->second.mtime = mtime;
+    } else if (dir_it->second.mtime.tv_sec != mtime.tv_sec ||
+               dir_it->second.mtime.tv_nsec != mtime.tv_nsec) {
+      dir_it->second.entries.clear();
+      dir_it->second.mtime = mtime;
+    }
+    dir_it->second.entries[base] = rc;
+    return rc;
+  }
+
+ private:
+  static constexpr size_t kShardCount = 8;
+  static constexpr size_t kMaxDirsPerShard = 1024;
+  static constexpr int64_t kMtimeSafetyWindowSec = 2;
+
+  struct DirEntry {
+    uv_timespec_t mtime;
+    std::unordered_map<std::string, int> entries;  // basename -> rc
+  };
+
+  struct Shard {
+    Mutex mutex;
+    std::unordered_map<std::string, DirEntry> dirs;
+  };
+
+  static Shard* ShardFor(const std::string& dir) {
+    return &shards_[std::hash<std::string>()(dir) % kShardCount];
+  }
+
+  static int PlainStat(uv_loop_t* loop, const char* path) {
+    uv_fs_t req;
+    int rc = uv_fs_stat(loop, &req, path, nullptr);
+    if (rc == 0) {
+      const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+      rc = !!(s->st_mode & S_IFDIR);
+    }
+    uv_fs_req_cleanup(&req);
+    return rc;
+  }
+
+  static Shard shards_[kShardCount];
+};
+
+ModuleStatCache::Shard ModuleStatCache::shards_[kShardCount];
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
@@ -853,17 +1265,351 @@ static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsString());
   node::Utf8Value path(env->isolate(), args[0]);
 
-  uv_fs_t req;
-  int rc = uv_fs_stat(env->event_loop(), &req, *path, nullptr);
-  if (rc == 0) {
-    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
-    rc = !!(s->st_mode & S_IFDIR);
-  }
-  uv_fs_req_cleanup(&req);
+  const int rc = ModuleStatCache::Stat(
+      env->event_loop(), std::string(*path, path.length()));
 
   args.GetReturnValue().Set(rc);
 }
 
+class StatCache;
+
+struct StatCacheWatcher {
+  uv_fs_event_t handle;
+  std::string dir;
+  StatCache* cache;
+};
+
+// Caches stat()/lstat() results for paths under explicitly opted-in
+// prefixes. Every directory containing a cached path gets an unref'ed
+// uv_fs_event watcher that drops the affected entries as soon as anything
+// in it changes, so hits can be answered from the loop thread without a
+// threadpool dispatch. Negative results (e.g. ENOENT probes) are cached
+// too, since config lookups tend to repeat them the most.
+class StatCache {
+ public:
+  // Total entries across all prefixes; full caches simply stop admitting
+  // new paths until something is invalidated.
+  static constexpr size_t kMaxEntries = 4096;
+
+  static StatCache* Get(Environment* env) {
+    StatCache* cache = per_thread_stat_cache;
+    if (cache == nullptr || cache->env_ != env || cache->prefixes_.empty())
+      return nullptr;
+    return cache;
+  }
+
+  static StatCache* GetOrCreate(Environment* env) {
+    StatCache* cache = per_thread_stat_cache;
+    if (cache != nullptr)
+      return cache->env_ == env ? cache : nullptr;
+    cache = new StatCache(env);
+    per_thread_stat_cache = cache;
+    env->AddCleanupHook(CleanupHook, cache);
+    return cache;
+  }
+
+  void SetPrefixes(std::vector<std::string> prefixes) {
+    entries_.clear();
+    CloseWatchers();
+    prefixes_ = std::move(prefixes);
+  }
+
+  bool Covers(const char* path) const {
+    for (const std::string& prefix : prefixes_) {
+      if (strncmp(path, prefix.c_str(), prefix.size()) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool Lookup(const char* path, bool use_lstat, uv_stat_t* out, int* err) {
+    auto it = entries_.find(MakeKey(use_lstat, path));
+    if (it == entries_.end())
+      return false;
+    *err = it->second.err;
+    if (*err == 0)
+      *out = it->second.stat;
+    return true;
+  }
+
+  // `s` may be null when `err` is negative.
+  void Insert(const char* path, bool use_lstat, const uv_stat_t* s, int err) {
+    if (closing_ || entries_.size() >= kMaxEntries)
+      return;
+    // Entries without a working watcher could go stale forever; better to
+    // keep paying the threadpool for them.
+    if (!EnsureWatcher(DirnameOf(path)))
+      return;
+    Entry& entry = entries_[MakeKey(use_lstat, path)];
+    if (err == 0)
+      entry.stat = *s;
+    entry.err = err;
+  }
+
+ private:
+  explicit StatCache(Environment* env) : env_(env) {}
+
+  struct Entry {
+    uv_stat_t stat;
+    int err;
+  };
+
+  static std::string MakeKey(bool use_lstat, const char* path) {
+    std::string key(use_lstat ? "l" : "s");
+    key += path;
+    return key;
+  }
+
+  static std::string DirnameOf(const char* path) {
+    std::string p(path);
+    size_t pos = p.find_last_of("/\\");
+    if (pos == std::string::npos)
+      return std::string(".");
+    return p.substr(0, pos == 0 ? 1 : pos);
+  }
+
+  bool EnsureWatcher(const std::string& dir) {
+    auto it = watchers_.find(dir);
+    if (it != watchers_.end())
+      return true;
+    std::unique_ptr<StatCacheWatcher> w(new StatCacheWatcher());
+    w->dir = dir;
+    w->cache = this;
+    w->handle.data = w.get();
+    if (uv_fs_event_init(env_->event_loop(), &w->handle) != 0)
+      return false;
+    open_handles_++;
+    if (uv_fs_event_start(&w->handle, OnEvent, dir.c_str(), 0) != 0) {
+      uv_close(reinterpret_cast<uv_handle_t*>(&w->handle), OnWatcherClose);
+      w.release();  // Freed by OnWatcherClose.
+      return false;
+    }
+    // The cache must never keep an otherwise idle loop alive.
+    uv_unref(reinterpret_cast<uv_handle_t*>(&w->handle));
+    watchers_[dir] = w.release();
+    return true;
+  }
+
+  void Invalidate(const std::string& dir, const char* filename) {
+    if (filename != nullptr) {
+      std::string full = dir;
+      full += kPathSeparator;
+      full += filename;
+      entries_.erase(MakeKey(false, full.c_str()));
+      entries_.erase(MakeKey(true, full.c_str()));
+      // The directory's own stats (mtime, nlink) changed as well.
+      entries_.erase(MakeKey(false, dir.c_str()));
+      entries_.erase(MakeKey(true, dir.c_str()));
+      return;
+    }
+    // No filename (e.g. an overflowed or coalesced notification): drop
+    // everything under the directory.
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->first.compare(1, dir.size(), dir) == 0)
+        it = entries_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  static void OnEvent(uv_fs_event_t* handle,
+                      const char* filename,
+                      int events,
+                      int status) {
+    StatCacheWatcher* w = static_cast<StatCacheWatcher*>(handle->data);
+    w->cache->Invalidate(w->dir, status < 0 ? nullptr : filename);
+  }
+
+  static void OnWatcherClose(uv_handle_t* handle) {
+    StatCacheWatcher* w = static_cast<StatCacheWatcher*>(handle->data);
+    StatCache* cache = w->cache;
+    delete w;
+    if (--cache->open_handles_ == 0 && cache->closing_)
+      delete cache;
+  }
+
+  void CloseWatchers() {
+    for (auto& entry : watchers_)
+      uv_close(reinterpret_cast<uv_handle_t*>(&entry.second->handle),
+               OnWatcherClose);
+    watchers_.clear();
+  }
+
+  static void CleanupHook(void* data) {
+    StatCache* cache = static_cast<StatCache*>(data);
+    if (per_thread_stat_cache == cache)
+      per_thread_stat_cache = nullptr;
+    cache->closing_ = true;
+    cache->entries_.clear();
+    cache->prefixes_.clear();
+    if (cache->open_handles_ == 0) {
+      delete cache;
+      return;
+    }
+    cache->CloseWatchers();
+  }
+
+  static thread_local StatCache* per_thread_stat_cache;
+
+  Environment* env_;
+  std::vector<std::string> prefixes_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_map<std::string, StatCacheWatcher*> watchers_;
+  int open_handles_ = 0;
+  bool closing_ = false;
+};
+
+thread_local StatCache* StatCache::per_thread_stat_cache = nullptr;
+
+static void MaybeCacheStat(Environment* env,
+                           const char* path,
+                           bool use_lstat,
+                           const uv_stat_t* s,
+                           int err) {
+  StatCache* cache = StatCache::Get(env);
+  if (cache != nullptr && cache->Covers(path))
+    cache->Insert(path, use_lstat, s, err);
+}
+
+// A threadpool stat whose result also populates the StatCache; used for
+// cache misses on covered paths, where the generic AfterStat callback has
+// no way to get at the path anymore.
+struct StatCacheJob {
+  uv_work_t work_req;
+  Environment* env;
+  BaseObjectPtr<FSReqBase> wrap;
+  bool use_lstat;
+  std::string path;
+  uv_stat_t stat;
+  int err;
+};
+
+static void DoStatCacheMiss(uv_work_t* req) {
+  StatCacheJob* job = ContainerOf(&StatCacheJob::work_req, req);
+  uv_fs_t fs_req;
+  job->err = job->use_lstat ?
+      uv_fs_lstat(nullptr, &fs_req, job->path.c_str(), nullptr) :
+      uv_fs_stat(nullptr, &fs_req, job->path.c_str(), nullptr);
+  if (job->err == 0)
+    job->stat = *static_cast<const uv_stat_t*>(fs_req.ptr);
+  uv_fs_req_cleanup(&fs_req);
+}
+
+static void AfterStatCacheMiss(uv_work_t* req, int status) {
+  std::unique_ptr<StatCacheJob> job(ContainerOf(&StatCacheJob::work_req, req));
+  if (status == UV_ECANCELED)
+    return;
+
+  Environment* env = job->env;
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  MaybeCacheStat(env, job->path.c_str(), job->use_lstat,
+                 job->err == 0 ? &job->stat : nullptr, job->err);
+
+  const char* syscall = job->use_lstat ? "lstat" : "stat";
+  if (job->err < 0) {
+    job->wrap->Reject(UVException(isolate, job->err, syscall, nullptr,
+                                  job->path.c_str(), nullptr));
+  } else {
+    job->wrap->ResolveStat(&job->stat);
+  }
+}
+
+// Tries to serve a stat()/lstat() binding call from the StatCache.
+// Returns true when the request has been fully handled. Async hits are
+// settled from an immediate so the callback stays asynchronous; async
+// misses on covered paths go through StatCacheJob so the result can be
+// cached. Sync misses return false and are cached by the caller.
+static bool TryStatCache(Environment* env,
+                         const FunctionCallbackInfo<Value>& args,
+                         const BufferValue& path,
+                         bool use_bigint,
+                         bool use_lstat,
+                         FSReqBase* req_wrap_async) {
+  StatCache* cache = StatCache::Get(env);
+  if (cache == nullptr || !cache->Covers(*path))
+    return false;
+
+  const char* syscall = use_lstat ? "lstat" : "stat";
+  uv_stat_t cached{};
+  int err = 0;
+  const bool hit = cache->Lookup(*path, use_lstat, &cached, &err);
+
+  if (req_wrap_async == nullptr) {
+    if (!hit)
+      return false;
+    if (err < 0) {
+      // Mirror what SyncCall() leaves in the ctx object on failure.
+      Local<Context> context = env->context();
+      Local<Object> ctx = args[3].As<Object>();
+      ctx->Set(context, env->errno_string(),
+               Integer::New(env->isolate(), err)).Check();
+      ctx->Set(context, env->syscall_string(),
+               OneByteString(env->isolate(), syscall)).Check();
+      return true;
+    }
+    args.GetReturnValue().Set(FillGlobalStatsArray(env, use_bigint, &cached));
+    return true;
+  }
+
+  req_wrap_async->Init(syscall, nullptr, 0, UTF8);
+  req_wrap_async->SetReturnValue(args);
+  BaseObjectPtr<FSReqBase> wrap{req_wrap_async};
+  // No FSReqAfterScope runs for these paths; the strong reference owns
+  // the wrap and deletes it once it has been settled.
+  req_wrap_async->Detach();
+
+  if (hit) {
+    std::string path_str(*path, path.length());
+    env->SetImmediate([wrap = std::move(wrap), cached, err, syscall,
+                       path_str = std::move(path_str)](Environment* env) {
+      Isolate* isolate = env->isolate();
+      HandleScope handle_scope(isolate);
+      Context::Scope context_scope(env->context());
+      if (err < 0) {
+        wrap->Reject(UVException(isolate, err, syscall, nullptr,
+                                 path_str.c_str(), nullptr));
+      } else {
+        wrap->ResolveStat(&cached);
+      }
+    });
+    return true;
+  }
+
+  StatCacheJob* job = new StatCacheJob();
+  job->env = env;
+  job->wrap = std::move(wrap);
+  job->use_lstat = use_lstat;
+  job->path.assign(*path, path.length());
+  CHECK_EQ(0, uv_queue_work(env->event_loop(), &job->work_req,
+                            DoStatCacheMiss, AfterStatCacheMiss));
+  return true;
+}
+
+static void SetStatCachePrefixes(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> prefixes_js = args[0].As<Array>();
+
+  std::vector<std::string> prefixes;
+  prefixes.reserve(prefixes_js->Length());
+  for (uint32_t i = 0; i < prefixes_js->Length(); i++) {
+    Local<Value> prefix_v;
+    if (!prefixes_js->Get(env->context(), i).ToLocal(&prefix_v))
+      return;
+    BufferValue prefix(env->isolate(), prefix_v);
+    CHECK_NOT_NULL(*prefix);
+    prefixes.emplace_back(*prefix, prefix.length());
+  }
+
+  StatCache* cache = StatCache::GetOrCreate(env);
+  if (cache != nullptr)
+    cache->SetPrefixes(std::move(prefixes));
+}
+
 static void Stat(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -876,14 +1622,23 @@ static void Stat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
   if (req_wrap_async != nullptr) {  // stat(path, use_bigint, req)
+    if (TryStatCache(env, args, path, use_bigint, false, req_wrap_async))
+      return;
     AsyncCall(env, req_wrap_async, args, "stat", UTF8, AfterStat,
               uv_fs_stat, *path);
   } else {  // stat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
+    if (TryStatCache(env, args, path, use_bigint, false, nullptr))
+      return;
     FSReqWrapSync req_wrap_sync;
     FS_SYNC_TRACE_BEGIN(stat);
     int err = SyncCall(env, args[3], &req_wrap_sync, "stat", uv_fs_stat, *path);
     FS_SYNC_TRACE_END(stat);
+    MaybeCacheStat(env, *path, false,
+                   err == 0 ?
+                       static_cast<const uv_stat_t*>(req_wrap_sync.req.ptr) :
+                       nullptr,
+                   err);
     if (err != 0) {
       return;  // error info is in ctx
     }
@@ -906,15 +1661,24 @@ static void LStat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
   if (req_wrap_async != nullptr) {  // lstat(path, use_bigint, req)
+    if (TryStatCache(env, args, path, use_bigint, true, req_wrap_async))
+      return;
     AsyncCall(env, req_wrap_async, args, "lstat", UTF8, AfterStat,
               uv_fs_lstat, *path);
   } else {  // lstat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
+    if (TryStatCache(env, args, path, use_bigint, true, nullptr))
+      return;
     FSReqWrapSync req_wrap_sync;
     FS_SYNC_TRACE_BEGIN(lstat);
     int err = SyncCall(env, args[3], &req_wrap_sync, "lstat", uv_fs_lstat,
                        *path);
     FS_SYNC_TRACE_END(lstat);
+    MaybeCacheStat(env, *path, true,
+                   err == 0 ?
+                       static_cast<const uv_stat_t*>(req_wrap_sync.req.ptr) :
+                       nullptr,
+                   err);
     if (err != 0) {
       return;  // error info is in ctx
     }
@@ -955,6 +1719,133 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Stats every path of a batch inside a single threadpool task and resolves
+// the request once with [errors, stats]: an Int32Array of per-path libuv
+// error codes (0 on success) and a Float64Array holding kFsStatsFieldsNumber
+// fields per path in the same order as `statValues`. Walking a large
+// directory tree this way costs one loop wakeup and one req allocation for
+// the whole batch instead of one per path.
+struct StatBatchJob {
+  uv_work_t work_req;
+  Environment* env;
+  BaseObjectPtr<FSReqBase> wrap;
+  bool use_lstat;
+  std::vector<std::string> paths;
+  std::vector<int32_t> errors;
+  std::vector<double> stats;
+};
+
+static void DoStatBatch(uv_work_t* req) {
+  StatBatchJob* job = ContainerOf(&StatBatchJob::work_req, req);
+  const size_t fields =
+      static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+  job->errors.resize(job->paths.size());
+  job->stats.resize(job->paths.size() * fields);
+  for (size_t i = 0; i < job->paths.size(); i++) {
+    uv_fs_t fs_req;
+    int err = job->use_lstat ?
+        uv_fs_lstat(nullptr, &fs_req, job->paths[i].c_str(), nullptr) :
+        uv_fs_stat(nullptr, &fs_req, job->paths[i].c_str(), nullptr);
+    job->errors[i] = err;
+    if (err == 0) {
+      const uv_stat_t* s = static_cast<const uv_stat_t*>(fs_req.ptr);
+      double* f = &job->stats[i * fields];
+#define SET_FIELD_WITH_STAT(stat_offset, stat)                                \
+  f[static_cast<size_t>(FsStatsOffset::stat_offset)] =                        \
+      static_cast<double>(stat)
+#define SET_FIELD_WITH_TIME_STAT(stat_offset, stat)                           \
+  /* NOLINTNEXTLINE(runtime/int) */                                           \
+  SET_FIELD_WITH_STAT(stat_offset, static_cast<unsigned long>(stat))
+      SET_FIELD_WITH_STAT(kDev, s->st_dev);
+      SET_FIELD_WITH_STAT(kMode, s->st_mode);
+      SET_FIELD_WITH_STAT(kNlink, s->st_nlink);
+      SET_FIELD_WITH_STAT(kUid, s->st_uid);
+      SET_FIELD_WITH_STAT(kGid, s->st_gid);
+      SET_FIELD_WITH_STAT(kRdev, s->st_rdev);
+      SET_FIELD_WITH_STAT(kBlkSize, s->st_blksize);
+      SET_FIELD_WITH_STAT(kIno, s->st_ino);
+      SET_FIELD_WITH_STAT(kSize, s->st_size);
+      SET_FIELD_WITH_STAT(kBlocks, s->st_blocks);
+      SET_FIELD_WITH_TIME_STAT(kATimeSec, s->st_atim.tv_sec);
+      SET_FIELD_WITH_TIME_STAT(kATimeNsec, s->st_atim.tv_nsec);
+      SET_FIELD_WITH_TIME_STAT(kMTimeSec, s->st_mtim.tv_sec);
+      SET_FIELD_WITH_TIME_STAT(kMTimeNsec, s->st_mtim.tv_nsec);
+      SET_FIELD_WITH_TIME_STAT(kCTimeSec, s->st_ctim.tv_sec);
+      SET_FIELD_WITH_TIME_STAT(kCTimeNsec, s->st_ctim.tv_nsec);
+      SET_FIELD_WITH_TIME_STAT(kBirthTimeSec, s->st_birthtim.tv_sec);
+      SET_FIELD_WITH_TIME_STAT(kBirthTimeNsec, s->st_birthtim.tv_nsec);
+#undef SET_FIELD_WITH_TIME_STAT
+#undef SET_FIELD_WITH_STAT
+    }
+    uv_fs_req_cleanup(&fs_req);
+  }
+}
+
+static void AfterStatBatch(uv_work_t* req, int status) {
+  std::unique_ptr<StatBatchJob> job(ContainerOf(&StatBatchJob::work_req, req));
+  if (status == UV_ECANCELED)
+    return;
+
+  Environment* env = job->env;
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  Local<ArrayBuffer> errors_ab =
+      ArrayBuffer::New(isolate, job->errors.size() * sizeof(int32_t));
+  memcpy(errors_ab->GetBackingStore()->Data(),
+         job->errors.data(),
+         job->errors.size() * sizeof(int32_t));
+  Local<ArrayBuffer> stats_ab =
+      ArrayBuffer::New(isolate, job->stats.size() * sizeof(double));
+  memcpy(stats_ab->GetBackingStore()->Data(),
+         job->stats.data(),
+         job->stats.size() * sizeof(double));
+
+  Local<Value> argv[] = {
+    Int32Array::New(errors_ab, 0, job->errors.size()),
+    Float64Array::New(stats_ab, 0, job->stats.size())
+  };
+  job->wrap->Resolve(Array::New(isolate, argv, arraysize(argv)));
+}
+
+static void StatBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> paths = args[0].As<Array>();
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2]);
+  CHECK_NOT_NULL(req_wrap_async);  // statBatch(paths, use_lstat, req)
+  req_wrap_async->Init("stat", nullptr, 0, UTF8);
+
+  std::unique_ptr<StatBatchJob> job(new StatBatchJob());
+  job->env = env;
+  job->wrap = BaseObjectPtr<FSReqBase>(req_wrap_async);
+  // No FSReqAfterScope runs for this job; let the job's reference own the
+  // wrap so it is deleted once the batch has been resolved.
+  req_wrap_async->Detach();
+  job->use_lstat = args[1]->IsTrue();
+  job->paths.reserve(paths->Length());
+  for (uint32_t i = 0; i < paths->Length(); i++) {
+    Local<Value> path_v;
+    if (!paths->Get(env->context(), i).ToLocal(&path_v))
+      return;
+    BufferValue path(env->isolate(), path_v);
+    CHECK_NOT_NULL(*path);
+    job->paths.emplace_back(*path, path.length());
+  }
+
+  CHECK_EQ(0, uv_queue_work(env->event_loop(), &job->work_req,
+                            DoStatBatch, AfterStatBatch));
+  job.release();  // Owned by the threadpool until AfterStatBatch runs.
+
+  args.GetReturnValue().Set(req_wrap_async->object());
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1605,6 +2496,268 @@ static void CopyFile(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// uv_fs_copyfile() copies sequentially on a single threadpool thread. The
+// parallel variant below clones the file outright when the filesystem
+// supports it (FICLONE on XFS/btrfs) and otherwise splits plain copies
+// into ranges handled by concurrent threadpool tasks, each preferring
+// copy_file_range(2) so the data never crosses into user space.
+constexpr int64_t kParallelCopyChunkSize = 8 << 20;  // 8 MiB
+constexpr int64_t kParallelCopyMaxTasks = 4;
+
+struct ParallelCopyJob;
+
+struct ParallelCopyRange {
+  uv_work_t work_req;
+  ParallelCopyJob* job;
+  int64_t offset;
+  int64_t length;
+  int err = 0;
+};
+
+struct ParallelCopyJob {
+  uv_work_t work_req;
+  Environment* env;
+  BaseObjectPtr<FSReqBase> wrap;
+  std::string src;
+  std::string dest;
+  int flags;
+  uv_file src_fd = -1;
+  uv_file dest_fd = -1;
+  int64_t size = 0;
+  // Set when the setup task finished the whole copy (clone or small file).
+  bool done = false;
+  int err = 0;
+  const char* syscall = "copyfile";
+  std::vector<ParallelCopyRange> ranges;
+  int pending_ranges = 0;
+};
+
+// Copies [offset, offset + length) between two already-open descriptors.
+// Runs on a threadpool thread; several ranges of the same file pair run
+// concurrently.
+static int CopyFdRange(uv_file src_fd,
+                       uv_file dest_fd,
+                       int64_t offset,
+                       int64_t length) {
+  int64_t copied = 0;
+#if defined(__linux__) && defined(__NR_copy_file_range)
+  while (copied < length) {
+    loff_t off_in = offset + copied;
+    loff_t off_out = offset + copied;
+    ssize_t n = syscall(__NR_copy_file_range, src_fd, &off_in, dest_fd,
+                        &off_out, static_cast<size_t>(length - copied), 0);
+    if (n > 0) {
+      copied += n;
+      continue;
+    }
+    if (n < 0 && errno == EINTR)
+      continue;
+    // EOF, old kernel or cross-device: finish with pread/pwrite.
+    break;
+  }
+#endif
+  std::vector<char> chunk(64 * 1024);
+  while (copied < length) {
+    int64_t want = length - copied;
+    if (want > static_cast<int64_t>(chunk.size()))
+      want = chunk.size();
+    uv_buf_t rbuf = uv_buf_init(chunk.data(), static_cast<unsigned int>(want));
+    uv_fs_t req;
+    int nread = uv_fs_read(nullptr, &req, src_fd, &rbuf, 1,
+                           offset + copied, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (nread < 0)
+      return nread;
+    if (nread == 0)  // The source shrank underneath us.
+      return 0;
+    int written = 0;
+    while (written < nread) {
+      uv_buf_t wbuf = uv_buf_init(chunk.data() + written,
+                                  static_cast<unsigned int>(nread - written));
+      int nw = uv_fs_write(nullptr, &req, dest_fd, &wbuf, 1,
+                           offset + copied + written, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (nw < 0)
+        return nw;
+      written += nw;
+    }
+    copied += nread;
+  }
+  return 0;
+}
+
+static void DoParallelCopySetup(uv_work_t* req) {
+  ParallelCopyJob* job = ContainerOf(&ParallelCopyJob::work_req, req);
+  uv_fs_t fs_req;
+
+  int r = uv_fs_open(nullptr, &fs_req, job->src.c_str(), O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&fs_req);
+  if (r < 0) {
+    job->err = r;
+    job->syscall = "open";
+    return;
+  }
+  job->src_fd = r;
+
+  r = uv_fs_fstat(nullptr, &fs_req, job->src_fd, nullptr);
+  if (r < 0) {
+    uv_fs_req_cleanup(&fs_req);
+    job->err = r;
+    job->syscall = "fstat";
+    return;
+  }
+  const uv_stat_t* s = static_cast<const uv_stat_t*>(fs_req.ptr);
+  job->size = static_cast<int64_t>(s->st_size);
+  const int mode = static_cast<int>(s->st_mode) & 0777;
+  uv_fs_req_cleanup(&fs_req);
+
+  int dest_flags = O_WRONLY | O_CREAT | O_TRUNC;
+  if (job->flags & UV_FS_COPYFILE_EXCL)
+    dest_flags |= O_EXCL;
+  r = uv_fs_open(nullptr, &fs_req, job->dest.c_str(), dest_flags, mode,
+                 nullptr);
+  uv_fs_req_cleanup(&fs_req);
+  if (r < 0) {
+    job->err = r;
+    job->syscall = "open";
+    return;
+  }
+  job->dest_fd = r;
+
+#ifdef __linux__
+  if (ioctl(job->dest_fd, FICLONE, job->src_fd) == 0) {
+    job->done = true;
+    return;
+  }
+#endif
+
+  if (job->size == 0) {
+    job->done = true;
+    return;
+  }
+  if (job->size <= kParallelCopyChunkSize) {
+    job->err = CopyFdRange(job->src_fd, job->dest_fd, 0, job->size);
+    job->done = true;
+    return;
+  }
+
+  // Preallocate so concurrently written ranges never race to extend the
+  // file.
+  r = uv_fs_ftruncate(nullptr, &fs_req, job->dest_fd, job->size, nullptr);
+  uv_fs_req_cleanup(&fs_req);
+  if (r < 0) {
+    job->err = r;
+    job->syscall = "ftruncate";
+  }
+}
+
+static void FinishParallelCopy(ParallelCopyJob* job) {
+  uv_fs_t fs_req;
+  if (job->src_fd >= 0) {
+    uv_fs_close(nullptr, &fs_req, job->src_fd, nullptr);
+    uv_fs_req_cleanup(&fs_req);
+  }
+  if (job->dest_fd >= 0) {
+    uv_fs_close(nullptr, &fs_req, job->dest_fd, nullptr);
+    uv_fs_req_cleanup(&fs_req);
+  }
+
+  // Canceled work means the loop is shutting down; don't call into JS.
+  if (job->err == UV_ECANCELED) {
+    delete job;
+    return;
+  }
+
+  Environment* env = job->env;
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+  if (job->err < 0) {
+    job->wrap->Reject(UVException(isolate, job->err, job->syscall, nullptr,
+                                  job->src.c_str(), job->dest.c_str()));
+  } else {
+    job->wrap->Resolve(Undefined(isolate));
+  }
+  delete job;
+}
+
+static void DoParallelCopyRange(uv_work_t* req) {
+  ParallelCopyRange* range = ContainerOf(&ParallelCopyRange::work_req, req);
+  range->err = CopyFdRange(range->job->src_fd, range->job->dest_fd,
+                           range->offset, range->length);
+}
+
+static void AfterParallelCopyRange(uv_work_t* req, int status) {
+  ParallelCopyRange* range = ContainerOf(&ParallelCopyRange::work_req, req);
+  ParallelCopyJob* job = range->job;
+  if (status == UV_ECANCELED)
+    job->err = status;
+  else if (range->err < 0 && job->err == 0)
+    job->err = range->err;
+  if (--job->pending_ranges == 0)
+    FinishParallelCopy(job);
+}
+
+static void AfterParallelCopySetup(uv_work_t* req, int status) {
+  ParallelCopyJob* job = ContainerOf(&ParallelCopyJob::work_req, req);
+  if (status == UV_ECANCELED)
+    job->err = status;
+  if (job->err != 0 || job->done) {
+    FinishParallelCopy(job);
+    return;
+  }
+
+  int64_t tasks = (job->size + kParallelCopyChunkSize - 1) /
+      kParallelCopyChunkSize;
+  if (tasks > kParallelCopyMaxTasks)
+    tasks = kParallelCopyMaxTasks;
+  const int64_t per_task = job->size / tasks;
+  job->ranges.resize(tasks);
+  job->pending_ranges = static_cast<int>(tasks);
+  for (int64_t i = 0; i < tasks; i++) {
+    ParallelCopyRange& range = job->ranges[i];
+    range.job = job;
+    range.offset = i * per_task;
+    range.length = i == tasks - 1 ? job->size - range.offset : per_task;
+    CHECK_EQ(0, uv_queue_work(job->env->event_loop(), &range.work_req,
+                              DoParallelCopyRange, AfterParallelCopyRange));
+  }
+}
+
+static void CopyFileParallel(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  BufferValue src(isolate, args[0]);
+  CHECK_NOT_NULL(*src);
+
+  BufferValue dest(isolate, args[1]);
+  CHECK_NOT_NULL(*dest);
+
+  CHECK(args[2]->IsInt32());
+  const int flags = args[2].As<Int32>()->Value();
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  CHECK_NOT_NULL(req_wrap_async);  // copyFileParallel(src, dest, flags, req)
+  req_wrap_async->Init("copyfile", nullptr, 0, UTF8);
+  req_wrap_async->SetReturnValue(args);
+
+  ParallelCopyJob* job = new ParallelCopyJob();
+  job->env = env;
+  job->wrap = BaseObjectPtr<FSReqBase>(req_wrap_async);
+  // No FSReqAfterScope runs for this job; the job's reference owns the
+  // wrap and deletes it once the copy has been settled.
+  req_wrap_async->Detach();
+  job->src.assign(*src, src.length());
+  job->dest.assign(*dest, dest.length());
+  job->flags = flags;
+  CHECK_EQ(0, uv_queue_work(env->event_loop(), &job->work_req,
+                            DoParallelCopySetup, AfterParallelCopySetup));
+}
+
 
 // Wrapper for write(2).
 //
@@ -1863,6 +3016,414 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+#ifndef _WIN32
+// mmapRead(path, ctx): maps the whole file and returns a Buffer backed by
+// the mapping, with an unmap-on-free deleter. Loading is O(page faults)
+// instead of threadpool read()s into fresh memory, and multiple processes
+// reading the same file share page cache instead of duplicating RSS. The
+// mapping is copy-on-write (MAP_PRIVATE), so writing into the Buffer stays
+// safe and only dirties the touched pages. Synchronous on purpose: open,
+// fstat and mmap are three cheap syscalls; the data itself is faulted in
+// lazily.
+static void MMapRead(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  FSReqWrapSync req_wrap_open;
+  FS_SYNC_TRACE_BEGIN(open);
+  const int fd = SyncCall(env, args[1], &req_wrap_open, "open",
+                          uv_fs_open, *path, O_RDONLY, 0);
+  FS_SYNC_TRACE_END(open);
+  if (fd < 0) {
+    return;  // error info is in ctx
+  }
+
+  FSReqWrapSync req_wrap_stat;
+  const int err = SyncCall(env, args[1], &req_wrap_stat, "fstat",
+                           uv_fs_fstat, fd);
+  if (err < 0) {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+    return;  // error info is in ctx
+  }
+
+  const uv_stat_t* s = static_cast<const uv_stat_t*>(req_wrap_stat.req.ptr);
+  const size_t size = static_cast<size_t>(s->st_size);
+
+  void* data = MAP_FAILED;
+  if (size > 0)
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  const int mmap_errno = errno;
+
+  // The mapping (if any) keeps its own reference to the file.
+  uv_fs_t close_req;
+  CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+  uv_fs_req_cleanup(&close_req);
+
+  if (size == 0) {
+    Local<Object> buf;
+    if (Buffer::New(env, 0).ToLocal(&buf))
+      args.GetReturnValue().Set(buf);
+    return;
+  }
+
+  if (data == MAP_FAILED) {
+    Local<Context> context = env->context();
+    Local<Object> ctx_obj = args[1].As<Object>();
+    ctx_obj->Set(context,
+                 env->errno_string(),
+                 Integer::New(isolate,
+                              uv_translate_sys_error(mmap_errno))).Check();
+    ctx_obj->Set(context,
+                 env->syscall_string(),
+                 OneByteString(isolate, "mmap")).Check();
+    return;
+  }
+
+  std::unique_ptr<v8::BackingStore> store = ArrayBuffer::NewBackingStore(
+      data,
+      size,
+      [](void* data, size_t length, void* deleter_data) {
+        munmap(data, length);
+      },
+      nullptr);
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+
+  Local<v8::Uint8Array> buf;
+  if (Buffer::New(isolate, ab, 0, size).ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+
+class AssetCache;
+
+struct AssetCacheWatcher {
+  uv_fs_event_t handle;
+  std::string path;
+  AssetCache* cache;
+};
+
+// Caches whole files as an open fd plus a private mapping, keyed by path.
+// A hit mints a Buffer over the existing mapping without touching the
+// kernel; writing that Buffer to a stream is then a pointer handoff with
+// no further copies. Mappings are refcounted, so an evicted entry stays
+// alive until the last Buffer over it is collected. Every cached file
+// carries an unref'ed uv_fs_event watcher that evicts it as soon as the
+// file changes, and the total mapped size is capped with LRU eviction.
+class AssetCache {
+ public:
+  static constexpr uint64_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+  struct Entry {
+    std::string path;
+    // Held open for the life of the entry: the cached content keeps being
+    // served even if the path is unlinked or renamed over, and fd-based
+    // serving paths (e.g. sendfile offload) can reuse it without reopening.
+    int fd = -1;
+    char* data = nullptr;
+    size_t size = 0;
+    // One reference held by the cache itself plus one per live Buffer.
+    // Backing stores can be freed from GC threads, hence the atomic.
+    std::atomic<uint32_t> refs{1};
+    AssetCacheWatcher* watcher = nullptr;
+    std::list<Entry*>::iterator lru_pos;
+  };
+
+  static AssetCache* GetOrCreate(Environment* env) {
+    AssetCache* cache = per_thread_asset_cache;
+    if (cache != nullptr)
+      return cache->env_ == env ? cache : nullptr;
+    cache = new AssetCache(env);
+    per_thread_asset_cache = cache;
+    env->AddCleanupHook(CleanupHook, cache);
+    return cache;
+  }
+
+  // Drops a reference; only ever touches the entry itself, so it is safe
+  // to call from whatever thread frees the Buffer's backing store.
+  static void Unref(Entry* entry) {
+    if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+    if (entry->data != nullptr)
+      munmap(entry->data, entry->size);
+    if (entry->fd >= 0)
+      close(entry->fd);
+    delete entry;
+  }
+
+  Entry* Lookup(const char* path) {
+    auto it = entries_.find(path);
+    if (it == entries_.end())
+      return nullptr;
+    Entry* entry = it->second;
+    lru_.splice(lru_.begin(), lru_, entry->lru_pos);
+    return entry;
+  }
+
+  // Takes ownership of the fd and the mapping on success; on failure the
+  // caller keeps both. Files larger than the cap and files that cannot be
+  // watched (which could go stale forever) are never admitted. `expected`
+  // is the stat taken before the file was mapped.
+  Entry* Insert(const char* path,
+                int fd,
+                char* data,
+                size_t size,
+                const uv_stat_t& expected) {
+    if (closing_ || size > max_bytes_ || entries_.count(path) != 0)
+      return nullptr;
+    Entry* entry = new Entry();
+    entry->path = path;
+    entry->fd = fd;
+    entry->data = data;
+    entry->size = size;
+    if (!StartWatcher(entry)) {
+      delete entry;
+      return nullptr;
+    }
+    // The watcher only observes changes from this point on; a write that
+    // landed between the caller's stat/mmap and the watcher arming would
+    // be cached forever. Re-stat the held fd now that the watcher is
+    // armed and refuse the entry if the file changed in that window.
+    uv_fs_t stat_req;
+    const int err = uv_fs_fstat(nullptr, &stat_req, fd, nullptr);
+    const uv_stat_t* now = static_cast<const uv_stat_t*>(stat_req.ptr);
+    const bool changed = err != 0 ||
+        now->st_size != expected.st_size ||
+        now->st_mtim.tv_sec != expected.st_mtim.tv_sec ||
+        now->st_mtim.tv_nsec != expected.st_mtim.tv_nsec;
+    uv_fs_req_cleanup(&stat_req);
+    if (changed) {
+      uv_close(reinterpret_cast<uv_handle_t*>(&entry->watcher->handle),
+               OnWatcherClose);
+      entry->watcher = nullptr;
+      delete entry;
+      return nullptr;
+    }
+    while (total_bytes_ + size > max_bytes_)
+      Evict(lru_.back());
+    lru_.push_front(entry);
+    entry->lru_pos = lru_.begin();
+    entries_[entry->path] = entry;
+    total_bytes_ += size;
+    return entry;
+  }
+
+  void SetMaxBytes(uint64_t max_bytes) {
+    max_bytes_ = max_bytes;
+    while (total_bytes_ > max_bytes_)
+      Evict(lru_.back());
+  }
+
+ private:
+  explicit AssetCache(Environment* env) : env_(env) {}
+
+  void Evict(Entry* entry) {
+    entries_.erase(entry->path);
+    lru_.erase(entry->lru_pos);
+    total_bytes_ -= entry->size;
+    if (entry->watcher != nullptr) {
+      uv_close(reinterpret_cast<uv_handle_t*>(&entry->watcher->handle),
+               OnWatcherClose);
+      entry->watcher = nullptr;
+    }
+    // Outstanding Buffers keep the mapping alive past this point.
+    Unref(entry);
+  }
+
+  bool StartWatcher(Entry* entry) {
+    std::unique_ptr<AssetCacheWatcher> w(new AssetCacheWatcher());
+    w->path = entry->path;
+    w->cache = this;
+    w->handle.data = w.get();
+    if (uv_fs_event_init(env_->event_loop(), &w->handle) != 0)
+      return false;
+    open_handles_++;
+    if (uv_fs_event_start(&w->handle, OnEvent, entry->path.c_str(), 0) != 0) {
+      uv_close(reinterpret_cast<uv_handle_t*>(&w->handle), OnWatcherClose);
+      w.release();  // Freed by OnWatcherClose.
+      return false;
+    }
+    // The cache must never keep an otherwise idle loop alive.
+    uv_unref(reinterpret_cast<uv_handle_t*>(&w->handle));
+    entry->watcher = w.release();
+    return true;
+  }
+
+  static void OnEvent(uv_fs_event_t* handle,
+                      const char* filename,
+                      int events,
+                      int status) {
+    AssetCacheWatcher* w = static_cast<AssetCacheWatcher*>(handle->data);
+    AssetCache* cache = w->cache;
+    auto it = cache->entries_.find(w->path);
+    if (it != cache->entries_.end())
+      cache->Evict(it->second);
+  }
+
+  static void OnWatcherClose(uv_handle_t* handle) {
+    AssetCacheWatcher* w = static_cast<AssetCacheWatcher*>(handle->data);
+    AssetCache* cache = w->cache;
+    delete w;
+    if (--cache->open_handles_ == 0 && cache->closing_)
+      delete cache;
+  }
+
+  static void CleanupHook(void* data) {
+    AssetCache* cache = static_cast<AssetCache*>(data);
+    if (per_thread_asset_cache == cache)
+      per_thread_asset_cache = nullptr;
+    cache->closing_ = true;
+    while (!cache->lru_.empty())
+      cache->Evict(cache->lru_.back());
+    if (cache->open_handles_ == 0)
+      delete cache;
+  }
+
+  static thread_local AssetCache* per_thread_asset_cache;
+
+  Environment* env_;
+  uint64_t max_bytes_ = kDefaultMaxBytes;
+  uint64_t total_bytes_ = 0;
+  std::unordered_map<std::string, Entry*> entries_;
+  std::list<Entry*> lru_;  // Most recently used first.
+  int open_handles_ = 0;
+  bool closing_ = false;
+};
+
+thread_local AssetCache* AssetCache::per_thread_asset_cache = nullptr;
+
+// assetCacheRead(path, ctx): readFileSync through the asset cache. A hit
+// returns a Buffer aliasing the cached mapping without a single syscall; a
+// miss opens and maps the file and caches the fd/mapping pair for next
+// time. All Buffers handed out for one file share one copy-on-write
+// mapping, so callers must treat them as read-only.
+static void AssetCacheRead(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  AssetCache* cache = AssetCache::GetOrCreate(env);
+  AssetCache::Entry* entry =
+      cache != nullptr ? cache->Lookup(*path) : nullptr;
+
+  if (entry == nullptr) {
+    FSReqWrapSync req_wrap_open;
+    FS_SYNC_TRACE_BEGIN(open);
+    const int fd = SyncCall(env, args[1], &req_wrap_open, "open",
+                            uv_fs_open, *path, O_RDONLY, 0);
+    FS_SYNC_TRACE_END(open);
+    if (fd < 0) {
+      return;  // error info is in ctx
+    }
+
+    FSReqWrapSync req_wrap_stat;
+    const int err = SyncCall(env, args[1], &req_wrap_stat, "fstat",
+                             uv_fs_fstat, fd);
+    if (err < 0) {
+      uv_fs_t close_req;
+      CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+      uv_fs_req_cleanup(&close_req);
+      return;  // error info is in ctx
+    }
+
+    const uv_stat_t* s = static_cast<const uv_stat_t*>(req_wrap_stat.req.ptr);
+    const size_t size = static_cast<size_t>(s->st_size);
+
+    if (size == 0) {
+      uv_fs_t close_req;
+      CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+      uv_fs_req_cleanup(&close_req);
+      Local<Object> buf;
+      if (Buffer::New(env, 0).ToLocal(&buf))
+        args.GetReturnValue().Set(buf);
+      return;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, 0);
+    if (data == MAP_FAILED) {
+      const int mmap_errno = errno;
+      uv_fs_t close_req;
+      CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+      uv_fs_req_cleanup(&close_req);
+      Local<Context> context = env->context();
+      Local<Object> ctx_obj = args[1].As<Object>();
+      ctx_obj->Set(context,
+                   env->errno_string(),
+                   Integer::New(isolate,
+                                uv_translate_sys_error(mmap_errno))).Check();
+      ctx_obj->Set(context,
+                   env->syscall_string(),
+                   OneByteString(isolate, "mmap")).Check();
+      return;
+    }
+
+    entry = cache != nullptr ?
+        cache->Insert(*path, fd, static_cast<char*>(data), size, *s) :
+        nullptr;
+    if (entry == nullptr) {
+      // Not admitted (too big, unwatchable, modified while being mapped,
+      // or the cache is shutting down): serve this one read uncached,
+      // mmapRead-style.
+      uv_fs_t close_req;
+      CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+      uv_fs_req_cleanup(&close_req);
+      std::unique_ptr<v8::BackingStore> store = ArrayBuffer::NewBackingStore(
+          data,
+          size,
+          [](void* data, size_t length, void* deleter_data) {
+            munmap(data, length);
+          },
+          nullptr);
+      Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+      Local<v8::Uint8Array> buf;
+      if (Buffer::New(isolate, ab, 0, size).ToLocal(&buf))
+        args.GetReturnValue().Set(buf);
+      return;
+    }
+  }
+
+  // Cache hit or freshly inserted: hand out a Buffer sharing the mapping.
+  entry->refs.fetch_add(1, std::memory_order_relaxed);
+  std::unique_ptr<v8::BackingStore> store = ArrayBuffer::NewBackingStore(
+      entry->data,
+      entry->size,
+      [](void* data, size_t length, void* deleter_data) {
+        AssetCache::Unref(static_cast<AssetCache::Entry*>(deleter_data));
+      },
+      entry);
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+  Local<v8::Uint8Array> buf;
+  if (Buffer::New(isolate, ab, 0, entry->size).ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+static void SetAssetCacheSize(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsNumber());
+  const double max_bytes = args[0].As<Number>()->Value();
+  CHECK_GE(max_bytes, 0);
+
+  AssetCache* cache = AssetCache::GetOrCreate(env);
+  if (cache != nullptr)
+    cache->SetMaxBytes(static_cast<uint64_t>(max_bytes));
+}
+#endif  // !_WIN32
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2126,6 +3687,11 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
   env->SetMethod(target, "read", Read);
+#ifndef _WIN32
+  env->SetMethod(target, "mmapRead", MMapRead);
+  env->SetMethod(target, "assetCacheRead", AssetCacheRead);
+  env->SetMethod(target, "setAssetCacheSize", SetAssetCacheSize);
+#endif
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
   env->SetMethod(target, "rename", Rename);
@@ -2138,6 +3704,8 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
+  env->SetMethod(target, "statBatch", StatBatch);
+  env->SetMethod(target, "setStatCachePrefixes", SetStatCachePrefixes);
   env->SetMethod(target, "link", Link);
   env->SetMethod(target, "symlink", Symlink);
   env->SetMethod(target, "readlink", ReadLink);
@@ -2147,6 +3715,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "writeString", WriteString);
   env->SetMethod(target, "realpath", RealPath);
   env->SetMethod(target, "copyFile", CopyFile);
+  env->SetMethod(target, "copyFileParallel", CopyFileParallel);
 
   env->SetMethod(target, "chmod", Chmod);
   env->SetMethod(target, "fchmod", FChmod);
@@ -2217,6 +3786,11 @@ void Initialize(Local<Object> target,
   fd->Inherit(AsyncWrap::GetConstructorTemplate(env));
   env->SetProtoMethod(fd, "close", FileHandle::Close);
   env->SetProtoMethod(fd, "releaseFD", FileHandle::ReleaseFD);
+  env->SetProtoMethod(fd, "setReadPipelineDepth",
+                      FileHandle::SetReadPipelineDepth);
+  env->SetProtoMethod(fd, "writeCombined", FileHandle::WriteCombined);
+  env->SetProtoMethod(fd, "flushCombinedWrites",
+                      FileHandle::FlushCombinedWrites);
   Local<ObjectTemplate> fdt = fd->InstanceTemplate();
   fdt->SetInternalFieldCount(StreamBase::kStreamBaseFieldCount);
   Local<String> handleString =
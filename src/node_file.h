@@ -6,9 +6,13 @@
 #include "node.h"
 #include "aliased_buffer.h"
 #include "stream_base.h"
+#include <deque>
 #include <iostream>
 
 namespace node {
+
+class StreamPipe;
+
 namespace fs {
 
 // structure used to store state during a complex operation, e.g., mkdirp.
@@ -190,6 +194,13 @@ class FileHandleReadWrap final : public ReqWrap<uv_fs_t> {
  private:
   FileHandle* file_handle_;
   uv_buf_t buffer_;
+  // Pipelined reads can complete out of order; completions are parked here
+  // until all earlier reads have finished and been emitted.
+  bool done_ = false;
+  // Set when a short read forced the pipeline to resynchronize; the result
+  // is dropped instead of emitted once the read completes.
+  bool discarded_ = false;
+  int result_ = 0;
 
   friend class FileHandle;
 };
@@ -214,6 +225,20 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   // Releases ownership of the FD.
   static void ReleaseFD(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  // Sets how many reads ReadStart() keeps in flight for this handle.
+  static void SetReadPipelineDepth(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // writeCombined(buffer): copies the buffer into a per-handle arena that
+  // is flushed as a single write per loop turn (or once the arena fills).
+  // Returns the number of bytes queued, or a negative errno if an earlier
+  // combined flush failed.
+  static void WriteCombined(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // flushCombinedWrites(req): barrier that resolves `req` once every byte
+  // queued so far has been handed to the kernel, so fsync() ordering holds.
+  static void FlushCombinedWrites(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
   // StreamBase interface:
   int ReadStart() override;
   int ReadStop() override;
@@ -248,6 +273,28 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   void Close();
   void AfterClose();
 
+  // Issues reads until read_pipeline_depth_ of them are in flight (or the
+  // requested range is covered). With an explicit read offset several reads
+  // can run concurrently; position-relative reads are limited to one.
+  void FillReadPipeline();
+  // Records the completion of `wrap` (bytes read or a negative errno),
+  // shared by the threadpool and io_uring submission paths.
+  void OnReadComplete(FileHandleReadWrap* wrap, int result);
+  // Emits completed reads from the front of the pipeline in issue order.
+  void DrainCompletedReads();
+  // Drops all issued-but-unemitted reads, e.g. after a short read made
+  // their file offsets stale. Reads still in flight are kept alive until
+  // their completion arrives and are then discarded quietly.
+  void DiscardPipelinedReads();
+
+  // Schedules a combined flush for later in this loop turn.
+  void ScheduleCombineFlush();
+  // Starts writing out the active arena; chains until both arenas are
+  // empty, then settles any pending flush barriers.
+  void StartCombineFlush();
+  static void AfterCombineFlush(uv_fs_t* req);
+  void SettleCombineBarriers();
+
   class CloseReq final : public ReqWrap<uv_fs_t> {
    public:
     CloseReq(Environment* env,
@@ -291,7 +338,36 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   int64_t read_length_ = -1;
 
   bool reading_ = false;
-  std::unique_ptr<FileHandleReadWrap> current_read_ = nullptr;
+  // In-flight and completed-but-unemitted reads, in file-offset order.
+  std::deque<std::unique_ptr<FileHandleReadWrap>> pending_reads_;
+  // Discarded reads whose completion has not arrived yet.
+  std::vector<std::unique_ptr<FileHandleReadWrap>> abandoned_reads_;
+  // Bytes covered by issued-but-unemitted reads; the next read is issued
+  // at read_offset_ + issued_ahead_.
+  int64_t issued_ahead_ = 0;
+  uint32_t read_pipeline_depth_ = 1;
+
+  // Flush the combined-write arena once it holds this many bytes instead
+  // of waiting for the end of the loop turn.
+  static constexpr size_t kCombineFlushThreshold = 1 << 20;
+  // Double-buffered write-combining arenas: appends land in the active
+  // arena while the other one is being written out.
+  std::vector<char> combine_active_;
+  std::vector<char> combine_flushing_;
+  bool combine_flush_scheduled_ = false;
+  bool combine_inflight_ = false;
+  // First error from a background flush; reported (and cleared) by the
+  // next writeCombined() or flushCombinedWrites() call.
+  int combine_error_ = 0;
+  // Flush barriers waiting for the arenas to drain.
+  std::vector<BaseObjectPtr<FSReqBase>> combine_barriers_;
+  uv_fs_t combine_req_;
+  // Keeps the handle alive while a combined flush is in flight.
+  BaseObjectPtr<FileHandle> combine_self_ref_;
+
+  // StreamPipe's sendfile(2) offload path reads from the fd directly and
+  // keeps read_offset_/read_length_ in sync while doing so.
+  friend class node::StreamPipe;
 };
 
 int MKDirpSync(uv_loop_t* loop,
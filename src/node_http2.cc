@@ -3,11 +3,15 @@
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_buffer.h"
+#include "node_dtrace.h"
 #include "node_http2.h"
 #include "node_http2_state.h"
+#include "node_internals.h"
 #include "node_mem-inl.h"
 #include "node_perf.h"
 #include "node_revert.h"
+#include "tracing/trace_category_state.h"
+#include "tracing/trace_event.h"
 #include "util-inl.h"
 
 #include <algorithm>
@@ -358,9 +362,51 @@ const char* Http2Session::TypeName() const {
 
 // The Headers class initializes a proper array of nghttp2_nv structs
 // containing the header name value pairs.
+// Splits the packed "name\0value\0name\0value\0..." byte string written by
+// JS into `count` nghttp2_nv entries pointing into `header_contents`.
+// Returns the number of usable entries, which may be less than `count` if a
+// passed header contained a null byte; in that case a single invalid header
+// is provided to make nghttp2 reject the headers list.
+static size_t PopulateHeaderBlock(nghttp2_nv* nva,
+                                  size_t count,
+                                  char* header_contents,
+                                  int header_string_len) {
+  size_t n = 0;
+  char* p;
+  for (p = header_contents; p < header_contents + header_string_len; n++) {
+    if (n >= count) {
+      static uint8_t zero = '\0';
+      nva[0].name = nva[0].value = &zero;
+      nva[0].namelen = nva[0].valuelen = 1;
+      return 1;
+    }
+
+    nva[n].flags = NGHTTP2_NV_FLAG_NONE;
+    nva[n].name = reinterpret_cast<uint8_t*>(p);
+    nva[n].namelen = strlen(p);
+    p += nva[n].namelen + 1;
+    nva[n].value = reinterpret_cast<uint8_t*>(p);
+    nva[n].valuelen = strlen(p);
+    p += nva[n].valuelen + 1;
+  }
+  return count;
+}
+
 Headers::Headers(Isolate* isolate,
                  Local<Context> context,
-                 Local<Array> headers) {
+                 Local<Value> value) {
+  if (!value->IsArray()) {
+    // A prepared header block; point straight at its converted entries.
+    CHECK(value->IsObject());
+    Http2PreparedHeaders* prepared =
+        BaseObject::FromJSObject<Http2PreparedHeaders>(value.As<Object>());
+    CHECK_NOT_NULL(prepared);
+    nva_ = prepared->nva();
+    count_ = prepared->length();
+    return;
+  }
+
+  Local<Array> headers = value.As<Array>();
   Local<Value> header_string = headers->Get(context, 0).ToLocalChecked();
   Local<Value> header_count = headers->Get(context, 1).ToLocalChecked();
   count_ = header_count.As<Uint32>()->Value();
@@ -382,6 +428,7 @@ Headers::Headers(Isolate* isolate,
       RoundUp(reinterpret_cast<uintptr_t>(*buf_), alignof(nghttp2_nv)));
   char* header_contents = start + (count_ * sizeof(nghttp2_nv));
   nghttp2_nv* const nva = reinterpret_cast<nghttp2_nv*>(start);
+  nva_ = nva;
 
   CHECK_LE(header_contents + header_string_len, *buf_ + buf_.length());
   CHECK_EQ(header_string.As<String>()->WriteOneByte(
@@ -392,28 +439,55 @@ Headers::Headers(Isolate* isolate,
                String::NO_NULL_TERMINATION),
            header_string_len);
 
-  size_t n = 0;
-  char* p;
-  for (p = header_contents; p < header_contents + header_string_len; n++) {
-    if (n >= count_) {
-      // This can happen if a passed header contained a null byte. In that
-      // case, just provide nghttp2 with an invalid header to make it reject
-      // the headers list.
-      static uint8_t zero = '\0';
-      nva[0].name = nva[0].value = &zero;
-      nva[0].namelen = nva[0].valuelen = 1;
-      count_ = 1;
-      return;
-    }
+  count_ = PopulateHeaderBlock(nva, count_, header_contents,
+                               header_string_len);
+}
 
-    nva[n].flags = NGHTTP2_NV_FLAG_NONE;
-    nva[n].name = reinterpret_cast<uint8_t*>(p);
-    nva[n].namelen = strlen(p);
-    p += nva[n].namelen + 1;
-    nva[n].value = reinterpret_cast<uint8_t*>(p);
-    nva[n].valuelen = strlen(p);
-    p += nva[n].valuelen + 1;
+Http2PreparedHeaders::Http2PreparedHeaders(Environment* env,
+                                           Local<Object> wrap,
+                                           Local<Array> headers)
+    : BaseObject(env, wrap) {
+  MakeWeak();
+
+  Local<Context> context = env->context();
+  Local<Value> header_string = headers->Get(context, 0).ToLocalChecked();
+  Local<Value> header_count = headers->Get(context, 1).ToLocalChecked();
+  count_ = header_count.As<Uint32>()->Value();
+  int header_string_len = header_string.As<String>()->Length();
+
+  if (count_ == 0) {
+    CHECK_EQ(header_string_len, 0);
+    return;
   }
+
+  // Same layout as Headers, but in heap storage that lives as long as this
+  // object so the converted block can be reused across submissions.
+  storage_.resize((alignof(nghttp2_nv) - 1) + count_ * sizeof(nghttp2_nv) +
+                  header_string_len);
+  char* start = reinterpret_cast<char*>(RoundUp(
+      reinterpret_cast<uintptr_t>(storage_.data()), alignof(nghttp2_nv)));
+  char* header_contents = start + (count_ * sizeof(nghttp2_nv));
+  nva_ = reinterpret_cast<nghttp2_nv*>(start);
+
+  CHECK_LE(header_contents + header_string_len,
+           storage_.data() + storage_.size());
+  CHECK_EQ(header_string.As<String>()->WriteOneByte(
+               env->isolate(),
+               reinterpret_cast<uint8_t*>(header_contents),
+               0,
+               header_string_len,
+               String::NO_NULL_TERMINATION),
+           header_string_len);
+
+  count_ = PopulateHeaderBlock(nva_, count_, header_contents,
+                               header_string_len);
+}
+
+void Http2PreparedHeaders::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsArray());
+  Environment* env = Environment::GetCurrent(args);
+  new Http2PreparedHeaders(env, args.This(), args[0].As<Array>());
 }
 
 Origins::Origins(Isolate* isolate,
@@ -595,6 +669,7 @@ Http2Session::~Http2Session() {
   CHECK_EQ(flags_ & SESSION_STATE_HAS_SCOPE, 0);
   Debug(this, "freeing nghttp2 session");
   nghttp2_session_del(session_);
+  env()->AdjustExternalMemory(-static_cast<int64_t>(stream_buf_external_));
   CHECK_EQ(current_nghttp2_memory_, 0);
   HandleScope handle_scope(env()->isolate());
   // Detach js_fields_ab_ to avoid having problem when new Http2Session
@@ -747,6 +822,27 @@ inline bool Http2Session::CanAddStream() {
          IsAvailableSessionMemory(sizeof(Http2Stream));
 }
 
+// Hands out a header block vector for an incoming HEADERS/CONTINUATION
+// sequence, preferring one whose capacity was already grown by an earlier
+// request on this session. Header-heavy workloads (e.g. gRPC) hit this for
+// every request, so avoiding the per-block allocation matters.
+std::vector<nghttp2_header> Http2Session::AcquireHeaderBlock() {
+  if (header_block_pool_.empty())
+    return std::vector<nghttp2_header>();
+  std::vector<nghttp2_header> block = std::move(header_block_pool_.back());
+  header_block_pool_.pop_back();
+  return block;
+}
+
+// Returns a drained header block vector to the pool so its capacity can be
+// reused. The pool is capped; anything beyond that is simply freed.
+void Http2Session::ReleaseHeaderBlock(std::vector<nghttp2_header>&& block) {
+  if (header_block_pool_.size() >= MAX_HEADER_BLOCK_POOL_SIZE)
+    return;
+  block.clear();
+  header_block_pool_.emplace_back(std::move(block));
+}
+
 inline void Http2Session::AddStream(Http2Stream* stream) {
   CHECK_GE(++statistics_.stream_count, 0);
   streams_[stream->id()] = stream;
@@ -801,6 +897,15 @@ ssize_t Http2Session::ConsumeHTTP2Data() {
   CHECK_LT(stream_buf_offset_, stream_buf_.len);
   size_t read_len = stream_buf_.len - stream_buf_offset_;
 
+  if (UNLIKELY(tracing::TraceCategoryState::Enabled(
+          tracing::TraceCategoryState::kNodeHttp2))) {
+    TRACE_EVENT_INSTANT1(TRACING_CATEGORY_NODE1(http2),
+                         "receive_data",
+                         TRACE_EVENT_SCOPE_THREAD,
+                         "read_len",
+                         static_cast<int64_t>(read_len));
+  }
+
   // multiple side effects.
   Debug(this, "receiving %d bytes [wants data? %d]",
         read_len,
@@ -830,6 +935,8 @@ ssize_t Http2Session::ConsumeHTTP2Data() {
   DecrementCurrentSessionMemory(stream_buf_.len);
   stream_buf_offset_ = 0;
   stream_buf_ab_.Reset();
+  env()->AdjustExternalMemory(-static_cast<int64_t>(stream_buf_external_));
+  stream_buf_external_ = 0;
   stream_buf_allocation_.clear();
   stream_buf_ = uv_buf_init(nullptr, 0);
 
@@ -1136,13 +1243,22 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
     len -= avail;
     stream->EmitRead(avail, buf);
 
-    // If the stream owner (e.g. the JS Http2Stream) wants more data, just
-    // tell nghttp2 that all data has been consumed. Otherwise, defer until
-    // more data is being requested.
-    if (stream->IsReading())
-      nghttp2_session_consume_stream(handle, id, avail);
-    else
+    // If the stream owner (e.g. the JS Http2Stream) wants more data, tell
+    // nghttp2 that the data has been consumed. Otherwise, defer until more
+    // data is being requested. Under session memory pressure only part of
+    // the chunk is acknowledged right away; the remainder is parked with
+    // the paused-read credit and handed back by ReleaseWithheldCredit()
+    // once the pressure subsides.
+    if (stream->IsReading()) {
+      size_t grant = session->GradedFlowControlGrant(avail);
+      nghttp2_session_consume_stream(handle, id, grant);
+      if (grant < static_cast<size_t>(avail)) {
+        stream->inbound_consumed_data_while_paused_ += avail - grant;
+        session->flags_ |= SESSION_STATE_HAS_WITHHELD_CREDIT;
+      }
+    } else {
       stream->inbound_consumed_data_while_paused_ += avail;
+    }
 
     // If we have a gathered a lot of data for output, try sending it now.
     if (session->outgoing_length_ > 4096 ||
@@ -1232,6 +1348,11 @@ void Http2StreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   Local<ArrayBuffer> ab;
   if (session->stream_buf_ab_.IsEmpty()) {
     ab = session->stream_buf_allocation_.ToArrayBuffer();
+    // Ownership moved into the ArrayBuffer's backing store, which V8
+    // accounts for by itself.
+    env->AdjustExternalMemory(
+        -static_cast<int64_t>(session->stream_buf_external_));
+    session->stream_buf_external_ = 0;
     session->stream_buf_ab_.Reset(env->isolate(), ab);
   } else {
     ab = PersistentToLocal::Strong(session->stream_buf_ab_);
@@ -1280,7 +1401,7 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
   // this way for performance reasons (it's faster to generate and pass an
   // array than it is to generate and pass the object).
   size_t headers_size = headers.size();
-  std::vector<Local<Value>> headers_v(headers_size * 2);
+  MaybeStackBuffer<Local<Value>, 64> headers_v(headers_size * 2);
   for (size_t i = 0; i < headers_size; ++i) {
     const nghttp2_header& item = headers[i];
     // The header name and value are passed as external one-byte strings
@@ -1290,12 +1411,17 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
         ExternalHeader::New<false>(this, item.value).ToLocalChecked();
   }
 
+  // The rcbuf references have been handed off to the external strings;
+  // recycle the emptied block so the next request can reuse its capacity.
+  headers.clear();
+  ReleaseHeaderBlock(std::move(headers));
+
   Local<Value> args[5] = {
       stream->object(),
       Integer::New(isolate, id),
       Integer::New(isolate, stream->headers_category()),
       Integer::New(isolate, frame->hd.flags),
-      Array::New(isolate, headers_v.data(), headers_size * 2)};
+      Array::New(isolate, headers_v.out(), headers_size * 2)};
   MakeCallback(env()->http2session_on_headers_function(),
                arraysize(args), args);
 }
@@ -1611,9 +1737,54 @@ void Http2Session::ClearOutgoing(int status) {
         stream->FlushRstStream();
     }
   }
+
+  // Finished writes release session memory, so this is a natural point to
+  // hand back any flow-control credit withheld under memory pressure.
+  ReleaseWithheldCredit();
+}
+
+// Hands back stream window credit that GradedFlowControlGrant() withheld
+// while the session was above its soft memory watermarks. The credit is
+// parked on each stream alongside the paused-read credit, so a stream that
+// resumes reading via ReadStart() returns it on its own; this path covers
+// streams that kept reading the whole time.
+void Http2Session::ReleaseWithheldCredit() {
+  if (!(flags_ & SESSION_STATE_HAS_WITHHELD_CREDIT))
+    return;
+  if (GetCurrentSessionMemory() >=
+      max_session_memory_ * SESSION_MEMORY_WATERMARK_LOW) {
+    return;
+  }
+  Debug(this, "releasing withheld flow-control credit");
+  flags_ &= ~SESSION_STATE_HAS_WITHHELD_CREDIT;
+  for (const auto& s : streams_) {
+    Http2Stream* stream = s.second;
+    if (stream->IsDestroyed() || !stream->IsReading())
+      continue;
+    if (stream->inbound_consumed_data_while_paused_ > 0) {
+      nghttp2_session_consume_stream(
+          session_,
+          stream->id(),
+          stream->inbound_consumed_data_while_paused_);
+      stream->inbound_consumed_data_while_paused_ = 0;
+    }
+  }
 }
 
 void Http2Session::PushOutgoingBuffer(nghttp2_stream_write&& write) {
+  // Copy small chunks into the session's own storage. Bytes in the storage
+  // arena are contiguous in queue order, so runs of such chunks (e.g. frame
+  // header, padding and a small DATA payload, across many streams) are
+  // merged into single iovec entries when the batch is written out. Large
+  // payloads stay zero-copy. The write itself is kept as a separate entry
+  // either way since it may carry a WriteWrap that has to be completed.
+  if (write.buf.base != nullptr &&
+      write.buf.len <= OUTGOING_COALESCE_THRESHOLD) {
+    size_t offset = outgoing_storage_.size();
+    outgoing_storage_.resize(offset + write.buf.len);
+    memcpy(&outgoing_storage_[offset], write.buf.base, write.buf.len);
+    write.buf.base = nullptr;
+  }
   outgoing_length_ += write.buf.len;
   outgoing_buffers_.emplace_back(std::move(write));
 }
@@ -1635,6 +1806,60 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
   });
 }
 
+// Admits up to `amount` bytes of DATA for `stream` in the current send
+// batch under weighted deficit round robin. Each participating stream gets
+// a per-round byte budget proportional to its priority weight (as set by
+// priority frames); once that budget is spent, the stream's data provider
+// is deferred until the next batch so a single large stream cannot starve
+// the other streams multiplexed on the session. Returns the number of
+// admitted bytes; 0 means the stream was deferred for this round.
+size_t Http2Session::DRRAdmit(Http2Stream* stream, size_t amount) {
+  if (!stream->drr_in_round_) {
+    nghttp2_stream* str = **stream;
+    int32_t weight =
+        str == nullptr ? NGHTTP2_DEFAULT_WEIGHT : nghttp2_stream_get_weight(str);
+    if (weight < NGHTTP2_MIN_WEIGHT)
+      weight = NGHTTP2_MIN_WEIGHT;
+    stream->drr_in_round_ = true;
+    stream->drr_deficit_ = static_cast<int64_t>(weight) * DRR_QUANTUM_PER_WEIGHT;
+    drr_round_streams_.push_back(stream->id());
+  }
+
+  if (stream->drr_deficit_ <= 0) {
+    stream->drr_deferred_ = true;
+    stream->drr_deferrals_++;
+    return 0;
+  }
+
+  if (static_cast<int64_t>(amount) > stream->drr_deficit_)
+    amount = static_cast<size_t>(stream->drr_deficit_);
+  stream->drr_deficit_ -= amount;
+  stream->drr_sent_bytes_ += amount;
+  return amount;
+}
+
+// Closes out a round of the deficit-round-robin scheduler: every stream
+// that participated starts the next batch with a fresh budget, and streams
+// that were deferred are resumed so that nghttp2 asks their providers for
+// data again.
+void Http2Session::DRRStartRound() {
+  if (drr_round_streams_.empty())
+    return;
+
+  std::vector<int32_t> round;
+  round.swap(drr_round_streams_);
+  for (int32_t id : round) {
+    Http2Stream* stream = FindStream(id);
+    if (stream == nullptr)
+      continue;
+    stream->drr_in_round_ = false;
+    if (stream->drr_deferred_) {
+      stream->drr_deferred_ = false;
+      CHECK_NE(nghttp2_session_resume_data(session_, id), NGHTTP2_ERR_NOMEM);
+    }
+  }
+}
+
 // Prompts nghttp2 to begin serializing it's pending data and pushes each
 // chunk out to the i/o socket to be sent. This is a particularly hot method
 // that will generally be called at least twice be event loop iteration.
@@ -1666,6 +1891,11 @@ uint8_t Http2Session::SendPendingData() {
   while ((src_length = nghttp2_session_mem_send(session_, &src)) > 0) {
     Debug(this, "nghttp2 has %d bytes to send", src_length);
     CopyDataIntoOutgoing(src, src_length);
+    if (outgoing_length_ >= OUTGOING_HIGH_WATER_MARK) {
+      // Enough for one batch; flush now and leave the rest for the next
+      // write, which is scheduled below once this one has been submitted.
+      break;
+    }
   }
 
   CHECK_NE(src_length, NGHTTP2_ERR_NOMEM);
@@ -1683,6 +1913,11 @@ uint8_t Http2Session::SendPendingData() {
   size_t count = outgoing_buffers_.size();
   if (count == 0) {
     ClearOutgoing(0);
+    // Deferred streams may have been the only source of data; give them a
+    // fresh round and schedule the write that will carry it.
+    DRRStartRound();
+    if (!(flags_ & SESSION_STATE_WRITE_SCHEDULED))
+      MaybeScheduleWrite();
     return 0;
   }
   MaybeStackBuffer<uv_buf_t, 32> bufs;
@@ -1693,17 +1928,27 @@ uint8_t Http2Session::SendPendingData() {
   // (Those are marked by having .base == nullptr.)
   size_t offset = 0;
   size_t i = 0;
-  for (const nghttp2_stream_write& write : outgoing_buffers_) {
+  for (size_t j = 0; j < count; j++) {
+    const nghttp2_stream_write& write = outgoing_buffers_[j];
     statistics_.data_sent += write.buf.len;
     if (write.buf.base == nullptr) {
+      // Merge the whole run of storage-backed chunks into one iovec entry;
+      // their bytes are already laid out back-to-back in the arena.
+      size_t run = write.buf.len;
+      while (j + 1 < count && outgoing_buffers_[j + 1].buf.base == nullptr) {
+        j++;
+        statistics_.data_sent += outgoing_buffers_[j].buf.len;
+        run += outgoing_buffers_[j].buf.len;
+      }
       bufs[i++] = uv_buf_init(
           reinterpret_cast<char*>(outgoing_storage_.data() + offset),
-          write.buf.len);
-      offset += write.buf.len;
+          run);
+      offset += run;
     } else {
       bufs[i++] = write.buf;
     }
   }
+  count = i;
 
   chunks_sent_since_last_write_++;
 
@@ -1717,6 +1962,17 @@ uint8_t Http2Session::SendPendingData() {
 
   MaybeStopReading();
 
+  // The batch is complete; replenish round-robin budgets and resume streams
+  // that were deferred so the next batch picks them up.
+  DRRStartRound();
+
+  // If the batch was capped by the high-water mark or streams were deferred
+  // and the write completed synchronously, nghttp2 may still have data
+  // pending; asynchronous writes are rescheduled from OnStreamAfterWrite()
+  // instead.
+  if (!res.async && !(flags_ & SESSION_STATE_WRITE_SCHEDULED))
+    MaybeScheduleWrite();
+
   return 0;
 }
 
@@ -1854,6 +2110,12 @@ void Http2Session::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   // to copy memory.
   stream_buf_allocation_ = std::move(buf);
 
+  // Until this allocation is released (or handed over to an ArrayBuffer),
+  // it is native memory that V8 cannot see; report it so the collector
+  // schedules with the real external footprint in view.
+  stream_buf_external_ = stream_buf_allocation_.size();
+  env()->AdjustExternalMemory(static_cast<int64_t>(stream_buf_external_));
+
   ssize_t ret = ConsumeHTTP2Data();
 
   if (UNLIKELY(ret < 0)) {
@@ -1917,7 +2179,9 @@ Http2Stream::Http2Stream(Http2Session* session,
   if (max_header_pairs_ == 0) {
     max_header_pairs_ = DEFAULT_MAX_HEADER_LIST_PAIRS;
   }
-  current_headers_.reserve(std::min(max_header_pairs_, 12u));
+  current_headers_ = session->AcquireHeaderBlock();
+  if (current_headers_.capacity() == 0)
+    current_headers_.reserve(std::min(max_header_pairs_, 12u));
 
   // Limit the number of header octets
   max_header_length_ =
@@ -1935,6 +2199,7 @@ Http2Stream::Http2Stream(Http2Session* session,
   if (options & STREAM_OPTION_EMPTY_PAYLOAD)
     Shutdown();
   session->AddStream(this);
+  dtrace_http2_stream_open(session, id);
 }
 
 
@@ -1948,6 +2213,7 @@ Http2Stream::~Http2Stream() {
     return;
   Debug(this, "tearing down stream");
   session_->DecrementCurrentSessionMemory(current_headers_length_);
+  session_->ReleaseHeaderBlock(std::move(current_headers_));
   session_->RemoveStream(this);
 }
 
@@ -1976,6 +2242,7 @@ void Http2Stream::Close(int32_t code) {
   CHECK(!this->IsDestroyed());
   flags_ |= NGHTTP2_STREAM_FLAG_CLOSED;
   code_ = code;
+  dtrace_http2_stream_close(session_.get(), id_, code);
   Debug(this, "closed with code %d", code);
 }
 
@@ -2056,6 +2323,32 @@ int Http2Stream::SubmitResponse(nghttp2_nv* nva, size_t len, int options) {
 }
 
 
+// Initiates a response on the Http2Stream whose payload is read straight
+// from a file descriptor by Provider::FD::OnRead. The payload bytes never
+// cross into JS, so there is no per-chunk Buffer allocation or write() call.
+int Http2Stream::SubmitFileResponse(int fd,
+                                    nghttp2_nv* nva,
+                                    size_t len,
+                                    int64_t offset,
+                                    int64_t length,
+                                    int options) {
+  CHECK(!this->IsDestroyed());
+  Http2Scope h2scope(this);
+  Debug(this, "submitting file response");
+  if (options & STREAM_OPTION_GET_TRAILERS)
+    flags_ |= NGHTTP2_STREAM_FLAG_TRAILERS;
+
+  fd_ = fd;
+  fd_offset_ = offset;
+  fd_length_ = length;
+
+  Http2Stream::Provider::FD prov(this, options);
+  int ret = nghttp2_submit_response(**session_, id_, nva, len, *prov);
+  CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
+  return ret;
+}
+
+
 // Submit informational headers for a stream.
 int Http2Stream::SubmitInfo(nghttp2_nv* nva, size_t len) {
   CHECK(!this->IsDestroyed());
@@ -2319,6 +2612,12 @@ ssize_t Http2Stream::Provider::Stream::OnRead(nghttp2_session* handle,
     amount = std::min(stream->available_outbound_length_, length);
     Debug(session, "sending %d bytes for data frame on stream %d", amount, id);
     if (amount > 0) {
+      amount = session->DRRAdmit(stream, amount);
+      if (amount == 0) {
+        // Round budget exhausted; the stream is resumed with the next batch.
+        Debug(session, "stream %d spent its round budget, deferring", id);
+        return NGHTTP2_ERR_DEFERRED;
+      }
       // Just return the length, let Http2Session::OnSendData take care of
       // actually taking the buffers out of the queue.
       *flags |= NGHTTP2_DATA_FLAG_NO_COPY;
@@ -2350,6 +2649,78 @@ ssize_t Http2Stream::Provider::Stream::OnRead(nghttp2_session* handle,
   return amount;
 }
 
+// The FD Provider reads the payload straight out of a file descriptor into
+// the frame assembly buffer nghttp2 hands us, so each DATA frame costs a
+// single read(2) and nothing else.
+Http2Stream::Provider::FD::FD(Http2Stream* stream, int options)
+    : Http2Stream::Provider(stream, options) {
+  provider_.read_callback = Http2Stream::Provider::FD::OnRead;
+}
+
+ssize_t Http2Stream::Provider::FD::OnRead(nghttp2_session* handle,
+                                          int32_t id,
+                                          uint8_t* buf,
+                                          size_t length,
+                                          uint32_t* flags,
+                                          nghttp2_data_source* source,
+                                          void* user_data) {
+  Http2Session* session = static_cast<Http2Session*>(user_data);
+  Debug(session, "reading file data for stream %d", id);
+  Http2Stream* stream = GetStream(session, id, source);
+  if (stream->statistics_.first_byte_sent == 0)
+    stream->statistics_.first_byte_sent = uv_hrtime();
+  CHECK_EQ(id, stream->id());
+
+  int64_t remaining = stream->fd_length_;  // -1 means "until EOF"
+  if (remaining >= 0 && static_cast<int64_t>(length) > remaining)
+    length = static_cast<size_t>(remaining);
+
+  size_t amount = 0;
+  if (length > 0) {
+    amount = session->DRRAdmit(stream, length);
+    if (amount == 0) {
+      // Round budget exhausted; the stream is resumed with the next batch.
+      Debug(session, "stream %d spent its round budget, deferring", id);
+      return NGHTTP2_ERR_DEFERRED;
+    }
+
+    uv_buf_t data = uv_buf_init(reinterpret_cast<char*>(buf), amount);
+    uv_fs_t read_req;
+    const int r = uv_fs_read(stream->env()->event_loop(),
+                             &read_req,
+                             stream->fd_,
+                             &data, 1,
+                             stream->fd_offset_,
+                             nullptr);
+    uv_fs_req_cleanup(&read_req);
+
+    if (r < 0) {
+      Debug(session, "file read failed for stream %d: %s",
+            id, uv_strerror(r));
+      return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+    }
+
+    amount = static_cast<size_t>(r);
+    stream->fd_offset_ += amount;
+    if (stream->fd_length_ > 0)
+      stream->fd_length_ -= amount;
+  }
+
+  // EOF is reached when the requested range has been fully sent or when the
+  // file itself runs out of bytes, whichever happens first.
+  if (stream->fd_length_ == 0 || amount == 0) {
+    Debug(session, "no more file data for stream %d", id);
+    *flags |= NGHTTP2_DATA_FLAG_EOF;
+    if (stream->HasTrailers()) {
+      *flags |= NGHTTP2_DATA_FLAG_NO_END_STREAM;
+      stream->OnTrailers();
+    }
+  }
+
+  stream->statistics_.sent_bytes += amount;
+  return amount;
+}
+
 inline void Http2Stream::IncrementAvailableOutboundLength(size_t amount) {
   available_outbound_length_ += amount;
   session_->IncrementCurrentSessionMemory(amount);
@@ -2615,6 +2986,31 @@ void Http2Stream::Respond(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Initiates a response on the Http2Stream whose payload is streamed straight
+// out of a file descriptor by the native data provider. The fd stays owned
+// by the caller and must outlive the stream.
+void Http2Stream::RespondFd(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+  Isolate* isolate = env->isolate();
+  Http2Stream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+
+  int fd = static_cast<int>(args[0]->IntegerValue(context).ToChecked());
+  Local<Array> headers = args[1].As<Array>();
+  int64_t offset = args[2]->IntegerValue(context).ToChecked();
+  int64_t length = args[3]->IntegerValue(context).ToChecked();
+  int options = args[4]->IntegerValue(context).ToChecked();
+
+  Headers list(isolate, context, headers);
+
+  args.GetReturnValue().Set(
+      stream->SubmitFileResponse(fd, *list, list.length(),
+                                 offset, length, options));
+  Debug(stream, "file response submitted");
+}
+
+
 // Submits informational headers on the Http2Stream
 void Http2Stream::Info(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -2714,6 +3110,11 @@ void Http2Stream::RefreshState(const FunctionCallbackInfo<Value>& args) {
   nghttp2_stream* str = **stream;
   nghttp2_session* s = **(stream->session());
 
+  buffer[IDX_STREAM_STATE_DRR_SENT_BYTES] =
+      static_cast<double>(stream->drr_sent_bytes_);
+  buffer[IDX_STREAM_STATE_DRR_DEFERRALS] =
+      static_cast<double>(stream->drr_deferrals_);
+
   if (str == nullptr) {
     buffer[IDX_STREAM_STATE] = NGHTTP2_STREAM_STATE_IDLE;
     buffer[IDX_STREAM_STATE_WEIGHT] =
@@ -3057,6 +3458,7 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(stream, "info", Http2Stream::Info);
   env->SetProtoMethod(stream, "trailers", Http2Stream::Trailers);
   env->SetProtoMethod(stream, "respond", Http2Stream::Respond);
+  env->SetProtoMethod(stream, "respondFd", Http2Stream::RespondFd);
   env->SetProtoMethod(stream, "rstStream", Http2Stream::RstStream);
   env->SetProtoMethod(stream, "refreshState", Http2Stream::RefreshState);
   stream->Inherit(AsyncWrap::GetConstructorTemplate(env));
@@ -3096,6 +3498,15 @@ void Initialize(Local<Object> target,
               http2SessionClassName,
               session->GetFunction(env->context()).ToLocalChecked()).Check();
 
+  Local<FunctionTemplate> prepared =
+      env->NewFunctionTemplate(Http2PreparedHeaders::New);
+  prepared->SetClassName(
+      FIXED_ONE_BYTE_STRING(env->isolate(), "PreparedHeaders"));
+  prepared->InstanceTemplate()->SetInternalFieldCount(1);
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "PreparedHeaders"),
+              prepared->GetFunction(env->context()).ToLocalChecked()).Check();
+
   Local<Object> constants = Object::New(isolate);
   Local<Array> name_for_error_code = Array::New(isolate);
 
@@ -23,6 +23,7 @@ using v8::Array;
 using v8::Context;
 using v8::Isolate;
 using v8::MaybeLocal;
+using v8::Value;
 
 using performance::PerformanceEntry;
 
@@ -38,6 +39,32 @@ using performance::PerformanceEntry;
 // Default maximum total memory cap for Http2Session.
 #define DEFAULT_MAX_SESSION_MEMORY 1e7
 
+// Outbound chunks no larger than this are copied into the session's own
+// storage when queued, so that neighbouring small frames can be merged into
+// a single iovec entry instead of producing one sub-MTU entry per frame.
+#define OUTGOING_COALESCE_THRESHOLD 1024
+
+// Stop gathering data from nghttp2 and flush to the socket once this much
+// outbound data has accumulated in a single batch; the remainder is picked
+// up by the next scheduled write.
+#define OUTGOING_HIGH_WATER_MARK (512 * 1024)
+
+// Per-round outbound DATA budget per unit of priority weight. With nghttp2
+// weights ranging from 1 to 256, a default-weight (16) stream may send up to
+// 16KB of DATA per send batch before it is deferred behind its peers.
+#define DRR_QUANTUM_PER_WEIGHT 1024
+
+// Soft watermarks, expressed as fractions of the maximum session memory, at
+// which graduated backpressure starts shrinking the stream window updates
+// sent back to the peer. See Http2Session::GradedFlowControlGrant().
+#define SESSION_MEMORY_WATERMARK_LOW 0.50
+#define SESSION_MEMORY_WATERMARK_HIGH 0.75
+#define SESSION_MEMORY_WATERMARK_CRITICAL 0.90
+
+// Maximum number of retired header block vectors kept around per session
+// for capacity reuse. See Http2Session::AcquireHeaderBlock().
+#define MAX_HEADER_BLOCK_POOL_SIZE 8
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 #define DEFAULT_SETTINGS_HEADER_TABLE_SIZE 4096
 #define DEFAULT_SETTINGS_ENABLE_PUSH 1
@@ -338,7 +365,8 @@ enum session_state_flags {
   SESSION_STATE_SENDING = 0x10,
   SESSION_STATE_WRITE_IN_PROGRESS = 0x20,
   SESSION_STATE_READING_STOPPED = 0x40,
-  SESSION_STATE_NGHTTP2_RECV_PAUSED = 0x80
+  SESSION_STATE_NGHTTP2_RECV_PAUSED = 0x80,
+  SESSION_STATE_HAS_WITHHELD_CREDIT = 0x100
 };
 
 typedef uint32_t(*get_setting)(nghttp2_session* session,
@@ -477,6 +505,16 @@ class Http2Stream : public AsyncWrap,
   // Initiate a response on this stream.
   int SubmitResponse(nghttp2_nv* nva, size_t len, int options);
 
+  // Initiate a response on this stream whose DATA payload is read directly
+  // from a file descriptor, bypassing the JS streams layer entirely. A
+  // length of -1 means "until EOF".
+  int SubmitFileResponse(int fd,
+                         nghttp2_nv* nva,
+                         size_t len,
+                         int64_t offset,
+                         int64_t length,
+                         int options);
+
   // Submit informational headers for this stream
   int SubmitInfo(nghttp2_nv* nva, size_t len);
 
@@ -588,6 +626,7 @@ class Http2Stream : public AsyncWrap,
   static void Info(const FunctionCallbackInfo<Value>& args);
   static void Trailers(const FunctionCallbackInfo<Value>& args);
   static void Respond(const FunctionCallbackInfo<Value>& args);
+  static void RespondFd(const FunctionCallbackInfo<Value>& args);
   static void RstStream(const FunctionCallbackInfo<Value>& args);
 
   class Provider;
@@ -637,6 +676,22 @@ class Http2Stream : public AsyncWrap,
   std::queue<nghttp2_stream_write> queue_;
   size_t available_outbound_length_ = 0;
 
+  // File-backed response state, used by Provider::FD when the payload is
+  // served straight from a file descriptor. The fd is owned by the caller;
+  // it must remain open until the stream finishes.
+  int fd_ = -1;
+  int64_t fd_offset_ = 0;
+  int64_t fd_length_ = -1;
+
+  // Weighted deficit-round-robin state for outbound DATA scheduling, see
+  // Http2Session::DRRAdmit(). The counters are surfaced through
+  // refreshState() so fairness can be verified under load.
+  int64_t drr_deficit_ = 0;
+  bool drr_in_round_ = false;
+  bool drr_deferred_ = false;
+  uint64_t drr_sent_bytes_ = 0;
+  uint64_t drr_deferrals_ = 0;
+
   Http2StreamListener stream_listener_;
 
   friend class Http2Session;
@@ -675,6 +730,22 @@ class Http2Stream::Provider::Stream : public Http2Stream::Provider {
                         void* user_data);
 };
 
+// A data provider that reads the DATA payload straight from a file
+// descriptor into nghttp2's frame assembly buffer, so file contents never
+// pass through the JS stream machinery. See Http2Stream::SubmitFileResponse.
+class Http2Stream::Provider::FD : public Http2Stream::Provider {
+ public:
+  FD(Http2Stream* stream, int options);
+
+  static ssize_t OnRead(nghttp2_session* session,
+                        int32_t id,
+                        uint8_t* buf,
+                        size_t length,
+                        uint32_t* flags,
+                        nghttp2_data_source* source,
+                        void* user_data);
+};
+
 typedef struct {
   uint8_t bitfield;
   uint8_t priority_listener_count;
@@ -737,6 +808,13 @@ class Http2Session : public AsyncWrap,
 
   uint8_t SendPendingData();
 
+  // Weighted deficit-round-robin scheduling of outbound DATA across the
+  // session's streams; one round corresponds to one send batch. DRRAdmit()
+  // is consulted by the stream data provider, DRRStartRound() runs once a
+  // batch has been handed to the underlying stream.
+  size_t DRRAdmit(Http2Stream* stream, size_t amount);
+  void DRRStartRound();
+
   // Submits a new request. If the request is a success, assigned
   // will be a pointer to the Http2Stream instance assigned.
   // This only works if the session is a client session.
@@ -862,6 +940,13 @@ class Http2Session : public AsyncWrap,
   // this session now, and may outlive it.
   void StopTrackingRcbuf(nghttp2_rcbuf* buf);
 
+  // Header block vectors are pooled per session so that the backing
+  // nghttp2_header arrays (which hold the rcbuf references for a
+  // HEADERS/CONTINUATION sequence) reuse their capacity across requests
+  // instead of being reallocated for every header block.
+  std::vector<nghttp2_header> AcquireHeaderBlock();
+  void ReleaseHeaderBlock(std::vector<nghttp2_header>&& block);
+
   // Returns the current session memory including memory allocated by nghttp2,
   // the current outbound storage queue, and pending writes.
   uint64_t GetCurrentSessionMemory() {
@@ -876,6 +961,31 @@ class Http2Session : public AsyncWrap,
     return GetCurrentSessionMemory() + amount <= max_session_memory_;
   }
 
+  // Returns how much of a just-received chunk should be acknowledged to the
+  // peer right away via a stream window update. Crossing the soft memory
+  // watermarks progressively halves the grant, so a session under memory
+  // pressure slows its peer down gradually instead of stopping reads
+  // outright. Withheld credit is returned by ReleaseWithheldCredit() once
+  // the pressure subsides.
+  size_t GradedFlowControlGrant(size_t consumed) {
+    uint64_t used = GetCurrentSessionMemory();
+    if (used < max_session_memory_ * SESSION_MEMORY_WATERMARK_LOW)
+      return consumed;
+    size_t shift = 1;
+    if (used >= max_session_memory_ * SESSION_MEMORY_WATERMARK_CRITICAL)
+      shift = 3;
+    else if (used >= max_session_memory_ * SESSION_MEMORY_WATERMARK_HIGH)
+      shift = 2;
+    // Never shrink the grant to zero; the point of the graduated scheme is
+    // to slow the peer down, not to stall it.
+    return std::max(static_cast<size_t>(1), consumed >> shift);
+  }
+
+  // Returns any stream window credit withheld by GradedFlowControlGrant()
+  // back to the peer once session memory has dropped below the lowest
+  // watermark again.
+  void ReleaseWithheldCredit();
+
   struct Statistics {
     uint64_t start_time;
     uint64_t end_time;
@@ -1021,6 +1131,10 @@ class Http2Session : public AsyncWrap,
   v8::Global<v8::ArrayBuffer> stream_buf_ab_;
   AllocatedBuffer stream_buf_allocation_;
   size_t stream_buf_offset_ = 0;
+  // Bytes of stream_buf_allocation_ currently reported to V8 as external
+  // memory; zeroed once the allocation is either released or handed over to
+  // an ArrayBuffer (whose backing store V8 accounts for itself).
+  size_t stream_buf_external_ = 0;
 
   size_t max_outstanding_pings_ = DEFAULT_MAX_PINGS;
   std::queue<BaseObjectPtr<Http2Ping>> outstanding_pings_;
@@ -1044,6 +1158,13 @@ class Http2Session : public AsyncWrap,
   void CopyDataIntoOutgoing(const uint8_t* src, size_t src_length);
   void ClearOutgoing(int status);
 
+  // Streams that took part in the current scheduling round, by id. See
+  // DRRAdmit().
+  std::vector<int32_t> drr_round_streams_;
+
+  // Retired header block vectors waiting for reuse. See AcquireHeaderBlock().
+  std::vector<std::vector<nghttp2_header>> header_block_pool_;
+
   friend class Http2Scope;
   friend class Http2StreamListener;
 };
@@ -1260,13 +1381,44 @@ class ExternalHeader :
   nghttp2_vec vec_;
 };
 
+// A header list converted into nghttp2_nv form once, to be reused across
+// many submissions. Reconnecting clients with a fixed header vocabulary
+// create one of these up front so that each request skips the per-call
+// conversion of the same JS strings. The nghttp2_nv entries point into
+// storage owned by this object; nghttp2 copies what it needs on submit.
+class Http2PreparedHeaders : public BaseObject {
+ public:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  nghttp2_nv* nva() { return nva_; }
+  size_t length() const { return count_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("storage", storage_.size());
+  }
+  SET_MEMORY_INFO_NAME(Http2PreparedHeaders)
+  SET_SELF_SIZE(Http2PreparedHeaders)
+
+ private:
+  Http2PreparedHeaders(Environment* env,
+                       Local<v8::Object> wrap,
+                       Local<Array> headers);
+
+  std::vector<char> storage_;
+  nghttp2_nv* nva_ = nullptr;
+  size_t count_ = 0;
+};
+
 class Headers {
  public:
-  Headers(Isolate* isolate, Local<Context> context, Local<Array> headers);
+  // `headers` is either the usual [header string, count] array or an
+  // Http2PreparedHeaders object, in which case its converted block is used
+  // directly.
+  Headers(Isolate* isolate, Local<Context> context, Local<Value> headers);
   ~Headers() = default;
 
   nghttp2_nv* operator*() {
-    return reinterpret_cast<nghttp2_nv*>(*buf_);
+    return nva_;
   }
 
   size_t length() const {
@@ -1275,6 +1427,7 @@ class Headers {
 
  private:
   size_t count_;
+  nghttp2_nv* nva_ = nullptr;
   MaybeStackBuffer<char, 3000> buf_;
 };
 
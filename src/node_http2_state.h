@@ -39,6 +39,8 @@ namespace http2 {
     IDX_STREAM_STATE_LOCAL_CLOSE,
     IDX_STREAM_STATE_REMOTE_CLOSE,
     IDX_STREAM_STATE_LOCAL_WINDOW_SIZE,
+    IDX_STREAM_STATE_DRR_SENT_BYTES,
+    IDX_STREAM_STATE_DRR_DEFERRALS,
     IDX_STREAM_STATE_COUNT
   };
 
@@ -23,6 +23,7 @@
 #include "node_buffer.h"
 #include "util.h"
 
+#include "aliased_buffer.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
@@ -32,6 +33,7 @@
 
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -77,6 +79,18 @@ const uint32_t kOnExecute = 4;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
 
+// Layout of the packed headers table, see Parser::EnablePackedHeaders().
+// Offsets and lengths are relative to the buffer passed to execute().
+enum packed_headers_index {
+  kPackedValid = 0,    // 1 if the last headers-complete event was packed
+  kPackedNumHeaders,
+  kPackedUrlOffset,
+  kPackedUrlLength,
+  kPackedHeadersStart  // per header: field off/len, value off/len
+};
+const size_t kPackedHeadersLength =
+    kPackedHeadersStart + kMaxHeaderFieldsCount * 4;
+
 // helper class for the Parser
 struct StringPtr {
   StringPtr() {
@@ -143,6 +157,17 @@ struct StringPtr {
   }
 
 
+  // Like ToString(), but goes through the per-Environment intern table.
+  // Used for header names and values, which mostly repeat across requests;
+  // high-cardinality strings like URLs should keep using ToString().
+  Local<String> ToInternedString(Environment* env) const {
+    if (str_)
+      return env->InternHTTPHeaderString(str_, size_);
+    else
+      return String::Empty(env->isolate());
+  }
+
+
   const char* str_;
   bool on_heap_;
   size_t size_;
@@ -159,6 +184,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("current_buffer", current_buffer_);
+    tracker->TrackField("gathered_body", gathered_body_);
   }
 
   SET_MEMORY_INFO_NAME(Parser)
@@ -273,9 +299,16 @@ class Parser : public AsyncWrap, public StreamListener {
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
 
+    if (packed_headers_)
+      (*packed_headers_)[kPackedValid] = 0;
+
     if (have_flushed_) {
       // Slow case, flush remaining headers.
       Flush();
+    } else if (TryPackHeaders()) {
+      // Fastest case, the headers stayed in the socket slab; JS reads them
+      // from the packed offset table on demand. A_HEADERS and A_URL remain
+      // undefined.
     } else {
       // Fast case, pass headers and URL to JS land.
       argv[A_HEADERS] = CreateHeaders();
@@ -328,11 +361,34 @@ class Parser : public AsyncWrap, public StreamListener {
       return -1;
     }
 
+    // Whole-body gathering only applies to messages with a known, small
+    // Content-Length that are going to be parsed normally; chunked,
+    // upgraded, skipped and oversized bodies keep the per-segment path.
+    gathering_body_ =
+        gather_body_limit_ > 0 &&
+        val == 0 &&
+        !parser_.upgrade &&
+        (parser_.flags & F_CONTENT_LENGTH) != 0 &&
+        (parser_.flags & F_CHUNKED) == 0 &&
+        parser_.content_length > 0 &&
+        parser_.content_length <= gather_body_limit_;
+    if (gathering_body_) {
+      gathered_body_.clear();
+      gathered_body_.reserve(parser_.content_length);
+    }
+
     return val;
   }
 
 
   int on_body(const char* at, size_t length) {
+    if (gathering_body_) {
+      // Accumulate natively; FlushGatheredBody() delivers the complete body
+      // to JS in one callback when the message ends.
+      gathered_body_.insert(gathered_body_.end(), at, at + length);
+      return 0;
+    }
+
     EscapableHandleScope scope(env()->isolate());
 
     Local<Object> obj = object();
@@ -373,6 +429,13 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_message_complete() {
     HandleScope scope(env()->isolate());
 
+    if (gathering_body_) {
+      gathering_body_ = false;
+      int rv = FlushGatheredBody();
+      if (rv != 0)
+        return rv;
+    }
+
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -491,7 +554,6 @@ class Parser : public AsyncWrap, public StreamListener {
     uint64_t max_http_header_size = 0;
 
     CHECK(args[0]->IsInt32());
-    CHECK(args[1]->IsObject());
 
     if (args.Length() > 2) {
       CHECK(args[2]->IsNumber());
@@ -516,7 +578,14 @@ class Parser : public AsyncWrap, public StreamListener {
             : AsyncWrap::PROVIDER_HTTPCLIENTREQUEST);
 
     parser->set_provider_type(provider);
-    parser->AsyncReset(args[1].As<Object>());
+    // JS passes null instead of an async resource when no async hooks are
+    // installed. In that case the recycled wrapper keeps its existing async
+    // identity instead of tearing it down and rebuilding it, which makes
+    // re-initializing a pooled parser allocation-free. llhttp settings are
+    // static and the header intern table is per-Environment, so neither has
+    // to be rebuilt either.
+    if (args[1]->IsObject())
+      parser->AsyncReset(args[1].As<Object>());
     parser->Init(type, max_http_header_size, lenient);
   }
 
@@ -575,6 +644,38 @@ class Parser : public AsyncWrap, public StreamListener {
     args.GetReturnValue().Set(ret);
   }
 
+
+  // enablePackedHeaders(): opt into packed header delivery and return the
+  // shared Uint32Array holding the offset table. When the kOnHeadersComplete
+  // callback fires with an undefined headers argument and slot 0 of the
+  // table is 1, the caller is expected to decode header slices out of the
+  // buffer it passed to execute(), using the packed offsets.
+  static void EnablePackedHeaders(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    Environment* env = Environment::GetCurrent(args);
+
+    if (!parser->packed_headers_) {
+      parser->packed_headers_ = std::make_unique<AliasedUint32Array>(
+          env->isolate(), kPackedHeadersLength);
+    }
+
+    args.GetReturnValue().Set(parser->packed_headers_->GetJSArray());
+  }
+
+
+  // gatherBody(limit): for messages with a known Content-Length of at most
+  // `limit` bytes, accumulate the body natively and invoke the kOnBody
+  // callback exactly once with the complete, right-sized buffer when the
+  // message ends, instead of once per TCP segment. Chunked, upgraded and
+  // larger bodies keep the per-segment path. Pass 0 to switch back off.
+  static void GatherBody(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    CHECK(args[0]->IsUint32());
+    parser->gather_body_limit_ = args[0].As<Uint32>()->Value();
+  }
+
  protected:
   static const size_t kAllocBufferSize = 64 * 1024;
 
@@ -729,8 +830,8 @@ class Parser : public AsyncWrap, public StreamListener {
     Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
 
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
-      headers_v[i * 2 + 1] = values_[i].ToString(env());
+      headers_v[i * 2] = fields_[i].ToInternedString(env());
+      headers_v[i * 2 + 1] = values_[i].ToInternedString(env());
     }
 
     return Array::New(env()->isolate(), headers_v, num_values_ * 2);
@@ -764,9 +865,56 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Delivers the body accumulated in whole-body gathering mode (see
+  // GatherBody()) as a single kOnBody callback.
+  int FlushGatheredBody() {
+    if (gathered_body_.empty())
+      return 0;
+
+    HandleScope scope(env()->isolate());
+
+    Local<Object> obj = object();
+    Local<Value> cb = obj->Get(env()->context(), kOnBody).ToLocalChecked();
+    if (!cb->IsFunction()) {
+      gathered_body_.clear();
+      return 0;
+    }
+
+    Local<Object> body;
+    if (!Buffer::Copy(env(),
+                      gathered_body_.data(),
+                      gathered_body_.size()).ToLocal(&body)) {
+      got_exception_ = true;
+      return -1;
+    }
+
+    Local<Value> argv[3] = {
+      body,
+      Integer::NewFromUnsigned(env()->isolate(), 0),
+      Integer::NewFromUnsigned(
+          env()->isolate(), static_cast<uint32_t>(gathered_body_.size()))
+    };
+
+    MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
+                                       arraysize(argv),
+                                       argv);
+    gathered_body_.clear();
+
+    if (r.IsEmpty()) {
+      got_exception_ = true;
+      llhttp_set_error_reason(&parser_, "HPE_JS_EXCEPTION:JS Exception");
+      return HPE_USER;
+    }
+
+    return 0;
+  }
+
+
   void Init(llhttp_type_t type, uint64_t max_http_header_size, bool lenient) {
     llhttp_init(&parser_, type, &settings);
     llhttp_set_lenient(&parser_, lenient);
+    gathering_body_ = false;
+    gathered_body_.clear();
     header_nread_ = 0;
     url_.Reset();
     status_message_.Reset();
@@ -788,6 +936,70 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Returns true if `str` is a contiguous slice of the buffer currently
+  // being executed, in which case it can be described by offset/length
+  // instead of being copied out.
+  bool SliceInCurrentBuffer(const StringPtr& str,
+                            uint32_t* offset,
+                            uint32_t* length) const {
+    if (str.size_ == 0) {
+      *offset = 0;
+      *length = 0;
+      return true;
+    }
+    if (str.on_heap_ ||
+        str.str_ < current_buffer_data_ ||
+        str.str_ + str.size_ > current_buffer_data_ + current_buffer_len_) {
+      return false;
+    }
+    *offset = static_cast<uint32_t>(str.str_ - current_buffer_data_);
+    *length = static_cast<uint32_t>(str.size_);
+    return true;
+  }
+
+
+  // Packed mode: instead of materializing one string per header name and
+  // value, write their offsets/lengths within the execute() buffer into the
+  // shared Uint32Array so that JS can decode only the headers it actually
+  // reads. Only possible while every slice still points into the current
+  // buffer; headers that were copied to the heap (message split across
+  // socket reads) fall back to CreateHeaders().
+  bool TryPackHeaders() {
+    if (!packed_headers_)
+      return false;
+
+    // When fed from a consumed stream there is no JS-visible buffer the
+    // offsets could refer to.
+    if (current_buffer_.IsEmpty())
+      return false;
+
+    AliasedUint32Array& packed = *packed_headers_;
+    uint32_t url_offset = 0;
+    uint32_t url_length = 0;
+    if (parser_.type == HTTP_REQUEST &&
+        !SliceInCurrentBuffer(url_, &url_offset, &url_length)) {
+      return false;
+    }
+
+    uint32_t slots[kMaxHeaderFieldsCount * 4];
+    for (size_t i = 0; i < num_values_; ++i) {
+      if (!SliceInCurrentBuffer(fields_[i], &slots[i * 4], &slots[i * 4 + 1]) ||
+          !SliceInCurrentBuffer(values_[i], &slots[i * 4 + 2],
+                                &slots[i * 4 + 3])) {
+        return false;
+      }
+    }
+
+    packed[kPackedNumHeaders] = static_cast<uint32_t>(num_values_);
+    packed[kPackedUrlOffset] = url_offset;
+    packed[kPackedUrlLength] = url_length;
+    for (size_t i = 0; i < num_values_ * 4; ++i)
+      packed[kPackedHeadersStart + i] = slots[i];
+    packed[kPackedValid] = 1;
+    return true;
+  }
+
+
   int MaybePause() {
     CHECK_NE(execute_depth_, 0);
 
@@ -816,6 +1028,12 @@ class Parser : public AsyncWrap, public StreamListener {
   bool pending_pause_ = false;
   uint64_t header_nread_ = 0;
   uint64_t max_http_header_size_;
+  std::unique_ptr<AliasedUint32Array> packed_headers_;
+  // Whole-body gathering mode, see GatherBody(). The vector keeps its
+  // capacity across messages so pooled parsers stop allocating for it.
+  uint64_t gather_body_limit_ = 0;
+  bool gathering_body_ = false;
+  std::vector<char> gathered_body_;
 
   // These are helper functions for filling `http_parser_settings`, which turn
   // a member function of Parser into a C-style HTTP parser callback.
@@ -852,6 +1070,154 @@ const llhttp_settings_t Parser::settings = {
 };
 
 
+// Native HTTP/1 response serializer. JS registers the static parts of a
+// response (status line, fixed headers) once as byte pieces; per response it
+// supplies only the varying values. write() assembles
+//   pieces[0] + values[0] + pieces[1] + values[1] + ...
+// directly into one managed buffer and submits it to the stream, so tiny
+// responses no longer pay for JS string concatenation plus a separate
+// encode pass.
+class HTTPResponseWriter : public BaseObject {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    new HTTPResponseWriter(env, args.This());
+  }
+
+
+  // setTemplate(pieces): pieces is an array of Buffers or Latin-1 strings
+  // whose bytes are copied and kept until the next setTemplate() call.
+  static void SetTemplate(const FunctionCallbackInfo<Value>& args) {
+    HTTPResponseWriter* writer;
+    ASSIGN_OR_RETURN_UNWRAP(&writer, args.Holder());
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK(args[0]->IsArray());
+    Local<Array> pieces = args[0].As<Array>();
+
+    writer->pieces_.clear();
+    writer->static_size_ = 0;
+    writer->pieces_.reserve(pieces->Length());
+
+    for (uint32_t i = 0; i < pieces->Length(); i++) {
+      Local<Value> piece;
+      if (!pieces->Get(env->context(), i).ToLocal(&piece))
+        return;
+      std::string bytes;
+      if (piece->IsArrayBufferView()) {
+        ArrayBufferViewContents<char> contents(piece);
+        bytes.assign(contents.data(), contents.length());
+      } else {
+        CHECK(piece->IsString());
+        Local<String> str = piece.As<String>();
+        bytes.resize(str->Length());
+        str->WriteOneByte(env->isolate(),
+                          reinterpret_cast<uint8_t*>(&bytes[0]),
+                          0,
+                          bytes.size(),
+                          String::NO_NULL_TERMINATION);
+      }
+      writer->static_size_ += bytes.size();
+      writer->pieces_.emplace_back(std::move(bytes));
+    }
+  }
+
+
+  // write(stream, req, values): interleaves the template pieces with the
+  // given values (Buffers or Latin-1 strings) and writes the result to the
+  // stream in a single request. Returns a libuv error code; bytes written
+  // and asynchronicity are reported through streamBaseState, exactly like
+  // writeBuffer()/writev().
+  static void Write(const FunctionCallbackInfo<Value>& args) {
+    HTTPResponseWriter* writer;
+    ASSIGN_OR_RETURN_UNWRAP(&writer, args.Holder());
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK(args[0]->IsObject());
+    CHECK(args[1]->IsObject());
+    CHECK(args[2]->IsArray());
+
+    StreamBase* stream = StreamBase::FromObject(args[0].As<Object>());
+    CHECK_NOT_NULL(stream);
+    Local<Object> req_wrap_obj = args[1].As<Object>();
+    Local<Array> values = args[2].As<Array>();
+    const uint32_t num_values = values->Length();
+
+    // First pass: coerce the values and compute the output size.
+    MaybeStackBuffer<Local<Value>, 16> value_handles(num_values);
+    size_t total = writer->static_size_;
+    for (uint32_t i = 0; i < num_values; i++) {
+      Local<Value> value;
+      if (!values->Get(env->context(), i).ToLocal(&value))
+        return;
+      if (value->IsArrayBufferView()) {
+        total += value.As<v8::ArrayBufferView>()->ByteLength();
+      } else {
+        Local<String> str;
+        if (!value->ToString(env->context()).ToLocal(&str))
+          return;
+        value = str;
+        total += str->Length();
+      }
+      value_handles[i] = value;
+    }
+
+    if (total > INT_MAX)
+      return args.GetReturnValue().Set(UV_ENOBUFS);
+
+    // Second pass: assemble the wire bytes into the write arena.
+    AllocatedBuffer data = env->AllocateManaged(total);
+    char* p = data.data();
+    const size_t rounds = std::max<size_t>(writer->pieces_.size(), num_values);
+    for (size_t i = 0; i < rounds; i++) {
+      if (i < writer->pieces_.size()) {
+        const std::string& piece = writer->pieces_[i];
+        memcpy(p, piece.data(), piece.size());
+        p += piece.size();
+      }
+      if (i < num_values) {
+        Local<Value> value = value_handles[i];
+        if (value->IsArrayBufferView()) {
+          ArrayBufferViewContents<char> contents(value);
+          memcpy(p, contents.data(), contents.length());
+          p += contents.length();
+        } else {
+          Local<String> str = value.As<String>();
+          p += str->WriteOneByte(env->isolate(),
+                                 reinterpret_cast<uint8_t*>(p),
+                                 0,
+                                 str->Length(),
+                                 String::NO_NULL_TERMINATION);
+        }
+      }
+    }
+    CHECK_EQ(static_cast<size_t>(p - data.data()), total);
+
+    uv_buf_t buf = uv_buf_init(data.data(), total);
+    StreamWriteResult res = stream->Write(&buf, 1, nullptr, req_wrap_obj);
+    stream->SetWriteResult(res);
+    if (res.wrap != nullptr)
+      res.wrap->SetAllocatedStorage(std::move(data));
+
+    args.GetReturnValue().Set(res.err);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(HTTPResponseWriter)
+  SET_SELF_SIZE(HTTPResponseWriter)
+
+ private:
+  HTTPResponseWriter(Environment* env, Local<Object> wrap)
+      : BaseObject(env, wrap) {
+    MakeWeak();
+  }
+
+  std::vector<std::string> pieces_;  // static byte pieces of the response
+  size_t static_size_ = 0;           // sum of the piece sizes
+};
+
+
 void InitializeHttpParser(Local<Object> target,
                           Local<Value> unused,
                           Local<Context> context,
@@ -897,10 +1263,23 @@ void InitializeHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "consume", Parser::Consume);
   env->SetProtoMethod(t, "unconsume", Parser::Unconsume);
   env->SetProtoMethod(t, "getCurrentBuffer", Parser::GetCurrentBuffer);
+  env->SetProtoMethod(t, "enablePackedHeaders", Parser::EnablePackedHeaders);
+  env->SetProtoMethod(t, "gatherBody", Parser::GatherBody);
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPParser"),
               t->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  Local<FunctionTemplate> w =
+      env->NewFunctionTemplate(HTTPResponseWriter::New);
+  w->InstanceTemplate()->SetInternalFieldCount(1);
+  w->SetClassName(
+      FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPResponseWriter"));
+  env->SetProtoMethod(w, "setTemplate", HTTPResponseWriter::SetTemplate);
+  env->SetProtoMethod(w, "write", HTTPResponseWriter::Write);
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPResponseWriter"),
+              w->GetFunction(env->context()).ToLocalChecked()).Check();
 }
 
 }  // anonymous namespace
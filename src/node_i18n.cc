@@ -44,6 +44,7 @@
 
 #if defined(NODE_HAVE_I18N_SUPPORT)
 
+#include "async_wrap-inl.h"
 #include "base_object-inl.h"
 #include "node.h"
 #include "node_buffer.h"
@@ -84,8 +85,11 @@ extern "C" const char U_DATA_API SMALL_ICUDATA_ENTRY_POINT[];
 
 namespace node {
 
+using v8::ArrayBuffer;
 using v8::Context;
+using v8::Function;
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Isolate;
@@ -94,7 +98,9 @@ using v8::MaybeLocal;
 using v8::NewStringType;
 using v8::Object;
 using v8::ObjectTemplate;
+using v8::Global;
 using v8::String;
+using v8::Uint32Array;
 using v8::Uint8Array;
 using v8::Value;
 
@@ -301,6 +307,243 @@ class ConverterObject : public BaseObject, Converter {
   bool bomSeen_ = false;     // True if the BOM has been seen
 };
 
+// Streaming transcoder. Keeps UConverter state (including the UTF-16
+// pivot buffer) across write() calls so that a large input can be
+// transcoded chunk by chunk into caller-supplied output buffers without
+// materializing the whole result, optionally off-thread. The binding
+// surface mirrors node_zlib.cc's CompressionStream:
+// init(fromEncoding, toEncoding, writeResult, writeCallback), then
+// write()/writeSync()(flush, in, in_off, in_len, out, out_off, out_len)
+// and close(). After each chunk, writeResult holds
+// [ output space left, input left, UErrorCode for the chunk ].
+class TranscodeStream : public AsyncWrap, public ThreadPoolWork {
+ public:
+  enum WriteResultField {
+    kAvailOut,
+    kAvailIn,
+    kErrorCode,
+    kWriteResultSize
+  };
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    new TranscodeStream(env, args.This());
+  }
+
+  static void Init(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    TranscodeStream* stream;
+    ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+    CHECK(args.Length() == 4 &&
+          "init(fromEncoding, toEncoding, writeResult, writeCallback)");
+    CHECK(!stream->init_done_ && "init before init");
+
+    Utf8Value from_label(env->isolate(), args[0]);
+    Utf8Value to_label(env->isolate(), args[1]);
+
+    CHECK(args[2]->IsUint32Array());
+    Local<Uint32Array> array = args[2].As<Uint32Array>();
+    CHECK_EQ(array->Length(), static_cast<size_t>(kWriteResultSize));
+    Local<ArrayBuffer> ab = array->Buffer();
+    uint32_t* write_result = static_cast<uint32_t*>(
+        ab->GetBackingStore()->Data());
+
+    CHECK(args[3]->IsFunction());
+
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter* from = ucnv_open(*from_label, &status);
+    if (U_FAILURE(status))
+      return args.GetReturnValue().Set(status);
+    UConverter* to = ucnv_open(*to_label, &status);
+    if (U_FAILURE(status)) {
+      ucnv_close(from);
+      return args.GetReturnValue().Set(status);
+    }
+    // Like the one-shot converters, substitute rather than fail on
+    // unrepresentable characters.
+    UErrorCode sub_status = U_ZERO_ERROR;
+    ucnv_setSubstChars(to, "?", 1, &sub_status);
+
+    stream->from_ = from;
+    stream->to_ = to;
+    stream->write_result_ = write_result;
+    stream->write_js_callback_.Reset(env->isolate(), args[3].As<Function>());
+    stream->init_done_ = true;
+    args.GetReturnValue().Set(0);
+  }
+
+  // write(flush, in, in_off, in_len, out, out_off, out_len)
+  template <bool async>
+  static void Write(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Local<Context> context = env->context();
+    CHECK_EQ(args.Length(), 7);
+
+    uint32_t in_off, in_len, out_off, out_len, flush;
+    if (!args[0]->Uint32Value(context).To(&flush)) return;
+
+    const char* in;
+    if (args[1]->IsNull()) {
+      // Just flush out the converter state.
+      in = nullptr;
+      in_off = 0;
+      in_len = 0;
+    } else {
+      CHECK(Buffer::HasInstance(args[1]));
+      Local<Object> in_buf = args[1].As<Object>();
+      if (!args[2]->Uint32Value(context).To(&in_off)) return;
+      if (!args[3]->Uint32Value(context).To(&in_len)) return;
+      CHECK(Buffer::IsWithinBounds(in_off, in_len, Buffer::Length(in_buf)));
+      in = Buffer::Data(in_buf) + in_off;
+    }
+
+    CHECK(Buffer::HasInstance(args[4]));
+    Local<Object> out_buf = args[4].As<Object>();
+    if (!args[5]->Uint32Value(context).To(&out_off)) return;
+    if (!args[6]->Uint32Value(context).To(&out_len)) return;
+    CHECK(Buffer::IsWithinBounds(out_off, out_len, Buffer::Length(out_buf)));
+    char* out = Buffer::Data(out_buf) + out_off;
+
+    TranscodeStream* stream;
+    ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+    CHECK(stream->init_done_ && "write before init");
+    CHECK(!stream->closed_ && "already finalized");
+    CHECK(!stream->write_in_progress_ && "write already in progress");
+
+    stream->write_in_progress_ = true;
+    stream->Ref();
+
+    stream->source_ = in;
+    stream->source_limit_ = in + in_len;
+    stream->target_ = out;
+    stream->target_limit_ = out + out_len;
+    stream->flush_ = flush != 0;
+
+    if (!async) {
+      env->PrintSyncTrace();
+      stream->DoThreadPoolWork();
+      stream->UpdateWriteResult();
+      stream->write_in_progress_ = false;
+      stream->Unref();
+      return;
+    }
+
+    stream->ScheduleWork();
+  }
+
+  static void Close(const FunctionCallbackInfo<Value>& args) {
+    TranscodeStream* stream;
+    ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+    stream->Close();
+  }
+
+  void DoThreadPoolWork() override {
+    status_ = U_ZERO_ERROR;
+    ucnv_convertEx(to_,
+                   from_,
+                   &target_,
+                   target_limit_,
+                   &source_,
+                   source_limit_,
+                   pivot_,
+                   &pivot_source_,
+                   &pivot_target_,
+                   pivot_ + arraysize(pivot_),
+                   false,  // Do not reset the converter state.
+                   flush_,
+                   &status_);
+    // Running out of output space is how the caller learns that it has to
+    // loop with a fresh output buffer, not a transcoding error.
+    if (status_ == U_BUFFER_OVERFLOW_ERROR)
+      status_ = U_ZERO_ERROR;
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    auto on_scope_leave = OnScopeLeave([&]() { Unref(); });
+
+    write_in_progress_ = false;
+
+    if (status == UV_ECANCELED) {
+      Close();
+      return;
+    }
+    CHECK_EQ(status, 0);
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    UpdateWriteResult();
+
+    Local<Function> cb = PersistentToLocal::Default(env()->isolate(),
+                                                    write_js_callback_);
+    MakeCallback(cb, 0, nullptr);
+
+    if (pending_close_)
+      Close();
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(TranscodeStream)
+  SET_SELF_SIZE(TranscodeStream)
+
+ private:
+  TranscodeStream(Environment* env, Local<Object> wrap)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_TRANSCODESTREAM),
+        ThreadPoolWork(env) {
+    MakeWeak();
+  }
+
+  ~TranscodeStream() override {
+    CHECK_EQ(false, write_in_progress_ && "write in progress");
+    Close();
+  }
+
+  void Close() {
+    if (write_in_progress_) {
+      pending_close_ = true;
+      return;
+    }
+    pending_close_ = false;
+    closed_ = true;
+    if (from_ != nullptr)
+      ucnv_close(from_);
+    if (to_ != nullptr)
+      ucnv_close(to_);
+    from_ = nullptr;
+    to_ = nullptr;
+  }
+
+  void UpdateWriteResult() {
+    write_result_[kAvailOut] = target_limit_ - target_;
+    write_result_[kAvailIn] = source_limit_ - source_;
+    write_result_[kErrorCode] = status_;
+  }
+
+  UConverter* from_ = nullptr;
+  UConverter* to_ = nullptr;
+
+  // Intermediate UTF-16 between the two converters; its fill state is
+  // part of the carried-over stream state.
+  UChar pivot_[2048];
+  UChar* pivot_source_ = pivot_;
+  UChar* pivot_target_ = pivot_;
+
+  const char* source_ = nullptr;
+  const char* source_limit_ = nullptr;
+  char* target_ = nullptr;
+  char* target_limit_ = nullptr;
+  UBool flush_ = false;
+  UErrorCode status_ = U_ZERO_ERROR;
+
+  bool init_done_ = false;
+  bool write_in_progress_ = false;
+  bool pending_close_ = false;
+  bool closed_ = false;
+
+  uint32_t* write_result_ = nullptr;
+  Global<Function> write_js_callback_;
+};
+
 // One-Shot Converters
 
 void CopySourceBuffer(MaybeStackBuffer<UChar>* dest,
@@ -832,6 +1075,22 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "getConverter", ConverterObject::Create);
   env->SetMethod(target, "decode", ConverterObject::Decode);
   env->SetMethod(target, "hasConverter", ConverterObject::Has);
+
+  // TranscodeStream
+  {
+    Local<FunctionTemplate> t = env->NewFunctionTemplate(TranscodeStream::New);
+    t->InstanceTemplate()->SetInternalFieldCount(1);
+    t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+    env->SetProtoMethod(t, "init", TranscodeStream::Init);
+    env->SetProtoMethod(t, "write", TranscodeStream::Write<true>);
+    env->SetProtoMethod(t, "writeSync", TranscodeStream::Write<false>);
+    env->SetProtoMethod(t, "close", TranscodeStream::Close);
+    Local<String> name =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "TranscodeStream");
+    t->SetClassName(name);
+    target->Set(env->context(), name,
+                t->GetFunction(env->context()).ToLocalChecked()).Check();
+  }
 }
 
 }  // namespace i18n
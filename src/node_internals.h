@@ -91,6 +91,11 @@ void PrintCaughtException(v8::Isolate* isolate,
                           const v8::TryCatch& try_catch);
 
 void ResetStdio();  // Safe to call more than once and from signal handlers.
+
+// Drains any bytes still parked in line-buffered TTY write batches (see
+// TTYWrap::DoTryWrite()). Called from ResetStdio(). Defined in
+// src/tty_wrap.cc.
+void FlushPendingTTYBatches();
 #ifdef __POSIX__
 void SignalExit(int signal, siginfo_t* info, void* ucontext);
 #endif
@@ -98,6 +103,15 @@ void SignalExit(int signal, siginfo_t* info, void* ucontext);
 std::string GetHumanReadableProcessName();
 void GetHumanReadableProcessName(char (*name)[1024]);
 
+// Number of CPUs this process can actually use: the online CPU count,
+// clamped by the scheduler affinity mask and the cgroup CPU quota on Linux.
+// Defined in src/node_os.cc.
+int GetAvailableParallelism();
+
+// Amount of memory actually available to this process: the cgroup limit
+// when one applies, the physical total otherwise. Defined in src/node_os.cc.
+uint64_t GetEffectiveMemory();
+
 void InitializeContextRuntime(v8::Local<v8::Context>);
 
 namespace task_queue {
@@ -106,12 +120,14 @@ void PromiseRejectCallback(v8::PromiseRejectMessage message);
 
 class NodeArrayBufferAllocator : public ArrayBufferAllocator {
  public:
+  ~NodeArrayBufferAllocator() override;
+
   inline uint32_t* zero_fill_field() { return &zero_fill_field_; }
 
-  void* Allocate(size_t size) override;  // Defined in src/node.cc
-  void* AllocateUninitialized(size_t size) override
-    { return node::UncheckedMalloc(size); }
-  void Free(void* data, size_t) override { free(data); }
+  // Defined in src/api/environment.cc.
+  void* Allocate(size_t size) override;
+  void* AllocateUninitialized(size_t size) override;
+  void Free(void* data, size_t size) override;
   virtual void* Reallocate(void* data, size_t old_size, size_t size) {
     return static_cast<void*>(
         UncheckedRealloc<char>(static_cast<char*>(data), size));
@@ -121,8 +137,39 @@ class NodeArrayBufferAllocator : public ArrayBufferAllocator {
 
   NodeArrayBufferAllocator* GetImpl() final { return this; }
 
+  struct PoolStats {
+    uint64_t hits = 0;            // Allocations served from a freelist.
+    uint64_t misses = 0;          // Pool-sized allocations that fell through.
+    uint64_t recycled = 0;        // Frees retained for later reuse.
+    uint64_t evicted = 0;         // Frees dropped because the pool was full.
+    uint64_t retained_bytes = 0;  // Currently held by the freelists.
+  };
+  PoolStats pool_stats() const;
+
+  // Drops every chunk currently retained by the freelists, returning the
+  // memory to the system allocator. Called on memory pressure.
+  void ReleasePooledMemory();
+
  private:
+  // Freed backing stores between 4 kB and 1 MB are kept in power-of-two
+  // size-classed freelists instead of going back to the system allocator,
+  // so that workloads that churn through medium-sized Buffers do not pay
+  // a malloc()/free() pair (and the resulting heap fragmentation) per
+  // allocation. A freed chunk is filed under the largest class that does
+  // not exceed its size and may only be handed out again for requests
+  // that fit in that class, so capacity can never be overstated.
+  static constexpr size_t kPoolMinSize = 4096;
+  static constexpr size_t kPoolClassCount = 9;  // 4 kB ... 1 MB.
+  static constexpr size_t kMaxChunksPerClass = 64;
+  static constexpr uint64_t kMaxRetainedBytes = 32 << 20;
+
+  void* PoolAllocate(size_t size);
+  bool PoolFree(void* data, size_t size);
+
   uint32_t zero_fill_field_ = 1;  // Boolean but exposed as uint32 to JS land.
+  mutable Mutex pool_mutex_;
+  std::vector<void*> pool_[kPoolClassCount];
+  PoolStats pool_stats_;
 };
 
 class DebuggingArrayBufferAllocator final : public NodeArrayBufferAllocator {
@@ -230,11 +277,18 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  // Holds the async context frame that was current before this scope swapped
+  // in the frame captured by the AsyncWrap this scope was created for.
+  v8::Global<v8::Value> prev_context_frame_;
   bool skip_hooks_;
   bool skip_task_queues_;
+  // When CPU budgeting is enabled, uv_hrtime() at entry of the outermost
+  // scope; the elapsed time is charged to the Environment in Close().
+  uint64_t cpu_charge_start_ns_ = 0;
   bool failed_ = false;
   bool pushed_ids_ = false;
   bool closed_ = false;
+  bool swapped_context_frame_ = false;
 };
 
 class DebugSealHandleScope {
@@ -253,7 +307,15 @@ class DebugSealHandleScope {
 
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  // Scheduling class of a work item. kBlockingIo work is submitted to the
+  // libuv pool directly; kCpuBound work (zlib, crypto) is additionally
+  // subject to --threadpool-cpu-limit so that a burst of CPU-heavy jobs
+  // cannot occupy every pool thread and starve file system and DNS requests.
+  enum class WorkClass { kBlockingIo, kCpuBound };
+
+  explicit inline ThreadPoolWork(Environment* env,
+                                 WorkClass work_class = WorkClass::kBlockingIo)
+      : env_(env), work_class_(work_class) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
@@ -265,8 +327,16 @@ class ThreadPoolWork {
   virtual void AfterThreadPoolWork(int status) = 0;
 
  private:
+  inline void SubmitToPool();
+
   Environment* env_;
   uv_work_t work_req_;
+  WorkClass work_class_;
+  // Set while this work item is waiting for a CPU work slot rather than
+  // sitting in the libuv queue. Only accessed from the event loop thread.
+  bool lane_queued_ = false;
+
+  friend class Environment;
 };
 
 #define TRACING_CATEGORY_NODE "node"
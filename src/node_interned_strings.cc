@@ -0,0 +1,137 @@
+#include "node_interned_strings.h"
+#include "util.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace node {
+
+namespace {
+
+struct CorpusEntry {
+  const char* data;
+  size_t size;
+};
+
+constexpr CorpusEntry corpus[] = {
+#define V(s) {"" s, sizeof(s) - 1},
+    NODE_INTERNED_STRING_CORPUS(V)
+#undef V
+};
+
+static_assert(arraysize(corpus) == kInternedStringCount,
+              "corpus definition out of sync");
+
+uint32_t Hash(const char* data, size_t size, uint32_t seed) {
+  // FNV-1a, seeded so the displacement search can re-hash a bucket.
+  uint32_t hash = seed ^ 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// CHD-style perfect hashing: a first-level hash groups corpus entries into
+// buckets; each bucket gets a displacement seed chosen (at startup, once per
+// process) so that its entries land in empty slots of the second-level
+// table. Lookup is then one displacement read plus one slot probe,
+// independent of corpus size.
+struct ProbeTable {
+  uint32_t slot_mask;
+  std::vector<uint32_t> displacements;  // Indexed by first-level bucket.
+  std::vector<int32_t> slots;           // Corpus index, or -1 when empty.
+};
+
+bool TryBuildProbeTable(uint32_t slot_count, ProbeTable* table) {
+  const uint32_t bucket_count = slot_count / 4;
+  table->slot_mask = slot_count - 1;
+  table->displacements.assign(bucket_count, 0);
+  table->slots.assign(slot_count, -1);
+
+  // Group entries by first-level bucket.
+  std::vector<std::vector<uint32_t>> buckets(bucket_count);
+  for (uint32_t i = 0; i < kInternedStringCount; i++) {
+    const uint32_t b =
+        Hash(corpus[i].data, corpus[i].size, 0) % bucket_count;
+    buckets[b].push_back(i);
+  }
+
+  // Place large buckets first; they are the hardest to fit.
+  std::vector<uint32_t> order(bucket_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  for (uint32_t b : order) {
+    const std::vector<uint32_t>& entries = buckets[b];
+    if (entries.empty()) continue;
+    bool placed = false;
+    for (uint32_t d = 1; d <= 65536; d++) {
+      std::vector<uint32_t> taken;
+      taken.reserve(entries.size());
+      bool fits = true;
+      for (uint32_t index : entries) {
+        const uint32_t slot =
+            Hash(corpus[index].data, corpus[index].size, d) &
+            table->slot_mask;
+        if (table->slots[slot] != -1 ||
+            std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+          fits = false;
+          break;
+        }
+        taken.push_back(slot);
+      }
+      if (!fits) continue;
+      for (size_t i = 0; i < entries.size(); i++)
+        table->slots[taken[i]] = static_cast<int32_t>(entries[i]);
+      table->displacements[b] = d;
+      placed = true;
+      break;
+    }
+    if (!placed) return false;
+  }
+  return true;
+}
+
+const ProbeTable& GetProbeTable() {
+  static const ProbeTable table = []() {
+    ProbeTable result;
+    // Start at twice the corpus size (rounded up to a power of two) and
+    // grow on the rare failure; construction runs once per process.
+    uint32_t slot_count = 64;
+    while (slot_count < 2 * kInternedStringCount) slot_count *= 2;
+    while (!TryBuildProbeTable(slot_count, &result)) slot_count *= 2;
+    return result;
+  }();
+  return table;
+}
+
+}  // anonymous namespace
+
+size_t FindInternedStringIndex(const char* data, size_t size) {
+  const ProbeTable& table = GetProbeTable();
+  const uint32_t bucket =
+      Hash(data, size, 0) % table.displacements.size();
+  const uint32_t displacement = table.displacements[bucket];
+  if (displacement == 0) return kInternedStringNotFound;
+  const uint32_t slot = Hash(data, size, displacement) & table.slot_mask;
+  const int32_t index = table.slots[slot];
+  if (index < 0) return kInternedStringNotFound;
+  const CorpusEntry& entry = corpus[index];
+  if (entry.size != size || memcmp(entry.data, data, size) != 0)
+    return kInternedStringNotFound;
+  return static_cast<size_t>(index);
+}
+
+const char* InternedStringSource(size_t index, size_t* size) {
+  CHECK_LT(index, kInternedStringCount);
+  *size = corpus[index].size;
+  return corpus[index].data;
+}
+
+}  // namespace node
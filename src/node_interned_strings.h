@@ -0,0 +1,149 @@
+#ifndef SRC_NODE_INTERNED_STRINGS_H_
+#define SRC_NODE_INTERNED_STRINGS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace node {
+
+// Corpus of immortal short strings that hot paths materialize over and over:
+// HTTP header names as they commonly appear on the wire (both the lowercased
+// form HTTP/2 mandates and the capitalized HTTP/1 convention), frequent
+// header values and common event names. Each entry gets one eternal
+// v8::String per Environment, so repeated occurrences cost neither an
+// allocation nor minor-GC pressure.
+//
+// The list is the extension point: add vocabulary here and the probe table
+// is rebuilt automatically at startup. Entries must be unique and at most
+// 255 bytes.
+#define NODE_INTERNED_STRING_CORPUS(V)                                         \
+  V("accept")                                                                  \
+  V("accept-charset")                                                          \
+  V("accept-encoding")                                                         \
+  V("accept-language")                                                         \
+  V("accept-ranges")                                                           \
+  V("access-control-allow-credentials")                                        \
+  V("access-control-allow-headers")                                            \
+  V("access-control-allow-methods")                                            \
+  V("access-control-allow-origin")                                             \
+  V("age")                                                                     \
+  V("allow")                                                                   \
+  V("authorization")                                                           \
+  V("cache-control")                                                           \
+  V("connection")                                                              \
+  V("content-disposition")                                                     \
+  V("content-encoding")                                                        \
+  V("content-language")                                                        \
+  V("content-length")                                                          \
+  V("content-range")                                                           \
+  V("content-security-policy")                                                 \
+  V("content-type")                                                            \
+  V("cookie")                                                                  \
+  V("date")                                                                    \
+  V("etag")                                                                    \
+  V("expect")                                                                  \
+  V("expires")                                                                 \
+  V("forwarded")                                                               \
+  V("host")                                                                    \
+  V("if-match")                                                                \
+  V("if-modified-since")                                                       \
+  V("if-none-match")                                                           \
+  V("if-range")                                                                \
+  V("if-unmodified-since")                                                     \
+  V("keep-alive")                                                              \
+  V("last-modified")                                                           \
+  V("link")                                                                    \
+  V("location")                                                                \
+  V("origin")                                                                  \
+  V("pragma")                                                                  \
+  V("proxy-authenticate")                                                      \
+  V("proxy-authorization")                                                     \
+  V("range")                                                                   \
+  V("referer")                                                                 \
+  V("retry-after")                                                             \
+  V("server")                                                                  \
+  V("set-cookie")                                                              \
+  V("strict-transport-security")                                               \
+  V("te")                                                                      \
+  V("trailer")                                                                 \
+  V("transfer-encoding")                                                       \
+  V("upgrade")                                                                 \
+  V("user-agent")                                                              \
+  V("vary")                                                                    \
+  V("via")                                                                     \
+  V("www-authenticate")                                                        \
+  V("x-forwarded-for")                                                         \
+  V("x-forwarded-host")                                                        \
+  V("x-forwarded-proto")                                                       \
+  V("x-powered-by")                                                            \
+  V("x-request-id")                                                            \
+  V("Accept")                                                                  \
+  V("Accept-Encoding")                                                         \
+  V("Accept-Language")                                                         \
+  V("Authorization")                                                           \
+  V("Cache-Control")                                                           \
+  V("Connection")                                                              \
+  V("Content-Encoding")                                                        \
+  V("Content-Length")                                                          \
+  V("Content-Type")                                                            \
+  V("Cookie")                                                                  \
+  V("Date")                                                                    \
+  V("ETag")                                                                    \
+  V("Expires")                                                                 \
+  V("Host")                                                                    \
+  V("Keep-Alive")                                                              \
+  V("Last-Modified")                                                           \
+  V("Location")                                                                \
+  V("Pragma")                                                                  \
+  V("Referer")                                                                 \
+  V("Server")                                                                  \
+  V("Set-Cookie")                                                              \
+  V("Transfer-Encoding")                                                       \
+  V("Upgrade")                                                                 \
+  V("User-Agent")                                                              \
+  V("Vary")                                                                    \
+  V("X-Forwarded-For")                                                         \
+  V("X-Forwarded-Proto")                                                       \
+  V("application/json")                                                        \
+  V("application/octet-stream")                                                \
+  V("chunked")                                                                 \
+  V("close")                                                                   \
+  V("deflate")                                                                 \
+  V("gzip")                                                                    \
+  V("identity")                                                                \
+  V("no-cache")                                                                \
+  V("no-store")                                                                \
+  V("text/html")                                                               \
+  V("text/plain")                                                              \
+  V("utf-8")                                                                   \
+  V("GET")                                                                     \
+  V("HEAD")                                                                    \
+  V("POST")                                                                    \
+  V("PUT")                                                                     \
+  V("DELETE")                                                                  \
+  V("OPTIONS")                                                                 \
+  V("PATCH")                                                                   \
+  V("HTTP/1.1")                                                                \
+  V("OK")
+
+#define V(s) +1
+constexpr size_t kInternedStringCount = 0 NODE_INTERNED_STRING_CORPUS(V);
+#undef V
+
+constexpr size_t kInternedStringNotFound = SIZE_MAX;
+
+// Resolves `data` to its corpus index with a single probe into the string
+// table (CHD-style displacement hashing, collision-free over the corpus).
+// Returns kInternedStringNotFound for strings outside the corpus.
+size_t FindInternedStringIndex(const char* data, size_t size);
+
+// Returns the bytes for a corpus index; `*size` receives the length.
+const char* InternedStringSource(size_t index, size_t* size);
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_INTERNED_STRINGS_H_
@@ -0,0 +1,340 @@
+#include "node_io_uring.h"
+
+#include "env-inl.h"
+#include "util-inl.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define NODE_HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef NODE_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#endif
+
+namespace node {
+
+#ifdef NODE_HAVE_IO_URING
+
+// io_uring syscall numbers are uniform across architectures but may be
+// missing from older libc headers.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#ifndef IORING_REGISTER_EVENTFD
+#define IORING_REGISTER_EVENTFD 4
+#endif
+#ifndef MAP_POPULATE
+#define MAP_POPULATE 0
+#endif
+
+namespace {
+
+constexpr unsigned kQueueDepth = 64;
+
+thread_local IoUring* per_loop_ring = nullptr;
+thread_local bool ring_setup_failed = false;
+
+int IoUringSetup(unsigned entries, struct io_uring_params* p) {
+  return syscall(__NR_io_uring_setup, entries, p);
+}
+
+int IoUringEnter(int fd, unsigned to_submit) {
+  return syscall(__NR_io_uring_enter, fd, to_submit, 0u, 0u, nullptr, 0u);
+}
+
+int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+// Ring head/tail words are shared with the kernel and need explicit
+// acquire/release ordering.
+uint32_t LoadAcquire(const uint32_t* ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(uint32_t* ptr, uint32_t value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+}  // anonymous namespace
+
+// The iovec has to stay valid until the kernel reaps the SQE, so it lives
+// in the per-request allocation that user_data points at.
+struct IoUring::Request {
+  struct iovec iov;
+  ReadCallback cb;
+};
+
+IoUring::IoUring(uv_loop_t* loop) : loop_(loop) {}
+
+IoUring::~IoUring() {
+  for (Request* req : pending_)
+    delete req;
+  if (sqes_ != nullptr)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr)
+    munmap(sq_ring_, sq_ring_size_);
+  if (event_fd_ >= 0)
+    close(event_fd_);
+  if (ring_fd_ >= 0)
+    close(ring_fd_);
+}
+
+IoUring* IoUring::Get(Environment* env) {
+  if (ring_setup_failed)
+    return nullptr;
+  if (per_loop_ring != nullptr) {
+    // Multiple Environments on one thread share the event loop, and
+    // therefore the ring.
+    CHECK_EQ(per_loop_ring->loop_, env->event_loop());
+    return per_loop_ring;
+  }
+
+  IoUring* ring = new IoUring(env->event_loop());
+  if (!ring->Setup(kQueueDepth)) {
+    delete ring;
+    ring_setup_failed = true;
+    return nullptr;
+  }
+
+  per_loop_ring = ring;
+  env->AddCleanupHook(CleanupHook, ring);
+  return ring;
+}
+
+bool IoUring::Setup(unsigned entries) {
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(p));
+
+  ring_fd_ = IoUringSetup(entries, &p);
+  if (ring_fd_ < 0)
+    return false;  // ENOSYS on pre-5.1 kernels, EPERM under seccomp.
+
+  bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+  single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+#ifdef IORING_FEAT_RW_CUR_POS
+  supports_cur_pos_ = (p.features & IORING_FEAT_RW_CUR_POS) != 0;
+#endif
+
+  sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (single_mmap)
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return false;
+  }
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      return false;
+    }
+  }
+
+  sqes_size_ = p.sq_entries * sizeof(struct io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    return false;
+  }
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_khead_ = reinterpret_cast<uint32_t*>(sq + p.sq_off.head);
+  sq_ktail_ = reinterpret_cast<uint32_t*>(sq + p.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(sq + p.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + p.sq_off.array);
+  sq_entries_ = p.sq_entries;
+
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_khead_ = reinterpret_cast<uint32_t*>(cq + p.cq_off.head);
+  cq_ktail_ = reinterpret_cast<uint32_t*>(cq + p.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(cq + p.cq_off.ring_mask);
+  cqes_ = cq + p.cq_off.cqes;
+
+  event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd_ < 0)
+    return false;
+  if (IoUringRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0)
+    return false;
+
+  CHECK_EQ(0, uv_poll_init(loop_, &poll_, event_fd_));
+  CHECK_EQ(0, uv_prepare_init(loop_, &prepare_));
+  poll_.data = this;
+  prepare_.data = this;
+  CHECK_EQ(0, uv_poll_start(&poll_, UV_READABLE,
+                            [](uv_poll_t* handle, int status, int events) {
+                              if (status == 0) {
+                                static_cast<IoUring*>(handle->data)
+                                    ->DrainCompletions();
+                              }
+                            }));
+  // Neither handle may keep an otherwise idle loop alive; the poll handle
+  // is ref'ed only while reads are in flight.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&poll_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&prepare_));
+  handles_initialized_ = true;
+  return true;
+}
+
+bool IoUring::SubmitRead(int fd,
+                         char* base,
+                         uint32_t len,
+                         int64_t offset,
+                         ReadCallback cb) {
+  if (offset < 0 && !supports_cur_pos_)
+    return false;
+
+  const uint32_t head = LoadAcquire(sq_khead_);
+  const uint32_t tail = *sq_ktail_;  // This thread is the only SQ producer.
+  if (tail - head >= sq_entries_)
+    return false;  // Ring full; fall back to the threadpool.
+
+  std::unique_ptr<Request> req = std::make_unique<Request>();
+  req->iov.iov_base = base;
+  req->iov.iov_len = len;
+  req->cb = std::move(cb);
+
+  struct io_uring_sqe* sqe =
+      static_cast<struct io_uring_sqe*>(sqes_) + (tail & sq_mask_);
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_READV;
+  sqe->fd = fd;
+  sqe->off = static_cast<uint64_t>(offset);
+  sqe->addr = reinterpret_cast<uint64_t>(&req->iov);
+  sqe->len = 1;
+  sqe->user_data = reinterpret_cast<uint64_t>(req.get());
+
+  sq_array_[tail & sq_mask_] = tail & sq_mask_;
+  StoreRelease(sq_ktail_, tail + 1);
+  to_submit_++;
+  pending_.insert(req.release());
+
+  if (inflight_++ == 0)
+    uv_ref(reinterpret_cast<uv_handle_t*>(&poll_));
+  if (!uv_is_active(reinterpret_cast<uv_handle_t*>(&prepare_))) {
+    CHECK_EQ(0, uv_prepare_start(&prepare_, [](uv_prepare_t* handle) {
+      static_cast<IoUring*>(handle->data)->Flush();
+    }));
+  }
+  return true;
+}
+
+void IoUring::Flush() {
+  while (to_submit_ > 0) {
+    int n = IoUringEnter(ring_fd_, to_submit_);
+    if (n < 0) {
+      CHECK(errno == EINTR || errno == EAGAIN);
+      continue;
+    }
+    to_submit_ -= n;
+  }
+  uv_prepare_stop(&prepare_);
+}
+
+void IoUring::DrainCompletions() {
+  uint64_t signal_count;
+  while (read(event_fd_, &signal_count, sizeof(signal_count)) ==
+         sizeof(signal_count)) {
+    // Drain the (non-blocking) eventfd; the CQ ring is the source of truth.
+  }
+
+  uint32_t head = *cq_khead_;  // This thread is the only CQ consumer.
+  uint32_t tail = LoadAcquire(cq_ktail_);
+  while (head != tail) {
+    const struct io_uring_cqe* cqe =
+        static_cast<const struct io_uring_cqe*>(cqes_) + (head & cq_mask_);
+    Request* req = reinterpret_cast<Request*>(
+        static_cast<uintptr_t>(cqe->user_data));
+    const int result = cqe->res;
+    head++;
+    // Hand the CQE back before running the callback; it may submit again.
+    StoreRelease(cq_khead_, head);
+
+    CHECK_EQ(pending_.erase(req), 1u);
+    CHECK_GT(inflight_, 0u);
+    if (--inflight_ == 0)
+      uv_unref(reinterpret_cast<uv_handle_t*>(&poll_));
+
+    ReadCallback cb = std::move(req->cb);
+    delete req;
+    cb(result);
+
+    tail = LoadAcquire(cq_ktail_);
+  }
+}
+
+void IoUring::Close() {
+  if (!handles_initialized_) {
+    delete this;
+    return;
+  }
+  open_handles_ = 2;
+  const uv_close_cb close_cb = [](uv_handle_t* handle) {
+    IoUring* ring = static_cast<IoUring*>(handle->data);
+    if (--ring->open_handles_ == 0)
+      delete ring;
+  };
+  uv_close(reinterpret_cast<uv_handle_t*>(&poll_), close_cb);
+  uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), close_cb);
+}
+
+void IoUring::CleanupHook(void* arg) {
+  IoUring* ring = static_cast<IoUring*>(arg);
+  CHECK_EQ(ring, per_loop_ring);
+  per_loop_ring = nullptr;
+  // A future Environment on this thread may probe the kernel again.
+  ring_setup_failed = false;
+  ring->Close();
+}
+
+#else  // !NODE_HAVE_IO_URING
+
+IoUring::IoUring(uv_loop_t* loop) : loop_(loop) {}
+
+IoUring::~IoUring() {}
+
+IoUring* IoUring::Get(Environment* env) {
+  return nullptr;
+}
+
+bool IoUring::SubmitRead(int fd,
+                         char* base,
+                         uint32_t len,
+                         int64_t offset,
+                         ReadCallback cb) {
+  return false;
+}
+
+#endif  // NODE_HAVE_IO_URING
+
+}  // namespace node
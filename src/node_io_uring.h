@@ -0,0 +1,100 @@
+#ifndef SRC_NODE_IO_URING_H_
+#define SRC_NODE_IO_URING_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "uv.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+
+namespace node {
+
+class Environment;
+
+// Minimal io_uring submission engine for regular-file reads. libuv routes
+// all file I/O through its threadpool, which costs two thread handoffs and
+// a loop wakeup per operation; on Linux 5.x a read can instead be handed to
+// the kernel directly and completed on the event loop. SQEs queued during a
+// loop turn are flushed with a single io_uring_enter(2) call from a prepare
+// handle just before the loop blocks, and completions are signalled through
+// a registered eventfd that a poll handle watches.
+//
+// All methods must be called from the loop thread. On non-Linux platforms,
+// pre-5.1 kernels and sandboxed (seccomp) processes Get() returns nullptr
+// and callers keep using the threadpool.
+class IoUring {
+ public:
+  using ReadCallback = std::function<void(int result)>;
+
+  // Returns the per-event-loop instance, creating it on first use, or
+  // nullptr when io_uring is unavailable. Setup failures latch so that the
+  // kernel is probed only once per thread.
+  static IoUring* Get(Environment* env);
+
+  // Queues a read of up to `len` bytes into `base`. A negative `offset`
+  // reads at the current file position (5.6+ kernels). `cb` runs on the
+  // loop thread with the number of bytes read or a negative errno, matching
+  // libuv result conventions. Returns false when the request cannot be
+  // queued (ring full, unsupported offset); the caller is expected to
+  // dispatch the read to the threadpool instead.
+  bool SubmitRead(int fd,
+                  char* base,
+                  uint32_t len,
+                  int64_t offset,
+                  ReadCallback cb);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+ private:
+  explicit IoUring(uv_loop_t* loop);
+  ~IoUring();
+
+  struct Request;
+
+  bool Setup(unsigned entries);
+  void Flush();
+  void DrainCompletions();
+  // Closes the libuv handles and deletes `this` once they are down.
+  void Close();
+  static void CleanupHook(void* arg);
+
+  uv_loop_t* loop_;
+  uv_poll_t poll_;
+  uv_prepare_t prepare_;
+  bool handles_initialized_ = false;
+  int open_handles_ = 0;
+
+  int ring_fd_ = -1;
+  int event_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_khead_ = nullptr;
+  uint32_t* sq_ktail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_khead_ = nullptr;
+  uint32_t* cq_ktail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  void* cqes_ = nullptr;
+
+  unsigned to_submit_ = 0;
+  size_t inflight_ = 0;
+  bool supports_cur_pos_ = false;
+  std::unordered_set<Request*> pending_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_IO_URING_H_
@@ -1,5 +1,6 @@
 #include "node_main_instance.h"
 #include "node_internals.h"
+#include "node_native_module_env.h"
 #include "node_options-inl.h"
 #include "node_v8_platform-inl.h"
 #include "util-inl.h"
@@ -73,6 +74,13 @@ NodeMainInstance::NodeMainInstance(
   SetIsolateCreateParamsForNode(params);
   Isolate::Initialize(isolate_, *params);
 
+  // Warm the shared native-module code cache on a platform worker thread,
+  // overlapping the bootstrap compilation work with the rest of the isolate
+  // and environment setup below. By the time RunBootstrapping() requires
+  // these modules, most of them deserialize from the cache instead of being
+  // compiled serially on this thread.
+  native_module::NativeModuleEnv::PrecompileBootstrapOnWorkerThread(platform);
+
   deserialize_mode_ = per_isolate_data_indexes != nullptr;
   // If the indexes are not nullptr, we are not deserializing
   CHECK_IMPLIES(deserialize_mode_, params->external_references != nullptr);
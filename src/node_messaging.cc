@@ -9,6 +9,9 @@
 #include "node_process.h"
 #include "util-inl.h"
 
+#include <atomic>
+#include <unordered_map>
+
 using node::contextify::ContextifyContext;
 using v8::Array;
 using v8::ArrayBuffer;
@@ -22,12 +25,15 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::Name;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SharedArrayBuffer;
@@ -50,6 +56,260 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// Fast-path frame format. Messages that consist of transferred ArrayBuffers
+// plus at most a small header of primitive values skip the ValueSerializer
+// entirely: the BackingStores are moved by pointer as usual, and the header
+// is encoded into a small flat buffer that takes the place of the serialized
+// data. Anything that does not match this shape falls back to the full
+// ValueSerializer path, so the fast path never has to clone or throw.
+//
+// A frame is a kind tag followed by kind-specific data:
+//   kFrameValue:        one encoded value (primitive or ArrayBuffer index)
+//   kFrameHeaderObject: uint32 property count, then per property an encoded
+//                       key string followed by an encoded value
+// Values are a one-byte tag plus payload; strings are stored as a uint32
+// character count plus raw two-byte character data, doubles verbatim, and
+// transferred ArrayBuffers as their index in the transfer list. Frames only
+// ever travel between threads of the same process, so host byte order is
+// fine and readers may CHECK on malformed data.
+enum FastFrameKind : uint32_t {
+  kFrameValue,
+  kFrameHeaderObject
+};
+
+enum FastFrameTag : uint8_t {
+  kTagUndefined,
+  kTagNull,
+  kTagFalse,
+  kTagTrue,
+  kTagDouble,
+  kTagString,
+  kTagArrayBuffer
+};
+
+// Headers larger than this are not "small" anymore; let the ValueSerializer
+// handle them rather than growing the frame without bound.
+constexpr size_t kMaxFastFrameSize = 4096;
+
+class FastFrameWriter {
+ public:
+  bool ok() const { return ok_; }
+
+  void WriteUint8(uint8_t value) { Append(&value, sizeof(value)); }
+  void WriteUint32(uint32_t value) { Append(&value, sizeof(value)); }
+  void WriteDouble(double value) { Append(&value, sizeof(value)); }
+
+  void WriteString(Isolate* isolate, Local<String> str) {
+    const uint32_t length = str->Length();
+    WriteUint32(length);
+    if (!ok_ || buf_.size() + length * sizeof(uint16_t) > kMaxFastFrameSize) {
+      ok_ = false;
+      return;
+    }
+    MaybeStackBuffer<uint16_t, 64> chars(length);
+    str->Write(isolate, *chars, 0, length, String::NO_NULL_TERMINATION);
+    Append(*chars, length * sizeof(uint16_t));
+  }
+
+  // Returns false if `value` cannot be represented in a fast frame.
+  bool WriteValue(Isolate* isolate,
+                  Local<Value> value,
+                  const std::vector<Local<ArrayBuffer>>& array_buffers) {
+    if (value->IsUndefined()) {
+      WriteUint8(kTagUndefined);
+    } else if (value->IsNull()) {
+      WriteUint8(kTagNull);
+    } else if (value->IsBoolean()) {
+      WriteUint8(value->IsTrue() ? kTagTrue : kTagFalse);
+    } else if (value->IsNumber()) {
+      WriteUint8(kTagDouble);
+      WriteDouble(value.As<Number>()->Value());
+    } else if (value->IsString()) {
+      WriteUint8(kTagString);
+      WriteString(isolate, value.As<String>());
+    } else if (value->IsArrayBuffer()) {
+      // Only ArrayBuffers that are being transferred move by reference;
+      // anything else would have to be cloned, which is the slow path's job.
+      for (uint32_t i = 0; i < array_buffers.size(); ++i) {
+        if (array_buffers[i] == value) {
+          WriteUint8(kTagArrayBuffer);
+          WriteUint32(i);
+          return true;
+        }
+      }
+      return false;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  MallocedBuffer<char> Release() {
+    CHECK(ok_);
+    MallocedBuffer<char> ret(buf_.size());
+    memcpy(ret.data, buf_.data(), buf_.size());
+    return ret;
+  }
+
+ private:
+  void Append(const void* data, size_t size) {
+    if (!ok_ || buf_.size() + size > kMaxFastFrameSize) {
+      ok_ = false;
+      return;
+    }
+    const char* p = static_cast<const char*>(data);
+    buf_.insert(buf_.end(), p, p + size);
+  }
+
+  std::vector<char> buf_;
+  bool ok_ = true;
+};
+
+class FastFrameReader {
+ public:
+  FastFrameReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  uint8_t ReadUint8() {
+    uint8_t value;
+    Read(&value, sizeof(value));
+    return value;
+  }
+
+  uint32_t ReadUint32() {
+    uint32_t value;
+    Read(&value, sizeof(value));
+    return value;
+  }
+
+  double ReadDouble() {
+    double value;
+    Read(&value, sizeof(value));
+    return value;
+  }
+
+  MaybeLocal<String> ReadString(Isolate* isolate) {
+    const uint32_t length = ReadUint32();
+    MaybeStackBuffer<uint16_t, 64> chars(length);
+    Read(*chars, length * sizeof(uint16_t));
+    return String::NewFromTwoByte(
+        isolate, *chars, v8::NewStringType::kNormal, length);
+  }
+
+  MaybeLocal<Value> ReadValue(
+      Isolate* isolate,
+      const std::vector<Local<ArrayBuffer>>& array_buffers) {
+    switch (ReadUint8()) {
+      case kTagUndefined:
+        return Undefined(isolate);
+      case kTagNull:
+        return Null(isolate);
+      case kTagFalse:
+        return False(isolate);
+      case kTagTrue:
+        return True(isolate);
+      case kTagDouble:
+        return Number::New(isolate, ReadDouble());
+      case kTagString: {
+        Local<String> str;
+        if (!ReadString(isolate).ToLocal(&str))
+          return MaybeLocal<Value>();
+        return str;
+      }
+      case kTagArrayBuffer: {
+        const uint32_t id = ReadUint32();
+        CHECK_LT(id, array_buffers.size());
+        return array_buffers[id];
+      }
+    }
+    UNREACHABLE();
+  }
+
+ private:
+  void Read(void* out, size_t size) {
+    CHECK_LE(size, size_ - pos_);
+    memcpy(out, data_ + pos_, size);
+    pos_ += size;
+  }
+
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+// Try to encode `input` into the fast-path frame format. Returns Just(true)
+// and fills `writer` if the message matched the shape, Just(false) if the
+// caller has to fall back to the ValueSerializer, and Nothing if a JS
+// exception is pending.
+Maybe<bool> TryWriteFastFrame(
+    Isolate* isolate,
+    Local<Context> context,
+    Local<Value> input,
+    const std::vector<Local<ArrayBuffer>>& array_buffers,
+    FastFrameWriter* writer) {
+  if (!input->IsObject() || input->IsArrayBuffer()) {
+    writer->WriteUint32(kFrameValue);
+    return Just(writer->WriteValue(isolate, input, array_buffers) &&
+                writer->ok());
+  }
+
+  // Only plain objects qualify as headers; anything with a different
+  // prototype (arrays, class instances, Dates, host objects, ...) would
+  // deserialize differently under structured clone. Proxies are rejected
+  // up front so none of their traps run both here and in the fallback.
+  if (input->IsProxy())
+    return Just(false);
+  Local<Object> obj = input.As<Object>();
+  if (!Object::New(isolate)->GetPrototype()->StrictEquals(obj->GetPrototype()))
+    return Just(false);
+
+  Local<Array> names;
+  if (!obj->GetOwnPropertyNames(
+               context,
+               static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                               v8::SKIP_SYMBOLS),
+               v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&names)) {
+    return Nothing<bool>();
+  }
+
+  const uint32_t length = names->Length();
+  writer->WriteUint32(kFrameHeaderObject);
+  writer->WriteUint32(length);
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> key;
+    Local<Value> value;
+    if (!names->Get(context, i).ToLocal(&key))
+      return Nothing<bool>();
+    if (!key->IsString())
+      return Just(false);
+    // Reading an accessor property here and then again from the
+    // ValueSerializer fallback would run its getter twice; structured
+    // clone reads every property exactly once. Peeking at the descriptor
+    // does not invoke the getter, so accessors can be left entirely to
+    // the fallback.
+    Local<Value> desc;
+    if (!obj->GetOwnPropertyDescriptor(context, key.As<Name>())
+             .ToLocal(&desc)) {
+      return Nothing<bool>();
+    }
+    bool is_accessor = false;
+    if (!desc->IsObject() ||
+        !desc.As<Object>()
+             ->Has(context, FIXED_ONE_BYTE_STRING(isolate, "get"))
+             .To(&is_accessor)) {
+      return Nothing<bool>();
+    }
+    if (is_accessor)
+      return Just(false);
+    if (!obj->Get(context, key).ToLocal(&value))
+      return Nothing<bool>();
+    writer->WriteString(isolate, key.As<String>());
+    if (!writer->WriteValue(isolate, value, array_buffers) || !writer->ok())
+      return Just(false);
+  }
+  return Just(writer->ok());
+}
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -104,6 +364,46 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   EscapableHandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
 
+  if (fast_frame_) {
+    // Fast-path frames (see Serialize()) only ever reference transferred
+    // ArrayBuffers and primitive values, so they are decoded directly
+    // instead of through a ValueDeserializer.
+    std::vector<Local<ArrayBuffer>> array_buffers;
+    for (uint32_t i = 0; i < array_buffers_.size(); ++i) {
+      array_buffers.push_back(
+          ArrayBuffer::New(env->isolate(), std::move(array_buffers_[i])));
+    }
+    array_buffers_.clear();
+
+    FastFrameReader reader(main_message_buf_.data, main_message_buf_.size);
+    Local<Value> result;
+    switch (reader.ReadUint32()) {
+      case kFrameValue:
+        if (!reader.ReadValue(env->isolate(), array_buffers).ToLocal(&result))
+          return MaybeLocal<Value>();
+        break;
+      case kFrameHeaderObject: {
+        const uint32_t nprops = reader.ReadUint32();
+        Local<Object> obj = Object::New(env->isolate());
+        for (uint32_t i = 0; i < nprops; i++) {
+          Local<String> key;
+          Local<Value> value;
+          if (!reader.ReadString(env->isolate()).ToLocal(&key) ||
+              !reader.ReadValue(env->isolate(), array_buffers)
+                   .ToLocal(&value)) {
+            return MaybeLocal<Value>();
+          }
+          obj->CreateDataProperty(context, key, value).Check();
+        }
+        result = obj;
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+    return handle_scope.Escape(result);
+  }
+
   // Create all necessary MessagePort handles.
   std::vector<MessagePort*> ports(message_ports_.size());
   for (uint32_t i = 0; i < message_ports_.size(); ++i) {
@@ -368,9 +668,29 @@ Maybe<bool> Message::Serialize(Environment* env,
     return Nothing<bool>();
   }
 
-  serializer.WriteHeader();
-  if (serializer.WriteValue(context, input).IsNothing()) {
-    return Nothing<bool>();
+  // The common worker messaging pattern - a handful of transferred
+  // ArrayBuffers plus a small header of primitive values - does not need
+  // the ValueSerializer at all. If the message matches that shape, encode
+  // it into a flat frame instead; the BackingStores still move by pointer
+  // through `array_buffers_` below, exactly as in the serialized case.
+  bool fast_frame = false;
+  FastFrameWriter fast_frame_writer;
+  if (delegate.ports_.empty()) {
+    if (!TryWriteFastFrame(env->isolate(),
+                           context,
+                           input,
+                           array_buffers,
+                           &fast_frame_writer)
+             .To(&fast_frame)) {
+      return Nothing<bool>();
+    }
+  }
+
+  if (!fast_frame) {
+    serializer.WriteHeader();
+    if (serializer.WriteValue(context, input).IsNothing()) {
+      return Nothing<bool>();
+    }
   }
 
   for (Local<ArrayBuffer> ab : array_buffers) {
@@ -386,6 +706,12 @@ Maybe<bool> Message::Serialize(Environment* env,
 
   delegate.Finish();
 
+  if (fast_frame) {
+    main_message_buf_ = fast_frame_writer.Release();
+    fast_frame_ = true;
+    return Just(true);
+  }
+
   // The serializer gave us a buffer allocated using `malloc()`.
   std::pair<uint8_t*, size_t> data = serializer.Release();
   CHECK_NOT_NULL(data.first);
@@ -416,6 +742,7 @@ void MessagePortData::AddToIncomingQueue(Message&& message) {
   // This function will be called by other threads.
   Mutex::ScopedLock lock(mutex_);
   incoming_messages_.emplace_back(std::move(message));
+  pending_message_count_.fetch_add(1, std::memory_order_release);
 
   if (owner_ != nullptr) {
     Debug(owner_, "Adding message to incoming queue");
@@ -552,24 +879,31 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               bool only_if_receiving) {
   Message received;
   {
-    // Get the head of the message queue.
+    // Get the head of the message queue. Messages that the OnMessage()
+    // batch loop has already claimed come first; they are older than
+    // anything still in the incoming queue.
     Mutex::ScopedLock lock(data_->mutex_);
 
     Debug(this, "MessagePort has message");
 
+    std::list<Message>* queue = &data_->incoming_messages_;
+    if (in_flight_messages_ != nullptr && !in_flight_messages_->empty())
+      queue = in_flight_messages_;
+
     bool wants_message = receiving_messages_ || !only_if_receiving;
     // We have nothing to do if:
     // - There are no pending messages
     // - We are not intending to receive messages, and the message we would
     //   receive is not the final "close" message.
-    if (data_->incoming_messages_.empty() ||
-        (!wants_message &&
-         !data_->incoming_messages_.front().IsCloseMessage())) {
+    if (queue->empty() ||
+        (!wants_message && !queue->front().IsCloseMessage())) {
       return env()->no_message_symbol();
     }
 
-    received = std::move(data_->incoming_messages_.front());
-    data_->incoming_messages_.pop_front();
+    received = std::move(queue->front());
+    queue->pop_front();
+    if (queue == &data_->incoming_messages_)
+      data_->pending_message_count_.fetch_sub(1, std::memory_order_release);
   }
 
   if (received.IsCloseMessage()) {
@@ -587,36 +921,87 @@ void MessagePort::OnMessage() {
   HandleScope handle_scope(env()->isolate());
   Local<Context> context = object(env()->isolate())->CreationContext();
 
+  const uint64_t budget = env()->options()->message_port_drain_budget;
   size_t processing_limit;
-  {
-    Mutex::ScopedLock(data_->mutex_);
-    processing_limit = std::max(data_->incoming_messages_.size(),
-                                static_cast<size_t>(1000));
+  if (budget > 0) {
+    // Hard per-loop-turn cap requested via --message-port-drain-budget.
+    processing_limit = budget;
+  } else {
+    // Prevent event loop starvation by only processing those messages without
+    // interruption that were already present when the OnMessage() call was
+    // first triggered, but at least 1000 messages because otherwise the
+    // overhead of repeatedly triggering the uv_async_t instance becomes
+    // noticable, at least on Windows.
+    // (That might require more investigation by somebody more familiar with
+    // Windows.)
+    // The wakeup counter tells us how many messages are pending without
+    // having to acquire the lock.
+    processing_limit =
+        std::max(data_->pending_message_count_.load(std::memory_order_acquire),
+                 static_cast<size_t>(1000));
   }
 
+  std::list<Message> batch;
+  CHECK_NULL(in_flight_messages_);
+  in_flight_messages_ = &batch;
+  auto reset_in_flight = OnScopeLeave([&]() { in_flight_messages_ = nullptr; });
+
+  // Returns messages that were claimed in a batch but not delivered to the
+  // head of the incoming queue, e.g. when the port stops receiving or a
+  // callback fails mid-batch.
+  auto requeue_batch = [&]() {
+    if (batch.empty() || !data_) return;
+    Mutex::ScopedLock lock(data_->mutex_);
+    data_->pending_message_count_.fetch_add(batch.size(),
+                                            std::memory_order_release);
+    data_->incoming_messages_.splice(data_->incoming_messages_.begin(), batch);
+  };
+
   // data_ can only ever be modified by the owner thread, so no need to lock.
   // However, the message port may be transferred while it is processing
   // messages, so we need to check that this handle still owns its `data_` field
-  // on every iteration.
+  // on every iteration. (If it is transferred from inside a message callback,
+  // Detach() moves the remainder of `batch` back along with it.)
   while (data_) {
+    if (batch.empty()) {
+      // The counted wakeups give us the exact number of pending messages;
+      // if none were added since the last claim, there is nothing left to
+      // drain and we can avoid locking the mutex just to find that out.
+      // (Messages added after this check are covered by their own
+      // uv_async_send() wakeup.)
+      if (data_->pending_message_count_.load(std::memory_order_acquire) == 0)
+        break;
+      // Claim everything that is currently pending under a single lock
+      // acquisition instead of locking once per message.
+      Mutex::ScopedLock lock(data_->mutex_);
+      batch.splice(batch.begin(), data_->incoming_messages_);
+      data_->pending_message_count_.store(0, std::memory_order_release);
+      if (batch.empty()) break;
+    }
+
+    Debug(this, "MessagePort has message");
+
     if (processing_limit-- == 0) {
-      // Prevent event loop starvation by only processing those messages without
-      // interruption that were already present when the OnMessage() call was
-      // first triggered, but at least 1000 messages because otherwise the
-      // overhead of repeatedly triggering the uv_async_t instance becomes
-      // noticable, at least on Windows.
-      // (That might require more investigation by somebody more familiar with
-      // Windows.)
+      requeue_batch();
       TriggerAsync();
       return;
     }
 
-    HandleScope handle_scope(env()->isolate());
-    Context::Scope context_scope(context);
+    const bool is_close = batch.front().IsCloseMessage();
+    if (!receiving_messages_ && !is_close) {
+      // We are not intending to receive messages; leave them queued until
+      // the port is started again.
+      requeue_batch();
+      return;
+    }
 
-    Local<Value> payload;
-    if (!ReceiveMessage(context, true).ToLocal(&payload)) break;
-    if (payload == env()->no_message_symbol()) break;
+    Message received = std::move(batch.front());
+    batch.pop_front();
+
+    if (is_close) {
+      Close();
+      return;
+    }
 
     if (!env()->can_call_into_js()) {
       Debug(this, "MessagePort drains queue because !can_call_into_js()");
@@ -624,6 +1009,15 @@ void MessagePort::OnMessage() {
       continue;
     }
 
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(context);
+
+    Local<Value> payload;
+    if (!received.Deserialize(env(), context).ToLocal(&payload)) {
+      requeue_batch();
+      return;
+    }
+
     Local<Object> event;
     Local<Value> cb_args[1];
     if (!env()->message_event_object_template()->NewInstance(context)
@@ -635,6 +1029,7 @@ void MessagePort::OnMessage() {
                      arraysize(cb_args),
                      cb_args).IsEmpty()) {
       // Re-schedule OnMessage() execution in case of failure.
+      requeue_batch();
       if (data_)
         TriggerAsync();
       return;
@@ -654,6 +1049,15 @@ void MessagePort::OnClose() {
 std::unique_ptr<MessagePortData> MessagePort::Detach() {
   CHECK(data_);
   Mutex::ScopedLock lock(data_->mutex_);
+  if (in_flight_messages_ != nullptr) {
+    // The port is being transferred from inside a message callback; return
+    // the undelivered remainder of the current batch to the queue so that
+    // those messages travel along with the MessagePortData.
+    data_->pending_message_count_.fetch_add(in_flight_messages_->size(),
+                                            std::memory_order_release);
+    data_->incoming_messages_.splice(data_->incoming_messages_.begin(),
+                                     *in_flight_messages_);
+  }
   data_->owner_ = nullptr;
   return std::move(data_);
 }
@@ -933,6 +1337,415 @@ Local<FunctionTemplate> GetMessagePortConstructorTemplate(Environment* env) {
 
 namespace {
 
+// A single-producer single-consumer ring of fixed-size records on top of a
+// SharedArrayBuffer, for workloads (e.g. audio processing) where even an
+// optimized MessagePort round trip is too slow. The shared memory starts
+// with a RingHeader - head and tail indices on separate cache lines plus
+// one registration slot per role - followed by `capacity` records. The
+// indices are free-running uint32 counters, so `tail - head` is the fill
+// level and the SPSC discipline means each side only ever stores to its
+// own counter. Offsets into the header are exported as constants so that
+// a dedicated thread may also poll or Atomics.wait() on the indices
+// directly; on the event loop, cross-thread wakeup goes through each
+// side's uv_async_t, which coalesces bursts of notifications into a
+// single loop iteration.
+struct RingHeader {
+  std::atomic<uint32_t> head;
+  char head_padding[64 - sizeof(std::atomic<uint32_t>)];
+  std::atomic<uint32_t> tail;
+  char tail_padding[64 - sizeof(std::atomic<uint32_t>)];
+  // Global registry ids of the RingChannel instances currently attached to
+  // either end, or 0. These are only meaningful within one process.
+  std::atomic<uint64_t> producer_id;
+  std::atomic<uint64_t> consumer_id;
+  char id_padding[64 - 2 * sizeof(std::atomic<uint64_t>)];
+};
+
+static_assert(sizeof(RingHeader) == 192,
+              "RingHeader layout is part of the binding contract");
+
+constexpr size_t kRingHeaderSize = sizeof(RingHeader);
+constexpr size_t kRingHeadOffset = offsetof(RingHeader, head);
+constexpr size_t kRingTailOffset = offsetof(RingHeader, tail);
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "std::atomic must be usable on shared memory");
+
+// Maps registry ids to live RingChannel instances, so that one end can wake
+// up the other through its uv_async_t without sharing pointers through the
+// SharedArrayBuffer. Channels deregister before their handle starts
+// closing, making it safe to call uv_async_send() under this lock.
+Mutex ring_channel_mutex;
+uint64_t next_ring_channel_id = 1;
+std::unordered_map<uint64_t, class RingChannel*> ring_channel_registry;
+
+class RingChannel : public HandleWrap {
+ public:
+  enum Role : uint32_t {
+    kRoleProducer,
+    kRoleConsumer
+  };
+
+  // new RingChannel(sharedArrayBuffer, recordSize, role)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    if (!args.IsConstructCall()) {
+      THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+      return;
+    }
+    CHECK(args[0]->IsSharedArrayBuffer());
+    CHECK(args[1]->IsUint32());
+    CHECK(args[2]->IsUint32());
+    const uint32_t record_size = args[1].As<v8::Uint32>()->Value();
+    const uint32_t role = args[2].As<v8::Uint32>()->Value();
+    CHECK_GT(record_size, 0);
+    CHECK_LE(role, kRoleConsumer);
+    std::shared_ptr<BackingStore> backing_store =
+        args[0].As<SharedArrayBuffer>()->GetBackingStore();
+    CHECK_GE(backing_store->ByteLength(), sizeof(RingHeader) + record_size);
+    new RingChannel(env,
+                    args.This(),
+                    std::move(backing_store),
+                    record_size,
+                    static_cast<Role>(role));
+  }
+
+  // push(record) -> bool; false if the ring is full.
+  static void Push(const FunctionCallbackInfo<Value>& args) {
+    RingChannel* ring;
+    ASSIGN_OR_RETURN_UNWRAP(&ring, args.This());
+    CHECK_EQ(ring->role_, kRoleProducer);
+    CHECK(Buffer::HasInstance(args[0]));
+    CHECK_GE(Buffer::Length(args[0]), ring->record_size_);
+    args.GetReturnValue().Set(ring->PushRecord(Buffer::Data(args[0])));
+  }
+
+  // shift(record) -> bool; false if the ring is empty, otherwise the record
+  // has been copied into the argument.
+  static void Shift(const FunctionCallbackInfo<Value>& args) {
+    RingChannel* ring;
+    ASSIGN_OR_RETURN_UNWRAP(&ring, args.This());
+    CHECK_EQ(ring->role_, kRoleConsumer);
+    CHECK(Buffer::HasInstance(args[0]));
+    CHECK_GE(Buffer::Length(args[0]), ring->record_size_);
+    args.GetReturnValue().Set(ring->ShiftRecord(Buffer::Data(args[0])));
+  }
+
+  void Close(Local<Value> close_callback = Local<Value>()) override {
+    Deregister();
+    HandleWrap::Close(close_callback);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RingChannel)
+  SET_SELF_SIZE(RingChannel)
+
+ private:
+  RingChannel(Environment* env,
+              Local<Object> wrap,
+              std::shared_ptr<BackingStore> backing_store,
+              uint32_t record_size,
+              Role role)
+      : HandleWrap(env,
+                   wrap,
+                   reinterpret_cast<uv_handle_t*>(&async_),
+                   AsyncWrap::PROVIDER_RINGCHANNEL),
+        backing_store_(std::move(backing_store)),
+        record_size_(record_size),
+        capacity_(
+            (backing_store_->ByteLength() - sizeof(RingHeader)) /
+            record_size),
+        role_(role) {
+    auto onwakeup = [](uv_async_t* handle) {
+      RingChannel* ring = ContainerOf(&RingChannel::async_, handle);
+      ring->OnWakeup();
+    };
+    CHECK_EQ(uv_async_init(env->event_loop(), &async_, onwakeup), 0);
+    {
+      Mutex::ScopedLock lock(ring_channel_mutex);
+      id_ = next_ring_channel_id++;
+      ring_channel_registry[id_] = this;
+    }
+    // Claim this side of the channel; a non-zero previous value means two
+    // producers or two consumers were attached, violating SPSC.
+    CHECK_EQ(id_slot()->exchange(id_), 0);
+  }
+
+  ~RingChannel() override {
+    Deregister();
+  }
+
+  RingHeader* header() const {
+    return static_cast<RingHeader*>(backing_store_->Data());
+  }
+
+  char* records() const {
+    return static_cast<char*>(backing_store_->Data()) + sizeof(RingHeader);
+  }
+
+  std::atomic<uint64_t>* id_slot() const {
+    return role_ == kRoleProducer ? &header()->producer_id
+                                  : &header()->consumer_id;
+  }
+
+  std::atomic<uint64_t>* peer_slot() const {
+    return role_ == kRoleProducer ? &header()->consumer_id
+                                  : &header()->producer_id;
+  }
+
+  bool PushRecord(const char* src) {
+    RingHeader* h = header();
+    const uint32_t head = h->head.load(std::memory_order_acquire);
+    const uint32_t tail = h->tail.load(std::memory_order_relaxed);
+    if (tail - head >= capacity_) return false;
+    memcpy(records() + (tail % capacity_) * record_size_, src, record_size_);
+    h->tail.store(tail + 1, std::memory_order_release);
+    WakePeer();
+    return true;
+  }
+
+  bool ShiftRecord(char* dst) {
+    RingHeader* h = header();
+    const uint32_t tail = h->tail.load(std::memory_order_acquire);
+    const uint32_t head = h->head.load(std::memory_order_relaxed);
+    if (tail == head) return false;
+    memcpy(dst, records() + (head % capacity_) * record_size_, record_size_);
+    h->head.store(head + 1, std::memory_order_release);
+    // Waking the producer signals that space has become available.
+    WakePeer();
+    return true;
+  }
+
+  void WakePeer() {
+    const uint64_t id = peer_slot()->load(std::memory_order_acquire);
+    if (id == 0) return;
+    Mutex::ScopedLock lock(ring_channel_mutex);
+    auto it = ring_channel_registry.find(id);
+    if (it != ring_channel_registry.end())
+      CHECK_EQ(uv_async_send(&it->second->async_), 0);
+  }
+
+  void OnWakeup() {
+    if (!env()->can_call_into_js()) return;
+    HandleScope handle_scope(env()->isolate());
+    Local<Context> context = object(env()->isolate())->CreationContext();
+    Context::Scope context_scope(context);
+    USE(MakeCallback(env()->onwakeup_string(), 0, nullptr));
+  }
+
+  void Deregister() {
+    {
+      Mutex::ScopedLock lock(ring_channel_mutex);
+      ring_channel_registry.erase(id_);
+    }
+    // Release this side's slot, but only if it is still ours.
+    uint64_t expected = id_;
+    id_slot()->compare_exchange_strong(expected, 0);
+  }
+
+  std::shared_ptr<BackingStore> backing_store_;
+  const uint32_t record_size_;
+  const uint32_t capacity_;
+  const Role role_;
+  uint64_t id_ = 0;
+  uv_async_t async_;
+};
+
+// A process-global multi-producer multi-consumer task queue for worker
+// pools. Instead of round-robining tasks onto per-worker MessagePorts
+// regardless of queue depth, producers push into a single named queue and
+// every attached receiver pulls the next task whenever it is idle - the
+// shared queue gives the same load-balancing effect as work stealing
+// without per-worker deques. Tasks are regular Messages, so transferred
+// ArrayBuffers move by BackingStore pointer and transfer-heavy payloads
+// take the flat fast-frame encoding instead of the ValueSerializer.
+class TaskQueueChannel;
+
+struct TaskQueueData {
+  // Protects tasks, receivers and wake_index. attach_count is guarded by
+  // task_queue_registry_mutex below instead.
+  Mutex mutex;
+  std::list<Message> tasks;
+  std::vector<TaskQueueChannel*> receivers;
+  size_t wake_index = 0;
+  size_t attach_count = 0;
+};
+
+// Queues are looked up by name so that workers can attach to them without
+// any handle passing; the entry lives until the last channel detaches.
+Mutex task_queue_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<TaskQueueData>>
+    task_queue_registry;
+
+class TaskQueueChannel : public HandleWrap {
+ public:
+  // new TaskQueueChannel(name, isReceiver). Receivers get onwakeup
+  // notifications when tasks are pushed; pure producers do not.
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    if (!args.IsConstructCall()) {
+      THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+      return;
+    }
+    CHECK(args[0]->IsString());
+    CHECK(args[1]->IsBoolean());
+    Utf8Value name(env->isolate(), args[0]);
+    new TaskQueueChannel(
+        env,
+        args.This(),
+        std::string(*name, name.length()),
+        args[1]->IsTrue());
+  }
+
+  // push(value[, transferList])
+  static void Push(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    TaskQueueChannel* channel;
+    ASSIGN_OR_RETURN_UNWRAP(&channel, args.This());
+    CHECK(channel->queue_);
+    Local<Context> context = args.This()->CreationContext();
+
+    TransferList transfer_list;
+    if (args[1]->IsObject()) {
+      bool was_iterable;
+      if (!ReadIterable(env, context, transfer_list, args[1]).To(&was_iterable))
+        return;
+      if (!was_iterable) {
+        return THROW_ERR_INVALID_ARG_TYPE(env,
+            "Optional transferList argument must be an iterable");
+      }
+    }
+
+    Message msg;
+    if (msg.Serialize(env, context, args[0], transfer_list).IsNothing())
+      return;
+    channel->PushTask(std::move(msg));
+  }
+
+  // shift() -> next task, or the no-message sentinel if the queue is empty
+  // (e.g. because another receiver got there first).
+  static void Shift(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    TaskQueueChannel* channel;
+    ASSIGN_OR_RETURN_UNWRAP(&channel, args.This());
+    CHECK(channel->queue_);
+
+    Message task;
+    {
+      Mutex::ScopedLock lock(channel->queue_->mutex);
+      if (channel->queue_->tasks.empty()) {
+        args.GetReturnValue().Set(env->no_message_symbol());
+        return;
+      }
+      task = std::move(channel->queue_->tasks.front());
+      channel->queue_->tasks.pop_front();
+    }
+
+    Local<Value> payload;
+    if (task.Deserialize(env, args.This()->CreationContext())
+            .ToLocal(&payload)) {
+      args.GetReturnValue().Set(payload);
+    }
+  }
+
+  // size() -> current queue depth, for depth-aware submission policies.
+  static void Size(const FunctionCallbackInfo<Value>& args) {
+    TaskQueueChannel* channel;
+    ASSIGN_OR_RETURN_UNWRAP(&channel, args.This());
+    CHECK(channel->queue_);
+    Mutex::ScopedLock lock(channel->queue_->mutex);
+    args.GetReturnValue().Set(
+        static_cast<uint32_t>(channel->queue_->tasks.size()));
+  }
+
+  void Close(Local<Value> close_callback = Local<Value>()) override {
+    Detach();
+    HandleWrap::Close(close_callback);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(TaskQueueChannel)
+  SET_SELF_SIZE(TaskQueueChannel)
+
+ private:
+  TaskQueueChannel(Environment* env,
+                   Local<Object> wrap,
+                   std::string name,
+                   bool receiver)
+      : HandleWrap(env,
+                   wrap,
+                   reinterpret_cast<uv_handle_t*>(&async_),
+                   AsyncWrap::PROVIDER_TASKQUEUE),
+        name_(std::move(name)),
+        receiver_(receiver) {
+    auto onwakeup = [](uv_async_t* handle) {
+      TaskQueueChannel* channel =
+          ContainerOf(&TaskQueueChannel::async_, handle);
+      channel->OnWakeup();
+    };
+    CHECK_EQ(uv_async_init(env->event_loop(), &async_, onwakeup), 0);
+    {
+      Mutex::ScopedLock lock(task_queue_registry_mutex);
+      std::shared_ptr<TaskQueueData>& entry = task_queue_registry[name_];
+      if (!entry) entry = std::make_shared<TaskQueueData>();
+      entry->attach_count++;
+      queue_ = entry;
+    }
+    if (receiver_) {
+      Mutex::ScopedLock lock(queue_->mutex);
+      queue_->receivers.push_back(this);
+    }
+  }
+
+  ~TaskQueueChannel() override {
+    Detach();
+  }
+
+  void PushTask(Message&& msg) {
+    Mutex::ScopedLock lock(queue_->mutex);
+    queue_->tasks.emplace_back(std::move(msg));
+    // Wake one receiver per task, round robin. A woken receiver that loses
+    // the race for the task simply finds the queue empty and goes back to
+    // sleep. Receivers detach under the same lock before their handle
+    // starts closing, so the send is safe.
+    if (!queue_->receivers.empty()) {
+      TaskQueueChannel* target =
+          queue_->receivers[queue_->wake_index++ % queue_->receivers.size()];
+      CHECK_EQ(uv_async_send(&target->async_), 0);
+    }
+  }
+
+  void OnWakeup() {
+    if (!env()->can_call_into_js()) return;
+    HandleScope handle_scope(env()->isolate());
+    Local<Context> context = object(env()->isolate())->CreationContext();
+    Context::Scope context_scope(context);
+    USE(MakeCallback(env()->onwakeup_string(), 0, nullptr));
+  }
+
+  void Detach() {
+    if (!queue_) return;
+    if (receiver_) {
+      Mutex::ScopedLock lock(queue_->mutex);
+      auto it = std::find(
+          queue_->receivers.begin(), queue_->receivers.end(), this);
+      if (it != queue_->receivers.end())
+        queue_->receivers.erase(it);
+    }
+    {
+      Mutex::ScopedLock lock(task_queue_registry_mutex);
+      if (--queue_->attach_count == 0)
+        task_queue_registry.erase(name_);
+    }
+    queue_.reset();
+  }
+
+  std::string name_;
+  const bool receiver_;
+  std::shared_ptr<TaskQueueData> queue_;
+  uv_async_t async_;
+};
+
 static void MessageChannel(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   if (!args.IsConstructCall()) {
@@ -982,6 +1795,42 @@ static void InitMessaging(Local<Object> target,
   env->SetMethod(target, "moveMessagePortToContext",
                  MessagePort::MoveToContext);
 
+  {
+    Local<String> ring_channel_string =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "RingChannel");
+    Local<FunctionTemplate> t = env->NewFunctionTemplate(RingChannel::New);
+    t->SetClassName(ring_channel_string);
+    t->InstanceTemplate()->SetInternalFieldCount(1);
+    t->Inherit(HandleWrap::GetConstructorTemplate(env));
+    env->SetProtoMethod(t, "push", RingChannel::Push);
+    env->SetProtoMethod(t, "shift", RingChannel::Shift);
+    target->Set(context,
+                ring_channel_string,
+                t->GetFunction(context).ToLocalChecked()).Check();
+
+    // Header layout constants, so that consumers can size the
+    // SharedArrayBuffer and poll the indices directly if they want to.
+    NODE_DEFINE_CONSTANT(target, kRingHeaderSize);
+    NODE_DEFINE_CONSTANT(target, kRingHeadOffset);
+    NODE_DEFINE_CONSTANT(target, kRingTailOffset);
+  }
+
+  {
+    Local<String> task_queue_string =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "TaskQueueChannel");
+    Local<FunctionTemplate> t =
+        env->NewFunctionTemplate(TaskQueueChannel::New);
+    t->SetClassName(task_queue_string);
+    t->InstanceTemplate()->SetInternalFieldCount(1);
+    t->Inherit(HandleWrap::GetConstructorTemplate(env));
+    env->SetProtoMethod(t, "push", TaskQueueChannel::Push);
+    env->SetProtoMethod(t, "shift", TaskQueueChannel::Shift);
+    env->SetProtoMethod(t, "size", TaskQueueChannel::Size);
+    target->Set(context,
+                task_queue_string,
+                t->GetFunction(context).ToLocalChecked()).Check();
+  }
+
   {
     Local<Function> domexception = GetDOMException(context).ToLocalChecked();
     target
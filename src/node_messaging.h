@@ -5,6 +5,7 @@
 
 #include "env.h"
 #include "node_mutex.h"
+#include <atomic>
 #include <list>
 
 namespace node {
@@ -73,6 +74,10 @@ class Message : public MemoryRetainer {
 
  private:
   MallocedBuffer<char> main_message_buf_;
+  // Whether main_message_buf_ contains a fast-path frame (transferred
+  // ArrayBuffers plus a small header of primitives) instead of
+  // ValueSerializer data. See TryWriteFastFrame() in node_messaging.cc.
+  bool fast_frame_ = false;
   std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<MessagePortData>> message_ports_;
@@ -117,6 +122,13 @@ class MessagePortData : public MemoryRetainer {
   // sibling_.
   mutable Mutex mutex_;
   std::list<Message> incoming_messages_;
+  // Counted-wakeup channel with eventfd/semaphore semantics. This always
+  // matches `incoming_messages_.size()` and is modified under `mutex_`, but
+  // can be read without it; since `uv_async_send()` coalesces wakeups, the
+  // receiving thread uses this to learn how many messages are pending (and,
+  // in particular, whether the queue is empty) without acquiring the lock
+  // just to re-scan for stragglers.
+  std::atomic<size_t> pending_message_count_ { 0 };
   MessagePort* owner_ = nullptr;
   // This mutex protects the sibling_ field and is shared between two entangled
   // MessagePorts. If both mutexes are acquired, this one needs to be
@@ -207,6 +219,12 @@ class MessagePort : public HandleWrap {
 
   std::unique_ptr<MessagePortData> data_ = nullptr;
   bool receiving_messages_ = false;
+  // Messages that OnMessage() has moved out of the incoming queue in one
+  // batch but not yet delivered. Only accessed from the owner thread; set
+  // while the batch is being processed so that Detach() can return
+  // undelivered messages to the queue if the port is transferred from
+  // within a message callback.
+  std::list<Message>* in_flight_messages_ = nullptr;
   uv_async_t async_;
 
   friend class MessagePortData;
@@ -1,5 +1,10 @@
 #include "node_native_module.h"
+#include "debug_utils.h"
+#include "node.h"
 #include "util-inl.h"
+#include "uv.h"
+
+#include <atomic>
 
 namespace node {
 namespace native_module {
@@ -148,9 +153,23 @@ NativeModuleCacheMap* NativeModuleLoader::code_cache() {
   return &code_cache_;
 }
 
-ScriptCompiler::CachedData* NativeModuleLoader::GetCodeCache(
-    const char* id) const {
-  Mutex::ScopedLock lock(code_cache_mutex_);
+NativeModuleLoader::CodeCacheShard* NativeModuleLoader::CacheShard(
+    const char* id) {
+  return &code_cache_shards_[std::hash<std::string>()(id) %
+                             kCodeCacheShardCount];
+}
+
+ScriptCompiler::CachedData* NativeModuleLoader::GetCodeCache(const char* id) {
+  CodeCacheShard* shard = CacheShard(id);
+  {
+    Mutex::ScopedLock lock(shard->mutex);
+    const auto it = shard->map.find(id);
+    if (it != shard->map.end()) {
+      // Safe to return without the lock held: shard entries are never
+      // erased or replaced.
+      return it->second.get();
+    }
+  }
   const auto it = code_cache_.find(id);
   if (it == code_cache_.end()) {
     // The module has not been compiled before.
@@ -196,15 +215,33 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
   Local<Integer> column_offset = Integer::New(isolate, 0);
   ScriptOrigin origin(filename, line_offset, column_offset, True(isolate));
 
-  Mutex::ScopedLock lock(code_cache_mutex_);
-
+  // Consult the process-wide caches: first the runtime cache that earlier
+  // compilations - possibly on other threads - have populated, then the
+  // code cache embedded into the binary. The ScriptCompiler::Source object
+  // takes ownership of the CachedData instance that is passed to it, so
+  // hand it a non-owning alias; the entry itself stays available to any
+  // number of Isolates. Since shard entries are never erased or replaced,
+  // the aliased buffer remains valid after the lock is dropped, and the
+  // compilation below does not serialize all threads on a global mutex.
   ScriptCompiler::CachedData* cached_data = nullptr;
+  CodeCacheShard* shard = CacheShard(id);
   {
+    Mutex::ScopedLock lock(shard->mutex);
+    auto cache_it = shard->map.find(id);
+    if (cache_it != shard->map.end()) {
+      cached_data = new ScriptCompiler::CachedData(
+          cache_it->second->data,
+          cache_it->second->length,
+          ScriptCompiler::CachedData::BufferNotOwned);
+    }
+  }
+  if (cached_data == nullptr) {
     auto cache_it = code_cache_.find(id);
     if (cache_it != code_cache_.end()) {
-      // Transfer ownership to ScriptCompiler::Source later.
-      cached_data = cache_it->second.release();
-      code_cache_.erase(cache_it);
+      cached_data = new ScriptCompiler::CachedData(
+          cache_it->second->data,
+          cache_it->second->length,
+          ScriptCompiler::CachedData::BufferNotOwned);
     }
   }
 
@@ -241,16 +278,139 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
   *result = (has_cache && !script_source.GetCachedData()->rejected)
                 ? Result::kWithCache
                 : Result::kWithoutCache;
-  // Generate new cache for next compilation
-  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
-      ScriptCompiler::CreateCodeCacheForFunction(fun));
-  CHECK_NOT_NULL(new_cached_data);
 
-  // The old entry should've been erased by now so we can just emplace
-  code_cache_.emplace(id, std::move(new_cached_data));
+  if (*result == Result::kWithoutCache) {
+    // There either was no cached data yet, or V8 rejected it (e.g. the
+    // embedded cache was built with incompatible flags); serialize the
+    // freshly compiled function so that the next compilation of this
+    // module in this process - typically a booting Worker - deserializes
+    // instead. If a concurrent compilation got there first, keep the
+    // existing entry: replacing it would invalidate aliases that other
+    // threads may still be consuming.
+    std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+        ScriptCompiler::CreateCodeCacheForFunction(fun));
+    CHECK_NOT_NULL(new_cached_data);
+    Mutex::ScopedLock lock(shard->mutex);
+    shard->map.emplace(id, std::move(new_cached_data));
+  }
 
   return scope.Escape(fun);
 }
 
+// Modules that every bootstrap loads before user code runs. Compiling them
+// ahead of time on a worker thread populates the shared runtime code cache
+// (see code_cache_shards_), so the main thread deserializes them during
+// bootstrap instead of paying for a full parse and compile. Unknown ids
+// and ids covered by the embedded code cache are skipped, so the list only
+// has to be roughly right.
+static const char* const kBootstrapPrecompileIds[] = {
+    "internal/bootstrap/loaders",
+    "internal/bootstrap/node",
+    "internal/bootstrap/pre_execution",
+    "internal/main/run_main_module",
+    "internal/main/eval_string",
+    "internal/async_hooks",
+    "internal/buffer",
+    "internal/console/constructor",
+    "internal/console/global",
+    "internal/constants",
+    "internal/errors",
+    "internal/fixed_queue",
+    "internal/linkedlist",
+    "internal/modules/cjs/helpers",
+    "internal/modules/cjs/loader",
+    "internal/options",
+    "internal/priority_queue",
+    "internal/process/execution",
+    "internal/process/per_thread",
+    "internal/process/promises",
+    "internal/process/signal",
+    "internal/process/task_queues",
+    "internal/process/warning",
+    "internal/querystring",
+    "internal/timers",
+    "internal/url",
+    "internal/util",
+    "internal/util/debuglog",
+    "internal/util/inspect",
+    "internal/util/types",
+    "internal/validators",
+    "buffer",
+    "events",
+    "path",
+    "timers",
+    "util",
+};
+
+class BootstrapPrecompileTask : public v8::Task {
+ public:
+  explicit BootstrapPrecompileTask(MultiIsolatePlatform* platform)
+      : platform_(platform) {}
+
+  void Run() override {
+    NativeModuleLoader::GetInstance()->PrecompileBootstrap(platform_);
+  }
+
+ private:
+  MultiIsolatePlatform* platform_;
+};
+
+void NativeModuleLoader::PostBootstrapPrecompileTask(
+    MultiIsolatePlatform* platform) {
+  static std::atomic_flag posted = ATOMIC_FLAG_INIT;
+  if (posted.test_and_set()) return;
+  if (platform->NumberOfWorkerThreads() == 0) return;
+  platform->CallOnWorkerThread(
+      std::make_unique<BootstrapPrecompileTask>(platform));
+}
+
+void NativeModuleLoader::PrecompileBootstrap(MultiIsolatePlatform* platform) {
+  // Code cache data is valid across Isolates in the same process, so the
+  // compilation can happen on a private short-lived Isolate; only the
+  // serialized caches it leaves behind in the shards are ever consumed by
+  // other threads. The event loop exists solely to register the Isolate
+  // with the platform; it is never run.
+  uv_loop_t loop;
+  if (uv_loop_init(&loop) != 0) return;
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+  Isolate::CreateParams params;
+  params.array_buffer_allocator = allocator.get();
+  Isolate* isolate = Isolate::Allocate();
+  if (isolate == nullptr) {
+    CheckedUvLoopClose(&loop);
+    return;
+  }
+  platform->RegisterIsolate(isolate, &loop);
+  Isolate::Initialize(isolate, params);
+
+  {
+    v8::Locker locker(isolate);
+    Isolate::Scope isolate_scope(isolate);
+    HandleScope handle_scope(isolate);
+    Local<Context> context = Context::New(isolate);
+    Context::Scope context_scope(context);
+    for (const char* id : kBootstrapPrecompileIds) {
+      if (!Exists(id)) continue;
+      // Covered by the embedded code cache, or the main thread (or an
+      // earlier Worker) got there first.
+      if (GetCodeCache(id) != nullptr) continue;
+      Result result;
+      USE(CompileAsModule(context, id, &result));
+    }
+  }
+
+  bool platform_finished = false;
+  platform->AddIsolateFinishedCallback(isolate, [](void* data) {
+    *static_cast<bool*>(data) = true;
+  }, &platform_finished);
+  platform->UnregisterIsolate(isolate);
+  isolate->Dispose();
+  // Wait until the platform has cleaned up all relevant resources.
+  while (!platform_finished)
+    uv_run(&loop, UV_RUN_ONCE);
+  CheckedUvLoopClose(&loop);
+}
+
 }  // namespace native_module
 }  // namespace node
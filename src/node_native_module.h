@@ -15,6 +15,9 @@
 class PerProcessTest;
 
 namespace node {
+
+class MultiIsolatePlatform;
+
 namespace native_module {
 
 using NativeModuleRecordMap = std::map<std::string, UnionBytes>;
@@ -38,6 +41,7 @@ class NativeModuleLoader {
   // Only allow access from friends.
   friend class NativeModuleEnv;
   friend class CodeCacheBuilder;
+  friend class BootstrapPrecompileTask;
 
   NativeModuleLoader();
   static NativeModuleLoader* GetInstance();
@@ -64,7 +68,7 @@ class NativeModuleLoader {
   bool CannotBeRequired(const char* id);
 
   NativeModuleCacheMap* code_cache();
-  v8::ScriptCompiler::CachedData* GetCodeCache(const char* id) const;
+  v8::ScriptCompiler::CachedData* GetCodeCache(const char* id);
   enum class Result { kWithCache, kWithoutCache };
   // If an exception is encountered (e.g. source code contains
   // syntax error), the returned value is empty.
@@ -77,14 +81,39 @@ class NativeModuleLoader {
                                                const char* id,
                                                Result* result);
 
+  // Posts a task to the platform worker pool that compiles the known
+  // bootstrap module set into the shared runtime code cache on a
+  // throwaway Isolate, so that the main thread deserializes those modules
+  // instead of compiling them. Opportunistic: modules the main thread
+  // reaches before the worker are simply compiled as before.
+  static void PostBootstrapPrecompileTask(MultiIsolatePlatform* platform);
+  void PrecompileBootstrap(MultiIsolatePlatform* platform);
+
   static NativeModuleLoader instance_;
   ModuleCategories module_categories_;
   NativeModuleRecordMap source_;
+  // Code cache embedded into the binary, filled in once during
+  // single-threaded process initialization through
+  // NativeModuleEnv::InitializeCodeCache() and read-only afterwards,
+  // so it can be consulted without locking.
   NativeModuleCacheMap code_cache_;
   UnionBytes config_;
 
-  // Used to synchronize access to the code cache map
-  Mutex code_cache_mutex_;
+  // Runtime code cache, shared by all threads and Isolates in the process
+  // so that Workers deserialize modules that the main thread (or an
+  // earlier Worker) has already compiled instead of recompiling them.
+  // Sharded by module id hash so that concurrently booting Workers do not
+  // contend on a single lock. Entries are never erased or replaced once
+  // inserted; this keeps the cached buffers valid forever, allowing
+  // lookups to hand V8 non-owning aliases and release the shard lock for
+  // the duration of the compilation.
+  static constexpr size_t kCodeCacheShardCount = 8;
+  struct CodeCacheShard {
+    Mutex mutex;
+    NativeModuleCacheMap map;
+  };
+  CodeCacheShard* CacheShard(const char* id);
+  CodeCacheShard code_cache_shards_[kCodeCacheShardCount];
 
   friend class ::PerProcessTest;
 };
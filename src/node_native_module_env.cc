@@ -37,6 +37,11 @@ bool NativeModuleEnv::Exists(const char* id) {
   return NativeModuleLoader::GetInstance()->Exists(id);
 }
 
+void NativeModuleEnv::PrecompileBootstrapOnWorkerThread(
+    MultiIsolatePlatform* platform) {
+  NativeModuleLoader::PostBootstrapPrecompileTask(platform);
+}
+
 Local<Object> NativeModuleEnv::GetSourceObject(Local<Context> context) {
   return NativeModuleLoader::GetInstance()->GetSourceObject(context);
 }
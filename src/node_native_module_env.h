@@ -36,6 +36,11 @@ class NativeModuleEnv {
   // in node_code_cache_stub.cc
   static void InitializeCodeCache();
 
+  // Warms the shared runtime code cache for the bootstrap module set on a
+  // platform worker thread, concurrently with the main isolate and
+  // environment setup.
+  static void PrecompileBootstrapOnWorkerThread(MultiIsolatePlatform* platform);
+
  private:
   static void RecordResult(const char* id,
                            NativeModuleLoader::Result result,
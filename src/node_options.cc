@@ -12,6 +12,7 @@ using v8::Boolean;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::Integer;
+using v8::IntegrityLevel;
 using v8::Isolate;
 using v8::Local;
 using v8::Map;
@@ -70,6 +71,12 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
       use_largepages != "silent") {
     errors->push_back("invalid value for --use-largepages");
   }
+  if (!v8_tuning_profile.empty() &&
+      v8_tuning_profile != "server-throughput" &&
+      v8_tuning_profile != "low-memory" &&
+      v8_tuning_profile != "fast-startup") {
+    errors->push_back("invalid value for --v8-tuning-profile");
+  }
   per_isolate->CheckOptions(errors);
 }
 
@@ -176,16 +183,34 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
     if (!cpu_prof_name.empty()) {
       errors->push_back("--cpu-prof-name must be used with --cpu-prof");
     }
-    if (!cpu_prof_dir.empty()) {
+    // The directory and sampling interval are shared with the flight
+    // recorder mode.
+    if (!cpu_prof_dir.empty() && !cpu_prof_flight_recorder) {
       errors->push_back("--cpu-prof-dir must be used with --cpu-prof");
     }
     // We can't catch the case where the value passed is the default value,
     // then the option just becomes a noop which is fine.
-    if (cpu_prof_interval != kDefaultCpuProfInterval) {
+    if (cpu_prof_interval != kDefaultCpuProfInterval &&
+        !cpu_prof_flight_recorder) {
       errors->push_back("--cpu-prof-interval must be used with --cpu-prof");
     }
   }
 
+  if (!cpu_prof_flight_recorder) {
+    // We can't catch the case where the value passed is the default value,
+    // then the option just becomes a noop which is fine.
+    if (cpu_prof_flight_window != kDefaultCpuProfFlightWindow) {
+      errors->push_back("--cpu-prof-flight-window must be used with "
+                        "--cpu-prof-flight-recorder");
+    }
+    if (!cpu_prof_flight_signal.empty()) {
+      errors->push_back("--cpu-prof-flight-signal must be used with "
+                        "--cpu-prof-flight-recorder");
+    }
+  } else if (cpu_prof_flight_window == 0) {
+    errors->push_back("--cpu-prof-flight-window must be greater than 0");
+  }
+
   if (!heap_prof) {
     if (!heap_prof_name.empty()) {
       errors->push_back("--heap-prof-name must be used with --heap-prof");
@@ -312,6 +337,16 @@ DebugOptionsParser::DebugOptionsParser() {
 }
 
 EnvironmentOptionsParser::EnvironmentOptionsParser() {
+  AddOption("--compile-cache-dir",
+            "store and reuse compiled code caches for CommonJS modules "
+            "in the given directory",
+            &EnvironmentOptions::compile_cache_dir,
+            kAllowedInEnvironment);
+  AddOption("--compile-cache-max-size",
+            "maximum total size in bytes of the on-disk compile cache "
+            "(default: 268435456 (256MB))",
+            &EnvironmentOptions::compile_cache_max_size,
+            kAllowedInEnvironment);
   AddOption("--enable-source-maps",
             "experimental Source Map V3 support",
             &EnvironmentOptions::enable_source_maps,
@@ -445,6 +480,27 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "Directory where the V8 profiles generated by --cpu-prof will be "
             "placed. Does not affect --prof.",
             &EnvironmentOptions::cpu_prof_dir);
+  AddOption("--cpu-prof-flight-recorder",
+            "Continuously sample the CPU into a bounded in-memory buffer, "
+            "keeping roughly the last --cpu-prof-flight-window seconds, and "
+            "write a CPU profile to disk only on demand.",
+            &EnvironmentOptions::cpu_prof_flight_recorder);
+  AddOption("--cpu-prof-flight-window",
+            "seconds of samples retained by --cpu-prof-flight-recorder. "
+            "(default: 30)",
+            &EnvironmentOptions::cpu_prof_flight_window);
+  AddOption("--cpu-prof-flight-signal",
+            "Dump the --cpu-prof-flight-recorder buffer on specified signal",
+            &EnvironmentOptions::cpu_prof_flight_signal,
+            kAllowedInEnvironment);
+  AddOption("--coverage-stream-interval",
+            "when NODE_V8_COVERAGE is set, append incremental coverage "
+            "deltas to a stream file in the coverage directory every "
+            "specified number of milliseconds instead of writing one "
+            "JSON dump of the accumulated result at exit. "
+            "(default: 0, disabled)",
+            &EnvironmentOptions::coverage_stream_interval,
+            kAllowedInEnvironment);
   AddOption(
       "--heap-prof",
       "Start the V8 heap profiler on start up, and write the heap profile "
@@ -468,16 +524,53 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "set the maximum size of HTTP headers (default: 8192 (8KB))",
             &EnvironmentOptions::max_http_header_size,
             kAllowedInEnvironment);
+  AddOption("--message-port-drain-budget",
+            "maximum number of MessagePort messages delivered per event "
+            "loop turn; bounds loop-turn latency under heavy worker "
+            "messaging. 0 (the default) processes whatever is queued when "
+            "draining starts, but at least 1000 messages",
+            &EnvironmentOptions::message_port_drain_budget,
+            kAllowedInEnvironment);
+  AddOption("--busy-poll-window",
+            "after activity on a socket marked with setBusyPoll(), keep "
+            "polling the event loop without blocking for this many "
+            "microseconds; trades CPU for receive latency. 0 (the default) "
+            "disables busy polling",
+            &EnvironmentOptions::busy_poll_window,
+            kAllowedInEnvironment);
+  AddOption("--loop-stall-threshold",
+            "capture a JS stack sample whenever an event loop turn takes "
+            "longer than this many milliseconds; samples are retrievable "
+            "via process.loopStallSamples(). 0 (the default) disables the "
+            "watchdog",
+            &EnvironmentOptions::loop_stall_threshold,
+            kAllowedInEnvironment);
+  AddOption("--recycle-async-ids",
+            "reuse the async ids of fully destroyed resources so that ids "
+            "stay in the small-integer range in long-lived processes",
+            &EnvironmentOptions::recycle_async_ids,
+            kAllowedInEnvironment);
   AddOption("--redirect-warnings",
             "write warnings to file instead of stderr",
             &EnvironmentOptions::redirect_warnings,
             kAllowedInEnvironment);
   AddOption("--test-udp-no-try-send", "",  // For testing only.
             &EnvironmentOptions::test_udp_no_try_send);
+  AddOption("--threadpool-cpu-limit",
+            "maximum number of CPU-bound threadpool jobs (zlib, crypto) "
+            "running concurrently; keeps threadpool threads available for "
+            "file system and DNS requests. 0 (the default) applies no limit",
+            &EnvironmentOptions::threadpool_cpu_limit,
+            kAllowedInEnvironment);
   AddOption("--throw-deprecation",
             "throw an exception on deprecations",
             &EnvironmentOptions::throw_deprecation,
             kAllowedInEnvironment);
+  AddOption("--trace-bindings",
+            "print the initialization time of each internal binding to "
+            "stderr",
+            &EnvironmentOptions::trace_bindings,
+            kAllowedInEnvironment);
   AddOption("--trace-deprecation",
             "show stack traces on deprecations",
             &EnvironmentOptions::trace_deprecation,
@@ -508,6 +601,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "an error), 'warn' (enforce warnings) or 'none' (silence warnings)",
             &EnvironmentOptions::unhandled_rejections,
             kAllowedInEnvironment);
+  AddOption("--worker-spawn-budget",
+            "fail worker threads whose environment setup takes longer than "
+            "this many milliseconds (default: 0, no deadline)",
+            &EnvironmentOptions::worker_spawn_budget,
+            kAllowedInEnvironment);
 
   AddOption("--check",
             "syntax check script without executing",
@@ -653,6 +751,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "the process title to use on startup",
             &PerProcessOptions::title,
             kAllowedInEnvironment);
+  AddOption("--trace-event-binary-file",
+            "write trace events as fixed-size binary records to an mmap'd "
+            "ring file at this path instead of JSON; it supports ${pid}",
+            &PerProcessOptions::trace_event_binary_file,
+            kAllowedInEnvironment);
   AddOption("--trace-event-categories",
             "comma separated list of trace event categories to record",
             &PerProcessOptions::trace_event_categories,
@@ -668,6 +771,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--v8-pool-cpuset",
+            "pin V8's worker thread pool to this set of CPUs, "
+            "e.g. '0,2-3' (Linux only)",
+            &PerProcessOptions::v8_pool_cpuset,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -758,6 +866,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "Map the Node.js static code to large pages",
             &PerProcessOptions::use_largepages,
             kAllowedInEnvironment);
+  AddOption("--v8-tuning-profile",
+            "apply a named V8 tuning profile scaled to the available "
+            "memory (server-throughput, low-memory or fast-startup)",
+            &PerProcessOptions::v8_tuning_profile,
+            kAllowedInEnvironment);
 
   Insert(iop, &PerProcessOptions::get_per_isolate_options);
 }
@@ -846,13 +959,22 @@ std::string GetBashCompletion() {
 // Return a map containing all the options and their metadata as well
 // as the aliases
 void GetOptions(const FunctionCallbackInfo<Value>& args) {
-  Mutex::ScopedLock lock(per_process::cli_options_mutex);
   Environment* env = Environment::GetCurrent(args);
   if (!env->has_run_bootstrapping_code()) {
     // No code because this is an assertion.
     return env->ThrowError(
         "Should not query options before bootstrapping is done");
   }
+
+  // Options do not change after parsing, so serialize them once per
+  // Environment and hand out the same frozen object on every later call
+  // instead of re-walking the option maps.
+  if (!env->serialized_options().IsEmpty()) {
+    args.GetReturnValue().Set(env->serialized_options());
+    return;
+  }
+
+  Mutex::ScopedLock lock(per_process::cli_options_mutex);
   env->set_has_serialized_options(true);
 
   Isolate* isolate = env->isolate();
@@ -961,10 +1083,12 @@ void GetOptions(const FunctionCallbackInfo<Value>& args) {
 
   Local<Object> ret = Object::New(isolate);
   if (ret->Set(context, env->options_string(), options).IsNothing() ||
-      ret->Set(context, env->aliases_string(), aliases).IsNothing()) {
+      ret->Set(context, env->aliases_string(), aliases).IsNothing() ||
+      ret->SetIntegrityLevel(context, IntegrityLevel::kFrozen).IsNothing()) {
     return;
   }
 
+  env->set_serialized_options(ret);
   args.GetReturnValue().Set(ret);
 }
 
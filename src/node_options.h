@@ -100,6 +100,8 @@ class DebugOptions : public Options {
 class EnvironmentOptions : public Options {
  public:
   bool abort_on_uncaught_exception = false;
+  std::string compile_cache_dir;
+  uint64_t compile_cache_max_size = 256 * 1024 * 1024;
   bool enable_source_maps = false;
   bool experimental_conditional_exports = false;
   bool experimental_json_modules = false;
@@ -116,6 +118,7 @@ class EnvironmentOptions : public Options {
   bool frozen_intrinsics = false;
   std::string heap_snapshot_signal;
   uint64_t max_http_header_size = 8 * 1024;
+  uint64_t message_port_drain_budget = 0;
   bool no_deprecation = false;
   bool no_force_async_hooks_checks = false;
   bool no_warnings = false;
@@ -130,15 +133,25 @@ class EnvironmentOptions : public Options {
   uint64_t cpu_prof_interval = kDefaultCpuProfInterval;
   std::string cpu_prof_name;
   bool cpu_prof = false;
+  bool cpu_prof_flight_recorder = false;
+  static const uint64_t kDefaultCpuProfFlightWindow = 30;
+  uint64_t cpu_prof_flight_window = kDefaultCpuProfFlightWindow;
+  std::string cpu_prof_flight_signal;
+  uint64_t coverage_stream_interval = 0;
   std::string heap_prof_dir;
   std::string heap_prof_name;
   static const uint64_t kDefaultHeapProfInterval = 512 * 1024;
   uint64_t heap_prof_interval = kDefaultHeapProfInterval;
   bool heap_prof = false;
 #endif  // HAVE_INSPECTOR
+  uint64_t busy_poll_window = 0;
+  uint64_t loop_stall_threshold = 0;
+  bool recycle_async_ids = false;
   std::string redirect_warnings;
   bool test_udp_no_try_send = false;
+  uint64_t threadpool_cpu_limit = 0;
   bool throw_deprecation = false;
+  bool trace_bindings = false;
   bool trace_deprecation = false;
   bool trace_exit = false;
   bool trace_sync_io = false;
@@ -147,6 +160,7 @@ class EnvironmentOptions : public Options {
   bool trace_warnings = false;
   std::string unhandled_rejections;
   std::string userland_loader;
+  uint64_t worker_spawn_budget = 0;
 
   bool syntax_check_only = false;
   bool has_eval_string = false;
@@ -205,8 +219,10 @@ class PerProcessOptions : public Options {
 
   std::string title;
   std::string trace_event_categories;
+  std::string trace_event_binary_file;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
   int64_t v8_thread_pool_size = 4;
+  std::string v8_pool_cpuset;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
 
@@ -237,6 +253,7 @@ class PerProcessOptions : public Options {
 #endif
 #endif
   std::string use_largepages = "off";
+  std::string v8_tuning_profile;
 
 #ifdef NODE_REPORT
   std::vector<std::string> cmdline;
@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "env-inl.h"
+#include "node_internals.h"
 #include "string_bytes.h"
 
 #ifdef __MINGW32__
@@ -31,11 +32,114 @@
 # include <climits>         // PATH_MAX on Solaris.
 #endif  // __POSIX__
 
+#ifdef __linux__
+# include <sched.h>         // sched_getaffinity
+#endif  // __linux__
+
 #include <array>
 #include <cerrno>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
 
 namespace node {
+
+#ifdef __linux__
+namespace {
+
+// Reads a single integer from a (proc/sysfs) file; returns false when the
+// file does not exist or does not start with a number.
+bool ReadFileLongLong(const char* path, int64_t* value) {
+  FILE* fp = fopen(path, "r");
+  if (fp == nullptr)
+    return false;
+  long long parsed;
+  int matched = fscanf(fp, "%lld", &parsed);
+  fclose(fp);
+  if (matched != 1)
+    return false;
+  *value = parsed;
+  return true;
+}
+
+// Returns the cgroup CPU quota that applies to this process as a number of
+// CPUs, or a negative value when no quota is in effect. Inside containers
+// the process's own cgroup is what is mounted at /sys/fs/cgroup, so the
+// static paths cover the Docker/Kubernetes case without parsing
+// /proc/self/cgroup.
+double CgroupCPUQuota() {
+  // cgroup v2: "cpu.max" holds "<quota> <period>" or "max <period>".
+  FILE* fp = fopen("/sys/fs/cgroup/cpu.max", "r");
+  if (fp != nullptr) {
+    char quota_str[32];
+    long long period;
+    int matched = fscanf(fp, "%31s %lld", quota_str, &period);
+    fclose(fp);
+    if (matched == 2 && strcmp(quota_str, "max") != 0 && period > 0) {
+      long long quota = strtoll(quota_str, nullptr, 10);
+      if (quota > 0)
+        return static_cast<double>(quota) / static_cast<double>(period);
+    }
+    return -1;
+  }
+
+  // cgroup v1: cpu.cfs_quota_us is -1 when unlimited.
+  static const char* const quota_paths[] = {
+      "/sys/fs/cgroup/cpu/cpu.cfs_quota_us",
+      "/sys/fs/cgroup/cpu,cpuacct/cpu.cfs_quota_us"};
+  static const char* const period_paths[] = {
+      "/sys/fs/cgroup/cpu/cpu.cfs_period_us",
+      "/sys/fs/cgroup/cpu,cpuacct/cpu.cfs_period_us"};
+  for (size_t i = 0; i < arraysize(quota_paths); i++) {
+    int64_t quota;
+    int64_t period;
+    if (ReadFileLongLong(quota_paths[i], &quota) &&
+        ReadFileLongLong(period_paths[i], &period) &&
+        quota > 0 && period > 0) {
+      return static_cast<double>(quota) / static_cast<double>(period);
+    }
+  }
+  return -1;
+}
+
+}  // anonymous namespace
+#endif  // __linux__
+
+int GetAvailableParallelism() {
+  uv_cpu_info_t* cpu_infos;
+  int count = 0;
+  if (uv_cpu_info(&cpu_infos, &count) == 0)
+    uv_free_cpu_info(cpu_infos, count);
+  if (count <= 0)
+    count = 1;
+
+#ifdef __linux__
+  cpu_set_t mask;
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    int allowed = CPU_COUNT(&mask);
+    if (allowed > 0 && allowed < count)
+      count = allowed;
+  }
+
+  double quota = CgroupCPUQuota();
+  if (quota > 0) {
+    int rounded = static_cast<int>(std::ceil(quota));
+    if (rounded < count)
+      count = rounded;
+  }
+#endif  // __linux__
+
+  return count > 0 ? count : 1;
+}
+
+uint64_t GetEffectiveMemory() {
+  uint64_t total = uv_get_total_memory();
+  uint64_t constrained = uv_get_constrained_memory();
+  if (constrained == 0 || constrained > total)
+    return total;
+  return constrained;
+}
+
 namespace os {
 
 using v8::Array;
@@ -142,6 +246,77 @@ static void GetCPUInfo(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Returns only the static per-core data in the format
+// [model, speed, model2, speed2, ...]. The changing tick counters are read
+// separately through RefreshCPUTimes() so that pollers do not pay for
+// rebuilding the model strings on every call.
+static void GetCPUTopology(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  uv_cpu_info_t* cpu_infos;
+  int count;
+
+  int err = uv_cpu_info(&cpu_infos, &count);
+  if (err)
+    return;
+
+  std::vector<Local<Value>> result(count * 2);
+  for (int i = 0, j = 0; i < count; i++) {
+    uv_cpu_info_t* ci = cpu_infos + i;
+    result[j++] = OneByteString(isolate, ci->model);
+    result[j++] = Number::New(isolate, ci->speed);
+  }
+
+  uv_free_cpu_info(cpu_infos, count);
+  args.GetReturnValue().Set(Array::New(isolate, result.data(), result.size()));
+}
+
+
+// Fills the caller-provided Float64Array with five tick counters per core
+// (user, nice, sys, idle, irq) and returns the core count, allocating
+// nothing on the JS heap. When the array is too small — first call, or the
+// core count changed — nothing is written and the caller is expected to
+// re-read the topology and resize.
+static void RefreshCPUTimes(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+
+  uv_cpu_info_t* cpu_infos;
+  int count;
+
+  int err = uv_cpu_info(&cpu_infos, &count);
+  if (err)
+    return;
+
+  if (static_cast<size_t>(count) * 5 <= array->Length()) {
+    Local<ArrayBuffer> ab = array->Buffer();
+    double* times = static_cast<double*>(ab->GetBackingStore()->Data());
+    for (int i = 0, j = 0; i < count; i++) {
+      uv_cpu_info_t* ci = cpu_infos + i;
+      times[j++] = static_cast<double>(ci->cpu_times.user);
+      times[j++] = static_cast<double>(ci->cpu_times.nice);
+      times[j++] = static_cast<double>(ci->cpu_times.sys);
+      times[j++] = static_cast<double>(ci->cpu_times.idle);
+      times[j++] = static_cast<double>(ci->cpu_times.irq);
+    }
+  }
+
+  uv_free_cpu_info(cpu_infos, count);
+  args.GetReturnValue().Set(count);
+}
+
+
+static void AvailableParallelism(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(node::GetAvailableParallelism());
+}
+
+
+static void EffectiveMemory(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(static_cast<double>(node::GetEffectiveMemory()));
+}
+
+
 static void GetFreeMemory(const FunctionCallbackInfo<Value>& args) {
   double amount = uv_get_free_memory();
   if (amount < 0)
@@ -397,7 +572,11 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "getUptime", GetUptime);
   env->SetMethod(target, "getTotalMem", GetTotalMemory);
   env->SetMethod(target, "getFreeMem", GetFreeMemory);
+  env->SetMethod(target, "availableParallelism", AvailableParallelism);
+  env->SetMethod(target, "effectiveMemory", EffectiveMemory);
   env->SetMethod(target, "getCPUs", GetCPUInfo);
+  env->SetMethod(target, "getCPUTopology", GetCPUTopology);
+  env->SetMethod(target, "refreshCPUTimes", RefreshCPUTimes);
   env->SetMethod(target, "getOSType", GetOSType);
   env->SetMethod(target, "getOSRelease", GetOSRelease);
   env->SetMethod(target, "getInterfaceAddresses", GetInterfaceAddresses);
@@ -8,10 +8,27 @@
 
 #include <cinttypes>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#if defined(__linux__) && defined(__NR_perf_event_open)
+#define NODE_HAVE_PERF_COUNTERS 1
+#endif
+
 namespace node {
 namespace performance {
 
 using v8::Array;
+using v8::BigInt;
 using v8::Context;
 using v8::DontDelete;
 using v8::Function;
@@ -38,6 +55,15 @@ using v8::Value;
 // Microseconds in a millisecond, as a float.
 #define MICROS_PER_MILLIS 1e3
 
+#ifdef NODE_HAVE_PERF_COUNTERS
+static void SnapshotCountersForMark(const char* name);
+static void ErasePerfCounterMarks(const char* name);
+static void AttachCounterDeltas(Environment* env,
+                                Local<Object> obj,
+                                const char* start_mark,
+                                const char* end_mark);
+#endif  // NODE_HAVE_PERF_COUNTERS
+
 // https://w3c.github.io/hr-time/#dfn-time-origin
 const uint64_t timeOrigin = PERFORMANCE_NOW();
 // https://w3c.github.io/hr-time/#dfn-time-origin-timestamp
@@ -136,6 +162,10 @@ void Mark(const FunctionCallbackInfo<Value>& args) {
   auto marks = env->performance_marks();
   (*marks)[*name] = now;
 
+#ifdef NODE_HAVE_PERF_COUNTERS
+  SnapshotCountersForMark(*name);
+#endif
+
   TRACE_EVENT_COPY_MARK_WITH_TIMESTAMP(
       TRACING_CATEGORY_NODE2(perf, usertiming),
       *name, now / 1000);
@@ -153,9 +183,15 @@ void ClearMark(const FunctionCallbackInfo<Value>& args) {
 
   if (args.Length() == 0) {
     marks->clear();
+#ifdef NODE_HAVE_PERF_COUNTERS
+    ErasePerfCounterMarks(nullptr);
+#endif
   } else {
     Utf8Value name(env->isolate(), args[0]);
     marks->erase(*name);
+#ifdef NODE_HAVE_PERF_COUNTERS
+    ErasePerfCounterMarks(*name);
+#endif
   }
 }
 
@@ -206,6 +242,9 @@ void Measure(const FunctionCallbackInfo<Value>& args) {
   PerformanceEntry entry(env, *name, "measure", startTimestamp, endTimestamp);
   Local<Object> obj;
   if (!entry.ToObject().ToLocal(&obj)) return;
+#ifdef NODE_HAVE_PERF_COUNTERS
+  AttachCounterDeltas(env, obj, *startMark, *endMark);
+#endif
   PerformanceEntry::Notify(env, entry.kind(), obj);
   args.GetReturnValue().Set(obj);
 }
@@ -302,6 +341,182 @@ static void RemoveGarbageCollectionTracking(
   GarbageCollectionCleanupHook(env);
 }
 
+// Hardware performance counters (Linux perf_event). Counters are opened
+// per-thread and counted in user mode only, so they work without elevated
+// perf_event_paranoid settings wherever self-profiling is permitted. All
+// state is thread-local: each Environment runs on its own thread and the
+// counters follow the thread that opened them.
+#ifdef NODE_HAVE_PERF_COUNTERS
+struct HardwareCounterDef {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+static const HardwareCounterDef kHardwareCounters[] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "cacheReferences", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+  { "cacheMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { "branchMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+constexpr size_t kHardwareCounterCount = arraysize(kHardwareCounters);
+
+struct PerfCounterState {
+  int fds[kHardwareCounterCount];
+  bool open = false;
+  // Counter values recorded by Mark() while counting is enabled, so that
+  // Measure() can attach per-counter deltas to the resulting entry.
+  std::unordered_map<std::string,
+                     std::array<uint64_t, kHardwareCounterCount>> mark_values;
+
+  PerfCounterState() {
+    for (size_t i = 0; i < kHardwareCounterCount; i++) fds[i] = -1;
+  }
+};
+
+static thread_local PerfCounterState perf_counter_state;
+
+static int PerfEventOpen(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, -1,
+                 PERF_FLAG_FD_CLOEXEC);
+}
+
+static bool ReadCounterValues(uint64_t* values) {
+  PerfCounterState* state = &perf_counter_state;
+  for (size_t i = 0; i < kHardwareCounterCount; i++) {
+    if (read(state->fds[i], &values[i], sizeof(uint64_t)) !=
+        static_cast<ssize_t>(sizeof(uint64_t))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void CloseCounters(PerfCounterState* state) {
+  for (size_t i = 0; i < kHardwareCounterCount; i++) {
+    if (state->fds[i] != -1) {
+      close(state->fds[i]);
+      state->fds[i] = -1;
+    }
+  }
+  state->open = false;
+  state->mark_values.clear();
+}
+
+// Records the current counter values under a mark name so that a later
+// Measure() between two marks can report deltas.
+static void SnapshotCountersForMark(const char* name) {
+  PerfCounterState* state = &perf_counter_state;
+  if (!state->open) return;
+  std::array<uint64_t, kHardwareCounterCount> values;
+  if (ReadCounterValues(values.data()))
+    state->mark_values[name] = values;
+}
+
+// Drops the counter snapshot for a cleared mark; nullptr clears them all.
+static void ErasePerfCounterMarks(const char* name) {
+  PerfCounterState* state = &perf_counter_state;
+  if (name == nullptr)
+    state->mark_values.clear();
+  else
+    state->mark_values.erase(name);
+}
+
+// Attaches per-counter deltas between two marks to a measure entry.
+static void AttachCounterDeltas(Environment* env,
+                                Local<Object> obj,
+                                const char* start_mark,
+                                const char* end_mark) {
+  PerfCounterState* state = &perf_counter_state;
+  if (!state->open) return;
+  auto start_it = state->mark_values.find(start_mark);
+  auto end_it = state->mark_values.find(end_mark);
+  if (start_it == state->mark_values.end() ||
+      end_it == state->mark_values.end()) {
+    return;
+  }
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  PropertyAttribute attr =
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete);
+  for (size_t i = 0; i < kHardwareCounterCount; i++) {
+    uint64_t delta = end_it->second[i] - start_it->second[i];
+    obj->DefineOwnProperty(context,
+                           OneByteString(isolate, kHardwareCounters[i].name),
+                           BigInt::NewFromUnsigned(isolate, delta),
+                           attr).Check();
+  }
+}
+#endif  // NODE_HAVE_PERF_COUNTERS
+
+// Opens (if necessary), resets and enables the per-thread hardware
+// counters. Returns false where perf_event is unavailable or denied.
+static void CountersStart(const FunctionCallbackInfo<Value>& args) {
+#ifdef NODE_HAVE_PERF_COUNTERS
+  PerfCounterState* state = &perf_counter_state;
+  if (!state->open) {
+    for (size_t i = 0; i < kHardwareCounterCount; i++) {
+      int fd = PerfEventOpen(kHardwareCounters[i].type,
+                             kHardwareCounters[i].config);
+      if (fd < 0) {
+        CloseCounters(state);
+        return args.GetReturnValue().Set(false);
+      }
+      state->fds[i] = fd;
+    }
+    state->open = true;
+  }
+  for (size_t i = 0; i < kHardwareCounterCount; i++) {
+    ioctl(state->fds[i], PERF_EVENT_IOC_RESET, 0);
+    ioctl(state->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+  }
+  args.GetReturnValue().Set(true);
+#else
+  args.GetReturnValue().Set(false);
+#endif  // NODE_HAVE_PERF_COUNTERS
+}
+
+static void CountersStop(const FunctionCallbackInfo<Value>& args) {
+#ifdef NODE_HAVE_PERF_COUNTERS
+  PerfCounterState* state = &perf_counter_state;
+  if (!state->open) return;
+  for (size_t i = 0; i < kHardwareCounterCount; i++)
+    ioctl(state->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+  CloseCounters(state);
+#endif  // NODE_HAVE_PERF_COUNTERS
+}
+
+// Returns the current counter values as an object of BigInts, or nothing
+// (undefined) while the counters are not running.
+static void CountersRead(const FunctionCallbackInfo<Value>& args) {
+#ifdef NODE_HAVE_PERF_COUNTERS
+  Environment* env = Environment::GetCurrent(args);
+  PerfCounterState* state = &perf_counter_state;
+  if (!state->open) return;
+  uint64_t values[kHardwareCounterCount];
+  if (!ReadCounterValues(values)) return;
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  Local<Object> obj = Object::New(isolate);
+  for (size_t i = 0; i < kHardwareCounterCount; i++) {
+    obj->Set(context,
+             OneByteString(isolate, kHardwareCounters[i].name),
+             BigInt::NewFromUnsigned(isolate, values[i])).Check();
+  }
+  args.GetReturnValue().Set(obj);
+#endif  // NODE_HAVE_PERF_COUNTERS
+}
+
 // Gets the name of a function
 inline Local<Value> GetName(Local<Function> fn) {
   Local<Value> val = fn->GetDebugName();
@@ -472,6 +687,79 @@ static void ELDHistogramNew(const FunctionCallbackInfo<Value>& args) {
   CHECK_GT(resolution, 0);
   new ELDHistogram(env, args.This(), resolution);
 }
+
+// General purpose histogram, filled one sample at a time from JavaScript.
+static void HistogramRecord(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  int64_t value = args[0]->IntegerValue(env->context()).FromJust();
+  args.GetReturnValue().Set(histogram->Record(value));
+}
+
+static void HistogramMin(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(histogram->Min()));
+}
+
+static void HistogramMax(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(histogram->Max()));
+}
+
+static void HistogramMean(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Mean());
+}
+
+static void HistogramStddev(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Stddev());
+}
+
+static void HistogramPercentile(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double percentile = args[0].As<Number>()->Value();
+  args.GetReturnValue().Set(histogram->Percentile(percentile));
+}
+
+static void HistogramPercentiles(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsMap());
+  Local<Map> map = args[0].As<Map>();
+  histogram->Percentiles([&](double key, double value) {
+    map->Set(env->context(),
+             Number::New(env->isolate(), key),
+             Number::New(env->isolate(), value)).IsEmpty();
+  });
+}
+
+static void HistogramReset(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->Reset();
+}
+
+static void HistogramNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  int64_t lowest = args[0]->IntegerValue(env->context()).FromJust();
+  int64_t highest = args[1]->IntegerValue(env->context()).FromJust();
+  int32_t figures = args[2]->Int32Value(env->context()).FromJust();
+  CHECK_GT(lowest, 0);
+  CHECK_GT(highest, lowest);
+  CHECK(figures >= 1 && figures <= 5);
+  new RecordableHistogram(env, args.This(), lowest, highest, figures);
+}
 }  // namespace
 
 ELDHistogram::ELDHistogram(
@@ -542,6 +830,32 @@ bool ELDHistogram::Disable() {
   return true;
 }
 
+// Snapshot of the always-on native loop-latency histogram (see
+// Environment::loop_latency_histogram()). Reading the histogram does not
+// pause or reset recording.
+void LoopLatency(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Histogram* histogram = env->loop_latency_histogram();
+  Local<Context> context = env->context();
+  Isolate* isolate = env->isolate();
+
+  Local<Object> obj = Object::New(isolate);
+  const auto set = [&](const char* name, double value) {
+    obj->Set(context,
+             OneByteString(isolate, name),
+             Number::New(isolate, value)).Check();
+  };
+  set("min", static_cast<double>(histogram->Min()));
+  set("max", static_cast<double>(histogram->Max()));
+  set("mean", histogram->Mean());
+  set("stddev", histogram->Stddev());
+  set("p50", histogram->Percentile(50));
+  set("p90", histogram->Percentile(90));
+  set("p99", histogram->Percentile(99));
+
+  args.GetReturnValue().Set(obj);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -556,6 +870,9 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).Check();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "loopPhases"),
+              state->loop_phases.GetJSArray()).Check();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -579,6 +896,10 @@ void Initialize(Local<Object> target,
                  "removeGarbageCollectionTracking",
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
+  env->SetMethod(target, "loopLatency", LoopLatency);
+  env->SetMethod(target, "countersStart", CountersStart);
+  env->SetMethod(target, "countersStop", CountersStop);
+  env->SetMethod(target, "countersRead", CountersRead);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -597,6 +918,11 @@ void Initialize(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_LOOP_PHASE_##name);
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -633,6 +959,23 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
   target->Set(context, eldh_classname,
               eldh->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  Local<String> histogram_classname =
+      FIXED_ONE_BYTE_STRING(isolate, "Histogram");
+  Local<FunctionTemplate> histogram =
+      env->NewFunctionTemplate(HistogramNew);
+  histogram->SetClassName(histogram_classname);
+  histogram->InstanceTemplate()->SetInternalFieldCount(1);
+  env->SetProtoMethod(histogram, "record", HistogramRecord);
+  env->SetProtoMethod(histogram, "min", HistogramMin);
+  env->SetProtoMethod(histogram, "max", HistogramMax);
+  env->SetProtoMethod(histogram, "mean", HistogramMean);
+  env->SetProtoMethod(histogram, "stddev", HistogramStddev);
+  env->SetProtoMethod(histogram, "percentile", HistogramPercentile);
+  env->SetProtoMethod(histogram, "percentiles", HistogramPercentiles);
+  env->SetProtoMethod(histogram, "reset", HistogramReset);
+  target->Set(context, histogram_classname,
+              histogram->GetFunction(env->context()).ToLocalChecked()).Check();
 }
 
 }  // namespace performance
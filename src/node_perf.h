@@ -125,6 +125,29 @@ class GCPerformanceEntry : public PerformanceEntry {
   PerformanceGCKind gckind_;
 };
 
+// A Histogram that is filled explicitly from JavaScript, one sample at a
+// time. Used, for example, by the benchmark drivers to record latency
+// distributions without keeping every sample around.
+class RecordableHistogram : public BaseObject, public Histogram {
+ public:
+  RecordableHistogram(Environment* env,
+                      Local<Object> wrap,
+                      int64_t lowest,
+                      int64_t highest,
+                      int figures)
+      : BaseObject(env, wrap),
+        Histogram(lowest, highest, figures) {
+    MakeWeak();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("histogram", GetMemorySize());
+  }
+
+  SET_MEMORY_INFO_NAME(RecordableHistogram)
+  SET_SELF_SIZE(RecordableHistogram)
+};
+
 class ELDHistogram : public HandleWrap, public Histogram {
  public:
   ELDHistogram(Environment* env,
@@ -29,6 +29,16 @@ extern uint64_t performance_v8_start;
   V(BOOTSTRAP_COMPLETE, "bootstrapComplete")
 
 
+// Cumulative per-phase event loop timing. Phases not listed here (close
+// callbacks, pending callbacks) are not separately observable without
+// modifying libuv; the poll value covers the poll phase including I/O
+// callbacks. ITERATIONS counts loop turns rather than time.
+#define NODE_PERFORMANCE_LOOP_PHASES(V)                                       \
+  V(TIMERS, "timers")                                                         \
+  V(POLL, "poll")                                                             \
+  V(CHECK, "check")                                                           \
+  V(ITERATIONS, "iterations")
+
 #define NODE_PERFORMANCE_ENTRY_TYPES(V)                                       \
   V(NODE, "node")                                                             \
   V(MARK, "mark")                                                             \
@@ -36,7 +46,8 @@ extern uint64_t performance_v8_start;
   V(GC, "gc")                                                                 \
   V(FUNCTION, "function")                                                     \
   V(HTTP2, "http2")                                                           \
-  V(HTTP, "http")
+  V(HTTP, "http")                                                             \
+  V(WORKER, "worker")
 
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
@@ -52,6 +63,13 @@ enum PerformanceEntryType {
   NODE_PERFORMANCE_ENTRY_TYPE_INVALID
 };
 
+enum PerformanceLoopPhase {
+#define V(name, _) NODE_PERFORMANCE_LOOP_PHASE_##name,
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+  NODE_PERFORMANCE_LOOP_PHASE_INVALID
+};
+
 class performance_state {
  public:
   explicit performance_state(v8::Isolate* isolate) :
@@ -63,6 +81,11 @@ class performance_state {
       offsetof(performance_state_internal, milestones),
       NODE_PERFORMANCE_MILESTONE_INVALID,
       root),
+    loop_phases(
+      isolate,
+      offsetof(performance_state_internal, loop_phases),
+      NODE_PERFORMANCE_LOOP_PHASE_INVALID,
+      root),
     observers(
       isolate,
       offsetof(performance_state_internal, observers),
@@ -70,10 +93,13 @@ class performance_state {
       root) {
     for (size_t i = 0; i < milestones.Length(); i++)
       milestones[i] = -1.;
+    for (size_t i = 0; i < loop_phases.Length(); i++)
+      loop_phases[i] = 0.;
   }
 
   AliasedUint8Array root;
   AliasedFloat64Array milestones;
+  AliasedFloat64Array loop_phases;
   AliasedUint32Array observers;
 
   uint64_t performance_last_gc_start_mark = 0;
@@ -81,10 +107,23 @@ class performance_state {
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
+  // Adds `duration` (in nanoseconds) to the cumulative time counter of the
+  // given event loop phase. The counters are stored in milliseconds so that
+  // they can be read from JS without conversion.
+  inline void AddLoopPhaseTime(enum PerformanceLoopPhase phase,
+                               uint64_t duration) {
+    loop_phases[phase] += duration / 1e6;
+  }
+
+  inline void IncrementLoopIterations() {
+    loop_phases[NODE_PERFORMANCE_LOOP_PHASE_ITERATIONS] += 1.;
+  }
+
  private:
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double loop_phases[NODE_PERFORMANCE_LOOP_PHASE_INVALID];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
 };
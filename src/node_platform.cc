@@ -3,10 +3,17 @@
 
 #include "env-inl.h"
 #include "debug_utils.h"
+#include "node_options.h"
 #include <algorithm>  // find_if(), find(), move()
 #include <cmath>  // llround()
+#include <cstdlib>  // strtol()
 #include <memory>  // unique_ptr(), shared_ptr(), make_shared()
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+
 namespace node {
 
 using v8::Isolate;
@@ -19,18 +26,54 @@ using node::tracing::TracingController;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkerThreadsTaskRunner::StealingTaskGroup* task_queue;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
   int id;
 };
 
+// Applies --v8-pool-cpuset ("0,2-3" style list) to the calling thread.
+// Only effective on Linux; elsewhere the option is accepted but ignored, as
+// there is no portable per-thread affinity call in this libuv version.
+static void ApplyPoolCpuSet() {
+#ifdef __linux__
+  const std::string& spec = per_process::cli_options->v8_pool_cpuset;
+  if (spec.empty()) return;
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  const char* p = spec.c_str();
+  while (*p != '\0') {
+    char* end;
+    const long first = strtol(p, &end, 10);  // NOLINT(runtime/int)
+    if (end == p || first < 0 || first >= CPU_SETSIZE) return;
+    long last = first;
+    p = end;
+    if (*p == '-') {
+      last = strtol(p + 1, &end, 10);  // NOLINT(runtime/int)
+      if (end == p + 1 || last < first || last >= CPU_SETSIZE) return;
+      p = end;
+    }
+    for (long cpu = first; cpu <= last; cpu++)  // NOLINT(runtime/int)
+      CPU_SET(cpu, &cpus);
+    if (*p == ',') p++;
+  }
+  // Best effort: an invalid or disallowed set must not take down the
+  // platform thread pool.
+  pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif  // __linux__
+}
+
 static void PlatformWorkerThread(void* data) {
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
+  ApplyPoolCpuSet();
+
+  WorkerThreadsTaskRunner::StealingTaskGroup* pending_worker_tasks =
+      worker_data->task_queue;
+  const int worker_id = worker_data->id;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
 
@@ -41,7 +84,8 @@ static void PlatformWorkerThread(void* data) {
     worker_data->platform_workers_ready->Signal(lock);
   }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
+  while (std::unique_ptr<Task> task =
+             pending_worker_tasks->BlockingPop(worker_id)) {
     task->Run();
     pending_worker_tasks->NotifyOfCompletion();
   }
@@ -51,7 +95,7 @@ static void PlatformWorkerThread(void* data) {
 
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
+  explicit DelayedTaskScheduler(StealingTaskGroup* tasks)
     : pending_worker_tasks_(tasks) {}
 
   std::unique_ptr<uv_thread_t> Start() {
@@ -157,7 +201,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
   uv_sem_t ready_;
-  TaskQueue<Task>* pending_worker_tasks_;
+  StealingTaskGroup* pending_worker_tasks_;
 
   TaskQueue<Task> tasks_;
   uv_loop_t loop_;
@@ -165,7 +209,77 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   std::unordered_set<uv_timer_t*> timers_;
 };
 
-WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
+WorkerThreadsTaskRunner::StealingTaskGroup::StealingTaskGroup(int num_shards) {
+  CHECK_EQ(0, uv_sem_init(&available_, 0));
+  if (num_shards < 1) num_shards = 1;
+  shards_.reserve(num_shards);
+  for (int i = 0; i < num_shards; i++)
+    shards_.emplace_back(new Shard());
+}
+
+WorkerThreadsTaskRunner::StealingTaskGroup::~StealingTaskGroup() {
+  uv_sem_destroy(&available_);
+}
+
+void WorkerThreadsTaskRunner::StealingTaskGroup::Push(
+    std::unique_ptr<Task> task) {
+  uint32_t index = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  Shard& shard = *shards_[index % shards_.size()];
+  outstanding_tasks_.fetch_add(1, std::memory_order_relaxed);
+  {
+    Mutex::ScopedLock lock(shard.mutex);
+    shard.tasks.push(std::move(task));
+  }
+  uv_sem_post(&available_);
+}
+
+std::unique_ptr<Task> WorkerThreadsTaskRunner::StealingTaskGroup::BlockingPop(
+    int worker_id) {
+  uv_sem_wait(&available_);
+  if (stopped_.load(std::memory_order_acquire)) {
+    // Relay the token so that the next blocked worker wakes up and exits too.
+    uv_sem_post(&available_);
+    return nullptr;
+  }
+  const size_t num_shards = shards_.size();
+  for (;;) {
+    // Own shard first, then steal from the others.
+    for (size_t i = 0; i < num_shards; i++) {
+      Shard& shard = *shards_[(worker_id + i) % num_shards];
+      Mutex::ScopedLock lock(shard.mutex);
+      if (!shard.tasks.empty()) {
+        std::unique_ptr<Task> task = std::move(shard.tasks.front());
+        shard.tasks.pop();
+        return task;
+      }
+    }
+    // Every semaphore token corresponds to one queued task, but the task
+    // backing this token may have been pushed to a shard the scan had
+    // already passed while another worker took a later one. Rescanning is
+    // rare enough that a busy retry is fine here.
+  }
+}
+
+void WorkerThreadsTaskRunner::StealingTaskGroup::NotifyOfCompletion() {
+  if (outstanding_tasks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Mutex::ScopedLock lock(drain_mutex_);
+    tasks_drained_.Broadcast(lock);
+  }
+}
+
+void WorkerThreadsTaskRunner::StealingTaskGroup::BlockingDrain() {
+  Mutex::ScopedLock lock(drain_mutex_);
+  while (outstanding_tasks_.load(std::memory_order_acquire) > 0)
+    tasks_drained_.Wait(lock);
+}
+
+void WorkerThreadsTaskRunner::StealingTaskGroup::Stop() {
+  stopped_.store(true, std::memory_order_release);
+  uv_sem_post(&available_);
+}
+
+WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size)
+    : pending_worker_tasks_(thread_pool_size) {
   Mutex platform_workers_mutex;
   ConditionVariable platform_workers_ready;
 
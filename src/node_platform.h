@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -126,8 +127,43 @@ class WorkerThreadsTaskRunner {
 
   int NumberOfWorkerThreads() const;
 
+  // Distributes background tasks over per-worker queue shards. Every
+  // platform worker pops from its own shard first and steals from the other
+  // shards when it runs dry, so that a burst of background compilation or GC
+  // tasks does not convoy all workers on a single queue mutex. A counting
+  // semaphore tracks the number of queued tasks; idle workers block on it
+  // instead of on a shared condition variable.
+  class StealingTaskGroup {
+   public:
+    explicit StealingTaskGroup(int num_shards);
+    ~StealingTaskGroup();
+
+    void Push(std::unique_ptr<v8::Task> task);
+    // Blocks until a task is available or Stop() was called. `worker_id`
+    // selects the shard that is searched first.
+    std::unique_ptr<v8::Task> BlockingPop(int worker_id);
+    void NotifyOfCompletion();
+    void BlockingDrain();
+    void Stop();
+
+   private:
+    struct Shard {
+      Mutex mutex;
+      std::queue<std::unique_ptr<v8::Task>> tasks;
+    };
+
+    uv_sem_t available_;
+    std::atomic<bool> stopped_ { false };
+    std::atomic<uint32_t> next_shard_ { 0 };
+    std::atomic<int> outstanding_tasks_ { 0 };
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    Mutex drain_mutex_;
+    ConditionVariable tasks_drained_;
+  };
+
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  StealingTaskGroup pending_worker_tasks_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -1,13 +1,16 @@
 #include "base_object-inl.h"
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_errors.h"
 #include "node_internals.h"
 #include "node_process.h"
+#include "node_watchdog.h"
 #include "util-inl.h"
 #include "uv.h"
 #include "v8.h"
 
+#include <map>
 #include <vector>
 
 #if HAVE_INSPECTOR
@@ -212,6 +215,122 @@ static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
   fields[3] = v8_heap_stats.external_memory();
 }
 
+namespace {
+
+// v8::EmbedderGraph implementation that only collects node sizes instead of
+// building an actual graph. Reusing the MemoryTracker visitors keeps the
+// breakdown consistent with what heap snapshots report, without the heap walk
+// and serialization a snapshot requires — tracking only visits the native
+// retainer tree, which takes milliseconds even on busy servers.
+class MemoryBreakdownGraph final : public v8::EmbedderGraph {
+ public:
+  Node* AddNode(std::unique_ptr<Node> node) override {
+    nodes_.push_back(std::move(node));
+    return nodes_.back().get();
+  }
+
+  // JS objects are accounted for by the regular V8 heap statistics; the
+  // breakdown only covers native allocations.
+  Node* V8Node(const Local<Value>& value) override { return nullptr; }
+
+  void AddEdge(Node* from, Node* to, const char* name) override {}
+
+  // Node sizes are adjusted by the tracker after AddNode() (e.g. when a
+  // container's stack size is shifted out into a child node), so totals can
+  // only be computed once tracking has finished.
+  std::map<std::string, size_t> Totals() const {
+    std::map<std::string, size_t> totals;
+    for (const auto& node : nodes_)
+      totals[node->Name()] += node->SizeInBytes();
+    return totals;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Node>> nodes_;
+};
+
+}  // anonymous namespace
+
+// Implements process.memoryUsage.detailed(): a per-subsystem breakdown of
+// native memory, aggregated from the same MemoryRetainer information that
+// feeds heap snapshots (handle wraps, req wraps, buffers, caches, ...).
+static void MemoryUsageDetailed(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  MemoryBreakdownGraph graph;
+  {
+    MemoryTracker tracker(isolate, &graph);
+    tracker.Track(env);
+  }
+
+  Local<Context> context = env->context();
+  Local<Object> result = Object::New(isolate);
+  for (const auto& entry : graph.Totals()) {
+    Local<String> key;
+    if (!String::NewFromUtf8(isolate,
+                             entry.first.c_str(),
+                             NewStringType::kNormal).ToLocal(&key)) {
+      return;
+    }
+    if (result->Set(context,
+                    key,
+                    Number::New(isolate,
+                                static_cast<double>(entry.second)))
+            .IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(result);
+}
+
+// Returns (and clears) the stack samples collected by the loop stall
+// watchdog; an empty array when --loop-stall-threshold is not in effect.
+static void LoopStallSamples(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  std::vector<LoopStallWatchdog::Sample> samples;
+  if (env->loop_stall_watchdog() != nullptr)
+    samples = env->loop_stall_watchdog()->DrainSamples();
+
+  std::vector<Local<Value>> entries;
+  entries.reserve(samples.size());
+  for (const LoopStallWatchdog::Sample& sample : samples) {
+    std::vector<Local<Value>> frames;
+    frames.reserve(sample.frames.size());
+    for (const std::string& frame : sample.frames) {
+      Local<Value> str;
+      if (!String::NewFromUtf8(isolate, frame.c_str(),
+                               NewStringType::kNormal).ToLocal(&str)) {
+        return;
+      }
+      frames.push_back(str);
+    }
+
+    Local<Object> entry = Object::New(isolate);
+    if (entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "timestamp"),
+                   Number::New(isolate, sample.timestamp / 1e6)).IsNothing() ||
+        entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "stallDuration"),
+                   Number::New(isolate,
+                               sample.stall_duration / 1e6)).IsNothing() ||
+        entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "stack"),
+                   Array::New(isolate,
+                              frames.data(),
+                              frames.size())).IsNothing()) {
+      return;
+    }
+    entries.push_back(entry);
+  }
+
+  args.GetReturnValue().Set(
+      Array::New(isolate, entries.data(), entries.size()));
+}
+
 void RawDebug(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.Length() == 1 && args[0]->IsString() &&
         "must be called with a single string");
@@ -230,6 +349,14 @@ static void StopProfilerIdleNotifier(const FunctionCallbackInfo<Value>& args) {
   env->StopProfilerIdleNotifier();
 }
 
+// Drops the cached process.env snapshot so that mutations made behind the
+// process's back (setenv(3) from an addon or the embedder) become visible
+// on the next property access.
+static void ResyncEnvironment(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->env_vars()->Resync();
+}
+
 static void Umask(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(env->has_run_bootstrapping_code());
@@ -289,6 +416,54 @@ void GetActiveHandles(const FunctionCallbackInfo<Value>& args) {
       Array::New(env->isolate(), handle_v.data(), handle_v.size()));
 }
 
+// Summarizes the live handle population as a flat [providerName, count, ...]
+// array, one pair per provider type with at least one handle. The counts are
+// maintained incrementally by HandleWrap, so this is O(provider types) no
+// matter how many handles exist — unlike _getActiveHandles(), which builds
+// a wrap object per handle. Note that the counts include handles that have
+// been unref'd but not yet closed.
+static void GetActiveHandleCounts(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  std::vector<Local<Value>> info_v;
+  const auto& counts = env->active_handle_counts();
+  for (size_t i = 0; i < counts.size(); i++) {
+    if (counts[i] == 0)
+      continue;
+    info_v.emplace_back(env->async_hooks()->provider_string(i));
+    info_v.emplace_back(Number::New(env->isolate(),
+                                    static_cast<double>(counts[i])));
+  }
+
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), info_v.data(), info_v.size()));
+}
+
+// Paginated variant of _getActiveHandles() for callers that want to walk a
+// large handle population without materializing every wrap object at once:
+// skips the first `offset` referenced handles and returns at most `count`.
+static void GetActiveHandlesSlice(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  const uint32_t offset = args[0].As<Uint32>()->Value();
+  const uint32_t count = args[1].As<Uint32>()->Value();
+
+  std::vector<Local<Value>> handle_v;
+  uint32_t seen = 0;
+  for (auto w : *env->handle_wrap_queue()) {
+    if (!HandleWrap::HasRef(w))
+      continue;
+    if (seen++ < offset)
+      continue;
+    handle_v.emplace_back(w->GetOwner());
+    if (handle_v.size() >= count)
+      break;
+  }
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), handle_v.data(), handle_v.size()));
+}
+
 static void ResourceUsage(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -456,9 +631,12 @@ static void InitializeProcessMethods(Local<Object> target,
       target, "_startProfilerIdleNotifier", StartProfilerIdleNotifier);
   env->SetMethod(target, "_stopProfilerIdleNotifier", StopProfilerIdleNotifier);
 
+  env->SetMethod(target, "resyncEnv", ResyncEnvironment);
   env->SetMethod(target, "umask", Umask);
   env->SetMethod(target, "_rawDebug", RawDebug);
+  env->SetMethod(target, "loopStallSamples", LoopStallSamples);
   env->SetMethod(target, "memoryUsage", MemoryUsage);
+  env->SetMethod(target, "memoryUsageDetailed", MemoryUsageDetailed);
   env->SetMethod(target, "cpuUsage", CPUUsage);
   env->SetMethod(target, "hrtime", Hrtime);
   env->SetMethod(target, "hrtimeBigInt", HrtimeBigInt);
@@ -466,6 +644,10 @@ static void InitializeProcessMethods(Local<Object> target,
 
   env->SetMethod(target, "_getActiveRequests", GetActiveRequests);
   env->SetMethod(target, "_getActiveHandles", GetActiveHandles);
+  env->SetMethodNoSideEffect(target,
+                             "getActiveHandleCounts",
+                             GetActiveHandleCounts);
+  env->SetMethod(target, "getActiveHandlesSlice", GetActiveHandlesSlice);
   env->SetMethod(target, "_kill", Kill);
 
   env->SetMethodNoSideEffect(target, "cwd", Cwd);
@@ -0,0 +1,210 @@
+#include "env-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <cstring>
+#include <vector>
+
+// Fast parser for application/x-www-form-urlencoded query strings, used by
+// lib/querystring.js when the caller sticks to the default '&'/'=' separators
+// and the default decoder. A word-at-a-time scan locates the next delimiter
+// or escape ('&', '=', '%', '+'); percent escapes are decoded in place into
+// the one-byte copy of the input, which doubles as the result arena, and the
+// decoded keys and values come back as a flat [key, value, ...] array. Keys
+// are interned so that repeated field names across large form bodies share
+// a single string. Inputs containing literal non-ASCII characters take the
+// slow path in JS; those cannot be decoded bytewise without changing how
+// unescaped Latin-1 characters round-trip.
+
+namespace node {
+namespace querystring {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Int32;
+using v8::Isolate;
+using v8::Local;
+using v8::NewStringType;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+namespace {
+
+const int8_t unhex_table[256] = {
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+constexpr uint64_t kEveryByte = 0x0101010101010101ULL;
+
+// Nonzero iff `word` contains the byte `byte` (classic SWAR zero-byte test).
+inline uint64_t HasByte(uint64_t word, uint8_t byte) {
+  uint64_t x = word ^ (kEveryByte * byte);
+  return (x - kEveryByte) & ~x & (kEveryByte * 0x80);
+}
+
+inline bool IsSpecial(uint8_t b) {
+  return b == '&' || b == '=' || b == '%' || b == '+' || b >= 0x80;
+}
+
+// Returns the offset of the first '&', '=', '%', '+' or non-ASCII byte at or
+// after `pos`, or `len` when there is none. Plain key/value characters are
+// skipped eight at a time.
+size_t FindSpecial(const uint8_t* data, size_t pos, size_t len) {
+  while (pos + 8 <= len) {
+    uint64_t word;
+    memcpy(&word, data + pos, 8);
+    uint64_t hits = HasByte(word, '&') | HasByte(word, '=') |
+                    HasByte(word, '%') | HasByte(word, '+') |
+                    (word & (kEveryByte * 0x80));
+    if (hits != 0) {
+      for (size_t i = 0; i < 8; i++) {
+        if (IsSpecial(data[pos + i]))
+          return pos + i;
+      }
+    }
+    pos += 8;
+  }
+  for (; pos < len; pos++) {
+    if (IsSpecial(data[pos]))
+      return pos;
+  }
+  return len;
+}
+
+// parse(qs, maxPairs) -> [key, value, ...] | undefined
+//
+// Matches the semantics of the default-configured querystring.parse(): '+'
+// becomes a space, malformed percent escapes pass through literally, '='
+// after the first one in a pair belongs to the value, empty pairs are
+// dropped but still count against maxPairs, and maxPairs < 0 means
+// unlimited. Returns undefined (so the caller falls back to the JS parser)
+// when the input contains characters outside of ASCII.
+void Parse(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsInt32());
+  Local<String> input = args[0].As<String>();
+  int32_t pairs = args[1].As<Int32>()->Value();
+
+  if (!input->ContainsOnlyOneByte())
+    return;
+
+  const size_t len = input->Length();
+  MaybeStackBuffer<uint8_t, 1024> buf(len);
+  input->WriteOneByte(isolate, buf.out(), 0, len, String::NO_NULL_TERMINATION);
+  uint8_t* data = buf.out();
+
+  std::vector<Local<Value>> parts;
+  size_t pos = 0;         // Read cursor (raw input).
+  size_t write = 0;       // Write cursor (decoded bytes, always <= pos).
+  size_t seg_start = 0;   // Decoded offset where the current pair starts.
+  size_t key_end = 0;     // Decoded offset of the first '=', if seen.
+  bool have_eq = false;
+
+  auto emit = [&](size_t start, size_t length, NewStringType type) {
+    parts.push_back(
+        length == 0
+            ? Local<Value>(String::Empty(isolate))
+            : Local<Value>(String::NewFromUtf8(
+                               isolate,
+                               reinterpret_cast<const char*>(data + start),
+                               type,
+                               length).ToLocalChecked()));
+  };
+
+  // Emits the current pair (if any); returns false once maxPairs is hit.
+  auto flush = [&](bool at_end) {
+    if (write > seg_start || have_eq) {
+      size_t klen = (have_eq ? key_end : write) - seg_start;
+      emit(seg_start, klen, NewStringType::kInternalized);
+      emit(have_eq ? key_end : write,
+           have_eq ? write - key_end : 0,
+           NewStringType::kNormal);
+    }
+    if (!at_end && --pairs == 0)
+      return false;
+    seg_start = write;
+    have_eq = false;
+    return true;
+  };
+
+  for (;;) {
+    size_t next = FindSpecial(data, pos, len);
+    size_t run = next - pos;
+    if (run > 0) {
+      memmove(data + write, data + pos, run);
+      write += run;
+    }
+    if (next == len) {
+      flush(true);
+      break;
+    }
+    uint8_t b = data[next];
+    pos = next + 1;
+    if (b == '&') {
+      if (!flush(false))
+        break;
+    } else if (b == '=') {
+      if (!have_eq) {
+        have_eq = true;
+        key_end = write;
+      } else {
+        data[write++] = '=';
+      }
+    } else if (b == '+') {
+      data[write++] = ' ';
+    } else if (b == '%') {
+      int8_t hi;
+      int8_t lo;
+      if (next + 2 < len &&
+          (hi = unhex_table[data[next + 1]]) >= 0 &&
+          (lo = unhex_table[data[next + 2]]) >= 0) {
+        data[write++] = static_cast<uint8_t>(hi * 16 + lo);
+        pos = next + 3;
+      } else {
+        data[write++] = '%';
+      }
+    } else {
+      // Literal non-ASCII character: punt to the JS implementation.
+      return;
+    }
+  }
+
+  args.GetReturnValue().Set(
+      Array::New(isolate, parts.data(), parts.size()));
+}
+
+}  // anonymous namespace
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethodNoSideEffect(target, "parse", Parse);
+}
+
+}  // namespace querystring
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(querystring,
+                                   node::querystring::Initialize)
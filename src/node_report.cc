@@ -4,6 +4,7 @@
 #include "diagnosticfilename-inl.h"
 #include "node_internals.h"
 #include "node_metadata.h"
+#include "threadpoolwork-inl.h"
 #include "util.h"
 
 #ifdef _WIN32
@@ -42,28 +43,63 @@ using v8::V8;
 using v8::Value;
 
 // Internal/static function declarations
-static void WriteNodeReport(Isolate* isolate,
-                            Environment* env,
-                            const char* message,
-                            const char* trigger,
+static void CaptureReportData(Isolate* isolate,
+                              Environment* env,
+                              const char* message,
+                              const char* trigger,
+                              Local<String> stackstr,
+                              ReportData* data);
+static void WriteNodeReport(const ReportData& data,
                             const std::string& filename,
-                            std::ostream& out,
-                            Local<String> stackstr);
+                            std::ostream& out);
+static std::string CaptureUvSection(Environment* env);
+static std::string CaptureEnvVarsSection();
+static std::string CaptureGCSection(Isolate* isolate);
 static void PrintVersionInformation(JSONWriter* writer);
 static void PrintJavaScriptStack(JSONWriter* writer,
-                                 Isolate* isolate,
-                                 Local<String> stackstr,
-                                 const char* trigger);
-static void PrintNativeStack(JSONWriter* writer);
+                                 const std::string& stack);
+static void PrintNativeStack(JSONWriter* writer,
+                             const std::vector<void*>& frames);
 static void PrintResourceUsage(JSONWriter* writer);
 static void PrintGCStatistics(JSONWriter* writer, Isolate* isolate);
-static void PrintSystemInformation(JSONWriter* writer);
+static void PrintSystemInformation(JSONWriter* writer,
+                                   const ReportData& data);
 static void PrintLoadedLibraries(JSONWriter* writer);
 static void PrintComponentVersions(JSONWriter* writer);
 static void PrintRelease(JSONWriter* writer);
 static void PrintCpuInfo(JSONWriter* writer);
 static void PrintNetworkInterfaceInfo(JSONWriter* writer);
 
+// Determine the required report filename. In order of priority:
+//   1) supplied on API 2) configured on startup 3) default generated
+static std::string ResolveReportFilename(Environment* env,
+                                         const std::string& name) {
+  if (!name.empty()) {
+    // Filename was specified as API parameter.
+    return name;
+  }
+  if (env != nullptr &&
+      env->isolate_data()->options()->report_filename.length() > 0) {
+    // File name was supplied via start-up option.
+    return env->isolate_data()->options()->report_filename;
+  }
+  return *DiagnosticFilename(env != nullptr ? env->thread_id() : 0,
+                             "report", "json");
+}
+
+// Append the filename to the configured report directory, if any.
+static std::string ResolveReportPathname(Environment* env,
+                                         const std::string& filename) {
+  if (env != nullptr &&
+      env->isolate_data()->options()->report_directory.length() > 0) {
+    std::string pathname = env->isolate_data()->options()->report_directory;
+    pathname += node::kPathSeparator;
+    pathname += filename;
+    return pathname;
+  }
+  return filename;
+}
+
 // External function to trigger a report, writing to file.
 // The 'name' parameter is in/out: an input filename is used
 // if supplied, and the actual filename is returned.
@@ -73,22 +109,7 @@ std::string TriggerNodeReport(Isolate* isolate,
                               const char* trigger,
                               const std::string& name,
                               Local<String> stackstr) {
-  std::string filename;
-  std::shared_ptr<PerIsolateOptions> options;
-  if (env != nullptr) options = env->isolate_data()->options();
-
-  // Determine the required report filename. In order of priority:
-  //   1) supplied on API 2) configured on startup 3) default generated
-  if (!name.empty()) {
-    // Filename was specified as API parameter.
-    filename = name;
-  } else if (env != nullptr && options->report_filename.length() > 0) {
-    // File name was supplied via start-up option.
-    filename = options->report_filename;
-  } else {
-    filename = *DiagnosticFilename(env != nullptr ? env->thread_id() : 0,
-                                   "report", "json");
-  }
+  std::string filename = ResolveReportFilename(env, name);
 
   // Open the report file stream for writing. Supports stdout/err,
   // user-specified or (default) generated name
@@ -100,20 +121,16 @@ std::string TriggerNodeReport(Isolate* isolate,
     outstream = &std::cerr;
   } else {
     // Regular file. Append filename to directory path if one was specified
-    if (env != nullptr && options->report_directory.length() > 0) {
-      std::string pathname = options->report_directory;
-      pathname += node::kPathSeparator;
-      pathname += filename;
-      outfile.open(pathname, std::ios::out | std::ios::binary);
-    } else {
-      outfile.open(filename, std::ios::out | std::ios::binary);
-    }
+    outfile.open(ResolveReportPathname(env, filename),
+                 std::ios::out | std::ios::binary);
     // Check for errors on the file open
     if (!outfile.is_open()) {
       std::cerr << "\nFailed to open Node.js report file: " << filename;
 
-      if (env != nullptr && options->report_directory.length() > 0)
-        std::cerr << " directory: " << options->report_directory;
+      if (env != nullptr &&
+          env->isolate_data()->options()->report_directory.length() > 0)
+        std::cerr << " directory: "
+                  << env->isolate_data()->options()->report_directory;
 
       std::cerr << " (errno: " << errno << ")" << std::endl;
       return "";
@@ -122,8 +139,9 @@ std::string TriggerNodeReport(Isolate* isolate,
     std::cerr << "\nWriting Node.js report to file: " << filename;
   }
 
-  WriteNodeReport(isolate, env, message, trigger, filename, *outstream,
-                  stackstr);
+  ReportData data;
+  CaptureReportData(isolate, env, message, trigger, stackstr, &data);
+  WriteNodeReport(data, filename, *outstream);
 
   // Do not close stdout/stderr, only close files we opened.
   if (outfile.is_open()) {
@@ -134,6 +152,69 @@ std::string TriggerNodeReport(Isolate* isolate,
   return filename;
 }
 
+// Writes a captured report to file on a worker thread so that the event
+// loop only pays for the capture phase. The work item owns itself.
+class AsyncReportWork : public node::ThreadPoolWork {
+ public:
+  AsyncReportWork(Environment* env,
+                  ReportData&& data,
+                  const std::string& pathname,
+                  const std::string& filename)
+      : ThreadPoolWork(env),
+        data_(std::move(data)),
+        pathname_(pathname),
+        filename_(filename) {}
+
+  void DoThreadPoolWork() override {
+    // Write to a temporary name and rename on completion so that a consumer
+    // polling for the report never observes a partially written file.
+    std::string tmpname = pathname_ + ".tmp";
+    std::ofstream outfile(tmpname, std::ios::out | std::ios::binary);
+    if (!outfile.is_open()) {
+      std::cerr << "\nFailed to open Node.js report file: " << filename_
+                << " (errno: " << errno << ")" << std::endl;
+      return;
+    }
+    WriteNodeReport(data_, filename_, outfile);
+    outfile.close();
+    if (std::rename(tmpname.c_str(), pathname_.c_str()) != 0) {
+      std::cerr << "\nFailed to rename Node.js report file: " << filename_
+                << " (errno: " << errno << ")" << std::endl;
+      return;
+    }
+    std::cerr << "\nNode.js report completed" << std::endl;
+  }
+
+  void AfterThreadPoolWork(int status) override { delete this; }
+
+ private:
+  ReportData data_;
+  std::string pathname_;
+  std::string filename_;
+};
+
+std::string TriggerNodeReportAsync(Isolate* isolate,
+                                   Environment* env,
+                                   const char* message,
+                                   const char* trigger,
+                                   const std::string& name,
+                                   Local<String> stackstr) {
+  std::string filename = ResolveReportFilename(env, name);
+  // Writing to the standard streams from a worker thread would interleave
+  // with other output; scheduling work also requires an environment.
+  if (env == nullptr || filename == "stdout" || filename == "stderr")
+    return TriggerNodeReport(isolate, env, message, trigger, name, stackstr);
+
+  ReportData data;
+  CaptureReportData(isolate, env, message, trigger, stackstr, &data);
+
+  std::cerr << "\nWriting Node.js report to file: " << filename;
+  AsyncReportWork* work = new AsyncReportWork(
+      env, std::move(data), ResolveReportPathname(env, filename), filename);
+  work->ScheduleWork();
+  return filename;
+}
+
 // External function to trigger a report, writing to a supplied stream.
 void GetNodeReport(Isolate* isolate,
                    Environment* env,
@@ -141,18 +222,136 @@ void GetNodeReport(Isolate* isolate,
                    const char* trigger,
                    Local<String> stackstr,
                    std::ostream& out) {
-  WriteNodeReport(isolate, env, message, trigger, "", out, stackstr);
+  ReportData data;
+  CaptureReportData(isolate, env, message, trigger, stackstr, &data);
+  WriteNodeReport(data, "", out);
+}
+
+// Internal function to gather everything the report needs from the isolate
+// and the environment. This is the only phase that has to run on the
+// requesting thread; the captured data can be serialized anywhere.
+static void CaptureReportData(Isolate* isolate,
+                              Environment* env,
+                              const char* message,
+                              const char* trigger,
+                              Local<String> stackstr,
+                              ReportData* data) {
+  data->message = message;
+  data->trigger = trigger;
+
+  if ((!strcmp(trigger, "FatalError")) ||
+      (!strcmp(trigger, "Signal"))) {
+    data->js_stack = "No stack.\nUnavailable.\n";
+  } else {
+    String::Utf8Value sv(isolate, stackstr);
+    data->js_stack = std::string(*sv, sv.length());
+  }
+
+  data->gc_section = CaptureGCSection(isolate);
+
+  // Prefer the cached libuv and environment-variable sections: they are
+  // refreshed from the event loop and keep the capture phase short. Fall
+  // back to an inline capture when no snapshot has been taken yet (e.g.
+  // during early startup, or when there is no environment).
+  bool have_snapshot = false;
+  if (env != nullptr) {
+    Mutex::ScopedLock lock(env->report_snapshot_mutex());
+    if (env->report_snapshot_timestamp() != 0) {
+      data->uv_section = env->report_uv_snapshot();
+      data->env_vars_section = env->report_env_vars_snapshot();
+      have_snapshot = true;
+    }
+  }
+  if (!have_snapshot) {
+    data->uv_section = CaptureUvSection(env);
+    data->env_vars_section = CaptureEnvVarsSection();
+  }
+
+  // Capture the raw native frames now; symbolization is comparatively slow
+  // and is deferred to serialization time.
+  auto sym_ctx = NativeSymbolDebuggingContext::New();
+  void* frames[256];
+  const int size = sym_ctx->GetStackTrace(frames, arraysize(frames));
+  // Frame 0 is this function; skip it as the old inline capture did.
+  if (size > 1)
+    data->native_frames.assign(frames + 1, frames + size);
+}
+
+// Refresh the cached report sections for `env`. Called periodically from
+// the event loop thread so that on-demand reports do not have to walk the
+// handle list or copy the environment block themselves.
+void UpdateReportSnapshots(Environment* env) {
+  std::string uv_section = CaptureUvSection(env);
+  std::string env_vars_section = CaptureEnvVarsSection();
+  Mutex::ScopedLock lock(env->report_snapshot_mutex());
+  env->report_uv_snapshot() = std::move(uv_section);
+  env->report_env_vars_snapshot() = std::move(env_vars_section);
+  env->report_snapshot_timestamp() = uv_hrtime();
+}
+
+// Serialize a report section into a standalone JSON fragment that can be
+// spliced into the main writer with json_rawfragment(). The single indent()
+// call matches the depth of the top-level report object.
+static std::string CaptureGCSection(Isolate* isolate) {
+  std::ostringstream out;
+  JSONWriter writer(out);
+  writer.indent();
+  PrintGCStatistics(&writer, isolate);
+  return out.str();
+}
+
+static std::string CaptureUvSection(Environment* env) {
+  std::ostringstream out;
+  JSONWriter writer(out);
+  writer.indent();
+  writer.json_arraystart("libuv");
+  if (env != nullptr) {
+    uv_walk(env->event_loop(), WalkHandle, static_cast<void*>(&writer));
+
+    writer.json_start();
+    writer.json_keyvalue("type", "loop");
+    writer.json_keyvalue("is_active",
+        static_cast<bool>(uv_loop_alive(env->event_loop())));
+    writer.json_keyvalue("address",
+        ValueToHexString(reinterpret_cast<int64_t>(env->event_loop())));
+    writer.json_end();
+  }
+
+  writer.json_arrayend();
+  return out.str();
+}
+
+static std::string CaptureEnvVarsSection() {
+  std::ostringstream out;
+  JSONWriter writer(out);
+  writer.indent();
+  uv_env_item_t* envitems;
+  int envcount;
+  int r;
+
+  writer.json_objectstart("environmentVariables");
+
+  {
+    Mutex::ScopedLock lock(node::per_process::env_var_mutex);
+    r = uv_os_environ(&envitems, &envcount);
+  }
+
+  if (r == 0) {
+    for (int i = 0; i < envcount; i++)
+      writer.json_keyvalue(envitems[i].name, envitems[i].value);
+
+    uv_os_free_environ(envitems, envcount);
+  }
+
+  writer.json_objectend();
+  return out.str();
 }
 
 // Internal function to coordinate and write the various
 // sections of the report to the supplied stream
-static void WriteNodeReport(Isolate* isolate,
-                            Environment* env,
-                            const char* message,
-                            const char* trigger,
+static void WriteNodeReport(const ReportData& data,
                             const std::string& filename,
-                            std::ostream& out,
-                            Local<String> stackstr) {
+                            std::ostream& out) {
   // Obtain the current time and the pid.
   TIME_TYPE tm_struct;
   DiagnosticFilename::LocalTime(&tm_struct);
@@ -169,8 +368,8 @@ static void WriteNodeReport(Isolate* isolate,
   writer.json_start();
   writer.json_objectstart("header");
   writer.json_keyvalue("reportVersion", NODE_REPORT_VERSION);
-  writer.json_keyvalue("event", message);
-  writer.json_keyvalue("trigger", trigger);
+  writer.json_keyvalue("event", data.message);
+  writer.json_keyvalue("trigger", data.trigger);
   if (!filename.empty())
     writer.json_keyvalue("filename", filename);
   else
@@ -233,34 +432,22 @@ static void WriteNodeReport(Isolate* isolate,
   writer.json_objectend();
 
   // Report summary JavaScript stack backtrace
-  PrintJavaScriptStack(&writer, isolate, stackstr, trigger);
+  PrintJavaScriptStack(&writer, data.js_stack);
 
   // Report native stack backtrace
-  PrintNativeStack(&writer);
+  PrintNativeStack(&writer, data.native_frames);
 
   // Report V8 Heap and Garbage Collector information
-  PrintGCStatistics(&writer, isolate);
+  writer.json_rawfragment(data.gc_section);
 
   // Report OS and current thread resource usage
   PrintResourceUsage(&writer);
 
-  writer.json_arraystart("libuv");
-  if (env != nullptr) {
-    uv_walk(env->event_loop(), WalkHandle, static_cast<void*>(&writer));
-
-    writer.json_start();
-    writer.json_keyvalue("type", "loop");
-    writer.json_keyvalue("is_active",
-        static_cast<bool>(uv_loop_alive(env->event_loop())));
-    writer.json_keyvalue("address",
-        ValueToHexString(reinterpret_cast<int64_t>(env->event_loop())));
-    writer.json_end();
-  }
-
-  writer.json_arrayend();
+  // Report libuv handle summary (captured section)
+  writer.json_rawfragment(data.uv_section);
 
   // Report operating system information
-  PrintSystemInformation(&writer);
+  PrintSystemInformation(&writer, data);
 
   writer.json_objectend();
 
@@ -397,19 +584,10 @@ static void PrintNetworkInterfaceInfo(JSONWriter* writer) {
 
 // Report the JavaScript stack.
 static void PrintJavaScriptStack(JSONWriter* writer,
-                                 Isolate* isolate,
-                                 Local<String> stackstr,
-                                 const char* trigger) {
+                                 const std::string& stack) {
   writer->json_objectstart("javascriptStack");
 
-  std::string ss;
-  if ((!strcmp(trigger, "FatalError")) ||
-      (!strcmp(trigger, "Signal"))) {
-    ss = "No stack.\nUnavailable.\n";
-  } else {
-    String::Utf8Value sv(isolate, stackstr);
-    ss = std::string(*sv, sv.length());
-  }
+  std::string ss = stack;
   int line = ss.find('\n');
   if (line == -1) {
     writer->json_keyvalue("message", ss);
@@ -433,15 +611,13 @@ static void PrintJavaScriptStack(JSONWriter* writer,
   writer->json_objectend();
 }
 
-// Report a native stack backtrace
-static void PrintNativeStack(JSONWriter* writer) {
+// Report a native stack backtrace. The frames were captured up front;
+// symbol lookup happens here, possibly on a worker thread.
+static void PrintNativeStack(JSONWriter* writer,
+                             const std::vector<void*>& frames) {
   auto sym_ctx = NativeSymbolDebuggingContext::New();
-  void* frames[256];
-  const int size = sym_ctx->GetStackTrace(frames, arraysize(frames));
   writer->json_arraystart("nativeStack");
-  int i;
-  for (i = 1; i < size; i++) {
-    void* frame = frames[i];
+  for (void* frame : frames) {
     writer->json_start();
     writer->json_keyvalue("pc",
                           ValueToHexString(reinterpret_cast<uintptr_t>(frame)));
@@ -544,27 +720,11 @@ static void PrintResourceUsage(JSONWriter* writer) {
 #endif
 }
 
-// Report operating system information.
-static void PrintSystemInformation(JSONWriter* writer) {
-  uv_env_item_t* envitems;
-  int envcount;
-  int r;
-
-  writer->json_objectstart("environmentVariables");
-
-  {
-    Mutex::ScopedLock lock(node::per_process::env_var_mutex);
-    r = uv_os_environ(&envitems, &envcount);
-  }
-
-  if (r == 0) {
-    for (int i = 0; i < envcount; i++)
-      writer->json_keyvalue(envitems[i].name, envitems[i].value);
-
-    uv_os_free_environ(envitems, envcount);
-  }
-
-  writer->json_objectend();
+// Report operating system information. The environment variable section
+// was captured up front and is spliced in as-is.
+static void PrintSystemInformation(JSONWriter* writer,
+                                   const ReportData& data) {
+  writer->json_rawfragment(data.env_vars_section);
 
 #ifndef _WIN32
   static struct {
@@ -27,6 +27,22 @@
 
 namespace report {
 
+// Everything needed to serialize a report without touching the isolate or
+// the environment again. The JSON fragments for the sections that are slow
+// to gather (or unsafe to gather off-thread) are captured up front; native
+// stack frames are captured synchronously but symbolized at serialization
+// time.
+struct ReportData {
+  std::string message;
+  std::string trigger;
+  std::string filename;
+  std::string js_stack;
+  std::string gc_section;
+  std::string uv_section;
+  std::string env_vars_section;
+  std::vector<void*> native_frames;
+};
+
 // Function declarations - functions in src/node_report.cc
 std::string TriggerNodeReport(v8::Isolate* isolate,
                               node::Environment* env,
@@ -34,6 +50,19 @@ std::string TriggerNodeReport(v8::Isolate* isolate,
                               const char* trigger,
                               const std::string& name,
                               v8::Local<v8::String> stackstr);
+// Like TriggerNodeReport(), but only the capture phase runs on the calling
+// thread; JSON serialization and the file write happen on the threadpool.
+// Returns the report filename immediately. Writing to stdout/stderr falls
+// back to the synchronous path.
+std::string TriggerNodeReportAsync(v8::Isolate* isolate,
+                                   node::Environment* env,
+                                   const char* message,
+                                   const char* trigger,
+                                   const std::string& name,
+                                   v8::Local<v8::String> stackstr);
+// Refreshes the cached libuv-handle and environment-variable report
+// sections for `env`. Must be called on the event loop thread.
+void UpdateReportSnapshots(node::Environment* env);
 void GetNodeReport(v8::Isolate* isolate,
                    node::Environment* env,
                    const char* message,
@@ -56,6 +85,7 @@ std::string ValueToHexString(T value) {
 
 // Function declarations - export functions in src/node_report_module.cc
 void WriteReport(const v8::FunctionCallbackInfo<v8::Value>& info);
+void WriteReportAsync(const v8::FunctionCallbackInfo<v8::Value>& info);
 void GetReport(const v8::FunctionCallbackInfo<v8::Value>& info);
 
 // Node.js boot time - defined in src/node.cc
@@ -146,6 +176,15 @@ class JSONWriter {
 
   struct Null {};  // Usable as a JSON value.
 
+  // Splice a pre-serialized JSON fragment (for example a cached report
+  // section) into the output as-is. Empty fragments are ignored.
+  inline void json_rawfragment(const std::string& fragment) {
+    if (fragment.empty()) return;
+    if (state_ == kAfterValue) out_ << ',';
+    out_ << fragment;
+    state_ = kAfterValue;
+  }
+
  private:
   template <typename T,
             typename test_for_number = typename std::
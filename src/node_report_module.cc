@@ -51,6 +51,32 @@ void WriteReport(const FunctionCallbackInfo<Value>& info) {
           .ToLocalChecked());
 }
 
+// Like WriteReport(), but serialization and the file write happen on a
+// worker thread. Used by the signal handler so that report generation does
+// not stall the event loop.
+void WriteReportAsync(const FunctionCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Isolate* isolate = env->isolate();
+  HandleScope scope(isolate);
+  std::string filename;
+  Local<String> stackstr;
+
+  CHECK_EQ(info.Length(), 4);
+  String::Utf8Value message(isolate, info[0].As<String>());
+  String::Utf8Value trigger(isolate, info[1].As<String>());
+  stackstr = info[3].As<String>();
+
+  if (info[2]->IsString())
+    filename = *String::Utf8Value(isolate, info[2]);
+
+  filename = TriggerNodeReportAsync(
+      isolate, env, *message, *trigger, filename, stackstr);
+  // Return value is the report filename
+  info.GetReturnValue().Set(
+      String::NewFromUtf8(isolate, filename.c_str(), v8::NewStringType::kNormal)
+          .ToLocalChecked());
+}
+
 // External JavaScript API for returning a report
 void GetReport(const FunctionCallbackInfo<Value>& info) {
   Environment* env = Environment::GetCurrent(info);
@@ -160,6 +186,7 @@ static void Initialize(Local<Object> exports,
   Environment* env = Environment::GetCurrent(context);
 
   env->SetMethod(exports, "writeReport", WriteReport);
+  env->SetMethod(exports, "writeReportAsync", WriteReportAsync);
   env->SetMethod(exports, "getReport", GetReport);
   env->SetMethod(exports, "getDirectory", GetDirectory);
   env->SetMethod(exports, "setDirectory", SetDirectory);
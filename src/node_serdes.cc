@@ -9,6 +9,7 @@ namespace node {
 using v8::Array;
 using v8::ArrayBuffer;
 using v8::Context;
+using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -94,6 +95,133 @@ class DeserializerContext : public BaseObject,
   ValueDeserializer deserializer_;
 };
 
+// Reusable per-thread output buffer for clone(). ValueSerializer usually
+// grows a fresh malloc'ed buffer for every serialization; routing the
+// buffer management callbacks through this arena means that steady-state
+// clones only pay for a single memcpy of the serialized payload.
+struct CloneArena {
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  ~CloneArena() { free(data); }
+};
+
+CloneArena* clone_arena() {
+  static thread_local CloneArena arena;
+  return &arena;
+}
+
+class CloneSerializerDelegate : public ValueSerializer::Delegate {
+ public:
+  explicit CloneSerializerDelegate(Isolate* isolate) : isolate_(isolate) {}
+
+  void ThrowDataCloneError(Local<String> message) override {
+    isolate_->ThrowException(Exception::Error(message));
+  }
+
+  void* ReallocateBufferMemory(void* old_buffer,
+                               size_t size,
+                               size_t* actual_size) override {
+    CloneArena* arena = clone_arena();
+    CHECK(old_buffer == nullptr || old_buffer == arena->data);
+    if (size > arena->size) {
+      size_t new_size = std::max(arena->size * 2, size);
+      uint8_t* new_data = UncheckedRealloc(arena->data, new_size);
+      if (new_data == nullptr) {
+        *actual_size = arena->size;
+        return nullptr;
+      }
+      arena->data = new_data;
+      arena->size = new_size;
+    }
+    *actual_size = arena->size;
+    return arena->data;
+  }
+
+  // The arena outlives the serializer and is reused by the next clone.
+  void FreeBufferMemory(void* buffer) override {}
+
+ private:
+  Isolate* isolate_;
+};
+
+// Holds a serialized copy of a cloned value and materializes it on first
+// request, so payloads that are handed around (e.g. queued) but never read
+// are never deserialized at all.
+class LazyCloneHandle : public BaseObject {
+ public:
+  LazyCloneHandle(Environment* env,
+                  Local<Object> wrap,
+                  MallocedBuffer<uint8_t>&& data)
+      : BaseObject(env, wrap), data_(std::move(data)) {
+    MakeWeak();
+  }
+
+  ~LazyCloneHandle() override = default;
+
+  static void Clone(const FunctionCallbackInfo<Value>& args);
+  static void Deserialize(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(LazyCloneHandle)
+  SET_SELF_SIZE(LazyCloneHandle)
+
+ private:
+  MallocedBuffer<uint8_t> data_;
+  v8::Global<Value> value_;
+};
+
+void LazyCloneHandle::Clone(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CloneSerializerDelegate delegate(isolate);
+  ValueSerializer serializer(isolate, &delegate);
+  serializer.WriteHeader();
+  bool ok;
+  if (!serializer.WriteValue(env->context(), args[0]).To(&ok) || !ok)
+    return;
+
+  // Release() points into the arena; copy the payload out so that the
+  // arena is free for the next clone.
+  std::pair<uint8_t*, size_t> ret = serializer.Release();
+  MallocedBuffer<uint8_t> data(ret.second);
+  memcpy(data.data, ret.first, ret.second);
+
+  Local<Object> obj;
+  if (!env->lazy_clone_handle_template()
+           ->NewInstance(env->context())
+           .ToLocal(&obj)) {
+    return;
+  }
+  new LazyCloneHandle(env, obj, std::move(data));
+  args.GetReturnValue().Set(obj);
+}
+
+void LazyCloneHandle::Deserialize(const FunctionCallbackInfo<Value>& args) {
+  LazyCloneHandle* handle;
+  ASSIGN_OR_RETURN_UNWRAP(&handle, args.Holder());
+  Environment* env = handle->env();
+  Isolate* isolate = env->isolate();
+
+  if (!handle->value_.IsEmpty())
+    return args.GetReturnValue().Set(handle->value_.Get(isolate));
+
+  ValueDeserializer deserializer(
+      isolate, handle->data_.data, handle->data_.size);
+  bool ok;
+  if (!deserializer.ReadHeader(env->context()).To(&ok) || !ok)
+    return env->ThrowError("Unable to deserialize cloned value");
+
+  Local<Value> value;
+  if (!deserializer.ReadValue(env->context()).ToLocal(&value))
+    return;
+
+  handle->value_.Reset(isolate, value);
+  // The serialized payload is no longer needed once materialized.
+  handle->data_ = MallocedBuffer<uint8_t>();
+  args.GetReturnValue().Set(value);
+}
+
 SerializerContext::SerializerContext(Environment* env, Local<Object> wrap)
   : BaseObject(env, wrap),
     serializer_(env->isolate(), this) {
@@ -443,6 +571,305 @@ void DeserializerContext::ReadRawBytes(
   args.GetReturnValue().Set(offset);
 }
 
+// ===== Streaming JSON encoder =====
+//
+// Serializes a JS value graph as UTF-8 JSON text directly into fixed-size
+// malloc'd slabs that are handed back to JS as an array of Buffers ready for
+// StreamBase::Write(), skipping the intermediate V8 heap string (and the
+// StringBytes::Write() copy out of it) that JSON.stringify plus Buffer.from
+// would build for a large response.
+
+constexpr size_t kJSONDefaultChunkSize = 64 * 1024;
+constexpr size_t kJSONMinChunkSize = 16;
+// Bounds native recursion; JSON.stringify relies on the JS stack instead.
+constexpr int kJSONMaxDepth = 256;
+
+class JSONChunkedWriter {
+ public:
+  JSONChunkedWriter(Environment* env, size_t chunk_size)
+      : env_(env), chunk_size_(chunk_size) {}
+
+  ~JSONChunkedWriter() {
+    for (Slab& slab : slabs_) free(slab.data);
+  }
+
+  void Append(const char* data, size_t length) {
+    while (length > 0) {
+      if (slabs_.empty() || slabs_.back().used == chunk_size_)
+        slabs_.push_back({ Malloc(chunk_size_), 0 });
+      Slab& slab = slabs_.back();
+      const size_t take = std::min(length, chunk_size_ - slab.used);
+      memcpy(slab.data + slab.used, data, take);
+      slab.used += take;
+      data += take;
+      length -= take;
+    }
+  }
+
+  void AppendChar(char c) { Append(&c, 1); }
+
+  MaybeLocal<Array> Finish() {
+    std::vector<Local<Value>> buffers;
+    buffers.reserve(slabs_.size());
+    for (Slab& slab : slabs_) {
+      Local<Object> buffer;
+      // Buffer::New() takes ownership of the malloc'd slab allocation.
+      if (!Buffer::New(env_, slab.data, slab.used, true).ToLocal(&buffer))
+        return MaybeLocal<Array>();
+      slab.data = nullptr;
+      buffers.push_back(buffer);
+    }
+    slabs_.clear();
+    return Array::New(env_->isolate(), buffers.data(), buffers.size());
+  }
+
+ private:
+  struct Slab {
+    char* data;
+    size_t used;
+  };
+
+  Environment* env_;
+  const size_t chunk_size_;
+  std::vector<Slab> slabs_;
+};
+
+class JSONEncoder {
+ public:
+  JSONEncoder(Environment* env, size_t chunk_size)
+      : env_(env), writer_(env, chunk_size) {}
+
+  // Values JSON.stringify omits (object context) or nulls out (arrays).
+  static bool IsSkipped(Local<Value> value) {
+    return value->IsUndefined() || value->IsFunction() || value->IsSymbol();
+  }
+
+  // Returns false with a pending exception for circular structures, BigInts,
+  // excessive depth, or a throwing getter/toJSON().
+  bool Encode(Local<Value> value, int depth, bool honor_to_json = true);
+
+  MaybeLocal<Array> Finish() { return writer_.Finish(); }
+
+ private:
+  bool EncodeString(Local<String> string);
+  bool PushStack(Local<Object> object);
+
+  Environment* env_;
+  JSONChunkedWriter writer_;
+  std::vector<Local<Object>> stack_;
+};
+
+bool JSONEncoder::PushStack(Local<Object> object) {
+  for (const Local<Object>& ancestor : stack_) {
+    if (ancestor == object) {
+      env_->ThrowTypeError("Converting circular structure to JSON");
+      return false;
+    }
+  }
+  stack_.push_back(object);
+  return true;
+}
+
+bool JSONEncoder::EncodeString(Local<String> string) {
+  Isolate* isolate = env_->isolate();
+  const size_t utf8_length = string->Utf8Length(isolate);
+  MaybeStackBuffer<char, 1024> scratch;
+  scratch.AllocateSufficientStorage(utf8_length);
+  string->WriteUtf8(isolate,
+                    scratch.out(),
+                    utf8_length,
+                    nullptr,
+                    String::NO_NULL_TERMINATION |
+                        String::REPLACE_INVALID_UTF8);
+
+  writer_.AppendChar('"');
+  // Escapes only ever apply to single-byte characters (multi-byte UTF-8
+  // units are all >= 0x80), so the scan can work bytewise, copying clean
+  // runs in one Append() each.
+  const char* data = scratch.out();
+  size_t run_start = 0;
+  for (size_t i = 0; i < utf8_length; i++) {
+    const unsigned char c = static_cast<unsigned char>(data[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+    writer_.Append(data + run_start, i - run_start);
+    switch (c) {
+      case '"': writer_.Append("\\\"", 2); break;
+      case '\\': writer_.Append("\\\\", 2); break;
+      case '\b': writer_.Append("\\b", 2); break;
+      case '\f': writer_.Append("\\f", 2); break;
+      case '\n': writer_.Append("\\n", 2); break;
+      case '\r': writer_.Append("\\r", 2); break;
+      case '\t': writer_.Append("\\t", 2); break;
+      default: {
+        char buf[8];
+        const int n = snprintf(buf, sizeof(buf), "\\u%04x", c);
+        writer_.Append(buf, n);
+        break;
+      }
+    }
+    run_start = i + 1;
+  }
+  writer_.Append(data + run_start, utf8_length - run_start);
+  writer_.AppendChar('"');
+  return true;
+}
+
+bool JSONEncoder::Encode(Local<Value> value, int depth, bool honor_to_json) {
+  if (depth > kJSONMaxDepth) {
+    env_->ThrowError("Maximum JSON encoding depth exceeded");
+    return false;
+  }
+  Isolate* isolate = env_->isolate();
+  Local<Context> context = env_->context();
+
+  // Unwrap boxed primitives the way JSON.stringify does.
+  if (value->IsNumberObject()) {
+    value = v8::Number::New(isolate, value.As<v8::NumberObject>()->ValueOf());
+  } else if (value->IsStringObject()) {
+    value = value.As<v8::StringObject>()->ValueOf();
+  } else if (value->IsBooleanObject()) {
+    value = v8::Boolean::New(isolate, value.As<v8::BooleanObject>()->ValueOf());
+  }
+
+  if (value->IsNull()) {
+    writer_.Append("null", 4);
+    return true;
+  }
+  if (value->IsTrue()) {
+    writer_.Append("true", 4);
+    return true;
+  }
+  if (value->IsFalse()) {
+    writer_.Append("false", 5);
+    return true;
+  }
+  if (value->IsNumber()) {
+    const double d = value.As<v8::Number>()->Value();
+    if (!std::isfinite(d)) {
+      writer_.Append("null", 4);
+      return true;
+    }
+    // Number::toString(10) and the JSON number grammar agree for every
+    // finite double; let V8 do the shortest-round-trip formatting.
+    Local<String> str;
+    if (!value->ToString(context).ToLocal(&str)) return false;
+    MaybeStackBuffer<char, 32> buf;
+    buf.AllocateSufficientStorage(str->Utf8Length(isolate));
+    str->WriteUtf8(isolate, buf.out(), buf.length(), nullptr,
+                   String::NO_NULL_TERMINATION);
+    writer_.Append(buf.out(), buf.length());
+    return true;
+  }
+  if (value->IsString()) {
+    return EncodeString(value.As<String>());
+  }
+  if (value->IsBigInt()) {
+    env_->ThrowTypeError("Do not know how to serialize a BigInt");
+    return false;
+  }
+  if (value->IsArray()) {
+    Local<Array> array = value.As<Array>();
+    if (!PushStack(array)) return false;
+    writer_.AppendChar('[');
+    const uint32_t length = array->Length();
+    for (uint32_t i = 0; i < length; i++) {
+      if (i > 0) writer_.AppendChar(',');
+      Local<Value> element;
+      if (!array->Get(context, i).ToLocal(&element)) return false;
+      if (IsSkipped(element)) {
+        writer_.Append("null", 4);
+        continue;
+      }
+      if (!Encode(element, depth + 1)) return false;
+    }
+    writer_.AppendChar(']');
+    stack_.pop_back();
+    return true;
+  }
+  if (value->IsObject()) {
+    Local<Object> object = value.As<Object>();
+
+    if (honor_to_json) {
+      Local<Value> to_json;
+      if (!object->Get(context,
+                       FIXED_ONE_BYTE_STRING(isolate, "toJSON"))
+               .ToLocal(&to_json)) {
+        return false;
+      }
+      if (to_json->IsFunction()) {
+        Local<Value> replacement;
+        if (!to_json.As<Function>()
+                 ->Call(context, object, 0, nullptr)
+                 .ToLocal(&replacement)) {
+          return false;
+        }
+        if (IsSkipped(replacement)) {
+          writer_.Append("null", 4);
+          return true;
+        }
+        // The replacement itself is serialized without another toJSON()
+        // call, per the JSON.stringify algorithm.
+        return Encode(replacement, depth, false);
+      }
+    }
+
+    if (!PushStack(object)) return false;
+    writer_.AppendChar('{');
+    Local<Array> names;
+    if (!object->GetOwnPropertyNames(
+                     context,
+                     static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                     v8::SKIP_SYMBOLS),
+                     v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&names)) {
+      return false;
+    }
+    bool first = true;
+    const uint32_t length = names->Length();
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> key;
+      if (!names->Get(context, i).ToLocal(&key)) return false;
+      Local<Value> property;
+      if (!object->Get(context, key).ToLocal(&property)) return false;
+      if (IsSkipped(property)) continue;
+      if (!first) writer_.AppendChar(',');
+      first = false;
+      if (!EncodeString(key.As<String>())) return false;
+      writer_.AppendChar(':');
+      if (!Encode(property, depth + 1)) return false;
+    }
+    writer_.AppendChar('}');
+    stack_.pop_back();
+    return true;
+  }
+
+  // Externals and other oddities; JSON.stringify has no representation for
+  // them either.
+  writer_.Append("null", 4);
+  return true;
+}
+
+void EncodeJSONChunked(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  size_t chunk_size = kJSONDefaultChunkSize;
+  if (args[1]->IsUint32()) {
+    chunk_size = args[1].As<v8::Uint32>()->Value();
+    if (chunk_size < kJSONMinChunkSize) chunk_size = kJSONMinChunkSize;
+  }
+
+  // Like JSON.stringify(), serializing undefined/functions/symbols at the
+  // top level yields undefined.
+  if (JSONEncoder::IsSkipped(args[0])) return;
+
+  JSONEncoder encoder(env, chunk_size);
+  if (!encoder.Encode(args[0], 0)) return;  // Exception pending.
+
+  Local<Array> chunks;
+  if (!encoder.Finish().ToLocal(&chunks)) return;
+  args.GetReturnValue().Set(chunks);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -498,6 +925,19 @@ void Initialize(Local<Object> target,
   target->Set(env->context(),
               deserializerString,
               des->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  if (env->lazy_clone_handle_template().IsEmpty()) {
+    Local<FunctionTemplate> lazy = FunctionTemplate::New(env->isolate());
+    lazy->SetClassName(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "LazyCloneHandle"));
+    lazy->InstanceTemplate()->SetInternalFieldCount(1);
+    env->SetProtoMethod(lazy, "deserialize", LazyCloneHandle::Deserialize);
+    env->set_lazy_clone_handle_template(lazy->InstanceTemplate());
+  }
+
+  env->SetMethod(target, "clone", LazyCloneHandle::Clone);
+
+  env->SetMethod(target, "encodeJSONChunked", EncodeJSONChunked);
 }
 
 }  // anonymous namespace
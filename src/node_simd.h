@@ -0,0 +1,82 @@
+#ifndef SRC_NODE_SIMD_H_
+#define SRC_NODE_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+// Shared plumbing for the runtime-dispatched vector kernels in base64.cc
+// and string_bytes.cc: architecture selection, intrinsic headers, target
+// attributes and CPU feature probes.
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)
+#define NODE_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NODE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// MSVC allows vector intrinsics unconditionally; GCC and Clang need the
+// target attribute when the translation unit is not compiled with
+// -mssse3/-mavx2 (it is not, since the binary must run on plain x86-64).
+#if defined(NODE_SIMD_X86) && !defined(_MSC_VER)
+#define NODE_TARGET_SSE2 __attribute__((target("sse2")))
+#define NODE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define NODE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NODE_TARGET_SSE2
+#define NODE_TARGET_SSSE3
+#define NODE_TARGET_AVX2
+#endif
+
+namespace node {
+namespace simd {
+
+inline uint32_t CountTrailingZeros32(uint32_t value) {
+#ifdef _MSC_VER
+  unsigned long result;  // NOLINT(runtime/int)
+  _BitScanForward(&result, value);
+  return result;
+#else
+  return __builtin_ctz(value);
+#endif
+}
+
+#ifdef NODE_SIMD_X86
+#ifdef _MSC_VER
+inline bool cpu_has_ssse3() {
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+}
+
+inline bool cpu_has_avx2() {
+  int info[4];
+  __cpuid(info, 1);
+  // AVX2 also needs the OS to save the ymm state.
+  if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+}
+#else
+inline bool cpu_has_ssse3() { return __builtin_cpu_supports("ssse3"); }
+inline bool cpu_has_avx2() { return __builtin_cpu_supports("avx2"); }
+#endif  // _MSC_VER
+#endif  // NODE_SIMD_X86
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SIMD_H_
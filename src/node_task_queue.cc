@@ -42,7 +42,13 @@ static void EnqueueMicrotask(const FunctionCallbackInfo<Value>& args) {
 }
 
 static void RunMicrotasks(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  const uint64_t start = uv_hrtime();
   MicrotasksScope::PerformCheckpoint(args.GetIsolate());
+  // Stored in milliseconds so that the field survives longer without losing
+  // double precision; nanosecond resolution is kept in the fraction.
+  env->task_queue_stats()->fields()[TaskQueueStats::kMicrotaskDrainTime] +=
+      (uv_hrtime() - start) / 1e6;
 }
 
 static void SetTickCallback(const FunctionCallbackInfo<Value>& args) {
@@ -132,6 +138,9 @@ static void Initialize(Local<Object> target,
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(isolate, "tickInfo"),
               env->tick_info()->fields().GetJSArray()).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(isolate, "taskQueueStats"),
+              env->task_queue_stats()->fields().GetJSArray()).Check();
 
   Local<Object> events = Object::New(isolate);
   NODE_DEFINE_CONSTANT(events, kPromiseRejectWithNoHandler);
@@ -47,6 +47,25 @@ namespace {
   VALUE_METHOD_MAP(V)
 #undef V
 
+// Evaluates every predicate from VALUE_METHOD_MAP plus the two composites
+// in a single binding crossing and returns them as a bitmask; bit N
+// corresponds to the N-th entry of the map, in order. Callers that need
+// several predicates for the same value (validation layers typically probe
+// four to six) pay one native call instead of one per predicate.
+static void Classify(const FunctionCallbackInfo<Value>& args) {
+  Local<Value> value = args[0];
+  uint32_t mask = 0;
+  uint32_t bit = 1;
+#define V(type)                                                               \
+  do {                                                                        \
+    if (value->Is##type()) mask |= bit;                                       \
+    bit <<= 1;                                                                \
+  } while (0);
+  VALUE_METHOD_MAP(V)
+#undef V
+  args.GetReturnValue().Set(mask);
+}
+
 static void IsAnyArrayBuffer(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(
     args[0]->IsArrayBuffer() || args[0]->IsSharedArrayBuffer());
@@ -75,6 +94,24 @@ void InitializeTypes(Local<Object> target,
 
   env->SetMethodNoSideEffect(target, "isAnyArrayBuffer", IsAnyArrayBuffer);
   env->SetMethodNoSideEffect(target, "isBoxedPrimitive", IsBoxedPrimitive);
+
+  env->SetMethodNoSideEffect(target, "classify", Classify);
+
+  // Bit positions for classify(), keyed by the predicate name.
+  Local<Object> bits = Object::New(env->isolate());
+  uint32_t bit = 1;
+#define V(type)                                                               \
+  do {                                                                        \
+    bits->Set(context,                                                        \
+              FIXED_ONE_BYTE_STRING(env->isolate(), "is" #type),              \
+              v8::Integer::NewFromUnsigned(env->isolate(), bit)).Check();     \
+    bit <<= 1;                                                                \
+  } while (0);
+  VALUE_METHOD_MAP(V)
+#undef V
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "classifyBits"),
+              bits).Check();
 }
 
 }  // anonymous namespace
@@ -2,10 +2,12 @@
 #include "base_object-inl.h"
 #include "node_errors.h"
 #include "node_i18n.h"
+#include "node_simd.h"
 #include "util-inl.h"
 
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -27,6 +29,7 @@ using v8::NewStringType;
 using v8::Null;
 using v8::Object;
 using v8::String;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -702,26 +705,103 @@ inline std::string PercentDecode(const char* input, size_t len) {
   const char* end = input + len;
 
   while (pointer < end) {
-    const char ch = pointer[0];
+    // Copy the whole run up to the next '%' in one go; escapes are rare
+    // even in inputs that do contain them.
+    const char* next = static_cast<const char*>(
+        memchr(pointer, '%', end - pointer));
+    if (next == nullptr) {
+      dest.append(pointer, end - pointer);
+      break;
+    }
+    dest.append(pointer, next - pointer);
+    pointer = next;
     const size_t remaining = end - pointer - 1;
-    if (ch != '%' || remaining < 2 ||
-        (ch == '%' &&
-         (!IsASCIIHexDigit(pointer[1]) ||
-          !IsASCIIHexDigit(pointer[2])))) {
-      dest += ch;
+    if (remaining < 2 ||
+        !IsASCIIHexDigit(pointer[1]) ||
+        !IsASCIIHexDigit(pointer[2])) {
+      dest += '%';
       pointer++;
-      continue;
     } else {
       unsigned a = hex2bin(pointer[1]);
       unsigned b = hex2bin(pointer[2]);
-      char c = static_cast<char>(a * 16 + b);
-      dest += c;
+      dest += static_cast<char>(a * 16 + b);
       pointer += 3;
     }
   }
   return dest;
 }
 
+// Returns true if host parsing would leave |input| untouched: all bytes
+// ASCII with no '%' (nothing to percent-decode), no uppercase letters
+// (nothing for IDNA to case-fold), and no "xn--" label (which ToASCII
+// would decode and validate). For such hosts -- the overwhelming majority
+// in practice -- both PercentDecode() and the ICU round trip can be
+// skipped. The forbidden-host-code-point and IPv4 checks still run on the
+// result either way.
+#if defined(NODE_SIMD_X86)
+NODE_TARGET_SSE2
+#endif
+bool IsSimpleHost(const char* input, size_t length) {
+  size_t i = 0;
+  bool seen_x = false;
+#if defined(NODE_SIMD_X86)
+  const __m128i percent = _mm_set1_epi8('%');
+  const __m128i upper_a = _mm_set1_epi8('A' - 1);
+  const __m128i upper_z = _mm_set1_epi8('Z' + 1);
+  const __m128i letter_x = _mm_set1_epi8('x');
+  __m128i found_x = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    __m128i bad = _mm_cmpeq_epi8(chunk, percent);
+    bad = _mm_or_si128(bad,
+                       _mm_and_si128(_mm_cmpgt_epi8(chunk, upper_a),
+                                     _mm_cmplt_epi8(chunk, upper_z)));
+    // High bits of |chunk| itself flag non-ASCII bytes.
+    if (_mm_movemask_epi8(_mm_or_si128(bad, chunk)) != 0)
+      return false;
+    found_x = _mm_or_si128(found_x, _mm_cmpeq_epi8(chunk, letter_x));
+  }
+  seen_x = _mm_movemask_epi8(found_x) != 0;
+#elif defined(NODE_SIMD_NEON)
+  uint8x16_t bad = vdupq_n_u8(0);
+  uint8x16_t found_x = vdupq_n_u8(0);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t chunk =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(input + i));
+    bad = vorrq_u8(bad, vceqq_u8(chunk, vdupq_n_u8('%')));
+    bad = vorrq_u8(bad,
+                   vandq_u8(vcgeq_u8(chunk, vdupq_n_u8('A')),
+                            vcleq_u8(chunk, vdupq_n_u8('Z'))));
+    bad = vorrq_u8(bad, vcgeq_u8(chunk, vdupq_n_u8(0x80)));
+    found_x = vorrq_u8(found_x, vceqq_u8(chunk, vdupq_n_u8('x')));
+  }
+  if (vmaxvq_u8(bad) != 0)
+    return false;
+  seen_x = vmaxvq_u8(found_x) != 0;
+#endif
+  for (; i < length; i++) {
+    const char ch = input[i];
+    if (ch == '%' || (ch >= 'A' && ch <= 'Z') ||
+        static_cast<unsigned char>(ch) >= 0x80) {
+      return false;
+    }
+    if (ch == 'x')
+      seen_x = true;
+  }
+  if (seen_x) {
+    // Punycode is only recognized at the start of a label.
+    for (size_t n = 0; n + 4 <= length; n++) {
+      if (input[n] == 'x' && input[n + 1] == 'n' &&
+          input[n + 2] == '-' && input[n + 3] == '-' &&
+          (n == 0 || input[n - 1] == '.')) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 #define SPECIALS(XX)                                                          \
   XX("ftp:", 21)                                                              \
   XX("file:", -1)                                                             \
@@ -1029,12 +1109,18 @@ void URLHost::ParseHost(const char* input,
   if (!is_special)
     return ParseOpaqueHost(input, length);
 
-  // First, we have to percent decode
-  std::string decoded = PercentDecode(input, length);
+  std::string decoded;
+  if (!unicode && IsSimpleHost(input, length)) {
+    // Nothing to percent-decode and IDNA would be the identity.
+    decoded.assign(input, length);
+  } else {
+    // First, we have to percent decode
+    decoded = PercentDecode(input, length);
 
-  // Then we have to punycode toASCII
-  if (!ToASCII(decoded, &decoded))
-    return;
+    // Then we have to punycode toASCII
+    if (!ToASCII(decoded, &decoded))
+      return;
+  }
 
   // If any of the following characters are still present, we have to fail
   for (size_t n = 0; n < decoded.size(); n++) {
@@ -2201,6 +2287,247 @@ static void Parse(const FunctionCallbackInfo<Value>& args) {
         args[5]);
 }
 
+// Entries in the result array filled in by ScanComponents().
+enum scan_component_offset {
+  SCAN_SCHEME_END = 0,   // One past the ':' of the scheme.
+  SCAN_HOST_START,
+  SCAN_HOST_END,
+  SCAN_PORT,             // Parsed port number, kScanNoComponent if absent.
+  SCAN_PATH_START,       // Index of the leading '/', == SCAN_PATH_END if
+                         // the path is empty.
+  SCAN_PATH_END,
+  SCAN_QUERY_START,      // One past the '?', kScanNoComponent if absent.
+  SCAN_FRAGMENT_START,   // One past the '#', kScanNoComponent if absent.
+  SCAN_COMPONENT_COUNT
+};
+
+const uint32_t kScanNoComponent = 0xFFFFFFFF;
+
+// Fast "components scan" for the canonical shape
+//
+//   scheme://host[:port][/path][?query][#fragment]
+//
+// covering the typical ASCII origin+path URL. The scan only succeeds when
+// the input is byte-for-byte what the full state machine would itself
+// serialize, so the reported offsets slice the input into exactly the
+// components a full parse would produce, without running the state machine
+// or building url_data strings. Anything that needs normalization --
+// escaping, case folding, dot segments, IPv4/IPv6 rewriting, userinfo,
+// tab/newline stripping, non-special schemes, base resolution -- bails out
+// and is handled by URL::Parse() as before.
+bool ScanCanonicalComponents(const char* input, size_t len, uint32_t* out) {
+  struct SpecialScheme { const char* name; size_t length; uint32_t port; };
+  static const SpecialScheme kSchemes[] = {
+    { "https", 5, 443 },
+    { "http", 4, 80 },
+    { "wss", 3, 443 },
+    { "ws", 2, 80 },
+    { "ftp", 3, 21 },
+  };
+  // Scheme: lowercase special schemes only, so that the default-port and
+  // separator rules are fixed up front. "file:" is excluded because of its
+  // optional host and Windows drive letter handling.
+  const SpecialScheme* scheme = nullptr;
+  for (const SpecialScheme& candidate : kSchemes) {
+    if (len > candidate.length + 2 &&
+        memcmp(input, candidate.name, candidate.length) == 0 &&
+        input[candidate.length] == ':') {
+      scheme = &candidate;
+      break;
+    }
+  }
+  if (scheme == nullptr)
+    return false;
+  size_t i = scheme->length + 1;
+  out[SCAN_SCHEME_END] = i;
+  if (i + 2 > len || input[i] != '/' || input[i + 1] != '/')
+    return false;
+  i += 2;
+
+  // Host: lowercase ASCII domain characters with non-empty labels and no
+  // "xn--" label; that subset maps to itself under IDNA. A host whose
+  // last label is numeric (or 0x-prefixed) would go through IPv4
+  // normalization, so only a canonical dotted quad is accepted in that
+  // case.
+  const size_t host_start = i;
+  size_t label_start = i;
+  while (i < len) {
+    const char ch = input[i];
+    if (ch == ':' || ch == '/' || ch == '?' || ch == '#')
+      break;
+    if (ch == '.') {
+      if (i == label_start)
+        return false;  // Empty label.
+      label_start = i + 1;
+    } else if (!(ch >= 'a' && ch <= 'z') && !IsASCIIDigit(ch) &&
+               ch != '-' && ch != '_') {
+      return false;
+    }
+    i++;
+  }
+  const size_t host_end = i;
+  if (host_end == host_start || label_start == host_end)
+    return false;  // Empty host or trailing dot.
+  // Punycode labels are not identity-mapped: ToASCII decodes and
+  // validates them and may reject the host outright, so they always take
+  // the full parser. Only the start of a label counts, as in
+  // IsSimpleHost().
+  for (size_t n = host_start; n + 4 <= host_end; n++) {
+    if (input[n] == 'x' && input[n + 1] == 'n' &&
+        input[n + 2] == '-' && input[n + 3] == '-' &&
+        (n == host_start || input[n - 1] == '.')) {
+      return false;
+    }
+  }
+  bool last_label_numeric = true;
+  for (size_t p = label_start; p < host_end; p++) {
+    if (!IsASCIIDigit(input[p])) {
+      last_label_numeric = false;
+      break;
+    }
+  }
+  if (host_end - label_start > 1 &&
+      input[label_start] == '0' && input[label_start + 1] == 'x') {
+    last_label_numeric = true;
+  }
+  if (last_label_numeric) {
+    size_t labels = 0;
+    size_t p = host_start;
+    while (p < host_end) {
+      size_t q = p;
+      uint32_t value = 0;
+      while (q < host_end && IsASCIIDigit(input[q])) {
+        value = value * 10 + (input[q] - '0');
+        if (value > 255)
+          return false;
+        q++;
+      }
+      if (q == p || (input[p] == '0' && q - p > 1))
+        return false;  // Not all-digit, or leading zero.
+      if (q < host_end && input[q] != '.')
+        return false;
+      labels++;
+      p = q + 1;
+    }
+    if (labels != 4)
+      return false;
+  }
+  out[SCAN_HOST_START] = host_start;
+  out[SCAN_HOST_END] = host_end;
+
+  // Port: canonical serializations have no leading zeros and elide the
+  // scheme's default port.
+  uint32_t port = kScanNoComponent;
+  if (i < len && input[i] == ':') {
+    const size_t port_start = ++i;
+    uint32_t value = 0;
+    while (i < len && IsASCIIDigit(input[i])) {
+      value = value * 10 + (input[i] - '0');
+      if (value > 0xffff)
+        return false;
+      i++;
+    }
+    if (i == port_start || (input[port_start] == '0' && i - port_start > 1))
+      return false;
+    if (i < len && input[i] != '/' && input[i] != '?' && input[i] != '#')
+      return false;
+    if (value == scheme->port)
+      return false;
+    port = value;
+  }
+  out[SCAN_PORT] = port;
+
+  // Path: no characters from the path encode set, no backslashes (which
+  // special schemes treat as segment separators), and no segment that the
+  // parser would collapse as "." or ".." (including the %2e spellings).
+  const size_t path_start = i;
+  size_t segment_start = i + 1;
+  auto is_dot_segment = [&] (size_t from, size_t to) {
+    size_t dots = 0;
+    while (from < to) {
+      if (input[from] == '.') {
+        dots++;
+        from++;
+      } else if (to - from >= 3 && input[from] == '%' &&
+                 input[from + 1] == '2' && (input[from + 2] | 0x20) == 'e') {
+        dots++;
+        from += 3;
+      } else {
+        return false;
+      }
+    }
+    return dots == 1 || dots == 2;
+  };
+  if (i < len && input[i] == '/') {
+    i++;
+    while (i < len) {
+      const char ch = input[i];
+      if (ch == '?' || ch == '#')
+        break;
+      if (ch == '/') {
+        if (is_dot_segment(segment_start, i))
+          return false;
+        segment_start = i + 1;
+      } else if (ch == '\\' || BitAt(PATH_ENCODE_SET, ch)) {
+        return false;
+      }
+      i++;
+    }
+    if (is_dot_segment(segment_start, i))
+      return false;
+  }
+  out[SCAN_PATH_START] = path_start;
+  out[SCAN_PATH_END] = i;
+
+  // Query and fragment, using the same encode sets the serializer applies.
+  uint32_t query_start = kScanNoComponent;
+  if (i < len && input[i] == '?') {
+    query_start = ++i;
+    while (i < len && input[i] != '#') {
+      if (BitAt(QUERY_ENCODE_SET_SPECIAL, input[i]))
+        return false;
+      i++;
+    }
+  }
+  out[SCAN_QUERY_START] = query_start;
+
+  uint32_t fragment_start = kScanNoComponent;
+  if (i < len && input[i] == '#') {
+    fragment_start = ++i;
+    while (i < len) {
+      if (BitAt(FRAGMENT_ENCODE_SET, input[i]))
+        return false;
+      i++;
+    }
+  }
+  out[SCAN_FRAGMENT_START] = fragment_start;
+  return i == len;
+}
+
+// scanComponents(input, result): fills the Uint32Array |result| with
+// component offsets into |input| and returns true when the input is in
+// canonical form, false when the caller needs a full parse() instead.
+static void ScanComponents(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_GE(args.Length(), 2);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsUint32Array());
+
+  Utf8Value input(env->isolate(), args[0]);
+  Local<Uint32Array> result_array = args[1].As<Uint32Array>();
+  CHECK_EQ(result_array->Length(),
+           static_cast<size_t>(SCAN_COMPONENT_COUNT));
+  uint32_t* result = reinterpret_cast<uint32_t*>(
+      static_cast<char*>(result_array->Buffer()->GetBackingStore()->Data()) +
+      result_array->ByteOffset());
+
+  // A one-byte length check keeps the offsets representable; anything that
+  // large is not worth a fast path anyway.
+  const bool hit = input.length() < kScanNoComponent &&
+      ScanCanonicalComponents(*input, input.length(), result);
+  args.GetReturnValue().Set(hit);
+}
+
 static void EncodeAuthSet(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK_GE(args.Length(), 1);
@@ -2424,6 +2751,7 @@ static void Initialize(Local<Object> target,
                        void* priv) {
   Environment* env = Environment::GetCurrent(context);
   env->SetMethod(target, "parse", Parse);
+  env->SetMethod(target, "scanComponents", ScanComponents);
   env->SetMethodNoSideEffect(target, "encodeAuth", EncodeAuthSet);
   env->SetMethodNoSideEffect(target, "toUSVString", ToUSVString);
   env->SetMethodNoSideEffect(target, "domainToASCII", DomainToASCII);
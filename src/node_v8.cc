@@ -30,7 +30,10 @@ using v8::Array;
 using v8::ArrayBuffer;
 using v8::BackingStore;
 using v8::Context;
+using v8::Function;
 using v8::FunctionCallbackInfo;
+using v8::GCCallbackFlags;
+using v8::GCType;
 using v8::HeapCodeStatistics;
 using v8::HeapSpaceStatistics;
 using v8::HeapStatistics;
@@ -38,6 +41,7 @@ using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::NewStringType;
+using v8::Number;
 using v8::Object;
 using v8::ScriptCompiler;
 using v8::String;
@@ -107,12 +111,11 @@ void UpdateHeapStatisticsArrayBuffer(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-void UpdateHeapSpaceStatisticsBuffer(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
+static void UpdateHeapSpaceStatistics(Environment* env) {
   HeapSpaceStatistics s;
   Isolate* const isolate = env->isolate();
   double* buffer = env->heap_space_statistics_buffer();
-  size_t number_of_heap_spaces = env->isolate()->NumberOfHeapSpaces();
+  size_t number_of_heap_spaces = isolate->NumberOfHeapSpaces();
 
   for (size_t i = 0; i < number_of_heap_spaces; i++) {
     isolate->GetHeapSpaceStatistics(&s, i);
@@ -125,6 +128,46 @@ void UpdateHeapSpaceStatisticsBuffer(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UpdateHeapSpaceStatisticsBuffer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  UpdateHeapSpaceStatistics(env);
+}
+
+
+// Keeps the heap space statistics buffer fresh from GC epilogues so that
+// reading it does not require a native call (or a heap walk) at all.
+static void HeapSpaceStatisticsGCCallback(Isolate* isolate,
+                                          GCType type,
+                                          GCCallbackFlags flags,
+                                          void* data) {
+  UpdateHeapSpaceStatistics(static_cast<Environment*>(data));
+}
+
+
+static void HeapSpaceStatisticsCleanupHook(void* data) {
+  Environment* env = static_cast<Environment*>(data);
+  env->isolate()->RemoveGCEpilogueCallback(HeapSpaceStatisticsGCCallback,
+                                           data);
+}
+
+
+void SetHeapSpaceStatisticsGCTracking(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsBoolean());
+  void* data = static_cast<void*>(env);
+  if (args[0]->IsTrue()) {
+    env->isolate()->AddGCEpilogueCallback(HeapSpaceStatisticsGCCallback, data);
+    env->AddCleanupHook(HeapSpaceStatisticsCleanupHook, data);
+    // Seed the buffer so that readers see valid numbers before the first GC.
+    UpdateHeapSpaceStatistics(env);
+  } else {
+    env->RemoveCleanupHook(HeapSpaceStatisticsCleanupHook, data);
+    env->isolate()->RemoveGCEpilogueCallback(HeapSpaceStatisticsGCCallback,
+                                             data);
+  }
+}
+
+
 void UpdateHeapCodeStatisticsArrayBuffer(
     const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -137,6 +180,41 @@ void UpdateHeapCodeStatisticsArrayBuffer(
 }
 
 
+void StartAllocationSampling(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  uint32_t interval = args[0].As<Uint32>()->Value();
+  CHECK_GT(interval, 0u);
+  env->StartAllocationSampling(interval);
+}
+
+
+void StopAllocationSampling(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->StopAllocationSampling();
+}
+
+
+// Returns the sample table as a flat array of numbers:
+// [ async_id, count, bytes, async_id, count, bytes, ... ]
+void ReadAllocationSamples(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  const auto& samples = env->allocation_samples();
+  std::vector<Local<Value>> items;
+  items.reserve(samples.size() * 3);
+  for (const auto& entry : samples) {
+    items.push_back(Number::New(isolate, entry.first));
+    items.push_back(Number::New(isolate,
+                                static_cast<double>(entry.second.count)));
+    items.push_back(Number::New(isolate,
+                                static_cast<double>(entry.second.bytes)));
+  }
+  args.GetReturnValue().Set(
+      Array::New(isolate, items.data(), items.size()));
+}
+
+
 void SetFlagsFromString(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsString());
   String::Utf8Value flags(args.GetIsolate(), args[0]);
@@ -144,6 +222,17 @@ void SetFlagsFromString(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Installs (or, when called with a non-function, clears) the JS callback
+// that Environment invokes when heap pressure triggers cache eviction.
+void SetMemoryPressureCallback(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (args[0]->IsFunction())
+    env->set_memory_pressure_callback(args[0].As<Function>());
+  else
+    env->set_memory_pressure_callback(Local<Function>());
+}
+
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -236,6 +325,17 @@ void Initialize(Local<Object> target,
                  "updateHeapSpaceStatisticsArrayBuffer",
                  UpdateHeapSpaceStatisticsBuffer);
 
+  env->SetMethod(target,
+                 "setHeapSpaceStatisticsGCTracking",
+                 SetHeapSpaceStatisticsGCTracking);
+
+  // Export symbols used by v8.startAllocationSampling() et al.
+  env->SetMethod(target, "startAllocationSampling", StartAllocationSampling);
+  env->SetMethod(target, "stopAllocationSampling", StopAllocationSampling);
+  env->SetMethodNoSideEffect(target,
+                             "readAllocationSamples",
+                             ReadAllocationSamples);
+
   const size_t heap_space_statistics_buffer_byte_length =
       sizeof(*env->heap_space_statistics_buffer()) *
       kHeapSpaceStatisticsPropertiesCount *
@@ -262,6 +362,11 @@ void Initialize(Local<Object> target,
 
   // Export symbols used by v8.setFlagsFromString()
   env->SetMethod(target, "setFlagsFromString", SetFlagsFromString);
+
+  // Export symbols used by v8.setMemoryPressureCallback()
+  env->SetMethod(target,
+                 "setMemoryPressureCallback",
+                 SetMemoryPressureCallback);
 }
 
 }  // namespace node
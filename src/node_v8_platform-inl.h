@@ -9,6 +9,7 @@
 #include "node.h"
 #include "node_metadata.h"
 #include "node_options.h"
+#include "tracing/node_binary_trace_writer.h"
 #include "tracing/node_trace_writer.h"
 #include "tracing/trace_event.h"
 #include "tracing/traced_value.h"
@@ -120,12 +121,19 @@ struct V8Platform {
       std::vector<std::string> categories =
           SplitString(per_process::cli_options->trace_event_categories, ',');
 
+      std::unique_ptr<tracing::AsyncTraceWriter> writer;
+      if (!per_process::cli_options->trace_event_binary_file.empty()) {
+        writer.reset(new tracing::NodeBinaryTraceWriter(
+            per_process::cli_options->trace_event_binary_file));
+      } else {
+        writer.reset(new tracing::NodeTraceWriter(
+            per_process::cli_options->trace_event_file_pattern));
+      }
+
       tracing_file_writer_ = tracing_agent_->AddClient(
           std::set<std::string>(std::make_move_iterator(categories.begin()),
                                 std::make_move_iterator(categories.end())),
-          std::unique_ptr<tracing::AsyncTraceWriter>(
-              new tracing::NodeTraceWriter(
-                  per_process::cli_options->trace_event_file_pattern)),
+          std::move(writer),
           tracing::Agent::kUseDefaultCategories);
     }
   }
@@ -631,12 +631,9 @@ void WASI::FdPread(const FunctionCallbackInfo<Value>& args) {
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, iovs_ptr, iovs_len * 8);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nread_ptr, 4);
-  uvwasi_iovec_t* iovs = UncheckedCalloc<uvwasi_iovec_t>(iovs_len);
-
-  if (iovs == nullptr) {
-    args.GetReturnValue().Set(UVWASI_ENOMEM);
-    return;
-  }
+  // Marshaled in a single bounds-check pass; typical iovs counts live on
+  // the stack, so hot read/write calls allocate nothing.
+  MaybeStackBuffer<uvwasi_iovec_t, 16> iovs(iovs_len);
 
   for (uint32_t i = 0; i < iovs_len; ++i) {
     uint32_t buf_ptr;
@@ -646,7 +643,6 @@ void WASI::FdPread(const FunctionCallbackInfo<Value>& args) {
     wasi->readUInt32(memory, &buf_len, iovs_ptr + 4);
 
     if (is_access_oob(mem_size, buf_ptr, buf_len)) {
-      free(iovs);
       args.GetReturnValue().Set(UVWASI_EOVERFLOW);
       return;
     }
@@ -659,14 +655,13 @@ void WASI::FdPread(const FunctionCallbackInfo<Value>& args) {
   size_t nread;
   uvwasi_errno_t err = uvwasi_fd_pread(&wasi->uvw_,
                                        fd,
-                                       iovs,
+                                       *iovs,
                                        iovs_len,
                                        offset,
                                        &nread);
   if (err == UVWASI_ESUCCESS)
     wasi->writeUInt32(memory, nread, nread_ptr);
 
-  free(iovs);
   args.GetReturnValue().Set(err);
 }
 
@@ -745,12 +740,7 @@ void WASI::FdPwrite(const FunctionCallbackInfo<Value>& args) {
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, iovs_ptr, iovs_len * 8);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nwritten_ptr, 4);
-  uvwasi_ciovec_t* iovs = UncheckedCalloc<uvwasi_ciovec_t>(iovs_len);
-
-  if (iovs == nullptr) {
-    args.GetReturnValue().Set(UVWASI_ENOMEM);
-    return;
-  }
+  MaybeStackBuffer<uvwasi_ciovec_t, 16> iovs(iovs_len);
 
   for (uint32_t i = 0; i < iovs_len; ++i) {
     uint32_t buf_ptr;
@@ -760,7 +750,6 @@ void WASI::FdPwrite(const FunctionCallbackInfo<Value>& args) {
     wasi->readUInt32(memory, &buf_len, iovs_ptr + 4);
 
     if (is_access_oob(mem_size, buf_ptr, buf_len)) {
-      free(iovs);
       args.GetReturnValue().Set(UVWASI_EOVERFLOW);
       return;
     }
@@ -773,14 +762,13 @@ void WASI::FdPwrite(const FunctionCallbackInfo<Value>& args) {
   size_t nwritten;
   uvwasi_errno_t err = uvwasi_fd_pwrite(&wasi->uvw_,
                                         fd,
-                                        iovs,
+                                        *iovs,
                                         iovs_len,
                                         offset,
                                         &nwritten);
   if (err == UVWASI_ESUCCESS)
     wasi->writeUInt32(memory, nwritten, nwritten_ptr);
 
-  free(iovs);
   args.GetReturnValue().Set(err);
 }
 
@@ -803,12 +791,7 @@ void WASI::FdRead(const FunctionCallbackInfo<Value>& args) {
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, iovs_ptr, iovs_len * 8);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nread_ptr, 4);
-  uvwasi_iovec_t* iovs = UncheckedCalloc<uvwasi_iovec_t>(iovs_len);
-
-  if (iovs == nullptr) {
-    args.GetReturnValue().Set(UVWASI_ENOMEM);
-    return;
-  }
+  MaybeStackBuffer<uvwasi_iovec_t, 16> iovs(iovs_len);
 
   for (uint32_t i = 0; i < iovs_len; ++i) {
     uint32_t buf_ptr;
@@ -818,7 +801,6 @@ void WASI::FdRead(const FunctionCallbackInfo<Value>& args) {
     wasi->readUInt32(memory, &buf_len, iovs_ptr + 4);
 
     if (is_access_oob(mem_size, buf_ptr, buf_len)) {
-      free(iovs);
       args.GetReturnValue().Set(UVWASI_EOVERFLOW);
       return;
     }
@@ -831,13 +813,12 @@ void WASI::FdRead(const FunctionCallbackInfo<Value>& args) {
   size_t nread;
   uvwasi_errno_t err = uvwasi_fd_read(&wasi->uvw_,
                                       fd,
-                                      iovs,
+                                      *iovs,
                                       iovs_len,
                                       &nread);
   if (err == UVWASI_ESUCCESS)
     wasi->writeUInt32(memory, nread, nread_ptr);
 
-  free(iovs);
   args.GetReturnValue().Set(err);
 }
 
@@ -984,12 +965,7 @@ void WASI::FdWrite(const FunctionCallbackInfo<Value>& args) {
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, iovs_ptr, iovs_len * 8);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nwritten_ptr, 4);
-  uvwasi_ciovec_t* iovs = UncheckedCalloc<uvwasi_ciovec_t>(iovs_len);
-
-  if (iovs == nullptr) {
-    args.GetReturnValue().Set(UVWASI_ENOMEM);
-    return;
-  }
+  MaybeStackBuffer<uvwasi_ciovec_t, 16> iovs(iovs_len);
 
   for (uint32_t i = 0; i < iovs_len; ++i) {
     uint32_t buf_ptr;
@@ -999,7 +975,6 @@ void WASI::FdWrite(const FunctionCallbackInfo<Value>& args) {
     wasi->readUInt32(memory, &buf_len, iovs_ptr + 4);
 
     if (is_access_oob(mem_size, buf_ptr, buf_len)) {
-      free(iovs);
       args.GetReturnValue().Set(UVWASI_EOVERFLOW);
       return;
     }
@@ -1012,13 +987,12 @@ void WASI::FdWrite(const FunctionCallbackInfo<Value>& args) {
   size_t nwritten;
   uvwasi_errno_t err = uvwasi_fd_write(&wasi->uvw_,
                                        fd,
-                                       iovs,
+                                       *iovs,
                                        iovs_len,
                                        &nwritten);
   if (err == UVWASI_ESUCCESS)
     wasi->writeUInt32(memory, nwritten, nwritten_ptr);
 
-  free(iovs);
   args.GetReturnValue().Set(err);
 }
 
@@ -1705,6 +1679,11 @@ void WASI::_SetMemory(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   ASSIGN_OR_RETURN_UNWRAP(&wasi, args.This());
   wasi->memory_.Reset(wasi->env()->isolate(), args[0].As<Object>());
+  // The memory object changed; drop the memoized translation.
+  wasi->cached_buffer_.Reset();
+  wasi->cached_backing_store_.reset();
+  wasi->cached_store_ = nullptr;
+  wasi->cached_size_ = 0;
 }
 
 
@@ -1785,6 +1764,21 @@ void WASI::writeUInt64(char* memory, uint64_t value, uint32_t offset) {
 
 uvwasi_errno_t WASI::backingStore(char** store, size_t* byte_length) {
   Environment* env = this->env();
+
+  // Fast path: reuse the memoized translation as long as the cached
+  // ArrayBuffer is still attached. memory.grow() detaches the old buffer
+  // (its byte length drops to zero), which sends us down the slow path.
+  if (!cached_buffer_.IsEmpty()) {
+    Local<ArrayBuffer> cached = PersistentToLocal::Strong(cached_buffer_);
+    if (cached_size_ > 0 && cached->ByteLength() == cached_size_) {
+      *store = cached_store_;
+      *byte_length = cached_size_;
+      return UVWASI_ESUCCESS;
+    }
+    cached_buffer_.Reset();
+    cached_backing_store_.reset();
+  }
+
   Local<Object> memory = PersistentToLocal::Strong(this->memory_);
   Local<Value> prop;
 
@@ -1798,6 +1792,11 @@ uvwasi_errno_t WASI::backingStore(char** store, size_t* byte_length) {
   std::shared_ptr<BackingStore> backing_store = ab->GetBackingStore();
   *byte_length = backing_store->ByteLength();
   *store = static_cast<char*>(backing_store->Data());
+
+  cached_buffer_.Reset(env->isolate(), ab);
+  cached_backing_store_ = std::move(backing_store);
+  cached_store_ = *store;
+  cached_size_ = *byte_length;
   return UVWASI_ESUCCESS;
 }
 
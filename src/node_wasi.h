@@ -7,6 +7,8 @@
 #include "node_mem.h"
 #include "uvwasi.h"
 
+#include <memory>
+
 namespace node {
 namespace wasi {
 
@@ -95,6 +97,15 @@ class WASI : public BaseObject,
   uvwasi_errno_t backingStore(char** store, size_t* byte_length);
   uvwasi_t uvw_;
   v8::Global<v8::Object> memory_;
+  // Memory translation cache: every syscall needs the linear memory's
+  // base pointer, but looking it up means a JS property read plus a
+  // BackingStore acquisition. The result is memoized until the cached
+  // ArrayBuffer is detached by a memory.grow() or the memory object is
+  // replaced through _SetMemory().
+  v8::Global<v8::ArrayBuffer> cached_buffer_;
+  std::shared_ptr<v8::BackingStore> cached_backing_store_;
+  char* cached_store_ = nullptr;
+  size_t cached_size_ = 0;
   uvwasi_mem_t alloc_info_;
   size_t current_uvwasi_memory_ = 0;
 };
@@ -91,6 +91,145 @@ void Watchdog::Timer(uv_timer_t* timer) {
 }
 
 
+LoopStallWatchdog::LoopStallWatchdog(Environment* env, uint64_t threshold_ms)
+    : env_(env),
+      threshold_ns_(threshold_ms * 1000 * 1000),
+      last_heartbeat_(uv_hrtime()) {
+  int rc;
+  rc = uv_loop_init(&loop_);
+  if (rc != 0) {
+    FatalError("node::LoopStallWatchdog::LoopStallWatchdog()",
+               "Failed to initialize uv loop.");
+  }
+
+  rc = uv_async_init(&loop_, &async_, [](uv_async_t* signal) {
+    LoopStallWatchdog* wd = ContainerOf(&LoopStallWatchdog::async_, signal);
+    uv_stop(&wd->loop_);
+  });
+  CHECK_EQ(0, rc);
+
+  rc = uv_timer_init(&loop_, &timer_);
+  CHECK_EQ(0, rc);
+
+  // Polling at half the threshold bounds detection latency to 1.5x the
+  // threshold while keeping the helper thread essentially idle.
+  uint64_t interval = std::max<uint64_t>(threshold_ms / 2, 1);
+  rc = uv_timer_start(&timer_, &LoopStallWatchdog::Timer, interval, interval);
+  CHECK_EQ(0, rc);
+
+  rc = uv_thread_create(&thread_, &LoopStallWatchdog::Run, this);
+  CHECK_EQ(0, rc);
+}
+
+
+LoopStallWatchdog::~LoopStallWatchdog() {
+  uv_async_send(&async_);
+  uv_thread_join(&thread_);
+
+  uv_close(reinterpret_cast<uv_handle_t*>(&async_), nullptr);
+
+  // UV_RUN_DEFAULT so that libuv has a chance to clean up.
+  uv_run(&loop_, UV_RUN_DEFAULT);
+
+  CheckedUvLoopClose(&loop_);
+}
+
+
+void LoopStallWatchdog::Heartbeat(bool in_poll) {
+  last_heartbeat_.store(uv_hrtime(), std::memory_order_relaxed);
+  in_poll_.store(in_poll, std::memory_order_relaxed);
+}
+
+
+std::vector<LoopStallWatchdog::Sample> LoopStallWatchdog::DrainSamples() {
+  Mutex::ScopedLock lock(samples_mutex_);
+  std::vector<Sample> samples;
+  samples.swap(samples_);
+  return samples;
+}
+
+
+void LoopStallWatchdog::Run(void* arg) {
+  LoopStallWatchdog* wd = static_cast<LoopStallWatchdog*>(arg);
+
+  // The loop is stopped by the async handle when the watchdog is destroyed.
+  uv_run(&wd->loop_, UV_RUN_DEFAULT);
+
+  // Close the timer handle on this side and let the destructor close async_.
+  uv_close(reinterpret_cast<uv_handle_t*>(&wd->timer_), nullptr);
+}
+
+
+void LoopStallWatchdog::Timer(uv_timer_t* timer) {
+  LoopStallWatchdog* wd = ContainerOf(&LoopStallWatchdog::timer_, timer);
+
+  // Blocking in poll means the loop is idle, not stalled; an interrupt would
+  // not be serviced there anyway since no JS is running.
+  if (wd->in_poll_.load(std::memory_order_relaxed))
+    return;
+
+  uint64_t last = wd->last_heartbeat_.load(std::memory_order_relaxed);
+  if (uv_hrtime() - last < wd->threshold_ns_)
+    return;
+
+  // Only one interrupt may be in flight; a long stall produces one sample
+  // per timer interval, which is what a flamegraph wants.
+  if (wd->interrupt_pending_.exchange(true, std::memory_order_acq_rel))
+    return;
+
+  // The interrupt data is the Environment rather than the watchdog so that a
+  // request that fires during teardown, after the watchdog is gone, can be
+  // detected and ignored.
+  wd->env_->isolate()->RequestInterrupt(CaptureStackSample, wd->env_);
+}
+
+
+void LoopStallWatchdog::CaptureStackSample(v8::Isolate* isolate, void* data) {
+  Environment* env = static_cast<Environment*>(data);
+  LoopStallWatchdog* wd = env->loop_stall_watchdog();
+  if (wd == nullptr)
+    return;
+  wd->Capture(isolate);
+}
+
+
+void LoopStallWatchdog::Capture(v8::Isolate* isolate) {
+  const uint64_t now = uv_hrtime();
+  Sample sample;
+  sample.timestamp = now;
+  sample.stall_duration =
+      now - last_heartbeat_.load(std::memory_order_relaxed);
+
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack = v8::StackTrace::CurrentStackTrace(
+      isolate, kMaxFrames, v8::StackTrace::kDetailed);
+  const int frame_count = stack->GetFrameCount();
+  sample.frames.reserve(frame_count);
+  for (int i = 0; i < frame_count; i++) {
+    v8::Local<v8::StackFrame> frame = stack->GetFrame(isolate, i);
+    Utf8Value name(isolate, frame->GetFunctionName());
+    Utf8Value script(isolate, frame->GetScriptNameOrSourceURL());
+    std::string entry = name.length() > 0 ? *name : "<anonymous>";
+    entry += " (";
+    entry += script.length() > 0 ? *script : "<unknown>";
+    entry += ':';
+    entry += std::to_string(frame->GetLineNumber());
+    entry += ':';
+    entry += std::to_string(frame->GetColumn());
+    entry += ')';
+    sample.frames.emplace_back(std::move(entry));
+  }
+
+  {
+    Mutex::ScopedLock lock(samples_mutex_);
+    if (samples_.size() >= kMaxSamples)
+      samples_.erase(samples_.begin());
+    samples_.emplace_back(std::move(sample));
+  }
+  interrupt_pending_.store(false, std::memory_order_release);
+}
+
+
 SigintWatchdog::SigintWatchdog(
   v8::Isolate* isolate, bool* received_signal)
     : isolate_(isolate), received_signal_(received_signal) {
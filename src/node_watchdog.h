@@ -26,6 +26,8 @@
 
 #include "uv.h"
 #include "node_mutex.h"
+#include <atomic>
+#include <string>
 #include <vector>
 
 #ifdef __POSIX__
@@ -34,6 +36,8 @@
 
 namespace node {
 
+class Environment;
+
 class Watchdog {
  public:
   explicit Watchdog(v8::Isolate* isolate,
@@ -54,6 +58,50 @@ class Watchdog {
   bool* timed_out_;
 };
 
+// Samples the main thread from a helper thread and captures a JS stack trace
+// whenever a single event loop turn exceeds a configurable threshold, for
+// diagnosing short production stalls that never become outages. Enabled with
+// --loop-stall-threshold; samples are drained via process.loopStallSamples().
+class LoopStallWatchdog {
+ public:
+  struct Sample {
+    uint64_t timestamp;       // uv_hrtime() at capture
+    uint64_t stall_duration;  // nanoseconds since the last loop heartbeat
+    std::vector<std::string> frames;
+  };
+
+  LoopStallWatchdog(Environment* env, uint64_t threshold_ms);
+  ~LoopStallWatchdog();
+
+  // Called on the main thread around the poll phase; poll wait is the loop
+  // idling, not a stall, so detection is suspended while in_poll is set.
+  void Heartbeat(bool in_poll);
+  std::vector<Sample> DrainSamples();
+
+ private:
+  static void Run(void* arg);
+  static void Timer(uv_timer_t* timer);
+  static void CaptureStackSample(v8::Isolate* isolate, void* data);
+  void Capture(v8::Isolate* isolate);
+
+  static constexpr size_t kMaxSamples = 64;
+  static constexpr int kMaxFrames = 64;
+
+  Environment* env_;
+  const uint64_t threshold_ns_;
+  std::atomic<uint64_t> last_heartbeat_;
+  std::atomic<bool> in_poll_ { false };
+  std::atomic<bool> interrupt_pending_ { false };
+
+  Mutex samples_mutex_;
+  std::vector<Sample> samples_;
+
+  uv_thread_t thread_;
+  uv_loop_t loop_;
+  uv_async_t async_;
+  uv_timer_t timer_;
+};
+
 class SigintWatchdog {
  public:
   explicit SigintWatchdog(v8::Isolate* isolate,
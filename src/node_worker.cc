@@ -16,6 +16,12 @@
 #include <string>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif  // __linux__
+
 using node::kDisallowedInEnvironment;
 using v8::Array;
 using v8::ArrayBuffer;
@@ -82,6 +88,7 @@ Worker::Worker(Environment* env,
 #endif
 
   argv_ = std::vector<std::string>{env->argv()[0]};
+  spawn_budget_ = env->options()->worker_spawn_budget;
   // Mark this Worker object as weak until we actually start the thread.
   MakeWeak();
 
@@ -225,6 +232,62 @@ size_t Worker::NearHeapLimit(void* data, size_t current_heap_limit,
   return current_heap_limit + kExtraHeapAllowance;
 }
 
+bool Worker::RecordSpawnPhase(SpawnPhases phase) {
+  uint64_t now = uv_hrtime();
+  uint64_t elapsed;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    spawn_timing_[phase] = now;
+    elapsed = now - spawn_timing_[kSpawnStarted];
+  }
+  if (spawn_budget_ == 0 || elapsed / 1000000 <= spawn_budget_)
+    return false;
+  Debug(this,
+        "Worker %llu exceeded spawn budget after phase %d",
+        thread_id_,
+        static_cast<int>(phase));
+  custom_error_ = "ERR_WORKER_SPAWN_BUDGET_EXCEEDED";
+  Exit(1);
+  return true;
+}
+
+bool Worker::ApplyScheduling() {
+  if (cpu_set_.empty() && !has_priority_) return true;
+#ifdef __linux__
+  if (!cpu_set_.empty()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : cpu_set_) CPU_SET(cpu, &cpus);
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      Debug(this,
+            "Worker %llu failed to apply CPU affinity: %d",
+            thread_id_,
+            err);
+      custom_error_ = "ERR_WORKER_SCHEDULING_FAILED";
+      Exit(1);
+      return false;
+    }
+  }
+  if (has_priority_) {
+    // On Linux the nice value is per-thread; pid 0 addresses the calling
+    // thread here, not the whole process.
+    errno = 0;
+    if (setpriority(PRIO_PROCESS, 0, priority_) != 0 && errno != 0) {
+      Debug(this,
+            "Worker %llu failed to set priority %d: %d",
+            thread_id_,
+            priority_,
+            errno);
+      custom_error_ = "ERR_WORKER_SCHEDULING_FAILED";
+      Exit(1);
+      return false;
+    }
+  }
+#endif  // __linux__
+  return true;
+}
+
 void Worker::Run() {
   std::string name = "WorkerThread ";
   name += std::to_string(thread_id_);
@@ -233,10 +296,16 @@ void Worker::Run() {
       TRACE_STR_COPY(name.c_str()));
   CHECK_NOT_NULL(platform_);
 
+  // Pin/deprioritize before any isolate setup work happens, so that the
+  // spawn phase itself already runs with the requested parameters.
+  if (!ApplyScheduling()) return;
+
   Debug(this, "Creating isolate for worker with id %llu", thread_id_);
 
+  RecordSpawnPhase(kSpawnStarted);
   WorkerThreadData data(this);
   if (isolate_ == nullptr) return;
+  if (RecordSpawnPhase(kSpawnIsolateReady)) return;
 
   Debug(this, "Starting worker with id %llu", thread_id_);
   {
@@ -301,6 +370,7 @@ void Worker::Run() {
 
       if (is_stopped()) return;
       CHECK(!context.IsEmpty());
+      if (RecordSpawnPhase(kSpawnContextReady)) return;
       Context::Scope context_scope(context);
       {
         // TODO(addaleax): Use CreateEnvironment(), or generally another
@@ -324,6 +394,7 @@ void Worker::Run() {
         this->env_ = env_.get();
       }
       Debug(this, "Created Environment for worker with id %llu", thread_id_);
+      if (RecordSpawnPhase(kSpawnEnvironmentReady)) return;
       if (is_stopped()) return;
       {
         env_->InitializeDiagnostics();
@@ -347,6 +418,7 @@ void Worker::Run() {
 
         Debug(this, "Loaded environment for worker %llu", thread_id_);
       }
+      if (RecordSpawnPhase(kSpawnBootstrapComplete)) return;
 
       if (is_stopped()) return;
       {
@@ -542,6 +614,40 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
                            sizeof(worker->resource_limits_));
 }
 
+// setScheduling(cpuSet, priority): stores CPU affinity and nice value to be
+// applied from the worker thread when it starts. Returns whether the running
+// platform supports applying them at all; values are range-checked by the
+// JS layer, actual kernel rejection is reported asynchronously via
+// ERR_WORKER_SCHEDULING_FAILED.
+void Worker::SetScheduling(const FunctionCallbackInfo<Value>& args) {
+  Worker* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+  Mutex::ScopedLock lock(w->mutex_);
+  CHECK(w->thread_joined_);  // The Worker has not started yet.
+
+  Environment* env = Environment::GetCurrent(args);
+  if (args[0]->IsArray()) {
+    Local<Array> cpus = args[0].As<Array>();
+    const uint32_t length = cpus->Length();
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> cpu;
+      if (!cpus->Get(env->context(), i).ToLocal(&cpu)) return;
+      CHECK(cpu->IsUint32());
+      w->cpu_set_.push_back(cpu.As<v8::Uint32>()->Value());
+    }
+  }
+  if (args[1]->IsInt32()) {
+    w->priority_ = args[1].As<v8::Int32>()->Value();
+    w->has_priority_ = true;
+  }
+
+#ifdef __linux__
+  args.GetReturnValue().Set(true);
+#else
+  args.GetReturnValue().Set(false);
+#endif  // __linux__
+}
+
 void Worker::CloneParentEnvVars(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
@@ -626,6 +732,33 @@ void Worker::GetResourceLimits(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(w->GetResourceLimits(args.GetIsolate()));
 }
 
+void Worker::GetSpawnTiming(const FunctionCallbackInfo<Value>& args) {
+  Worker* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+  Isolate* isolate = args.GetIsolate();
+
+  uint64_t timing[kTotalSpawnPhaseCount];
+  {
+    Mutex::ScopedLock lock(w->mutex_);
+    memcpy(timing, w->spawn_timing_, sizeof(timing));
+  }
+
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, sizeof(double) *
+                                           kTotalSpawnPhaseCount);
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+  // The start is reported relative to the process' time origin so it can
+  // serve as a PerformanceEntry start time; the later phases are reported
+  // as offsets from the start (and 0 if the phase was not reached yet).
+  fields[kSpawnStarted] = timing[kSpawnStarted] == 0 ? 0 :
+      (timing[kSpawnStarted] - performance::timeOrigin) / 1e6;
+  for (int i = kSpawnIsolateReady; i < kTotalSpawnPhaseCount; i++) {
+    fields[i] = timing[i] == 0 ? 0 :
+        (timing[i] - timing[kSpawnStarted]) / 1e6;
+  }
+  args.GetReturnValue().Set(
+      Float64Array::New(ab, 0, kTotalSpawnPhaseCount));
+}
+
 Local<Float64Array> Worker::GetResourceLimits(Isolate* isolate) const {
   Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, sizeof(resource_limits_));
 
@@ -678,6 +811,8 @@ void InitWorker(Local<Object> target,
     env->SetProtoMethod(w, "ref", Worker::Ref);
     env->SetProtoMethod(w, "unref", Worker::Unref);
     env->SetProtoMethod(w, "getResourceLimits", Worker::GetResourceLimits);
+    env->SetProtoMethod(w, "getSpawnTiming", Worker::GetSpawnTiming);
+    env->SetProtoMethod(w, "setScheduling", Worker::SetScheduling);
 
     Local<String> workerString =
         FIXED_ONE_BYTE_STRING(env->isolate(), "Worker");
@@ -719,6 +854,13 @@ void InitWorker(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kMaxOldGenerationSizeMb);
   NODE_DEFINE_CONSTANT(target, kCodeRangeSizeMb);
   NODE_DEFINE_CONSTANT(target, kTotalResourceLimitCount);
+
+  NODE_DEFINE_CONSTANT(target, kSpawnStarted);
+  NODE_DEFINE_CONSTANT(target, kSpawnIsolateReady);
+  NODE_DEFINE_CONSTANT(target, kSpawnContextReady);
+  NODE_DEFINE_CONSTANT(target, kSpawnEnvironmentReady);
+  NODE_DEFINE_CONSTANT(target, kSpawnBootstrapComplete);
+  NODE_DEFINE_CONSTANT(target, kTotalSpawnPhaseCount);
 }
 
 }  // anonymous namespace
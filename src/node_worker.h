@@ -19,6 +19,17 @@ enum ResourceLimits {
   kTotalResourceLimitCount
 };
 
+// Phases of the worker thread's startup sequence, in the order in which
+// they are passed. Timestamps for each phase are recorded in Run().
+enum SpawnPhases {
+  kSpawnStarted,
+  kSpawnIsolateReady,
+  kSpawnContextReady,
+  kSpawnEnvironmentReady,
+  kSpawnBootstrapComplete,
+  kTotalSpawnPhaseCount
+};
+
 // A worker thread, as represented in its parent thread.
 class Worker : public AsyncWrap {
  public:
@@ -60,6 +71,8 @@ class Worker : public AsyncWrap {
   static void GetResourceLimits(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   v8::Local<v8::Float64Array> GetResourceLimits(v8::Isolate* isolate) const;
+  static void GetSpawnTiming(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetScheduling(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
   void CreateEnvMessagePort(Environment* env);
@@ -92,6 +105,26 @@ class Worker : public AsyncWrap {
   double resource_limits_[kTotalResourceLimitCount];
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
 
+  // uv_hrtime() timestamps for each startup phase, recorded by the worker
+  // thread and read by the parent thread; 0 until the phase is reached.
+  uint64_t spawn_timing_[kTotalSpawnPhaseCount] = {0};
+  // Maximum time the startup sequence may take in milliseconds, copied
+  // from --worker-spawn-budget; 0 disables the deadline.
+  uint64_t spawn_budget_ = 0;
+  // Records the timestamp for `phase` and returns true if the spawn budget
+  // has been exceeded, in which case the caller should abort startup.
+  // Only called from the worker thread.
+  bool RecordSpawnPhase(SpawnPhases phase);
+
+  // Scheduling parameters from the `cpuSet`/`priority` Worker options,
+  // stored before the thread starts and applied from the worker thread at
+  // the top of Run(). Returns false (with custom_error_ set and Exit()
+  // requested) if the kernel rejected them.
+  bool ApplyScheduling();
+  std::vector<int> cpu_set_;
+  bool has_priority_ = false;
+  int priority_ = 0;
+
   // Full size of the thread's stack.
   static constexpr size_t kStackSize = 4 * 1024 * 1024;
   // Stack buffer size that is not available to the JS engine.
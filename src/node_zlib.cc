@@ -37,15 +37,20 @@
 #include <sys/types.h>
 
 #include <cerrno>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
 using v8::Context;
+using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -54,10 +59,13 @@ using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Local;
+using v8::Null;
 using v8::Object;
+using v8::ObjectTemplate;
 using v8::String;
 using v8::Uint32;
 using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -121,9 +129,19 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// Number of input bytes sampled into a byte histogram before the adaptive
+// mode picks a compression level, and the Shannon entropy thresholds (in
+// bits per byte) above which it downgrades to Z_BEST_SPEED or
+// Z_NO_COMPRESSION. Already-compressed or encrypted payloads sit near 8
+// bits/byte, where further deflate effort is wasted.
+constexpr size_t kAdaptiveSampleBytes = 16 * 1024;
+constexpr double kAdaptiveStoreEntropy = 7.5;
+constexpr double kAdaptiveFastEntropy = 6.5;
+
 class ZlibContext : public MemoryRetainer {
  public:
-  ZlibContext() = default;
+  ZlibContext() : strm_(new z_stream()) {}
+  ~ZlibContext() override { delete strm_; }
 
   // Streaming-related, should be available for all compression libraries:
   void Close();
@@ -134,12 +152,22 @@ class ZlibContext : public MemoryRetainer {
   CompressionError GetErrorInfo() const;
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
   CompressionError ResetStream();
+  // Parks the initialized stream in the per-Environment pool instead of
+  // running deflateEnd()/inflateEnd(), if there is room. `memory` is the
+  // number of zlib allocation bytes currently attributed to the state; it is
+  // transferred to whichever stream adopts it later. Returns false if the
+  // state was not pooled (and still needs Close()).
+  bool ReleaseToPool(Environment* env, size_t memory);
 
   // Zlib-specific:
   CompressionError Init(int level, int window_bits, int mem_level, int strategy,
-                        std::vector<unsigned char>&& dictionary);
+                        std::vector<unsigned char>&& dictionary,
+                        Environment* env, size_t* pooled_memory);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
+  // Content-aware level adaptation: sample the first kAdaptiveSampleBytes of
+  // input and lower the level for high-entropy (incompressible) streams.
+  inline void EnableAdaptiveLevel() { adaptive_ = true; }
 
   SET_MEMORY_INFO_NAME(ZlibContext)
   SET_SELF_SIZE(ZlibContext)
@@ -154,6 +182,8 @@ class ZlibContext : public MemoryRetainer {
  private:
   CompressionError ErrorForMessage(const char* message) const;
   CompressionError SetDictionary();
+  bool AcquirePooledState(Environment* env, size_t* pooled_memory);
+  void SampleAndAdaptLevel();
 
   int err_ = 0;
   int flush_ = 0;
@@ -165,7 +195,17 @@ class ZlibContext : public MemoryRetainer {
   unsigned int gzip_id_bytes_read_ = 0;
   std::vector<unsigned char> dictionary_;
 
-  z_stream strm_;
+  // Adaptive level selection state; the histogram is only touched from the
+  // thread pool while a write is in flight.
+  bool adaptive_ = false;
+  bool adaptive_decided_ = false;
+  size_t adaptive_sampled_ = 0;
+  uint32_t adaptive_histogram_[256] = {};
+
+  // Heap-allocated (and owned) because zlib stores a back-pointer to the
+  // z_stream inside its internal state, which would dangle if the stream
+  // moved between this context and the per-Environment pool by value.
+  z_stream* strm_;
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -178,6 +218,8 @@ class BrotliContext : public MemoryRetainer {
   void SetFlush(int flush);
   void GetAfterWriteOffsets(uint32_t* avail_in, uint32_t* avail_out) const;
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
+  // Brotli states are not pooled (see ZlibContext::ReleaseToPool()).
+  bool ReleaseToPool(Environment* env, size_t memory) { return false; }
 
   BrotliContext(const BrotliContext&) = delete;
   BrotliContext& operator=(const BrotliContext&) = delete;
@@ -239,12 +281,16 @@ class BrotliDecoderContext final : public BrotliContext {
   DeleteFnPtr<BrotliDecoderState, BrotliDecoderDestroyInstance> state_;
 };
 
+// Decompressed bytes below which the output-to-input ratio guard is not
+// enforced; see CompressionStream::CheckOutputLimits().
+constexpr uint64_t kRatioGuardMinOutput = 1024 * 1024;
+
 template <typename CompressionContext>
 class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env, WorkClass::kCpuBound),
         write_result_(nullptr) {
     MakeWeak();
   }
@@ -267,6 +313,16 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     CHECK(init_done_ && "close before init");
 
     AllocScope alloc_scope(this);
+    // Flush pending allocation updates so that zlib_memory_ reflects the
+    // full footprint of the native state before deciding whether to pool it.
+    AdjustAmountOfExternalAllocatedMemory();
+    if (ctx_.ReleaseToPool(env(), zlib_memory_)) {
+      // The pooled state keeps its allocations alive; stop charging them
+      // against this stream (and the isolate) while the state is parked.
+      unreported_allocations_.fetch_sub(static_cast<ssize_t>(zlib_memory_),
+                                        std::memory_order_relaxed);
+      return;
+    }
     ctx_.Close();
   }
 
@@ -345,12 +401,15 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
     ctx_.SetBuffers(in, in_len, out, out_len);
     ctx_.SetFlush(flush);
+    last_write_in_len_ = in_len;
+    last_write_out_len_ = out_len;
 
     if (!async) {
       // sync version
       env()->PrintSyncTrace();
       DoThreadPoolWork();
-      if (CheckError()) {
+      AccountWrite();
+      if (CheckError() && CheckOutputLimits()) {
         UpdateWriteResult();
         write_in_progress_ = false;
       }
@@ -364,6 +423,21 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
   void UpdateWriteResult() {
     ctx_.GetAfterWriteOffsets(&write_result_[1], &write_result_[0]);
+    if (write_result_size_ >= 4) {
+      // Low 32 bits of the lifetime byte totals, so that e.g. adaptive
+      // compression decisions can be audited from JS without extra calls.
+      write_result_[2] = static_cast<uint32_t>(total_bytes_in_);
+      write_result_[3] = static_cast<uint32_t>(total_bytes_out_);
+    }
+  }
+
+  // Folds the byte counts of the write that just finished into the lifetime
+  // totals. Called exactly once per completed write, on the main thread.
+  void AccountWrite() {
+    uint32_t avail_in, avail_out;
+    ctx_.GetAfterWriteOffsets(&avail_in, &avail_out);
+    total_bytes_in_ += last_write_in_len_ - avail_in;
+    total_bytes_out_ += last_write_out_len_ - avail_out;
   }
 
   // thread pool!
@@ -382,6 +456,54 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     return false;
   }
 
+  // Decompression-bomb guards: errors out once the configured output size or
+  // output-to-input ratio limit is exceeded. The ratio is only enforced after
+  // kRatioGuardMinOutput decompressed bytes, since the first writes of even
+  // benign highly-compressible data can exceed any reasonable ratio.
+  // The limits apply over the lifetime of the handle and survive reset(), so
+  // multi-member archives cannot evade them.
+  bool CheckOutputLimits() {
+    if (max_output_length_ == 0 && max_output_ratio_ == 0)
+      return true;
+
+    if (max_output_length_ > 0 && total_bytes_out_ > max_output_length_) {
+      EmitError(CompressionError("Exceeded maximum decompressed size",
+                                 "ERR_BUFFER_TOO_LARGE",
+                                 Z_BUF_ERROR));
+      return false;
+    }
+    if (max_output_ratio_ > 0 &&
+        total_bytes_out_ > kRatioGuardMinOutput &&
+        total_bytes_out_ >
+            max_output_ratio_ *
+                static_cast<double>(std::max<uint64_t>(total_bytes_in_, 1))) {
+      EmitError(CompressionError("Exceeded maximum decompression ratio",
+                                 "ERR_ZLIB_MAX_RATIO",
+                                 Z_BUF_ERROR));
+      return false;
+    }
+    return true;
+  }
+
+  // setOutputLimits(maxOutputLength, maxRatio); 0 disables the
+  // respective guard.
+  static void SetOutputLimits(const FunctionCallbackInfo<Value>& args) {
+    CompressionStream* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    CHECK_EQ(args.Length(), 2);
+
+    Local<Context> context = ctx->env()->context();
+    double max_output_length;
+    if (!args[0]->NumberValue(context).To(&max_output_length)) return;
+    double max_ratio;
+    if (!args[1]->NumberValue(context).To(&max_ratio)) return;
+
+    CHECK_GE(max_output_length, 0);
+    CHECK_GE(max_ratio, 0);
+    ctx->max_output_length_ = static_cast<uint64_t>(max_output_length);
+    ctx->max_output_ratio_ = max_ratio;
+  }
+
 
   // v8 land!
   void AfterThreadPoolWork(int status) override {
@@ -400,9 +522,14 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     HandleScope handle_scope(env()->isolate());
     Context::Scope context_scope(env()->context());
 
+    AccountWrite();
+
     if (!CheckError())
       return;
 
+    if (!CheckOutputLimits())
+      return;
+
     UpdateWriteResult();
 
     // call the write() cb
@@ -452,12 +579,23 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  protected:
   CompressionContext* context() { return &ctx_; }
 
-  void InitStream(uint32_t* write_result, Local<Function> write_js_callback) {
+  void InitStream(uint32_t* write_result,
+                  size_t write_result_size,
+                  Local<Function> write_js_callback) {
     write_result_ = write_result;
+    write_result_size_ = write_result_size;
     write_js_callback_.Reset(env()->isolate(), write_js_callback);
     init_done_ = true;
   }
 
+  // Takes over accounting for memory that was allocated while an adopted
+  // zlib state sat in the per-Environment pool, so that its eventual frees
+  // balance against this stream.
+  void AdoptPooledMemory(size_t memory) {
+    unreported_allocations_.fetch_add(static_cast<ssize_t>(memory),
+                                      std::memory_order_relaxed);
+  }
+
   // Allocation functions provided to zlib itself. We store the real size of
   // the allocated memory chunk just before the "payload" memory we return
   // to zlib.
@@ -533,6 +671,16 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   std::atomic<ssize_t> unreported_allocations_{0};
   size_t zlib_memory_ = 0;
 
+  // Decompression-bomb guards (see CheckOutputLimits()); 0 = unlimited.
+  uint64_t max_output_length_ = 0;
+  double max_output_ratio_ = 0;
+  // Lifetime byte totals for this handle (see AccountWrite()).
+  uint64_t total_bytes_in_ = 0;
+  uint64_t total_bytes_out_ = 0;
+  uint32_t last_write_in_len_ = 0;
+  uint32_t last_write_out_len_ = 0;
+  size_t write_result_size_ = 0;
+
   CompressionContext ctx_;
 };
 
@@ -605,14 +753,18 @@ class ZlibStream : public CompressionStream<ZlibContext> {
           data + Buffer::Length(args[6]));
     }
 
-    wrap->InitStream(write_result, write_js_callback);
+    wrap->InitStream(write_result, array->Length(), write_js_callback);
 
     AllocScope alloc_scope(wrap);
     wrap->context()->SetAllocationFunctions(
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
+    size_t pooled_memory = 0;
     const CompressionError err =
         wrap->context()->Init(level, window_bits, mem_level, strategy,
-                              std::move(dictionary));
+                              std::move(dictionary), wrap->env(),
+                              &pooled_memory);
+    if (pooled_memory > 0)
+      wrap->AdoptPooledMemory(pooled_memory);
     if (err.IsError())
       wrap->EmitError(err);
 
@@ -635,6 +787,14 @@ class ZlibStream : public CompressionStream<ZlibContext> {
       wrap->EmitError(err);
   }
 
+  // Must be called before the first write; the level decision is made on the
+  // thread pool once enough input has been sampled.
+  static void SetAdaptive(const FunctionCallbackInfo<Value>& args) {
+    ZlibStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    wrap->context()->EnableAdaptiveLevel();
+  }
+
   SET_MEMORY_INFO_NAME(ZlibStream)
   SET_SELF_SIZE(ZlibStream)
 };
@@ -672,7 +832,9 @@ class BrotliCompressionStream : public CompressionStream<CompressionContext> {
 
     CHECK(args[2]->IsFunction());
     Local<Function> write_js_callback = args[2].As<Function>();
-    wrap->InitStream(write_result, write_js_callback);
+    wrap->InitStream(write_result,
+                     args[1].As<Uint32Array>()->Length(),
+                     write_js_callback);
 
     AllocScope alloc_scope(wrap);
     CompressionError err =
@@ -711,6 +873,11 @@ class BrotliCompressionStream : public CompressionStream<CompressionContext> {
     // the zlib Params() function.
   }
 
+  static void SetAdaptive(const FunctionCallbackInfo<Value>& args) {
+    // Entropy-based level adaptation is zlib-specific; Brotli streams accept
+    // and ignore the call. (Brotli has its own quality/size heuristics.)
+  }
+
   SET_MEMORY_INFO_NAME(BrotliCompressionStream)
   SET_SELF_SIZE(BrotliCompressionStream)
 };
@@ -723,10 +890,10 @@ void ZlibContext::Close() {
 
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_);
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_);
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
@@ -746,11 +913,13 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      if (adaptive_ && !adaptive_decided_)
+        SampleAndAdaptLevel();
+      err_ = deflate(strm_, flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -763,7 +932,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -796,7 +965,7 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_, flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
@@ -804,12 +973,12 @@ void ZlibContext::DoThreadPoolWork() {
           err_ == Z_NEED_DICT &&
           !dictionary_.empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
+        err_ = inflateSetDictionary(strm_,
                                     dictionary_.data(),
                                     dictionary_.size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_, flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -818,17 +987,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_, flush_);
       }
       break;
     default:
@@ -837,12 +1006,61 @@ void ZlibContext::DoThreadPoolWork() {
 }
 
 
+// Runs on the thread pool, before the deflate() call of the write that
+// completes the sample. Accumulates a byte histogram over the first
+// kAdaptiveSampleBytes of input (or less, if the stream ends earlier) and
+// downgrades the compression level once, based on the sample's Shannon
+// entropy. deflateParams() compresses input buffered so far with the old
+// parameters, so the transition is safe mid-stream; levels are only ever
+// lowered, never raised above what the user configured.
+void ZlibContext::SampleAndAdaptLevel() {
+  const size_t take = std::min<size_t>(
+      kAdaptiveSampleBytes - adaptive_sampled_, strm_->avail_in);
+  const Bytef* data = strm_->next_in;
+  for (size_t i = 0; i < take; i++)
+    adaptive_histogram_[data[i]]++;
+  adaptive_sampled_ += take;
+
+  if (adaptive_sampled_ < kAdaptiveSampleBytes && flush_ != Z_FINISH)
+    return;  // Keep sampling on the next write.
+
+  adaptive_decided_ = true;
+  if (adaptive_sampled_ == 0)
+    return;
+
+  double entropy = 0;
+  const double total = static_cast<double>(adaptive_sampled_);
+  for (size_t i = 0; i < 256; i++) {
+    if (adaptive_histogram_[i] == 0) continue;
+    const double p = adaptive_histogram_[i] / total;
+    entropy -= p * std::log2(p);
+  }
+
+  int level;
+  if (entropy >= kAdaptiveStoreEntropy)
+    level = Z_NO_COMPRESSION;
+  else if (entropy >= kAdaptiveFastEntropy)
+    level = Z_BEST_SPEED;
+  else
+    return;
+
+  const int configured = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  if (level >= configured)
+    return;
+
+  // Z_BUF_ERROR (no room for buffered input compressed with the old
+  // parameters) leaves the parameters unchanged; do not retry.
+  if (deflateParams(strm_, level, strategy_) == Z_OK)
+    level_ = level;  // Keep the pool key (see ReleaseToPool()) accurate.
+}
+
+
 void ZlibContext::SetBuffers(char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = reinterpret_cast<Bytef*>(in);
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = reinterpret_cast<Bytef*>(in);
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -853,14 +1071,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -871,7 +1089,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
@@ -898,12 +1116,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_);
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_);
       break;
     default:
       break;
@@ -919,15 +1137,16 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
 CompressionError ZlibContext::Init(
     int level, int window_bits, int mem_level, int strategy,
-    std::vector<unsigned char>&& dictionary) {
+    std::vector<unsigned char>&& dictionary,
+    Environment* env, size_t* pooled_memory) {
   if (!((window_bits == 0) &&
         (mode_ == INFLATE ||
          mode_ == GUNZIP ||
@@ -969,11 +1188,19 @@ CompressionError ZlibContext::Init(
     window_bits_ *= -1;
   }
 
+  dictionary_ = std::move(dictionary);
+
+  // Adopting a parked stream with the same parameters from the
+  // per-Environment pool is much cheaper than re-running *Init2() below,
+  // which would re-allocate the window and internal state from scratch.
+  if (AcquirePooledState(env, pooled_memory))
+    return SetDictionary();
+
   switch (mode_) {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      err_ = deflateInit2(strm_,
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -984,14 +1211,12 @@ CompressionError ZlibContext::Init(
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_, window_bits_);
       break;
     default:
       UNREACHABLE();
   }
 
-  dictionary_ = std::move(dictionary);
-
   if (err_ != Z_OK) {
     dictionary_.clear();
     mode_ = NONE;
@@ -1002,6 +1227,110 @@ CompressionError ZlibContext::Init(
 }
 
 
+inline bool IsDeflateMode(node_zlib_mode mode) {
+  return mode == DEFLATE || mode == GZIP || mode == DEFLATERAW;
+}
+
+// Allocation functions installed on z_streams parked in the per-Environment
+// pool (and on the states backing one-shot compression jobs). They follow
+// the same size-prefix convention as the allocators in CompressionStream,
+// but do not account the memory against any stream, so that pooled states
+// can be disposed of after the stream that released them is long gone. If
+// the opaque pointer is non-null it points at a size_t counter tracking the
+// total bytes held, which becomes PooledZlibState::memory on release.
+void* AllocForPooledState(void* data, uInt items, uInt size) {
+  size_t real_size =
+      MultiplyWithOverflowCheck(static_cast<size_t>(items),
+                                static_cast<size_t>(size)) +
+      sizeof(size_t);
+  char* memory = UncheckedMalloc(real_size);
+  if (UNLIKELY(memory == nullptr)) return nullptr;
+  *reinterpret_cast<size_t*>(memory) = real_size;
+  if (data != nullptr)
+    *static_cast<size_t*>(data) += real_size;
+  return memory + sizeof(size_t);
+}
+
+void FreeForPooledState(void* data, void* pointer) {
+  if (UNLIKELY(pointer == nullptr)) return;
+  char* real_pointer = static_cast<char*>(pointer) - sizeof(size_t);
+  if (data != nullptr)
+    *static_cast<size_t*>(data) -= *reinterpret_cast<size_t*>(real_pointer);
+  free(real_pointer);
+}
+
+bool ZlibContext::AcquirePooledState(Environment* env, size_t* pooled_memory) {
+  const bool is_deflate = IsDeflateMode(mode_);
+  std::vector<PooledZlibState>& pool = env->pooled_zlib_states();
+  for (auto it = pool.begin(); it != pool.end(); ++it) {
+    if (it->is_deflate != is_deflate ||
+        it->window_bits != window_bits_ ||
+        it->level != level_ ||
+        it->mem_level != mem_level_ ||
+        it->strategy != strategy_) {
+      continue;
+    }
+
+    PooledZlibState state = *it;
+    pool.erase(it);
+
+    err_ = is_deflate ? deflateReset(state.stream) : inflateReset(state.stream);
+    if (err_ != Z_OK) {
+      // The parked state is unusable; dispose of it (its allocation
+      // functions are still the pool's) and initialize from scratch.
+      if (is_deflate)
+        deflateEnd(state.stream);
+      else
+        inflateEnd(state.stream);
+      delete state.stream;
+      err_ = Z_OK;
+      return false;
+    }
+
+    // Move this wrap's allocation accounting functions, installed on the
+    // freshly constructed stream by SetAllocationFunctions(), over to the
+    // adopted state.
+    state.stream->zalloc = strm_->zalloc;
+    state.stream->zfree = strm_->zfree;
+    state.stream->opaque = strm_->opaque;
+
+    delete strm_;
+    strm_ = state.stream;
+    *pooled_memory = state.memory;
+    return true;
+  }
+
+  return false;
+}
+
+bool ZlibContext::ReleaseToPool(Environment* env, size_t memory) {
+  if (mode_ == NONE) return false;
+  std::vector<PooledZlibState>& pool = env->pooled_zlib_states();
+  if (pool.size() >= Environment::kMaxPooledZlibStates) return false;
+
+  // Detach the stream from this wrap's allocation accounting so that the
+  // pooled state outlives it safely.
+  strm_->zalloc = AllocForPooledState;
+  strm_->zfree = FreeForPooledState;
+  strm_->opaque = nullptr;
+
+  PooledZlibState state;
+  state.stream = strm_;
+  state.is_deflate = IsDeflateMode(mode_);
+  state.level = level_;
+  state.window_bits = window_bits_;
+  state.mem_level = mem_level_;
+  state.strategy = strategy_;
+  state.memory = memory;
+  pool.push_back(state);
+
+  strm_ = nullptr;
+  mode_ = NONE;
+  dictionary_.clear();
+  return true;
+}
+
+
 CompressionError ZlibContext::SetDictionary() {
   if (dictionary_.empty())
     return CompressionError {};
@@ -1011,14 +1340,14 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
+      err_ = deflateSetDictionary(strm_,
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
+      err_ = inflateSetDictionary(strm_,
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
@@ -1040,7 +1369,7 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_, level, strategy);
       break;
     default:
       break;
@@ -1050,6 +1379,11 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
     return ErrorForMessage("Failed to set parameters");
   }
 
+  // Keep the cached parameters in sync with the live state; they form the
+  // matching key if this stream is later released to the pool.
+  level_ = level;
+  strategy_ = strategy;
+
   return CompressionError {};
 }
 
@@ -1209,6 +1543,862 @@ CompressionError BrotliDecoderContext::GetErrorInfo() const {
 }
 
 
+// One-shot whole-buffer compression. For small payloads, the scheduling and
+// Transform-stream overhead of the streaming path costs more than deflate
+// itself; these bindings compress a single buffer in one deflate() call,
+// sized exactly via deflateBound(). Used by the convenience methods in
+// lib/zlib.js when the options allow it.
+struct OneShotCompressParams {
+  node_zlib_mode mode = NONE;
+  int level = 0;
+  int window_bits = 0;  // Effective value (gzip/raw adjustments applied).
+  int mem_level = 0;
+  int strategy = 0;
+};
+
+void ParseOneShotParams(const FunctionCallbackInfo<Value>& args,
+                        OneShotCompressParams* params) {
+  CHECK(args[0]->IsInt32());
+  params->mode = static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+  CHECK(params->mode == DEFLATE || params->mode == GZIP ||
+        params->mode == DEFLATERAW);
+
+  CHECK(args[2]->IsInt32());
+  params->level = args[2].As<Int32>()->Value();
+  CHECK(args[3]->IsInt32());
+  params->window_bits = args[3].As<Int32>()->Value();
+  CHECK(args[4]->IsInt32());
+  params->mem_level = args[4].As<Int32>()->Value();
+  CHECK(args[5]->IsInt32());
+  params->strategy = args[5].As<Int32>()->Value();
+
+  CHECK((params->window_bits >= Z_MIN_WINDOWBITS &&
+         params->window_bits <= Z_MAX_WINDOWBITS) &&
+        "invalid windowBits");
+  CHECK((params->level >= Z_MIN_LEVEL && params->level <= Z_MAX_LEVEL) &&
+        "invalid compression level");
+  CHECK((params->mem_level >= Z_MIN_MEMLEVEL &&
+         params->mem_level <= Z_MAX_MEMLEVEL) &&
+        "invalid memlevel");
+  CHECK((params->strategy == Z_FILTERED ||
+         params->strategy == Z_HUFFMAN_ONLY ||
+         params->strategy == Z_RLE ||
+         params->strategy == Z_FIXED ||
+         params->strategy == Z_DEFAULT_STRATEGY) &&
+        "invalid strategy");
+
+  if (params->mode == GZIP)
+    params->window_bits += 16;
+  else if (params->mode == DEFLATERAW)
+    params->window_bits *= -1;
+}
+
+// Returns an initialized deflate state for `params`, reusing a state from
+// the per-Environment pool when one with matching parameters is parked
+// there. `pool_memory` receives the allocation bytes already held by the
+// state and is kept up to date by the pool allocation functions via the
+// opaque pointer. Must be called on the Environment thread. Returns nullptr
+// if initialization failed.
+z_stream* OneShotAcquireState(Environment* env,
+                              const OneShotCompressParams& params,
+                              size_t* pool_memory) {
+  std::vector<PooledZlibState>& pool = env->pooled_zlib_states();
+  for (auto it = pool.begin(); it != pool.end(); ++it) {
+    if (!it->is_deflate ||
+        it->window_bits != params.window_bits ||
+        it->level != params.level ||
+        it->mem_level != params.mem_level ||
+        it->strategy != params.strategy) {
+      continue;
+    }
+
+    z_stream* strm = it->stream;
+    const size_t memory = it->memory;
+    pool.erase(it);
+    if (deflateReset(strm) != Z_OK) {
+      deflateEnd(strm);
+      delete strm;
+      break;
+    }
+    *pool_memory = memory;
+    strm->opaque = pool_memory;
+    return strm;
+  }
+
+  z_stream* strm = new z_stream();
+  strm->zalloc = AllocForPooledState;
+  strm->zfree = FreeForPooledState;
+  strm->opaque = pool_memory;
+  if (deflateInit2(strm,
+                   params.level,
+                   Z_DEFLATED,
+                   params.window_bits,
+                   params.mem_level,
+                   params.strategy) != Z_OK) {
+    delete strm;
+    return nullptr;
+  }
+  return strm;
+}
+
+// Parks the state back in the per-Environment pool (where a later stream or
+// one-shot job with the same parameters can adopt it), or disposes of it if
+// the pool is full.
+void OneShotReleaseState(Environment* env,
+                         const OneShotCompressParams& params,
+                         z_stream* strm,
+                         size_t pool_memory) {
+  strm->opaque = nullptr;
+  std::vector<PooledZlibState>& pool = env->pooled_zlib_states();
+  if (pool.size() >= Environment::kMaxPooledZlibStates) {
+    deflateEnd(strm);
+    delete strm;
+    return;
+  }
+
+  PooledZlibState state;
+  state.stream = strm;
+  state.is_deflate = true;
+  state.level = params.level;
+  state.window_bits = params.window_bits;
+  state.mem_level = params.mem_level;
+  state.strategy = params.strategy;
+  state.memory = pool_memory;
+  pool.push_back(state);
+}
+
+// Compresses `in` into a single freshly malloc()'ed buffer with one
+// deflate(Z_FINISH) call. The output is sized with deflateBound(), so
+// deflate() cannot run out of space; on success the buffer is shrunk to the
+// actual output size and ownership passes to the caller. Does not touch V8
+// state and is safe to run on the thread pool.
+CompressionError OneShotDeflate(z_stream* strm,
+                                const unsigned char* in,
+                                size_t in_len,
+                                char** out,
+                                size_t* out_len) {
+  CHECK_LE(in_len, std::numeric_limits<uInt>::max());
+  const uLong bound = deflateBound(strm, in_len);
+  CHECK_LE(bound, std::numeric_limits<uInt>::max());
+  char* buf = UncheckedMalloc(bound);
+  if (UNLIKELY(buf == nullptr))
+    return CompressionError("Insufficient memory", "Z_MEM_ERROR", Z_MEM_ERROR);
+
+  strm->next_in = const_cast<Bytef*>(in);
+  strm->avail_in = in_len;
+  strm->next_out = reinterpret_cast<Bytef*>(buf);
+  strm->avail_out = bound;
+
+  const int err = deflate(strm, Z_FINISH);
+  if (err != Z_STREAM_END) {
+    free(buf);
+    const char* message = strm->msg != nullptr ? strm->msg : "Zlib error";
+    return CompressionError(message, ZlibStrerror(err), err);
+  }
+
+  *out_len = strm->total_out;
+  if (char* shrunk = static_cast<char*>(realloc(buf, *out_len)))
+    buf = shrunk;
+  *out = buf;
+  return CompressionError();
+}
+
+Local<Value> MakeZlibErrorObject(Environment* env,
+                                 const CompressionError& error) {
+  Local<Value> js_error =
+      Exception::Error(OneByteString(env->isolate(), error.message));
+  Local<Object> obj = js_error.As<Object>();
+  obj->Set(env->context(),
+           env->errno_string(),
+           Integer::New(env->isolate(), error.err)).Check();
+  obj->Set(env->context(),
+           env->code_string(),
+           OneByteString(env->isolate(), error.code)).Check();
+  return js_error;
+}
+
+class OneShotCompressJob final : public AsyncWrap, public ThreadPoolWork {
+ public:
+  OneShotCompressJob(Environment* env,
+                     Local<Object> object,
+                     const OneShotCompressParams& params,
+                     Local<Object> input,
+                     Local<Function> callback,
+                     z_stream* strm,
+                     size_t pool_memory)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(env, WorkClass::kCpuBound),
+        params_(params),
+        strm_(strm),
+        pool_memory_(pool_memory),
+        in_(reinterpret_cast<const unsigned char*>(Buffer::Data(input))),
+        in_len_(Buffer::Length(input)) {
+    input_.Reset(env->isolate(), input);
+    callback_.Reset(env->isolate(), callback);
+    // The allocation counter lives in this job from now on.
+    strm_->opaque = &pool_memory_;
+  }
+
+  void DoThreadPoolWork() override {
+    error_ = OneShotDeflate(strm_, in_, in_len_, &out_, &out_len_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<OneShotCompressJob> self(this);
+    OneShotReleaseState(env(), params_, strm_, pool_memory_);
+
+    if (status == UV_ECANCELED) {
+      free(out_);
+      return;
+    }
+    CHECK_EQ(status, 0);
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    Local<Value> argv[2];
+    if (!error_.IsError() && out_len_ > Buffer::kMaxLength) {
+      free(out_);
+      error_ = CompressionError("Cannot create final Buffer. "
+                                "It would be larger than the maximum "
+                                "Buffer size",
+                                "Z_BUF_ERROR", Z_BUF_ERROR);
+    }
+    if (error_.IsError()) {
+      argv[0] = MakeZlibErrorObject(env(), error_);
+      argv[1] = Undefined(env()->isolate());
+    } else {
+      Local<Object> buf;
+      if (!Buffer::New(env(), out_, out_len_, true).ToLocal(&buf))
+        return;  // There is a pending exception.
+      argv[0] = Null(env()->isolate());
+      argv[1] = buf;
+    }
+    MakeCallback(callback_.Get(env()->isolate()), arraysize(argv), argv);
+  }
+
+  SET_MEMORY_INFO_NAME(OneShotCompressJob)
+  SET_SELF_SIZE(OneShotCompressJob)
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("zlib_memory", pool_memory_);
+  }
+
+ private:
+  OneShotCompressParams params_;
+  z_stream* strm_;
+  size_t pool_memory_;
+  const unsigned char* in_;
+  size_t in_len_;
+  char* out_ = nullptr;
+  size_t out_len_ = 0;
+  CompressionError error_;
+  Global<Object> input_;
+  Global<Function> callback_;
+};
+
+// oneShotCompressSync(mode, buffer, level, windowBits, memLevel, strategy)
+void OneShotCompressSync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  OneShotCompressParams params;
+  ParseOneShotParams(args, &params);
+  CHECK(Buffer::HasInstance(args[1]));
+
+  size_t pool_memory = 0;
+  z_stream* strm = OneShotAcquireState(env, params, &pool_memory);
+  if (strm == nullptr)
+    return env->ThrowError("zlib initialization failed");
+
+  char* out = nullptr;
+  size_t out_len = 0;
+  const CompressionError error = OneShotDeflate(
+      strm,
+      reinterpret_cast<const unsigned char*>(Buffer::Data(args[1])),
+      Buffer::Length(args[1]),
+      &out,
+      &out_len);
+  OneShotReleaseState(env, params, strm, pool_memory);
+
+  if (error.IsError()) {
+    env->isolate()->ThrowException(MakeZlibErrorObject(env, error));
+    return;
+  }
+  if (out_len > Buffer::kMaxLength) {
+    free(out);
+    return env->ThrowRangeError("Cannot create final Buffer. "
+                                "It would be larger than the maximum "
+                                "Buffer size");
+  }
+
+  Local<Object> buf;
+  if (Buffer::New(env, out, out_len, true).ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+// oneShotCompress(mode, buffer, level, windowBits, memLevel, strategy, cb)
+void OneShotCompress(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  OneShotCompressParams params;
+  ParseOneShotParams(args, &params);
+  CHECK(Buffer::HasInstance(args[1]));
+  CHECK(args[6]->IsFunction());
+
+  Local<Object> obj;
+  if (!env->zlib_oneshot_job_template()
+           ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+
+  size_t pool_memory = 0;
+  z_stream* strm = OneShotAcquireState(env, params, &pool_memory);
+  if (strm == nullptr)
+    return env->ThrowError("zlib initialization failed");
+
+  OneShotCompressJob* job = new OneShotCompressJob(env,
+                                                   obj,
+                                                   params,
+                                                   args[1].As<Object>(),
+                                                   args[6].As<Function>(),
+                                                   strm,
+                                                   pool_memory);
+  job->ScheduleWork();
+}
+
+
+// Parallel block compression for large buffers (the technique pioneered by
+// pigz): the input is split into fixed-size blocks that are compressed
+// concurrently on the thread pool as independent raw deflate streams. Every
+// block but the last is flushed with Z_FULL_FLUSH, which both ends its
+// output on a byte boundary (via an empty stored block) and prevents
+// back-references into it from later blocks, so the per-block outputs
+// concatenate into a single valid deflate stream. The gzip/zlib wrapper is
+// written by hand on the main thread and the per-block checksums are merged
+// with crc32_combine()/adler32_combine().
+constexpr size_t kParallelBlockSize = 1 << 20;
+
+class ParallelCompressJob final : public AsyncWrap {
+ public:
+  ParallelCompressJob(Environment* env,
+                      Local<Object> object,
+                      const OneShotCompressParams& params,
+                      Local<Object> input,
+                      Local<Function> callback)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_ZLIB),
+        params_(params),
+        in_(reinterpret_cast<const unsigned char*>(Buffer::Data(input))),
+        in_len_(Buffer::Length(input)) {
+    input_.Reset(env->isolate(), input);
+    callback_.Reset(env->isolate(), callback);
+
+    // ParseOneShotParams() stores the effective windowBits. The blocks are
+    // always raw deflate streams; the base value sizes their windows and the
+    // wrapper format stays in params_.mode.
+    if (params_.mode == GZIP)
+      base_window_bits_ = params_.window_bits - 16;
+    else if (params_.mode == DEFLATERAW)
+      base_window_bits_ = -params_.window_bits;
+    else
+      base_window_bits_ = params_.window_bits;
+
+    const size_t count = std::max<size_t>(
+        1, (in_len_ + kParallelBlockSize - 1) / kParallelBlockSize);
+    blocks_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      auto block = std::make_unique<Block>(this, i);
+      block->in = in_ + i * kParallelBlockSize;
+      block->in_len =
+          std::min(kParallelBlockSize, in_len_ - i * kParallelBlockSize);
+      block->last = i == count - 1;
+      blocks_.push_back(std::move(block));
+    }
+    remaining_ = count;
+  }
+
+  ~ParallelCompressJob() override {
+    for (const auto& block : blocks_)
+      free(block->out);
+  }
+
+  void Schedule() {
+    for (const auto& block : blocks_)
+      block->work.ScheduleWork();
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelCompressJob)
+  SET_SELF_SIZE(ParallelCompressJob)
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("blocks", blocks_.size() * sizeof(Block));
+  }
+
+ private:
+  class BlockWork final : public ThreadPoolWork {
+   public:
+    BlockWork(ParallelCompressJob* job, size_t index)
+        : ThreadPoolWork(job->env(), WorkClass::kCpuBound),
+          job_(job),
+          index_(index) {}
+
+    void DoThreadPoolWork() override { job_->CompressBlock(index_); }
+    void AfterThreadPoolWork(int status) override { job_->OnBlockDone(status); }
+
+   private:
+    ParallelCompressJob* job_;
+    size_t index_;
+  };
+
+  struct Block {
+    Block(ParallelCompressJob* job, size_t index) : work(job, index) {}
+
+    BlockWork work;
+    const unsigned char* in = nullptr;
+    size_t in_len = 0;
+    bool last = false;
+    char* out = nullptr;
+    size_t out_len = 0;
+    uLong checksum = 0;
+    CompressionError error;
+  };
+
+  // Runs on the thread pool; every invocation only touches its own block.
+  void CompressBlock(size_t index) {
+    Block* block = blocks_[index].get();
+
+    z_stream strm;
+    strm.zalloc = nullptr;
+    strm.zfree = nullptr;
+    strm.opaque = nullptr;
+    if (deflateInit2(&strm,
+                     params_.level,
+                     Z_DEFLATED,
+                     -base_window_bits_,
+                     params_.mem_level,
+                     params_.strategy) != Z_OK) {
+      block->error =
+          CompressionError("Insufficient memory", "Z_MEM_ERROR", Z_MEM_ERROR);
+      return;
+    }
+
+    // Z_FULL_FLUSH may append an empty stored block past deflateBound().
+    const uLong bound = deflateBound(&strm, block->in_len) + 16;
+    CHECK_LE(bound, std::numeric_limits<uInt>::max());
+    char* buf = UncheckedMalloc(bound);
+    if (UNLIKELY(buf == nullptr)) {
+      deflateEnd(&strm);
+      block->error =
+          CompressionError("Insufficient memory", "Z_MEM_ERROR", Z_MEM_ERROR);
+      return;
+    }
+
+    strm.next_in = const_cast<Bytef*>(block->in);
+    strm.avail_in = block->in_len;
+    strm.next_out = reinterpret_cast<Bytef*>(buf);
+    strm.avail_out = bound;
+
+    const int err = deflate(&strm, block->last ? Z_FINISH : Z_FULL_FLUSH);
+    const bool done = block->last ? err == Z_STREAM_END
+                                  : err == Z_OK && strm.avail_in == 0;
+    if (!done) {
+      free(buf);
+      const char* message = strm.msg != nullptr ? strm.msg : "Zlib error";
+      block->error = CompressionError(message, ZlibStrerror(err), err);
+      deflateEnd(&strm);
+      return;
+    }
+
+    block->out_len = strm.total_out;
+    if (char* shrunk = static_cast<char*>(realloc(buf, block->out_len)))
+      buf = shrunk;
+    block->out = buf;
+    deflateEnd(&strm);
+
+    if (params_.mode == GZIP)
+      block->checksum = crc32(crc32(0, nullptr, 0), block->in, block->in_len);
+    else if (params_.mode == DEFLATE)
+      block->checksum =
+          adler32(adler32(0, nullptr, 0), block->in, block->in_len);
+  }
+
+  void OnBlockDone(int status) {
+    if (status == UV_ECANCELED)
+      canceled_ = true;
+    else
+      CHECK_EQ(status, 0);
+    CHECK_GT(remaining_, 0u);
+    if (--remaining_ > 0) return;
+    Finish();
+  }
+
+  // Runs on the Environment thread once all blocks have completed; stitches
+  // the block outputs together and invokes the callback.
+  void Finish() {
+    std::unique_ptr<ParallelCompressJob> self(this);
+    if (canceled_) return;  // Block outputs are freed by the destructor.
+
+    CompressionError error;
+    for (const auto& block : blocks_) {
+      if (block->error.IsError()) {
+        error = block->error;
+        break;
+      }
+    }
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    Local<Value> argv[2];
+    if (!error.IsError()) {
+      size_t total = HeaderSize() + TrailerSize();
+      for (const auto& block : blocks_)
+        total += block->out_len;
+
+      char* out = nullptr;
+      if (total > Buffer::kMaxLength) {
+        error = CompressionError("Cannot create final Buffer. "
+                                 "It would be larger than the maximum "
+                                 "Buffer size",
+                                 "Z_BUF_ERROR", Z_BUF_ERROR);
+      } else if (UNLIKELY((out = UncheckedMalloc(total)) == nullptr)) {
+        error = CompressionError(
+            "Insufficient memory", "Z_MEM_ERROR", Z_MEM_ERROR);
+      } else {
+        size_t offset = WriteHeader(out);
+        for (const auto& block : blocks_) {
+          memcpy(out + offset, block->out, block->out_len);
+          offset += block->out_len;
+          free(block->out);
+          block->out = nullptr;
+        }
+        offset += WriteTrailer(out + offset);
+        CHECK_EQ(offset, total);
+
+        Local<Object> buf;
+        if (!Buffer::New(env(), out, total, true).ToLocal(&buf))
+          return;  // There is a pending exception.
+        argv[0] = Null(env()->isolate());
+        argv[1] = buf;
+        MakeCallback(callback_.Get(env()->isolate()), arraysize(argv), argv);
+        return;
+      }
+    }
+
+    argv[0] = MakeZlibErrorObject(env(), error);
+    argv[1] = Undefined(env()->isolate());
+    MakeCallback(callback_.Get(env()->isolate()), arraysize(argv), argv);
+  }
+
+  size_t HeaderSize() const {
+    switch (params_.mode) {
+      case GZIP: return 10;
+      case DEFLATE: return 2;
+      default: return 0;
+    }
+  }
+
+  size_t TrailerSize() const {
+    switch (params_.mode) {
+      case GZIP: return 8;
+      case DEFLATE: return 4;
+      default: return 0;
+    }
+  }
+
+  // Writes the same header bytes deflate() itself would emit for this
+  // level/strategy/windowBits combination.
+  size_t WriteHeader(char* out) const {
+    unsigned char* p = reinterpret_cast<unsigned char*>(out);
+    const int level =
+        params_.level == Z_DEFAULT_COMPRESSION ? 6 : params_.level;
+    if (params_.mode == GZIP) {
+      p[0] = 0x1f;
+      p[1] = 0x8b;
+      p[2] = Z_DEFLATED;
+      p[3] = 0;  // No flags.
+      p[4] = p[5] = p[6] = p[7] = 0;  // No modification time.
+      p[8] = level == 9 ? 2 :
+             (params_.strategy >= Z_HUFFMAN_ONLY || level < 2 ? 4 : 0);
+      p[9] = 0x03;  // OS: Unix.
+      return 10;
+    }
+    if (params_.mode == DEFLATE) {
+      unsigned int header =
+          (Z_DEFLATED + ((base_window_bits_ - 8) << 4)) << 8;
+      unsigned int level_flags;
+      if (params_.strategy >= Z_HUFFMAN_ONLY || level < 2)
+        level_flags = 0;
+      else if (level < 6)
+        level_flags = 1;
+      else if (level == 6)
+        level_flags = 2;
+      else
+        level_flags = 3;
+      header |= level_flags << 6;
+      header += 31 - (header % 31);
+      p[0] = (header >> 8) & 0xff;
+      p[1] = header & 0xff;
+      return 2;
+    }
+    return 0;
+  }
+
+  size_t WriteTrailer(char* out) const {
+    unsigned char* p = reinterpret_cast<unsigned char*>(out);
+    if (params_.mode == GZIP) {
+      uLong crc = crc32(0, nullptr, 0);
+      for (const auto& block : blocks_)
+        crc = crc32_combine(crc, block->checksum, block->in_len);
+      p[0] = crc & 0xff;
+      p[1] = (crc >> 8) & 0xff;
+      p[2] = (crc >> 16) & 0xff;
+      p[3] = (crc >> 24) & 0xff;
+      const uint32_t size = static_cast<uint32_t>(in_len_);
+      p[4] = size & 0xff;
+      p[5] = (size >> 8) & 0xff;
+      p[6] = (size >> 16) & 0xff;
+      p[7] = (size >> 24) & 0xff;
+      return 8;
+    }
+    if (params_.mode == DEFLATE) {
+      uLong adler = adler32(0, nullptr, 0);
+      for (const auto& block : blocks_)
+        adler = adler32_combine(adler, block->checksum, block->in_len);
+      p[0] = (adler >> 24) & 0xff;
+      p[1] = (adler >> 16) & 0xff;
+      p[2] = (adler >> 8) & 0xff;
+      p[3] = adler & 0xff;
+      return 4;
+    }
+    return 0;
+  }
+
+  OneShotCompressParams params_;
+  int base_window_bits_ = 0;
+  const unsigned char* in_;
+  size_t in_len_;
+  std::vector<std::unique_ptr<Block>> blocks_;
+  size_t remaining_ = 0;
+  bool canceled_ = false;
+  Global<Object> input_;
+  Global<Function> callback_;
+};
+
+// oneShotCompressParallel(mode, buffer, level, windowBits, memLevel,
+//                         strategy, cb)
+void OneShotCompressParallel(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  OneShotCompressParams params;
+  ParseOneShotParams(args, &params);
+  CHECK(Buffer::HasInstance(args[1]));
+  CHECK(args[6]->IsFunction());
+
+  Local<Object> obj;
+  if (!env->zlib_oneshot_job_template()
+           ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+
+  ParallelCompressJob* job = new ParallelCompressJob(env,
+                                                     obj,
+                                                     params,
+                                                     args[1].As<Object>(),
+                                                     args[6].As<Function>());
+  job->Schedule();
+}
+
+
+// Checksums. crc32() and adler32() come straight from zlib; CRC32C (the
+// Castagnoli polynomial used by iSCSI, ext4, and most storage formats) is
+// computed with the dedicated CPU instruction where one exists — SSE4.2 on
+// x86-64, the optional CRC32 extension on ARMv8 — and with a bytewise table
+// otherwise. The dispatch happens once, at first use.
+
+enum ChecksumType {
+  CHECKSUM_CRC32,
+  CHECKSUM_CRC32C,
+  CHECKSUM_ADLER32
+};
+
+// Checksumming runs at several bytes per cycle, so only inputs large enough
+// to be worth a threadpool round trip are offloaded; lib/zlib.js compares
+// against this before choosing the async path.
+constexpr size_t CHECKSUM_ASYNC_THRESHOLD = 1024 * 1024;
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define NODE_HAS_HARDWARE_CRC32C 1
+
+__attribute__((target("sse4.2")))
+uint32_t Crc32cHardware(uint32_t crc, const unsigned char* data, size_t len) {
+  uint64_t crc64 = ~crc;
+  while (len >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data, 8);
+    crc64 = __builtin_ia32_crc32di(crc64, chunk);
+    data += 8;
+    len -= 8;
+  }
+  uint32_t crc32 = static_cast<uint32_t>(crc64);
+  while (len-- > 0)
+    crc32 = __builtin_ia32_crc32qi(crc32, *data++);
+  return ~crc32;
+}
+
+bool Crc32cHardwareSupported() {
+  return __builtin_cpu_supports("sse4.2");
+}
+
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define NODE_HAS_HARDWARE_CRC32C 1
+
+uint32_t Crc32cHardware(uint32_t crc, const unsigned char* data, size_t len) {
+  crc = ~crc;
+  while (len >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data, 8);
+    crc = __builtin_aarch64_crc32cx(crc, chunk);
+    data += 8;
+    len -= 8;
+  }
+  while (len-- > 0)
+    crc = __builtin_aarch64_crc32cb(crc, *data++);
+  return ~crc;
+}
+
+bool Crc32cHardwareSupported() { return true; }
+
+#else
+#define NODE_HAS_HARDWARE_CRC32C 0
+#endif
+
+uint32_t Crc32cSoftware(uint32_t crc, const unsigned char* data, size_t len) {
+  static uint32_t table[256];
+  static bool initialized = false;
+  if (!initialized) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++)
+        c = (c >> 1) ^ (0x82F63B78 & (0 - (c & 1)));
+      table[i] = c;
+    }
+    initialized = true;
+  }
+  crc = ~crc;
+  while (len-- > 0)
+    crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+uint32_t Crc32c(uint32_t crc, const unsigned char* data, size_t len) {
+#if NODE_HAS_HARDWARE_CRC32C
+  static const bool hardware = Crc32cHardwareSupported();
+  if (hardware)
+    return Crc32cHardware(crc, data, len);
+#endif
+  return Crc32cSoftware(crc, data, len);
+}
+
+uint32_t RunChecksum(uint32_t type,
+                     const unsigned char* data,
+                     size_t len,
+                     uint32_t seed) {
+  switch (type) {
+    case CHECKSUM_CRC32:
+      return static_cast<uint32_t>(crc32(seed, data, len));
+    case CHECKSUM_CRC32C:
+      return Crc32c(seed, data, len);
+    case CHECKSUM_ADLER32:
+      return static_cast<uint32_t>(adler32(seed, data, len));
+    default:
+      UNREACHABLE();
+  }
+}
+
+// checksum(type, buffer, seed) -> uint32
+void ChecksumSync(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  CHECK(Buffer::HasInstance(args[1]));
+  CHECK(args[2]->IsUint32());
+
+  const uint32_t result = RunChecksum(
+      args[0].As<Uint32>()->Value(),
+      reinterpret_cast<const unsigned char*>(Buffer::Data(args[1])),
+      Buffer::Length(args[1]),
+      args[2].As<Uint32>()->Value());
+  args.GetReturnValue().Set(result);
+}
+
+class ChecksumJob final : public AsyncWrap, public ThreadPoolWork {
+ public:
+  ChecksumJob(Environment* env,
+              Local<Object> object,
+              uint32_t type,
+              uint32_t seed,
+              Local<Object> input,
+              Local<Function> callback)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(env, WorkClass::kCpuBound),
+        type_(type),
+        seed_(seed),
+        data_(reinterpret_cast<const unsigned char*>(Buffer::Data(input))),
+        len_(Buffer::Length(input)) {
+    input_.Reset(env->isolate(), input);
+    callback_.Reset(env->isolate(), callback);
+  }
+
+  void DoThreadPoolWork() override {
+    result_ = RunChecksum(type_, data_, len_, seed_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ChecksumJob> self(this);
+    if (status == UV_ECANCELED) return;
+    CHECK_EQ(status, 0);
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    Local<Value> argv[] = {
+      Null(env()->isolate()),
+      Integer::NewFromUnsigned(env()->isolate(), result_),
+    };
+    MakeCallback(callback_.Get(env()->isolate()), arraysize(argv), argv);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(ChecksumJob)
+  SET_SELF_SIZE(ChecksumJob)
+
+ private:
+  uint32_t type_;
+  uint32_t seed_;
+  const unsigned char* data_;
+  size_t len_;
+  uint32_t result_ = 0;
+  Global<Object> input_;
+  Global<Function> callback_;
+};
+
+// checksumAsync(type, buffer, seed, callback)
+void ChecksumAsync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  CHECK(Buffer::HasInstance(args[1]));
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsFunction());
+
+  Local<Object> obj;
+  if (!env->zlib_oneshot_job_template()
+           ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+
+  ChecksumJob* job = new ChecksumJob(env,
+                                     obj,
+                                     args[0].As<Uint32>()->Value(),
+                                     args[2].As<Uint32>()->Value(),
+                                     args[1].As<Object>(),
+                                     args[3].As<Function>());
+  job->ScheduleWork();
+}
+
+
 template <typename Stream>
 struct MakeClass {
   static void Make(Environment* env, Local<Object> target, const char* name) {
@@ -1224,6 +2414,8 @@ struct MakeClass {
     env->SetProtoMethod(z, "init", Stream::Init);
     env->SetProtoMethod(z, "params", Stream::Params);
     env->SetProtoMethod(z, "reset", Stream::Reset);
+    env->SetProtoMethod(z, "setOutputLimits", Stream::SetOutputLimits);
+    env->SetProtoMethod(z, "setAdaptive", Stream::SetAdaptive);
 
     Local<String> zlibString = OneByteString(env->isolate(), name);
     z->SetClassName(zlibString);
@@ -1243,6 +2435,23 @@ void Initialize(Local<Object> target,
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
 
+  env->SetMethod(target, "oneShotCompress", OneShotCompress);
+  env->SetMethod(target, "oneShotCompressSync", OneShotCompressSync);
+  env->SetMethod(target, "oneShotCompressParallel", OneShotCompressParallel);
+
+  env->SetMethodNoSideEffect(target, "checksum", ChecksumSync);
+  env->SetMethod(target, "checksumAsync", ChecksumAsync);
+  NODE_DEFINE_CONSTANT(target, CHECKSUM_CRC32);
+  NODE_DEFINE_CONSTANT(target, CHECKSUM_CRC32C);
+  NODE_DEFINE_CONSTANT(target, CHECKSUM_ADLER32);
+  NODE_DEFINE_CONSTANT(target, CHECKSUM_ASYNC_THRESHOLD);
+
+  {
+    Local<ObjectTemplate> t = ObjectTemplate::New(env->isolate());
+    t->SetInternalFieldCount(1);
+    env->set_zlib_oneshot_job_template(t);
+  }
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).Check();
@@ -19,13 +19,17 @@
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include "base_object-inl.h"
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "util-inl.h"
 
 #include <cstring>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 namespace node {
 
@@ -44,6 +48,140 @@ using v8::Value;
 
 namespace {
 
+// Caches the expensive-to-build spawn attributes (file, argv, env, cwd and
+// process flags) across spawns, the way posix_spawn attribute objects do.
+// Repeated spawns of the same command then pay only for stdio setup and the
+// uv_spawn() call itself instead of re-converting and copying every string.
+class SpawnTemplate : public BaseObject {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    // This constructor should not be exposed to public javascript.
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    Local<Object> js_options =
+        args[0]->ToObject(env->context()).ToLocalChecked();
+    new SpawnTemplate(env, args.This(), js_options);
+  }
+
+  SpawnTemplate(Environment* env,
+                Local<Object> object,
+                Local<Object> js_options)
+      : BaseObject(env, object) {
+    Local<Context> context = env->context();
+
+    Local<Value> uid_v =
+        js_options->Get(context, env->uid_string()).ToLocalChecked();
+    if (!uid_v->IsUndefined() && !uid_v->IsNull()) {
+      CHECK(uid_v->IsInt32());
+      flags_ |= UV_PROCESS_SETUID;
+      uid_ = static_cast<uv_uid_t>(uid_v.As<Int32>()->Value());
+    }
+
+    Local<Value> gid_v =
+        js_options->Get(context, env->gid_string()).ToLocalChecked();
+    if (!gid_v->IsUndefined() && !gid_v->IsNull()) {
+      CHECK(gid_v->IsInt32());
+      flags_ |= UV_PROCESS_SETGID;
+      gid_ = static_cast<uv_gid_t>(gid_v.As<Int32>()->Value());
+    }
+
+    Local<Value> file_v =
+        js_options->Get(context, env->file_string()).ToLocalChecked();
+    CHECK(file_v->IsString());
+    file_ = *node::Utf8Value(env->isolate(), file_v);
+
+    Local<Value> argv_v =
+        js_options->Get(context, env->args_string()).ToLocalChecked();
+    if (!argv_v.IsEmpty() && argv_v->IsArray()) {
+      Local<Array> js_argv = argv_v.As<Array>();
+      uint32_t argc = js_argv->Length();
+      args_storage_.reserve(argc);
+      for (uint32_t i = 0; i < argc; i++) {
+        node::Utf8Value arg(env->isolate(),
+                            js_argv->Get(context, i).ToLocalChecked());
+        args_storage_.emplace_back(*arg, arg.length());
+      }
+      // Build the pointer array only after the storage stopped moving.
+      for (std::string& arg : args_storage_)
+        argv_.push_back(&arg[0]);
+      argv_.push_back(nullptr);
+    }
+
+    Local<Value> cwd_v =
+        js_options->Get(context, env->cwd_string()).ToLocalChecked();
+    if (cwd_v->IsString()) {
+      node::Utf8Value cwd(env->isolate(), cwd_v);
+      cwd_.assign(*cwd, cwd.length());
+    }
+
+    Local<Value> env_v =
+        js_options->Get(context, env->env_pairs_string()).ToLocalChecked();
+    if (!env_v.IsEmpty() && env_v->IsArray()) {
+      has_env_ = true;
+      Local<Array> env_opt = env_v.As<Array>();
+      uint32_t envc = env_opt->Length();
+      env_storage_.reserve(envc);
+      for (uint32_t i = 0; i < envc; i++) {
+        node::Utf8Value pair(env->isolate(),
+                             env_opt->Get(context, i).ToLocalChecked());
+        env_storage_.emplace_back(*pair, pair.length());
+      }
+      for (std::string& pair : env_storage_)
+        envp_.push_back(&pair[0]);
+      envp_.push_back(nullptr);
+    }
+
+    Local<Value> hide_v =
+        js_options->Get(context, env->windows_hide_string()).ToLocalChecked();
+    if (hide_v->IsTrue())
+      flags_ |= UV_PROCESS_WINDOWS_HIDE;
+
+    Local<Value> wva_v =
+        js_options->Get(context, env->windows_verbatim_arguments_string())
+            .ToLocalChecked();
+    if (wva_v->IsTrue())
+      flags_ |= UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS;
+
+    Local<Value> detached_v =
+        js_options->Get(context, env->detached_string()).ToLocalChecked();
+    if (detached_v->IsTrue())
+      flags_ |= UV_PROCESS_DETACHED;
+  }
+
+  // Fills in everything that ParseStdioOptions() does not cover.
+  void Apply(uv_process_options_t* options) {
+    options->flags |= flags_;
+    options->uid = uid_;
+    options->gid = gid_;
+    options->file = file_.c_str();
+    options->args = argv_.empty() ? nullptr : argv_.data();
+    options->env = has_env_ ? envp_.data() : nullptr;
+    options->cwd = cwd_.empty() ? nullptr : cwd_.c_str();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("file", file_);
+    tracker->TrackField("cwd", cwd_);
+    tracker->TrackField("args_storage", args_storage_);
+    tracker->TrackField("env_storage", env_storage_);
+  }
+  SET_MEMORY_INFO_NAME(SpawnTemplate)
+  SET_SELF_SIZE(SpawnTemplate)
+
+ private:
+  std::string file_;
+  std::string cwd_;
+  std::vector<std::string> args_storage_;
+  std::vector<std::string> env_storage_;
+  std::vector<char*> argv_;
+  std::vector<char*> envp_;
+  bool has_env_ = false;
+  unsigned int flags_ = 0;
+  uv_uid_t uid_ = 0;
+  uv_gid_t gid_ = 0;
+};
+
+
 class ProcessWrap : public HandleWrap {
  public:
   static void Initialize(Local<Object> target,
@@ -65,6 +203,17 @@ class ProcessWrap : public HandleWrap {
     target->Set(env->context(),
                 processString,
                 constructor->GetFunction(context).ToLocalChecked()).Check();
+
+    Local<FunctionTemplate> spawn_template =
+        env->NewFunctionTemplate(SpawnTemplate::New);
+    spawn_template->InstanceTemplate()->SetInternalFieldCount(1);
+    Local<String> templateString =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "SpawnTemplate");
+    spawn_template->SetClassName(templateString);
+    target->Set(env->context(),
+                templateString,
+                spawn_template->GetFunction(context).ToLocalChecked())
+        .Check();
   }
 
   SET_NO_MEMORY_INFO()
@@ -152,106 +301,125 @@ class ProcessWrap : public HandleWrap {
 
     options.exit_cb = OnExit;
 
-    // options.uid
-    Local<Value> uid_v =
-        js_options->Get(context, env->uid_string()).ToLocalChecked();
-    if (!uid_v->IsUndefined() && !uid_v->IsNull()) {
-      CHECK(uid_v->IsInt32());
-      const int32_t uid = uid_v.As<Int32>()->Value();
-      options.flags |= UV_PROCESS_SETUID;
-      options.uid = static_cast<uv_uid_t>(uid);
+    // options.spawnTemplate - caches everything below except stdio.
+    Local<Value> template_v =
+        js_options->Get(context, env->spawn_template_string()).ToLocalChecked();
+    SpawnTemplate* tmpl = nullptr;
+    if (template_v->IsObject())
+      ASSIGN_OR_RETURN_UNWRAP(&tmpl, template_v.As<Object>());
+
+    // These must stay alive until after the uv_spawn() call below.
+    Local<Value> file_v;
+    Local<Value> cwd_v;
+    if (tmpl == nullptr) {
+      file_v = js_options->Get(context, env->file_string()).ToLocalChecked();
+      CHECK(file_v->IsString());
+      cwd_v = js_options->Get(context, env->cwd_string()).ToLocalChecked();
+      if (!cwd_v->IsString())
+        cwd_v = Local<Value>();
     }
-
-    // options.gid
-    Local<Value> gid_v =
-        js_options->Get(context, env->gid_string()).ToLocalChecked();
-    if (!gid_v->IsUndefined() && !gid_v->IsNull()) {
-      CHECK(gid_v->IsInt32());
-      const int32_t gid = gid_v.As<Int32>()->Value();
-      options.flags |= UV_PROCESS_SETGID;
-      options.gid = static_cast<uv_gid_t>(gid);
-    }
-
-    // TODO(bnoordhuis) is this possible to do without mallocing ?
-
-    // options.file
-    Local<Value> file_v =
-        js_options->Get(context, env->file_string()).ToLocalChecked();
-    CHECK(file_v->IsString());
     node::Utf8Value file(env->isolate(), file_v);
-    options.file = *file;
+    node::Utf8Value cwd(env->isolate(), cwd_v);
+
+    if (tmpl != nullptr) {
+      tmpl->Apply(&options);
+    } else {
+      // options.uid
+      Local<Value> uid_v =
+          js_options->Get(context, env->uid_string()).ToLocalChecked();
+      if (!uid_v->IsUndefined() && !uid_v->IsNull()) {
+        CHECK(uid_v->IsInt32());
+        const int32_t uid = uid_v.As<Int32>()->Value();
+        options.flags |= UV_PROCESS_SETUID;
+        options.uid = static_cast<uv_uid_t>(uid);
+      }
 
-    // options.args
-    Local<Value> argv_v =
-        js_options->Get(context, env->args_string()).ToLocalChecked();
-    if (!argv_v.IsEmpty() && argv_v->IsArray()) {
-      Local<Array> js_argv = Local<Array>::Cast(argv_v);
-      int argc = js_argv->Length();
-      CHECK_GT(argc + 1, 0);  // Check for overflow.
+      // options.gid
+      Local<Value> gid_v =
+          js_options->Get(context, env->gid_string()).ToLocalChecked();
+      if (!gid_v->IsUndefined() && !gid_v->IsNull()) {
+        CHECK(gid_v->IsInt32());
+        const int32_t gid = gid_v.As<Int32>()->Value();
+        options.flags |= UV_PROCESS_SETGID;
+        options.gid = static_cast<uv_gid_t>(gid);
+      }
 
-      // Heap allocate to detect errors. +1 is for nullptr.
-      options.args = new char*[argc + 1];
-      for (int i = 0; i < argc; i++) {
-        node::Utf8Value arg(env->isolate(),
-                            js_argv->Get(context, i).ToLocalChecked());
-        options.args[i] = strdup(*arg);
-        CHECK_NOT_NULL(options.args[i]);
+      // TODO(bnoordhuis) is this possible to do without mallocing ?
+
+      // options.file
+      options.file = *file;
+
+      // options.args
+      Local<Value> argv_v =
+          js_options->Get(context, env->args_string()).ToLocalChecked();
+      if (!argv_v.IsEmpty() && argv_v->IsArray()) {
+        Local<Array> js_argv = Local<Array>::Cast(argv_v);
+        int argc = js_argv->Length();
+        CHECK_GT(argc + 1, 0);  // Check for overflow.
+
+        // Heap allocate to detect errors. +1 is for nullptr.
+        options.args = new char*[argc + 1];
+        for (int i = 0; i < argc; i++) {
+          node::Utf8Value arg(env->isolate(),
+                              js_argv->Get(context, i).ToLocalChecked());
+          options.args[i] = strdup(*arg);
+          CHECK_NOT_NULL(options.args[i]);
+        }
+        options.args[argc] = nullptr;
       }
-      options.args[argc] = nullptr;
-    }
 
-    // options.cwd
-    Local<Value> cwd_v =
-        js_options->Get(context, env->cwd_string()).ToLocalChecked();
-    node::Utf8Value cwd(env->isolate(),
-                        cwd_v->IsString() ? cwd_v : Local<Value>());
-    if (cwd.length() > 0) {
-      options.cwd = *cwd;
-    }
+      // options.cwd
+      if (cwd.length() > 0) {
+        options.cwd = *cwd;
+      }
 
-    // options.env
-    Local<Value> env_v =
-        js_options->Get(context, env->env_pairs_string()).ToLocalChecked();
-    if (!env_v.IsEmpty() && env_v->IsArray()) {
-      Local<Array> env_opt = Local<Array>::Cast(env_v);
-      int envc = env_opt->Length();
-      CHECK_GT(envc + 1, 0);  // Check for overflow.
-      options.env = new char*[envc + 1];  // Heap allocated to detect errors.
-      for (int i = 0; i < envc; i++) {
-        node::Utf8Value pair(env->isolate(),
-                             env_opt->Get(context, i).ToLocalChecked());
-        options.env[i] = strdup(*pair);
-        CHECK_NOT_NULL(options.env[i]);
+      // options.env
+      Local<Value> env_v =
+          js_options->Get(context, env->env_pairs_string()).ToLocalChecked();
+      if (!env_v.IsEmpty() && env_v->IsArray()) {
+        Local<Array> env_opt = Local<Array>::Cast(env_v);
+        int envc = env_opt->Length();
+        CHECK_GT(envc + 1, 0);  // Check for overflow.
+        options.env = new char*[envc + 1];  // Heap allocated to detect errors.
+        for (int i = 0; i < envc; i++) {
+          node::Utf8Value pair(env->isolate(),
+                               env_opt->Get(context, i).ToLocalChecked());
+          options.env[i] = strdup(*pair);
+          CHECK_NOT_NULL(options.env[i]);
+        }
+        options.env[envc] = nullptr;
       }
-      options.env[envc] = nullptr;
     }
 
     // options.stdio
     ParseStdioOptions(env, js_options, &options);
 
-    // options.windowsHide
-    Local<Value> hide_v =
-        js_options->Get(context, env->windows_hide_string()).ToLocalChecked();
+    if (tmpl == nullptr) {
+      // options.windowsHide
+      Local<Value> hide_v =
+          js_options->Get(context, env->windows_hide_string())
+              .ToLocalChecked();
 
-    if (hide_v->IsTrue()) {
-      options.flags |= UV_PROCESS_WINDOWS_HIDE;
-    }
+      if (hide_v->IsTrue()) {
+        options.flags |= UV_PROCESS_WINDOWS_HIDE;
+      }
 
-    // options.windows_verbatim_arguments
-    Local<Value> wva_v =
-        js_options->Get(context, env->windows_verbatim_arguments_string())
-            .ToLocalChecked();
+      // options.windows_verbatim_arguments
+      Local<Value> wva_v =
+          js_options->Get(context, env->windows_verbatim_arguments_string())
+              .ToLocalChecked();
 
-    if (wva_v->IsTrue()) {
-      options.flags |= UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS;
-    }
+      if (wva_v->IsTrue()) {
+        options.flags |= UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS;
+      }
 
-    // options.detached
-    Local<Value> detached_v =
-        js_options->Get(context, env->detached_string()).ToLocalChecked();
+      // options.detached
+      Local<Value> detached_v =
+          js_options->Get(context, env->detached_string()).ToLocalChecked();
 
-    if (detached_v->IsTrue()) {
-      options.flags |= UV_PROCESS_DETACHED;
+      if (detached_v->IsTrue()) {
+        options.flags |= UV_PROCESS_DETACHED;
+      }
     }
 
     int err = uv_spawn(env->event_loop(), &wrap->process_, &options);
@@ -264,14 +432,17 @@ class ProcessWrap : public HandleWrap {
                                        wrap->process_.pid)).Check();
     }
 
-    if (options.args) {
-      for (int i = 0; options.args[i]; i++) free(options.args[i]);
-      delete [] options.args;
-    }
+    // When spawning from a template the args/env arrays belong to it.
+    if (tmpl == nullptr) {
+      if (options.args) {
+        for (int i = 0; options.args[i]; i++) free(options.args[i]);
+        delete [] options.args;
+      }
 
-    if (options.env) {
-      for (int i = 0; options.env[i]; i++) free(options.env[i]);
-      delete [] options.env;
+      if (options.env) {
+        for (int i = 0; options.env[i]; i++) free(options.env[i]);
+        delete [] options.env;
+      }
     }
 
     delete[] options.stdio;
@@ -26,6 +26,8 @@
 #include "string_bytes.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <climits>  // UINT_MAX
 #include <cstring>
 
 
@@ -50,48 +52,6 @@ using v8::Object;
 using v8::String;
 using v8::Value;
 
-void SyncProcessOutputBuffer::OnAlloc(size_t suggested_size,
-                                      uv_buf_t* buf) const {
-  if (used() == kBufferSize)
-    *buf = uv_buf_init(nullptr, 0);
-  else
-    *buf = uv_buf_init(data_ + used(), available());
-}
-
-
-void SyncProcessOutputBuffer::OnRead(const uv_buf_t* buf, size_t nread) {
-  // If we hand out the same chunk twice, this should catch it.
-  CHECK_EQ(buf->base, data_ + used());
-  used_ += static_cast<unsigned int>(nread);
-}
-
-
-size_t SyncProcessOutputBuffer::Copy(char* dest) const {
-  memcpy(dest, data_, used());
-  return used();
-}
-
-
-unsigned int SyncProcessOutputBuffer::available() const {
-  return sizeof data_ - used();
-}
-
-
-unsigned int SyncProcessOutputBuffer::used() const {
-  return used_;
-}
-
-
-SyncProcessOutputBuffer* SyncProcessOutputBuffer::next() const {
-  return next_;
-}
-
-
-void SyncProcessOutputBuffer::set_next(SyncProcessOutputBuffer* next) {
-  next_ = next;
-}
-
-
 SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
                                            bool readable,
                                            bool writable,
@@ -101,8 +61,9 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
       writable_(writable),
       input_buffer_(input_buffer),
 
-      first_output_buffer_(nullptr),
-      last_output_buffer_(nullptr),
+      output_(nullptr),
+      output_used_(0),
+      output_capacity_(0),
 
       uv_pipe_(),
       write_req_(),
@@ -116,13 +77,8 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
 SyncProcessStdioPipe::~SyncProcessStdioPipe() {
   CHECK(lifecycle_ == kUninitialized || lifecycle_ == kClosed);
 
-  SyncProcessOutputBuffer* buf;
-  SyncProcessOutputBuffer* next;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = next) {
-    next = buf->next();
-    delete buf;
-  }
+  // The arena is null if GetOutputAsBuffer() transferred it to a Buffer.
+  free(output_);
 }
 
 
@@ -184,11 +140,18 @@ void SyncProcessStdioPipe::Close() {
 }
 
 
-Local<Object> SyncProcessStdioPipe::GetOutputAsBuffer(Environment* env) const {
-  size_t length = OutputLength();
-  Local<Object> js_buffer = Buffer::New(env, length).ToLocalChecked();
-  CopyOutput(Buffer::Data(js_buffer));
-  return js_buffer;
+Local<Object> SyncProcessStdioPipe::GetOutputAsBuffer(Environment* env) {
+  if (output_used_ == 0)
+    return Buffer::New(env, 0).ToLocalChecked();
+
+  // Trim the arena down to the bytes actually read and hand it over to the
+  // Buffer instead of copying it.
+  char* data = Realloc(output_, output_used_);
+  size_t length = output_used_;
+  output_ = nullptr;
+  output_used_ = 0;
+  output_capacity_ = 0;
+  return Buffer::New(env, data, length, true).ToLocalChecked();
 }
 
 
@@ -231,45 +194,41 @@ uv_handle_t* SyncProcessStdioPipe::uv_handle() const {
 }
 
 
-size_t SyncProcessStdioPipe::OutputLength() const {
-  SyncProcessOutputBuffer* buf;
-  size_t size = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    size += buf->used();
-
-  return size;
-}
-
-
-void SyncProcessStdioPipe::CopyOutput(char* dest) const {
-  SyncProcessOutputBuffer* buf;
-  size_t offset = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    offset += buf->Copy(dest + offset);
-}
-
-
 void SyncProcessStdioPipe::OnAlloc(size_t suggested_size, uv_buf_t* buf) {
   // This function assumes that libuv will never allocate two buffers for the
-  // same stream at the same time. There's an assert in
-  // SyncProcessOutputBuffer::OnRead that would fail if this assumption was
-  // ever violated.
-
-  if (last_output_buffer_ == nullptr) {
-    // Allocate the first capture buffer.
-    first_output_buffer_ = new SyncProcessOutputBuffer();
-    last_output_buffer_ = first_output_buffer_;
-
-  } else if (last_output_buffer_->available() == 0) {
-    // The current capture buffer is full so get us a new one.
-    SyncProcessOutputBuffer* buf = new SyncProcessOutputBuffer();
-    last_output_buffer_->set_next(buf);
-    last_output_buffer_ = buf;
+  // same stream at the same time. There's an assert in OnRead that would
+  // fail if this assumption was ever violated.
+
+  // Hand out the free tail of the output arena, growing it geometrically
+  // when the tail runs low, so that reads land directly in their final
+  // location and large outputs need only O(log n) reallocations.
+  if (output_capacity_ - output_used_ < kInitialOutputCapacity / 16) {
+    size_t new_capacity =
+        std::max(output_capacity_ * 2, kInitialOutputCapacity);
+
+    // When a maxBuffer cap is in effect there is no point in growing (much)
+    // beyond it: cap the arena at the remaining budget plus one read chunk,
+    // which both bounds memory and still lets the cap overflow get detected.
+    double max_buffer = process_handler_->max_buffer_;
+    if (max_buffer > 0) {
+      size_t total = process_handler_->buffered_output_size_;
+      size_t remaining =
+          max_buffer > total ? static_cast<size_t>(max_buffer - total) : 0;
+      size_t capped = output_used_ +
+          std::max(remaining + 1, static_cast<size_t>(kInitialOutputCapacity));
+      new_capacity = std::min(new_capacity, capped);
+    }
+
+    if (new_capacity > output_capacity_) {
+      output_ = Realloc(output_, new_capacity);
+      output_capacity_ = new_capacity;
+    }
   }
 
-  last_output_buffer_->OnAlloc(suggested_size, buf);
+  size_t available = output_capacity_ - output_used_;
+  *buf = uv_buf_init(output_ + output_used_,
+                     static_cast<unsigned int>(
+                         std::min<size_t>(available, UINT_MAX)));
 }
 
 
@@ -283,7 +242,9 @@ void SyncProcessStdioPipe::OnRead(const uv_buf_t* buf, ssize_t nread) {
     uv_read_stop(uv_stream());
 
   } else {
-    last_output_buffer_->OnRead(buf, nread);
+    // If we hand out the same chunk twice, this should catch it.
+    CHECK_EQ(buf->base, output_ + output_used_);
+    output_used_ += nread;
     process_handler_->IncrementBufferSizeAndCheckOverflow(nread);
   }
 }
@@ -32,38 +32,14 @@ namespace node {
 
 
 
-class SyncProcessOutputBuffer;
 class SyncProcessStdioPipe;
 class SyncProcessRunner;
 
 
-class SyncProcessOutputBuffer {
-  static const unsigned int kBufferSize = 65536;
-
- public:
-  inline SyncProcessOutputBuffer() = default;
-
-  inline void OnAlloc(size_t suggested_size, uv_buf_t* buf) const;
-  inline void OnRead(const uv_buf_t* buf, size_t nread);
-
-  inline size_t Copy(char* dest) const;
-
-  inline unsigned int available() const;
-  inline unsigned int used() const;
-
-  inline SyncProcessOutputBuffer* next() const;
-  inline void set_next(SyncProcessOutputBuffer* next);
-
- private:
-  // Use unsigned int because that's what `uv_buf_init` takes.
-  mutable char data_[kBufferSize];
-  unsigned int used_ = 0;
-
-  SyncProcessOutputBuffer* next_ = nullptr;
-};
+class SyncProcessStdioPipe {
+  static const size_t kInitialOutputCapacity = 65536;
 
 
-class SyncProcessStdioPipe {
   enum Lifecycle {
     kUninitialized = 0,
     kInitialized,
@@ -83,7 +59,7 @@ class SyncProcessStdioPipe {
   int Start();
   void Close();
 
-  v8::Local<v8::Object> GetOutputAsBuffer(Environment* env) const;
+  v8::Local<v8::Object> GetOutputAsBuffer(Environment* env);
 
   inline bool readable() const;
   inline bool writable() const;
@@ -94,9 +70,6 @@ class SyncProcessStdioPipe {
   inline uv_handle_t* uv_handle() const;
 
  private:
-  inline size_t OutputLength() const;
-  inline void CopyOutput(char* dest) const;
-
   inline void OnAlloc(size_t suggested_size, uv_buf_t* buf);
   inline void OnRead(const uv_buf_t* buf, ssize_t nread);
   inline void OnWriteDone(int result);
@@ -121,8 +94,11 @@ class SyncProcessStdioPipe {
   bool writable_;
   uv_buf_t input_buffer_;
 
-  SyncProcessOutputBuffer* first_output_buffer_;
-  SyncProcessOutputBuffer* last_output_buffer_;
+  // Geometrically growing arena that child output is read into directly,
+  // so that no chunk list has to be concatenated when the process exits.
+  char* output_;
+  size_t output_used_;
+  size_t output_capacity_;
 
   mutable uv_pipe_t uv_pipe_;
   uv_write_t write_req_;
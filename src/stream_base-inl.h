@@ -7,6 +7,8 @@
 
 #include "node.h"
 #include "env-inl.h"
+#include "node_dtrace.h"
+#include "tracing/trace_category_state.h"
 #include "v8.h"
 
 namespace node {
@@ -116,8 +118,13 @@ inline uv_buf_t StreamResource::EmitAlloc(size_t suggested_size) {
 
 inline void StreamResource::EmitRead(ssize_t nread, const uv_buf_t& buf) {
   DebugSealHandleScope handle_scope(v8::Isolate::GetCurrent());
-  if (nread > 0)
+  if (nread > 0) {
     bytes_read_ += static_cast<uint64_t>(nread);
+    dtrace_stream_read(this, static_cast<int32_t>(nread));
+  }
+  if (UNLIKELY(tracing::TraceCategoryState::Enabled(
+          tracing::TraceCategoryState::kNodeStream)))
+    TraceReadChunk(nread);
   listener_->OnStreamRead(nread, buf);
 }
 
@@ -149,6 +156,11 @@ inline int StreamBase::Shutdown(v8::Local<v8::Object> req_wrap_obj) {
 
   HandleScope handle_scope(env->isolate());
 
+  // Writes that were queued while corked have to go out before the stream
+  // shuts down.
+  if (cork_state_ != nullptr)
+    FlushCorkedWrites();
+
   if (req_wrap_obj.IsEmpty()) {
     if (!env->shutdown_wrap_template()
              ->NewInstance(env->context())
@@ -189,6 +201,11 @@ inline StreamWriteResult StreamBase::Write(
   for (size_t i = 0; i < count; ++i)
     total_bytes += bufs[i].len;
   bytes_written_ += total_bytes;
+  dtrace_stream_write(this, static_cast<int32_t>(total_bytes));
+
+  if (corked_ && send_handle == nullptr) {
+    return QueueCorkedWrite(bufs, count, req_wrap_obj, total_bytes);
+  }
 
   if (send_handle == nullptr) {
     err = DoTryWrite(&bufs, &count);
@@ -284,7 +301,9 @@ inline void WriteWrap::SetAllocatedStorage(AllocatedBuffer&& storage) {
 }
 
 inline void WriteWrap::OnDone(int status) {
-  stream()->EmitAfterWrite(this, status);
+  StreamBase* stream = this->stream();
+  stream->EmitAfterWrite(this, status);
+  stream->OnCorkedWriteDone(this, status);
   Dispose();
 }
 
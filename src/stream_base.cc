@@ -5,6 +5,8 @@
 #include "node.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "node_internals.h"
+#include "tracing/trace_event.h"
 #include "env-inl.h"
 #include "js_stream.h"
 #include "string_bytes.h"
@@ -32,6 +34,74 @@ using v8::ReadOnly;
 using v8::String;
 using v8::Value;
 
+namespace {
+
+// Storage blocks handed out by `StreamReq::operator new` carry a small
+// header so that `operator delete` can tell whether the block belongs to a
+// per-Environment pool. Pooled blocks all have the same capacity; requests
+// that do not fit (or that are allocated via plain `new`) fall back to
+// malloc() with a null header.
+struct alignas(std::max_align_t) StreamReqStorage {
+  Environment* env;
+};
+
+constexpr size_t kStreamReqStorageSize = 1024;
+constexpr size_t kStreamReqPoolLimit = 64;
+
+// Read buffers of this size are recycled through a per-Environment
+// freelist instead of being allocated per read. Since the buffers are
+// both allocated and first touched on the event loop thread, the pages
+// stay first-touch bound to that thread's NUMA node.
+constexpr size_t kStreamReadBufferSize = 64 * 1024;
+constexpr size_t kStreamReadBufferPoolLimit = 16;
+// Reads at or below this size are copied into an exactly-sized buffer for
+// JS so that the large read buffer can be recycled right away.
+constexpr size_t kStreamReadCopyThreshold = 8 * 1024;
+
+}  // anonymous namespace
+
+void* StreamReq::operator new(size_t size, Environment* env) {
+  StreamReqStorage* storage;
+  if (env != nullptr && sizeof(StreamReqStorage) + size <=
+                            kStreamReqStorageSize) {
+    std::vector<void*>& freelist = env->stream_req_storage_freelist();
+    if (!freelist.empty()) {
+      storage = static_cast<StreamReqStorage*>(freelist.back());
+      freelist.pop_back();
+    } else {
+      storage = reinterpret_cast<StreamReqStorage*>(
+          Malloc(kStreamReqStorageSize));
+    }
+    storage->env = env;
+  } else {
+    storage = reinterpret_cast<StreamReqStorage*>(
+        Malloc(sizeof(StreamReqStorage) + size));
+    storage->env = nullptr;
+  }
+  return storage + 1;
+}
+
+void* StreamReq::operator new(size_t size) {
+  return operator new(size, static_cast<Environment*>(nullptr));
+}
+
+void StreamReq::operator delete(void* ptr, size_t size) {
+  StreamReqStorage* storage = static_cast<StreamReqStorage*>(ptr) - 1;
+  Environment* env = storage->env;
+  if (env != nullptr) {
+    std::vector<void*>& freelist = env->stream_req_storage_freelist();
+    if (freelist.size() < kStreamReqPoolLimit) {
+      freelist.push_back(storage);
+      return;
+    }
+  }
+  free(storage);
+}
+
+void StreamReq::operator delete(void* ptr, Environment* env) {
+  operator delete(ptr, static_cast<size_t>(0));
+}
+
 template int StreamBase::WriteString<ASCII>(
     const FunctionCallbackInfo<Value>& args);
 template int StreamBase::WriteString<UTF8>(
@@ -87,19 +157,30 @@ int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
   else
     count = chunks->Length() >> 1;
 
-  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  // Chunked HTTP responses routinely produce several dozen small fragments
+  // per writev() call; keep the iovec for those on the stack.
+  MaybeStackBuffer<uv_buf_t, 64> bufs(count);
 
   size_t storage_size = 0;
   size_t offset;
 
   if (!all_buffers) {
-    // Determine storage size first
+    // Flatten the string chunks and determine the total storage size in a
+    // single pass, so that the write loop below does not have to call
+    // ToString() and ParseEncoding() on every chunk a second time.
+    MaybeStackBuffer<Local<String>, 64> strings(count);
+    MaybeStackBuffer<enum encoding, 64> encodings(count);
+
     for (size_t i = 0; i < count; i++) {
       Local<Value> chunk = chunks->Get(env->context(), i * 2).ToLocalChecked();
 
-      if (Buffer::HasInstance(chunk))
-        continue;
+      if (Buffer::HasInstance(chunk)) {
         // Buffer chunk, no additional storage required
+        bufs[i].base = Buffer::Data(chunk);
+        bufs[i].len = Buffer::Length(chunk);
+        strings[i] = Local<String>();
+        continue;
+      }
 
       // String chunk
       Local<String> string = chunk->ToString(env->context()).ToLocalChecked();
@@ -113,58 +194,55 @@ int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
                     .To(&chunk_size))
         return 0;
       storage_size += chunk_size;
+      strings[i] = string;
+      encodings[i] = encoding;
     }
 
     if (storage_size > INT_MAX)
       return UV_ENOBUFS;
-  } else {
-    for (size_t i = 0; i < count; i++) {
-      Local<Value> chunk = chunks->Get(env->context(), i).ToLocalChecked();
-      bufs[i].base = Buffer::Data(chunk);
-      bufs[i].len = Buffer::Length(chunk);
-    }
-  }
 
-  AllocatedBuffer storage;
-  if (storage_size > 0)
-    storage = env->AllocateManaged(storage_size);
+    // Encode all string chunks back-to-back into a single scratch region and
+    // point the remaining iovec entries into it, so that the whole chunk
+    // array is submitted as one vectored write.
+    AllocatedBuffer storage;
+    if (storage_size > 0)
+      storage = env->AllocateManaged(storage_size);
 
-  offset = 0;
-  if (!all_buffers) {
+    offset = 0;
     for (size_t i = 0; i < count; i++) {
-      Local<Value> chunk = chunks->Get(env->context(), i * 2).ToLocalChecked();
+      if (strings[i].IsEmpty())
+        continue;  // Buffer chunk, already filled in above.
 
-      // Write buffer
-      if (Buffer::HasInstance(chunk)) {
-        bufs[i].base = Buffer::Data(chunk);
-        bufs[i].len = Buffer::Length(chunk);
-        continue;
-      }
-
-      // Write string
       CHECK_LE(offset, storage_size);
       char* str_storage = storage.data() + offset;
       size_t str_size = storage.size() - offset;
 
-      Local<String> string = chunk->ToString(env->context()).ToLocalChecked();
-      enum encoding encoding = ParseEncoding(env->isolate(),
-          chunks->Get(env->context(), i * 2 + 1).ToLocalChecked());
       str_size = StringBytes::Write(env->isolate(),
                                     str_storage,
                                     str_size,
-                                    string,
-                                    encoding);
+                                    strings[i],
+                                    encodings[i]);
       bufs[i].base = str_storage;
       bufs[i].len = str_size;
       offset += str_size;
     }
+
+    StreamWriteResult res = Write(*bufs, count, nullptr, req_wrap_obj);
+    SetWriteResult(res);
+    if (res.wrap != nullptr && storage_size > 0) {
+      res.wrap->SetAllocatedStorage(std::move(storage));
+    }
+    return res.err;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(env->context(), i).ToLocalChecked();
+    bufs[i].base = Buffer::Data(chunk);
+    bufs[i].len = Buffer::Length(chunk);
   }
 
   StreamWriteResult res = Write(*bufs, count, nullptr, req_wrap_obj);
   SetWriteResult(res);
-  if (res.wrap != nullptr && storage_size > 0) {
-    res.wrap->SetAllocatedStorage(std::move(storage));
-  }
   return res.err;
 }
 
@@ -239,7 +317,8 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
   uv_buf_t buf;
 
   bool try_write = storage_size <= sizeof(stack_storage) &&
-                   (!IsIPCPipe() || send_handle_obj.IsEmpty());
+                   (!IsIPCPipe() || send_handle_obj.IsEmpty()) &&
+                   !is_corked();  // Corked writes are queued, not written.
   if (try_write) {
     data_size = StringBytes::Write(env->isolate(),
                                    stack_storage,
@@ -313,6 +392,109 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void StreamBase::Cork() {
+  if (cork_state_ == nullptr)
+    cork_state_.reset(new CorkState());
+  corked_ = true;
+}
+
+int StreamBase::Uncork() {
+  corked_ = false;
+  return FlushCorkedWrites();
+}
+
+int StreamBase::CorkJS(const FunctionCallbackInfo<Value>& args) {
+  Cork();
+  return 0;
+}
+
+int StreamBase::UncorkJS(const FunctionCallbackInfo<Value>& args) {
+  return Uncork();
+}
+
+StreamWriteResult StreamBase::QueueCorkedWrite(
+    uv_buf_t* bufs,
+    size_t count,
+    Local<Object> req_wrap_obj,
+    size_t total_bytes) {
+  Environment* env = stream_env();
+  HandleScope handle_scope(env->isolate());
+
+  if (req_wrap_obj.IsEmpty()) {
+    if (!env->write_wrap_template()
+             ->NewInstance(env->context())
+             .ToLocal(&req_wrap_obj)) {
+      return StreamWriteResult { false, UV_EBUSY, nullptr, 0 };
+    }
+    StreamReq::ResetObject(req_wrap_obj);
+  }
+
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(GetAsyncWrap());
+  WriteWrap* req_wrap = CreateWriteWrap(req_wrap_obj);
+
+  CorkState* state = cork_state_.get();
+  state->bufs.insert(state->bufs.end(), bufs, bufs + count);
+  state->wraps.push_back(req_wrap);
+  ScheduleCorkedFlush();
+
+  // The write always completes asynchronously, when the flush finishes.
+  return StreamWriteResult { true, 0, req_wrap, total_bytes };
+}
+
+void StreamBase::ScheduleCorkedFlush() {
+  CorkState* state = cork_state_.get();
+  if (state->flush_scheduled)
+    return;
+  state->flush_scheduled = true;
+
+  BaseObjectPtr<AsyncWrap> strong_ref{GetAsyncWrap()};
+  stream_env()->SetImmediate([this, strong_ref](Environment* env) {
+    cork_state_->flush_scheduled = false;
+    FlushCorkedWrites();
+  });
+}
+
+int StreamBase::FlushCorkedWrites() {
+  CorkState* state = cork_state_.get();
+  if (state == nullptr || state->wraps.empty())
+    return 0;
+
+  std::vector<uv_buf_t> bufs = std::move(state->bufs);
+  std::vector<WriteWrap*> wraps = std::move(state->wraps);
+  state->bufs.clear();
+  state->wraps.clear();
+
+  // The first queued wrap carries the actual stream write; the others are
+  // completed alongside it from OnCorkedWriteDone().
+  WriteWrap* master = wraps.front();
+  std::vector<WriteWrap*> followers(wraps.begin() + 1, wraps.end());
+  state->inflight.emplace_back(master, std::move(followers));
+
+  int err = DoWrite(master, bufs.data(), bufs.size(), nullptr);
+  if (err != 0) {
+    // Synchronous failure: deliver it through the regular completion path
+    // for every queued write. master->Done() also clears the inflight entry.
+    master->Done(err);
+  }
+  return err;
+}
+
+void StreamBase::OnCorkedWriteDone(WriteWrap* w, int status) {
+  CorkState* state = cork_state_.get();
+  if (state == nullptr)
+    return;
+
+  for (auto it = state->inflight.begin(); it != state->inflight.end(); ++it) {
+    if (it->first != w)
+      continue;
+    std::vector<WriteWrap*> followers = std::move(it->second);
+    state->inflight.erase(it);
+    for (WriteWrap* follower : followers)
+      follower->Done(status);
+    return;
+  }
+}
+
 MaybeLocal<Value> StreamBase::CallJSOnreadMethod(ssize_t nread,
                                                  Local<ArrayBuffer> ab,
                                                  size_t offset,
@@ -396,6 +578,8 @@ void StreamBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
                       JSMethod<&StreamBase::UseUserBuffer>);
   env->SetProtoMethod(t, "writev", JSMethod<&StreamBase::Writev>);
   env->SetProtoMethod(t, "writeBuffer", JSMethod<&StreamBase::WriteBuffer>);
+  env->SetProtoMethod(t, "cork", JSMethod<&StreamBase::CorkJS>);
+  env->SetProtoMethod(t, "uncork", JSMethod<&StreamBase::UncorkJS>);
   env->SetProtoMethod(
       t, "writeAsciiString", JSMethod<&StreamBase::WriteString<ASCII>>);
   env->SetProtoMethod(
@@ -474,9 +658,24 @@ void StreamResource::ClearError() {
 }
 
 
+void StreamResource::TraceReadChunk(ssize_t nread) {
+  TRACE_EVENT_INSTANT1(TRACING_CATEGORY_NODE1(stream),
+                       "read_chunk",
+                       TRACE_EVENT_SCOPE_THREAD,
+                       "nread",
+                       static_cast<int64_t>(nread));
+}
+
+
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  std::vector<AllocatedBuffer>& freelist = env->stream_read_buffer_freelist();
+  if (suggested_size <= kStreamReadBufferSize && !freelist.empty()) {
+    AllocatedBuffer buf = std::move(freelist.back());
+    freelist.pop_back();
+    return buf.release();
+  }
   return env->AllocateManaged(suggested_size).release();
 }
 
@@ -488,13 +687,32 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Context::Scope context_scope(env->context());
   AllocatedBuffer buf(env, buf_);
 
+  std::vector<AllocatedBuffer>& freelist = env->stream_read_buffer_freelist();
+  const bool recyclable =
+      buf.size() == kStreamReadBufferSize &&
+      freelist.size() < kStreamReadBufferPoolLimit;
+
   if (nread <= 0)  {
+    if (recyclable)
+      freelist.push_back(std::move(buf));
     if (nread < 0)
       stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
     return;
   }
 
   CHECK_LE(static_cast<size_t>(nread), buf.size());
+
+  // For small reads — the common case on request/response workloads — hand
+  // JS a right-sized copy and recycle the read buffer immediately, so that
+  // the next read does not have to allocate a fresh one.
+  if (recyclable && static_cast<size_t>(nread) <= kStreamReadCopyThreshold) {
+    AllocatedBuffer copy = env->AllocateManaged(nread);
+    memcpy(copy.data(), buf.data(), nread);
+    freelist.push_back(std::move(buf));
+    stream->CallJSOnreadMethod(nread, copy.ToArrayBuffer());
+    return;
+  }
+
   buf.Resize(nread);
 
   stream->CallJSOnreadMethod(nread, buf.ToArrayBuffer());
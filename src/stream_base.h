@@ -54,6 +54,15 @@ class StreamReq {
   // constructor explicitly.
   static inline void ResetObject(v8::Local<v8::Object> req_wrap_obj);
 
+  // Stream requests are allocated at a very high rate on busy sockets.
+  // Allocating through `new (env) ...` draws the storage from a small
+  // per-Environment freelist, so that steady-state writes do not hit
+  // malloc()/free() at all; plain `new` keeps working and bypasses the pool.
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, Environment* env);
+  static void operator delete(void* ptr, size_t size);
+  static void operator delete(void* ptr, Environment* env);
+
  protected:
   virtual void OnDone(int status) = 0;
 
@@ -265,6 +274,11 @@ class StreamResource {
   // Call the current listener's OnStreamWantsWrite() method.
   void EmitWantsWrite(size_t suggested_size);
 
+  // Emit a node.stream trace event for a read chunk. Out of line so that
+  // EmitRead() only pays a single cached-byte check while the category is
+  // disabled.
+  void TraceReadChunk(ssize_t nread);
+
   StreamListener* listener_ = nullptr;
   uint64_t bytes_read_ = 0;
   uint64_t bytes_written_ = 0;
@@ -318,6 +332,22 @@ class StreamBase : public StreamResource {
       uv_stream_t* send_handle = nullptr,
       v8::Local<v8::Object> req_wrap_obj = v8::Local<v8::Object>());
 
+  // Cork the stream: while corked, `Write()` queues the submitted buffers
+  // without copying them and completes asynchronously. The queue is flushed
+  // as a single vectored write either by `Uncork()` or automatically at the
+  // end of the current loop turn. Buffer memory must stay valid until the
+  // corresponding write callback has fired — the same contract as for any
+  // asynchronous write.
+  void Cork();
+  int Uncork();
+  inline bool is_corked() const { return corked_; }
+
+  // Publish the result of a write to the JS-visible stream state array.
+  // Native code that calls `Write()` on behalf of a JS caller (instead of
+  // going through the writeBuffer()/writev() bindings) uses this to report
+  // bytes written and asynchronicity the same way those bindings do.
+  void SetWriteResult(const StreamWriteResult& res);
+
   // These can be overridden by subclasses to get more specific wrap instances.
   // For example, a subclass Foo could create a FooWriteWrap or FooShutdownWrap
   // (inheriting from ShutdownWrap/WriteWrap) that has extra fields, like
@@ -340,6 +370,8 @@ class StreamBase : public StreamResource {
   int Shutdown(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Writev(const v8::FunctionCallbackInfo<v8::Value>& args);
   int WriteBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int CorkJS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int UncorkJS(const v8::FunctionCallbackInfo<v8::Value>& args);
   template <enum encoding enc>
   int WriteString(const v8::FunctionCallbackInfo<v8::Value>& args);
   int UseUserBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -367,7 +399,28 @@ class StreamBase : public StreamResource {
   Environment* env_;
   EmitToJSStreamListener default_listener_;
 
-  void SetWriteResult(const StreamWriteResult& res);
+  // Cork state, allocated lazily on the first Cork() call.
+  struct CorkState {
+    bool flush_scheduled = false;
+    std::vector<uv_buf_t> bufs;
+    std::vector<WriteWrap*> wraps;
+    // In-flight flushes: the dispatched (master) wrap plus the queued wraps
+    // that are completed when it finishes.
+    std::vector<std::pair<WriteWrap*, std::vector<WriteWrap*>>> inflight;
+  };
+  std::unique_ptr<CorkState> cork_state_;
+  bool corked_ = false;
+
+  StreamWriteResult QueueCorkedWrite(uv_buf_t* bufs,
+                                     size_t count,
+                                     v8::Local<v8::Object> req_wrap_obj,
+                                     size_t total_bytes);
+  int FlushCorkedWrites();
+  void ScheduleCorkedFlush();
+  // Called for every finished write; completes queued writes that were
+  // coalesced into `w`. No-op unless the stream has ever been corked.
+  void OnCorkedWriteDone(WriteWrap* w, int status);
+
   static void AddMethod(Environment* env,
                         v8::Local<v8::Signature> sig,
                         enum v8::PropertyAttribute attributes,
@@ -393,6 +446,11 @@ class SimpleShutdownWrap : public ShutdownWrap, public OtherBase {
 
   AsyncWrap* GetAsyncWrap() override { return this; }
 
+  // `OtherBase` may be a `ReqWrap`, which has its own pooled allocator;
+  // stream requests always go through the `StreamReq` one.
+  using StreamReq::operator new;
+  using StreamReq::operator delete;
+
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SimpleShutdownWrap)
   SET_SELF_SIZE(SimpleShutdownWrap)
@@ -406,6 +464,10 @@ class SimpleWriteWrap : public WriteWrap, public OtherBase {
 
   AsyncWrap* GetAsyncWrap() override { return this; }
 
+  // See SimpleShutdownWrap.
+  using StreamReq::operator new;
+  using StreamReq::operator delete;
+
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SimpleWriteWrap)
   SET_SELF_SIZE(SimpleWriteWrap)
@@ -1,8 +1,16 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
 #include "node_buffer.h"
+#include "node_file.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -57,6 +65,8 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
   if (is_closed_)
     return;
 
+  StopKernelOffload();
+
   // Note that we possibly cannot use virtual methods on `source` and `sink`
   // here, because this function can be called from their destructors via
   // `OnStreamDestroy()`.
@@ -71,10 +81,11 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
   if (is_in_deletion) return;
 
   // Delay the JS-facing part with SetImmediate, because this might be from
-  // inside the garbage collector, so we can’t run JS here.
+  // inside the garbage collector, so we can’t run JS here. Use the
+  // high-priority lane so that teardown is not stuck behind bulk immediates.
   HandleScope handle_scope(env()->isolate());
   BaseObjectPtr<StreamPipe> strong_ref{this};
-  env()->SetImmediate([this, strong_ref](Environment* env) {
+  env()->SetHighPriorityImmediate([this, strong_ref](Environment* env) {
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
     Local<Object> object = this->object();
@@ -208,7 +219,7 @@ void StreamPipe::WritableListener::OnStreamDestroy() {
 void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
   pipe->wanted_data_ = suggested_size;
-  if (pipe->is_reading_ || pipe->is_closed_)
+  if (pipe->is_reading_ || pipe->is_closed_ || pipe->kernel_offload_)
     return;
   HandleScope handle_scope(pipe->env()->isolate());
   InternalCallbackScope callback_scope(pipe,
@@ -228,6 +239,146 @@ void StreamPipe::WritableListener::OnStreamRead(ssize_t nread,
   return previous_listener_->OnStreamRead(nread, buf);
 }
 
+struct StreamPipe::OffloadPoll {
+  uv_poll_t handle;
+  int fd;  // dup() of the socket fd; watched for writability.
+  StreamPipe* pipe;
+};
+
+bool StreamPipe::TryStartKernelOffload() {
+#ifdef __linux__
+  AsyncWrap* source_wrap = source()->GetAsyncWrap();
+  AsyncWrap* sink_wrap = sink()->GetAsyncWrap();
+  if (source_wrap == nullptr || sink_wrap == nullptr ||
+      source_wrap->provider_type() != AsyncWrap::PROVIDER_FILEHANDLE ||
+      sink_wrap->provider_type() != AsyncWrap::PROVIDER_TCPWRAP) {
+    return false;
+  }
+
+  fs::FileHandle* handle = static_cast<fs::FileHandle*>(source());
+  const int in_fd = handle->fd();
+  const int out_fd = sink()->GetFD();
+  if (in_fd < 0 || out_fd < 0) return false;
+
+  struct stat in_stat;
+  struct stat out_stat;
+  if (fstat(in_fd, &in_stat) != 0 || !S_ISREG(in_stat.st_mode) ||
+      fstat(out_fd, &out_stat) != 0 || !S_ISSOCK(out_stat.st_mode)) {
+    return false;
+  }
+
+  // The socket fd is owned by the uv_tcp_t handle; watch a dup() of it for
+  // writability so that libuv does not see the same fd twice.
+  int poll_fd = dup(out_fd);
+  if (poll_fd < 0) return false;
+
+  OffloadPoll* poll = new OffloadPoll();
+  if (uv_poll_init(env()->event_loop(), &poll->handle, poll_fd) != 0) {
+    close(poll_fd);
+    delete poll;
+    return false;
+  }
+  poll->fd = poll_fd;
+  poll->pipe = this;
+  offload_poll_ = poll;
+  kernel_offload_ = true;
+
+  DoKernelOffload();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void StreamPipe::DoKernelOffload() {
+#ifdef __linux__
+  fs::FileHandle* handle = static_cast<fs::FileHandle*>(source());
+  constexpr size_t kSendfileChunk = 1 << 20;  // 1 Mb per sendfile(2) call
+
+  for (;;) {
+    const int64_t read_length = handle->read_length_;
+    if (read_length == 0)
+      return FinishKernelOffload(0);
+
+    size_t count = kSendfileChunk;
+    if (read_length > 0 && static_cast<size_t>(read_length) < count)
+      count = static_cast<size_t>(read_length);
+
+    const int64_t read_offset = handle->read_offset_;
+    off_t offset = read_offset;
+    ssize_t n = sendfile(sink()->GetFD(),
+                         handle->fd(),
+                         read_offset >= 0 ? &offset : nullptr,
+                         count);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Socket send buffer is full; resume once it drains.
+        uv_poll_start(&offload_poll_->handle, UV_WRITABLE, AfterOffloadPoll);
+        return;
+      }
+      return FinishKernelOffload(uv_translate_sys_error(errno));
+    }
+
+    if (n == 0)  // EOF
+      return FinishKernelOffload(0);
+
+    if (read_offset >= 0)
+      handle->read_offset_ = offset;
+    if (read_length > 0)
+      handle->read_length_ = read_length - n;
+  }
+#endif
+}
+
+void StreamPipe::FinishKernelOffload(int status) {
+#ifdef __linux__
+  StopKernelOffload();
+
+  // Deliver EOF (or the error) exactly like the copy loop would; this stops
+  // the source, shuts down the sink and unpipes.
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  readable_listener_.OnStreamRead(status == 0 ? UV_EOF : status,
+                                  uv_buf_init(nullptr, 0));
+#endif
+}
+
+void StreamPipe::StopKernelOffload() {
+  if (offload_poll_ == nullptr) return;
+  kernel_offload_ = false;
+  OffloadPoll* poll = offload_poll_;
+  offload_poll_ = nullptr;
+  poll->pipe = nullptr;
+  uv_close(reinterpret_cast<uv_handle_t*>(&poll->handle), [](uv_handle_t* h) {
+    OffloadPoll* poll =
+        ContainerOf(&OffloadPoll::handle, reinterpret_cast<uv_poll_t*>(h));
+#ifdef __linux__
+    close(poll->fd);
+#endif
+    delete poll;
+  });
+}
+
+void StreamPipe::AfterOffloadPoll(uv_poll_t* handle, int status, int events) {
+#ifdef __linux__
+  OffloadPoll* poll = ContainerOf(&OffloadPoll::handle, handle);
+  StreamPipe* pipe = poll->pipe;
+  if (pipe == nullptr) return;
+  uv_poll_stop(handle);
+
+  HandleScope handle_scope(pipe->env()->isolate());
+  Context::Scope context_scope(pipe->env()->context());
+  InternalCallbackScope callback_scope(pipe,
+      InternalCallbackScope::kSkipTaskQueues);
+
+  if (status < 0)
+    pipe->FinishKernelOffload(status);
+  else
+    pipe->DoKernelOffload();
+#endif
+}
+
 void StreamPipe::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   CHECK(args[0]->IsObject());
@@ -242,6 +393,8 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+  if (pipe->TryStartKernelOffload())
+    return;
   if (pipe->wanted_data_ > 0)
     pipe->writable_listener_.OnStreamWantsWrite(pipe->wanted_data_);
 }
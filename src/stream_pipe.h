@@ -43,6 +43,20 @@ class StreamPipe : public AsyncWrap {
 
   void ProcessData(size_t nread, AllocatedBuffer&& buf);
 
+  // Kernel-offload mode: when the source is a FileHandle and the sink is a
+  // TCP socket, payload bytes are moved with sendfile(2) and never enter
+  // userspace. Only supported on Linux; everywhere else (and for all other
+  // stream combinations) the regular copy loop above is used.
+  struct OffloadPoll;
+  bool TryStartKernelOffload();
+  void DoKernelOffload();
+  void FinishKernelOffload(int status);
+  void StopKernelOffload();
+  static void AfterOffloadPoll(uv_poll_t* handle, int status, int events);
+
+  bool kernel_offload_ = false;
+  OffloadPoll* offload_poll_ = nullptr;
+
   class ReadableListener : public StreamListener {
    public:
     uv_buf_t OnStreamAlloc(size_t suggested_size) override;
@@ -148,6 +148,7 @@ Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
         Local<FunctionTemplate>(),
         static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     env->SetProtoMethod(tmpl, "setBlocking", SetBlocking);
+    env->SetProtoMethod(tmpl, "setReadBatching", SetReadBatching);
     StreamBase::AddMethods(env, tmpl);
     env->set_libuv_stream_wrap_ctor_template(tmpl);
   }
@@ -195,6 +196,7 @@ bool LibuvStreamWrap::IsIPCPipe() {
 
 
 int LibuvStreamWrap::ReadStart() {
+  reading_paused_by_gc_ = false;
   return uv_read_start(stream(), [](uv_handle_t* handle,
                                     size_t suggested_size,
                                     uv_buf_t* buf) {
@@ -206,6 +208,7 @@ int LibuvStreamWrap::ReadStart() {
 
 
 int LibuvStreamWrap::ReadStop() {
+  reading_paused_by_gc_ = false;
   return uv_read_stop(stream());
 }
 
@@ -214,6 +217,29 @@ void LibuvStreamWrap::OnUvAlloc(size_t suggested_size, uv_buf_t* buf) {
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
 
+  // Backpressure from the garbage collector: while the collector is under
+  // pressure, shrink read buffers so that ingest allocates less during
+  // marking; under critical pressure additionally stop reading until the
+  // collector has caught up, letting the kernel socket buffer absorb the
+  // backlog instead of the JS heap.
+  const uint32_t pressure = env()->gc_pressure_level();
+  if (pressure >= Environment::kGCPressureModerate) {
+    suggested_size = std::min(suggested_size, size_t{16 * 1024});
+    if (pressure >= Environment::kGCPressureCritical &&
+        !reading_paused_by_gc_) {
+      ReadStop();
+      reading_paused_by_gc_ = true;
+      BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+      env()->OnGCPressureRelieved([this, strong_ref]() {
+        if (!reading_paused_by_gc_)
+          return;  // Explicitly stopped (or resumed) from JS meanwhile.
+        reading_paused_by_gc_ = false;
+        if (IsAlive())
+          ReadStart();
+      });
+    }
+  }
+
   *buf = EmitAlloc(suggested_size);
 }
 
@@ -247,6 +273,9 @@ void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
   Context::Scope context_scope(env()->context());
   uv_handle_type type = UV_UNKNOWN_HANDLE;
 
+  if (latency_critical_ && nread > 0)
+    env()->NoteBusyPollActivity();
+
   if (is_named_pipe_ipc() &&
       uv_pipe_pending_count(reinterpret_cast<uv_pipe_t*>(stream())) > 0) {
     type = uv_pipe_pending_type(reinterpret_cast<uv_pipe_t*>(stream()));
@@ -256,6 +285,16 @@ void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
   // uv_close() on the handle.
   CHECK_EQ(persistent().IsEmpty(), false);
 
+  if (read_batching_ && type == UV_UNKNOWN_HANDLE) {
+    if (nread > 0) {
+      AppendToReadBatch(nread, buf);
+      return;
+    }
+    // Deliver all batched data before EOF or errors so that ordering is
+    // preserved for the JS consumer.
+    FlushReadBatch();
+  }
+
   if (nread > 0) {
     MaybeLocal<Object> pending_obj;
 
@@ -282,6 +321,63 @@ void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
 }
 
 
+void LibuvStreamWrap::AppendToReadBatch(ssize_t nread, const uv_buf_t* buf) {
+  // Take ownership of the buffer that was handed out by EmitAlloc(); its
+  // contents are copied into the accumulation buffer and it is freed when
+  // this function returns.
+  AllocatedBuffer chunk(env(), *buf);
+  const size_t size = static_cast<size_t>(nread);
+
+  if (read_batch_.data() == nullptr) {
+    read_batch_ = env()->AllocateManaged(std::max<size_t>(size, 64 * 1024));
+  } else if (read_batch_.size() - read_batch_len_ < size) {
+    read_batch_.Resize(
+        std::max(read_batch_.size() * 2, read_batch_len_ + size));
+  }
+  memcpy(read_batch_.data() + read_batch_len_, buf->base, size);
+  read_batch_len_ += size;
+
+  if (!read_batch_scheduled_) {
+    read_batch_scheduled_ = true;
+    BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+    env()->SetImmediate([this, strong_ref](Environment* env) {
+      FlushReadBatch();
+    });
+  }
+}
+
+void LibuvStreamWrap::FlushReadBatch() {
+  read_batch_scheduled_ = false;
+  if (read_batch_len_ == 0)
+    return;
+
+  HandleScope scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  AllocatedBuffer batch = std::move(read_batch_);
+  const size_t len = read_batch_len_;
+  read_batch_len_ = 0;
+
+  if (persistent().IsEmpty())
+    return;
+
+  batch.Resize(len);
+  EmitRead(len, batch.release());
+}
+
+void LibuvStreamWrap::SetReadBatching(const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK_GT(args.Length(), 0);
+  bool enable = args[0]->IsTrue();
+  if (!enable && wrap->read_batching_) {
+    // Hand any accumulated data to JS before turning batching off.
+    wrap->FlushReadBatch();
+  }
+  wrap->read_batching_ = enable;
+}
+
 void LibuvStreamWrap::GetWriteQueueSize(
     const FunctionCallbackInfo<Value>& info) {
   LibuvStreamWrap* wrap;
@@ -313,11 +409,11 @@ typedef SimpleShutdownWrap<ReqWrap<uv_shutdown_t>> LibuvShutdownWrap;
 typedef SimpleWriteWrap<ReqWrap<uv_write_t>> LibuvWriteWrap;
 
 ShutdownWrap* LibuvStreamWrap::CreateShutdownWrap(Local<Object> object) {
-  return new LibuvShutdownWrap(this, object);
+  return new (env()) LibuvShutdownWrap(this, object);
 }
 
 WriteWrap* LibuvStreamWrap::CreateWriteWrap(Local<Object> object) {
-  return new LibuvWriteWrap(this, object);
+  return new (env()) LibuvWriteWrap(this, object);
 }
 
 
@@ -78,6 +78,18 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   static LibuvStreamWrap* From(Environment* env, v8::Local<v8::Object> object);
 
+  // Opt-in batched read delivery: reads that arrive within one loop
+  // iteration are accumulated into a single buffer and emitted in one
+  // onread call during the check phase, amortizing the C++→JS transition
+  // cost for high-frequency small reads. Only valid for plain byte streams
+  // that are read through the default JS stream listener; chunk boundaries
+  // within one iteration are not preserved.
+  static void SetReadBatching(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Streams marked latency-critical feed the loop's busy-poll window (see
+  // Environment::NoteBusyPollActivity()) whenever data arrives on them.
+  inline void set_latency_critical(bool on) { latency_critical_ = on; }
+
  protected:
   LibuvStreamWrap(Environment* env,
                   v8::Local<v8::Object> object,
@@ -109,8 +121,23 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
 
+  // Read batching state, see SetReadBatching().
+  void AppendToReadBatch(ssize_t nread, const uv_buf_t* buf);
+  void FlushReadBatch();
+
   uv_stream_t* const stream_;
 
+  bool latency_critical_ = false;
+  bool read_batching_ = false;
+  bool read_batch_scheduled_ = false;
+  size_t read_batch_len_ = 0;
+  AllocatedBuffer read_batch_;
+
+  // Set while reading has been stopped because of critical GC pressure,
+  // see OnUvAlloc(). Cleared by any ReadStop() so that an explicit stop
+  // from JS cancels the scheduled resume.
+  bool reading_paused_by_gc_ = false;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
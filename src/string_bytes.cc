@@ -25,6 +25,7 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "node_simd.h"
 #include "util.h"
 
 #include <climits>
@@ -244,13 +245,252 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+
+// Vectorized hex kernels with runtime dispatch, in the same style as the
+// base64 ones in base64.cc. The encoder translates both nibbles through a
+// 16-byte table lookup and interleaves them; the decoder classifies the
+// characters with byte-wise range compares and bails out to the scalar
+// loop on the first block containing anything but [0-9A-Fa-f]. Both
+// return how much they processed (input bytes for the encoder, output
+// bytes for the decoder); the scalar loops finish the remainder.
+
+using HexEncodeFn = size_t (*)(char* dst, const char* src, size_t slen);
+using HexDecodeFn = size_t (*)(char* buf, size_t len,
+                               const char* src, size_t srclen);
+
+#ifndef NODE_SIMD_NEON
+// Fallback for CPUs (or architectures) without a suitable kernel.
+static size_t hex_encode_none(char*, const char*, size_t) {
+  return 0;
+}
+
+static size_t hex_decode_none(char*, size_t, const char*, size_t) {
+  return 0;
+}
+#endif  // !NODE_SIMD_NEON
+
+#ifdef NODE_SIMD_X86
+
+NODE_TARGET_SSSE3
+static size_t hex_encode_ssse3(char* dst, const char* src, size_t slen) {
+  const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  size_t i = 0;
+  while (i + 16 <= slen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0F));
+    const __m128i lo = _mm_and_si128(in, _mm_set1_epi8(0x0F));
+    const __m128i hex_hi = _mm_shuffle_epi8(lut, hi);
+    const __m128i hex_lo = _mm_shuffle_epi8(lut, lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2),
+                     _mm_unpacklo_epi8(hex_hi, hex_lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16),
+                     _mm_unpackhi_epi8(hex_hi, hex_lo));
+    i += 16;
+  }
+  return i;
+}
+
+NODE_TARGET_AVX2
+static size_t hex_encode_avx2(char* dst, const char* src, size_t slen) {
+  const __m256i lut = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  size_t i = 0;
+  while (i + 32 <= slen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi =
+        _mm256_and_si256(_mm256_srli_epi32(in, 4), _mm256_set1_epi8(0x0F));
+    const __m256i lo = _mm256_and_si256(in, _mm256_set1_epi8(0x0F));
+    const __m256i hex_hi = _mm256_shuffle_epi8(lut, hi);
+    const __m256i hex_lo = _mm256_shuffle_epi8(lut, lo);
+    // The unpacks interleave within 128-bit lanes; the cross-lane
+    // permutes restore the original byte order.
+    const __m256i ilv_lo = _mm256_unpacklo_epi8(hex_hi, hex_lo);
+    const __m256i ilv_hi = _mm256_unpackhi_epi8(hex_hi, hex_lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2),
+                        _mm256_permute2x128_si256(ilv_lo, ilv_hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32),
+                        _mm256_permute2x128_si256(ilv_lo, ilv_hi, 0x31));
+    i += 32;
+  }
+  return i;
+}
+
+NODE_TARGET_SSSE3
+static size_t hex_decode_ssse3(char* buf, size_t len,
+                               const char* src, size_t srclen) {
+  size_t i = 0;
+  while (i + 8 <= len && i * 2 + 16 <= srclen) {
+    const __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    const __m128i lc = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    // Bytes >= 0x80 are negative in the signed compares and classify as
+    // neither digit nor letter, as intended.
+    const __m128i digit =
+        _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    const __m128i alpha =
+        _mm_and_si128(_mm_cmpgt_epi8(lc, _mm_set1_epi8('a' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lc));
+    if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xFFFF)
+      break;
+    const __m128i val = _mm_or_si128(
+        _mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+        _mm_and_si128(alpha, _mm_sub_epi8(lc, _mm_set1_epi8('a' - 10))));
+    // Combine nibble pairs: high * 16 + low.
+    const __m128i packed =
+        _mm_maddubs_epi16(val, _mm_set1_epi16(0x0110));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(buf + i),
+                     _mm_packus_epi16(packed, packed));
+    i += 8;
+  }
+  return i;
+}
+
+NODE_TARGET_AVX2
+static size_t hex_decode_avx2(char* buf, size_t len,
+                              const char* src, size_t srclen) {
+  size_t i = 0;
+  while (i + 16 <= len && i * 2 + 32 <= srclen) {
+    const __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+    const __m256i lc = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i alpha =
+        _mm256_and_si256(_mm256_cmpgt_epi8(lc, _mm256_set1_epi8('a' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lc));
+    if (_mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) != -1)
+      break;
+    const __m256i val = _mm256_or_si256(
+        _mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+        _mm256_and_si256(alpha,
+                         _mm256_sub_epi8(lc, _mm256_set1_epi8('a' - 10))));
+    const __m256i packed =
+        _mm256_maddubs_epi16(val, _mm256_set1_epi16(0x0110));
+    // packus duplicates per lane; select qwords 0 and 2 to compact.
+    const __m256i bytes = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(packed, packed), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i),
+                     _mm256_castsi256_si128(bytes));
+    i += 16;
+  }
+  return i;
+}
+
+#endif  // NODE_SIMD_X86
+
+#ifdef NODE_SIMD_NEON
+
+static size_t hex_encode_neon(char* dst, const char* src, size_t slen) {
+  static const uint8_t kHexTable[16] = {
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+  const uint8x16_t lut = vld1q_u8(kHexTable);
+  size_t i = 0;
+  while (i + 16 <= slen) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x2_t out;
+    out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+    out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, vdupq_n_u8(0x0F)));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dst + i * 2), out);
+    i += 16;
+  }
+  return i;
+}
+
+static size_t hex_decode_neon(char* buf, size_t len,
+                              const char* src, size_t srclen) {
+  size_t i = 0;
+  while (i + 16 <= len && i * 2 + 32 <= srclen) {
+    // The deinterleaving load separates high and low nibble characters.
+    const uint8x16x2_t c =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(src + i * 2));
+    uint8x16_t val[2];
+    uint8x16_t valid = vdupq_n_u8(0xFF);
+    for (int j = 0; j < 2; j++) {
+      const uint8x16_t ch = c.val[j];
+      const uint8x16_t lc = vorrq_u8(ch, vdupq_n_u8(0x20));
+      const uint8x16_t digit = vandq_u8(vcgeq_u8(ch, vdupq_n_u8('0')),
+                                        vcleq_u8(ch, vdupq_n_u8('9')));
+      const uint8x16_t alpha = vandq_u8(vcgeq_u8(lc, vdupq_n_u8('a')),
+                                        vcleq_u8(lc, vdupq_n_u8('f')));
+      valid = vandq_u8(valid, vorrq_u8(digit, alpha));
+      val[j] = vorrq_u8(vandq_u8(digit, vsubq_u8(ch, vdupq_n_u8('0'))),
+                        vandq_u8(alpha, vsubq_u8(lc, vdupq_n_u8('a' - 10))));
+    }
+    if (vminvq_u8(valid) != 0xFF)
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(buf + i),
+             vorrq_u8(vshlq_n_u8(val[0], 4), val[1]));
+    i += 16;
+  }
+  return i;
+}
+
+#endif  // NODE_SIMD_NEON
+
+static HexEncodeFn ResolveHexEncode() {
+#if defined(NODE_SIMD_X86)
+  if (simd::cpu_has_avx2())
+    return hex_encode_avx2;
+  if (simd::cpu_has_ssse3())
+    return hex_encode_ssse3;
+  return hex_encode_none;
+#elif defined(NODE_SIMD_NEON)
+  return hex_encode_neon;
+#else
+  return hex_encode_none;
+#endif
+}
+
+static HexDecodeFn ResolveHexDecode() {
+#if defined(NODE_SIMD_X86)
+  if (simd::cpu_has_avx2())
+    return hex_decode_avx2;
+  if (simd::cpu_has_ssse3())
+    return hex_decode_ssse3;
+  return hex_decode_none;
+#elif defined(NODE_SIMD_NEON)
+  return hex_decode_neon;
+#else
+  return hex_decode_none;
+#endif
+}
+
+static size_t hex_encode_simd(char* dst, const char* src, size_t slen) {
+  static const HexEncodeFn encode = ResolveHexEncode();
+  return encode(dst, src, slen);
+}
+
+// Only one-byte input has a vectorized decoder; the two-byte (UCS-2)
+// instantiation of hex_decode() goes straight to the scalar loop.
+static inline size_t hex_decode_simd(char* buf, size_t len,
+                                     const char* src, size_t srclen) {
+  static const HexDecodeFn decode = ResolveHexDecode();
+  return decode(buf, len, src, srclen);
+}
+
+template <typename TypeName>
+static inline size_t hex_decode_simd(char*, size_t,
+                                     const TypeName*, size_t) {
+  return 0;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
-  size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  size_t i = hex_decode_simd(buf, len, src, srcLen);
+  for (; i < len && i * 2 + 1 < srcLen; ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -593,7 +833,8 @@ static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  size_t i = hex_encode_simd(dst, src, slen);
+  for (size_t k = i * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -604,6 +845,36 @@ static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
 }
 
 
+// Reusable per-thread scratch space for encode temporaries (forced-ASCII,
+// base64, hex and byte-swapped UCS-2 output) that are only needed until
+// the V8 string has been created. Results of EXTERN_APEX bytes or more
+// are externalized and keep their own allocation, so the scratch buffer
+// never needs to grow past that; smaller results previously paid a
+// malloc/free pair per Encode() call. Encode() always runs on a thread
+// with a live isolate, so thread-local storage gives us per-thread reuse
+// without threading an Environment* through StringBytes.
+static char* encode_scratch(size_t size) {
+  struct Scratch {
+    char* data = nullptr;
+    size_t size = 0;
+    ~Scratch() { free(data); }
+  };
+  static thread_local Scratch scratch;
+
+  if (size >= EXTERN_APEX)
+    return nullptr;
+  if (size > scratch.size) {
+    size_t new_size = std::max(scratch.size * 2, size);
+    if (new_size > EXTERN_APEX)
+      new_size = EXTERN_APEX;
+    free(scratch.data);
+    scratch.data = node::UncheckedMalloc(new_size);
+    scratch.size = scratch.data == nullptr ? 0 : new_size;
+  }
+  return scratch.data;
+}
+
+
 #define CHECK_BUFLEN_IN_RANGE(len)                                    \
   do {                                                                \
     if ((len) > Buffer::kMaxLength) {                                 \
@@ -643,6 +914,10 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case ASCII:
       if (contains_non_ascii(buf, buflen)) {
+        if (char* out = encode_scratch(buflen)) {
+          force_ascii(buf, out, buflen);
+          return ExternOneByteString::NewFromCopy(isolate, out, buflen, error);
+        }
         char* out = node::UncheckedMalloc(buflen);
         if (out == nullptr) {
           *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -670,6 +945,11 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case BASE64: {
       size_t dlen = base64_encoded_size(buflen);
+      if (char* dst = encode_scratch(dlen)) {
+        size_t written = base64_encode(buf, buflen, dst, dlen);
+        CHECK_EQ(written, dlen);
+        return ExternOneByteString::NewFromCopy(isolate, dst, dlen, error);
+      }
       char* dst = node::UncheckedMalloc(dlen);
       if (dst == nullptr) {
         *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -684,6 +964,11 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case HEX: {
       size_t dlen = buflen * 2;
+      if (char* dst = encode_scratch(dlen)) {
+        size_t written = hex_encode(buf, buflen, dst, dlen);
+        CHECK_EQ(written, dlen);
+        return ExternOneByteString::NewFromCopy(isolate, dst, dlen, error);
+      }
       char* dst = node::UncheckedMalloc(dlen);
       if (dst == nullptr) {
         *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -697,6 +982,17 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case UCS2: {
       if (IsBigEndian()) {
+        // malloc() results are suitably aligned for uint16_t.
+        if (uint16_t* dst =
+                reinterpret_cast<uint16_t*>(encode_scratch(buflen))) {
+          for (size_t i = 0, k = 0; k < buflen / 2; i += 2, k += 1) {
+            const uint8_t hi = static_cast<uint8_t>(buf[i + 1]);
+            const uint8_t lo = static_cast<uint8_t>(buf[i + 0]);
+            dst[k] = static_cast<uint16_t>(hi) << 8 | lo;
+          }
+          return ExternTwoByteString::NewFromCopy(
+              isolate, dst, buflen / 2, error);
+        }
         uint16_t* dst = node::UncheckedMalloc<uint16_t>(buflen / 2);
         if (dst == nullptr) {
           *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -713,6 +1009,11 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
       }
       if (reinterpret_cast<uintptr_t>(buf) % 2 != 0) {
         // Unaligned data still means we can't directly pass it to V8.
+        if (char* dst = encode_scratch(buflen)) {
+          memcpy(dst, buf, buflen);
+          return ExternTwoByteString::NewFromCopy(
+              isolate, reinterpret_cast<uint16_t*>(dst), buflen / 2, error);
+        }
         char* dst = node::UncheckedMalloc(buflen);
         if (dst == nullptr) {
           *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -746,12 +1047,17 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
   // https://nodejs.org/api/buffer.html regarding Node's "ucs2"
   // encoding specification
   if (IsBigEndian()) {
+    size_t nbytes = buflen * sizeof(uint16_t);
+    if (uint16_t* dst = reinterpret_cast<uint16_t*>(encode_scratch(nbytes))) {
+      memcpy(dst, buf, nbytes);
+      SwapBytes16(reinterpret_cast<char*>(dst), nbytes);
+      return ExternTwoByteString::NewFromCopy(isolate, dst, buflen, error);
+    }
     uint16_t* dst = node::UncheckedMalloc<uint16_t>(buflen);
     if (dst == nullptr) {
       *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
       return MaybeLocal<Value>();
     }
-    size_t nbytes = buflen * sizeof(uint16_t);
     memcpy(dst, buf, nbytes);
     SwapBytes16(reinterpret_cast<char*>(dst), nbytes);
     return ExternTwoByteString::New(isolate, dst, buflen, error);
@@ -3,6 +3,7 @@
 
 #include "env-inl.h"
 #include "node_buffer.h"
+#include "node_simd.h"
 #include "string_bytes.h"
 #include "util.h"
 
@@ -22,6 +23,36 @@ namespace node {
 
 namespace {
 
+// Returns true if |data| contains only 7-bit bytes. For such chunks UTF-8
+// decoding is the identity, so the one-byte string constructor can be used
+// directly instead of having V8 run its UTF-8 decoder over the data. Stream
+// decoding of predominantly-ASCII input (e.g. JSON lines, HTTP bodies)
+// hits this path for nearly every chunk. SSE2 is part of the baseline on
+// x86, so no runtime dispatch is needed.
+#ifdef NODE_SIMD_X86
+NODE_TARGET_SSE2
+#endif
+bool IsAscii(const char* data, size_t length) {
+  size_t i = 0;
+#ifdef NODE_SIMD_X86
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16) {
+    acc = _mm_or_si128(
+        acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+  }
+  if (_mm_movemask_epi8(acc) != 0) return false;
+#elif defined(NODE_SIMD_NEON)
+  uint8x16_t acc = vdupq_n_u8(0);
+  for (; i + 16 <= length; i += 16) {
+    acc = vorrq_u8(acc, vld1q_u8(reinterpret_cast<const uint8_t*>(data + i)));
+  }
+  if (vmaxvq_u8(acc) >= 0x80) return false;
+#endif
+  uint8_t tail = 0;
+  for (; i < length; i++) tail |= static_cast<uint8_t>(data[i]);
+  return (tail & 0x80) == 0;
+}
+
 MaybeLocal<String> MakeString(Isolate* isolate,
                               const char* data,
                               size_t length,
@@ -29,6 +60,13 @@ MaybeLocal<String> MakeString(Isolate* isolate,
   Local<Value> error;
   MaybeLocal<Value> ret;
   if (encoding == UTF8) {
+    if (IsAscii(data, length)) {
+      return String::NewFromOneByte(
+          isolate,
+          reinterpret_cast<const uint8_t*>(data),
+          v8::NewStringType::kNormal,
+          length);
+    }
     return String::NewFromUtf8(
         isolate,
         data,
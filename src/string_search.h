@@ -7,6 +7,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_simd.h"
 #include "util.h"
 
 #include <cstring>
@@ -85,6 +86,135 @@ class StringSearchBase {
   int suffix_table_[kBMMaxShift + 1];
 };
 
+#if defined(NODE_SIMD_X86) || defined(NODE_SIMD_NEON)
+
+// SIMD candidate filter for one-byte forward searches: scans for
+// positions where both the first and the last needle byte line up and
+// verifies the bytes in between with memcmp. Filtering on two bytes
+// keeps the verifier off the hot path even when the needle starts with
+// a byte that is common in the haystack (where a plain memchr skip loop
+// degrades to a match attempt per occurrence). Requires needle_length
+// >= 2 and needle_length <= haystack_length.
+
+#ifdef NODE_SIMD_X86
+
+NODE_TARGET_AVX2
+inline size_t SimdSearchAvx2(const uint8_t* haystack, size_t haystack_length,
+                             const uint8_t* needle, size_t needle_length,
+                             size_t index) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[needle_length - 1]);
+  size_t i = index;
+  // The second load reads needle_length - 1 bytes past the last tested
+  // position, so stay a full vector short of the end of the haystack.
+  while (i + needle_length + 31 <= haystack_length) {
+    const __m256i b0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+        haystack + i + needle_length - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(b0, first), _mm256_cmpeq_epi8(b1, last)));
+    while (mask != 0) {
+      const size_t pos = i + simd::CountTrailingZeros32(mask);
+      if (memcmp(haystack + pos + 1, needle + 1, needle_length - 2) == 0)
+        return pos;
+      mask &= mask - 1;
+    }
+    i += 32;
+  }
+  for (; i + needle_length <= haystack_length; i++) {
+    if (haystack[i] == needle[0] &&
+        memcmp(haystack + i + 1, needle + 1, needle_length - 1) == 0) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
+
+NODE_TARGET_SSE2
+inline size_t SimdSearchSse2(const uint8_t* haystack, size_t haystack_length,
+                             const uint8_t* needle, size_t needle_length,
+                             size_t index) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[needle_length - 1]);
+  size_t i = index;
+  while (i + needle_length + 15 <= haystack_length) {
+    const __m128i b0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+        haystack + i + needle_length - 1));
+    uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(b0, first), _mm_cmpeq_epi8(b1, last)));
+    while (mask != 0) {
+      const size_t pos = i + simd::CountTrailingZeros32(mask);
+      if (memcmp(haystack + pos + 1, needle + 1, needle_length - 2) == 0)
+        return pos;
+      mask &= mask - 1;
+    }
+    i += 16;
+  }
+  for (; i + needle_length <= haystack_length; i++) {
+    if (haystack[i] == needle[0] &&
+        memcmp(haystack + i + 1, needle + 1, needle_length - 1) == 0) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
+
+#else  // NODE_SIMD_NEON
+
+inline size_t SimdSearchNeon(const uint8_t* haystack, size_t haystack_length,
+                             const uint8_t* needle, size_t needle_length,
+                             size_t index) {
+  const uint8x16_t first = vdupq_n_u8(needle[0]);
+  const uint8x16_t last = vdupq_n_u8(needle[needle_length - 1]);
+  size_t i = index;
+  while (i + needle_length + 15 <= haystack_length) {
+    const uint8x16_t eq = vandq_u8(
+        vceqq_u8(vld1q_u8(haystack + i), first),
+        vceqq_u8(vld1q_u8(haystack + i + needle_length - 1), last));
+    // Narrowing shift produces a 64-bit mask with one nibble per lane,
+    // the usual movemask substitute on aarch64.
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    while (mask != 0) {
+      const int bit = __builtin_ctzll(mask);
+      const size_t pos = i + (bit >> 2);
+      if (memcmp(haystack + pos + 1, needle + 1, needle_length - 2) == 0)
+        return pos;
+      mask &= ~(UINT64_C(0xF) << bit);
+    }
+    i += 16;
+  }
+  for (; i + needle_length <= haystack_length; i++) {
+    if (haystack[i] == needle[0] &&
+        memcmp(haystack + i + 1, needle + 1, needle_length - 1) == 0) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
+
+#endif  // NODE_SIMD_X86
+
+inline size_t SimdSearch(const uint8_t* haystack, size_t haystack_length,
+                         const uint8_t* needle, size_t needle_length,
+                         size_t index) {
+#ifdef NODE_SIMD_X86
+  using SearchFn = size_t (*)(const uint8_t*, size_t,
+                              const uint8_t*, size_t, size_t);
+  static const SearchFn search =
+      simd::cpu_has_avx2() ? SimdSearchAvx2 : SimdSearchSse2;
+  return search(haystack, haystack_length, needle, needle_length, index);
+#else
+  return SimdSearchNeon(haystack, haystack_length,
+                        needle, needle_length, index);
+#endif
+}
+
+#endif  // defined(NODE_SIMD_X86) || defined(NODE_SIMD_NEON)
+
 template <typename Char>
 class StringSearch : private StringSearchBase {
  public:
@@ -110,6 +240,19 @@ class StringSearch : private StringSearchBase {
   }
 
   size_t Search(Vector subject, size_t index) {
+#if defined(NODE_SIMD_X86) || defined(NODE_SIMD_NEON)
+    // One-byte forward searches go through the SIMD candidate filter;
+    // the table-driven strategies remain for two-byte characters,
+    // reverse searches and short subjects.
+    if (sizeof(Char) == 1 && subject.forward() && pattern_.length() >= 2 &&
+        subject.length() >= 64) {
+      return SimdSearch(reinterpret_cast<const uint8_t*>(subject.start()),
+                        subject.length(),
+                        reinterpret_cast<const uint8_t*>(pattern_.start()),
+                        pattern_.length(),
+                        index);
+    }
+#endif
     return (this->*strategy_)(subject, index);
   }
 
@@ -566,6 +709,124 @@ size_t SearchString(Vector<const Char> subject,
   StringSearch<Char> search(pattern);
   return search.Search(subject, start_index);
 }
+
+//---------------------------------------------------------------------
+// Multi-needle search.
+//---------------------------------------------------------------------
+
+// A needle for SearchStringMulti(). Byte-level only: multi-needle
+// searches operate on the raw buffer contents regardless of encoding.
+struct MultiPattern {
+  const uint8_t* data;
+  size_t length;
+};
+
+// Needle count limit; the candidate sets below are uint32_t bitmasks.
+const size_t kMaxMultiNeedles = 32;
+
+// Tries every needle whose bit is set in `candidates`, lowest index
+// first, so ties at the same offset resolve to the first needle given.
+inline bool MultiSearchVerify(const uint8_t* haystack, size_t haystack_length,
+                              const MultiPattern* needles, uint32_t candidates,
+                              size_t pos, size_t* needle_index) {
+  while (candidates != 0) {
+    const uint32_t j = simd::CountTrailingZeros32(candidates);
+    candidates &= candidates - 1;
+    const MultiPattern& p = needles[j];
+    if (pos + p.length <= haystack_length &&
+        memcmp(haystack + pos, p.data, p.length) == 0) {
+      *needle_index = j;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Finds the earliest occurrence of any of the given needles in a single
+// forward pass over the haystack. Returns the match offset and stores
+// the needle's index in *needle_index, or returns haystack_length if
+// nothing matched. Positions are scanned with a vectorized compare
+// against every needle's first byte where available; candidates are
+// verified through the first-byte table. SSE2 is baseline for every x86
+// target this tree supports, so no runtime dispatch is needed here.
+NODE_TARGET_SSE2
+inline size_t SearchStringMulti(const uint8_t* haystack,
+                                size_t haystack_length,
+                                const MultiPattern* needles,
+                                size_t n_needles,
+                                size_t start_index,
+                                size_t* needle_index) {
+  CHECK_GT(n_needles, 0);
+  CHECK_LE(n_needles, kMaxMultiNeedles);
+
+  uint32_t first_byte_mask[256];
+  memset(first_byte_mask, 0, sizeof(first_byte_mask));
+  size_t min_length = needles[0].length;
+  for (size_t j = 0; j < n_needles; j++) {
+    CHECK_GT(needles[j].length, 0);
+    first_byte_mask[needles[j].data[0]] |= UINT32_C(1) << j;
+    min_length = std::min(min_length, needles[j].length);
+  }
+
+  size_t i = start_index;
+
+#if defined(NODE_SIMD_X86)
+  __m128i first_bytes[kMaxMultiNeedles];
+  for (size_t j = 0; j < n_needles; j++)
+    first_bytes[j] = _mm_set1_epi8(needles[j].data[0]);
+  while (i + 16 <= haystack_length) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    __m128i any = _mm_cmpeq_epi8(block, first_bytes[0]);
+    for (size_t j = 1; j < n_needles; j++)
+      any = _mm_or_si128(any, _mm_cmpeq_epi8(block, first_bytes[j]));
+    uint32_t mask = _mm_movemask_epi8(any);
+    while (mask != 0) {
+      const size_t pos = i + simd::CountTrailingZeros32(mask);
+      mask &= mask - 1;
+      if (MultiSearchVerify(haystack, haystack_length, needles,
+                            first_byte_mask[haystack[pos]], pos,
+                            needle_index)) {
+        return pos;
+      }
+    }
+    i += 16;
+  }
+#elif defined(NODE_SIMD_NEON)
+  uint8x16_t first_bytes[kMaxMultiNeedles];
+  for (size_t j = 0; j < n_needles; j++)
+    first_bytes[j] = vdupq_n_u8(needles[j].data[0]);
+  while (i + 16 <= haystack_length) {
+    const uint8x16_t block = vld1q_u8(haystack + i);
+    uint8x16_t any = vceqq_u8(block, first_bytes[0]);
+    for (size_t j = 1; j < n_needles; j++)
+      any = vorrq_u8(any, vceqq_u8(block, first_bytes[j]));
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(any), 4)), 0);
+    while (mask != 0) {
+      const int bit = __builtin_ctzll(mask);
+      mask &= ~(UINT64_C(0xF) << bit);
+      const size_t pos = i + (bit >> 2);
+      if (MultiSearchVerify(haystack, haystack_length, needles,
+                            first_byte_mask[haystack[pos]], pos,
+                            needle_index)) {
+        return pos;
+      }
+    }
+    i += 16;
+  }
+#endif
+
+  for (; i + min_length <= haystack_length; i++) {
+    const uint32_t candidates = first_byte_mask[haystack[i]];
+    if (candidates != 0 &&
+        MultiSearchVerify(haystack, haystack_length, needles,
+                          candidates, i, needle_index)) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
 }  // namespace stringsearch
 }  // namespace node
 
@@ -33,9 +33,27 @@
 
 #include <cstdlib>
 
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Available since Linux 4.11; older kernels report ENOPROTOOPT at runtime.
+#if defined(__linux__) && !defined(TCP_FASTOPEN_CONNECT)
+#define TCP_FASTOPEN_CONNECT 30
+#endif
+
 
 namespace node {
 
+// Flag value for bind()/bind6(): shard the accept queue across processes
+// and threads with SO_REUSEPORT. Lives well outside the range used by
+// libuv's UV_TCP_* flags.
+constexpr unsigned int TCP_REUSEPORT = 0x10000;
+
+using v8::Array;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -94,12 +112,16 @@ void TCPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "connect", Connect);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
+  env->SetProtoMethod(t, "connectSockaddrs", ConnectSockaddrs);
   env->SetProtoMethod(t, "getsockname",
                       GetSockOrPeerName<TCPWrap, uv_tcp_getsockname>);
   env->SetProtoMethod(t, "getpeername",
                       GetSockOrPeerName<TCPWrap, uv_tcp_getpeername>);
   env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
   env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "setBusyPoll", SetBusyPoll);
+  env->SetProtoMethod(t, "setFastOpen", SetFastOpen);
+  env->SetProtoMethod(t, "setFastOpenConnect", SetFastOpenConnect);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -126,6 +148,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, TCP_REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -192,6 +215,114 @@ void TCPWrap::SetKeepAlive(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TCPWrap::SetBusyPoll(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  Environment* env = wrap->env();
+  CHECK(args[0]->IsUint32());
+  unsigned int usec = args[0].As<Uint32>()->Value();
+
+#if defined(__linux__)
+  // Ask the kernel to busy-poll the device queue for this socket too.
+  // This is best-effort: SO_BUSY_POLL may be compiled out or require
+  // CAP_NET_ADMIN on older kernels, and the loop-level spin below is
+  // useful on its own, so setsockopt() failures are ignored.
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd) == 0) {
+    int val = static_cast<int>(usec);
+    setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &val, sizeof(val));
+  }
+#endif  // defined(__linux__)
+
+  if (usec > 0 && !wrap->busy_poll_enabled_) {
+    wrap->set_latency_critical(true);
+    env->RegisterBusyPollStream();
+    wrap->busy_poll_enabled_ = true;
+  } else if (usec == 0 && wrap->busy_poll_enabled_) {
+    wrap->set_latency_critical(false);
+    env->UnregisterBusyPollStream();
+    wrap->busy_poll_enabled_ = false;
+  }
+
+  args.GetReturnValue().Set(0);
+}
+
+
+// Enables TCP Fast Open on a bound socket, ahead of listen(). `qlen` caps
+// the number of TFO requests the kernel may keep queued before they are
+// accepted. Payload carried in a SYN is delivered through the first read
+// on the accepted connection - it reaches the first EmitRead without any
+// extra plumbing here.
+void TCPWrap::SetFastOpen(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#if defined(TCP_FASTOPEN)
+  CHECK(args[0]->IsUint32());
+  int qlen = static_cast<int>(args[0].As<Uint32>()->Value());
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err == 0 &&
+      setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &qlen, sizeof(qlen)) != 0) {
+    err = uv_translate_sys_error(errno);
+  }
+  args.GetReturnValue().Set(err);
+#else
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#endif  // defined(TCP_FASTOPEN)
+}
+
+
+// Client-side Fast Open, called before connect(): the kernel defers the
+// SYN until the first write on the socket and carries that payload in the
+// SYN itself, saving a round trip to servers that previously issued a TFO
+// cookie. Issuing sendto(MSG_FASTOPEN) directly would bypass libuv's
+// connect state machine, so the TCP_FASTOPEN_CONNECT socket option is used
+// instead and ConnectWrap completion semantics are unchanged. The socket
+// is created up front if libuv has not done so yet, like EnableReusePort.
+void TCPWrap::SetFastOpenConnect(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#if defined(__linux__)
+  CHECK(args[0]->IsUint32());
+  const int family = args[0].As<Uint32>()->Value() == 6 ? AF_INET6 : AF_INET;
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err != 0) {
+    int sock = socket(family, SOCK_STREAM, 0);
+    if (sock < 0)
+      return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+    err = uv_tcp_open(&wrap->handle_, sock);
+    if (err != 0) {
+      close(sock);
+      return args.GetReturnValue().Set(err);
+    }
+    fd = sock;
+  }
+  int on = 1;
+  err = 0;
+  if (setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &on, sizeof(on)) != 0)
+    err = uv_translate_sys_error(errno);
+  args.GetReturnValue().Set(err);
+#else
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#endif  // defined(__linux__)
+}
+
+
+void TCPWrap::OnClose() {
+  if (busy_poll_enabled_) {
+    env()->UnregisterBusyPollStream();
+    busy_poll_enabled_ = false;
+  }
+}
+
+
 #ifdef _WIN32
 void TCPWrap::SetSimultaneousAccepts(const FunctionCallbackInfo<Value>& args) {
   TCPWrap* wrap;
@@ -222,6 +353,37 @@ void TCPWrap::Open(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(err);
 }
 
+// Sets SO_REUSEPORT before the socket is bound, creating the socket up
+// front if libuv has not done so yet. Each listener bound this way owns an
+// independent kernel accept queue, so multiple workers can share a port
+// without shipping accepted fds over IPC.
+static int EnableReusePort(uv_tcp_t* handle, int family) {
+#if defined(SO_REUSEPORT)
+  int on = 1;
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(handle), &fd) == 0) {
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+      return uv_translate_sys_error(errno);
+    return 0;
+  }
+
+  int sock = socket(family, SOCK_STREAM, 0);
+  if (sock < 0)
+    return uv_translate_sys_error(errno);
+  if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0) {
+    int err = uv_translate_sys_error(errno);
+    close(sock);
+    return err;
+  }
+  int err = uv_tcp_open(handle, sock);
+  if (err != 0)
+    close(sock);
+  return err;
+#else
+  return UV_ENOTSUP;
+#endif  // defined(SO_REUSEPORT)
+}
+
 template <typename T>
 void TCPWrap::Bind(
     const FunctionCallbackInfo<Value>& args,
@@ -236,7 +398,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
+  if (args[2]->IsUint32() &&
       !args[2]->Uint32Value(env->context()).To(&flags)) {
     return;
   }
@@ -244,6 +406,11 @@ void TCPWrap::Bind(
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
 
+  if (err == 0 && (flags & TCP_REUSEPORT) != 0) {
+    flags &= ~TCP_REUSEPORT;
+    err = EnableReusePort(&wrap->handle_, family);
+  }
+
   if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
@@ -333,6 +500,64 @@ void TCPWrap::Connect(const FunctionCallbackInfo<Value>& args,
 }
 
 
+// connectSockaddrs(req, [sockaddrBuf, ...]): connect to the first reachable
+// candidate out of a list of pre-resolved binary sockaddrs, falling back
+// between them in C++ instead of re-entering per address from JS. Only the
+// winning (or final failing) status is reported through oncomplete.
+void TCPWrap::ConnectSockaddrs(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+
+#ifdef _WIN32
+  // Moving the winning socket into this handle relies on dup(2).
+  args.GetReturnValue().Set(UV_ENOSYS);
+#else
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> list = args[1].As<Array>();
+  uint32_t count = list->Length();
+  if (count == 0)
+    return args.GetReturnValue().Set(UV_EINVAL);
+
+  std::vector<sockaddr_storage> addrs(count);
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> entry;
+    if (!list->Get(env->context(), i).ToLocal(&entry))
+      return;
+    if (!entry->IsArrayBufferView())
+      return args.GetReturnValue().Set(UV_EINVAL);
+    ArrayBufferViewContents<char> contents(entry);
+    size_t len = contents.length();
+    if (len < sizeof(sa_family_t) || len > sizeof(sockaddr_storage))
+      return args.GetReturnValue().Set(UV_EINVAL);
+    memset(&addrs[i], 0, sizeof(addrs[i]));
+    memcpy(&addrs[i], contents.data(), len);
+    const int family = reinterpret_cast<sockaddr*>(&addrs[i])->sa_family;
+    if ((family == AF_INET && len < sizeof(sockaddr_in)) ||
+        (family == AF_INET6 && len < sizeof(sockaddr_in6)) ||
+        (family != AF_INET && family != AF_INET6)) {
+      return args.GetReturnValue().Set(UV_EINVAL);
+    }
+  }
+
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
+  MultiConnectWrap* req_wrap =
+      new MultiConnectWrap(env, req_wrap_obj, wrap, &wrap->handle_);
+  int err = req_wrap->Start(std::move(addrs));
+  if (err)
+    delete req_wrap;
+
+  args.GetReturnValue().Set(err);
+#endif
+}
+
+
 // also used by udp_wrap.cc
 Local<Object> AddressToJS(Environment* env,
                           const sockaddr* addr,
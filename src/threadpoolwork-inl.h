@@ -25,12 +25,25 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "util-inl.h"
+#include "node_dtrace.h"
 #include "node_internals.h"
 
 namespace node {
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
+  dtrace_threadpool_enqueue();
+  if (work_class_ == WorkClass::kCpuBound &&
+      !env_->TryAcquireCpuWorkSlot(this)) {
+    // All slots permitted by --threadpool-cpu-limit are taken; the work was
+    // queued and will be submitted once a running CPU-class job finishes.
+    lane_queued_ = true;
+    return;
+  }
+  SubmitToPool();
+}
+
+void ThreadPoolWork::SubmitToPool() {
   int status = uv_queue_work(
       env_->event_loop(),
       &work_req_,
@@ -40,13 +53,33 @@ void ThreadPoolWork::ScheduleWork() {
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
-        self->env_->DecreaseWaitingRequestCounter();
+        Environment* env = self->env_;
+        const bool cpu_bound = self->work_class_ == WorkClass::kCpuBound;
+        env->DecreaseWaitingRequestCounter();
+        dtrace_threadpool_dequeue();
+        // This may delete `self`; releasing the CPU slot (which can submit
+        // the next queued job) happens afterwards via the local copies.
         self->AfterThreadPoolWork(status);
+        if (cpu_bound)
+          env->ReleaseCpuWorkSlot();
       });
   CHECK_EQ(status, 0);
 }
 
 int ThreadPoolWork::CancelWork() {
+  if (lane_queued_) {
+    // Not yet submitted to the pool; drop the work item from the wait queue
+    // and deliver the completion callback asynchronously, mirroring the
+    // behavior of a successful uv_cancel().
+    env_->CancelQueuedCpuWork(this);
+    lane_queued_ = false;
+    env_->SetImmediate([this](Environment* env) {
+      env->DecreaseWaitingRequestCounter();
+      dtrace_threadpool_dequeue();
+      AfterThreadPoolWork(UV_ECANCELED);
+    });
+    return 0;
+  }
   return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
 }
 
@@ -1,8 +1,14 @@
+#include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "handle_wrap.h"
+#include "memory_tracker-inl.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace node {
 namespace {
@@ -11,11 +17,264 @@ using v8::Array;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::Integer;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::Value;
 
+// A hierarchical timer wheel for coarse-grained, cancel-heavy timeouts such
+// as per-connection idle timers. Arming and cancelling are O(1); expiry
+// processing is amortized over elapsed ticks (1 tick = 1ms of uv_now time).
+// Timers fire with up to one tick of slack, which is acceptable for the
+// idle-timeout use case this serves; precise timers should keep using the
+// regular Timeout path.
+constexpr int kWheelLevels = 4;
+constexpr int kWheelSlotBits = 6;
+constexpr int kWheelSlots = 1 << kWheelSlotBits;  // 64 slots per level.
+constexpr int kWheelSlotMask = kWheelSlots - 1;
+
+class TimerWheel : public HandleWrap {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    new TimerWheel(env, args.This());
+  }
+
+  // arm(after) -> id. Schedules a timer `after` milliseconds from now.
+  static void Arm(const FunctionCallbackInfo<Value>& args) {
+    TimerWheel* wheel;
+    ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+    Environment* env = wheel->env();
+    int64_t after = args[0]->IntegerValue(env->context()).FromJust();
+    if (after < 1) after = 1;
+
+    // An empty wheel does not tick; catch the clock up before inserting so
+    // that Advance() never has to walk over a long idle stretch.
+    if (wheel->armed_count_ == 0)
+      wheel->current_tick_ = uv_now(env->event_loop());
+
+    WheelTimer* timer = new WheelTimer();
+    timer->id = wheel->next_id_++;
+    timer->due = uv_now(env->event_loop()) + after;
+    wheel->by_id_[timer->id] = timer;
+    wheel->Insert(timer);
+    wheel->armed_count_++;
+
+    // Only touch the uv timer when this timer is due before the current
+    // wakeup, so that arming stays O(1).
+    if (wheel->next_wakeup_ == 0 || timer->due < wheel->next_wakeup_)
+      wheel->WakeAt(timer->due);
+
+    args.GetReturnValue().Set(static_cast<double>(timer->id));
+  }
+
+  // cancel(id) -> boolean. O(1); stale wakeups are left in place.
+  static void Cancel(const FunctionCallbackInfo<Value>& args) {
+    TimerWheel* wheel;
+    ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+    Environment* env = wheel->env();
+    uint64_t id = static_cast<uint64_t>(
+        args[0]->NumberValue(env->context()).FromJust());
+    auto it = wheel->by_id_.find(id);
+    if (it == wheel->by_id_.end()) {
+      args.GetReturnValue().Set(false);
+      return;
+    }
+    WheelTimer* timer = it->second;
+    wheel->Unlink(timer);
+    wheel->by_id_.erase(it);
+    delete timer;
+    wheel->armed_count_--;
+    if (wheel->armed_count_ == 0) {
+      uv_timer_stop(&wheel->handle_);
+      wheel->next_wakeup_ = 0;
+    }
+    args.GetReturnValue().Set(true);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(TimerWheel)
+  SET_SELF_SIZE(TimerWheel)
+
+ private:
+  struct WheelTimer {
+    uint64_t id;
+    uint64_t due;
+    WheelTimer* prev = nullptr;
+    WheelTimer* next = nullptr;
+    int level = 0;
+    int slot = 0;
+  };
+
+  TimerWheel(Environment* env, Local<Object> wrap)
+      : HandleWrap(env,
+                   wrap,
+                   reinterpret_cast<uv_handle_t*>(&handle_),
+                   AsyncWrap::PROVIDER_TIMERWHEEL) {
+    CHECK_EQ(0, uv_timer_init(env->event_loop(), &handle_));
+    current_tick_ = uv_now(env->event_loop());
+  }
+
+  ~TimerWheel() override {
+    for (auto& entry : by_id_)
+      delete entry.second;
+  }
+
+  // Buckets a timer by its distance from the current tick. Timers further
+  // out than the wheel's span are parked in the outermost level and cascade
+  // inwards as time passes.
+  void Insert(WheelTimer* timer) {
+    uint64_t delta = timer->due > current_tick_ ? timer->due - current_tick_
+                                                : 1;
+    int level = 0;
+    while (level < kWheelLevels - 1 &&
+           delta >= (1ULL << (kWheelSlotBits * (level + 1)))) {
+      level++;
+    }
+    constexpr uint64_t max_span = 1ULL << (kWheelSlotBits * kWheelLevels);
+    uint64_t bucket_due = timer->due;
+    if (delta >= max_span)
+      bucket_due = current_tick_ + max_span - 1;
+    int slot = (bucket_due >> (kWheelSlotBits * level)) & kWheelSlotMask;
+
+    timer->level = level;
+    timer->slot = slot;
+    timer->prev = nullptr;
+    timer->next = slots_[level][slot];
+    if (timer->next != nullptr) timer->next->prev = timer;
+    slots_[level][slot] = timer;
+    counts_[level]++;
+  }
+
+  void Unlink(WheelTimer* timer) {
+    if (timer->prev != nullptr)
+      timer->prev->next = timer->next;
+    else
+      slots_[timer->level][timer->slot] = timer->next;
+    if (timer->next != nullptr)
+      timer->next->prev = timer->prev;
+    timer->prev = timer->next = nullptr;
+    counts_[timer->level]--;
+  }
+
+  // Moves all timers out of the level-`level` slot that the current tick
+  // points at, re-bucketing them into lower levels.
+  void Cascade(int level) {
+    int slot = (current_tick_ >> (kWheelSlotBits * level)) & kWheelSlotMask;
+    if (slot == 0 && level + 1 < kWheelLevels)
+      Cascade(level + 1);
+    WheelTimer* timer = slots_[level][slot];
+    slots_[level][slot] = nullptr;
+    while (timer != nullptr) {
+      WheelTimer* next = timer->next;
+      timer->prev = timer->next = nullptr;
+      counts_[level]--;
+      Insert(timer);
+      timer = next;
+    }
+  }
+
+  static void OnTimeout(uv_timer_t* handle) {
+    TimerWheel* wheel = ContainerOf(&TimerWheel::handle_, handle);
+    wheel->next_wakeup_ = 0;
+    wheel->Advance(uv_now(wheel->env()->event_loop()));
+  }
+
+  void Advance(uint64_t now) {
+    std::vector<uint64_t> expired;
+    while (current_tick_ < now) {
+      current_tick_++;
+      int slot = current_tick_ & kWheelSlotMask;
+      if (slot == 0)
+        Cascade(1);
+      if (counts_[0] == 0) {
+        // Nothing can expire before the next cascade boundary; skip ahead
+        // so that catching up after an idle stretch is O(elapsed / 64)
+        // rather than one iteration per elapsed millisecond.
+        current_tick_ = std::min(now, current_tick_ | kWheelSlotMask);
+        continue;
+      }
+      WheelTimer* timer = slots_[0][slot];
+      slots_[0][slot] = nullptr;
+      while (timer != nullptr) {
+        WheelTimer* next = timer->next;
+        expired.push_back(timer->id);
+        by_id_.erase(timer->id);
+        delete timer;
+        armed_count_--;
+        counts_[0]--;
+        timer = next;
+      }
+    }
+    Reschedule();
+    if (!expired.empty())
+      EmitExpired(expired);
+  }
+
+  // Finds the next point in time at which either a level-0 timer is due or
+  // a higher-level slot needs to cascade, and arms the uv timer for it.
+  void Reschedule() {
+    if (armed_count_ == 0) {
+      uv_timer_stop(&handle_);
+      next_wakeup_ = 0;
+      return;
+    }
+    for (uint64_t d = 1; d <= kWheelSlotMask; d++) {
+      if (slots_[0][(current_tick_ + d) & kWheelSlotMask] != nullptr) {
+        WakeAt(current_tick_ + d);
+        return;
+      }
+    }
+    uint64_t best = 0;
+    for (int level = 1; level < kWheelLevels; level++) {
+      uint64_t cur = current_tick_ >> (kWheelSlotBits * level);
+      for (uint64_t d = 1; d <= kWheelSlotMask; d++) {
+        if (slots_[level][(cur + d) & kWheelSlotMask] != nullptr) {
+          uint64_t cascade_tick = (cur + d) << (kWheelSlotBits * level);
+          if (best == 0 || cascade_tick < best)
+            best = cascade_tick;
+          break;
+        }
+      }
+    }
+    CHECK_NE(best, 0);
+    WakeAt(best);
+  }
+
+  void WakeAt(uint64_t tick) {
+    uint64_t now = uv_now(env()->event_loop());
+    uint64_t delay = tick > now ? tick - now : 1;
+    uv_timer_start(&handle_, OnTimeout, delay, 0);
+    next_wakeup_ = tick;
+  }
+
+  void EmitExpired(const std::vector<uint64_t>& expired) {
+    v8::HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    std::vector<Local<Value>> ids(expired.size());
+    for (size_t i = 0; i < expired.size(); i++)
+      ids[i] = Number::New(env()->isolate(), static_cast<double>(expired[i]));
+    Local<Value> arg =
+        Array::New(env()->isolate(), ids.data(), ids.size());
+    MakeCallback(env()->onexpired_string(), 1, &arg);
+  }
+
+  uv_timer_t handle_;
+  WheelTimer* slots_[kWheelLevels][kWheelSlots] = {};
+  size_t counts_[kWheelLevels] = {};
+  std::unordered_map<uint64_t, WheelTimer*> by_id_;
+  uint64_t current_tick_ = 0;
+  uint64_t next_wakeup_ = 0;  // 0 = uv timer not armed.
+  uint64_t next_id_ = 1;
+  size_t armed_count_ = 0;
+};
+
+constexpr int kCoarseClockDateNow = Environment::kCoarseClockDateNow;
+constexpr int kCoarseClockLibuvNow = Environment::kCoarseClockLibuvNow;
+
 void SetupTimers(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsFunction());
   CHECK(args[1]->IsFunction());
@@ -55,9 +314,26 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "toggleTimerRef", ToggleTimerRef);
   env->SetMethod(target, "toggleImmediateRef", ToggleImmediateRef);
 
+  Local<FunctionTemplate> wheel = env->NewFunctionTemplate(TimerWheel::New);
+  wheel->InstanceTemplate()->SetInternalFieldCount(1);
+  wheel->Inherit(HandleWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(wheel, "arm", TimerWheel::Arm);
+  env->SetProtoMethod(wheel, "cancel", TimerWheel::Cancel);
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "TimerWheel"),
+              wheel->GetFunction(env->context()).ToLocalChecked()).Check();
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "immediateInfo"),
               env->immediate_info()->fields().GetJSArray()).Check();
+
+  // [kCoarseClockDateNow, kCoarseClockLibuvNow]; refreshed once per loop
+  // turn, so values lag a plain clock read by up to one turn.
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "coarseClockFields"),
+              env->coarse_clock_fields().GetJSArray()).Check();
+  NODE_DEFINE_CONSTANT(target, kCoarseClockDateNow);
+  NODE_DEFINE_CONSTANT(target, kCoarseClockLibuvNow);
 }
 
 
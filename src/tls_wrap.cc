@@ -32,6 +32,23 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <openssl/async.h>
+#include <openssl/rsa.h>
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <netinet/tcp.h>  // TCP_ULP
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <openssl/hmac.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#define NODE_HAVE_KTLS 1
+#endif
+#endif  // defined(__linux__)
+
 namespace node {
 
 using crypto::SecureContext;
@@ -52,8 +69,160 @@ using v8::Object;
 using v8::ReadOnly;
 using v8::Signature;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
+namespace {
+
+// The TLSWrap whose SSL object is currently being driven on this thread.
+// AsyncRSAPrivEnc() uses it to find the event loop to offload to; when the
+// private key operation fires outside of ClearIn()/ClearOut() it falls
+// back to the synchronous default method.
+thread_local TLSWrap* current_handshake_wrap = nullptr;
+
+class CurrentHandshakeWrapScope {
+ public:
+  explicit CurrentHandshakeWrapScope(TLSWrap* wrap)
+      : previous_(current_handshake_wrap) {
+    current_handshake_wrap = wrap;
+  }
+  ~CurrentHandshakeWrapScope() {
+    current_handshake_wrap = previous_;
+  }
+
+ private:
+  TLSWrap* previous_;
+};
+
+int DefaultRSAPrivEnc(int flen,
+                      const unsigned char* from,
+                      unsigned char* to,
+                      RSA* rsa,
+                      int padding) {
+  return RSA_meth_get_priv_enc(RSA_get_default_method())(
+      flen, from, to, rsa, padding);
+}
+
+// Carries one offloaded RSA private key operation from the OpenSSL async
+// job that was paused to the threadpool and back. The paused job and the
+// after-work callback each hold a reference; the last one to let go frees
+// the struct. `to` points into the paused job's stack, which stays alive
+// until the job is resumed and finishes.
+struct AsyncKeyJob {
+  uv_work_t work_req;
+  BaseObjectPtr<TLSWrap> wrap;
+  std::vector<unsigned char> from;
+  unsigned char* to = nullptr;
+  RSA* rsa = nullptr;
+  int padding = 0;
+  int result = -1;
+  std::atomic<bool> done{false};
+  std::atomic<int> refs{2};
+
+  static void Release(AsyncKeyJob* job) {
+    if (--job->refs == 0) {
+      RSA_free(job->rsa);
+      delete job;
+    }
+  }
+};
+
+void DoAsyncKeyOp(uv_work_t* req) {
+  AsyncKeyJob* job = ContainerOf(&AsyncKeyJob::work_req, req);
+  job->result = DefaultRSAPrivEnc(job->from.size(),
+                                  job->from.data(),
+                                  job->to,
+                                  job->rsa,
+                                  job->padding);
+  job->done = true;
+}
+
+}  // anonymous namespace
+
+
+int TLSWrap::AsyncRSAPrivEnc(int flen,
+                             const unsigned char* from,
+                             unsigned char* to,
+                             RSA* rsa,
+                             int padding) {
+  TLSWrap* wrap = current_handshake_wrap;
+  if (wrap == nullptr || ASYNC_get_current_job() == nullptr)
+    return DefaultRSAPrivEnc(flen, from, to, rsa, padding);
+
+  AsyncKeyJob* job = new AsyncKeyJob();
+  job->wrap = BaseObjectPtr<TLSWrap>(wrap);
+  job->from.assign(from, from + flen);
+  job->to = to;
+  job->rsa = rsa;
+  job->padding = padding;
+  RSA_up_ref(rsa);
+
+  if (uv_queue_work(wrap->env()->event_loop(),
+                    &job->work_req,
+                    DoAsyncKeyOp,
+                    AfterAsyncKeyOp) != 0) {
+    RSA_free(rsa);
+    delete job;
+    return DefaultRSAPrivEnc(flen, from, to, rsa, padding);
+  }
+
+  // Suspend until the threadpool has produced the result. SSL_read() and
+  // SSL_write() report SSL_ERROR_WANT_ASYNC in the meantime, and an
+  // unrelated Cycle() may resume the job before the work is done, in which
+  // case it is simply paused again.
+  while (!job->done) {
+    if (ASYNC_pause_job() == 0) {
+      // Could not suspend; degrade to blocking until the result arrives.
+      while (!job->done)
+        uv_sleep(1);
+      break;
+    }
+  }
+
+  int result = job->result;
+  AsyncKeyJob::Release(job);
+  return result;
+}
+
+
+void TLSWrap::AfterAsyncKeyOp(uv_work_t* req, int status) {
+  AsyncKeyJob* job = ContainerOf(&AsyncKeyJob::work_req, req);
+  BaseObjectPtr<TLSWrap> wrap = std::move(job->wrap);
+  AsyncKeyJob::Release(job);
+
+  // If the SSL object was destroyed while the operation was in flight the
+  // paused job can no longer be resumed; OpenSSL reclaims it with the SSL.
+  if (status == UV_ECANCELED || !wrap || wrap->ssl_ == nullptr)
+    return;
+
+  wrap->Cycle();
+}
+
+
+bool TLSWrap::InstallAsyncPrivateKey(SSL_CTX* ctx) {
+  if (!ASYNC_is_capable())
+    return false;
+
+  // Only RSA is offloaded; an ECDSA sign is an order of magnitude cheaper
+  // than the threadpool round trip it would take to move it off the loop.
+  EVP_PKEY* pkey = SSL_CTX_get0_privatekey(ctx);
+  if (pkey == nullptr || EVP_PKEY_base_id(pkey) != EVP_PKEY_RSA)
+    return false;
+
+  static RSA_METHOD* method = []() {
+    RSA_METHOD* m = RSA_meth_dup(RSA_get_default_method());
+    CHECK_NOT_NULL(m);
+    RSA_meth_set1_name(m, "Node.js threadpool RSA method");
+    RSA_meth_set_priv_enc(m, AsyncRSAPrivEnc);
+    return m;
+  }();
+
+  RSA_set_method(EVP_PKEY_get0_RSA(pkey), method);
+  SSL_CTX_set_mode(ctx, SSL_MODE_ASYNC);
+  return true;
+}
+
+
 TLSWrap::TLSWrap(Environment* env,
                  Local<Object> obj,
                  Kind kind,
@@ -69,11 +238,14 @@ TLSWrap::TLSWrap(Environment* env,
   // sc comes from an Unwrap. Make sure it was assigned.
   CHECK_NOT_NULL(sc);
 
-  // We've our own session callbacks
-  SSL_CTX_sess_set_get_cb(sc_->ctx_.get(),
-                          SSLWrap<TLSWrap>::GetSessionCallback);
-  SSL_CTX_sess_set_new_cb(sc_->ctx_.get(),
-                          SSLWrap<TLSWrap>::NewSessionCallback);
+  // We've our own session callbacks, unless the context already stores its
+  // sessions in the process-wide shared cache.
+  if (!sc_->use_shared_session_cache_) {
+    SSL_CTX_sess_set_get_cb(sc_->ctx_.get(),
+                            SSLWrap<TLSWrap>::GetSessionCallback);
+    SSL_CTX_sess_set_new_cb(sc_->ctx_.get(),
+                            SSLWrap<TLSWrap>::NewSessionCallback);
+  }
 
   stream->PushStreamListener(this);
 
@@ -395,6 +567,10 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
   // Ensure that the progress will be made and `InvokeQueued` will be called.
   ClearIn();
 
+  // The socket made progress, so push out whatever the record batch has
+  // accumulated in the meantime.
+  FlushRecordBatch();
+
   // Try writing more data
   write_size_ = 0;
   EncOut();
@@ -416,6 +592,12 @@ Local<Value> TLSWrap::GetSSLError(int status, int* err, std::string* msg) {
     case SSL_ERROR_WANT_X509_LOOKUP:
       return Local<Value>();
 
+    // A private key operation is running on the threadpool; the cycle is
+    // restarted from AfterAsyncKeyOp() once it has finished.
+    case SSL_ERROR_WANT_ASYNC:
+    case SSL_ERROR_WANT_ASYNC_JOB:
+      return Local<Value>();
+
     case SSL_ERROR_ZERO_RETURN:
       return scope.Escape(env()->zero_return_string());
 
@@ -502,36 +684,40 @@ void TLSWrap::ClearOut() {
   }
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+  CurrentHandshakeWrapScope handshake_scope(this);
+
+  // A 0-RTT peer may still be sending early data, which has to be drained
+  // with SSL_read_early_data() before SSL_read() is allowed.
+  if (!TryReadEarlyData()) {
+    Debug(this, "Returning from ClearOut(), awaiting more early data");
+    return;
+  }
+  if (ssl_ == nullptr)  // TryReadEarlyData() may call into JS.
+    return;
 
-  char out[kClearOutChunkSize];
   int read;
   for (;;) {
-    read = SSL_read(ssl_.get(), out, sizeof(out));
+    // Decrypt straight into the read buffer that is handed to EmitRead()
+    // instead of bouncing the plaintext through an intermediate stack
+    // buffer. When SSL_read() produces nothing the untouched buffer goes
+    // back through EmitRead(0, ...), which recycles it.
+    uv_buf_t buf = EmitAlloc(kClearOutChunkSize);
+    read = SSL_read(ssl_.get(), buf.base, buf.len);
     Debug(this, "Read %d bytes of cleartext output", read);
 
-    if (read <= 0)
+    if (read <= 0) {
+      EmitRead(0, buf);
       break;
+    }
 
-    char* current = out;
-    while (read > 0) {
-      int avail = read;
-
-      uv_buf_t buf = EmitAlloc(avail);
-      if (static_cast<int>(buf.len) < avail)
-        avail = buf.len;
-      memcpy(buf.base, current, avail);
-      EmitRead(avail, buf);
-
-      // Caveat emptor: OnRead() calls into JS land which can result in
-      // the SSL context object being destroyed.  We have to carefully
-      // check that ssl_ != nullptr afterwards.
-      if (ssl_ == nullptr) {
-        Debug(this, "Returning from read loop, ssl_ == nullptr");
-        return;
-      }
+    EmitRead(read, buf);
 
-      read -= avail;
-      current += avail;
+    // Caveat emptor: OnRead() calls into JS land which can result in
+    // the SSL context object being destroyed.  We have to carefully
+    // check that ssl_ != nullptr afterwards.
+    if (ssl_ == nullptr) {
+      Debug(this, "Returning from read loop, ssl_ == nullptr");
+      return;
     }
   }
 
@@ -586,7 +772,9 @@ void TLSWrap::ClearIn() {
 
   AllocatedBuffer data = std::move(pending_cleartext_input_);
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+  CurrentHandshakeWrapScope handshake_scope(this);
 
+  app_data_written_ = true;
   int written = SSL_write(ssl_.get(), data.data(), data.size());
   Debug(this, "Writing %zu bytes, written = %d", data.size(), written);
   CHECK(written == -1 || written == static_cast<int>(data.size()));
@@ -619,6 +807,350 @@ void TLSWrap::ClearIn() {
 }
 
 
+bool TLSWrap::TryReadEarlyData() {
+  if (!early_data_enabled_ || early_data_done_)
+    return true;
+
+  for (;;) {
+    char buf[kClearOutChunkSize];
+    size_t nread = 0;
+    int ret = SSL_read_early_data(ssl_.get(), buf, sizeof(buf), &nread);
+    Debug(this, "SSL_read_early_data() = %d, %zu bytes", ret, nread);
+    switch (ret) {
+      case SSL_READ_EARLY_DATA_ERROR: {
+        int err = SSL_get_error(ssl_.get(), 0);
+        if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE)
+          return false;  // More of the 0-RTT flight is still in transit.
+        // Fatal errors surface through the regular SSL_read() path.
+        early_data_done_ = true;
+        return true;
+      }
+      case SSL_READ_EARLY_DATA_SUCCESS:
+        if (nread > 0) {
+          early_data_buffer_.insert(early_data_buffer_.end(),
+                                    buf,
+                                    buf + nread);
+          OnEarlyData();
+          if (ssl_ == nullptr)  // JS may have destroyed the SSL context.
+            return false;
+        }
+        break;
+      case SSL_READ_EARLY_DATA_FINISH:
+        early_data_done_ = true;
+        FlushEarlyData();
+        return ssl_ != nullptr;
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+
+void TLSWrap::OnEarlyData() {
+  if (early_data_announced_)
+    return;
+  early_data_announced_ = true;
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  Local<Value> callback;
+  if (object()->Get(env()->context(), env()->onearlydata_string())
+        .ToLocal(&callback) && callback->IsFunction()) {
+    MakeCallback(callback.As<Function>(), 0, nullptr);
+  }
+}
+
+
+void TLSWrap::FlushEarlyData() {
+  if (!early_data_accepted_ || early_data_buffer_.empty())
+    return;
+  Debug(this, "Delivering %zu bytes of early data",
+        early_data_buffer_.size());
+
+  std::vector<char> data;
+  data.swap(early_data_buffer_);
+  size_t offset = 0;
+  while (offset < data.size()) {
+    uv_buf_t buf = EmitAlloc(data.size() - offset);
+    size_t avail = std::min<size_t>(buf.len, data.size() - offset);
+    memcpy(buf.base, data.data() + offset, avail);
+    EmitRead(avail, buf);
+    offset += avail;
+    if (ssl_ == nullptr)
+      return;
+  }
+}
+
+
+// Server: opt this connection into receiving TLS1.3 0-RTT early data. The
+// secure context must additionally announce a non-zero max early data size
+// (see SecureContext::SetMaxEarlyData) for clients to send any.
+void TLSWrap::EnableEarlyData(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+  CHECK(wrap->is_server());
+  wrap->early_data_enabled_ = true;
+}
+
+
+// Server: arm the replay gate. Early data received so far (and any that is
+// still in transit) is released to the application. Until this is called,
+// 0-RTT payloads stay parked because an attacker can replay them.
+void TLSWrap::AcceptEarlyData(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(wrap->is_server());
+  wrap->early_data_accepted_ = true;
+  wrap->FlushEarlyData();
+}
+
+
+// Client: send application data in the same flight as the ClientHello of a
+// resumed session. Returns the number of bytes accepted; 0 when the
+// connection state does not allow early data (no resumable session, or the
+// server did not advertise support). Rejected early data is not
+// retransmitted automatically - check getEarlyDataStatus() after the
+// handshake and rewrite the payload if it reports rejection.
+void TLSWrap::WriteEarlyData(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+  CHECK(wrap->is_client());
+  CHECK(args[0]->IsArrayBufferView());
+  ArrayBufferViewContents<char> data(args[0]);
+
+  // Only attempt 0-RTT when the resumed session actually permits it;
+  // SSL_write_early_data() would otherwise fail fatally and poison the
+  // handshake state.
+  SSL_SESSION* sess = SSL_get_session(wrap->ssl_.get());
+  if (sess == nullptr || SSL_SESSION_get_max_early_data(sess) == 0)
+    return args.GetReturnValue().Set(0);
+
+  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+  size_t written = 0;
+  int ok = SSL_write_early_data(
+      wrap->ssl_.get(), data.data(), data.length(), &written);
+  Debug(wrap, "SSL_write_early_data() = %d, %zu bytes", ok, written);
+  if (ok == 1)
+    wrap->app_data_written_ = true;  // Precludes later kTLS offload.
+  // Push the ClientHello + early data flight out to the transport.
+  wrap->EncOut();
+  args.GetReturnValue().Set(ok == 1 ? static_cast<uint32_t>(written) : 0);
+}
+
+
+void TLSWrap::GetEarlyDataStatus(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+  args.GetReturnValue().Set(SSL_get_early_data_status(wrap->ssl_.get()));
+}
+
+
+#ifdef NODE_HAVE_KTLS
+// TLS1.2 PRF with P_SHA256, RFC 5246 section 5. Used to re-derive the
+// record-layer key block so that the transmit keys can be handed to the
+// kernel; only cipher suites whose PRF hash is SHA256 are offloaded.
+static bool TLS12Prf(const unsigned char* secret,
+                     size_t secret_len,
+                     const char* label,
+                     const unsigned char* seed,
+                     size_t seed_len,
+                     unsigned char* out,
+                     size_t out_len) {
+  unsigned char full_seed[16 + 2 * SSL3_RANDOM_SIZE];
+  size_t label_len = strlen(label);
+  CHECK_LE(label_len + seed_len, sizeof(full_seed));
+  memcpy(full_seed, label, label_len);
+  memcpy(full_seed + label_len, seed, seed_len);
+  size_t full_seed_len = label_len + seed_len;
+
+  unsigned char a[EVP_MAX_MD_SIZE];
+  unsigned int a_len;
+  if (HMAC(EVP_sha256(), secret, secret_len,
+           full_seed, full_seed_len, a, &a_len) == nullptr) {
+    return false;
+  }
+
+  size_t done = 0;
+  while (done < out_len) {
+    unsigned char block_input[EVP_MAX_MD_SIZE + sizeof(full_seed)];
+    memcpy(block_input, a, a_len);
+    memcpy(block_input + a_len, full_seed, full_seed_len);
+    unsigned char block[EVP_MAX_MD_SIZE];
+    unsigned int block_len;
+    if (HMAC(EVP_sha256(), secret, secret_len,
+             block_input, a_len + full_seed_len, block, &block_len) ==
+        nullptr) {
+      return false;
+    }
+    size_t use = std::min(static_cast<size_t>(block_len), out_len - done);
+    memcpy(out + done, block, use);
+    done += use;
+    if (HMAC(EVP_sha256(), secret, secret_len, a, a_len, a, &a_len) ==
+        nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif  // NODE_HAVE_KTLS
+
+
+bool TLSWrap::StartKTLS() {
+#ifndef NODE_HAVE_KTLS
+  return false;
+#else
+  if (ssl_ == nullptr || !established_ || shutdown_ || ktls_tx_)
+    return false;
+
+  // The kernel takes over the record layer at a fixed sequence number, so
+  // the offload can only be installed right after the handshake, before any
+  // application data has been encrypted and while nothing is in flight.
+  if (app_data_written_ || current_write_ != nullptr || write_size_ != 0 ||
+      pending_cleartext_input_.size() != 0 || !record_batch_.empty() ||
+      BIO_pending(enc_out_) != 0) {
+    return false;
+  }
+
+  if (SSL_version(ssl_.get()) != TLS1_2_VERSION)
+    return false;
+
+  // Restricted to AES-128-GCM: an AEAD suite with a P_SHA256 PRF that every
+  // kTLS-capable kernel supports.
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_.get());
+  if (cipher == nullptr ||
+      SSL_CIPHER_get_cipher_nid(cipher) != NID_aes_128_gcm) {
+    return false;
+  }
+
+  int fd = GetFD();
+  if (fd < 0)
+    return false;
+
+  // Re-derive the key block, RFC 5246 section 6.3. For AEAD suites it is
+  // the two write keys followed by the two 4-byte implicit nonce salts.
+  unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_len = SSL_SESSION_get_master_key(
+      SSL_get_session(ssl_.get()), master, sizeof(master));
+  unsigned char randoms[2 * SSL3_RANDOM_SIZE];
+  size_t server_len =
+      SSL_get_server_random(ssl_.get(), randoms, SSL3_RANDOM_SIZE);
+  size_t client_len = SSL_get_client_random(
+      ssl_.get(), randoms + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+  if (master_len == 0 ||
+      server_len != SSL3_RANDOM_SIZE ||
+      client_len != SSL3_RANDOM_SIZE) {
+    return false;
+  }
+
+  unsigned char key_block[2 * TLS_CIPHER_AES_GCM_128_KEY_SIZE +
+                          2 * TLS_CIPHER_AES_GCM_128_SALT_SIZE];
+  bool derived = TLS12Prf(master, master_len, "key expansion",
+                          randoms, sizeof(randoms),
+                          key_block, sizeof(key_block));
+  OPENSSL_cleanse(master, sizeof(master));
+  if (!derived)
+    return false;
+
+  const unsigned char* client_key = key_block;
+  const unsigned char* server_key =
+      client_key + TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+  const unsigned char* client_salt =
+      server_key + TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+  const unsigned char* server_salt =
+      client_salt + TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+  const unsigned char* write_key = is_server() ? server_key : client_key;
+  const unsigned char* write_salt = is_server() ? server_salt : client_salt;
+
+  bool ok = false;
+  if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls") - 1) == 0) {
+    struct tls12_crypto_info_aes_gcm_128 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.key, write_key, TLS_CIPHER_AES_GCM_128_KEY_SIZE);
+    memcpy(info.salt, write_salt, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+    // Exactly one record (the Finished message) has been sent since the
+    // last change_cipher_spec, so application data continues at record
+    // sequence number 1. The explicit nonce tracks the sequence number.
+    uint64_t seq = 1;
+    for (size_t i = 0; i < TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE; i++) {
+      info.rec_seq[TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE - 1 - i] = seq & 0xff;
+      seq >>= 8;
+    }
+    memcpy(info.iv, info.rec_seq, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+    ok = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) == 0;
+    OPENSSL_cleanse(&info, sizeof(info));
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+
+  if (!ok) {
+    Debug(this, "kTLS offload not available, staying in userspace");
+    return false;
+  }
+
+  // From here on DoWrite() passes cleartext straight through to the socket
+  // and the kernel encrypts it. A renegotiation would desynchronize the
+  // kernel's record sequence, so forbid it outright.
+  SSL_set_options(ssl_.get(), SSL_OP_NO_RENEGOTIATION);
+  ktls_tx_ = true;
+  Debug(this, "kTLS transmit offload enabled");
+  return true;
+#endif  // NODE_HAVE_KTLS
+}
+
+
+void TLSWrap::FlushRecordBatch() {
+  if (record_batch_.empty() || ssl_ == nullptr)
+    return;
+
+  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  app_data_written_ = true;
+  int written = SSL_write(ssl_.get(),
+                          record_batch_.data(),
+                          record_batch_.size());
+  Debug(this, "Flushing %zu batched bytes, written = %d",
+        record_batch_.size(), written);
+  CHECK(written == -1 || written == static_cast<int>(record_batch_.size()));
+
+  if (written == -1) {
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    int err;
+    Local<Value> arg = GetSSLError(written, &err, &error_);
+    if (!arg.IsEmpty()) {
+      Debug(this, "Got SSL error (%d) while flushing batch", err);
+      record_batch_.clear();
+      // The batched writes may be failed from inside DoWrite(); defer their
+      // completion the same way EncOut() defers synchronous finishes, but on
+      // the high-priority lane so the error surfaces before bulk work.
+      BaseObjectPtr<TLSWrap> strong_ref{this};
+      env()->SetHighPriorityImmediate([this, strong_ref](Environment* env) {
+        CompleteBatchedWrites(UV_EPROTO);
+      });
+    }
+    // Otherwise leave the batch in place; a later flush will retry.
+    return;
+  }
+
+  record_batch_.clear();
+  EncOut();
+}
+
+
+void TLSWrap::CompleteBatchedWrites(int status) {
+  std::vector<WriteWrap*> wraps;
+  wraps.swap(record_batch_wraps_);
+  for (WriteWrap* wrap : wraps)
+    wrap->Done(status);
+}
+
+
 std::string TLSWrap::diagnostic_name() const {
   std::string name = "TLSWrap ";
   if (is_server())
@@ -704,6 +1236,63 @@ int TLSWrap::DoWrite(WriteWrap* w,
   for (i = 0; i < count; i++)
     length += bufs[i].len;
 
+  // With kTLS transmit offload active the kernel owns the record layer:
+  // hand the cleartext straight to the underlying stream. The empty-write
+  // machinery already knows how to complete our WriteWrap once the socket
+  // write finishes, so reuse it.
+  if (ktls_tx_ && length != 0) {
+    Debug(this, "Passing %zu bytes through to the kTLS socket", length);
+    CHECK_NULL(current_empty_write_);
+    current_empty_write_ = w;
+    StreamWriteResult res =
+        underlying_stream()->Write(bufs, count, send_handle);
+    if (res.err != 0) {
+      current_empty_write_ = nullptr;
+      return res.err;
+    }
+    if (!res.async) {
+      BaseObjectPtr<TLSWrap> strong_ref{this};
+      env()->SetImmediate([this, strong_ref](Environment* env) {
+        OnStreamAfterWrite(current_empty_write_, 0);
+      });
+    }
+    return 0;
+  }
+
+  // Opt-in record batching: copy small writes into the batch buffer and
+  // acknowledge them once the copy is made, so that cleartext written across
+  // several write() calls is encrypted as one fuller TLS record instead of
+  // one undersized record each. Writes at or above the watermark join the
+  // batch only if one is already pending, to preserve ordering.
+  if (record_batch_watermark_ != 0 && length != 0 && established_ &&
+      !shutdown_ && current_write_ == nullptr &&
+      pending_cleartext_input_.size() == 0 &&
+      (length < record_batch_watermark_ || !record_batch_.empty())) {
+    Debug(this, "Batching %zu bytes of cleartext", length);
+    size_t offset = record_batch_.size();
+    record_batch_.resize(offset + length);
+    for (i = 0; i < count; i++) {
+      memcpy(record_batch_.data() + offset, bufs[i].base, bufs[i].len);
+      offset += bufs[i].len;
+    }
+    record_batch_wraps_.push_back(w);
+    if (!record_batch_scheduled_) {
+      record_batch_scheduled_ = true;
+      BaseObjectPtr<TLSWrap> strong_ref{this};
+      env()->SetImmediate([this, strong_ref](Environment* env) {
+        record_batch_scheduled_ = false;
+        // Acknowledging the batched writes first lets the stream hand over
+        // whatever cleartext it buffered in the meantime before the next
+        // loop-turn flush.
+        CompleteBatchedWrites(0);
+        FlushRecordBatch();
+      });
+    }
+    if (record_batch_.size() >= record_batch_watermark_)
+      FlushRecordBatch();
+    return 0;
+  }
+
   // We want to trigger a Write() on the underlying stream to drive the stream
   // system, but don't want to encrypt empty buffers into a TLS frame, so see
   // if we can find something to Write().
@@ -746,6 +1335,7 @@ int TLSWrap::DoWrite(WriteWrap* w,
   AllocatedBuffer data;
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  app_data_written_ = true;
   int written = 0;
   if (count != 1) {
     data = env()->AllocateManaged(length);
@@ -854,9 +1444,17 @@ ShutdownWrap* TLSWrap::CreateShutdownWrap(Local<Object> req_wrap_object) {
 
 int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   Debug(this, "DoShutdown()");
+
+  // Anything still sitting in the record batch has already been
+  // acknowledged, so it has to go out ahead of the close_notify.
+  FlushRecordBatch();
+
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
+  // With kTLS transmit offload the close_notify alert can not be written
+  // through the regular stream (the kernel would encrypt it as application
+  // data), so shut the transport down without it.
+  if (ssl_ && !ktls_tx_ && SSL_shutdown(ssl_.get()) == 0)
     SSL_shutdown(ssl_.get());
 
   shutdown_ = true;
@@ -969,6 +1567,10 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
   // And destroy
   wrap->InvokeQueued(UV_ECANCELED, "Canceled because of SSL destruction");
 
+  // Batched writes that were never flushed can no longer complete.
+  wrap->record_batch_.clear();
+  wrap->CompleteBatchedWrites(UV_ECANCELED);
+
   // Destroy the SSL structure and friends
   wrap->SSLWrap<TLSWrap>::DestroySSL();
   wrap->enc_in_ = nullptr;
@@ -1206,6 +1808,32 @@ unsigned int TLSWrap::PskClientCallback(SSL* s,
 
 #endif
 
+// Enables Nagle-like record batching with the given watermark in bytes, or
+// disables it again when the watermark is 0. See the field documentation in
+// tls_wrap.h for the semantics.
+void TLSWrap::SetRecordBatching(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsUint32());
+  wrap->record_batch_watermark_ = args[0].As<Uint32>()->Value();
+  Debug(wrap, "Record batching watermark set to %zu",
+        wrap->record_batch_watermark_);
+  // Turning batching off must not strand already-accumulated data.
+  if (wrap->record_batch_watermark_ == 0)
+    wrap->FlushRecordBatch();
+}
+
+
+// Attempts to move the transmit side of this connection into the kernel
+// (Linux kTLS). Returns a boolean; on false the caller keeps using the
+// userspace record layer, nothing has changed.
+void TLSWrap::EnableKTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(wrap->StartKTLS());
+}
+
+
 void TLSWrap::GetWriteQueueSize(const FunctionCallbackInfo<Value>& info) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, info.This());
@@ -1226,6 +1854,8 @@ void TLSWrap::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pending_cleartext_input",
                               pending_cleartext_input_.size(),
                               "AllocatedBuffer");
+  tracker->TrackField("record_batch", record_batch_);
+  tracker->TrackField("early_data_buffer", early_data_buffer_);
   if (enc_in_ != nullptr)
     tracker->TrackField("enc_in", crypto::NodeBIO::FromBIO(enc_in_));
   if (enc_out_ != nullptr)
@@ -1270,6 +1900,16 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableTrace", EnableTrace);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "setRecordBatching", SetRecordBatching);
+  env->SetProtoMethod(t, "enableKTLS", EnableKTLS);
+  env->SetProtoMethod(t, "enableEarlyData", EnableEarlyData);
+  env->SetProtoMethod(t, "acceptEarlyData", AcceptEarlyData);
+  env->SetProtoMethod(t, "writeEarlyData", WriteEarlyData);
+  env->SetProtoMethod(t, "getEarlyDataStatus", GetEarlyDataStatus);
+
+  NODE_DEFINE_CONSTANT(target, SSL_EARLY_DATA_NOT_SENT);
+  NODE_DEFINE_CONSTANT(target, SSL_EARLY_DATA_REJECTED);
+  NODE_DEFINE_CONSTANT(target, SSL_EARLY_DATA_ACCEPTED);
 
 #ifndef OPENSSL_NO_PSK
   env->SetProtoMethod(t, "setPskIdentityHint", SetPskIdentityHint);
@@ -33,6 +33,7 @@
 #include <openssl/ssl.h>
 
 #include <string>
+#include <vector>
 
 namespace node {
 
@@ -83,6 +84,14 @@ class TLSWrap : public AsyncWrap,
   // Called by the done() callback of the 'newSession' event.
   void NewSessionDoneCb();
 
+  // Swap the RSA private key method of ctx for one that runs the modular
+  // exponentiation on the libuv threadpool, and put the context into
+  // SSL_MODE_ASYNC so the handshake suspends instead of blocking the event
+  // loop on it. Returns false when the key type or the OpenSSL build does
+  // not support the offload. Called by
+  // SecureContext::EnableAsyncPrivateKey().
+  static bool InstallAsyncPrivateKey(SSL_CTX* ctx);
+
   // Implement MemoryRetainer:
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(TLSWrap)
@@ -126,6 +135,41 @@ class TLSWrap : public AsyncWrap,
   void ClearIn();  // SSL_write() clear data "in" to SSL.
   void ClearOut();  // SSL_read() clear text "out" from SSL.
 
+  // Pass the accumulated record batch to SSL_write() as a single unit and
+  // kick off EncOut(). Does not complete the batched WriteWraps; see
+  // CompleteBatchedWrites().
+  void FlushRecordBatch();
+
+  // Try to install the negotiated transmit keys into the kernel (Linux
+  // kTLS), flipping outbound traffic into passthrough mode. Returns false
+  // when the platform, kernel, cipher or connection state does not allow
+  // the offload; the userspace path keeps working in that case.
+  bool StartKTLS();
+
+  // Server side of a TLS1.3 0-RTT handshake. While the peer may still be
+  // sending early data SSL_read() is not allowed, so ClearOut() drains it
+  // with SSL_read_early_data() first. Returns true once normal reads may
+  // proceed, false when more of the 0-RTT flight is still in transit.
+  bool TryReadEarlyData();
+  // Announce the arrival of early data to JS (once), so the application
+  // can decide whether to arm the replay gate.
+  void OnEarlyData();
+  // Deliver parked early data through EmitRead() once the replay gate has
+  // been armed via acceptEarlyData().
+  void FlushEarlyData();
+  // Call Done() on the WriteWraps whose data has been copied into the
+  // record batch.
+  void CompleteBatchedWrites(int status);
+
+  // RSA private key operation that suspends the OpenSSL async job while the
+  // actual computation runs on the threadpool; see InstallAsyncPrivateKey().
+  static int AsyncRSAPrivEnc(int flen,
+                             const unsigned char* from,
+                             unsigned char* to,
+                             RSA* rsa,
+                             int padding);
+  static void AfterAsyncKeyOp(uv_work_t* req, int status);
+
   // Call Done() on outstanding WriteWrap request.
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -165,6 +209,14 @@ class TLSWrap : public AsyncWrap,
   static void EnableTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetRecordBatching(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableEarlyData(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void AcceptEarlyData(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WriteEarlyData(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetEarlyDataStatus(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static int SelectSNIContextCallback(SSL* s, int* ad, void* arg);
@@ -192,6 +244,15 @@ class TLSWrap : public AsyncWrap,
   BIO* enc_out_ = nullptr;  // SSL_write()/handshake fills this for EncOut().
   // Waiting for ClearIn() to pass to SSL_write().
   AllocatedBuffer pending_cleartext_input_;
+  // Nagle-like record batching, opt-in via setRecordBatching(). Cleartext
+  // writes smaller than the watermark are copied into record_batch_ and
+  // acknowledged once the copy is made; the batch is passed to SSL_write()
+  // as one unit when the watermark is crossed or at the end of the loop
+  // turn, producing fewer, fuller TLS records for small-write workloads.
+  size_t record_batch_watermark_ = 0;  // 0 disables batching.
+  std::vector<char> record_batch_;
+  std::vector<WriteWrap*> record_batch_wraps_;
+  bool record_batch_scheduled_ = false;
   size_t write_size_ = 0;
   WriteWrap* current_write_ = nullptr;
   bool in_dowrite_ = false;
@@ -200,6 +261,23 @@ class TLSWrap : public AsyncWrap,
   bool started_ = false;
   bool established_ = false;
   bool shutdown_ = false;
+  // True once the kernel owns the transmit record layer; DoWrite() then
+  // passes cleartext straight through to the underlying stream. See
+  // StartKTLS().
+  bool ktls_tx_ = false;
+  // True once application data went through SSL_write(), at which point the
+  // record sequence number is no longer known and kTLS can not be enabled.
+  bool app_data_written_ = false;
+  // TLS1.3 0-RTT server state. Early data read off the wire before the
+  // handshake completes is parked in early_data_buffer_ until JS arms the
+  // replay gate via acceptEarlyData(); 0-RTT data can be replayed by an
+  // attacker and must not reach request handling before the application
+  // has declared the traffic safe to replay.
+  bool early_data_enabled_ = false;   // enableEarlyData() was called.
+  bool early_data_done_ = false;      // The 0-RTT flight was fully drained.
+  bool early_data_accepted_ = false;  // JS armed the replay gate.
+  bool early_data_announced_ = false;
+  std::vector<char> early_data_buffer_;
   std::string error_;
   int cycle_depth_ = 0;
 
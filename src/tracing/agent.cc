@@ -3,6 +3,7 @@
 #include <string>
 #include "trace_event.h"
 #include "tracing/node_trace_buffer.h"
+#include "tracing/trace_category_state.h"
 #include "debug_utils.h"
 #include "env-inl.h"
 
@@ -17,6 +18,7 @@ class Agent::ScopedSuspendTracing {
     if (do_suspend) {
       CHECK(agent_->started_);
       controller->StopTracing();
+      TraceCategoryState::Reset();
     }
   }
 
@@ -25,6 +27,7 @@ class Agent::ScopedSuspendTracing {
     TraceConfig* config = agent_->CreateTraceConfig();
     if (config != nullptr) {
       controller_->StartTracing(config);
+      TraceCategoryState::Refresh(controller_);
     }
   }
 
@@ -145,6 +148,7 @@ void Agent::StopTracing() {
   // to flush the buffer again on destruction of the V8::Platform.
   tracing_controller_->StopTracing();
   tracing_controller_->Initialize(nullptr);
+  TraceCategoryState::Reset();
   started_ = false;
 
   // Thread should finish when the tracing loop is stopped.
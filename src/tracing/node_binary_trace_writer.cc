@@ -0,0 +1,165 @@
+#include "tracing/node_binary_trace_writer.h"
+
+#include <cstring>
+#include <fcntl.h>
+
+#include "util.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace node {
+namespace tracing {
+
+namespace {
+
+void ReplaceSubstring(std::string* target,
+                      const std::string& search,
+                      const std::string& insert) {
+  size_t pos = target->find(search);
+  for (; pos != std::string::npos; pos = target->find(search, pos)) {
+    target->replace(pos, search.size(), insert);
+    pos += insert.size();
+  }
+}
+
+// Bounded copy into a fixed-width record field. The field is NUL-padded
+// but, like the rest of the record, not necessarily NUL-terminated when
+// the source fills it completely; readers must treat the width as a hard
+// limit.
+void CopyField(char* dest, size_t dest_size, const char* src) {
+  if (src == nullptr) src = "";
+  strncpy(dest, src, dest_size);
+}
+
+}  // namespace
+
+NodeBinaryTraceWriter::NodeBinaryTraceWriter(const std::string& file_pattern,
+                                             uint64_t record_capacity)
+    : file_pattern_(file_pattern), record_capacity_(record_capacity) {
+  CHECK_GT(record_capacity_, 0);
+  OpenRingFile();
+}
+
+NodeBinaryTraceWriter::~NodeBinaryTraceWriter() {
+  CloseRingFile();
+}
+
+void NodeBinaryTraceWriter::OpenRingFile() {
+  std::string filepath(file_pattern_);
+  // The pattern accepts ${pid} like --trace-event-file-pattern does;
+  // ${rotation} makes no sense for a ring that overwrites in place.
+  ReplaceSubstring(&filepath, "${pid}", std::to_string(uv_os_getpid()));
+
+  uv_fs_t req;
+  fd_ = uv_fs_open(nullptr,
+                   &req,
+                   filepath.c_str(),
+                   O_CREAT | O_RDWR | O_TRUNC,
+                   0644,
+                   nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd_ < 0) return;  // Tracing silently becomes a no-op, like ENOSPC.
+
+  mapping_size_ = sizeof(FileHeader) + record_capacity_ * sizeof(Record);
+  int err = uv_fs_ftruncate(nullptr, &req, fd_, mapping_size_, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0) {
+    CloseRingFile();
+    return;
+  }
+
+#ifdef _WIN32
+  HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(fd_));
+  mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, 0,
+                                       nullptr);
+  if (mapping_handle_ != nullptr) {
+    base_ = MapViewOfFile(mapping_handle_, FILE_MAP_ALL_ACCESS, 0, 0,
+                          mapping_size_);
+  }
+#else
+  void* mem = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd_, 0);
+  if (mem != MAP_FAILED) base_ = mem;
+#endif
+  if (base_ == nullptr) {
+    CloseRingFile();
+    return;
+  }
+
+  header_ = static_cast<FileHeader*>(base_);
+  records_ = reinterpret_cast<Record*>(
+      static_cast<char*>(base_) + sizeof(FileHeader));
+  header_->magic = kMagic;
+  header_->version = kVersion;
+  header_->record_size = sizeof(Record);
+  header_->record_capacity = record_capacity_;
+  header_->sequence.store(0, std::memory_order_relaxed);
+}
+
+void NodeBinaryTraceWriter::CloseRingFile() {
+  if (base_ != nullptr) {
+#ifdef _WIN32
+    FlushViewOfFile(base_, mapping_size_);
+    UnmapViewOfFile(base_);
+#else
+    msync(base_, mapping_size_, MS_SYNC);
+    munmap(base_, mapping_size_);
+#endif
+    base_ = nullptr;
+    header_ = nullptr;
+    records_ = nullptr;
+  }
+#ifdef _WIN32
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+    mapping_handle_ = nullptr;
+  }
+#endif
+  if (fd_ >= 0) {
+    uv_fs_t req;
+    uv_fs_close(nullptr, &req, fd_, nullptr);
+    uv_fs_req_cleanup(&req);
+    fd_ = -1;
+  }
+}
+
+void NodeBinaryTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  if (base_ == nullptr) return;
+
+  // Claim a slot. fetch_add makes concurrent appenders (the agent calls
+  // this from one thread today, but the format should not depend on that)
+  // claim distinct slots without a lock; a writer that falls a full lap
+  // behind gets its record overwritten, which is the ring's stated loss
+  // model anyway.
+  uint64_t seq = header_->sequence.fetch_add(1, std::memory_order_relaxed);
+  Record* record = &records_[seq % record_capacity_];
+
+  record->timestamp = trace_event->ts();
+  record->duration = trace_event->duration();
+  record->id = trace_event->id();
+  record->pid = trace_event->pid();
+  record->tid = trace_event->tid();
+  record->phase = trace_event->phase();
+  CopyField(record->name, kNameLength, trace_event->name());
+  CopyField(record->categories,
+            kCategoryLength,
+            v8::platform::tracing::TracingController::GetCategoryGroupName(
+                trace_event->category_enabled_flag()));
+}
+
+void NodeBinaryTraceWriter::Flush(bool blocking) {
+  if (base_ == nullptr) return;
+#ifdef _WIN32
+  FlushViewOfFile(base_, mapping_size_);
+#else
+  msync(base_, mapping_size_, blocking ? MS_SYNC : MS_ASYNC);
+#endif
+}
+
+}  // namespace tracing
+}  // namespace node
@@ -0,0 +1,91 @@
+#ifndef SRC_TRACING_NODE_BINARY_TRACE_WRITER_H_
+#define SRC_TRACING_NODE_BINARY_TRACE_WRITER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "libplatform/v8-tracing.h"
+#include "tracing/agent.h"
+#include "uv.h"
+
+namespace node {
+namespace tracing {
+
+using v8::platform::tracing::TraceObject;
+
+// A trace sink that appends fixed-size binary records to an mmap'd ring
+// file instead of serializing JSON. AppendTraceEvent() does no allocation,
+// no formatting and takes no locks: a slot is claimed with an atomic
+// fetch-add on a sequence counter stored in the file header, so the hot
+// path is a handful of stores plus two bounded string copies. Once the
+// ring wraps, the oldest records are overwritten in place; the sequence
+// counter keeps growing so a reader can tell how many records were ever
+// written and where the ring currently starts. Use
+// tools/trace_ring_to_json.py to convert a ring file to the JSON trace
+// event format offline.
+class NodeBinaryTraceWriter : public AsyncTraceWriter {
+ public:
+  static constexpr uint64_t kMagic = 0x3143525445444F4EULL;  // "NODETRC1"
+  static constexpr uint32_t kVersion = 1;
+  // 128-byte records; the default ring is 1 << 17 records, i.e. 16 MiB.
+  static constexpr uint64_t kDefaultRecordCapacity = 1 << 17;
+  static constexpr size_t kNameLength = 63;
+  static constexpr size_t kCategoryLength = 32;
+
+  // The header occupies the first page of the file so that records start
+  // page-aligned. `sequence` is the only mutable field; it is the total
+  // number of records ever claimed, not an offset into the ring.
+  struct FileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_capacity;
+    std::atomic<uint64_t> sequence;
+    char padding[4096 - 32];
+  };
+
+  struct Record {
+    int64_t timestamp;  // Microseconds, same clock as the JSON writer.
+    uint64_t duration;  // Microseconds.
+    uint64_t id;
+    int32_t pid;
+    int32_t tid;
+    char phase;
+    char name[kNameLength];
+    char categories[kCategoryLength];
+  };
+
+  static_assert(sizeof(FileHeader) == 4096,
+                "trace ring header must fill one page");
+  static_assert(sizeof(Record) == 128,
+                "trace ring records must stay a power-of-two size");
+
+  explicit NodeBinaryTraceWriter(const std::string& file_pattern,
+                                 uint64_t record_capacity =
+                                     kDefaultRecordCapacity);
+  ~NodeBinaryTraceWriter() override;
+
+  void AppendTraceEvent(TraceObject* trace_event) override;
+  void Flush(bool blocking) override;
+
+ private:
+  void OpenRingFile();
+  void CloseRingFile();
+
+  std::string file_pattern_;
+  uint64_t record_capacity_;
+  size_t mapping_size_ = 0;
+  void* base_ = nullptr;
+  FileHeader* header_ = nullptr;
+  Record* records_ = nullptr;
+  int fd_ = -1;
+#ifdef _WIN32
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace tracing
+}  // namespace node
+
+#endif  // SRC_TRACING_NODE_BINARY_TRACE_WRITER_H_
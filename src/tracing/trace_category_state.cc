@@ -0,0 +1,49 @@
+#include "tracing/trace_category_state.h"
+
+#include "node_internals.h"
+#include "tracing/trace_event.h"
+#include "util-inl.h"
+
+namespace node {
+namespace tracing {
+
+namespace {
+
+// Order must match TraceCategoryState::Category. The strings must be the
+// exact category groups used at the trace sites so that the controller
+// resolves the same category-group entry.
+const char* const kCategoryGroups[] = {
+  TRACING_CATEGORY_NODE,
+  TRACING_CATEGORY_NODE1(async_hooks),
+  TRACING_CATEGORY_NODE1(environment),
+  TRACING_CATEGORY_NODE1(stream),
+  TRACING_CATEGORY_NODE1(http2),
+  TRACING_CATEGORY_NODE2(dns, native),
+};
+
+static_assert(arraysize(kCategoryGroups) ==
+                  TraceCategoryState::kCategoryCount,
+              "category group strings out of sync with Category enum");
+
+}  // namespace
+
+std::atomic<uint8_t> TraceCategoryState::enabled_[kCategoryCount] = {};
+
+void TraceCategoryState::Refresh(
+    v8::platform::tracing::TracingController* controller) {
+  for (size_t i = 0; i < kCategoryCount; i++) {
+    uint8_t flags = *controller->GetCategoryGroupEnabled(kCategoryGroups[i]);
+    enabled_[i].store(
+        flags & (kEnabledForRecording_CategoryGroupEnabledFlags |
+                 kEnabledForEventCallback_CategoryGroupEnabledFlags),
+        std::memory_order_relaxed);
+  }
+}
+
+void TraceCategoryState::Reset() {
+  for (size_t i = 0; i < kCategoryCount; i++)
+    enabled_[i].store(0, std::memory_order_relaxed);
+}
+
+}  // namespace tracing
+}  // namespace node
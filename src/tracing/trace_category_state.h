@@ -0,0 +1,59 @@
+#ifndef SRC_TRACING_TRACE_CATEGORY_STATE_H_
+#define SRC_TRACING_TRACE_CATEGORY_STATE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+class TracingController;
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
+
+namespace node {
+namespace tracing {
+
+// Caches the enabled state of a fixed set of hot trace categories in one
+// process-wide byte per category, refreshed by the agent whenever tracing
+// starts or stops. The TRACE_EVENT macros already cache the
+// category-enabled pointer in a per-site static, but the enabled check
+// still costs an atomic load plus a dependent load through that pointer.
+// Call sites that run once per chunk of stream data gate on Enabled()
+// first, which is a single relaxed load and a predictable branch for as
+// long as the category stays disabled.
+class TraceCategoryState {
+ public:
+  // Keep in sync with the category strings in trace_category_state.cc.
+  enum Category : size_t {
+    kNode,
+    kNodeAsyncHooks,
+    kNodeEnvironment,
+    kNodeStream,
+    kNodeHttp2,
+    kNodeDnsNative,
+    kCategoryCount
+  };
+
+  static inline bool Enabled(Category category) {
+    return enabled_[category].load(std::memory_order_relaxed) != 0;
+  }
+
+  // Called by the tracing agent after StartTracing() has applied a new
+  // configuration.
+  static void Refresh(v8::platform::tracing::TracingController* controller);
+
+  // Called by the tracing agent after StopTracing(); every category
+  // reports disabled until the next Refresh().
+  static void Reset();
+
+ private:
+  static std::atomic<uint8_t> enabled_[kCategoryCount];
+};
+
+}  // namespace tracing
+}  // namespace node
+
+#endif  // SRC_TRACING_TRACE_CATEGORY_STATE_H_
@@ -24,10 +24,19 @@
 #include "env-inl.h"
 #include "handle_wrap.h"
 #include "node_buffer.h"
+#include "node_internals.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+#ifdef __POSIX__
+# include <unistd.h>  // write()
+#endif
+
 namespace node {
 
 using v8::Array;
@@ -41,6 +50,25 @@ using v8::Object;
 using v8::String;
 using v8::Value;
 
+namespace {
+
+// Flush a line-buffered batch to the fd once it holds this many bytes even
+// if the loop turn has not finished yet.
+constexpr size_t kBatchHighWaterMark = 64 * 1024;
+
+// Line-buffered TTY wraps, so that ResetStdio() can drain any bytes still
+// parked in their batches when the process is torn down.
+Mutex line_buffered_wraps_mutex;
+std::vector<TTYWrap*> line_buffered_wraps;
+
+}  // anonymous namespace
+
+void FlushPendingTTYBatches() {
+  Mutex::ScopedLock lock(line_buffered_wraps_mutex);
+  for (TTYWrap* wrap : line_buffered_wraps)
+    wrap->FlushBatchOnTeardown();
+}
+
 void TTYWrap::Initialize(Local<Object> target,
                          Local<Value> unused,
                          Local<Context> context,
@@ -57,6 +85,8 @@ void TTYWrap::Initialize(Local<Object> target,
 
   env->SetProtoMethodNoSideEffect(t, "getWindowSize", TTYWrap::GetWindowSize);
   env->SetProtoMethod(t, "setRawMode", SetRawMode);
+  env->SetProtoMethod(t, "setLineBuffered", SetLineBuffered);
+  env->SetProtoMethod(t, "flushLineBuffer", FlushLineBuffer);
 
   env->SetMethodNoSideEffect(target, "isTTY", IsTTY);
 
@@ -110,6 +140,172 @@ void TTYWrap::SetRawMode(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TTYWrap::SetLineBuffered(const FunctionCallbackInfo<Value>& args) {
+  TTYWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  const bool enable = args[0]->IsTrue();
+  if (enable == wrap->line_buffered_)
+    return;
+
+  if (enable) {
+    Mutex::ScopedLock lock(line_buffered_wraps_mutex);
+    line_buffered_wraps.push_back(wrap);
+  } else {
+    wrap->FlushBatch();
+    Mutex::ScopedLock lock(line_buffered_wraps_mutex);
+    auto it = std::find(line_buffered_wraps.begin(),
+                        line_buffered_wraps.end(),
+                        wrap);
+    if (it != line_buffered_wraps.end())
+      line_buffered_wraps.erase(it);
+  }
+  wrap->line_buffered_ = enable;
+}
+
+
+void TTYWrap::FlushLineBuffer(const FunctionCallbackInfo<Value>& args) {
+  TTYWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  wrap->FlushBatch();
+}
+
+
+int TTYWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
+  if (!line_buffered_)
+    return LibuvStreamWrap::DoTryWrite(bufs, count);
+
+  for (size_t i = 0; i < *count; i++)
+    batch_active_.append((*bufs)[i].base, (*bufs)[i].len);
+  *count = 0;
+
+  if (batch_active_.size() + batch_draining_.size() >= kBatchHighWaterMark)
+    FlushBatch();
+  else
+    ScheduleFlush();
+  return 0;
+}
+
+
+void TTYWrap::ScheduleFlush() {
+  if (flush_scheduled_)
+    return;
+  flush_scheduled_ = true;
+  env()->SetImmediate([](Environment* env) { FlushEnvBatches(env); });
+}
+
+
+// Runs once per loop turn when any wrap of this Environment has batched
+// bytes. Looking the wraps up through the registry instead of capturing
+// `this` keeps a pending immediate from touching a wrap that was closed
+// and deleted in the meantime.
+void TTYWrap::FlushEnvBatches(Environment* env) {
+  Mutex::ScopedLock lock(line_buffered_wraps_mutex);
+  for (TTYWrap* wrap : line_buffered_wraps) {
+    if (wrap->env() != env)
+      continue;
+    wrap->flush_scheduled_ = false;
+    wrap->FlushBatch();
+  }
+}
+
+
+void TTYWrap::FlushBatch() {
+  for (;;) {
+    if (batch_draining_.empty()) {
+      if (batch_active_.empty())
+        return;
+      batch_draining_.swap(batch_active_);
+    }
+
+    uv_buf_t buf = uv_buf_init(&batch_draining_[0], batch_draining_.size());
+    uv_buf_t* bufs = &buf;
+    size_t count = 1;
+    const int err = LibuvStreamWrap::DoTryWrite(&bufs, &count);
+    if (err != 0) {
+      // Hard error (e.g. EPIPE): drop the batch. A per-line write would
+      // have reported the same error to exactly one of the batched calls.
+      batch_draining_.clear();
+      batch_active_.clear();
+      return;
+    }
+    if (count != 0) {
+      // The fd would block: keep the remainder for the next loop turn
+      // instead of spinning on EAGAIN.
+      batch_draining_.erase(0, batch_draining_.size() - buf.len);
+      ScheduleFlush();
+      return;
+    }
+    batch_draining_.clear();
+  }
+}
+
+
+void TTYWrap::FlushBatchOnTeardown() {
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd) != 0) {
+    batch_draining_.clear();
+    batch_active_.clear();
+    return;
+  }
+
+  for (std::string* batch : {&batch_draining_, &batch_active_}) {
+    size_t offset = 0;
+    int retries = 100;
+    while (offset < batch->size()) {
+#ifdef _WIN32
+      DWORD written;
+      if (!WriteFile(fd,
+                     batch->data() + offset,
+                     static_cast<DWORD>(batch->size() - offset),
+                     &written,
+                     nullptr)) {
+        break;
+      }
+      offset += written;
+#else
+      ssize_t written = write(fd, batch->data() + offset,
+                              batch->size() - offset);
+      if (written < 0) {
+        if (errno == EINTR)
+          continue;
+        if ((errno == EAGAIN || errno == EWOULDBLOCK) && retries-- > 0) {
+          uv_sleep(1);
+          continue;
+        }
+        break;  // Hard error or a sink that stays blocked: give up.
+      }
+      offset += written;
+#endif
+    }
+    batch->clear();
+  }
+}
+
+
+void TTYWrap::Close(Local<Value> close_callback) {
+  // Push out whatever is still batched while the handle is usable; bytes
+  // the fd does not accept right now are dropped with the handle.
+  FlushBatch();
+  HandleWrap::Close(close_callback);
+}
+
+
+TTYWrap::~TTYWrap() {
+  if (!line_buffered_)
+    return;
+  Mutex::ScopedLock lock(line_buffered_wraps_mutex);
+  auto it = std::find(line_buffered_wraps.begin(),
+                      line_buffered_wraps.end(),
+                      this);
+  if (it != line_buffered_wraps.end())
+    line_buffered_wraps.erase(it);
+}
+
+
 void TTYWrap::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
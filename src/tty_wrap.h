@@ -27,6 +27,8 @@
 #include "uv.h"
 #include "stream_wrap.h"
 
+#include <string>
+
 namespace node {
 
 class Environment;
@@ -42,6 +44,16 @@ class TTYWrap : public LibuvStreamWrap {
   SET_MEMORY_INFO_NAME(TTYWrap)
   SET_SELF_SIZE(TTYWrap)
 
+  ~TTYWrap() override;
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  // Drains any batched bytes with bare writes on the underlying fd. Called
+  // from ResetStdio() during process teardown, so it must not touch the
+  // event loop or allocate.
+  void FlushBatchOnTeardown();
+
  private:
   TTYWrap(Environment* env,
           v8::Local<v8::Object> object,
@@ -52,9 +64,25 @@ class TTYWrap : public LibuvStreamWrap {
   static void IsTTY(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetWindowSize(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetRawMode(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetLineBuffered(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FlushLineBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  // In line-buffered mode DoTryWrite() parks the bytes in a double buffer
+  // instead of issuing one write syscall per console.log() line; the batch
+  // is flushed per loop turn, when it exceeds the high-water mark, and on
+  // close/teardown.
+  int DoTryWrite(uv_buf_t** bufs, size_t* count) override;
+  static void FlushEnvBatches(Environment* env);
+  void FlushBatch();
+  void ScheduleFlush();
+
   uv_tty_t handle_;
+
+  bool line_buffered_ = false;
+  bool flush_scheduled_ = false;
+  std::string batch_active_;    // Bytes parked by DoTryWrite().
+  std::string batch_draining_;  // Bytes a previous flush could not write.
 };
 
 }  // namespace node
@@ -26,6 +26,24 @@
 #include "req_wrap-inl.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <cerrno>
+
+// UDP generic segmentation offload. Send support (UDP_SEGMENT) is available
+// since Linux 4.18, receive coalescing (UDP_GRO) since Linux 5.0; older
+// glibc headers do not carry the definitions.
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
 namespace node {
 
 using v8::Array;
@@ -122,6 +140,10 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "disconnect", Disconnect);
   env->SetProtoMethod(t, "recvStart", RecvStart);
   env->SetProtoMethod(t, "recvStop", RecvStop);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "recvBatch", RecvBatch);
+  env->SetProtoMethod(t, "sendGso", SendGso);
+  env->SetProtoMethod(t, "enableGro", EnableGro);
   env->SetProtoMethod(t, "getpeername",
                       GetSockOrPeerName<UDPWrap, uv_udp_getpeername>);
   env->SetProtoMethod(t, "getsockname",
@@ -575,6 +597,314 @@ void UDPWrap::RecvStop(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// sendBatch(list, count[, port, address])
+// Submits one datagram per buffer in `list` with a single sendmmsg(2) call
+// (in groups of up to 64). All datagrams go to the same destination; `port`
+// and `address` may be omitted for connected sockets. Returns the number of
+// datagrams handed to the kernel; the JS caller is expected to re-submit the
+// remainder (or fall back to the one-at-a-time path) when the send buffer
+// fills up.
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+#ifdef __linux__
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint32());
+  Local<Array> chunks = args[0].As<Array>();
+  const size_t count = args[1].As<Uint32>()->Value();
+
+  int err = 0;
+  struct sockaddr_storage addr_storage;
+  sockaddr* addr = nullptr;
+  if (args.Length() >= 4 && !args[2]->IsUndefined()) {
+    CHECK(args[2]->IsUint32());
+    CHECK(args[3]->IsString());
+    const unsigned short port = args[2].As<Uint32>()->Value();
+    node::Utf8Value address(env->isolate(), args[3]);
+    err = sockaddr_for_family(AF_INET, address.out(), port, &addr_storage);
+    if (err != 0)
+      err = sockaddr_for_family(AF_INET6, address.out(), port, &addr_storage);
+    if (err != 0)
+      return args.GetReturnValue().Set(err);
+    addr = reinterpret_cast<sockaddr*>(&addr_storage);
+  }
+
+  int fd = -1;
+  uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  constexpr size_t kMaxBatch = 64;
+  size_t sent = 0;
+  while (sent < count) {
+    const size_t batch = std::min(kMaxBatch, count - sent);
+    struct mmsghdr msgs[kMaxBatch];
+    struct iovec iovs[kMaxBatch];
+    memset(msgs, 0, sizeof(msgs[0]) * batch);
+
+    for (size_t i = 0; i < batch; i++) {
+      Local<Value> chunk =
+          chunks->Get(env->context(), sent + i).ToLocalChecked();
+      CHECK(Buffer::HasInstance(chunk));
+      iovs[i].iov_base = Buffer::Data(chunk);
+      iovs[i].iov_len = Buffer::Length(chunk);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      if (addr != nullptr) {
+        msgs[i].msg_hdr.msg_name = addr;
+        msgs[i].msg_hdr.msg_namelen = addr->sa_family == AF_INET6 ?
+            sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+      }
+    }
+
+    int n = sendmmsg(fd, msgs, batch, MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+    }
+    sent += n;
+    if (static_cast<size_t>(n) < batch) break;
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(sent));
+#else
+  args.GetReturnValue().Set(UV_ENOSYS);
+#endif  // __linux__
+}
+
+
+// sendGso(buffer, segmentSize[, port, address])
+// Hands one large payload to the kernel, which segments it into
+// `segmentSize`-sized datagrams on the wire (UDP generic segmentation
+// offload): one syscall and one trip down the stack instead of one per
+// datagram. `port` and `address` may be omitted for connected sockets.
+// Returns the number of bytes accepted, 0 when the send buffer is full, and
+// UV_ENOSYS when the kernel lacks UDP GSO so the caller can fall back to
+// sendBatch() or per-packet sends.
+void UDPWrap::SendGso(const FunctionCallbackInfo<Value>& args) {
+#ifdef __linux__
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(Buffer::HasInstance(args[0]));
+  CHECK(args[1]->IsUint32());
+  Local<Value> chunk = args[0];
+  const uint32_t segment_size = args[1].As<Uint32>()->Value();
+  CHECK_GT(segment_size, 0);
+  CHECK_LE(segment_size, 65535);
+
+  int err = 0;
+  struct sockaddr_storage addr_storage;
+  sockaddr* addr = nullptr;
+  if (args.Length() >= 4 && !args[2]->IsUndefined()) {
+    CHECK(args[2]->IsUint32());
+    CHECK(args[3]->IsString());
+    const unsigned short port = args[2].As<Uint32>()->Value();
+    node::Utf8Value address(env->isolate(), args[3]);
+    err = sockaddr_for_family(AF_INET, address.out(), port, &addr_storage);
+    if (err != 0)
+      err = sockaddr_for_family(AF_INET6, address.out(), port, &addr_storage);
+    if (err != 0)
+      return args.GetReturnValue().Set(err);
+    addr = reinterpret_cast<sockaddr*>(&addr_storage);
+  }
+
+  int fd = -1;
+  uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  struct iovec iov;
+  iov.iov_base = Buffer::Data(chunk);
+  iov.iov_len = Buffer::Length(chunk);
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  if (addr != nullptr) {
+    msg.msg_name = addr;
+    msg.msg_namelen = addr->sa_family == AF_INET6 ?
+        sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+  }
+
+  alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) =
+      static_cast<uint16_t>(segment_size);
+
+  ssize_t n;
+  do {
+    n = sendmsg(fd, &msg, MSG_DONTWAIT);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return args.GetReturnValue().Set(0);
+    // Kernels without UDP GSO reject the UDP_SEGMENT ancillary data with
+    // EINVAL; report that as "not implemented" so callers fall back.
+    if (errno == EINVAL || errno == EOPNOTSUPP)
+      return args.GetReturnValue().Set(UV_ENOSYS);
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(n));
+#else
+  args.GetReturnValue().Set(UV_ENOSYS);
+#endif  // __linux__
+}
+
+
+// enableGro()
+// Asks the kernel to coalesce bursts of same-flow datagrams into fewer,
+// larger buffers (UDP generic receive offload). Coalesced entries surface
+// through recvBatch() with a nonzero segment size; size the recvBatch()
+// stride for up to 64KB per entry when enabled. Returns UV_ENOSYS on
+// kernels without UDP_GRO.
+void UDPWrap::EnableGro(const FunctionCallbackInfo<Value>& args) {
+#ifdef __linux__
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  int fd = -1;
+  uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  int on = 1;
+  if (setsockopt(fd, SOL_UDP, UDP_GRO, &on, sizeof(on)) != 0) {
+    if (errno == ENOPROTOOPT)
+      return args.GetReturnValue().Set(UV_ENOSYS);
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+  }
+
+  args.GetReturnValue().Set(0);
+#else
+  args.GetReturnValue().Set(UV_ENOSYS);
+#endif  // __linux__
+}
+
+
+// recvBatch(maxPackets, bytesPerPacket)
+// Drains up to `maxPackets` datagrams (at most 64) in one recvmmsg(2) call.
+// Payloads are packed into a single buffer at fixed `bytesPerPacket`
+// strides; datagrams larger than the stride are truncated, so callers must
+// size it for the largest datagram they expect (up to 64KB per entry when
+// GRO is enabled, see enableGro()). Returns 0 when no data is waiting, a
+// negative libuv error code on failure, and otherwise an array
+// [payloads (Buffer), lengths (Uint32Array), rinfos (Array),
+// segmentSizes (Uint32Array)]. A nonzero segment size means the kernel
+// coalesced several wire datagrams of that size into the one entry.
+void UDPWrap::RecvBatch(const FunctionCallbackInfo<Value>& args) {
+#ifdef __linux__
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  constexpr size_t kMaxBatch = 64;
+  const size_t max_packets =
+      std::min<size_t>(args[0].As<Uint32>()->Value(), kMaxBatch);
+  const size_t stride = args[1].As<Uint32>()->Value();
+  CHECK_GT(max_packets, 0);
+  CHECK_GT(stride, 0);
+
+  int fd = -1;
+  uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  AllocatedBuffer slab = env->AllocateManaged(max_packets * stride);
+  struct mmsghdr msgs[kMaxBatch];
+  struct iovec iovs[kMaxBatch];
+  struct sockaddr_storage addrs[kMaxBatch];
+  alignas(struct cmsghdr) char controls[kMaxBatch][CMSG_SPACE(sizeof(int))];
+  memset(msgs, 0, sizeof(msgs[0]) * max_packets);
+
+  for (size_t i = 0; i < max_packets; i++) {
+    iovs[i].iov_base = slab.data() + i * stride;
+    iovs[i].iov_len = stride;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_control = controls[i];
+    msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+  }
+
+  int n;
+  do {
+    n = recvmmsg(fd, msgs, max_packets, MSG_DONTWAIT, nullptr);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return args.GetReturnValue().Set(0);
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+  }
+  if (n == 0)
+    return args.GetReturnValue().Set(0);
+
+  Local<v8::ArrayBuffer> lengths_ab =
+      v8::ArrayBuffer::New(env->isolate(), n * sizeof(uint32_t));
+  uint32_t* lengths = static_cast<uint32_t*>(lengths_ab->GetContents().Data());
+  Local<v8::ArrayBuffer> segsizes_ab =
+      v8::ArrayBuffer::New(env->isolate(), n * sizeof(uint32_t));
+  uint32_t* segsizes =
+      static_cast<uint32_t*>(segsizes_ab->GetContents().Data());
+  Local<Array> rinfos = Array::New(env->isolate(), n);
+  for (int i = 0; i < n; i++) {
+    lengths[i] = msgs[i].msg_len;
+    segsizes[i] = 0;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+        segsizes[i] = *reinterpret_cast<int*>(CMSG_DATA(cmsg));
+        break;
+      }
+    }
+    rinfos->Set(env->context(),
+                i,
+                AddressToJS(env,
+                            reinterpret_cast<const sockaddr*>(&addrs[i])))
+        .Check();
+  }
+
+  Local<Value> result[] = {
+    slab.ToBuffer().ToLocalChecked(),
+    v8::Uint32Array::New(lengths_ab, 0, n),
+    rinfos,
+    v8::Uint32Array::New(segsizes_ab, 0, n),
+  };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), result, arraysize(result)));
+#else
+  args.GetReturnValue().Set(UV_ENOSYS);
+#endif  // __linux__
+}
+
+
 void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
   std::unique_ptr<SendWrap> req_wrap{static_cast<SendWrap*>(req->data)};
   if (req_wrap->have_callback()) {
@@ -53,6 +53,14 @@ class UDPWrap: public HandleWrap {
   static void Disconnect(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStart(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Batch datagram I/O through sendmmsg(2)/recvmmsg(2) where available;
+  // both return UV_ENOSYS on platforms without those syscalls.
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void RecvBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // UDP generic segmentation/receive offload (Linux); UV_ENOSYS elsewhere
+  // or when the kernel lacks support.
+  static void SendGso(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableGro(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DropMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddSourceSpecificMembership(
@@ -1,7 +1,9 @@
 #include "inspector_socket.h"
 #include "util-inl.h"
+#include "zlib.h"
 #include "gtest/gtest.h"
 
+#include <cstring>
 #include <queue>
 
 #define PORT 9444
@@ -851,4 +853,106 @@ TEST_F(InspectorSocketTest, HostCheckedForUPGRADE) {
   expect_failure_no_delegate(UPGRADE_REQUEST);
 }
 
+TEST_F(InspectorSocketTest, CoalescesFramesWrittenInOneTurn) {
+  do_write(const_cast<char*>(HANDSHAKE_REQ), sizeof(HANDSHAKE_REQ) - 1);
+  SPIN_WHILE(!delegate->inspector_ready);
+  expect_handshake();
+
+  // Both messages are written before the loop runs, so they arrive as
+  // back-to-back frames in order.
+  const char MESSAGE1[] = "abcd";
+  const char MESSAGE2[] = "efgh";
+  const char EXPECTED[] = {'\x81', '\x04', 'a', 'b', 'c', 'd',
+                           '\x81', '\x04', 'e', 'f', 'g', 'h'};
+  delegate->Write(MESSAGE1, sizeof(MESSAGE1) - 1);
+  delegate->Write(MESSAGE2, sizeof(MESSAGE2) - 1);
+  expect_on_client(EXPECTED, sizeof(EXPECTED));
+
+  const char CLIENT_CLOSE_FRAME[] = {'\x88', '\x80', '\x2D',
+                                     '\x0E', '\x1E', '\xFA'};
+  do_write(CLIENT_CLOSE_FRAME, sizeof(CLIENT_CLOSE_FRAME));
+  expect_on_client(SERVER_CLOSE_FRAME, sizeof(SERVER_CLOSE_FRAME));
+}
+
+// Compresses one permessage-deflate message the way a peer would: raw
+// deflate with a sync flush, minus the trailing empty stored block.
+static std::vector<char> deflate_message(z_stream* stream,
+                                         const char* data, size_t len) {
+  std::vector<char> output(deflateBound(stream, len) + 16);
+  stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream->avail_in = len;
+  stream->next_out = reinterpret_cast<Bytef*>(output.data());
+  stream->avail_out = output.size();
+  EXPECT_EQ(Z_OK, deflate(stream, Z_SYNC_FLUSH));
+  output.resize(output.size() - stream->avail_out - 4);
+  return output;
+}
+
+TEST_F(InspectorSocketTest, NegotiatesPermessageDeflate) {
+  const char DEFLATE_HANDSHAKE_REQ[] =
+      "GET /ws/path HTTP/1.1\r\n"
+      "Host: localhost:9229\r\n"
+      "Upgrade: websocket\r\n"
+      "Connection: Upgrade\r\n"
+      "Sec-WebSocket-Key: aaa==\r\n"
+      "Sec-WebSocket-Version: 13\r\n"
+      "Sec-WebSocket-Extensions: permessage-deflate; "
+      "client_max_window_bits\r\n\r\n";
+  do_write(const_cast<char*>(DEFLATE_HANDSHAKE_REQ),
+           sizeof(DEFLATE_HANDSHAKE_REQ) - 1);
+  SPIN_WHILE(!delegate->inspector_ready);
+  const char UPGRADE_RESPONSE[] =
+      "HTTP/1.1 101 Switching Protocols\r\n"
+      "Upgrade: websocket\r\n"
+      "Connection: Upgrade\r\n"
+      "Sec-WebSocket-Accept: Dt87H1OULVZnSJo/KgMUYI7xPCg=\r\n"
+      "Sec-WebSocket-Extensions: permessage-deflate\r\n\r\n";
+  expect_on_client(UPGRADE_RESPONSE, sizeof(UPGRADE_RESPONSE) - 1);
+
+  // Server -> client: the frame has the RSV1 bit set and carries the
+  // compressed payload.
+  z_stream server_stream;
+  memset(&server_stream, 0, sizeof(server_stream));
+  ASSERT_EQ(Z_OK, deflateInit2(&server_stream, Z_DEFAULT_COMPRESSION,
+                               Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY));
+  const char SERVER_MESSAGE[] = "abcd";
+  std::vector<char> compressed =
+      deflate_message(&server_stream, SERVER_MESSAGE,
+                      sizeof(SERVER_MESSAGE) - 1);
+  deflateEnd(&server_stream);
+  std::string expected;
+  expected.push_back('\xC1');
+  expected.push_back(static_cast<char>(compressed.size()));
+  expected.append(compressed.data(), compressed.size());
+  delegate->Write(SERVER_MESSAGE, sizeof(SERVER_MESSAGE) - 1);
+  expect_on_client(expected.data(), expected.size());
+
+  // Client -> server: a masked compressed frame is inflated before it is
+  // passed on.
+  z_stream client_stream;
+  memset(&client_stream, 0, sizeof(client_stream));
+  ASSERT_EQ(Z_OK, deflateInit2(&client_stream, Z_DEFAULT_COMPRESSION,
+                               Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY));
+  const char CLIENT_MESSAGE[] = "1234";
+  std::vector<char> payload =
+      deflate_message(&client_stream, CLIENT_MESSAGE,
+                      sizeof(CLIENT_MESSAGE) - 1);
+  deflateEnd(&client_stream);
+  const char MASK[4] = {'W', 'h', 'O', 'a'};
+  std::string frame;
+  frame.push_back('\xC1');
+  frame.push_back(static_cast<char>(0x80 | payload.size()));
+  frame.append(MASK, sizeof(MASK));
+  for (size_t i = 0; i < payload.size(); i++)
+    frame.push_back(payload[i] ^ MASK[i % sizeof(MASK)]);
+  do_write(frame.data(), frame.size());
+  delegate->ExpectData(CLIENT_MESSAGE, sizeof(CLIENT_MESSAGE) - 1);
+
+  // 3. Close
+  const char CLIENT_CLOSE_FRAME[] = {'\x88', '\x80', '\x2D',
+                                     '\x0E', '\x1E', '\xFA'};
+  do_write(CLIENT_CLOSE_FRAME, sizeof(CLIENT_CLOSE_FRAME));
+  expect_on_client(SERVER_CLOSE_FRAME, sizeof(SERVER_CLOSE_FRAME));
+}
+
 }  // anonymous namespace
@@ -0,0 +1,32 @@
+#include "node_interned_strings.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+using node::FindInternedStringIndex;
+using node::InternedStringSource;
+using node::kInternedStringCount;
+using node::kInternedStringNotFound;
+
+TEST(InternedStringsTest, RoundTrip) {
+  // Every corpus entry must resolve back to its own index.
+  for (size_t i = 0; i < kInternedStringCount; i++) {
+    size_t size;
+    const char* data = InternedStringSource(i, &size);
+    EXPECT_EQ(i, FindInternedStringIndex(data, size));
+  }
+}
+
+TEST(InternedStringsTest, Misses) {
+  auto miss = [](const char* str) {
+    EXPECT_EQ(kInternedStringNotFound,
+              FindInternedStringIndex(str, strlen(str)));
+  };
+  miss("");
+  miss("x-definitely-not-a-header");
+  // Near-misses of corpus entries must be rejected by the byte compare.
+  miss("content-lengt");
+  miss("content-lengthh");
+  miss("Content-Typo");
+}
@@ -0,0 +1,41 @@
+'use strict';
+require('../common');
+
+// Tests that --compile-cache-dir caches ES module compilations on disk and
+// that cached runs still evaluate the module graph correctly.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'compile-cache');
+
+const depFile = path.join(tmpdir.path, 'dep.mjs');
+const entryFile = path.join(tmpdir.path, 'entry.mjs');
+fs.writeFileSync(depFile, 'export const answer = 42;\n');
+fs.writeFileSync(entryFile,
+                 'import { answer } from "./dep.mjs";\n' +
+                 'console.log(answer);\n');
+
+function run() {
+  const child = spawnSync(process.execPath,
+                          [`--compile-cache-dir=${cacheDir}`, entryFile]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return child.stdout.toString().trim();
+}
+
+// Cold run: the modules compile normally and the cache gets populated.
+assert.strictEqual(run(), '42');
+const entries = fs.readdirSync(cacheDir);
+assert.ok(entries.length > 0);
+assert.ok(entries.every((name) => name.endsWith('.cache')));
+
+// Warm run: the cached data is consumed and the result is unchanged.
+assert.strictEqual(run(), '42');
+
+// A modified module must not be served from a stale cache entry.
+fs.writeFileSync(depFile, 'export const answer = 1337;\n');
+assert.strictEqual(run(), '1337');
@@ -0,0 +1,7 @@
+'use strict';
+
+// Worker used by test-child-process-prefork-pool: echoes every task it is
+// sent so the test can tell which worker serviced it.
+process.on('message', (msg) => {
+  process.send({ echo: msg, pid: process.pid });
+});
@@ -0,0 +1,8 @@
+const a = 99;
+setTimeout(() => {
+  if (a === 99) {
+    const b = 101;
+  } else {
+    const c = 102;
+  }
+}, 200);
@@ -0,0 +1,12 @@
+{
+  "targets": [
+    {
+      "target_name": "test_cb_info_view",
+      "sources": [
+        "../common.c",
+        "../entry_point.c",
+        "test_cb_info_view.c"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,12 @@
+'use strict';
+const common = require('../../common');
+const assert = require('assert');
+
+// Testing the callback-info view and per-argument accessors
+const binding = require(`./build/${common.buildType}/test_cb_info_view`);
+
+const result = binding.View(10, 'two', 3);
+assert.strictEqual(result.argc, 3);
+assert.strictEqual(result.second, 'two');
+assert.strictEqual(result.missing, undefined);
+assert.strictEqual(result.self, binding);
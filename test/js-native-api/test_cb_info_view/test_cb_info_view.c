@@ -0,0 +1,50 @@
+#define NAPI_EXPERIMENTAL
+#include <js_native_api.h>
+#include "../common.h"
+
+static int instance_data_value = 1234;
+static char callback_data_tag = 0;
+
+// Returns { argc, second, missing, self } gathered through the view and
+// per-argument accessors; the data/instance-data checks stay in C since the
+// pointers are not representable in JS.
+static napi_value View(napi_env env, napi_callback_info info) {
+  napi_callback_info_view view;
+  NAPI_CALL(env, napi_get_cb_info_view(env, info, &view));
+  NAPI_ASSERT(env, view.data == &callback_data_tag,
+      "view.data should be the descriptor data pointer");
+  NAPI_ASSERT(env, view.instance_data == &instance_data_value,
+      "view.instance_data should match napi_set_instance_data");
+
+  napi_value argc;
+  NAPI_CALL(env, napi_create_uint32(env, (uint32_t)view.argc, &argc));
+
+  napi_value second;
+  NAPI_CALL(env, napi_get_cb_arg(env, info, 1, &second));
+
+  // Out-of-range indexes yield undefined, mirroring napi_get_cb_info.
+  napi_value missing;
+  NAPI_CALL(env, napi_get_cb_arg(env, info, 5, &missing));
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, napi_set_named_property(env, result, "argc", argc));
+  NAPI_CALL(env, napi_set_named_property(env, result, "second", second));
+  NAPI_CALL(env, napi_set_named_property(env, result, "missing", missing));
+  NAPI_CALL(env, napi_set_named_property(env, result, "self", view.this_arg));
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  NAPI_CALL(env, napi_set_instance_data(
+      env, &instance_data_value, NULL, NULL));
+
+  napi_property_descriptor desc = {
+    "View", NULL, View, NULL, NULL, NULL, napi_default, &callback_data_tag
+  };
+  NAPI_CALL(env, napi_define_properties(env, exports, 1, &desc));
+
+  return exports;
+}
+EXTERN_C_END
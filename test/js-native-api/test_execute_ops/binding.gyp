@@ -0,0 +1,12 @@
+{
+  "targets": [
+    {
+      "target_name": "test_execute_ops",
+      "sources": [
+        "../common.c",
+        "../entry_point.c",
+        "test_execute_ops.c"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,23 @@
+'use strict';
+const common = require('../../common');
+const assert = require('assert');
+
+// Testing the vectored call interface
+const test_execute_ops = require(`./build/${common.buildType}/test_execute_ops`);
+
+const source = { x: 42 };
+const arr = [7, 8, 9];
+const fn = (v) => v + 1;
+
+const result = test_execute_ops.ExecuteScript(source, fn, arr);
+assert.deepStrictEqual(result, { y: 42, first: 7, called: 43 });
+assert.deepStrictEqual(arr, [7, 8, 42]);
+
+// Unknown opcodes are rejected with napi_invalid_arg (1).
+assert.strictEqual(test_execute_ops.BadOp(), 1);
+
+// An exception thrown by a called function aborts the op buffer and
+// propagates to the caller.
+assert.throws(() => {
+  test_execute_ops.CallThrowing(() => { throw new RangeError('boom'); });
+}, RangeError);
@@ -0,0 +1,107 @@
+#define NAPI_EXPERIMENTAL
+#include <js_native_api.h>
+#include "../common.h"
+
+// Slot layout shared by the ops in ExecuteScript. kX doubles as the single
+// call argument, so it must directly follow the receiver slot kRecv.
+enum {
+  kResult,
+  kSource,
+  kArr,
+  kKeyX,
+  kKeyY,
+  kKeyFirst,
+  kKeyCalled,
+  kFn,
+  kRecv,
+  kX,
+  kFirst,
+  kCallResult,
+  kSlotCount
+};
+
+// Builds { y: source.x, first: arr[0], called: fn(source.x) } and writes
+// source.x into arr[2], all in one napi_execute_ops() transition.
+static napi_value ExecuteScript(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc == 3, "Expects a source object, function and array");
+
+  napi_value slots[kSlotCount];
+  slots[kSource] = args[0];
+  slots[kFn] = args[1];
+  slots[kArr] = args[2];
+  NAPI_CALL(env, napi_create_string_utf8(env, "x", 1, &slots[kKeyX]));
+  NAPI_CALL(env, napi_create_string_utf8(env, "y", 1, &slots[kKeyY]));
+  NAPI_CALL(env, napi_create_string_utf8(env, "first", 5,
+      &slots[kKeyFirst]));
+  NAPI_CALL(env, napi_create_string_utf8(env, "called", 6,
+      &slots[kKeyCalled]));
+  NAPI_CALL(env, napi_get_undefined(env, &slots[kRecv]));
+
+  const napi_op ops[] = {
+    { napi_op_create_object, 0, 0, 0, kResult },
+    { napi_op_get_property, kSource, kKeyX, 0, kX },
+    { napi_op_set_property, kResult, kKeyY, kX, 0 },
+    { napi_op_get_element, kArr, 0, 0, kFirst },
+    { napi_op_set_element, kArr, 2, kX, 0 },
+    { napi_op_set_property, kResult, kKeyFirst, kFirst, 0 },
+    { napi_op_call_function, kFn, 1, kRecv, kCallResult },
+    { napi_op_set_property, kResult, kKeyCalled, kCallResult, 0 },
+  };
+
+  NAPI_CALL(env, napi_execute_ops(env, ops,
+      sizeof(ops) / sizeof(*ops), slots, kSlotCount));
+
+  return slots[kResult];
+}
+
+// Unknown opcodes must be rejected; the status is handed back to JS.
+static napi_value BadOp(napi_env env, napi_callback_info info) {
+  napi_value slots[1];
+  NAPI_CALL(env, napi_get_undefined(env, &slots[0]));
+
+  const napi_op op = { (napi_op_code)999, 0, 0, 0, 0 };
+  napi_status status = napi_execute_ops(env, &op, 1, slots, 1);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_int32(env, (int32_t)status, &result));
+  return result;
+}
+
+// An exception thrown by a called function must abort the op buffer with
+// napi_pending_exception and propagate to JS.
+static napi_value CallThrowing(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value fn;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &fn, NULL, NULL));
+
+  napi_value slots[2];
+  slots[0] = fn;
+  NAPI_CALL(env, napi_get_undefined(env, &slots[1]));
+
+  const napi_op op = { napi_op_call_function, 0, 0, 1, 1 };
+  napi_status status = napi_execute_ops(env, &op, 1, slots, 2);
+  if (status == napi_pending_exception) {
+    // Leave the exception pending so it propagates to the caller.
+    return NULL;
+  }
+  NAPI_ASSERT(env, false, "expected napi_pending_exception");
+  return NULL;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor descriptors[] = {
+    DECLARE_NAPI_PROPERTY("ExecuteScript", ExecuteScript),
+    DECLARE_NAPI_PROPERTY("BadOp", BadOp),
+    DECLARE_NAPI_PROPERTY("CallThrowing", CallThrowing),
+  };
+
+  NAPI_CALL(env, napi_define_properties(
+      env, exports, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+
+  return exports;
+}
+EXTERN_C_END
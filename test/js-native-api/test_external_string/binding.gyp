@@ -0,0 +1,12 @@
+{
+  "targets": [
+    {
+      "target_name": "test_external_string",
+      "sources": [
+        "../common.c",
+        "../entry_point.c",
+        "test_external_string.c"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,22 @@
+'use strict';
+const common = require('../../common');
+const assert = require('assert');
+
+// Testing external string adoption
+const binding = require(`./build/${common.buildType}/test_external_string`);
+
+// The small string is copied and its finalizer runs synchronously; the
+// copy/finalize assertions live in the addon.
+assert.strictEqual(binding.CreateSmallLatin1(), 'small external');
+
+const largeLatin1 = binding.CreateLargeLatin1();
+assert.strictEqual(largeLatin1.length, 256);
+assert.strictEqual(largeLatin1[0], 'a');
+assert.strictEqual(largeLatin1[255], 'z');
+assert.ok(largeLatin1.slice(1, 255).split('').every((c) => c === 'x'));
+
+const largeUtf16 = binding.CreateLargeUtf16();
+assert.strictEqual(largeUtf16.length, 256);
+assert.strictEqual(largeUtf16[0], 'a');
+assert.strictEqual(largeUtf16[255], 'z');
+assert.ok(largeUtf16.slice(1, 255).split('').every((c) => c === 'y'));
@@ -0,0 +1,74 @@
+#define NAPI_EXPERIMENTAL
+#include <js_native_api.h>
+#include <string.h>
+#include "../common.h"
+
+// Large buffers are adopted by the engine and must stay alive and unchanged
+// for as long as the strings exist, hence static storage.
+#define LARGE_LENGTH 256
+static char large_latin1[LARGE_LENGTH + 1];
+static char16_t large_utf16[LARGE_LENGTH + 1];
+
+static char small_latin1[] = "small external";
+static int small_finalized = 0;
+
+static void FinalizeSmall(napi_env env, void* data, void* hint) {
+  if (data == small_latin1) small_finalized++;
+}
+
+// Small strings fall back to a copy; the finalizer must run before the
+// creating call returns.
+static napi_value CreateSmallLatin1(napi_env env, napi_callback_info info) {
+  napi_value result;
+  bool copied = false;
+  NAPI_CALL(env, napi_create_external_string_latin1(
+      env, small_latin1, NAPI_AUTO_LENGTH,
+      FinalizeSmall, NULL, &result, &copied));
+  NAPI_ASSERT(env, copied, "small string should be copied");
+  NAPI_ASSERT(env, small_finalized == 1,
+      "copy fallback should finalize immediately");
+  return result;
+}
+
+static napi_value CreateLargeLatin1(napi_env env, napi_callback_info info) {
+  memset(large_latin1, 'x', LARGE_LENGTH);
+  large_latin1[0] = 'a';
+  large_latin1[LARGE_LENGTH - 1] = 'z';
+  large_latin1[LARGE_LENGTH] = '\0';
+
+  napi_value result;
+  bool copied = true;
+  NAPI_CALL(env, napi_create_external_string_latin1(
+      env, large_latin1, LARGE_LENGTH, NULL, NULL, &result, &copied));
+  NAPI_ASSERT(env, !copied, "large string should be adopted, not copied");
+  return result;
+}
+
+static napi_value CreateLargeUtf16(napi_env env, napi_callback_info info) {
+  for (size_t i = 0; i < LARGE_LENGTH; i++) large_utf16[i] = u'y';
+  large_utf16[0] = u'a';
+  large_utf16[LARGE_LENGTH - 1] = u'z';
+  large_utf16[LARGE_LENGTH] = u'\0';
+
+  napi_value result;
+  bool copied = true;
+  NAPI_CALL(env, napi_create_external_string_utf16(
+      env, large_utf16, LARGE_LENGTH, NULL, NULL, &result, &copied));
+  NAPI_ASSERT(env, !copied, "large string should be adopted, not copied");
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NAPI_PROPERTY("CreateSmallLatin1", CreateSmallLatin1),
+    DECLARE_NAPI_PROPERTY("CreateLargeLatin1", CreateLargeLatin1),
+    DECLARE_NAPI_PROPERTY("CreateLargeUtf16", CreateLargeUtf16),
+  };
+
+  NAPI_CALL(env, napi_define_properties(
+      env, exports, sizeof(properties) / sizeof(*properties), properties));
+
+  return exports;
+}
+EXTERN_C_END
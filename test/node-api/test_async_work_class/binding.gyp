@@ -0,0 +1,8 @@
+{
+  "targets": [
+    {
+      "target_name": "test_async_work_class",
+      "sources": [ "test_async_work_class.cc" ]
+    }
+  ]
+}
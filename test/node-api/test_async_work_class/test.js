@@ -0,0 +1,26 @@
+'use strict';
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/test_async_work_class`);
+
+const BLOCKING_IO = 0;
+const CPU_BOUND = 1;
+
+// Both scheduling classes execute and complete normally.
+binding.Test(BLOCKING_IO, 5, common.mustCall((val) => {
+  assert.strictEqual(val, 10);
+}));
+binding.Test(CPU_BOUND, 21, common.mustCall((val) => {
+  assert.strictEqual(val, 42);
+}));
+
+// Several queued items of the same class all complete, exercising the
+// per-env pooling of recycled work objects.
+for (let i = 0; i < 8; i++) {
+  binding.Test(CPU_BOUND, i, common.mustCall((val) => {
+    assert.strictEqual(val, i * 2);
+  }));
+}
+
+// Out-of-range classes are rejected with napi_invalid_arg (1).
+assert.strictEqual(binding.BadClass(), 1);
@@ -0,0 +1,102 @@
+#define NAPI_EXPERIMENTAL
+#include <stdlib.h>
+#include <node_api.h>
+#include "../../js-native-api/common.h"
+
+typedef struct {
+  int32_t _input;
+  int32_t _output;
+  napi_ref _callback;
+  napi_async_work _request;
+} carrier;
+
+static void Execute(napi_env env, void* data) {
+  carrier* c = static_cast<carrier*>(data);
+  c->_output = c->_input * 2;
+}
+
+static void Complete(napi_env env, napi_status status, void* data) {
+  carrier* c = static_cast<carrier*>(data);
+
+  if (status != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Execute callback failed.");
+    return;
+  }
+
+  napi_value result;
+  NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, c->_output, &result));
+  napi_value callback;
+  NAPI_CALL_RETURN_VOID(env,
+      napi_get_reference_value(env, c->_callback, &callback));
+  napi_value global;
+  NAPI_CALL_RETURN_VOID(env, napi_get_global(env, &global));
+
+  napi_value unused;
+  NAPI_CALL_RETURN_VOID(env,
+      napi_call_function(env, global, callback, 1, &result, &unused));
+
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, c->_callback));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, c->_request));
+  free(c);
+}
+
+// Test(workClass, input, callback): queues a work item of the given class
+// which doubles `input` and passes the result to `callback`.
+static napi_value Test(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  NAPI_ASSERT(env, argc == 3, "Expects a class, a number and a function.");
+
+  int32_t work_class;
+  NAPI_CALL(env, napi_get_value_int32(env, argv[0], &work_class));
+
+  carrier* c = static_cast<carrier*>(malloc(sizeof(carrier)));
+  NAPI_CALL(env, napi_get_value_int32(env, argv[1], &c->_input));
+  NAPI_CALL(env, napi_create_reference(env, argv[2], 1, &c->_callback));
+
+  napi_value resource_name;
+  NAPI_CALL(env, napi_create_string_utf8(
+      env, "TestResource", NAPI_AUTO_LENGTH, &resource_name));
+  NAPI_CALL(env, napi_create_async_work_with_class(
+      env, nullptr, resource_name,
+      static_cast<napi_async_work_class>(work_class),
+      Execute, Complete, c, &c->_request));
+  NAPI_CALL(env, napi_queue_async_work(env, c->_request));
+
+  return nullptr;
+}
+
+// Creating work with an out-of-range class must fail; the status is handed
+// back to JS.
+static napi_value BadClass(napi_env env, napi_callback_info info) {
+  napi_value resource_name;
+  NAPI_CALL(env, napi_create_string_utf8(
+      env, "TestResource", NAPI_AUTO_LENGTH, &resource_name));
+
+  napi_async_work work;
+  napi_status status = napi_create_async_work_with_class(
+      env, nullptr, resource_name,
+      static_cast<napi_async_work_class>(1000),
+      Execute, Complete, nullptr, &work);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_int32(env, (int32_t)status, &result));
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NAPI_PROPERTY("Test", Test),
+    DECLARE_NAPI_PROPERTY("BadClass", BadClass),
+  };
+
+  NAPI_CALL(env, napi_define_properties(
+      env, exports, sizeof(properties) / sizeof(*properties), properties));
+
+  return exports;
+}
+EXTERN_C_END
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,86 @@
+// Exercises the registration-based external buffer API: one finalization
+// table is created up front and every buffer only passes an index and a
+// generation, so externalizing a chunk performs no per-buffer finalizer
+// allocation. The finalize callback must report the exact slot and
+// generation the buffer was created with.
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+#include <string.h>
+#include "../../js-native-api/common.h"
+
+#define TABLE_CAPACITY 4
+#define SLOT_SIZE 16
+
+static napi_external_buffer_table table = NULL;
+static char slots[TABLE_CAPACITY][SLOT_SIZE];
+static int finalize_count = 0;
+static size_t last_index = 0;
+static uint32_t last_generation = 0;
+
+static void finalize_slot(napi_env env, void* data, void* hint,
+                          size_t index, uint32_t generation) {
+  if (index >= TABLE_CAPACITY || data != slots[index]) {
+    napi_fatal_error("finalize_slot", NAPI_AUTO_LENGTH,
+        "unexpected data pointer", NAPI_AUTO_LENGTH);
+  }
+  finalize_count++;
+  last_index = index;
+  last_generation = generation;
+}
+
+static napi_value CreateTable(napi_env env, napi_callback_info info) {
+  NAPI_CALL(env, napi_create_external_buffer_table(env, TABLE_CAPACITY,
+      finalize_slot, NULL, &table));
+  return NULL;
+}
+
+static napi_value CreateBuffer(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], result;
+  uint32_t index, generation;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &index));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[1], &generation));
+  NAPI_ASSERT(env, index < TABLE_CAPACITY, "index within table capacity");
+
+  memset(slots[index], (int)index, SLOT_SIZE);
+  NAPI_CALL(env, napi_create_external_buffer_with_table(env, SLOT_SIZE,
+      slots[index], table, index, generation, &result));
+  return result;
+}
+
+static napi_value LastFinalize(napi_env env, napi_callback_info info) {
+  napi_value result, value;
+
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, napi_create_int32(env, finalize_count, &value));
+  NAPI_CALL(env, napi_set_named_property(env, result, "count", value));
+  NAPI_CALL(env, napi_create_uint32(env, (uint32_t)last_index, &value));
+  NAPI_CALL(env, napi_set_named_property(env, result, "index", value));
+  NAPI_CALL(env, napi_create_uint32(env, last_generation, &value));
+  NAPI_CALL(env, napi_set_named_property(env, result, "generation", value));
+  return result;
+}
+
+static napi_value DeleteTable(napi_env env, napi_callback_info info) {
+  NAPI_CALL(env, napi_delete_external_buffer_table(env, table));
+  table = NULL;
+  return NULL;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NAPI_PROPERTY("createTable", CreateTable),
+    DECLARE_NAPI_PROPERTY("createBuffer", CreateBuffer),
+    DECLARE_NAPI_PROPERTY("lastFinalize", LastFinalize),
+    DECLARE_NAPI_PROPERTY("deleteTable", DeleteTable),
+  };
+
+  NAPI_CALL(env, napi_define_properties(env, exports,
+      sizeof(properties) / sizeof(properties[0]), properties));
+
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
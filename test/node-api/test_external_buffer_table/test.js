@@ -0,0 +1,37 @@
+// Flags: --expose-gc
+'use strict';
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/binding`);
+
+// External buffers created through a finalization table must invoke the
+// table's finalize callback with the index and generation they were created
+// with once they are collected.
+
+binding.createTable();
+
+{
+  let buf = binding.createBuffer(2, 7);
+  assert.strictEqual(buf.length, 16);
+  assert.strictEqual(buf[0], 2);
+  buf = null;
+}
+
+// Finalization runs from an immediate scheduled by the GC callback, so keep
+// collecting and turning the loop until it has happened.
+function gcUntilFinalized(ticks) {
+  assert(ticks > 0, 'external buffer was never finalized');
+  global.gc();
+  setImmediate(common.mustCall(() => {
+    if (binding.lastFinalize().count === 0)
+      return gcUntilFinalized(ticks - 1);
+    const info = binding.lastFinalize();
+    assert.strictEqual(info.count, 1);
+    assert.strictEqual(info.index, 2);
+    assert.strictEqual(info.generation, 7);
+    binding.deleteTable();
+  }));
+}
+
+gcUntilFinalized(10);
@@ -0,0 +1,139 @@
+// Exercises the lock-free queue used by thread-safe functions without a
+// maximum queue size, together with the experimental batch callback: several
+// producer threads push integers as fast as they can, and the batch callback
+// forwards each drained batch to JS as one array so the test can verify that
+// every item arrives exactly once and that deliveries are actually batched.
+#define NAPI_EXPERIMENTAL
+#include <uv.h>
+#include <node_api.h>
+#include "../../js-native-api/common.h"
+
+#define THREAD_COUNT 4
+#define ITEMS_PER_THREAD 1000
+
+static uv_thread_t uv_threads[THREAD_COUNT];
+static napi_threadsafe_function ts_fn;
+static napi_ref js_finalize_cb;
+
+// Thread data to transmit to JS. Pre-filled with 0 .. (total - 1); thread t
+// owns the slice starting at t * ITEMS_PER_THREAD.
+static int ints[THREAD_COUNT * ITEMS_PER_THREAD];
+
+// Source thread producing the data.
+static void data_source_thread(void* data) {
+  int* start = data;
+  int index;
+
+  for (index = 0; index < ITEMS_PER_THREAD; index++) {
+    if (napi_call_threadsafe_function(ts_fn, &start[index],
+        napi_tsfn_nonblocking) != napi_ok) {
+      napi_fatal_error("data_source_thread", NAPI_AUTO_LENGTH,
+          "napi_call_threadsafe_function failed", NAPI_AUTO_LENGTH);
+    }
+  }
+
+  if (napi_release_threadsafe_function(ts_fn, napi_tsfn_release) != napi_ok) {
+    napi_fatal_error("data_source_thread", NAPI_AUTO_LENGTH,
+        "napi_release_threadsafe_function failed", NAPI_AUTO_LENGTH);
+  }
+}
+
+// Getting a whole batch of data into JS in one invocation.
+static void call_js_batch(napi_env env, napi_value cb, void* hint,
+                          void** data, size_t count) {
+  size_t index;
+
+  if (env == NULL || cb == NULL) {
+    return;
+  }
+
+  napi_value batch, item, undefined;
+  NAPI_CALL_RETURN_VOID(env, napi_create_array_with_length(env, count,
+      &batch));
+  for (index = 0; index < count; index++) {
+    NAPI_CALL_RETURN_VOID(env,
+        napi_create_int32(env, *(int*)data[index], &item));
+    NAPI_CALL_RETURN_VOID(env, napi_set_element(env, batch, index, item));
+  }
+  NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, undefined, cb, 1, &batch,
+      NULL));
+}
+
+// Join the threads and inform JS that we're done.
+static void join_the_threads(napi_env env, void* data, void* hint) {
+  uv_thread_t* the_threads = data;
+  napi_value js_cb, undefined;
+  int index;
+
+  for (index = 0; index < THREAD_COUNT; index++) {
+    uv_thread_join(&the_threads[index]);
+  }
+
+  NAPI_CALL_RETURN_VOID(env,
+      napi_get_reference_value(env, js_finalize_cb, &js_cb));
+  NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, undefined, js_cb, 0,
+      NULL, NULL));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, js_finalize_cb));
+  ts_fn = NULL;
+}
+
+// StartThreads(batchCallback, doneCallback)
+static napi_value StartThreads(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], async_name;
+  int index;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_ASSERT(env, argc == 2, "Exactly two arguments were received");
+  NAPI_CALL(env, napi_create_reference(env, argv[1], 1, &js_finalize_cb));
+
+  for (index = 0; index < THREAD_COUNT * ITEMS_PER_THREAD; index++) {
+    ints[index] = index;
+  }
+
+  NAPI_CALL(env, napi_create_string_utf8(env, "N-API thread-safe function "
+      "batch test", NAPI_AUTO_LENGTH, &async_name));
+  NAPI_CALL(env, napi_create_threadsafe_function(env, argv[0], NULL,
+      async_name, 0, THREAD_COUNT, uv_threads, join_the_threads, NULL,
+      NULL, &ts_fn));
+  NAPI_CALL(env, napi_set_threadsafe_function_batch_callback(ts_fn,
+      call_js_batch));
+
+  for (index = 0; index < THREAD_COUNT; index++) {
+    NAPI_ASSERT(env, uv_thread_create(&uv_threads[index], data_source_thread,
+        &ints[index * ITEMS_PER_THREAD]) == 0,
+        "Thread creation succeeded");
+  }
+
+  return NULL;
+}
+
+// Module init
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_value thread_count, items_per_thread;
+
+  NAPI_CALL(env, napi_create_uint32(env, THREAD_COUNT, &thread_count));
+  NAPI_CALL(env,
+      napi_create_uint32(env, ITEMS_PER_THREAD, &items_per_thread));
+
+  napi_property_descriptor properties[] = {
+    {
+      "THREAD_COUNT", NULL, NULL, NULL, NULL, thread_count,
+      napi_enumerable, NULL
+    },
+    {
+      "ITEMS_PER_THREAD", NULL, NULL, NULL, NULL, items_per_thread,
+      napi_enumerable, NULL
+    },
+    DECLARE_NAPI_PROPERTY("StartThreads", StartThreads),
+  };
+
+  NAPI_CALL(env, napi_define_properties(env, exports,
+      sizeof(properties) / sizeof(properties[0]), properties));
+
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,32 @@
+'use strict';
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/binding`);
+
+// Four native threads push 1000 integers each through an unbounded
+// thread-safe function with a batch callback installed. Every item must
+// arrive exactly once, each delivery must be a non-empty array, and with
+// producers racing far ahead of the loop thread at least one delivery is
+// expected to carry more than one item.
+
+const total = binding.THREAD_COUNT * binding.ITEMS_PER_THREAD;
+const received = [];
+let batches = 0;
+let largestBatch = 0;
+
+binding.StartThreads((batch) => {
+  assert(Array.isArray(batch));
+  assert(batch.length > 0);
+  batches++;
+  largestBatch = Math.max(largestBatch, batch.length);
+  received.push(...batch);
+}, common.mustCall(() => {
+  assert.strictEqual(received.length, total);
+  received.sort((a, b) => a - b);
+  for (let i = 0; i < total; i++)
+    assert.strictEqual(received[i], i);
+  assert(batches <= total);
+  assert(largestBatch > 1,
+         `expected at least one batched delivery, largest was ${largestBatch}`);
+}));
@@ -0,0 +1,46 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const net = require('net');
+
+// The async context frame set before creating an async resource must be
+// observable again from inside that resource's callbacks, without any hooks
+// being enabled, and independently for interleaved contexts.
+
+assert.strictEqual(async_hooks.getAsyncContextFrame(), undefined);
+
+const frameA = { name: 'a' };
+const frameB = { name: 'b' };
+
+// Native resources: each TCP handle propagates the frame that was current
+// when it was created into its own callbacks.
+async_hooks.setAsyncContextFrame(frameA);
+const server = net.createServer(common.mustCall((conn) => {
+  // The connection handle was accepted inside the server's callback scope,
+  // so it inherits the server's frame.
+  assert.strictEqual(async_hooks.getAsyncContextFrame(), frameA);
+  conn.end('x');
+  server.close();
+}));
+server.listen(0, common.mustCall(() => {
+  async_hooks.setAsyncContextFrame(frameB);
+  const client = net.connect(server.address().port);
+  async_hooks.setAsyncContextFrame(undefined);
+
+  client.on('data', common.mustCall(() => {
+    assert.strictEqual(async_hooks.getAsyncContextFrame(), frameB);
+    client.end();
+  }));
+}));
+async_hooks.setAsyncContextFrame(undefined);
+
+// JS resources: AsyncResource captures and restores the frame as well.
+async_hooks.setAsyncContextFrame(frameA);
+const resource = new async_hooks.AsyncResource('FRAME_TEST');
+async_hooks.setAsyncContextFrame(undefined);
+
+resource.runInAsyncScope(common.mustCall(() => {
+  assert.strictEqual(async_hooks.getAsyncContextFrame(), frameA);
+}));
+assert.strictEqual(async_hooks.getAsyncContextFrame(), undefined);
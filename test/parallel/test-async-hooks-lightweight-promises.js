@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+
+// In 'lightweight' promise tracking mode no PromiseWrap is allocated; ids
+// live on the promise itself and init/promiseResolve events arrive in
+// batches. Context propagation must be exact, init must carry the parent
+// promise's id as triggerAsyncId, and all init resources must be the same
+// shared placeholder object.
+
+assert.throws(() => async_hooks.setPromiseTrackingMode('sparse'),
+              { code: 'ERR_INVALID_ARG_VALUE' });
+
+async_hooks.setPromiseTrackingMode('lightweight');
+
+const inits = new Map();
+const resolved = new Set();
+
+const hook = async_hooks.createHook({
+  init(asyncId, type, triggerAsyncId, resource) {
+    if (type === 'PROMISE')
+      inits.set(asyncId, { triggerAsyncId, resource });
+  },
+  promiseResolve(asyncId) { resolved.add(asyncId); },
+}).enable();
+
+const parent = Promise.resolve(42);
+const child = parent.then(common.mustCall((value) => {
+  assert.strictEqual(value, 42);
+  return async_hooks.executionAsyncId();
+}));
+
+child.then(common.mustCall((childId) => {
+  // The then() callback observed the chained promise's own async id.
+  assert.ok(childId > 0);
+
+  // Batched events are delivered no later than the next loop turn.
+  setImmediate(common.mustCall(() => {
+    assert.ok(inits.has(childId));
+    const childInit = inits.get(childId);
+
+    // The chained promise was triggered by its parent, whose own init was
+    // observed as well.
+    assert.ok(inits.has(childInit.triggerAsyncId));
+
+    // No per-promise resources: every PROMISE init saw the same object.
+    const resources = new Set();
+    for (const { resource } of inits.values())
+      resources.add(resource);
+    assert.strictEqual(resources.size, 1);
+
+    // Both promises in the chain reported resolution.
+    assert.ok(resolved.has(childId));
+    assert.ok(resolved.has(childInit.triggerAsyncId));
+
+    hook.disable();
+    async_hooks.setPromiseTrackingMode('full');
+  }));
+}));
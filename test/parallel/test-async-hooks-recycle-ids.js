@@ -0,0 +1,29 @@
+// Flags: --recycle-async-ids
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const fs = require('fs');
+
+// With --recycle-async-ids, the id of a destroyed native resource is handed
+// out again to a later one instead of growing the counter forever. No
+// destroy hook is registered here, so the id becomes reusable as soon as
+// the resource is torn down.
+
+const fsReqIds = [];
+async_hooks.createHook({
+  init(asyncId, type) {
+    if (type === 'FSREQCALLBACK')
+      fsReqIds.push(asyncId);
+  },
+}).enable();
+
+fs.stat(__filename, common.mustCall(() => {
+  // Let the request wrap finish destruction before the next one is created.
+  setImmediate(common.mustCall(() => {
+    fs.stat(__filename, common.mustCall(() => {
+      assert.strictEqual(fsReqIds.length, 2);
+      assert.strictEqual(fsReqIds[1], fsReqIds[0]);
+    }));
+  }));
+}));
@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+
+// With a sample interval of N, only one in N async resources should receive
+// hook callbacks, and a sampled resource must get its complete
+// init/before/after/destroy sequence. Context tracking must keep working for
+// unsampled resources.
+
+assert.throws(() => async_hooks.setSampleInterval(-1), { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => async_hooks.setSampleInterval('2'), { code: 'ERR_INVALID_ARG_TYPE' });
+
+const seenInit = new Set();
+const seenBefore = new Set();
+
+const hook = async_hooks.createHook({
+  init(asyncId) { seenInit.add(asyncId); },
+  before(asyncId) { seenBefore.add(asyncId); },
+}).enable();
+
+async_hooks.setSampleInterval(1000000);
+
+const resources = [];
+for (let i = 0; i < 100; i++)
+  resources.push(new async_hooks.AsyncResource('SAMPLED_TEST'));
+
+// With such a sparse interval, at most a handful of the 100 consecutive ids
+// can fall on a sampled slot.
+const sampled = resources.filter((r) => seenInit.has(r.asyncId()));
+assert.ok(sampled.length <= 1,
+          `expected at most 1 sampled resource, got ${sampled.length}`);
+
+// before()/after() of an unsampled resource must not fire, but the async id
+// stack must still be maintained.
+const unsampled = resources.find((r) => !seenInit.has(r.asyncId()));
+unsampled.runInAsyncScope(common.mustCall(() => {
+  assert.strictEqual(async_hooks.executionAsyncId(), unsampled.asyncId());
+}));
+assert.ok(!seenBefore.has(unsampled.asyncId()));
+
+// Restoring full fidelity brings every new resource back.
+async_hooks.setSampleInterval(0);
+const always = new async_hooks.AsyncResource('SAMPLED_TEST');
+assert.ok(seenInit.has(always.asyncId()));
+always.runInAsyncScope(() => {});
+assert.ok(seenBefore.has(always.asyncId()));
+
+hook.disable();
@@ -0,0 +1,73 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// Buffer#indexOfAny() reports the leftmost occurrence of any needle, with
+// ties going to the needle listed first, and matches a per-needle
+// indexOf() scan on random inputs.
+
+const buf = Buffer.from('key: value\r\n');
+
+assert.deepStrictEqual(buf.indexOfAny([':', '\r\n', '\n']),
+                       { offset: 3, needle: 0 });
+assert.deepStrictEqual(buf.indexOfAny(['\r\n', '\n'], 4),
+                       { offset: 10, needle: 0 });
+assert.strictEqual(buf.indexOfAny(['=', ';']), null);
+
+// Ties at the same offset resolve to the first listed needle.
+assert.deepStrictEqual(buf.indexOfAny(['\n', '\r\n'], 4),
+                       { offset: 10, needle: 1 });
+assert.deepStrictEqual(Buffer.from('abc').indexOfAny(['ab', 'abc']),
+                       { offset: 0, needle: 0 });
+
+// Buffer and Uint8Array needles match byte-wise.
+assert.deepStrictEqual(buf.indexOfAny([Buffer.from('value')]),
+                       { offset: 5, needle: 0 });
+assert.deepStrictEqual(buf.indexOfAny([new Uint8Array([0x76])]),
+                       { offset: 5, needle: 0 });
+
+// String needles honor the encoding argument.
+const utf16 = Buffer.from('ΚΑΣ', 'utf16le');
+assert.deepStrictEqual(utf16.indexOfAny(['Σ'], 0, 'utf16le'),
+                       { offset: 4, needle: 0 });
+
+// A byteOffset past the end of the buffer never matches.
+assert.strictEqual(buf.indexOfAny([':'], buf.length), null);
+// A NaN byteOffset searches the whole buffer, as indexOf() does.
+assert.deepStrictEqual(buf.indexOfAny([':'], {}), { offset: 3, needle: 0 });
+
+// Argument validation.
+assert.throws(() => buf.indexOfAny('nope'), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => buf.indexOfAny([]), { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => buf.indexOfAny(new Array(33).fill('a')),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => buf.indexOfAny([42]), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => buf.indexOfAny(['']), { code: 'ERR_INVALID_ARG_VALUE' });
+
+// Differential check against one indexOf() scan per needle.
+function naive(haystack, needles, byteOffset) {
+  let best = null;
+  for (let i = 0; i < needles.length; i++) {
+    const offset = haystack.indexOf(needles[i], byteOffset);
+    if (offset === -1)
+      continue;
+    if (best === null || offset < best.offset)
+      best = { offset, needle: i };
+  }
+  return best;
+}
+
+{
+  const alphabet = 'aabbc';
+  const needles = ['ab', 'bc', 'ca', 'aab', 'b'];
+  for (let round = 0; round < 200; round++) {
+    const len = 1 + (round * 7) % 257;
+    const haystack = Buffer.alloc(len);
+    for (let i = 0; i < len; i++)
+      haystack[i] = alphabet.charCodeAt((i * 31 + round) % alphabet.length);
+    const byteOffset = round % 5;
+    assert.deepStrictEqual(haystack.indexOfAny(needles, byteOffset),
+                           naive(haystack, needles, byteOffset),
+                           `round ${round}`);
+  }
+}
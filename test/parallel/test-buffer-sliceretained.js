@@ -0,0 +1,51 @@
+// Flags: --expose-gc
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// Buffer#sliceRetained() returns a zero-copy view with its own
+// ArrayBuffer that stays valid after the source has been collected.
+
+{
+  const src = Buffer.from('0123456789');
+  const view = src.sliceRetained(2, 6);
+
+  assert.ok(Buffer.isBuffer(view));
+  assert.strictEqual(view.toString(), '2345');
+
+  // The memory is shared: writes are visible in both directions.
+  view[0] = 0x61;
+  assert.strictEqual(src[2], 0x61);
+  src[3] = 0x62;
+  assert.strictEqual(view[1], 0x62);
+
+  // The view is backed by its own ArrayBuffer, not the source's.
+  assert.notStrictEqual(view.buffer, src.buffer);
+  assert.strictEqual(view.byteOffset, 0);
+  assert.strictEqual(view.buffer.byteLength, view.length);
+}
+
+// Offset handling mirrors slice().
+{
+  const src = Buffer.from('0123456789');
+  assert.strictEqual(src.sliceRetained().toString(), '0123456789');
+  assert.strictEqual(src.sliceRetained(-4).toString(), '6789');
+  assert.strictEqual(src.sliceRetained(-4, -2).toString(), '67');
+  assert.strictEqual(src.sliceRetained(6, 3).length, 0);
+  assert.strictEqual(src.sliceRetained(100).length, 0);
+  assert.strictEqual(src.sliceRetained(0, 100).length, src.length);
+}
+
+// The retained view survives collection of the source buffer.
+{
+  let view;
+  {
+    let src = Buffer.alloc(1024 * 1024);
+    src.write('still here', 1000);
+    view = src.sliceRetained(1000, 1010);
+    src = null;
+  }
+  global.gc();
+  global.gc();
+  assert.strictEqual(view.toString(), 'still here');
+}
@@ -0,0 +1,37 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const { PreforkPool } = require('internal/child_process/prefork_pool');
+
+const pool = new PreforkPool(fixtures.path('prefork-pool-worker.js'),
+                             { size: 2 });
+
+// The pool forks its workers up front.
+assert.strictEqual(pool.idleCount, 2);
+
+assert.throws(() => new PreforkPool(fixtures.path('prefork-pool-worker.js'),
+                                    { size: 0 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+
+const worker = pool.acquire();
+assert(worker.pid > 0);
+// The handed-out worker was replaced in the background.
+assert.strictEqual(pool.idleCount, 2);
+
+worker.send({ task: 42 });
+worker.on('message', common.mustCall((msg) => {
+  assert.strictEqual(msg.echo.task, 42);
+  assert.strictEqual(msg.pid, worker.pid);
+
+  // Releasing puts the still-healthy worker back into the pool...
+  pool.release(worker);
+  assert.strictEqual(pool.idleCount, 2);
+
+  // ...until the pool is closed, which reaps the idle workers.
+  pool.close();
+  assert.strictEqual(pool.idleCount, 0);
+  assert.strictEqual(pool.acquire(), null);
+}));
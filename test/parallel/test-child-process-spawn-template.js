@@ -0,0 +1,43 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const { SpawnTemplate } = internalBinding('process_wrap');
+const { ChildProcess } = require('child_process');
+
+const envPairs = [];
+for (const key of Object.keys(process.env))
+  envPairs.push(`${key}=${process.env[key]}`);
+
+// A template converts and copies file/args/env/cwd once; every spawn that
+// passes it afterwards only pays for its own stdio setup.
+const template = new SpawnTemplate({
+  file: process.execPath,
+  args: [process.execPath, '-p', '21 * 2'],
+  envPairs,
+  cwd: process.cwd(),
+});
+
+for (let i = 0; i < 3; i++) {
+  const child = new ChildProcess();
+  child.spawn({
+    file: process.execPath,
+    args: [process.execPath, '-p', '21 * 2'],
+    stdio: ['ignore', 'pipe', 'inherit'],
+    spawnTemplate: template,
+  });
+
+  let stdout = '';
+  child.stdout.setEncoding('utf8');
+  child.stdout.on('data', (chunk) => stdout += chunk);
+
+  child.on('exit', common.mustCall((code, signal) => {
+    assert.strictEqual(code, 0);
+    assert.strictEqual(signal, null);
+  }));
+  child.on('close', common.mustCall(() => {
+    assert.strictEqual(stdout.trim(), '42');
+  }));
+}
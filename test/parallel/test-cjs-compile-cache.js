@@ -0,0 +1,41 @@
+'use strict';
+require('../common');
+
+// Tests that --compile-cache-dir populates a code cache directory on the
+// first run and that cached runs still load modules correctly.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'compile-cache');
+
+const depFile = path.join(tmpdir.path, 'dep.js');
+const entryFile = path.join(tmpdir.path, 'entry.js');
+fs.writeFileSync(depFile, 'module.exports = { answer: 42 };\n');
+fs.writeFileSync(entryFile,
+                 'const dep = require("./dep.js");\n' +
+                 'console.log(dep.answer);\n');
+
+function run() {
+  const child = spawnSync(process.execPath,
+                          [`--compile-cache-dir=${cacheDir}`, entryFile]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return child.stdout.toString().trim();
+}
+
+// Cold run: modules compile normally and the cache gets populated.
+assert.strictEqual(run(), '42');
+const entries = fs.readdirSync(cacheDir);
+assert.ok(entries.length > 0);
+assert.ok(entries.every((name) => name.endsWith('.cache')));
+
+// Warm run: the cached data is consumed and the result is unchanged.
+assert.strictEqual(run(), '42');
+
+// A modified module must not be served from a stale cache entry.
+fs.writeFileSync(depFile, 'module.exports = { answer: 1337 };\n');
+assert.strictEqual(run(), '1337');
@@ -0,0 +1,19 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+// NODE_DEBUG_NATIVE=CLEANUP prints a per-subsystem teardown timing summary
+// when the Environment is torn down.
+const child = spawnSync(process.execPath, ['-e', 'setTimeout(() => {}, 1);'], {
+  env: { ...process.env, NODE_DEBUG_NATIVE: 'CLEANUP' },
+  encoding: 'utf8',
+});
+assert.strictEqual(child.status, 0);
+assert.match(child.stderr, /cleanup: total \d+\.\d+ ms/);
+assert.match(child.stderr, /waiting on handle closes/);
+
+// Without the category enabled there must be no cleanup chatter.
+const quiet = spawnSync(process.execPath, ['-e', ''], { encoding: 'utf8' });
+assert.strictEqual(quiet.status, 0);
+assert.strictEqual(quiet.stderr.includes('cleanup:'), false);
@@ -0,0 +1,77 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const crypto = require('crypto');
+
+// cipher.updateInPlace() overwrites the given range with the ciphertext
+// and must produce byte-identical output to update() for every supported
+// mode; block modes with a block size larger than one are rejected.
+
+const key = crypto.randomBytes(32);
+const iv16 = crypto.randomBytes(16);
+const iv12 = crypto.randomBytes(12);
+const plaintext = Buffer.from('The quick brown fox jumps over the lazy dog');
+
+// CTR: in-place output matches update(), and deciphering in place
+// round-trips.
+{
+  const expected = crypto.createCipheriv('aes-256-ctr', key, iv16)
+    .update(plaintext);
+
+  const buf = Buffer.from(plaintext);
+  const cipher = crypto.createCipheriv('aes-256-ctr', key, iv16);
+  assert.strictEqual(cipher.updateInPlace(buf), buf.length);
+  assert.deepStrictEqual(buf, expected);
+
+  const decipher = crypto.createDecipheriv('aes-256-ctr', key, iv16);
+  assert.strictEqual(decipher.updateInPlace(buf), buf.length);
+  assert.deepStrictEqual(buf, plaintext);
+}
+
+// GCM: the auth tag produced over in-place updates verifies.
+{
+  const buf = Buffer.from(plaintext);
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv12);
+  cipher.updateInPlace(buf);
+  cipher.final();
+  const tag = cipher.getAuthTag();
+
+  const decipher = crypto.createDecipheriv('aes-256-gcm', key, iv12);
+  decipher.setAuthTag(tag);
+  decipher.updateInPlace(buf);
+  decipher.final();
+  assert.deepStrictEqual(buf, plaintext);
+}
+
+// Offset and length select a sub-range; bytes outside it are untouched.
+{
+  const expected = crypto.createCipheriv('aes-256-ctr', key, iv16)
+    .update(plaintext.slice(4, 14));
+
+  const buf = Buffer.from(plaintext);
+  const cipher = crypto.createCipheriv('aes-256-ctr', key, iv16);
+  assert.strictEqual(cipher.updateInPlace(buf, 4, 10), 10);
+  assert.deepStrictEqual(buf.slice(0, 4), plaintext.slice(0, 4));
+  assert.deepStrictEqual(buf.slice(4, 14), expected);
+  assert.deepStrictEqual(buf.slice(14), plaintext.slice(14));
+}
+
+// Argument validation.
+{
+  const cipher = crypto.createCipheriv('aes-256-ctr', key, iv16);
+  assert.throws(() => cipher.updateInPlace('nope'),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => cipher.updateInPlace(Buffer.alloc(4), 2, 3),
+                { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => cipher.updateInPlace(Buffer.alloc(4), -1),
+                { code: 'ERR_OUT_OF_RANGE' });
+}
+
+// Modes with a block size larger than one cannot cipher in place.
+{
+  const cipher = crypto.createCipheriv('aes-256-cbc', key, iv16);
+  assert.throws(() => cipher.updateInPlace(Buffer.alloc(16)),
+                { message: /unsupported state/ });
+}
@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const crypto = require('crypto');
+
+// hash.update()/hmac.update() accept an array of views and digest every
+// element in one binding call; the result must match element-by-element
+// updates, and invalid inputs must keep throwing instead of aborting.
+
+const chunks = [
+  Buffer.from('hello '),
+  new Uint8Array(Buffer.from('world')),
+  new DataView(Buffer.from('!').buffer.slice(0)),
+];
+
+{
+  const expected = crypto.createHash('sha256')
+    .update(chunks[0]).update(chunks[1]).update(chunks[2])
+    .digest('hex');
+  assert.strictEqual(
+    crypto.createHash('sha256').update(chunks).digest('hex'), expected);
+  // An empty array is a no-op.
+  assert.strictEqual(
+    crypto.createHash('sha256').update([]).update(chunks).digest('hex'),
+    expected);
+}
+
+{
+  const expected = crypto.createHmac('sha256', 'key')
+    .update(chunks[0]).update(chunks[1]).update(chunks[2])
+    .digest('hex');
+  assert.strictEqual(
+    crypto.createHmac('sha256', 'key').update(chunks).digest('hex'),
+    expected);
+}
+
+// Arrays may only hold views; strings and other values are rejected with
+// the same error non-view scalars always produced.
+for (const invalid of ['str', 42, null, { length: 1 }]) {
+  assert.throws(() => crypto.createHash('sha256').update([invalid]),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+}
+assert.throws(() => crypto.createHash('sha256').update(42),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.createHmac('sha256', 'key').update(42),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+
+// A Proxy-backed array can pass the lib-side validation and then hand the
+// binding something else entirely; that must throw, not abort.
+{
+  let reads = 0;
+  const evil = new Proxy([Buffer.from('x')], {
+    get(target, prop, receiver) {
+      if (prop === '0' && ++reads > 1)
+        return 42;  // Second read (from the binding) lies.
+      return Reflect.get(target, prop, receiver);
+    }
+  });
+  assert.throws(() => crypto.createHash('sha256').update(evil),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+}
@@ -0,0 +1,68 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const crypto = require('crypto');
+
+// crypto.timingSafeEqualMany() returns the index of the first candidate
+// equal to the probe, or -1, and validates its inputs without aborting
+// even when a Proxy-backed array lies to the binding.
+
+const probe = Buffer.from('secret value 123');
+const other = Buffer.from('secret value 456');
+
+assert.strictEqual(crypto.timingSafeEqualMany(probe, []), -1);
+assert.strictEqual(crypto.timingSafeEqualMany(probe, [other]), -1);
+assert.strictEqual(crypto.timingSafeEqualMany(probe, [probe]), 0);
+assert.strictEqual(
+  crypto.timingSafeEqualMany(probe, [other, Buffer.from(probe)]), 1);
+// The first of several matches wins.
+assert.strictEqual(
+  crypto.timingSafeEqualMany(probe, [other, probe, Buffer.from(probe)]), 1);
+
+// TypedArray and DataView candidates work; only byte contents matter.
+assert.strictEqual(
+  crypto.timingSafeEqualMany(probe, [new Uint8Array(probe)]), 0);
+assert.strictEqual(
+  crypto.timingSafeEqualMany(
+    probe, [new DataView(probe.buffer, probe.byteOffset, probe.byteLength)]),
+  0);
+
+// Argument validation.
+assert.throws(() => crypto.timingSafeEqualMany('nope', []),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.timingSafeEqualMany(probe, 'nope'),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.timingSafeEqualMany(probe, [null]),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.timingSafeEqualMany(probe, [Buffer.alloc(3)]),
+              { code: 'ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH' });
+
+// A Proxy-backed array can pass the lib-side checks and then hand the
+// binding different values; both a non-view and a wrong-length buffer
+// must throw instead of aborting the process.
+{
+  let reads = 0;
+  const lyingType = new Proxy([Buffer.from(probe)], {
+    get(target, prop, receiver) {
+      if (prop === '0' && ++reads > 1)
+        return 42;
+      return Reflect.get(target, prop, receiver);
+    }
+  });
+  assert.throws(() => crypto.timingSafeEqualMany(probe, lyingType),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+}
+{
+  let reads = 0;
+  const lyingLength = new Proxy([Buffer.from(probe)], {
+    get(target, prop, receiver) {
+      if (prop === '0' && ++reads > 1)
+        return Buffer.alloc(1);
+      return Reflect.get(target, prop, receiver);
+    }
+  });
+  assert.throws(() => crypto.timingSafeEqualMany(probe, lyingLength),
+                { code: 'ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH' });
+}
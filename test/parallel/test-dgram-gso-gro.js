@@ -0,0 +1,101 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// Tests UDP generic segmentation offload (sendGso()) and generic receive
+// offload (enableGro()): a payload that is not a multiple of the segment
+// size must arrive complete, with every wire datagram no larger than one
+// segment, and kernels without GSO must surface ENOSYS so callers can
+// fall back to ordinary sends.
+
+if (!common.isLinux)
+  common.skip('UDP GSO/GRO is Linux-only');
+
+const assert = require('assert');
+const dgram = require('dgram');
+const { kStateSymbol } = require('internal/dgram');
+const { internalBinding } = require('internal/test/binding');
+const { UV_ENOSYS } = internalBinding('uv');
+
+const kSegmentSize = 512;
+// Three full segments plus a short tail: the kernel must emit the tail as
+// a final, smaller datagram rather than padding or dropping it.
+const payload = Buffer.alloc(3 * kSegmentSize + 100);
+for (let i = 0; i < payload.length; i++)
+  payload[i] = i & 0xff;
+
+const receiver = dgram.createSocket('udp4');
+const sender = dgram.createSocket('udp4');
+
+receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const rhandle = receiver[kStateSymbol].handle;
+  const port = receiver.address().port;
+
+  // Keep the datagrams queued in the kernel for recvBatch() instead of
+  // letting libuv's reader drain them.
+  rhandle.recvStop();
+
+  // GRO is best-effort: older kernels lack UDP_GRO and that must be
+  // reported as ENOSYS, not a hard failure.
+  const groErr = rhandle.enableGro();
+  assert(groErr === 0 || groErr === UV_ENOSYS,
+         `enableGro failed: ${groErr}`);
+
+  sender.bind(0, common.localhostIPv4, common.mustCall(() => {
+    const shandle = sender[kStateSymbol].handle;
+
+    (function sendGso() {
+      const n = shandle.sendGso(payload, kSegmentSize, port,
+                                common.localhostIPv4);
+      if (n === UV_ENOSYS) {
+        // Kernel without UDP GSO: the documented fallback is an ordinary
+        // send, which must still deliver the payload whole.
+        sender.send(payload, port, common.localhostIPv4,
+                    common.mustCall((err) => assert.ifError(err)));
+        drain();
+        return;
+      }
+      assert(n >= 0, `sendGso failed: ${n}`);
+      if (n === 0) {  // Send buffer full; retry like a real caller would.
+        setTimeout(sendGso, common.platformTimeout(10));
+        return;
+      }
+      assert.strictEqual(n, payload.length);
+      drain();
+    })();
+
+    const received = [];
+    function drain() {
+      const stride = 65536;  // Up to 64KB per entry when GRO coalesces.
+      const result = rhandle.recvBatch(64, stride);
+      assert(typeof result === 'object' || result === 0,
+             `recvBatch failed: ${result}`);
+      let total = 0;
+      if (result !== 0) {
+        const [ slab, lengths, , segsizes ] = result;
+        for (let i = 0; i < lengths.length; i++) {
+          received.push(slab.slice(i * stride, i * stride + lengths[i]));
+          // Entries larger than one segment are only legal when the
+          // kernel marked them as GRO-coalesced runs of that segment
+          // size.
+          if (segsizes[i] === 0)
+            assert(lengths[i] <= kSegmentSize,
+                   `oversized datagram: ${lengths[i]}`);
+          else
+            assert.strictEqual(segsizes[i], kSegmentSize);
+        }
+      }
+      for (const chunk of received)
+        total += chunk.length;
+      if (total < payload.length) {
+        setTimeout(common.mustCall(drain), common.platformTimeout(10));
+        return;
+      }
+      // Same-flow datagrams keep their order on loopback, so the
+      // concatenation must reproduce the original payload exactly.
+      assert.deepStrictEqual(Buffer.concat(received), payload);
+      receiver.close();
+      sender.close();
+    }
+  }));
+}));
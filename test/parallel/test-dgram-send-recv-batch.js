@@ -0,0 +1,91 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+const { kStateSymbol } = require('internal/dgram');
+const { internalBinding } = require('internal/test/binding');
+const { UV_ENOSYS } = internalBinding('uv');
+
+// Tests the sendBatch()/recvBatch() handle methods: a multi-buffer batch
+// (larger than the native per-syscall group of 64) submitted with
+// sendBatch() must come out of recvBatch() byte for byte, with matching
+// rinfo entries, and a bad destination address must be reported as a
+// negative libuv error code.
+
+const kPackets = 70;
+
+const receiver = dgram.createSocket('udp4');
+const sender = dgram.createSocket('udp4');
+
+receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const rhandle = receiver[kStateSymbol].handle;
+  const port = receiver.address().port;
+
+  if (!common.isLinux) {
+    // The batch syscalls are Linux-only; everywhere else the methods must
+    // report ENOSYS so callers can fall back.
+    assert.strictEqual(
+      rhandle.sendBatch([Buffer.from('x')], 1, port, common.localhostIPv4),
+      UV_ENOSYS);
+    assert.strictEqual(rhandle.recvBatch(1, 1024), UV_ENOSYS);
+    receiver.close();
+    sender.close();
+    return;
+  }
+
+  // Stop libuv's own reader so the datagrams stay queued in the kernel
+  // for recvBatch() to drain.
+  rhandle.recvStop();
+
+  sender.bind(0, common.localhostIPv4, common.mustCall(() => {
+    const shandle = sender[kStateSymbol].handle;
+
+    // An unparseable address must fail up front with a negative error
+    // code rather than sending anything.
+    assert(shandle.sendBatch([Buffer.from('x')], 1, port, 'not an ip') < 0);
+
+    const payloads = [];
+    for (let i = 0; i < kPackets; i++)
+      payloads.push(Buffer.from(`packet-${i}`));
+
+    // The contract allows partial sends when the socket buffer fills up;
+    // re-submit the remainder like a real caller would.
+    (function sendAll(remaining) {
+      const n = shandle.sendBatch(remaining, remaining.length, port,
+                                  common.localhostIPv4);
+      assert(n >= 0, `sendBatch failed: ${n}`);
+      assert(n <= remaining.length);
+      if (n < remaining.length)
+        setTimeout(() => sendAll(remaining.slice(n)),
+                   common.platformTimeout(10));
+    })(payloads);
+
+    const received = [];
+    (function drain() {
+      const stride = 1024;
+      const result = rhandle.recvBatch(64, stride);
+      assert(typeof result === 'object' || result === 0,
+             `recvBatch failed: ${result}`);
+      if (result !== 0) {
+        const [ slab, lengths, rinfos, segsizes ] = result;
+        for (let i = 0; i < lengths.length; i++) {
+          received.push(slab.slice(i * stride, i * stride + lengths[i]));
+          assert.strictEqual(rinfos[i].address, common.localhostIPv4);
+          assert.strictEqual(rinfos[i].port, sender.address().port);
+          // No GRO was enabled, so nothing may be coalesced.
+          assert.strictEqual(segsizes[i], 0);
+        }
+      }
+      if (received.length < kPackets) {
+        setTimeout(common.mustCall(drain), common.platformTimeout(10));
+        return;
+      }
+      assert.deepStrictEqual(
+        received.map((b) => b.toString()).sort(),
+        payloads.map((b) => b.toString()).sort());
+      receiver.close();
+      sender.close();
+    })();
+  }));
+}));
@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const dns = require('dns');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Successful responses are cached per resolver for their TTL, so repeated
+// queries for the same name must not hit the server again while the cached
+// answer is fresh. Changing the server list flushes the cache.
+
+const server = dgram.createSocket('udp4');
+let queryCount = 0;
+
+server.on('message', (msg, { address, port }) => {
+  queryCount++;
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain;
+  assert.strictEqual(domain, 'example.org');
+
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: [{ type: 'A', address: '1.2.3.4', ttl: 300, domain }],
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(() => {
+  const resolver = new dns.Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+
+  resolver.resolve4('example.org', common.mustCall((err, res) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(res, ['1.2.3.4']);
+    assert.strictEqual(queryCount, 1);
+
+    // Served from the cache; the server must not see a second query.
+    resolver.resolve4('example.org', common.mustCall((err, res) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(res, ['1.2.3.4']);
+      assert.strictEqual(queryCount, 1);
+
+      // Names are case-insensitive, so this is a cache hit too.
+      resolver.resolve4('EXAMPLE.ORG', common.mustCall((err, res) => {
+        assert.ifError(err);
+        assert.deepStrictEqual(res, ['1.2.3.4']);
+        assert.strictEqual(queryCount, 1);
+
+        // setServers() drops the cache, so the next query goes out again.
+        resolver.setServers([`127.0.0.1:${server.address().port}`]);
+        resolver.resolve4('example.org', common.mustCall((err, res) => {
+          assert.ifError(err);
+          assert.deepStrictEqual(res, ['1.2.3.4']);
+          assert.strictEqual(queryCount, 2);
+          server.close();
+        }));
+      }));
+    }));
+  }));
+}));
@@ -0,0 +1,63 @@
+// Flags: --expose-gc
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const dns = require('dns');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Creating and discarding per-request Resolver instances parks quiescent
+// channels in a pool for reuse. The pooling is transparent; this exercises
+// the park/adopt/swap paths and verifies resolution stays correct across
+// resolver generations and back-to-back queries on one channel.
+
+const server = dgram.createSocket('udp4');
+const addresses = { 'a.example.org': '1.1.1.1', 'b.example.org': '2.2.2.2' };
+
+server.on('message', (msg, { address, port }) => {
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain;
+  assert(addresses[domain]);
+
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: [{ type: 'A', address: addresses[domain], ttl: 1, domain }],
+  }), port, address);
+});
+
+function resolveWithFreshResolver(name, servers) {
+  return new Promise((resolve, reject) => {
+    const resolver = new dns.Resolver();
+    resolver.setServers(servers);
+    resolver.resolve4(name, (err, res) => err ? reject(err) : resolve(res));
+  });
+}
+
+server.bind(0, common.mustCall(async () => {
+  const servers = [`127.0.0.1:${server.address().port}`];
+
+  // Sequential queries on one resolver reuse the same channel sockets.
+  const resolver = new dns.Resolver();
+  resolver.setServers(servers);
+  const resolve4 = (name) => new Promise((resolve, reject) => {
+    resolver.resolve4(name, (err, res) => err ? reject(err) : resolve(res));
+  });
+  assert.deepStrictEqual(await resolve4('a.example.org'), ['1.1.1.1']);
+  assert.deepStrictEqual(await resolve4('b.example.org'), ['2.2.2.2']);
+
+  // Per-request resolvers: each generation parks its channel on collection
+  // and the next one adopts it via setServers().
+  for (let i = 0; i < 3; i++) {
+    assert.deepStrictEqual(
+      await resolveWithFreshResolver('a.example.org', servers), ['1.1.1.1']);
+    global.gc();
+  }
+
+  // A resolver created after the pool is warm must not see state from a
+  // previous owner of its channel: responses come from its own queries.
+  assert.deepStrictEqual(
+    await resolveWithFreshResolver('b.example.org', servers), ['2.2.2.2']);
+
+  server.close();
+}));
@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const dns = require('dns');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Identical queries issued while one is already in flight are coalesced
+// into a single wire query; every caller still gets its own callback.
+
+const server = dgram.createSocket('udp4');
+let queryCount = 0;
+
+server.on('message', common.mustCall((msg, { address, port }) => {
+  queryCount++;
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain;
+  assert.strictEqual(domain, 'example.org');
+
+  // Hold the response until all duplicate requests are in flight.
+  setTimeout(common.mustCall(() => {
+    server.send(dnstools.writeDNSPacket({
+      id: parsed.id,
+      questions: parsed.questions,
+      answers: [{ type: 'A', address: '1.2.3.4', ttl: 300, domain }],
+    }), port, address);
+  }), common.platformTimeout(100));
+}));
+
+server.bind(0, common.mustCall(() => {
+  const resolver = new dns.Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+
+  let pending = 5;
+  const done = common.mustCall((err, res) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(res, ['1.2.3.4']);
+    assert.strictEqual(queryCount, 1);
+    if (--pending === 0)
+      server.close();
+  }, 5);
+
+  resolver.resolve4('example.org', done);
+  resolver.resolve4('example.org', done);
+  resolver.resolve4('example.org', done);
+  // DNS names are case-insensitive, so these coalesce too.
+  resolver.resolve4('EXAMPLE.org', done);
+  resolver.resolve4('example.ORG', done);
+}));
@@ -0,0 +1,87 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const dns = require('dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const dnsPromises = dns.promises;
+
+// With `mode: 'resolver'`, dns.lookup() resolves via parallel A/AAAA
+// queries on the default resolver's channel instead of getaddrinfo(3).
+
+const server = dgram.createSocket('udp4');
+
+server.on('message', (msg, { address, port }) => {
+  const parsed = dnstools.parseDNSPacket(msg);
+  const question = parsed.questions[0];
+  assert.strictEqual(question.domain, 'example.org');
+
+  const answers = question.type === 'AAAA' ?
+    [{ type: 'AAAA', address: '::42', ttl: 300, domain: question.domain }] :
+    [{ type: 'A', address: '1.2.3.4', ttl: 300, domain: question.domain },
+     { type: 'A', address: '5.6.7.8', ttl: 300, domain: question.domain }];
+
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    questions: parsed.questions,
+    answers,
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(async () => {
+  dns.setServers([`127.0.0.1:${server.address().port}`]);
+
+  // Default ordering puts IPv4 addresses first, like the getaddrinfo path.
+  dns.lookup('example.org', { mode: 'resolver', all: true },
+             common.mustCall((err, addresses) => {
+               assert.ifError(err);
+               assert.deepStrictEqual(addresses, [
+                 { address: '1.2.3.4', family: 4 },
+                 { address: '5.6.7.8', family: 4 },
+                 { address: '::42', family: 6 },
+               ]);
+             }));
+
+  // Verbatim mode interleaves the families, IPv6 first.
+  dns.lookup('example.org', { mode: 'resolver', all: true, verbatim: true },
+             common.mustCall((err, addresses) => {
+               assert.ifError(err);
+               assert.deepStrictEqual(addresses, [
+                 { address: '::42', family: 6 },
+                 { address: '1.2.3.4', family: 4 },
+                 { address: '5.6.7.8', family: 4 },
+               ]);
+             }));
+
+  // Single-address form reports the address family.
+  dns.lookup('example.org', { mode: 'resolver' },
+             common.mustCall((err, address, family) => {
+               assert.ifError(err);
+               assert.strictEqual(address, '1.2.3.4');
+               assert.strictEqual(family, 4);
+             }));
+
+  // Restricting the family only issues that family's query.
+  dns.lookup('example.org', { mode: 'resolver', family: 6 },
+             common.mustCall((err, address, family) => {
+               assert.ifError(err);
+               assert.strictEqual(address, '::42');
+               assert.strictEqual(family, 6);
+             }));
+
+  const result = await dnsPromises.lookup('example.org', { mode: 'resolver' });
+  assert.deepStrictEqual(result, { address: '1.2.3.4', family: 4 });
+
+  // IP literals and bad modes behave like the getaddrinfo path.
+  dns.lookup('127.0.0.1', { mode: 'resolver' },
+             common.mustCall((err, address, family) => {
+               assert.ifError(err);
+               assert.strictEqual(address, '127.0.0.1');
+               assert.strictEqual(family, 4);
+             }));
+  assert.throws(() => dns.lookup('example.org', { mode: 'bogus' },
+                                 common.mustNotCall()),
+                { code: 'ERR_INVALID_OPT_VALUE' });
+
+  server.unref();
+}));
@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+
+// Tests fs.readAssetSync() and fs.setAssetCacheSize(): cached reads must
+// return the file's content, honor encodings, surface errors like plain
+// reads, and pick up new content after the cache is dropped or the file
+// changes under its watcher.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'asset.txt');
+fs.writeFileSync(file, 'hello asset');
+
+// First read populates the cache, the second is served from it; both must
+// see the same content as a regular read.
+assert.deepStrictEqual(fs.readAssetSync(file), Buffer.from('hello asset'));
+assert.deepStrictEqual(fs.readAssetSync(file), fs.readFileSync(file));
+
+// Encoding can be passed as a string or an options object.
+assert.strictEqual(fs.readAssetSync(file, 'utf8'), 'hello asset');
+assert.strictEqual(fs.readAssetSync(file, { encoding: 'utf8' }),
+                   'hello asset');
+
+// Empty files are not cached but still read correctly.
+const empty = path.join(tmpdir.path, 'empty.txt');
+fs.writeFileSync(empty, '');
+assert.strictEqual(fs.readAssetSync(empty).length, 0);
+
+// Missing files report ENOENT with the usual shape.
+assert.throws(() => fs.readAssetSync(path.join(tmpdir.path, 'nope.txt')),
+              { code: 'ENOENT', syscall: 'open' });
+
+// Argument validation.
+assert.throws(() => fs.setAssetCacheSize(-1), { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => fs.setAssetCacheSize('big'),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+
+// Dropping the cache forces the next read to hit the filesystem again, so
+// it must observe new content even if no watcher event was processed yet.
+fs.writeFileSync(file, 'second version');
+fs.setAssetCacheSize(0);
+assert.strictEqual(fs.readAssetSync(file, 'utf8'), 'second version');
+fs.setAssetCacheSize(64 * 1024 * 1024);
+
+// With the cache re-enabled, an in-place change must eventually be picked
+// up via the file watcher (event delivery is asynchronous).
+assert.strictEqual(fs.readAssetSync(file, 'utf8'), 'second version');
+fs.writeFileSync(file, 'third version');
+(function poll() {
+  if (fs.readAssetSync(file, 'utf8') === 'third version')
+    return;
+  setTimeout(common.mustCall(poll), common.platformTimeout(10));
+})();
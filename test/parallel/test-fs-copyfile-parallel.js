@@ -0,0 +1,69 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// COPYFILE_PARALLEL produces byte-identical copies whether the filesystem
+// supports reflinks or the copy falls back to range tasks, honors
+// COPYFILE_EXCL, and maps to an opportunistic reflink in the sync form.
+
+const { COPYFILE_EXCL, COPYFILE_PARALLEL } = fs.constants;
+
+tmpdir.refresh();
+
+assert.strictEqual(typeof COPYFILE_PARALLEL, 'number');
+
+const small = path.join(tmpdir.path, 'small.bin');
+fs.writeFileSync(small, 'parallel copy source');
+
+// Larger than the 8 MiB fan-out threshold so multiple range tasks run on
+// filesystems without reflink support.
+const large = path.join(tmpdir.path, 'large.bin');
+const chunk = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < chunk.length; i++)
+  chunk[i] = i & 0xFF;
+for (let i = 0; i < 9; i++)
+  fs.appendFileSync(large, chunk);
+
+const smallDest = path.join(tmpdir.path, 'small.copy');
+fs.copyFile(small, smallDest, COPYFILE_PARALLEL, common.mustCall((err) => {
+  assert.strictEqual(err, null);
+  assert.deepStrictEqual(fs.readFileSync(smallDest),
+                         fs.readFileSync(small));
+
+  // COPYFILE_EXCL still applies on the parallel path.
+  fs.copyFile(small, smallDest, COPYFILE_PARALLEL | COPYFILE_EXCL,
+              common.mustCall((err) => {
+                assert.strictEqual(err.code, 'EEXIST');
+              }));
+}));
+
+const largeDest = path.join(tmpdir.path, 'large.copy');
+fs.copyFile(large, largeDest, COPYFILE_PARALLEL, common.mustCall((err) => {
+  assert.strictEqual(err, null);
+  assert.deepStrictEqual(fs.readFileSync(largeDest),
+                         fs.readFileSync(large));
+}));
+
+// A missing source reports its error.
+fs.copyFile(path.join(tmpdir.path, 'missing'),
+            path.join(tmpdir.path, 'missing.copy'),
+            COPYFILE_PARALLEL,
+            common.mustCall((err) => {
+              assert.strictEqual(err.code, 'ENOENT');
+            }));
+
+// The sync form treats the flag as an opportunistic reflink.
+const syncDest = path.join(tmpdir.path, 'small.sync.copy');
+fs.copyFileSync(small, syncDest, COPYFILE_PARALLEL);
+assert.deepStrictEqual(fs.readFileSync(syncDest), fs.readFileSync(small));
+
+// The promise form routes through the same parallel binding.
+const promiseDest = path.join(tmpdir.path, 'large.promise.copy');
+fs.promises.copyFile(large, promiseDest, COPYFILE_PARALLEL)
+  .then(common.mustCall(() => {
+    assert.deepStrictEqual(fs.readFileSync(promiseDest),
+                           fs.readFileSync(large));
+  }));
@@ -0,0 +1,42 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// filehandle.setReadPipelineDepth() validates its argument, is chainable,
+// and reads through a handle with a deepened pipeline stay correct.
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'pipelined.txt');
+const content = Buffer.alloc(256 * 1024);
+for (let i = 0; i < content.length; i++)
+  content[i] = i & 0xFF;
+fs.writeFileSync(file, content);
+
+async function main() {
+  const handle = await fs.promises.open(file, 'r');
+
+  assert.strictEqual(handle.setReadPipelineDepth(8), handle);
+  // Out-of-range depths are clamped, not rejected.
+  assert.strictEqual(handle.setReadPipelineDepth(1000), handle);
+
+  assert.throws(() => handle.setReadPipelineDepth(-1),
+                { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => handle.setReadPipelineDepth('deep'),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+
+  // Reads through the handle remain byte-exact with the pipeline deepened.
+  assert.deepStrictEqual(await handle.readFile(), content);
+
+  const chunk = Buffer.alloc(4096);
+  const { bytesRead } = await handle.read(chunk, 0, chunk.length, 8192);
+  assert.strictEqual(bytesRead, chunk.length);
+  assert.deepStrictEqual(chunk, content.slice(8192, 8192 + chunk.length));
+
+  await handle.close();
+}
+
+main().then(common.mustCall());
@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// filehandle.setWriteCombining() queues position-less buffer writes in a
+// per-handle arena; barriers (sync/datasync/close) flush it first and
+// background flush errors stick until the next write or barrier.
+
+tmpdir.refresh();
+
+async function combinedAppendsSurviveBarrier() {
+  const file = path.join(tmpdir.path, 'combined.log');
+  const handle = await fs.promises.open(file, 'a');
+  assert.strictEqual(handle.setWriteCombining(true), handle);
+
+  const chunks = [];
+  for (let i = 0; i < 100; i++) {
+    const chunk = Buffer.from(`line ${i}\n`);
+    chunks.push(chunk);
+    const { bytesWritten } = await handle.write(chunk);
+    assert.strictEqual(bytesWritten, chunk.length);
+  }
+
+  // sync() is a barrier: everything queued is on disk afterwards.
+  await handle.sync();
+  assert.deepStrictEqual(fs.readFileSync(file), Buffer.concat(chunks));
+
+  // More appends followed by close() must not lose the tail either.
+  const tail = Buffer.from('tail line\n');
+  chunks.push(tail);
+  await handle.write(tail);
+  await handle.close();
+  assert.deepStrictEqual(fs.readFileSync(file), Buffer.concat(chunks));
+}
+
+async function combiningCanBeToggledOff() {
+  const file = path.join(tmpdir.path, 'toggled.log');
+  const handle = await fs.promises.open(file, 'a');
+  handle.setWriteCombining(true);
+  await handle.write(Buffer.from('combined\n'));
+  assert.strictEqual(handle.setWriteCombining(false), handle);
+  await handle.write(Buffer.from('direct\n'));
+  await handle.close();
+  const lines = fs.readFileSync(file, 'utf8');
+  assert.ok(lines.includes('combined\n'));
+  assert.ok(lines.includes('direct\n'));
+}
+
+async function flushErrorsAreSticky() {
+  // A read-only descriptor accepts queued appends but every background
+  // flush fails; the sticky error must surface on the next barrier while
+  // close() still succeeds afterwards.
+  const file = path.join(tmpdir.path, 'readonly.log');
+  fs.writeFileSync(file, 'untouched');
+  const handle = await fs.promises.open(file, 'r');
+  handle.setWriteCombining(true);
+
+  await handle.write(Buffer.from('never lands'));
+  await assert.rejects(handle.sync(), { code: 'EBADF', syscall: 'write' });
+
+  await handle.close();
+  assert.strictEqual(fs.readFileSync(file, 'utf8'), 'untouched');
+}
+
+Promise.all([
+  combinedAppendsSurviveBarrier(),
+  combiningCanBeToggledOff(),
+  flushErrorsAreSticky(),
+]).then(common.mustCall());
@@ -0,0 +1,61 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// The mmap option of fs.readFile()/fs.readFileSync() returns the same
+// contents as a regular read and falls back to a regular read for file
+// descriptors and non-'r' flags.
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'mapped.txt');
+const content = Buffer.alloc(128 * 1024);
+for (let i = 0; i < content.length; i++)
+  content[i] = i & 0xFF;
+fs.writeFileSync(file, content);
+
+const empty = path.join(tmpdir.path, 'empty.txt');
+fs.writeFileSync(empty, '');
+
+// Synchronous form.
+assert.deepStrictEqual(fs.readFileSync(file, { mmap: true }), content);
+assert.strictEqual(fs.readFileSync(file, { mmap: true, encoding: 'latin1' }),
+                   content.toString('latin1'));
+assert.strictEqual(fs.readFileSync(empty, { mmap: true }).length, 0);
+
+// A file descriptor path falls back to a regular read and respects the
+// current file position.
+{
+  const fd = fs.openSync(file, 'r');
+  assert.deepStrictEqual(fs.readFileSync(fd, { mmap: true }), content);
+  fs.closeSync(fd);
+}
+
+// Flags other than 'r' fall back to a regular read with that flag.
+assert.deepStrictEqual(fs.readFileSync(file, { mmap: true, flag: 'r+' }),
+                       content);
+
+// Errors surface the same way as for a regular read.
+assert.throws(() => fs.readFileSync(path.join(tmpdir.path, 'missing'),
+                                    { mmap: true }),
+              { code: 'ENOENT' });
+
+// Asynchronous form.
+fs.readFile(file, { mmap: true }, common.mustCall((err, data) => {
+  assert.strictEqual(err, null);
+  assert.deepStrictEqual(data, content);
+}));
+
+fs.readFile(file, { mmap: true, encoding: 'latin1' },
+            common.mustCall((err, data) => {
+              assert.strictEqual(err, null);
+              assert.strictEqual(data, content.toString('latin1'));
+            }));
+
+fs.readFile(path.join(tmpdir.path, 'missing'), { mmap: true },
+            common.mustCall((err) => {
+              assert.strictEqual(err.code, 'ENOENT');
+            }));
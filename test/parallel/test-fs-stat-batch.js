@@ -0,0 +1,66 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// fs.statBatch() stats every path in one threadpool task and reports
+// per-path results: an fs.Stats (or null) per path plus an Int32Array of
+// libuv error codes. Individual failures must not fail the batch.
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'file.txt');
+const dir = path.join(tmpdir.path, 'dir');
+const missing = path.join(tmpdir.path, 'missing');
+fs.writeFileSync(file, 'batch me');
+fs.mkdirSync(dir);
+
+fs.statBatch([file, dir, missing], common.mustCall((err, stats, errors) => {
+  assert.strictEqual(err, null);
+  assert.strictEqual(stats.length, 3);
+  assert.ok(errors instanceof Int32Array);
+  assert.strictEqual(errors.length, 3);
+
+  assert.strictEqual(errors[0], 0);
+  assert.ok(stats[0].isFile());
+  assert.strictEqual(stats[0].size, 8);
+  assert.strictEqual(stats[0].size, fs.statSync(file).size);
+
+  assert.strictEqual(errors[1], 0);
+  assert.ok(stats[1].isDirectory());
+
+  // A failing path reports its libuv error code without failing the batch.
+  assert.strictEqual(stats[2], null);
+  assert.ok(errors[2] < 0);
+}));
+
+// The empty batch completes with empty results.
+fs.statBatch([], common.mustCall((err, stats, errors) => {
+  assert.strictEqual(err, null);
+  assert.deepStrictEqual(stats, []);
+  assert.strictEqual(errors.length, 0);
+}));
+
+// options.lstat stats the link itself instead of its target.
+if (common.canCreateSymLink()) {
+  const link = path.join(tmpdir.path, 'link');
+  fs.symlinkSync(file, link);
+  fs.statBatch([link], { lstat: true },
+               common.mustCall((err, stats, errors) => {
+                 assert.strictEqual(err, null);
+                 assert.strictEqual(errors[0], 0);
+                 assert.ok(stats[0].isSymbolicLink());
+               }));
+  fs.statBatch([link], common.mustCall((err, stats) => {
+    assert.strictEqual(err, null);
+    assert.ok(stats[0].isFile());
+  }));
+}
+
+// Argument validation.
+assert.throws(() => fs.statBatch('not-an-array', common.mustNotCall()),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => fs.statBatch([42], common.mustNotCall()),
+              { code: 'ERR_INVALID_ARG_TYPE' });
@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// fs.setStatCachePrefixes() serves repeat stat()/lstat() lookups under the
+// covered prefixes from a watcher-invalidated cache; writes to a covered
+// directory must be observed on a later lookup.
+
+tmpdir.refresh();
+
+const covered = path.join(tmpdir.path, 'covered');
+fs.mkdirSync(covered);
+const file = path.join(covered, 'file.txt');
+fs.writeFileSync(file, 'original');
+
+fs.setStatCachePrefixes([covered]);
+
+// Populate the cache and verify cached results match a direct stat.
+const first = fs.statSync(file);
+assert.strictEqual(first.size, 8);
+const cached = fs.statSync(file);
+assert.strictEqual(cached.size, first.size);
+assert.strictEqual(cached.ino, first.ino);
+assert.ok(cached.isFile());
+
+// Failed lookups are cached too, and both report ENOENT.
+const missing = path.join(covered, 'missing');
+assert.throws(() => fs.statSync(missing), { code: 'ENOENT' });
+assert.throws(() => fs.statSync(missing), { code: 'ENOENT' });
+
+// Async lookups on a covered path still invoke their callback
+// asynchronously on a cache hit.
+let sync = true;
+fs.stat(file, common.mustCall((err, stats) => {
+  assert.strictEqual(err, null);
+  assert.strictEqual(sync, false);
+  assert.strictEqual(stats.size, 8);
+
+  afterAsyncHit();
+}));
+sync = false;
+
+function afterAsyncHit() {
+  // A change in the covered directory drops the affected entries. Watcher
+  // delivery is asynchronous, so poll until the new size is observed.
+  fs.writeFileSync(file, 'original plus more');
+  fs.writeFileSync(missing, 'exists now');
+
+  const poll = setInterval(() => {
+    let stats;
+    try {
+      stats = fs.statSync(file);
+      fs.statSync(missing);
+    } catch {
+      return;
+    }
+    if (stats.size !== 18)
+      return;
+    clearInterval(poll);
+    done();
+  }, 10);
+}
+
+const done = common.mustCall(function done() {
+  // lstat() is covered independently of stat().
+  assert.ok(fs.lstatSync(covered).isDirectory());
+  assert.ok(fs.lstatSync(covered).isDirectory());
+
+  // Disabling drops the cache; lookups keep working uncached.
+  fs.setStatCachePrefixes([]);
+  assert.strictEqual(fs.statSync(file).size, 18);
+
+  assert.throws(() => fs.setStatCachePrefixes('not-an-array'),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
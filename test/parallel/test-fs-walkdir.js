@@ -0,0 +1,86 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// fs.walkdir() delivers the whole subtree in pages of { path, type, size }
+// records, with sizes only when options.stats is set.
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'walk');
+fs.mkdirSync(path.join(root, 'a', 'b'), { recursive: true });
+fs.mkdirSync(path.join(root, 'c'));
+fs.writeFileSync(path.join(root, 'top.txt'), 'top');
+fs.writeFileSync(path.join(root, 'a', 'nested.txt'), 'nested');
+fs.writeFileSync(path.join(root, 'a', 'b', 'deep.txt'), 'deepest');
+
+const expected = [
+  'a',
+  path.join('a', 'b'),
+  path.join('a', 'b', 'deep.txt'),
+  path.join('a', 'nested.txt'),
+  'c',
+  'top.txt',
+].sort();
+
+async function collect(options) {
+  const entries = [];
+  for await (const entry of fs.walkdir(root, options))
+    entries.push(entry);
+  return entries;
+}
+
+async function main() {
+  // The default walk covers the whole subtree; sizes are not gathered.
+  const entries = await collect();
+  assert.deepStrictEqual(entries.map((e) => e.path).sort(), expected);
+  for (const entry of entries)
+    assert.strictEqual(entry.size, -1);
+
+  // Directory and file entries report distinct, consistent types.
+  const types = new Map(entries.map((e) => [e.path, e.type]));
+  assert.strictEqual(types.get('a'), types.get('c'));
+  assert.strictEqual(types.get('top.txt'),
+                     types.get(path.join('a', 'b', 'deep.txt')));
+  assert.notStrictEqual(types.get('a'), types.get('top.txt'));
+
+  // options.stats gathers sizes during the walk.
+  const statted = await collect({ stats: true });
+  const sizes = new Map(statted.map((e) => [e.path, e.size]));
+  assert.strictEqual(sizes.get('top.txt'), 3);
+  assert.strictEqual(sizes.get(path.join('a', 'nested.txt')), 6);
+  assert.strictEqual(sizes.get(path.join('a', 'b', 'deep.txt')), 7);
+
+  // Small pages page through the same set of entries.
+  const walker = fs.walkdir(root, { batchSize: 2 });
+  const paged = [];
+  let pages = 0;
+  let page;
+  while ((page = await walker.read()) !== null) {
+    assert.ok(page.length <= 2);
+    pages++;
+    paged.push(...page);
+  }
+  assert.ok(pages >= 3);
+  assert.deepStrictEqual(paged.map((e) => e.path).sort(), expected);
+  // The finished walker keeps reporting the end of the traversal.
+  assert.strictEqual(await walker.read(), null);
+
+  // Overlapping read()s on one walker are rejected.
+  {
+    const busy = fs.walkdir(root);
+    busy.read(common.mustCall());
+    assert.throws(() => busy.read(common.mustNotCall()),
+                  { code: 'ERR_DIR_CONCURRENT_OPERATION' });
+  }
+
+  // A root that cannot be scanned fails the first read().
+  await assert.rejects(
+    fs.walkdir(path.join(tmpdir.path, 'missing')).read(),
+    { code: 'ENOENT' });
+}
+
+main().then(common.mustCall());
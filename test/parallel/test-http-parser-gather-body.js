@@ -0,0 +1,89 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+const { HTTPParser } = require('_http_common');
+const { REQUEST } = HTTPParser;
+
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnBody = HTTPParser.kOnBody | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+
+// Tests gatherBody(): for messages with a known Content-Length within
+// the limit, the body accumulates natively and kOnBody fires exactly
+// once with the complete buffer when the message ends. Chunked and
+// over-limit bodies keep the per-segment path. Either way, the bytes
+// delivered must equal what the default streaming path produces.
+
+function parse(chunks, gatherLimit) {
+  const parser = new HTTPParser();
+  parser.initialize(REQUEST, {});
+  if (gatherLimit !== undefined)
+    parser.gatherBody(gatherLimit);
+  const bodies = [];
+  let complete = false;
+  parser[kOnHeadersComplete] = () => {};
+  parser[kOnBody] = (buf, start, len) => {
+    bodies.push(Buffer.from(buf.slice(start, start + len)));
+  };
+  parser[kOnMessageComplete] = () => { complete = true; };
+  for (const chunk of chunks)
+    assert.strictEqual(parser.execute(chunk), chunk.length);
+  parser.free();
+  assert(complete);
+  return bodies;
+}
+
+function split(str) {
+  // Feed the message in small pieces so the streaming path sees the body
+  // one fragment at a time.
+  const buf = Buffer.from(str);
+  const chunks = [];
+  for (let i = 0; i < buf.length; i += 7)
+    chunks.push(buf.slice(i, i + 7));
+  return chunks;
+}
+
+// Content-Length body within the limit: the streaming path delivers the
+// body in several callbacks, the gathering path in exactly one, and the
+// bytes must match.
+const clRequest =
+  'POST /upload HTTP/1.1\r\nContent-Length: 26\r\n\r\n' +
+  'abcdefghijklmnopqrstuvwxyz';
+{
+  const streamed = parse(split(clRequest));
+  assert(streamed.length > 1);
+  assert.strictEqual(Buffer.concat(streamed).toString(),
+                     'abcdefghijklmnopqrstuvwxyz');
+
+  const gathered = parse(split(clRequest), 1024);
+  assert.strictEqual(gathered.length, 1);
+  assert.deepStrictEqual(gathered[0], Buffer.concat(streamed));
+}
+
+// Body larger than the limit: gathering must not engage, so the
+// per-segment callbacks are identical to the default path.
+{
+  const streamed = parse(split(clRequest));
+  const capped = parse(split(clRequest), 10);
+  assert.deepStrictEqual(capped, streamed);
+}
+
+// Chunked bodies have no up-front length and keep the per-segment path;
+// the concatenated result still matches the streamed equivalent.
+const chunkedRequest =
+  'POST /upload HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n' +
+  'b\r\nhello chunk\r\n8\r\n another\r\n0\r\n\r\n';
+{
+  const streamed = parse(split(chunkedRequest));
+  const gathered = parse(split(chunkedRequest), 1024);
+  assert.strictEqual(Buffer.concat(streamed).toString(),
+                     'hello chunk another');
+  assert.deepStrictEqual(Buffer.concat(gathered), Buffer.concat(streamed));
+}
+
+// gatherBody(0) switches the mode back off.
+{
+  const off = parse(split(clRequest), 0);
+  assert(off.length > 1);
+}
@@ -0,0 +1,103 @@
+'use strict';
+const { mustCall } = require('../common');
+const assert = require('assert');
+
+const { HTTPParser } = require('_http_common');
+const { REQUEST } = HTTPParser;
+
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+
+// Tests enablePackedHeaders(): with packed delivery enabled the
+// kOnHeadersComplete callback receives undefined headers/url and the
+// shared Uint32Array offset table instead describes slices of the buffer
+// passed to execute(). Decoding those slices must yield exactly the
+// headers and url the default path materializes, and messages split
+// across execute() calls must fall back to the default path.
+
+const request = Buffer.from(
+  'GET /hello?a=1 HTTP/1.1\r\n' +
+  'Host: example.com\r\n' +
+  'X-Test: yes\r\n' +
+  'Content-Length: 0\r\n' +
+  '\r\n');
+
+// Layout of the packed table, see Parser::EnablePackedHeaders() in
+// src/node_http_parser.cc.
+const kPackedValid = 0;
+const kPackedNumHeaders = 1;
+const kPackedUrlOffset = 2;
+const kPackedUrlLength = 3;
+const kPackedHeadersStart = 4;
+
+function parseDefault(chunks) {
+  const parser = new HTTPParser();
+  parser.initialize(REQUEST, {});
+  const result = {};
+  parser[kOnHeadersComplete] = mustCall(
+    (versionMajor, versionMinor, headers, method, url) => {
+      result.headers = headers;
+      result.url = url;
+    });
+  for (const chunk of chunks)
+    assert.strictEqual(parser.execute(chunk), chunk.length);
+  parser.free();
+  return result;
+}
+
+function parsePacked(chunks, expectPacked) {
+  const parser = new HTTPParser();
+  parser.initialize(REQUEST, {});
+  const table = parser.enablePackedHeaders();
+  assert(table instanceof Uint32Array);
+  const result = {};
+  let current = null;
+  parser[kOnHeadersComplete] = mustCall(
+    (versionMajor, versionMinor, headers, method, url) => {
+      assert.strictEqual(table[kPackedValid] === 1, expectPacked);
+      if (table[kPackedValid] !== 1) {
+        // Fallback: headers arrive as arguments, like without the mode.
+        result.headers = headers;
+        result.url = url;
+        return;
+      }
+      assert.strictEqual(headers, undefined);
+      assert.strictEqual(url, undefined);
+      result.url = current.toString('latin1',
+                                    table[kPackedUrlOffset],
+                                    table[kPackedUrlOffset] +
+                                        table[kPackedUrlLength]);
+      result.headers = [];
+      for (let i = 0; i < table[kPackedNumHeaders]; i++) {
+        const base = kPackedHeadersStart + i * 4;
+        result.headers.push(
+          current.toString('latin1', table[base],
+                           table[base] + table[base + 1]),
+          current.toString('latin1', table[base + 2],
+                           table[base + 2] + table[base + 3]));
+      }
+    });
+  for (const chunk of chunks) {
+    current = chunk;
+    assert.strictEqual(parser.execute(chunk), chunk.length);
+  }
+  parser.free();
+  return result;
+}
+
+// One-shot parse: the whole message is in a single execute() buffer, so
+// packed delivery must kick in and decode to the same header list.
+const expected = parseDefault([request]);
+assert.deepStrictEqual(expected.headers,
+                       ['Host', 'example.com',
+                        'X-Test', 'yes',
+                        'Content-Length', '0']);
+assert.strictEqual(expected.url, '/hello?a=1');
+assert.deepStrictEqual(parsePacked([request], true), expected);
+
+// Split mid-header: the saved slices no longer point into the current
+// execute() buffer, so the parser must fall back to materialized headers
+// with identical output.
+const splitAt = request.indexOf('X-Te') + 2;
+const chunks = [request.slice(0, splitAt), request.slice(splitAt)];
+assert.deepStrictEqual(parseDefault(chunks), expected);
+assert.deepStrictEqual(parsePacked(chunks, false), expected);
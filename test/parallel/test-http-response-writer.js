@@ -0,0 +1,72 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const { internalBinding } = require('internal/test/binding');
+const { HTTPResponseWriter } = internalBinding('http_parser');
+const { WriteWrap } = internalBinding('stream_wrap');
+
+// Tests the HTTPResponseWriter binding: setTemplate() registers the
+// static byte pieces of a response once, and write() interleaves them
+// with per-response values (Buffers or Latin-1 strings) into a single
+// stream write. The bytes on the wire must match the hand-assembled
+// responses exactly, including non-ASCII header values and chunked
+// framing.
+
+const responses = [
+  // Template substitution: content type, length and body vary per
+  // response, the rest is static.
+  'HTTP/1.1 200 OK\r\nServer: test\r\nContent-Type: text/plain\r\n' +
+      'Content-Length: 5\r\n\r\nhello',
+  // Same template, different values; the header value carries a Latin-1
+  // byte that must be written as a single byte, not UTF-8 encoded.
+  'HTTP/1.1 200 OK\r\nServer: test\r\nContent-Type: text/caf\xe9\r\n' +
+      'Content-Length: 3\r\n\r\nabc',
+  // Chunked framing supplied as template pieces around the chunk data.
+  'HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n' +
+      '5\r\nhello\r\n0\r\n\r\n',
+];
+
+const server = net.createServer(common.mustCall((conn) => {
+  const received = [];
+  conn.on('data', (chunk) => received.push(chunk));
+  conn.on('end', common.mustCall(() => {
+    assert.strictEqual(Buffer.concat(received).toString('latin1'),
+                       responses.join(''));
+    conn.end();
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    const writer = new HTTPResponseWriter();
+
+    const write = (values) => {
+      const req = new WriteWrap();
+      req.handle = client._handle;
+      req.oncomplete = () => {};
+      assert.strictEqual(writer.write(client._handle, req, values), 0);
+    };
+
+    writer.setTemplate([
+      'HTTP/1.1 200 OK\r\nServer: test\r\nContent-Type: ',
+      '\r\nContent-Length: ',
+      '\r\n\r\n',
+    ]);
+    write(['text/plain', '5', Buffer.from('hello')]);
+    write(['text/caf\xe9', '3', Buffer.from('abc')]);
+
+    // setTemplate() replaces the previous pieces; with fewer values than
+    // pieces the remaining pieces are appended verbatim.
+    writer.setTemplate([
+      'HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n',
+      '\r\n0\r\n\r\n',
+    ]);
+    write([Buffer.from('5\r\nhello')]);
+
+    client.end();
+  }));
+}));
@@ -0,0 +1,50 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// The deficit-round-robin scheduler's fairness counters are exposed via
+// http2stream.state as drrSentBytes/drrDeferrals. Once every DATA frame
+// of a response has been handed to the session, drrSentBytes must cover
+// the whole body; waitForTrailers keeps the stream alive so the state is
+// still readable at that point.
+
+const body = Buffer.alloc(512 * 1024, 'x');
+
+const server = h2.createServer();
+
+server.on('stream', common.mustCall((stream) => {
+  {
+    const state = stream.state;
+    assert.strictEqual(typeof state.drrSentBytes, 'number');
+    assert.strictEqual(typeof state.drrDeferrals, 'number');
+    assert.strictEqual(state.drrSentBytes, 0);
+  }
+
+  stream.respond({ ':status': 200 }, { waitForTrailers: true });
+  stream.on('wantTrailers', common.mustCall(() => {
+    const state = stream.state;
+    assert.ok(state.drrSentBytes >= body.length,
+              `drrSentBytes ${state.drrSentBytes} < ${body.length}`);
+    assert.ok(state.drrDeferrals >= 0);
+    stream.sendTrailers({});
+  }));
+  stream.end(body);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  const req = client.request({ ':path': '/' });
+
+  let received = 0;
+  req.on('data', (chunk) => received += chunk.length);
+  req.on('end', common.mustCall(() => {
+    assert.strictEqual(received, body.length);
+    client.close();
+    server.close();
+  }));
+  req.end();
+}));
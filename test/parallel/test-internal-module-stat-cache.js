@@ -0,0 +1,39 @@
+// Flags: --expose-internals
+'use strict';
+require('../common');
+
+// Tests that the process-wide internalModuleStat cache keeps answering
+// correctly when directory contents change, including negative probes
+// that later turn positive.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+const { internalBinding } = require('internal/test/binding');
+const { internalModuleStat } = internalBinding('fs');
+
+tmpdir.refresh();
+
+const dir = path.join(tmpdir.path, 'pkg');
+const file = path.join(dir, 'index.js');
+fs.mkdirSync(dir);
+
+// Basic contract: 0 for files, 1 for directories, < 0 for missing paths.
+assert.strictEqual(internalModuleStat(dir), 1);
+assert.strictEqual(internalModuleStat(file), -2);  // UV_ENOENT
+assert.strictEqual(internalModuleStat(file), -2);  // Served again, maybe cached.
+
+// A negative probe must turn positive once the file appears; creating it
+// changes the directory mtime, which invalidates any cached answer.
+fs.writeFileSync(file, 'module.exports = 42;\n');
+assert.strictEqual(internalModuleStat(file), 0);
+
+// And back to negative after removal.
+fs.unlinkSync(file);
+assert.strictEqual(internalModuleStat(file), -2);
+
+// Probes under a missing directory chain fail without special-casing.
+assert.strictEqual(
+  internalModuleStat(path.join(tmpdir.path, 'no', 'such', 'dir', 'x.js')),
+  -2);
@@ -0,0 +1,31 @@
+// Flags: --loop-stall-threshold=50
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+
+// Stall the loop well past the 50ms threshold so the watchdog thread gets a
+// chance to capture at least one stack sample via an interrupt.
+const start = Date.now();
+while (Date.now() - start < 300);
+
+setImmediate(common.mustCall(() => {
+  const samples = process.loopStallSamples();
+  assert(Array.isArray(samples));
+  assert(samples.length >= 1);
+
+  for (const sample of samples) {
+    assert.strictEqual(typeof sample.timestamp, 'number');
+    assert(sample.stallDuration >= 50);
+    assert(Array.isArray(sample.stack));
+    for (const frame of sample.stack)
+      assert.strictEqual(typeof frame, 'string');
+  }
+
+  // The stalling code lives in this file, so it shows up in the samples.
+  assert(samples.some(
+    (sample) => sample.stack.some((frame) => frame.includes(__filename))));
+
+  // Draining is destructive; with the loop now healthy no new samples appear.
+  assert.strictEqual(process.loopStallSamples().length, 0);
+}));
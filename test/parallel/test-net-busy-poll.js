@@ -0,0 +1,40 @@
+// Flags: --busy-poll-window=50
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Verify that socket.setBusyPoll() accepts a microsecond budget, that data
+// still flows on a busy-polled socket, and that passing 0 disables it again.
+// The latency effect itself is timing-dependent and not asserted here.
+
+const server = net.createServer(common.mustCall((conn) => {
+  conn.setBusyPoll(50);
+  conn.on('data', common.mustCall((chunk) => {
+    assert.strictEqual(chunk.toString(), 'ping');
+    conn.end('pong');
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+
+  // Calling before 'connect' must defer rather than throw.
+  assert.strictEqual(client.setBusyPoll(50), client);
+
+  client.on('connect', common.mustCall(() => {
+    client.write('ping');
+  }));
+
+  let received = '';
+  client.on('data', (chunk) => received += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, 'pong');
+
+    // Disabling must also be accepted on a live handle.
+    assert.strictEqual(client.setBusyPoll(0), client);
+
+    client.end();
+    server.close();
+  }));
+}));
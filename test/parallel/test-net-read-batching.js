@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// With batched read delivery enabled, data written as many small chunks
+// must still arrive complete and in order; coalescing may merge chunks
+// but never reorders or drops bytes, and 'end' flushes the pending batch.
+
+const chunks = [];
+for (let i = 0; i < 64; i++)
+  chunks.push(`chunk-${i}\n`);
+const expected = chunks.join('');
+
+const server = net.createServer(common.mustCall((conn) => {
+  for (const chunk of chunks)
+    conn.write(chunk);
+  conn.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port);
+
+  // Chainable before the handle exists; the setting applies on connect.
+  assert.strictEqual(socket.setReadBatching(true), socket);
+
+  let received = '';
+  let events = 0;
+  socket.setEncoding('utf8');
+  socket.on('data', (chunk) => {
+    received += chunk;
+    events++;
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.strictEqual(received, expected);
+    // Coalescing depends on arrival timing, but batching must never
+    // produce more 'data' events than chunks written.
+    assert.ok(events <= chunks.length);
+    server.close();
+  }));
+}));
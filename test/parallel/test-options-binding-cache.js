@@ -0,0 +1,20 @@
+// Flags: --expose-internals
+'use strict';
+require('../common');
+
+// Tests that the options binding serializes the parsed CLI options only
+// once per Environment and hands out the same frozen object afterwards.
+
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const { getOptions } = internalBinding('options');
+
+const first = getOptions();
+const second = getOptions();
+
+assert.strictEqual(first, second);
+assert.ok(Object.isFrozen(first));
+
+// The cached serialization still reflects the options this process was
+// started with.
+assert.strictEqual(first.options.get('--expose-internals').value, true);
@@ -105,6 +105,17 @@ for (const cpu of cpus) {
   assert.strictEqual(typeof cpu.times.irq, 'number');
 }
 
+const parallelism = os.availableParallelism();
+is.number(parallelism);
+assert.ok(Number.isInteger(parallelism));
+assert.ok(parallelism >= 1);
+assert.ok(parallelism <= cpus.length);
+
+const effectiveMem = os.effectiveMemory();
+is.number(effectiveMem);
+assert.ok(effectiveMem > 0);
+assert.ok(effectiveMem <= os.totalmem());
+
 const type = os.type();
 is.string(type);
 assert.ok(type.length > 0);
@@ -245,6 +256,8 @@ assert.strictEqual(`${os.arch}`, os.arch());
 assert.strictEqual(`${os.platform}`, os.platform());
 
 assert.strictEqual(+os.totalmem, os.totalmem());
+assert.strictEqual(+os.availableParallelism, os.availableParallelism());
+assert.strictEqual(+os.effectiveMemory, os.effectiveMemory());
 
 // Assert that the following values are coercible to numbers.
 // On IBMi, os.uptime() returns 'undefined'
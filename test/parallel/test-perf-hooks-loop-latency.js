@@ -0,0 +1,32 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { loopLatency } = require('perf_hooks');
+
+// The native loop-latency histogram records without any opt-in; after a few
+// loop turns a snapshot must contain plausible statistics, and snapshotting
+// must not disturb recording.
+
+function check(stats) {
+  for (const key of ['min', 'max', 'mean', 'stddev', 'p50', 'p90', 'p99'])
+    assert.strictEqual(typeof stats[key], 'number');
+  assert.ok(stats.min <= stats.max);
+  assert.ok(stats.p50 <= stats.p99);
+}
+
+let turns = 0;
+(function spin() {
+  if (++turns < 10)
+    return setImmediate(spin);
+
+  const first = loopLatency();
+  check(first);
+  assert.ok(first.max > 0, 'expected loop turns to have been recorded');
+
+  // Recording keeps running after a snapshot.
+  setTimeout(common.mustCall(() => {
+    const second = loopLatency();
+    check(second);
+    assert.ok(second.max >= first.max);
+  }), 10);
+})();
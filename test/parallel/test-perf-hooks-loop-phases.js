@@ -0,0 +1,23 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+
+const phases = performance.nodeTiming.loopPhases;
+assert.strictEqual(typeof phases.timers, 'number');
+assert.strictEqual(typeof phases.poll, 'number');
+assert.strictEqual(typeof phases.check, 'number');
+assert.strictEqual(typeof phases.iterations, 'number');
+
+// Schedule a timer and an immediate so that the timers and check phases run,
+// then verify that the counters have advanced.
+setTimeout(common.mustCall(() => {
+  setImmediate(common.mustCall(() => {
+    const later = performance.nodeTiming.loopPhases;
+    assert(later.iterations > phases.iterations);
+    assert(later.timers > 0);
+    assert(later.check > 0);
+    assert(later.poll >= phases.poll);
+  }));
+}), 10);
@@ -0,0 +1,51 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance, PerformanceObserver } = require('perf_hooks');
+
+// Counters are not running yet.
+assert.strictEqual(performance.readHardwareCounters(), undefined);
+
+if (!performance.startHardwareCounters()) {
+  // Non-Linux, perf_event_paranoid restrictions or a container seccomp
+  // policy; the API must fail gracefully in that case.
+  assert.strictEqual(performance.readHardwareCounters(), undefined);
+  performance.stopHardwareCounters();  // Must not throw.
+  common.skip('hardware performance counters not available');
+}
+
+function spin() {
+  let sum = 0;
+  for (let i = 0; i < 1e6; i++)
+    sum += i * i;
+  return sum;
+}
+
+spin();
+
+const counters = performance.readHardwareCounters();
+for (const key of ['cycles', 'instructions', 'cacheReferences',
+                   'cacheMisses', 'branchMisses']) {
+  assert.strictEqual(typeof counters[key], 'bigint');
+}
+assert.ok(counters.cycles > 0n);
+assert.ok(counters.instructions > 0n);
+
+// Measures between two marks carry per-counter deltas.
+const obs = new PerformanceObserver(common.mustCall((list) => {
+  const entry = list.getEntries()[0];
+  assert.strictEqual(entry.name, 'spin');
+  assert.strictEqual(typeof entry.cycles, 'bigint');
+  assert.strictEqual(typeof entry.instructions, 'bigint');
+  assert.ok(entry.instructions > 0n);
+  obs.disconnect();
+  performance.stopHardwareCounters();
+  assert.strictEqual(performance.readHardwareCounters(), undefined);
+}));
+obs.observe({ entryTypes: ['measure'] });
+
+performance.mark('A');
+spin();
+performance.mark('B');
+performance.measure('spin', 'A', 'B');
@@ -0,0 +1,46 @@
+// Flags: --expose-internals
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const {
+  getActiveHandleCounts,
+  getActiveHandlesSlice,
+} = internalBinding('process_methods');
+
+function countsToMap(flat) {
+  assert.strictEqual(flat.length % 2, 0);
+  const out = new Map();
+  for (let i = 0; i < flat.length; i += 2) {
+    assert.strictEqual(typeof flat[i], 'string');
+    assert.ok(Number.isInteger(flat[i + 1]) && flat[i + 1] > 0);
+    out.set(flat[i], flat[i + 1]);
+  }
+  return out;
+}
+
+const before = countsToMap(getActiveHandleCounts()).get('TCPSERVERWRAP') || 0;
+
+const server = net.createServer().listen(0, () => {
+  const after = countsToMap(getActiveHandleCounts()).get('TCPSERVERWRAP');
+  assert.strictEqual(after, before + 1);
+
+  // The paginated walk, concatenated, matches the one-shot variant.
+  const all = process._getActiveHandles();
+  const paged = [];
+  for (let offset = 0; ; offset += 2) {
+    const page = getActiveHandlesSlice(offset, 2);
+    paged.push(...page);
+    if (page.length < 2) break;
+  }
+  assert.deepStrictEqual(paged, all);
+  assert.ok(paged.includes(server));
+
+  server.close(() => {
+    const closed = countsToMap(getActiveHandleCounts()).get('TCPSERVERWRAP') ||
+                   0;
+    assert.strictEqual(closed, before);
+  });
+});
@@ -0,0 +1,21 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const breakdown = process.memoryUsage.detailed();
+assert.strictEqual(typeof breakdown, 'object');
+// The Environment itself is always tracked.
+assert(breakdown.Environment > 0);
+for (const [name, bytes] of Object.entries(breakdown)) {
+  assert.strictEqual(typeof name, 'string');
+  assert(Number.isFinite(bytes) && bytes >= 0,
+         `${name} should map to a non-negative number, got ${bytes}`);
+}
+
+// Live handle wraps must show up in the breakdown.
+const server = net.createServer().listen(0, common.mustCall(() => {
+  const withServer = process.memoryUsage.detailed();
+  assert(withServer.TCPWrap > 0);
+  server.close();
+}));
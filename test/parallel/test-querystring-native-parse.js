@@ -0,0 +1,45 @@
+'use strict';
+require('../common');
+
+// The default-configured parse() is served by the native fast path in
+// src/node_querystring.cc; forcing a custom decoder takes the JS path.
+// Verify that both agree on the awkward inputs the fast path handles
+// itself: malformed percent escapes, '+' handling, repeated '=', empty
+// pairs counting against maxKeys, and the non-ASCII bailout.
+
+const assert = require('assert');
+const qs = require('querystring');
+
+function check(input, expected, options) {
+  assert.deepStrictEqual({ ...qs.parse(input, null, null, options) },
+                         expected,
+                         `parse(${JSON.stringify(input)})`);
+}
+
+check('foo=bar&baz=qux', { foo: 'bar', baz: 'qux' });
+check('a=1&a=2&a=3', { a: ['1', '2', '3'] });
+check('a+b=c+d', { 'a b': 'c d' });
+check('a=b=c&==', { a: 'b=c', '': '=' });
+check('=', { '': '' });
+check('a', { a: '' });
+check('&&a=b&&', { a: 'b' });
+check('%41%20%42=%61%2Db', { 'A B': 'a-b' });
+check('100%=%', { '100%': '%' });
+check('a=%4', { a: '%4' });
+check('a=%4g', { a: '%4g' });
+check('a=%zz', { a: '%zz' });
+check('caf%C3%A9=%E2%82%AC', { café: '€' });
+
+// Empty pairs consume the maxKeys budget, matching the JS implementation.
+check('a=1&&b=2', { a: '1' }, { maxKeys: 2 });
+check('a=1&b=2&c=3', { a: '1', b: '2' }, { maxKeys: 2 });
+check('a=1&b=2', { a: '1', b: '2' }, { maxKeys: 0 });
+
+// Literal non-ASCII input falls back to the JS parser; results must agree
+// with an explicitly decoded equivalent.
+check('café=€&x=%C3%A9', { café: '€', x: 'é' });
+assert.deepStrictEqual(qs.parse('café=1'), qs.parse('caf%C3%A9=1'));
+
+// Invalid UTF-8 from percent escapes decodes to replacement characters,
+// like the decodeURIComponent fallback does.
+assert.deepStrictEqual({ ...qs.parse('a=%FF') }, { a: '�' });
@@ -0,0 +1,38 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+
+// *Must* match Environment::TaskQueueStats::Fields in src/env.h.
+const kTicksEnqueued = 0;
+const kTicksDrained = 1;
+const kMaxTickDepth = 2;
+const kMicrotaskDrainTime = 3;
+
+const { taskQueueStats } = internalBinding('task_queue');
+
+const enqueuedBefore = taskQueueStats[kTicksEnqueued];
+
+// Each nextTick() call bumps the enqueued counter immediately.
+for (let i = 0; i < 5; i++)
+  process.nextTick(common.mustCall());
+assert.strictEqual(taskQueueStats[kTicksEnqueued], enqueuedBefore + 5);
+
+// Ticks scheduled from within a tick extend the same drain run, so the
+// maximum observed depth covers the whole chain.
+process.nextTick(common.mustCall(() => {
+  process.nextTick(common.mustCall(() => {
+    process.nextTick(common.mustCall());
+  }));
+}));
+
+setImmediate(common.mustCall(() => {
+  assert(taskQueueStats[kTicksDrained] >= 8);
+  assert(taskQueueStats[kMaxTickDepth] >= 8);
+  assert.strictEqual(taskQueueStats[kTicksEnqueued],
+                     taskQueueStats[kTicksDrained]);
+  // Microtask checkpoints ran at least once by now.
+  assert(taskQueueStats[kMicrotaskDrainTime] >= 0);
+}));
@@ -0,0 +1,38 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const {
+  setCoarseTimeout,
+  clearCoarseTimeout
+} = require('internal/timers');
+
+// A coarse timeout fires, though possibly a few milliseconds late.
+const start = Date.now();
+setCoarseTimeout(common.mustCall(() => {
+  assert(Date.now() - start >= 10);
+}), 10);
+
+// A cancelled coarse timeout never fires.
+const cancelled = setCoarseTimeout(common.mustNotCall(), 20);
+clearCoarseTimeout(cancelled);
+
+// Cancelling twice (or cancelling an unknown id) is a no-op.
+clearCoarseTimeout(cancelled);
+clearCoarseTimeout(-1);
+
+// High-churn arm/cancel cycles leave the surviving timers intact.
+let fired = 0;
+for (let i = 0; i < 1000; i++) {
+  const id = setCoarseTimeout(common.mustNotCall(), 1000);
+  clearCoarseTimeout(id);
+}
+for (let i = 0; i < 10; i++) {
+  setCoarseTimeout(common.mustCall(() => {
+    fired++;
+  }), 15 + i);
+}
+process.on('exit', () => {
+  assert.strictEqual(fired, 10);
+});
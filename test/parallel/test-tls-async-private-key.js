@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const tls = require('tls');
+
+// With asyncPrivateKey enabled, the RSA sign of a full handshake runs on
+// the threadpool and the handshake pauses and resumes around it. A burst
+// of concurrent full handshakes (no resumption material shared) must all
+// complete and carry application data both ways.
+
+const CONNECTIONS = 8;
+
+const server = tls.createServer({
+  key: fixtures.readKey('rsa_private.pem'),
+  cert: fixtures.readKey('rsa_cert.crt'),
+  asyncPrivateKey: true,
+}, common.mustCall((socket) => {
+  socket.pipe(socket);
+}, CONNECTIONS));
+
+server.listen(0, common.mustCall(() => {
+  let pending = CONNECTIONS;
+  for (let i = 0; i < CONNECTIONS; i++) {
+    const socket = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+    }, common.mustCall(() => {
+      socket.setEncoding('utf8');
+      socket.write(`echo-${i}`);
+      socket.on('data', common.mustCall((data) => {
+        assert.strictEqual(data, `echo-${i}`);
+        socket.end();
+        if (--pending === 0)
+          server.close();
+      }));
+    }));
+  }
+}));
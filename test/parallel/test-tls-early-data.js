@@ -0,0 +1,67 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const tls = require('tls');
+
+// TLS1.3 0-RTT: a resuming client sends its first request as early data in
+// the same flight as the ClientHello, and the server gates delivery on the
+// 'earlyData' event. Whether early data is actually accepted depends on the
+// OpenSSL build and the ticket contents, so this test only asserts that the
+// payload arrives one way or the other and that the reported status is
+// consistent - no assertion on the saved round trip itself.
+
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  minVersion: 'TLSv1.3',
+  maxEarlyData: 16384,
+};
+
+const server = tls.createServer(options, (socket) => {
+  socket.on('data', (chunk) => socket.end(chunk));  // Echo.
+});
+
+// Echoing is idempotent, so replayed early data is harmless here.
+server.on('earlyData', (socket, accept) => accept());
+
+server.listen(0, common.mustCall(() => {
+  // The first connection only harvests a session ticket.
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+  }, common.mustCall());
+
+  client.once('session', common.mustCall((session) => {
+    client.end();
+    resume(session);
+  }));
+
+  function resume(session) {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      session,
+      earlyData: 'hello',
+    }, common.mustCall(() => {
+      const status = client.getEarlyDataStatus();
+      assert(['accepted', 'rejected', 'not-sent'].includes(status));
+      if (status !== 'accepted') {
+        // Early data is never retransmitted automatically; rewrite it
+        // through the regular stream.
+        client.write('hello');
+      }
+
+      let reply = '';
+      client.setEncoding('utf8');
+      client.on('data', (chunk) => reply += chunk);
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(reply, 'hello');
+        server.close();
+      }));
+    }));
+  }
+}));
@@ -0,0 +1,116 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const net = require('net');
+const tls = require('tls');
+
+// Tests setRecordBatching(): with a watermark set, small writes issued in
+// the same tick must coalesce into far fewer TLS records than the
+// unbatched default produces, while the decrypted byte stream stays
+// identical. Record counts are observed by a TCP proxy between client
+// and server that parses the record headers of the client-to-server
+// ciphertext.
+
+const kWrites = 40;
+const kWriteSize = 25;
+const kPhaseBytes = kWrites * kWriteSize;
+
+function phasePayload(tag) {
+  const chunks = [];
+  for (let i = 0; i < kWrites; i++)
+    chunks.push(Buffer.alloc(kWriteSize, `${tag}${i}-`));
+  return chunks;
+}
+
+const plain = phasePayload('p');
+const batched = phasePayload('b');
+
+// Counted per phase; null while the handshake is still in progress.
+let phase = null;
+const records = { plain: 0, batched: 0 };
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+}, common.mustCall((socket) => {
+  const received = [];
+  let bytes = 0;
+  socket.on('data', (chunk) => {
+    received.push(chunk);
+    bytes += chunk.length;
+    // Acknowledge each completed phase so the client flips phases only
+    // after all of the previous phase's records passed the proxy.
+    if (bytes === kPhaseBytes || bytes === 2 * kPhaseBytes)
+      socket.write('ack');
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(received),
+                           Buffer.concat(plain.concat(batched)));
+    socket.end();
+  }));
+}));
+
+// The proxy relays bytes unmodified and counts application-data records
+// (content type 23, 5-byte header) flowing from client to server.
+const proxy = net.createServer(common.mustCall((upstream) => {
+  const downstream = net.connect(server.address().port);
+  let pending = Buffer.alloc(0);
+  upstream.on('data', (chunk) => {
+    pending = Buffer.concat([pending, chunk]);
+    while (pending.length >= 5) {
+      const length = pending.readUInt16BE(3);
+      if (pending.length < 5 + length)
+        break;
+      if (pending[0] === 23 && phase !== null)
+        records[phase]++;
+      pending = pending.slice(5 + length);
+    }
+    downstream.write(chunk);
+  });
+  downstream.on('data', (chunk) => upstream.write(chunk));
+  upstream.on('end', () => downstream.end());
+  downstream.on('end', () => upstream.end());
+}));
+
+server.listen(0, common.mustCall(() => {
+  proxy.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: proxy.address().port,
+      rejectUnauthorized: false,
+    }, common.mustCall(() => {
+      // Phase one: default behavior, one record per write() call.
+      phase = 'plain';
+      for (const chunk of plain)
+        client.write(chunk);
+    }));
+
+    let acks = 0;
+    client.on('data', common.mustCall(() => {
+      acks++;
+      if (acks === 1) {
+        // Phase two: same writes with batching on; the watermark exceeds
+        // the total, so everything coalesces until the loop-turn flush.
+        client._handle.setRecordBatching(64 * 1024);
+        phase = 'batched';
+        for (const chunk of batched)
+          client.write(chunk);
+        return;
+      }
+      client.end();
+      proxy.close();
+      server.close();
+      // The unbatched phase pays roughly one record per write; batching
+      // must collapse the same writes into a handful of fuller records.
+      assert(records.plain >= kWrites / 2,
+             `expected ~${kWrites} unbatched records, saw ${records.plain}`);
+      assert(records.batched <= 5,
+             `expected few batched records, saw ${records.batched}`);
+      assert(records.batched < records.plain);
+    }, 2));
+  }));
+}));
@@ -0,0 +1,66 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const tls = require('tls');
+const { constants } = require('crypto');
+const {
+  Worker, isMainThread, parentPort
+} = require('worker_threads');
+
+// A session established with a server on one thread must be resumable at
+// a server on another thread when both opt into the shared session cache.
+// Tickets are disabled and TLS 1.2 forced so that resumption goes through
+// the session-id cache rather than stateless tickets.
+
+const serverOptions = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  sharedSessionCache: true,
+  secureOptions: constants.SSL_OP_NO_TICKET,
+  maxVersion: 'TLSv1.2',
+};
+
+if (!isMainThread) {
+  // Worker: serve handshakes until the main thread says we are done.
+  const server = tls.createServer(serverOptions, (socket) => socket.end());
+  server.listen(0, () => parentPort.postMessage(server.address().port));
+  parentPort.on('message', common.mustCall(() => {
+    server.close();
+    parentPort.unref();
+  }));
+} else {
+  const server = tls.createServer(serverOptions, (socket) => socket.end());
+  const worker = new Worker(__filename);
+
+  worker.on('message', common.mustCall((workerPort) => {
+    // First handshake against the worker's server establishes the session.
+    const first = tls.connect({
+      port: workerPort,
+      rejectUnauthorized: false,
+      maxVersion: 'TLSv1.2',
+    }, common.mustCall(() => {
+      assert.strictEqual(first.isSessionReused(), false);
+      const session = first.getSession();
+      assert.ok(session);
+      first.end();
+
+      server.listen(0, common.mustCall(() => {
+        // Second handshake resumes it at the main thread's server.
+        const second = tls.connect({
+          port: server.address().port,
+          rejectUnauthorized: false,
+          maxVersion: 'TLSv1.2',
+          session,
+        }, common.mustCall(() => {
+          assert.strictEqual(second.isSessionReused(), true);
+          second.end();
+          server.close();
+          worker.postMessage('done');
+        }));
+      }));
+    }));
+  }));
+}
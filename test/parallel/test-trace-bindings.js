@@ -0,0 +1,23 @@
+'use strict';
+require('../common');
+
+// Tests that --trace-bindings reports internal binding initialization
+// times on stderr without affecting the program.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const child = spawnSync(process.execPath,
+                        ['--trace-bindings', '-e', 'console.log(42)']);
+assert.strictEqual(child.status, 0, child.stderr.toString());
+assert.strictEqual(child.stdout.toString().trim(), '42');
+
+const stderr = child.stderr.toString();
+// Bootstrap always touches a few well-known bindings.
+assert.match(stderr, /\(node:\d+\) binding fs: \d+\.\d us/);
+assert.match(stderr, /\(node:\d+\) binding util: \d+\.\d us/);
+
+// Without the flag there is no binding output.
+const quiet = spawnSync(process.execPath, ['-e', 'console.log(42)']);
+assert.strictEqual(quiet.status, 0);
+assert.ok(!quiet.stderr.toString().includes(') binding '));
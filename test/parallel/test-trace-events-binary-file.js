@@ -0,0 +1,57 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+const CODE =
+  'setTimeout(() => { for (let i = 0; i < 100000; i++) { "test" + i } }, 1)';
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+const FILE_NAME = path.join(tmpdir.path, 'node_trace.bin');
+
+// Layout from src/tracing/node_binary_trace_writer.h.
+const HEADER_SIZE = 4096;
+const RECORD_SIZE = 128;
+const MAGIC = 0x3143525445444f4en;  // "NODETRC1"
+
+const proc = cp.spawn(
+  process.execPath,
+  [ '--trace-events-enabled',
+    '--trace-event-binary-file', FILE_NAME,
+    '-e', CODE ],
+  { cwd: tmpdir.path }
+);
+
+proc.once('exit', common.mustCall(() => {
+  assert(fs.existsSync(FILE_NAME));
+  const data = fs.readFileSync(FILE_NAME);
+
+  assert.strictEqual(data.readBigUInt64LE(0), MAGIC);
+  assert.strictEqual(data.readUInt32LE(8), 1);  // version
+  assert.strictEqual(data.readUInt32LE(12), RECORD_SIZE);
+  const capacity = data.readBigUInt64LE(16);
+  const sequence = data.readBigUInt64LE(24);
+  assert.strictEqual(data.length, HEADER_SIZE + Number(capacity) * RECORD_SIZE);
+  assert.ok(sequence > 0n, 'expected trace records to have been written');
+
+  // Decode a few records and check they look like trace events.
+  const count = Number(sequence < capacity ? sequence : capacity);
+  let sawNodeCategory = false;
+  for (let i = 0; i < count; i++) {
+    const offset = HEADER_SIZE + (i * RECORD_SIZE);
+    const pid = data.readInt32LE(offset + 24);
+    const phase = data.toString('ascii', offset + 32, offset + 33);
+    const name = data.toString('utf8', offset + 33, offset + 96)
+      .replace(/\0.*$/, '');
+    const cat = data.toString('utf8', offset + 96, offset + 128)
+      .replace(/\0.*$/, '');
+    assert.strictEqual(pid, proc.pid);
+    assert.ok(phase.length === 1);
+    assert.ok(name.length > 0);
+    if (cat.includes('node')) sawNodeCategory = true;
+  }
+  assert.ok(sawNodeCategory);
+}));
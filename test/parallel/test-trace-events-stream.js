@@ -0,0 +1,40 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+const CODE = `
+  const net = require('net');
+  const server = net.createServer((socket) => {
+    socket.end('pong');
+  }).listen(0, () => {
+    const client = net.connect(server.address().port, () => {
+      client.write('ping');
+    });
+    client.on('data', () => {});
+    client.on('close', () => server.close());
+  });
+`;
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+const FILE_NAME = path.join(tmpdir.path, 'node_trace.1.log');
+
+const proc = cp.spawn(
+  process.execPath,
+  [ '--trace-event-categories', 'node.stream', '-e', CODE ],
+  { cwd: tmpdir.path }
+);
+
+proc.once('exit', common.mustCall(() => {
+  assert(fs.existsSync(FILE_NAME));
+  const data = fs.readFileSync(FILE_NAME);
+  const traces = JSON.parse(data.toString()).traceEvents;
+  const chunks = traces.filter(
+    (trace) => trace.name === 'read_chunk' &&
+               trace.cat.includes('node.stream'));
+  assert.ok(chunks.length > 0, 'expected stream read_chunk trace events');
+  assert.ok(chunks.some((trace) => trace.args.nread > 0));
+}));
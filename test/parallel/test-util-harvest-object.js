@@ -0,0 +1,73 @@
+// Flags: --expose-internals
+'use strict';
+require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const {
+  harvestObject,
+  kHarvestPrimitive,
+  kHarvestString,
+  kHarvestObject,
+  kHarvestOpaque,
+  kHarvestTruncated,
+} = internalBinding('util');
+
+function toMap(flat) {
+  const out = new Map();
+  for (let i = 0; i < flat.length; i += 3)
+    out.set(flat[i], { kind: flat[i + 1], value: flat[i + 2] });
+  return out;
+}
+
+{
+  const desc = toMap(harvestObject({
+    num: 1,
+    str: 'hello',
+    nested: { deep: true },
+    fn() {},
+  }, 1, 16));
+
+  assert.strictEqual(desc.get('num').kind, kHarvestPrimitive);
+  assert.strictEqual(desc.get('num').value, 1);
+  assert.strictEqual(desc.get('str').kind, kHarvestString);
+  assert.strictEqual(desc.get('str').value, 'hello');
+  assert.strictEqual(desc.get('nested').kind, kHarvestObject);
+  const nested = toMap(desc.get('nested').value);
+  assert.strictEqual(nested.get('deep').value, true);
+  assert.strictEqual(desc.get('fn').kind, kHarvestOpaque);
+}
+
+{
+  // Long strings are cut to a bounded prefix.
+  const desc = toMap(harvestObject({ s: 'x'.repeat(1000) }, 0, 16));
+  assert.strictEqual(desc.get('s').kind, kHarvestString);
+  assert.strictEqual(desc.get('s').value, 'x'.repeat(128));
+}
+
+{
+  // Depth 0 reports nested objects opaquely by constructor name.
+  const desc = toMap(harvestObject({ d: new Date() }, 0, 16));
+  assert.strictEqual(desc.get('d').kind, kHarvestOpaque);
+  assert.strictEqual(desc.get('d').value, 'Date');
+}
+
+{
+  // Getters must not run.
+  let ran = false;
+  const obj = { get boom() { ran = true; return 1; } };
+  const desc = toMap(harvestObject(obj, 1, 16));
+  assert.strictEqual(ran, false);
+  assert.strictEqual(desc.get('boom').kind, kHarvestOpaque);
+  assert.strictEqual(desc.get('boom').value, 'Accessor');
+}
+
+{
+  // Property count is bounded; the overflow is reported, not dropped.
+  const big = {};
+  for (let i = 0; i < 10; i++) big[`k${i}`] = i;
+  const flat = harvestObject(big, 0, 4);
+  assert.strictEqual(flat.length, 5 * 3);
+  assert.strictEqual(flat[flat.length - 3], null);
+  assert.strictEqual(flat[flat.length - 2], kHarvestTruncated);
+  assert.strictEqual(flat[flat.length - 1], 6);
+}
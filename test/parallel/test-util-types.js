@@ -284,3 +284,20 @@ for (const [ value, _method ] of [
   await m.evaluate();
   assert.ok(types.isModuleNamespaceObject(m.namespace));
 })();
+
+{
+  // classify() must agree with the individual predicates, bit for bit.
+  const { classify, classifyBits } = internalBinding('types');
+  assert.strictEqual(typeof classify, 'function');
+  // Not part of the public util.types surface.
+  assert.strictEqual(types.classify, undefined);
+  assert.strictEqual(types.classifyBits, undefined);
+  const binding = internalBinding('types');
+  for (const value of [new Date(), /re/, new Map(), Promise.resolve(), {}]) {
+    const mask = classify(value);
+    for (const [name, bit] of Object.entries(classifyBits)) {
+      assert.strictEqual(!!(mask & bit), binding[name](value),
+                         `${name} mismatch for ${inspect(value)}`);
+    }
+  }
+}
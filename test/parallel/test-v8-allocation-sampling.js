@@ -0,0 +1,38 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const v8 = require('v8');
+const crypto = require('crypto');
+const { executionAsyncId } = require('async_hooks');
+
+[0, -1, 1.5, '1', null].forEach((i) => {
+  assert.throws(() => v8.startAllocationSampling(i), {
+    code: /ERR_INVALID_ARG_TYPE|ERR_OUT_OF_RANGE/
+  });
+});
+
+// Table is empty while the profiler is stopped.
+assert.deepStrictEqual(v8.getAllocationSamples(), []);
+
+// Interval 1 samples every allocation, so the buffers allocated below must
+// show up attributed to the current async id. crypto.randomBytes() output
+// goes through the native buffer allocation path that is being sampled.
+v8.startAllocationSampling(1);
+
+const retain = [];
+for (let i = 0; i < 32; i++)
+  retain.push(crypto.randomBytes(4096));
+
+const samples = v8.getAllocationSamples();
+const own = samples.find((sample) => sample.asyncId === executionAsyncId());
+assert.ok(own, 'expected samples for the current async id');
+assert.ok(own.count >= 32);
+assert.ok(own.bytes >= 32 * 4096);
+assert.strictEqual(own.estimatedCount, own.count);
+assert.strictEqual(own.estimatedBytes, own.bytes);
+
+// Stopping discards the table.
+v8.stopAllocationSampling();
+assert.deepStrictEqual(v8.getAllocationSamples(), []);
@@ -0,0 +1,51 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+// v8.clone() snapshots the value immediately and materializes the copy
+// lazily on the handle's first deserialize() call.
+
+{
+  const original = { answer: 42, nested: { list: [1, 2, 3] } };
+  const handle = v8.clone(original);
+
+  // The clone is a snapshot: mutations after clone() are not observed.
+  original.answer = 0;
+  original.nested.list.push(4);
+
+  const copy = handle.deserialize();
+  assert.deepStrictEqual(copy, { answer: 42, nested: { list: [1, 2, 3] } });
+  assert.notStrictEqual(copy, original);
+  assert.notStrictEqual(copy.nested, original.nested);
+
+  // The materialized value is cached; every deserialize() returns it.
+  assert.strictEqual(handle.deserialize(), copy);
+}
+
+// Structured-clone value coverage, including circular references.
+{
+  const circular = { name: 'loop' };
+  circular.self = circular;
+  const value = {
+    map: new Map([['key', 'value']]),
+    set: new Set([1, 2]),
+    date: new Date(0),
+    bytes: new Uint8Array([1, 2, 3]),
+    circular,
+  };
+  const copy = v8.clone(value).deserialize();
+  assert.deepStrictEqual(copy.map, value.map);
+  assert.deepStrictEqual(copy.set, value.set);
+  assert.deepStrictEqual(copy.date, value.date);
+  assert.deepStrictEqual(copy.bytes, value.bytes);
+  assert.strictEqual(copy.circular.self, copy.circular);
+}
+
+// Primitives round-trip.
+for (const primitive of [null, true, 'text', 42.5]) {
+  assert.strictEqual(v8.clone(primitive).deserialize(), primitive);
+}
+
+// Values the structured clone algorithm rejects throw at clone() time.
+assert.throws(() => v8.clone(() => {}), /could not be cloned/);
@@ -0,0 +1,122 @@
+'use strict';
+
+if (!process.features.inspector) return;
+
+// Tests that --coverage-stream-interval appends incremental coverage
+// deltas to a stream file instead of one JSON dump at exit.
+
+require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+let dirc = 0;
+function nextdir() {
+  return `cov_${++dirc}`;
+}
+
+// Streams coverage for a program with no async logic; the only delta is
+// the one taken at exit.
+{
+  const coverageDirectory = path.join(tmpdir.path, nextdir());
+  const output = spawnSync(process.execPath, [
+    '--coverage-stream-interval', '10',
+    require.resolve('../fixtures/v8-coverage/basic'),
+  ], { env: { ...process.env, NODE_V8_COVERAGE: coverageDirectory } });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  assert.strictEqual(output.stderr.toString(), '');
+  const ranges = getStreamedCoverage('basic.js', coverageDirectory);
+  // First branch executed.
+  assert.strictEqual(ranges[0].count, 1);
+  // Second branch did not execute.
+  assert.strictEqual(ranges[1].count, 0);
+}
+
+// Periodic deltas are taken while the program is still running.
+{
+  const coverageDirectory = path.join(tmpdir.path, nextdir());
+  const output = spawnSync(process.execPath, [
+    '--coverage-stream-interval', '10',
+    require.resolve('../fixtures/v8-coverage/timeout'),
+  ], { env: { ...process.env, NODE_V8_COVERAGE: coverageDirectory } });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  assert.strictEqual(output.stderr.toString(), '');
+  const records = getStreamRecords(coverageDirectory);
+  assert.ok(records.length >= 2,
+            `expected at least 2 delta records, got ${records.length}`);
+  const ranges = getStreamedCoverage('timeout.js', coverageDirectory);
+  // First branch executed.
+  assert.strictEqual(ranges[0].count, 1);
+}
+
+// --coverage-stream-interval is a noop without NODE_V8_COVERAGE.
+{
+  const coverageDirectory = path.join(tmpdir.path, nextdir());
+  const output = spawnSync(process.execPath, [
+    '--coverage-stream-interval', '10',
+    require.resolve('../fixtures/v8-coverage/basic'),
+  ], { env: { ...process.env } });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  assert.strictEqual(output.stderr.toString(), '');
+  assert.ok(!fs.existsSync(coverageDirectory));
+}
+
+// Parses the length-prefixed delta records from the stream file, and
+// checks that no accumulated JSON dump was written next to it.
+function getStreamRecords(coverageDirectory) {
+  const files = fs.readdirSync(coverageDirectory);
+  const streamFiles = files.filter((file) =>
+    file.startsWith('coverage-stream-'));
+  assert.strictEqual(streamFiles.length, 1);
+  assert.deepStrictEqual(
+    files.filter((file) => /^coverage-.+\.json$/.test(file)), []);
+  const data = fs.readFileSync(
+    path.join(coverageDirectory, streamFiles[0]));
+  const records = [];
+  let offset = 0;
+  while (offset < data.length) {
+    const length = data.readUInt32LE(offset);
+    offset += 4;
+    records.push(JSON.parse(data.slice(offset, offset + length)));
+    offset += length;
+  }
+  return records;
+}
+
+// Merges the deltas for a given fixture name by summing the call counts
+// per range, the same way an offline merge would, and returns the ranges
+// sorted by start offset.
+function getStreamedCoverage(fixtureFile, coverageDirectory) {
+  const merged = new Map();
+  for (const record of getStreamRecords(coverageDirectory)) {
+    for (const script of record.result.result) {
+      if (!script.url.includes(`/${fixtureFile}`)) continue;
+      for (const fn of script.functions) {
+        for (const range of fn.ranges) {
+          const key = `${range.startOffset}-${range.endOffset}`;
+          const existing = merged.get(key);
+          if (existing === undefined) {
+            merged.set(key, { ...range });
+          } else {
+            existing.count += range.count;
+          }
+        }
+      }
+    }
+  }
+  return [...merged.values()].sort(
+    (a, b) => a.startOffset - b.startOffset);
+}
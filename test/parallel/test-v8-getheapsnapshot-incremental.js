@@ -0,0 +1,23 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+[null, 1, 'incremental'].forEach((i) => {
+  assert.throws(() => v8.getHeapSnapshot(i),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+assert.throws(() => v8.getHeapSnapshot({ incremental: 1 }),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+
+// An incremental snapshot stream must produce the same kind of JSON
+// document as the default mode, just spread across multiple loop turns.
+const stream = v8.getHeapSnapshot({ incremental: true });
+let data = '';
+stream.setEncoding('utf8');
+stream.on('data', (chunk) => { data += chunk; });
+stream.on('end', common.mustCall(() => {
+  const parsed = JSON.parse(data);
+  assert.ok(Array.isArray(parsed.snapshot.meta.node_fields));
+  assert.ok(parsed.nodes.length > 0);
+}));
@@ -0,0 +1,33 @@
+// Flags: --expose-gc
+'use strict';
+require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+[null, 1, 'true', {}].forEach((i) => {
+  assert.throws(() => v8.setHeapSpaceStatisticsGCTracking(i),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+
+v8.setHeapSpaceStatisticsGCTracking(true);
+// Enabling twice is a no-op.
+v8.setHeapSpaceStatisticsGCTracking(true);
+
+// The buffer is seeded on enable, so readings are valid before any GC.
+const before = v8.getHeapSpaceStatistics();
+assert.ok(before.some((space) => space.space_used_size > 0));
+
+// After allocating and collecting, the GC epilogue must have refreshed
+// the buffer without an explicit update call.
+const retain = [];
+for (let i = 0; i < 1e4; i++)
+  retain.push({ i });
+global.gc();
+
+const after = v8.getHeapSpaceStatistics();
+assert.ok(after.some((space) => space.space_used_size > 0));
+assert.notDeepStrictEqual(before, after);
+
+v8.setHeapSpaceStatisticsGCTracking(false);
+// Disabling twice is a no-op.
+v8.setHeapSpaceStatisticsGCTracking(false);
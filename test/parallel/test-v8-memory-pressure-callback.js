@@ -0,0 +1,17 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+// Installing, replacing and clearing the callback must not throw. Actually
+// firing it requires driving the heap close to its limit, which is not
+// something a parallel test can do reliably, so only the API surface is
+// checked here.
+v8.setMemoryPressureCallback(() => {});
+v8.setMemoryPressureCallback(() => {});
+v8.setMemoryPressureCallback();
+
+[null, 0, 'callback', {}].forEach((invalid) => {
+  assert.throws(() => v8.setMemoryPressureCallback(invalid),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
@@ -0,0 +1,42 @@
+'use strict';
+require('../common');
+
+// Tests that --v8-tuning-profile resolves named profiles into V8 flags
+// before isolate creation and that explicit flags take precedence.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const heapLimitScript =
+  'console.log(require("v8").getHeapStatistics().heap_size_limit)';
+
+function heapLimit(...args) {
+  const child = spawnSync(process.execPath,
+                          [...args, '-e', heapLimitScript]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return Number(child.stdout.toString());
+}
+
+// Every profile must be accepted and produce a working process.
+for (const profile of ['server-throughput', 'low-memory', 'fast-startup']) {
+  heapLimit(`--v8-tuning-profile=${profile}`);
+}
+
+// The low-memory profile caps the old space at 2048 MB; allow some slack
+// for the young generation and other V8 overhead.
+const lowMemoryLimit = heapLimit('--v8-tuning-profile=low-memory');
+assert.ok(lowMemoryLimit <= 2304 * 1024 * 1024,
+          `low-memory heap limit too large: ${lowMemoryLimit}`);
+
+// An explicit V8 flag wins over the profile.
+const overridden = heapLimit('--v8-tuning-profile=low-memory',
+                             '--max-old-space-size=3000');
+assert.ok(overridden > 2560 * 1024 * 1024,
+          `explicit flag did not override profile: ${overridden}`);
+
+// Unknown profile names are rejected at startup.
+const bad = spawnSync(process.execPath,
+                      ['--v8-tuning-profile=potato', '-e', '0']);
+assert.notStrictEqual(bad.status, 0);
+assert.ok(bad.stderr.toString().includes(
+  'invalid value for --v8-tuning-profile'));
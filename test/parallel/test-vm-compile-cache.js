@@ -0,0 +1,56 @@
+'use strict';
+require('../common');
+
+// Tests that --compile-cache-dir caches vm.Script compilations on disk:
+// a second process compiling the same source consumes the cache entry
+// written by the first, and results stay correct either way.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'compile-cache');
+
+const scriptFile = path.join(tmpdir.path, 'run.js');
+fs.writeFileSync(scriptFile, `
+  const vm = require('vm');
+  const source = 'function add(a, b) { return a + b; } add(40, 2);';
+  const script = new vm.Script(source, { filename: 'cached.js' });
+  console.log(script.runInThisContext());
+`);
+
+function run(flags) {
+  const child = spawnSync(process.execPath, [...flags, scriptFile]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return child.stdout.toString().trim();
+}
+
+// Without the flag, no cache directory appears.
+assert.strictEqual(run([]), '42');
+assert.ok(!fs.existsSync(cacheDir));
+
+// Cold run: the script compiles normally and an entry is written. The write
+// happens on the threadpool but completes before process exit.
+assert.strictEqual(run([`--compile-cache-dir=${cacheDir}`]), '42');
+const entries = fs.readdirSync(cacheDir);
+assert.ok(entries.length > 0);
+assert.ok(entries.every((name) => name.endsWith('.cache')));
+
+// Warm run: the entry is consumed and the result is unchanged.
+assert.strictEqual(run([`--compile-cache-dir=${cacheDir}`]), '42');
+assert.deepStrictEqual(fs.readdirSync(cacheDir), entries);
+
+// A corrupted entry is rejected by V8 and rewritten, not wrongly consumed.
+const entryPath = path.join(cacheDir, entries[0]);
+fs.writeFileSync(entryPath, Buffer.from('not a code cache'));
+assert.strictEqual(run([`--compile-cache-dir=${cacheDir}`]), '42');
+
+// With a size limit of one byte no new entries can be written.
+tmpdir.refresh();
+assert.strictEqual(
+  run([`--compile-cache-dir=${cacheDir}`, '--compile-cache-max-size=1']),
+  '42');
+assert.ok(!fs.existsSync(cacheDir) || fs.readdirSync(cacheDir).length === 0);
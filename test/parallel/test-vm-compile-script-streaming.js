@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common');
+
+// Tests vm.compileScriptStreaming(): scripts compiled through V8's
+// streaming parser behave like regular vm.Script instances.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const vm = require('vm');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const scriptFile = path.join(tmpdir.path, 'big.js');
+// Large enough that streaming spans multiple read chunks.
+let source = 'let total = 0;\n';
+for (let i = 0; i < 20000; i++) {
+  source += `function f${i}() { return ${i}; } total += f${i}();\n`;
+}
+source += 'total;\n';
+fs.writeFileSync(scriptFile, source);
+const expected = 20000 * 19999 / 2;
+
+// Compile from a path.
+vm.compileScriptStreaming(scriptFile).then(common.mustCall((script) => {
+  assert(script instanceof vm.Script);
+  assert.strictEqual(script.runInThisContext(), expected);
+}));
+
+// Compile from an open file descriptor.
+const fd = fs.openSync(scriptFile, 'r');
+vm.compileScriptStreaming(fd, { filename: 'big.js' })
+  .then(common.mustCall((script) => {
+    fs.closeSync(fd);
+    assert.strictEqual(script.runInThisContext(), expected);
+  }));
+
+// Syntax errors reject with a decorated error.
+const badFile = path.join(tmpdir.path, 'bad.js');
+fs.writeFileSync(badFile, 'function {');
+assert.rejects(vm.compileScriptStreaming(badFile), SyntaxError)
+  .then(common.mustCall());
+
+// A missing file rejects with the libuv error.
+assert.rejects(vm.compileScriptStreaming(path.join(tmpdir.path, 'nope.js')),
+               { code: 'ENOENT' })
+  .then(common.mustCall());
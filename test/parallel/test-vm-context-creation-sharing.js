@@ -0,0 +1,33 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const vm = require('vm');
+
+// Contextified contexts share one global object template per Environment;
+// each context must still own its mutable state and resolve its own sandbox
+// through the interceptors.
+const sandboxes = [];
+for (let i = 0; i < 64; i++) {
+  const sandbox = vm.createContext({ id: i });
+  vm.runInContext('result = id * 2; globalThis.tag = `ctx${id}`;', sandbox);
+  sandboxes.push(sandbox);
+}
+
+for (let i = 0; i < sandboxes.length; i++) {
+  assert.strictEqual(sandboxes[i].id, i);
+  assert.strictEqual(sandboxes[i].result, i * 2);
+  assert.strictEqual(sandboxes[i].tag, `ctx${i}`);
+}
+
+// Nothing may leak into the outer context.
+assert.strictEqual(global.result, undefined);
+assert.strictEqual(global.tag, undefined);
+
+// Deletions and defineProperty still go through the shared interceptors.
+const sandbox = sandboxes[0];
+vm.runInContext('delete tag;', sandbox);
+assert(!('tag' in sandbox));
+vm.runInContext(
+  'Object.defineProperty(globalThis, "answer", { value: 42 });', sandbox);
+assert.strictEqual(sandbox.answer, 42);
+assert.strictEqual(sandboxes[1].answer, undefined);
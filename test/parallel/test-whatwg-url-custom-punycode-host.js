@@ -0,0 +1,30 @@
+'use strict';
+
+// Tests below are not from WPT.
+
+const common = require('../common');
+
+if (!common.hasIntl)
+  common.skip('missing Intl');
+
+const assert = require('assert');
+
+// Hosts with an "xn--" label must never take the canonical-input fast
+// path: ToASCII decodes and validates punycode and may reject the host,
+// so invalid punycode has to keep throwing even when the input otherwise
+// looks canonical.
+assert.throws(() => new URL('http://xn--a/'), { code: 'ERR_INVALID_URL' });
+assert.throws(() => new URL('http://good.example.xn--a/'),
+              { code: 'ERR_INVALID_URL' });
+
+// Valid punycode labels still parse (through the full parser) and
+// serialize unchanged.
+assert.strictEqual(new URL('http://xn--maana-pta.com/').hostname,
+                   'xn--maana-pta.com');
+assert.strictEqual(new URL('http://sub.xn--maana-pta.com/a?b#c').href,
+                   'http://sub.xn--maana-pta.com/a?b#c');
+
+// An "xn--" in the middle of a label is not punycode and stays eligible
+// for fast-path parsing.
+assert.strictEqual(new URL('http://not-xn--a.example/').hostname,
+                   'not-xn--a.example');
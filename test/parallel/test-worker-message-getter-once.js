@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel } = require('worker_threads');
+
+// Posting a message must read each own property exactly once, like
+// structured clone. The fast-path frame encoder used to walk getters and
+// then walk them again from the ValueSerializer fallback when a later
+// property did not fit the frame format.
+
+const { port1, port2 } = new MessageChannel();
+
+let headerCalls = 0;
+let trailerCalls = 0;
+const message = {
+  get header() {
+    headerCalls++;
+    return 1;
+  },
+  // Dates never fit the fast-path frame, forcing the serializer fallback
+  // after the getter above has already been considered.
+  stamp: new Date(0),
+  get trailer() {
+    trailerCalls++;
+    return 'last';
+  },
+};
+
+port1.postMessage(message);
+// postMessage() serializes synchronously, so the getters have run by now.
+assert.strictEqual(headerCalls, 1);
+assert.strictEqual(trailerCalls, 1);
+
+port2.once('message', common.mustCall((received) => {
+  assert.strictEqual(received.header, 1);
+  assert.deepStrictEqual(received.stamp, new Date(0));
+  assert.strictEqual(received.trailer, 'last');
+
+  // A getter-only message (no serializer-forcing value) must behave the
+  // same way.
+  let calls = 0;
+  port2.on('message', common.mustCall((msg) => {
+    assert.deepStrictEqual(msg, { value: 42 });
+    port1.close();
+  }));
+  port1.postMessage({ get value() { calls++; return 42; } });
+  assert.strictEqual(calls, 1);
+}));
@@ -0,0 +1,38 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { PerformanceObserver } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+// Starting a worker publishes a 'worker' performance entry carrying the
+// per-phase startup offsets before the 'online' event fires.
+
+let observed = null;
+const obs = new PerformanceObserver(common.mustCall((list) => {
+  const entries = list.getEntriesByType('worker');
+  assert.strictEqual(entries.length, 1);
+  observed = entries[0];
+  obs.disconnect();
+}));
+obs.observe({ entryTypes: ['worker'] });
+
+const worker = new Worker('require("worker_threads").parentPort.ref();',
+                          { eval: true });
+
+worker.on('online', common.mustCall(() => {
+  // The entry was published before 'online' was emitted.
+  assert.notStrictEqual(observed, null);
+  assert.strictEqual(observed.entryType, 'worker');
+  assert.strictEqual(observed.name, 'Worker');
+  assert.strictEqual(observed.threadId, worker.threadId);
+
+  // Phases are cumulative offsets from the spawn start.
+  assert.ok(observed.startTime >= 0);
+  assert.ok(observed.isolateInit > 0);
+  assert.ok(observed.contextInit >= observed.isolateInit);
+  assert.ok(observed.environmentInit >= observed.contextInit);
+  assert.ok(observed.bootstrapComplete >= observed.environmentInit);
+  assert.strictEqual(observed.duration, observed.bootstrapComplete);
+
+  worker.terminate();
+}));
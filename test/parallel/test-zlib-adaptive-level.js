@@ -0,0 +1,67 @@
+'use strict';
+// With `adaptive: true`, zlib compression streams sample the first input
+// bytes natively and lower the compression level for high-entropy data.
+// Verify that adapted streams still produce valid output, that compressible
+// data is still compressed, and that the byte totals exposed through the
+// write-result array stay accurate.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const compressible = Buffer.from('hello world '.repeat(8192));
+const incompressible = require('crypto').randomBytes(256 * 1024);
+
+function gzipStream(input, opts, chunkBytes, cb) {
+  const gzip = zlib.createGzip(opts);
+  const chunks = [];
+  gzip.on('data', (chunk) => chunks.push(chunk));
+  gzip.on('end', common.mustCall(() => cb(Buffer.concat(chunks), gzip)));
+  for (let i = 0; i < input.length; i += chunkBytes)
+    gzip.write(input.slice(i, i + chunkBytes));
+  gzip.end();
+}
+
+// Low-entropy data keeps the configured level: output stays small and
+// round-trips.
+gzipStream(compressible, { adaptive: true }, 64 * 1024, (out) => {
+  assert(out.length < compressible.length / 4);
+  assert.deepStrictEqual(zlib.gunzipSync(out), compressible);
+});
+
+// High-entropy data is stored rather than compressed; either way the output
+// must round-trip, and stored blocks can never shrink the payload.
+gzipStream(incompressible, { adaptive: true }, 64 * 1024, (out) => {
+  assert(out.length >= incompressible.length);
+  assert.deepStrictEqual(zlib.gunzipSync(out), incompressible);
+});
+
+// Sampling may span multiple small writes before the decision is made.
+gzipStream(incompressible, { adaptive: true }, 1024, (out) => {
+  assert.deepStrictEqual(zlib.gunzipSync(out), incompressible);
+});
+
+// Inputs shorter than the sample window are decided at stream end.
+const shortRandom = require('crypto').randomBytes(4 * 1024);
+gzipStream(shortRandom, { adaptive: true }, 1024, (out) => {
+  assert.deepStrictEqual(zlib.gunzipSync(out), shortRandom);
+});
+
+// The write-result array mirrors the handle's lifetime byte totals;
+// bytesProduced must match the concatenated output exactly.
+gzipStream(compressible, {}, 64 * 1024, (out, gzip) => {
+  assert.strictEqual(gzip.bytesProduced, out.length);
+  assert.strictEqual(gzip.bytesWritten, compressible.length);
+  assert.strictEqual(gzip._writeState[2], compressible.length);
+});
+
+// The convenience methods accept the option too (it forces the streaming
+// path, since adaptation is stateful).
+zlib.gzip(incompressible, { adaptive: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(zlib.gunzipSync(out), incompressible);
+}));
+
+assert.deepStrictEqual(
+  zlib.gunzipSync(zlib.gzipSync(compressible, { adaptive: true })),
+  compressible);
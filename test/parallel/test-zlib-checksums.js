@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Known test vectors for the string '123456789'.
+const vectors = [
+  [zlib.crc32, 0xCBF43926],
+  [zlib.crc32c, 0xE3069283],
+  [zlib.adler32, 0x091E01DE],
+];
+
+const input = '123456789';
+
+for (const [fn, expected] of vectors) {
+  assert.strictEqual(fn(input), expected);
+  assert.strictEqual(fn(Buffer.from(input)), expected);
+  assert.strictEqual(fn(new Uint8Array(Buffer.from(input))), expected);
+
+  // Resuming from a running value matches the one-shot result.
+  const head = fn(input.slice(0, 4));
+  assert.strictEqual(fn(input.slice(4), head), expected);
+
+  // The callback form reports the same value asynchronously.
+  fn(input, common.mustCall((err, result) => {
+    assert.strictEqual(err, null);
+    assert.strictEqual(result, expected);
+  }));
+}
+
+// Empty input returns the initial value.
+assert.strictEqual(zlib.crc32(''), 0);
+assert.strictEqual(zlib.crc32c(''), 0);
+assert.strictEqual(zlib.adler32(''), 1);
+
+// Streaming contexts match the one-shot functions chunk for chunk.
+for (const [algorithm, expected] of
+     [['crc32', 0xCBF43926], ['crc32c', 0xE3069283], ['adler32', 0x091E01DE]]) {
+  const checksum = new zlib.Checksum(algorithm);
+  assert.strictEqual(checksum.update('1234').update('56789'), checksum);
+  assert.strictEqual(checksum.digest(), expected);
+  assert.strictEqual(checksum.value, expected);
+}
+
+// Large inputs take the threadpool path with the callback form and agree
+// with the synchronous result.
+const big = Buffer.alloc(2 * 1024 * 1024, 0xAB);
+const bigSync = zlib.crc32c(big);
+zlib.crc32c(big, common.mustCall((err, result) => {
+  assert.strictEqual(err, null);
+  assert.strictEqual(result, bigSync);
+}));
+
+assert.throws(() => new zlib.Checksum('md5'),
+              { code: 'ERR_INVALID_ARG_VALUE' });
+assert.throws(() => zlib.crc32(null), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => zlib.crc32('x', -1), { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => zlib.crc32('x', 0, 'nope'),
+              { code: 'ERR_INVALID_ARG_TYPE' });
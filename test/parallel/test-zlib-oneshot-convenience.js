@@ -0,0 +1,79 @@
+'use strict';
+// The deflate/gzip/deflateRaw convenience methods take a one-shot native
+// fast path when the options only contain the numeric zlib parameters.
+// Verify that the fast path produces byte-identical output to the streaming
+// path and behaves the same for edge-case inputs and options.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = 'hello world '.repeat(200);
+
+// Passing `chunkSize` forces the streaming path without affecting output.
+const streamOpts = { chunkSize: zlib.constants.Z_DEFAULT_CHUNK };
+
+for (const method of ['deflateSync', 'gzipSync', 'deflateRawSync']) {
+  const oneShot = zlib[method](input);
+  const streamed = zlib[method](input, streamOpts);
+  assert.deepStrictEqual(oneShot, streamed,
+                         `${method} one-shot output differs from stream`);
+}
+
+// Options that the one-shot path supports must still be honored.
+{
+  const tight = zlib.deflateSync(input, { level: 9 });
+  const loose = zlib.deflateSync(input, { level: 0 });
+  assert(tight.length < loose.length);
+  assert.strictEqual(zlib.inflateSync(tight).toString(), input);
+  assert.strictEqual(zlib.inflateSync(loose).toString(), input);
+
+  const raw = zlib.deflateRawSync(input, { windowBits: 9 });
+  assert.strictEqual(
+    zlib.inflateRawSync(raw, { windowBits: 9 }).toString(), input);
+}
+
+// Non-Buffer input types follow the same coercion as the streaming path.
+{
+  const fromString = zlib.gzipSync(input);
+  const fromBuffer = zlib.gzipSync(Buffer.from(input));
+  const fromView = zlib.gzipSync(new Uint8Array(Buffer.from(input)));
+  const fromAB = zlib.gzipSync(new Uint8Array(Buffer.from(input)).buffer);
+  assert.deepStrictEqual(fromString, fromBuffer);
+  assert.deepStrictEqual(fromView, fromBuffer);
+  assert.deepStrictEqual(fromAB, fromBuffer);
+  assert.strictEqual(zlib.gunzipSync(fromString).toString(), input);
+}
+
+// Empty input still produces a valid (header-only) compressed stream.
+{
+  const empty = zlib.gzipSync(Buffer.alloc(0));
+  assert(empty.length > 0);
+  assert.strictEqual(zlib.gunzipSync(empty).length, 0);
+}
+
+// Invalid options throw the same errors as the streaming path.
+assert.throws(() => zlib.gzipSync(input, { level: 10 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => zlib.gzip(input, 'not a callback'),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+
+// Ineligible options (here: a dictionary) transparently use the stream path.
+{
+  const dictionary = Buffer.from('hello world');
+  const out = zlib.deflateSync(input, { dictionary });
+  assert.strictEqual(
+    zlib.inflateSync(out, { dictionary }).toString(), input);
+}
+
+// Async versions go through the thread pool and must match the sync output.
+zlib.gzip(input, common.mustCall((err, buf) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(buf, zlib.gzipSync(input));
+  assert.strictEqual(zlib.gunzipSync(buf).toString(), input);
+}));
+
+zlib.deflate(input, { level: 1 }, common.mustCall((err, buf) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(buf, zlib.deflateSync(input, { level: 1 }));
+}));
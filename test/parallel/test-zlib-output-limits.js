@@ -0,0 +1,86 @@
+'use strict';
+// The decompression classes accept `maxOutputLength` and `maxRatio` options
+// that are enforced natively while inflating, guarding against decompression
+// bombs in untrusted input.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// 10 MiB of zeroes compresses to ~10 KiB: a classic small bomb.
+const bomb = zlib.deflateSync(Buffer.alloc(10 * 1024 * 1024));
+const gzipBomb = zlib.gzipSync(Buffer.alloc(10 * 1024 * 1024));
+
+// The output size limit stops inflation partway through.
+assert.throws(() => zlib.inflateSync(bomb, { maxOutputLength: 64 * 1024 }), {
+  code: 'ERR_BUFFER_TOO_LARGE',
+  message: 'Exceeded maximum decompressed size'
+});
+
+// The ratio limit trips once the output exceeds a mebibyte at >1000x.
+assert.throws(() => zlib.inflateSync(bomb, { maxRatio: 100 }), {
+  code: 'ERR_ZLIB_MAX_RATIO',
+  message: 'Exceeded maximum decompression ratio'
+});
+
+// Streaming decompression emits 'error' instead of throwing.
+{
+  const inflate = zlib.createGunzip({ maxOutputLength: 64 * 1024 });
+  inflate.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+  }));
+  inflate.on('end', common.mustNotCall());
+  inflate.end(gzipBomb);
+  inflate.resume();
+}
+
+// Inputs within the limits are unaffected.
+{
+  const input = Buffer.from('hello world '.repeat(1000));
+  const compressed = zlib.deflateSync(input);
+  const out = zlib.inflateSync(compressed, {
+    maxOutputLength: input.length,
+    maxRatio: 1000
+  });
+  assert.deepStrictEqual(out, input);
+}
+
+// The ratio guard does not apply below 1 MiB of output, so small
+// highly-compressible payloads pass even with a tight ratio.
+{
+  const small = zlib.deflateSync(Buffer.alloc(512 * 1024));
+  assert.strictEqual(zlib.inflateSync(small, { maxRatio: 2 }).length,
+                     512 * 1024);
+}
+
+// The guards survive reset(), so multi-member archives cannot evade them.
+{
+  const member = zlib.gzipSync(Buffer.alloc(1024 * 1024));
+  const archive = Buffer.concat([member, member, member]);
+  const gunzip = zlib.createGunzip({ maxOutputLength: 2 * 1024 * 1024 });
+  gunzip.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+  }));
+  gunzip.end(archive);
+  gunzip.resume();
+}
+
+// The options are validated like the other numeric zlib options.
+assert.throws(() => zlib.createInflate({ maxOutputLength: 0 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => zlib.createInflate({ maxRatio: 0.5 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => zlib.createInflate({ maxRatio: 'big' }),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+
+// Brotli decompression supports the same guards.
+{
+  const brotliBomb = zlib.brotliCompressSync(Buffer.alloc(10 * 1024 * 1024));
+  const decompress =
+    zlib.createBrotliDecompress({ maxOutputLength: 64 * 1024 });
+  decompress.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+  }));
+  decompress.end(brotliBomb);
+  decompress.resume();
+}
@@ -0,0 +1,67 @@
+'use strict';
+// The async deflate/gzip/deflateRaw convenience methods accept
+// `parallel: true`, which compresses the input as concurrent independent
+// blocks and stitches them into a single stream. Verify that the stitched
+// output decompresses back to the input for each wrapper format, for inputs
+// both larger and smaller than the native block size, and that headers and
+// checksums are intact.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Several megabytes, so the input spans multiple 1 MiB blocks; mix
+// repetitive and incompressible data so block outputs have varying sizes.
+const big = Buffer.concat([
+  Buffer.alloc(2 * 1024 * 1024, 'abcdefgh'),
+  require('crypto').randomBytes(1024 * 1024 + 12345),
+  Buffer.alloc(1024 * 1024, 'z'),
+]);
+
+zlib.gzip(big, { parallel: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  // Valid gzip magic + deflate method.
+  assert.strictEqual(out[0], 0x1f);
+  assert.strictEqual(out[1], 0x8b);
+  assert.strictEqual(out[2], 8);
+  // gunzip verifies the combined CRC32 and ISIZE trailer.
+  assert.deepStrictEqual(zlib.gunzipSync(out), big);
+}));
+
+zlib.deflate(big, { parallel: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  // inflate verifies the zlib header checksum and the combined Adler-32.
+  assert.deepStrictEqual(zlib.inflateSync(out), big);
+}));
+
+zlib.deflateRaw(big, { parallel: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(zlib.inflateRawSync(out), big);
+}));
+
+// Compression parameters still apply to the individual blocks.
+zlib.gzip(big, { parallel: true, level: 9 }, common.mustCall((err, tight) => {
+  assert.ifError(err);
+  zlib.gzip(big, { parallel: true, level: 1 },
+            common.mustCall((err, loose) => {
+              assert.ifError(err);
+              assert(tight.length < loose.length);
+              assert.deepStrictEqual(zlib.gunzipSync(loose), big);
+            }));
+}));
+
+// Inputs smaller than one block degenerate to a single compression job.
+const small = Buffer.from('hello world '.repeat(100));
+zlib.gzip(small, { parallel: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(zlib.gunzipSync(out), small);
+}));
+
+zlib.gzip(Buffer.alloc(0), { parallel: true }, common.mustCall((err, out) => {
+  assert.ifError(err);
+  assert.strictEqual(zlib.gunzipSync(out).length, 0);
+}));
+
+// The synchronous methods accept and ignore the option.
+assert.deepStrictEqual(zlib.gzipSync(small, { parallel: true }),
+                       zlib.gzipSync(small));
@@ -0,0 +1,58 @@
+'use strict';
+// Sequentially created compression streams with identical parameters adopt
+// pooled native zlib state from streams that were closed before them. Verify
+// that reused state behaves exactly like freshly initialized state, including
+// with preset dictionaries and after params() changes.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = 'hello hello hello world world world'.repeat(50);
+const dictionary = Buffer.from('hello world');
+
+function roundTrip(createCompress, createDecompress, cb) {
+  const compress = createCompress();
+  const decompress = createDecompress();
+  const chunks = [];
+  compress.pipe(decompress);
+  decompress.on('data', (chunk) => chunks.push(chunk));
+  decompress.on('end', common.mustCall(() => {
+    assert.strictEqual(Buffer.concat(chunks).toString(), input);
+    cb();
+  }));
+  compress.end(input);
+}
+
+// Repeated gzip/gunzip round trips; from the second iteration on, both the
+// deflate and the inflate stream reuse the state released by the previous
+// iteration.
+function gzipLoop(i, done) {
+  if (i === 0) return done();
+  roundTrip(() => zlib.createGzip(), () => zlib.createGunzip(),
+            () => gzipLoop(i - 1, done));
+}
+
+gzipLoop(5, common.mustCall(() => {
+  // Deflate with a preset dictionary; the dictionary must be re-applied to
+  // reused states.
+  function dictLoop(i, done) {
+    if (i === 0) return done();
+    roundTrip(() => zlib.createDeflate({ dictionary }),
+              () => zlib.createInflate({ dictionary }),
+              () => dictLoop(i - 1, done));
+  }
+
+  dictLoop(3, common.mustCall(() => {
+    // A stream whose parameters were changed via params() must only be
+    // matched against requests for the new parameters.
+    const deflate = zlib.createDeflate({ level: 9 });
+    deflate.params(1, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+      deflate.close(common.mustCall(() => {
+        roundTrip(() => zlib.createDeflate({ level: 1 }),
+                  () => zlib.createInflate(),
+                  common.mustCall());
+      }));
+    }));
+  }));
+}));
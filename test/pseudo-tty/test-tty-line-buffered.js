@@ -0,0 +1,35 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// Tests the setLineBuffered()/flushLineBuffer() handle methods: writes
+// issued while the mode is on are batched and come out whole and in
+// order, explicit flushes and disabling the mode push the batch out
+// before later writes, and bytes still batched at process teardown are
+// not dropped.
+
+assert(process.stdout.isTTY);
+const handle = process.stdout._handle;
+
+handle.setLineBuffered(true);
+
+// A line assembled from several write() calls in the same tick reaches
+// the fd as one whole write when the batch flushes.
+process.stdout.write('first ');
+process.stdout.write('line, ');
+process.stdout.write('assembled from pieces\n');
+
+// An explicit flush pushes batched bytes out immediately.
+process.stdout.write('second line, flushed by hand\n');
+handle.flushLineBuffer();
+
+// Disabling the mode flushes the batch first, so ordering is preserved
+// across the switch to unbuffered writes.
+process.stdout.write('third line, batched');
+handle.setLineBuffered(false);
+process.stdout.write(' then unbuffered\n');
+
+// A final line without a newline is still parked in the batch when the
+// process exits; teardown must flush it.
+handle.setLineBuffered(true);
+process.stdout.write('final line without newline');
@@ -0,0 +1,131 @@
+'use strict';
+
+// Test that --cpu-prof-flight-recorder writes a profile of the retained
+// samples when the --cpu-prof-flight-signal signal is received, and that
+// the flight recorder flags are validated.
+
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+common.skipIfInspectorDisabled();
+
+if (common.isWindows)
+  common.skip('test not supported on Windows');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+const {
+  getCpuProfiles,
+  kCpuProfInterval,
+  env,
+  verifyFrames
+} = require('../common/cpu-prof');
+
+if (process.argv[2] === 'child') {
+  const fs = require('fs');
+
+  function fib(n) {
+    if (n === 0 || n === 1) return n;
+    return fib(n - 1) + fib(n - 2);
+  }
+  fib(process.platform === 'win32' ? 40 : 30);
+
+  assert.strictEqual(process.listenerCount('SIGUSR2'), 1);
+  process.kill(process.pid, 'SIGUSR2');
+
+  // Asynchronously wait for the profile. Use an async loop to be a bit more
+  // robust in case platform or machine differences throw off the timing.
+  (function validate() {
+    const files = fs.readdirSync(process.cwd());
+
+    if (files.length === 0)
+      return setImmediate(validate);
+
+    assert.strictEqual(files.length, 1);
+    assert(/^CPU-flight\..+\.cpuprofile$/.test(files[0]));
+  })();
+  return;
+}
+
+// Dump on signal.
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof-flight-recorder',
+    '--cpu-prof-flight-signal', 'SIGUSR2',
+    '--cpu-prof-interval', kCpuProfInterval,
+    __filename, 'child',
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  const profiles = getCpuProfiles(tmpdir.path);
+  assert.strictEqual(profiles.length, 1);
+  verifyFrames(output, profiles[0], 'test-cpu-prof-flight-recorder.js');
+}
+
+// No dump requested, nothing should be written to disk.
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof-flight-recorder',
+    '--cpu-prof-interval', kCpuProfInterval,
+    fixtures.path('workload', 'fibonacci.js'),
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  const profiles = getCpuProfiles(tmpdir.path);
+  assert.deepStrictEqual(profiles, []);
+}
+
+// --cpu-prof-flight-signal without --cpu-prof-flight-recorder
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof-flight-signal', 'SIGUSR2',
+    fixtures.path('workload', 'fibonacci.js'),
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  const stderr = output.stderr.toString().trim();
+  if (output.status !== 9) {
+    console.log(stderr);
+  }
+  assert.strictEqual(output.status, 9);
+  assert.strictEqual(
+    stderr,
+    `${process.execPath}: --cpu-prof-flight-signal must be used with ` +
+      '--cpu-prof-flight-recorder');
+}
+
+// --cpu-prof-flight-window without --cpu-prof-flight-recorder
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof-flight-window', '10',
+    fixtures.path('workload', 'fibonacci.js'),
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  const stderr = output.stderr.toString().trim();
+  if (output.status !== 9) {
+    console.log(stderr);
+  }
+  assert.strictEqual(output.status, 9);
+  assert.strictEqual(
+    stderr,
+    `${process.execPath}: --cpu-prof-flight-window must be used with ` +
+      '--cpu-prof-flight-recorder');
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+# Convert a binary trace ring file written by --trace-event-binary-file
+# into the JSON trace event format understood by chrome://tracing and
+# similar viewers.
+#
+# Usage: python tools/trace_ring_to_json.py <ring-file> [<output.json>]
+#
+# The file layout is defined in src/tracing/node_binary_trace_writer.h:
+# a 4096-byte header (magic, version, record size, record capacity and a
+# monotonically increasing sequence counter) followed by fixed 128-byte
+# records. The sequence counter never wraps, so the number of valid
+# records and the position of the oldest one can be recovered even after
+# the ring has been overwritten many times.
+
+from __future__ import print_function
+
+import json
+import struct
+import sys
+
+HEADER_FORMAT = '<QIIQQ'
+HEADER_SIZE = 4096
+MAGIC = 0x3143525445444F4E  # "NODETRC1"
+RECORD_FORMAT = '<qQQiic63s32s'
+
+
+def decode_field(raw):
+  return raw.split(b'\0', 1)[0].decode('utf-8', 'replace')
+
+
+def read_records(stream):
+  header = stream.read(HEADER_SIZE)
+  if len(header) < HEADER_SIZE:
+    raise SystemExit('truncated header')
+  magic, version, record_size, capacity, sequence = \
+      struct.unpack_from(HEADER_FORMAT, header)
+  if magic != MAGIC:
+    raise SystemExit('not a trace ring file (bad magic)')
+  if version != 1:
+    raise SystemExit('unsupported trace ring version %d' % version)
+  if record_size != struct.calcsize(RECORD_FORMAT):
+    raise SystemExit('unexpected record size %d' % record_size)
+
+  count = min(sequence, capacity)
+  start = sequence - count  # Sequence number of the oldest surviving record.
+  events = []
+  for seq in range(start, sequence):
+    stream.seek(HEADER_SIZE + (seq % capacity) * record_size)
+    raw = stream.read(record_size)
+    if len(raw) < record_size:
+      break
+    ts, dur, event_id, pid, tid, phase, name, cat = \
+        struct.unpack(RECORD_FORMAT, raw)
+    event = {
+      'pid': pid,
+      'tid': tid,
+      'ts': ts,
+      'tts': ts,
+      'ph': phase.decode('ascii', 'replace'),
+      'cat': decode_field(cat),
+      'name': decode_field(name),
+      'dur': dur,
+      'tdur': dur,
+      'args': {},
+    }
+    if event_id != 0:
+      event['id'] = '0x%x' % event_id
+    events.append(event)
+  return events
+
+
+def main(args):
+  if len(args) < 1 or len(args) > 2:
+    print('usage: trace_ring_to_json.py <ring-file> [<output.json>]',
+          file=sys.stderr)
+    return 1
+  with open(args[0], 'rb') as stream:
+    events = read_records(stream)
+  output = json.dumps({'traceEvents': events}, separators=(',', ':'))
+  if len(args) == 2:
+    with open(args[1], 'w') as out:
+      out.write(output)
+  else:
+    print(output)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))